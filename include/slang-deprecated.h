@@ -858,6 +858,11 @@ extern "C"
         SlangCompileRequest* request,
         ISlangBlob** outBlob);
 
+    /** Serialize the binding layout of the parameters and entry points of `reflection` into a
+    compact binary blob, whose layout is described in `slang-reflection-blob.h`.
+    */
+    SLANG_API SlangResult spReflection_ToBinary(SlangReflection* reflection, ISlangBlob** outBlob);
+
     SLANG_API unsigned spReflection_GetParameterCount(SlangReflection* reflection);
     SLANG_API SlangReflectionParameter* spReflection_GetParameterByIndex(
         SlangReflection* reflection,
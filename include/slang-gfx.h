@@ -62,7 +62,9 @@ enum class StructType
     D3D12DeviceExtendedDesc,
     D3D12ExperimentalFeaturesDesc,
     SlangSessionExtendedDesc,
-    RayTracingValidationDesc
+    RayTracingValidationDesc,
+    CPUDeviceExtendedDesc,
+    AsyncPipelineSpecializationDesc
 };
 
 // TODO: Rename to Stage
@@ -1485,6 +1487,14 @@ public:
 
         IShaderProgram* program;
     };
+
+    /// Replace the hit group, and the record overwrite if `recordOverwrite` isn't null, of the
+    /// hit group record at `index`. The buffers the table already created for pipelines are
+    /// updated in place by the next ray dispatch with the table, instead of being created again.
+    virtual SLANG_NO_THROW Result SLANG_MCALL setHitGroup(
+        GfxIndex index,
+        const char* hitGroupName,
+        const ShaderRecordOverwrite* recordOverwrite) = 0;
 };
 #define SLANG_UUID_IShaderTable                            \
     {                                                      \
@@ -2068,7 +2078,13 @@ class ICommandQueue : public ISlangUnknown
 public:
     enum class QueueType
     {
-        Graphics
+        /// A queue that can run every kind of command.
+        Graphics,
+        /// A queue that can run compute, ray tracing and resource commands, concurrently with the
+        /// graphics queue where the device supports it.
+        Compute,
+        /// A queue that can only run copy commands, usually on a dedicated transfer engine.
+        Copy,
     };
     struct Desc
     {
@@ -2109,6 +2125,20 @@ public:
         }                                                \
     }
 
+/// A heap of the short-lived memory and descriptors that command buffers are recorded with.
+///
+/// Command buffers can be recorded on several threads at once, on D3D12 and Vulkan, as long as
+/// each thread records its own command buffers from its own transient heap:
+/// - A transient heap, its command buffers and their encoders must only be used by one thread
+///   at a time. Each heap allocates its own descriptors and constant buffer memory, so the
+///   threads don't contend for them.
+/// - Pipelines, resources, resource views and samplers can be bound by several threads at once,
+///   and shader objects can be created on any thread. Their reference counts are thread safe,
+///   and specialized pipelines are looked up in a cache that all threads share.
+/// - A shader object must only be bound by one thread at a time, since binding it caches the
+///   constant buffer and descriptors that it allocates from the transient heap of the encoder.
+/// - Submitting command buffers to an `ICommandQueue`, and `synchronizeAndReset`, must not run
+///   at the same time as other uses of the queue or heap.
 class ITransientResourceHeap : public ISlangUnknown
 {
 public:
@@ -2129,6 +2159,8 @@ public:
         GfxCount srvDescriptorCount;
         GfxCount constantBufferDescriptorCount;
         GfxCount accelerationStructureDescriptorCount;
+        /// The type of the queues that the command buffers created from the heap are submitted to.
+        ICommandQueue::QueueType queueType = ICommandQueue::QueueType::Graphics;
     };
 
     // Waits until GPU commands issued before last call to `finish()` has been completed, and resets
@@ -2362,6 +2394,18 @@ public:
     handleMessage(DebugMessageType type, DebugMessageSource source, const char* message) = 0;
 };
 
+/// The number of state changes that command encoders skipped because the same state was
+/// already set on the command buffer by the encoder.
+struct RedundantStateStats
+{
+    uint64_t pipelineBindCount;
+    uint64_t descriptorBindCount;
+    uint64_t vertexBufferBindCount;
+    uint64_t indexBufferBindCount;
+    uint64_t viewportCount;
+    uint64_t scissorRectCount;
+};
+
 class IDevice : public ISlangUnknown
 {
 public:
@@ -2388,7 +2432,10 @@ public:
 
     struct ShaderCacheDesc
     {
-        // The root directory for the shader cache. If not set, shader cache is disabled.
+        // The root directory for the shader cache. If not set, shader cache is disabled. On
+        // Vulkan, the contents of the device's VkPipelineCache are also kept in this directory,
+        // for each physical device and driver, and written when the device is destroyed. On
+        // D3D12, the same is done with an ID3D12PipelineLibrary for each adapter.
         const char* shaderCachePath = nullptr;
         // The maximum number of entries stored in the cache. By default, there is no limit.
         GfxCount maxEntryCount = 0;
@@ -2782,6 +2829,22 @@ public:
         slang::TypeReflection* type,
         ShaderObjectContainerType container,
         IShaderObject** outObject) = 0;
+
+    /// Get the index of `view` in the shader-visible descriptor heap, registering the view in
+    /// the heap the first time it is asked for. Shaders can access the view by passing the
+    /// index to `getResourceFromDescriptorHeap`, so the view doesn't need to be bound to a
+    /// shader object.
+    /// Only available on D3D12 devices created with
+    /// `D3D12DeviceExtendedDesc::enableBindlessResources`.
+    virtual SLANG_NO_THROW Result SLANG_MCALL
+    getBindlessResourceIndex(IResourceView* view, uint32_t* outIndex) = 0;
+
+    /// Get the number of redundant state changes the command encoders of the device have skipped
+    /// since the device was created or `resetRedundantStateStats` was called. The counts of an
+    /// encoder are added when it ends encoding.
+    virtual SLANG_NO_THROW Result SLANG_MCALL
+    getRedundantStateStats(RedundantStateStats* outStats) = 0;
+    virtual SLANG_NO_THROW Result SLANG_MCALL resetRedundantStateStats() = 0;
 };
 
 #define SLANG_UUID_IDevice                                 \
@@ -2809,6 +2872,18 @@ public:
     virtual SLANG_NO_THROW Result SLANG_MCALL clearShaderCache() = 0;
     virtual SLANG_NO_THROW Result SLANG_MCALL getShaderCacheStats(ShaderCacheStats* outStats) = 0;
     virtual SLANG_NO_THROW Result SLANG_MCALL resetShaderCacheStats() = 0;
+
+    /// Create the specializations of `pipeline` that were recorded under `name` in earlier
+    /// sessions, and record the specializations that draws and dispatches create from now on.
+    ///
+    /// The specializations are recorded in the shader cache by the full names of their type
+    /// arguments, so the recording survives changes to the shaders as long as the types exist.
+    /// Recorded specializations whose types the program of `pipeline` doesn't have are skipped.
+    /// With `AsyncPipelineSpecializationDesc`, the specializations are generated on the worker
+    /// threads, and the first draw or dispatch that needs one creates its pipeline. Otherwise
+    /// they are all created before this returns.
+    virtual SLANG_NO_THROW Result SLANG_MCALL
+    prewarmPipelineSpecializations(IPipelineState* pipeline, const char* name) = 0;
 };
 
 #define SLANG_UUID_IShaderCache                            \
@@ -2919,6 +2994,11 @@ struct D3D12DeviceExtendedDesc
     const char* rootParameterShaderAttributeName = nullptr;
     bool debugBreakOnD3D12Error = false;
     uint32_t highestShaderModel = 0;
+    /// Allocate the shader-visible CBV/SRV/UAV descriptors of all transient heaps from one
+    /// device-wide heap, so that resource views can be registered in it once with
+    /// `IDevice::getBindlessResourceIndex` and accessed by shaders through
+    /// `getResourceFromDescriptorHeap`. Samplers are still bound through descriptor tables.
+    bool enableBindlessResources = false;
 };
 
 struct SlangSessionExtendedDesc
@@ -2936,4 +3016,34 @@ struct RayTracingValidationDesc
     bool enableRaytracingValidation = false;
 };
 
+/// Options for the CPU device.
+struct CPUDeviceExtendedDesc
+{
+    StructType structType = StructType::CPUDeviceExtendedDesc;
+    /// The size of the pool of worker threads that the device creates to run the thread groups
+    /// of compute dispatches. The threads are kept for the lifetime of the device, and the
+    /// calling thread runs thread groups alongside them. 0 uses one worker per hardware thread,
+    /// besides the calling thread. Without this desc, dispatches run on the calling thread only.
+    uint32_t threadPoolSize = 0;
+};
+
+/// Specialize pipelines in the background, on devices that support it (D3D12 and Vulkan).
+///
+/// When a draw or dispatch needs a specialization of the bound pipeline that hasn't been
+/// created yet, the specialization and the generation of its code are started on a worker
+/// thread, and the draw or dispatch is skipped: nothing is recorded, and it returns
+/// `SLANG_E_PENDING`. Once the code is ready, the next draw or dispatch that needs it creates
+/// the pipeline and is recorded as usual.
+///
+/// The Slang session of the device is created thread safe, and the modules of programs created
+/// with other sessions must be thread safe too. Diagnostics of background compiles are reported
+/// to the debug callback from the worker threads.
+struct AsyncPipelineSpecializationDesc
+{
+    StructType structType = StructType::AsyncPipelineSpecializationDesc;
+    /// The number of background threads that pipelines are specialized on. 0 uses one thread
+    /// per hardware thread.
+    uint32_t workerThreadCount = 0;
+};
+
 } // namespace gfx
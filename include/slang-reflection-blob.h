@@ -0,0 +1,126 @@
+// slang-reflection-blob.h
+#ifndef SLANG_REFLECTION_BLOB_H
+#define SLANG_REFLECTION_BLOB_H
+
+/*
+The layout of the binary reflection blob produced by `spReflection_ToBinary` and the
+`-reflection-binary` option.
+
+The blob holds the binding layout of the global shader parameters and of the parameters of each
+entry point, so that an application can look up bindings at run time without linking Slang. It
+is meant to be used in place, e.g. from a memory mapped file: reading it needs no allocation and
+no code besides this header.
+
+The blob is a single RIFF chunk. It starts with a `SlangReflectionBlobHeader`, whose `size` is
+the size of the data that follows it. All offsets in the blob are in bytes from the start of
+that data, and an offset of 0 means empty. The root `SlangReflectionBlobProgram` is at offset
+`SLANG_REFLECTION_BLOB_PROGRAM_OFFSET`. All values are stored little endian, and all structures
+are 4 byte aligned.
+
+Strings are stored as arrays of chars, followed by a terminating 0 that isn't included in the
+count.
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define SLANG_REFLECTION_BLOB_FOURCC \
+    (((uint32_t)'S' << 0) | ((uint32_t)'L' << 8) | ((uint32_t)'R' << 16) | ((uint32_t)'B' << 24))
+
+/* Incremented whenever the layout of the blob changes. */
+#define SLANG_REFLECTION_BLOB_VERSION 1
+
+#define SLANG_REFLECTION_BLOB_PROGRAM_OFFSET 8
+
+/* The value used for sizes and counts that are unbounded. */
+#define SLANG_REFLECTION_BLOB_UNBOUNDED 0xffffffffu
+
+typedef struct SlangReflectionBlobHeader
+{
+    uint32_t fourCC; /* SLANG_REFLECTION_BLOB_FOURCC */
+    uint32_t size;   /* The size of the data following the header. */
+} SlangReflectionBlobHeader;
+
+/* `count` items stored contiguously at `offset`. */
+typedef struct SlangReflectionBlobArray
+{
+    uint32_t offset;
+    uint32_t count;
+} SlangReflectionBlobArray;
+
+/* The resources of one kind a variable uses. */
+typedef struct SlangReflectionBlobBinding
+{
+    uint32_t category; /* SlangParameterCategory */
+    uint32_t space;    /* The register space or descriptor set. */
+    /* The first register or binding, or the byte offset for SLANG_PARAMETER_CATEGORY_UNIFORM. */
+    uint32_t index;
+    /* The number of registers or bindings, or bytes for SLANG_PARAMETER_CATEGORY_UNIFORM. */
+    uint32_t size;
+} SlangReflectionBlobBinding;
+
+/* A shader parameter or a field of one. The bindings of fields are relative to the variable
+   that holds them. */
+typedef struct SlangReflectionBlobVar
+{
+    SlangReflectionBlobArray name;     /* of char */
+    SlangReflectionBlobArray bindings; /* of SlangReflectionBlobBinding */
+    /* of SlangReflectionBlobVar. The fields of a struct, or of the element type of an array or
+       a buffer. */
+    SlangReflectionBlobArray fields;
+    uint32_t typeKind;     /* slang::TypeReflection::Kind */
+    uint32_t elementCount; /* The element count of an array, 0 if the variable isn't an array. */
+} SlangReflectionBlobVar;
+
+typedef struct SlangReflectionBlobEntryPoint
+{
+    SlangReflectionBlobArray name;       /* of char */
+    SlangReflectionBlobArray parameters; /* of SlangReflectionBlobVar */
+    uint32_t stage;                      /* SlangStage */
+    uint32_t threadGroupSize[3];
+} SlangReflectionBlobEntryPoint;
+
+typedef struct SlangReflectionBlobProgram
+{
+    uint32_t version; /* SLANG_REFLECTION_BLOB_VERSION */
+    uint32_t reserved;
+    SlangReflectionBlobArray parameters;  /* of SlangReflectionBlobVar */
+    SlangReflectionBlobArray entryPoints; /* of SlangReflectionBlobEntryPoint */
+} SlangReflectionBlobProgram;
+
+/* Get the program stored in `blob`, or NULL if it isn't a reflection blob of this version. */
+static inline const SlangReflectionBlobProgram* slangReflectionBlobGetProgram(
+    const void* blob,
+    size_t blobSize)
+{
+    const SlangReflectionBlobHeader* header = (const SlangReflectionBlobHeader*)blob;
+    if (blobSize < sizeof(SlangReflectionBlobHeader) ||
+        header->fourCC != SLANG_REFLECTION_BLOB_FOURCC ||
+        header->size > blobSize - sizeof(SlangReflectionBlobHeader) ||
+        header->size < SLANG_REFLECTION_BLOB_PROGRAM_OFFSET + sizeof(SlangReflectionBlobProgram))
+    {
+        return NULL;
+    }
+    const SlangReflectionBlobProgram* program =
+        (const SlangReflectionBlobProgram*)((const char*)(header + 1) +
+                                            SLANG_REFLECTION_BLOB_PROGRAM_OFFSET);
+    return program->version == SLANG_REFLECTION_BLOB_VERSION ? program : NULL;
+}
+
+/* Get the items of `array`, which are `itemSize` bytes each, or NULL if the array is empty or
+   doesn't fit in the blob. */
+static inline const void* slangReflectionBlobGetItems(
+    const void* blob,
+    SlangReflectionBlobArray array,
+    size_t itemSize)
+{
+    const SlangReflectionBlobHeader* header = (const SlangReflectionBlobHeader*)blob;
+    if (array.offset == 0 || array.count == 0 || array.offset > header->size ||
+        (header->size - array.offset) / itemSize < array.count)
+    {
+        return NULL;
+    }
+    return (const char*)(header + 1) + array.offset;
+}
+
+#endif
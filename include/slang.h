@@ -853,6 +853,22 @@ typedef uint32_t SlangSizeT;
         SLANG_EMIT_SPIRV_DIRECTLY,
     };
 
+    enum SlangSpirvOptimizationPreset
+    {
+        SLANG_SPIRV_OPTIMIZATION_PRESET_DEFAULT = 0,  /**< Passes from the optimization level. */
+        SLANG_SPIRV_OPTIMIZATION_PRESET_FAST_COMPILE, /**< A few cheap dead code passes. */
+        SLANG_SPIRV_OPTIMIZATION_PRESET_PERFORMANCE,  /**< spirv-opt's passes for speed (-O). */
+        SLANG_SPIRV_OPTIMIZATION_PRESET_SIZE,         /**< spirv-opt's passes for size (-Os). */
+    };
+
+    enum SlangAutodiffCheckpointPolicy
+    {
+        SLANG_AUTODIFF_CHECKPOINT_POLICY_DEFAULT = 0,   /**< Store calls, recompute the rest. */
+        SLANG_AUTODIFF_CHECKPOINT_POLICY_STORE_ALL,     /**< Store every computed value. */
+        SLANG_AUTODIFF_CHECKPOINT_POLICY_RECOMPUTE_ALL, /**< Recompute all that can be. */
+        SLANG_AUTODIFF_CHECKPOINT_POLICY_BUDGET,        /**< Recompute within a budget. */
+    };
+
     // All compiler option names supported by Slang.
     namespace slang
     {
@@ -1004,7 +1020,50 @@ typedef uint32_t SlangSizeT;
         // Setting of EmitSpirvDirectly or EmitSpirvViaGLSL will turn into this option internally.
         EmitSpirvMethod, // enum SlangEmitSpirvMethod
 
-        EmitReflectionJSON, // bool
+        EmitReflectionJSON,            // bool
+        TraceOutput,                   // stringValue0: path to write a Chrome trace JSON file to.
+        ReportIRPassStatistics,        // bool
+        IRPassStatisticsJSON,          // stringValue0: path to write IR pass statistics JSON to.
+        DownstreamThreadCount,         // intValue0: threads to run downstream compiles on.
+        CompilationCachePath,          // stringValue0: compilation cache directory.
+        CompilationCacheMaxEntryCount, // intValue0: maximum compilation cache entries.
+        DownstreamResultCache,         // bool: cache the results of downstream compilers.
+        MapBinaryModules,              // bool: memory map precompiled modules to load them.
+        OptimizationThreadCount,       // intValue0: threads to compute IR analyses on.
+        SpirvOptimizationPreset,       // intValue0: enum SlangSpirvOptimizationPreset
+        FrontEndThreadCount,           // intValue0: threads to lex translation units on.
+        DeferFunctionBodyChecking,     // bool: only check function bodies that are used.
+        ReflectionJSONCompact,         // bool: emit EmitReflectionJSON without whitespace.
+        ReflectionJSONFilter,          // stringValue0: comma separated names to emit reflection of.
+        EmitReflectionBinary,          // stringValue0: path to write the binary reflection blob to.
+        ShareGenericSpecializations,   // bool: reuse generic specializations across programs.
+        ShareForwardDerivatives,       // bool: reuse forward derivatives across programs.
+        AutodiffCheckpointPolicy,      // intValue0: enum SlangAutodiffCheckpointPolicy
+        AutodiffRecomputeBudget,       // intValue0: instructions a recomputed value may cost.
+        ReportRegisterPressure,        // bool: report values live at once in each function.
+        InstrumentProfileCounters,     // bool: count the executions of functions and loops.
+        ProfileCounts,                 // stringValue0: path of the counts to optimize with.
+        TrimUnusedUniformFields,       // bool: remove unused fields from constant buffers.
+        PackGlobalUniforms,            // bool: reorder global uniforms to minimize padding.
+        CPUThreadSIMDWidth,            // intValue0: CPU group threads run per SIMD loop.
+        BatchEntryPoints,              // bool: compile all PTX/metallib entry points at once.
+        PrecompileModules,             // stringValue0: directory to write each module to.
+        ContiguousTensorVariants,      // bool: add CUDA kernel variants for contiguous tensors.
+        CacheTensorViews,              // bool: reuse torch TensorViews of unchanged tensors.
+        PadGroupSharedArrays,          // bool: pad groupshared rows to avoid bank conflicts.
+        ReportOptimizationRemarks,     // bool: report the optimizations applied and missed.
+        OptimizationRemarksFile,       // stringValue0: path to write optimization remarks to.
+        ReportShaderCost,              // bool: report the static cost of each entry point.
+        IncrementalCodeGen,            // bool: reuse code generated from identical linked IR.
+        LowerReferencedFunctionsOnly,  // bool: only lower imported functions that are referenced.
+        DebugInfoFunctions,            // stringValue0: names of functions to emit debug info for.
+        MemoryBudget,                  // intValue0: soft limit in MiB of a session's memory use.
+        ReleaseIntermediateIR,         // bool: release a target's IR once all its code is made.
+        IndexSearchDirectories,        // bool: skip search directories by their listings.
+        PrefetchImportedModules,       // bool: read the files of a module's imports concurrently.
+        LoopUnrollBudget,              // intValue0: instructions that unrolling a loop may add.
+        CompressIdleModuleIR,          // intValue0: seconds before unused module IR is compressed.
+        AggressiveExpressionFolding,   // bool: fold more single-use values into source expressions.
         CountOf,
     };
 
@@ -1160,6 +1219,8 @@ typedef uint32_t SlangSizeT;
 #define SLANG_E_NOT_AVAILABLE SLANG_MAKE_CORE_ERROR(7)
     //! Could not complete because the operation times out.
 #define SLANG_E_TIME_OUT SLANG_MAKE_CORE_ERROR(8)
+    //! Could not complete because the operation was canceled.
+#define SLANG_E_CANCELED SLANG_MAKE_CORE_ERROR(9)
 
     /** A "Universally Unique Identifier" (UUID)
 
@@ -1702,6 +1763,16 @@ public:                                                              \
 
 #define SLANG_UUID_ISlangWriter ISlangWriter::getTypeGuid()
 
+    /* The subsystems of the compiler whose memory use is accounted for. */
+    typedef SlangUInt32 SlangMemoryCategoryIntegral;
+    enum SlangMemoryCategory : SlangMemoryCategoryIntegral
+    {
+        SLANG_MEMORY_CATEGORY_TOTAL = 0, /**< All of the categories below together. */
+        SLANG_MEMORY_CATEGORY_IR,        /**< The IR modules, including linked ones. */
+        SLANG_MEMORY_CATEGORY_AST,       /**< The syntax trees and checked values. */
+        SLANG_MEMORY_CATEGORY_COUNT_OF,
+    };
+
     struct ISlangProfiler : public ISlangUnknown
     {
         SLANG_COM_INTERFACE(
@@ -1716,6 +1787,37 @@ public:                                                              \
     };
 #define SLANG_UUID_ISlangProfiler ISlangProfiler::getTypeGuid()
 
+    /** Extends `ISlangProfiler` with the trace and the memory use of the profiled compilation.
+    It is queried from the `ISlangProfiler` returned by `ICompileRequest::getCompileTimeProfile`.
+    */
+    struct ISlangProfiler2 : public ISlangProfiler
+    {
+        // uuidgen output:     d72a32ff -  7f8e -  4d74 -    abe9 -      f5226e27cc73
+        SLANG_COM_INTERFACE(
+            0xd72a32ff,
+            0x7f8e,
+            0x4d74,
+            {0xab, 0xe9, 0xf5, 0x22, 0x6e, 0x27, 0xcc, 0x73})
+
+        /** Get the hierarchical trace of the profiled compilation, in the Chrome trace event
+        JSON format (loadable by chrome://tracing or Perfetto). Tracing must have been enabled,
+        for example via the `TraceOutput` compiler option.
+        @param outTraceJSON Receives a blob holding the JSON text
+        @returns SLANG_E_NOT_AVAILABLE if no trace was recorded */
+        virtual SLANG_NO_THROW SlangResult SLANG_MCALL getTraceJSON(ISlangBlob** outTraceJSON) = 0;
+
+        /** Get the memory used by the profiled compilation, as it was when the profile was taken.
+        @param category The subsystem to get the memory of, or SLANG_MEMORY_CATEGORY_TOTAL
+        @param outCurrentBytes Receives the bytes allocated when the profile was taken
+        @param outPeakBytes Receives the most bytes that were allocated at once
+        @returns SLANG_E_NOT_AVAILABLE if the profile has no memory accounting */
+        virtual SLANG_NO_THROW SlangResult SLANG_MCALL getMemoryUsage(
+            SlangMemoryCategory category,
+            uint64_t* outCurrentBytes,
+            uint64_t* outPeakBytes) = 0;
+    };
+#define SLANG_UUID_ISlangProfiler2 ISlangProfiler2::getTypeGuid()
+
     namespace slang
     {
     struct IGlobalSession;
@@ -3327,6 +3429,13 @@ struct ShaderReflection
     {
         return spReflection_ToJson((SlangReflection*)this, nullptr, outBlob);
     }
+
+    /// Serialize the binding layout of the program into the binary format of
+    /// `slang-reflection-blob.h`.
+    SlangResult toBinary(ISlangBlob** outBlob)
+    {
+        return spReflection_ToBinary((SlangReflection*)this, outBlob);
+    }
 };
 
 
@@ -3748,7 +3857,15 @@ struct TargetDesc
 typedef uint32_t SessionFlags;
 enum
 {
-    kSessionFlags_None = 0
+    kSessionFlags_None = 0,
+
+    /** The session, and the component types created from it, may be used from several
+    threads at once. Loading, checking and linking are serialized, and the modules loaded
+    are shared by all threads. Code generation is serialized too, up to and including the
+    IR optimizations and emitting; only downstream compilers (such as DXC, NVRTC or
+    spirv-opt) run concurrently, for different component types.
+    */
+    kSessionFlags_ThreadSafe = 1 << 0,
 };
 
 struct PreprocessorMacroDesc
@@ -4001,6 +4118,34 @@ struct ISession : public ISlangUnknown
 
     #define SLANG_UUID_ISession ISession::getTypeGuid()
 
+/** A static, target-independent estimate of the cost of an entry point, taken from the IR
+after it is optimized for the target, and counting each instruction of the functions the
+entry point calls once, however many times it runs.
+ */
+struct ShaderCost
+{
+    /// Arithmetic, logic, comparison and conversion operations, including calls to
+    /// built-in math functions.
+    SlangUInt aluOpCount = 0;
+    /// Texture sampling and gather operations.
+    SlangUInt textureSampleCount = 0;
+    /// Other texture reads and writes.
+    SlangUInt textureAccessCount = 0;
+    SlangUInt bufferLoadCount = 0;
+    SlangUInt bufferLoadBytes = 0;
+    SlangUInt bufferStoreCount = 0;
+    SlangUInt bufferStoreBytes = 0;
+    /// The size of the groupshared variables that the entry point uses.
+    SlangUInt groupSharedBytes = 0;
+    SlangUInt barrierCount = 0;
+    /// Local arrays that are kept in memory instead of registers, and their size.
+    SlangUInt localArrayCount = 0;
+    SlangUInt localArrayBytes = 0;
+    /// The largest number of values live at once in any of the functions the entry point
+    /// calls, as an estimate of the registers it needs.
+    SlangUInt estimatedLiveValueCount = 0;
+};
+
 struct IMetadata : public ISlangCastable
 {
     SLANG_COM_INTERFACE(0x8044a8a3, 0xddc0, 0x4b7f, {0xaf, 0x8e, 0x2, 0x6e, 0x90, 0x5d, 0x73, 0x32})
@@ -4014,6 +4159,30 @@ struct IMetadata : public ISlangCastable
         SlangUInt spaceIndex,            // `space` for D3D12, `set` for Vulkan
         SlangUInt registerIndex,         // `register` for D3D12, `binding` for Vulkan
         bool& outUsed) = 0;
+
+    /*
+    Returns where the uniform data at `offset` bytes in the reflected layout of the constant
+    buffer at the specified binding location is in the compiled shader.
+
+    When the fields that the shader doesn't use are removed from constant buffers with
+    `CompilerOptionName::TrimUnusedUniformFields`, `outUsed` is false for the data of removed
+    fields, and `outOffset` is the offset of the data in the compacted buffer otherwise. The
+    data of buffers that weren't trimmed is at its reflected offset.
+    */
+    virtual SlangResult getUniformDataOffset(
+        SlangParameterCategory category,
+        SlangUInt spaceIndex,
+        SlangUInt registerIndex,
+        SlangUInt offset,
+        SlangUInt& outOffset,
+        bool& outUsed) = 0;
+
+    /*
+    Returns the static cost of the entry point named `entryPointName` in the compiled code.
+    `entryPointName` can be null when the metadata is for a single entry point. Fails with
+    `SLANG_E_NOT_FOUND` when there is no such entry point.
+    */
+    virtual SlangResult getShaderCost(const char* entryPointName, ShaderCost& outCost) = 0;
 };
     #define SLANG_UUID_IMetadata IMetadata::getTypeGuid()
 
@@ -4125,6 +4294,9 @@ struct IComponentType : public ISlangUnknown
     If code has not already been generated for the given entry point and target,
     then a compilation error may be detected, in which case `outDiagnostics`
     (if non-null) will be filled in with a blob of messages diagnosing the error.
+
+    Once code has been generated, asking for it again returns the same blob without
+    compiling, hashing or allocating anything, and leaves `outDiagnostics` untouched.
     */
     virtual SLANG_NO_THROW SlangResult SLANG_MCALL getEntryPointCode(
         SlangInt entryPointIndex,
@@ -4235,6 +4407,20 @@ struct IComponentType : public ISlangUnknown
         SlangInt targetIndex,
         IMetadata** outMetadata,
         IBlob** outDiagnostics = nullptr) = 0;
+
+    /** Get the compiled code for each of the `entryPointCount` entry points in
+    `entryPointIndices` for the chosen `targetIndex`, writing the code of the entry point
+    `entryPointIndices[i]` to `outCodes[i]`.
+
+    This is the same as calling getEntryPointCode for each of the entry points, except that
+    if any of them fails, none of the code is returned.
+    */
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL getEntryPointCodes(
+        SlangInt entryPointCount,
+        SlangInt const* entryPointIndices,
+        SlangInt targetIndex,
+        IBlob** outCodes,
+        IBlob** outDiagnostics = nullptr) = 0;
 };
     #define SLANG_UUID_IComponentType IComponentType::getTypeGuid()
 
@@ -4374,6 +4560,128 @@ struct SpecializationArg
         return rs;
     }
 };
+
+/** One entry point to compile with `IBatchCompileService_Experimental::compileBatch`.
+ */
+struct BatchCompileItem
+{
+    /** The program the entry point is in, created from the session the batch is compiled with.
+     */
+    IComponentType* program = nullptr;
+    /** The arguments to specialize `program` with, or none if it doesn't need specializing. */
+    SpecializationArg const* specializationArgs = nullptr;
+    SlangInt specializationArgCount = 0;
+    /** The index of the entry point in `program`. */
+    SlangInt entryPointIndex = 0;
+    /** The index of the session target to compile for. */
+    SlangInt targetIndex = 0;
+};
+
+/** Called with the code of an item of a batch as soon as it is compiled, or with the
+failure and diagnostics if it couldn't be. The blobs are only valid for the duration of the
+call, unless the callback takes a reference to them.
+*/
+typedef void(SLANG_MCALL* BatchCompileCallback)(
+    void* userData,
+    SlangInt itemIndex,
+    SlangResult result,
+    IBlob* code,
+    IBlob* diagnostics);
+
+/* Experimental interface for compiling many entry points and specializations at once. It is
+queried from an `ISession`. */
+struct IBatchCompileService_Experimental : public ISlangUnknown
+{
+    // uuidgen output:     5d1c7e42 -  93b1 -  4c8e -    a6f0 -      2be4d9a7c315
+    SLANG_COM_INTERFACE(
+        0x5d1c7e42,
+        0x93b1,
+        0x4c8e,
+        {0xa6, 0xf0, 0x2b, 0xe4, 0xd9, 0xa7, 0xc3, 0x15})
+
+    /** Compile the entry points of `items`, calling `callback` for each of them as it is done.
+
+    Items with the same program and specialization arguments are specialized and linked once,
+    and share the code generated for each target. When the session was created with
+    `kSessionFlags_ThreadSafe`, the code is generated on up to `threadCount` threads, including
+    the calling one, and `callback` is called from those threads. The threads only overlap in
+    downstream compiles, as the rest of code generation holds the session's lock. Otherwise
+    everything is done on the calling thread. Returns once every item has been reported, with
+    `SLANG_FAIL` if any of them failed.
+    */
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL compileBatch(
+        BatchCompileItem const* items,
+        SlangInt itemCount,
+        SlangInt threadCount,
+        BatchCompileCallback callback,
+        void* userData) = 0;
+};
+
+    #define SLANG_UUID_IBatchCompileService_Experimental \
+        IBatchCompileService_Experimental::getTypeGuid()
+
+/* Interface for getting the memory used by a session, as it is now. It is queried from an
+`ISession`. A compile request has a session of its own, whose memory use is available from
+the `ISlangProfiler2` of `ICompileRequest::getCompileTimeProfile`. */
+struct IMemoryStats : public ISlangUnknown
+{
+    // uuidgen output:     a3e4b1c9 -  6f27 -  4d58 -    9b0e -      c7d21f43a865
+    SLANG_COM_INTERFACE(
+        0xa3e4b1c9,
+        0x6f27,
+        0x4d58,
+        {0x9b, 0x0e, 0xc7, 0xd2, 0x1f, 0x43, 0xa8, 0x65})
+
+    /** Get the bytes currently allocated by `category`, and the most that have been allocated
+    at once since the session was created or `resetPeakMemoryUsage` was last called.
+    */
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL getMemoryUsage(
+        SlangMemoryCategory category,
+        uint64_t* outCurrentBytes,
+        uint64_t* outPeakBytes) = 0;
+
+    /** Make the peaks the bytes currently allocated, such as before compiling a program whose
+    peak is of interest.
+    */
+    virtual SLANG_NO_THROW void SLANG_MCALL resetPeakMemoryUsage() = 0;
+};
+
+    #define SLANG_UUID_IMemoryStats IMemoryStats::getTypeGuid()
+
+/* Interface for canceling the compilations of a session from another thread. It is queried from
+an `ISession`, or from an `ICompileRequest` for the session of the request.
+
+A canceled compilation stops at the next point it checks for cancellation, such as between IR
+passes or between the declarations being checked, and the call that started it fails with
+`SLANG_E_CANCELED`, or in the case of loading a module returns nullptr. The session stays
+canceled, and every compilation started on it fails the same way, until `resetCancellation` is
+called. Results generated before the cancellation stay valid. */
+struct ICompileCancellation : public ISlangUnknown
+{
+    // uuidgen output:     4e8b2d17 -  c5a9 -  4f3e -    8d61 -      0b7f93e2c4a8
+    SLANG_COM_INTERFACE(
+        0x4e8b2d17,
+        0xc5a9,
+        0x4f3e,
+        {0x8d, 0x61, 0x0b, 0x7f, 0x93, 0xe2, 0xc4, 0xa8})
+
+    /** Cancel the compilations of the session. */
+    virtual SLANG_NO_THROW void SLANG_MCALL cancel() = 0;
+
+    /** Cancel the compilations of the session once `milliseconds` have passed, unless
+    `resetCancellation` is called before then. This can be used to bound the time taken by the
+    compilations started from now on.
+    */
+    virtual SLANG_NO_THROW void SLANG_MCALL cancelAfter(uint32_t milliseconds) = 0;
+
+    /** Stop canceling compilations, and forget any time set by `cancelAfter`. */
+    virtual SLANG_NO_THROW void SLANG_MCALL resetCancellation() = 0;
+
+    /** True if compilations are being canceled. */
+    virtual SLANG_NO_THROW bool SLANG_MCALL isCanceled() = 0;
+};
+
+    #define SLANG_UUID_ICompileCancellation ICompileCancellation::getTypeGuid()
 } // namespace slang
 
     // Passed into functions to create globalSession to identify the API version client code is
@@ -9,6 +9,22 @@
 #endif
 #endif
 
+// Marks the loop that follows for the compiler to vectorize, running WIDTH of its iterations in
+// the lanes of SIMD instructions. The iterations must not depend on each other.
+#ifndef SLANG_PRELUDE_SIMD_LOOP
+#define SLANG_PRELUDE_PRAGMA(X) _Pragma(#X)
+#if defined(__clang__)
+#define SLANG_PRELUDE_SIMD_LOOP(WIDTH) \
+    SLANG_PRELUDE_PRAGMA(clang loop vectorize(enable) vectorize_width(WIDTH))
+#elif defined(__GNUC__)
+#define SLANG_PRELUDE_SIMD_LOOP(WIDTH) SLANG_PRELUDE_PRAGMA(GCC ivdep)
+#elif defined(_MSC_VER)
+#define SLANG_PRELUDE_SIMD_LOOP(WIDTH) __pragma(loop(ivdep))
+#else
+#define SLANG_PRELUDE_SIMD_LOOP(WIDTH)
+#endif
+#endif
+
 // Since we are using unsigned arithmatic care is need in this comparison.
 // It is *assumed* that sizeInBytes >= elemSize. Which means (sizeInBytes >= elemSize) >= 0
 // Which means only a single test is needed
@@ -1,3 +1,6 @@
+#ifndef SLANG_CUDA_PRELUDE_H
+#define SLANG_CUDA_PRELUDE_H
+
 #define SLANG_PRELUDE_EXPORT
 
 #ifdef __CUDACC_RTC__
@@ -3321,3 +3324,157 @@ struct TensorView
         *reinterpret_cast<T*>(data + offset) = val;
     }
 };
+
+// A view of a tensor whose innermost dimension is contiguous, used for the parameters of the
+// contiguous variant of a kernel.
+//
+// An access with an index for every dimension of the tensor steps over the innermost one by the
+// size of the element, which is known at compile time, instead of by a stride read at runtime.
+// Accesses with fewer indices only use the strides, as in `TensorView`.
+struct ContiguousTensorView : TensorView
+{
+    template<typename T>
+    __device__ uint8_t* at(const uint32_t* index, unsigned int indexCount)
+    {
+        uint64_t offset = 0;
+        for (unsigned int i = 0; i + 1 < indexCount; ++i)
+        {
+            offset += strides[i] * index[i];
+        }
+        uint32_t innermostStride =
+            indexCount == dimensionCount ? uint32_t(sizeof(T)) : strides[indexCount - 1];
+        return data + offset + uint64_t(innermostStride) * index[indexCount - 1];
+    }
+
+    template<typename T>
+    __device__ T* data_ptr_at(uint32_t index)
+    {
+        return reinterpret_cast<T*>(at<T>(&index, 1));
+    }
+
+    template<typename T>
+    __device__ T* data_ptr_at(uint2 index)
+    {
+        uint32_t indices[] = {index.x, index.y};
+        return reinterpret_cast<T*>(at<T>(indices, 2));
+    }
+
+    template<typename T>
+    __device__ T* data_ptr_at(uint3 index)
+    {
+        uint32_t indices[] = {index.x, index.y, index.z};
+        return reinterpret_cast<T*>(at<T>(indices, 3));
+    }
+
+    template<typename T>
+    __device__ T* data_ptr_at(uint4 index)
+    {
+        uint32_t indices[] = {index.x, index.y, index.z, index.w};
+        return reinterpret_cast<T*>(at<T>(indices, 4));
+    }
+
+    template<typename T, unsigned int N>
+    __device__ T* data_ptr_at(uint index[N])
+    {
+        return reinterpret_cast<T*>(at<T>(index, N));
+    }
+
+    template<typename T>
+    __device__ T& load(uint32_t x)
+    {
+        return *data_ptr_at<T>(x);
+    }
+    template<typename T>
+    __device__ T& load(uint32_t x, uint32_t y)
+    {
+        return *data_ptr_at<T>(make_uint2(x, y));
+    }
+    template<typename T>
+    __device__ T& load(uint2 index)
+    {
+        return *data_ptr_at<T>(index);
+    }
+    template<typename T>
+    __device__ T& load(uint32_t x, uint32_t y, uint32_t z)
+    {
+        return *data_ptr_at<T>(make_uint3(x, y, z));
+    }
+    template<typename T>
+    __device__ T& load(uint3 index)
+    {
+        return *data_ptr_at<T>(index);
+    }
+    template<typename T>
+    __device__ T& load(uint32_t x, uint32_t y, uint32_t z, uint32_t w)
+    {
+        return *data_ptr_at<T>(make_uint4(x, y, z, w));
+    }
+    template<typename T>
+    __device__ T& load(uint4 index)
+    {
+        return *data_ptr_at<T>(index);
+    }
+    template<typename T>
+    __device__ T& load(uint32_t i0, uint32_t i1, uint32_t i2, uint32_t i3, uint32_t i4)
+    {
+        uint32_t indices[] = {i0, i1, i2, i3, i4};
+        return *reinterpret_cast<T*>(at<T>(indices, 5));
+    }
+
+    // Generic version of load
+    template<typename T, unsigned int N>
+    __device__ T& load(uint index[N])
+    {
+        return *reinterpret_cast<T*>(at<T>(index, N));
+    }
+
+    template<typename T>
+    __device__ void store(uint32_t x, T val)
+    {
+        load<T>(x) = val;
+    }
+    template<typename T>
+    __device__ void store(uint32_t x, uint32_t y, T val)
+    {
+        load<T>(x, y) = val;
+    }
+    template<typename T>
+    __device__ void store(uint2 index, T val)
+    {
+        load<T>(index) = val;
+    }
+    template<typename T>
+    __device__ void store(uint32_t x, uint32_t y, uint32_t z, T val)
+    {
+        load<T>(x, y, z) = val;
+    }
+    template<typename T>
+    __device__ void store(uint3 index, T val)
+    {
+        load<T>(index) = val;
+    }
+    template<typename T>
+    __device__ void store(uint32_t x, uint32_t y, uint32_t z, uint32_t w, T val)
+    {
+        load<T>(x, y, z, w) = val;
+    }
+    template<typename T>
+    __device__ void store(uint4 index, T val)
+    {
+        load<T>(index) = val;
+    }
+    template<typename T>
+    __device__ void store(uint32_t i0, uint32_t i1, uint32_t i2, uint32_t i3, uint32_t i4, T val)
+    {
+        load<T>(i0, i1, i2, i3, i4) = val;
+    }
+
+    // Generic version
+    template<typename T, unsigned int N>
+    __device__ void store(uint index[N], T val)
+    {
+        *reinterpret_cast<T*>(at<T>(index, N)) = val;
+    }
+};
+
+#endif // SLANG_CUDA_PRELUDE_H
@@ -77,6 +77,18 @@ struct TensorView
     uint32_t dimensionCount;
 };
 
+// The host side of the `ContiguousTensorView` that the contiguous variant of a kernel takes,
+// which has the same layout as a `TensorView`.
+struct ContiguousTensorView : TensorView
+{
+};
+
+// Can the contiguous variant of a kernel be launched with a view of the tensor?
+bool is_innermost_contiguous(torch::Tensor val)
+{
+    return val.dim() == 0 || val.size(-1) <= 1 || val.stride(-1) == 1;
+}
+
 
 TensorView make_tensor_view(
     torch::Tensor val,
@@ -178,4 +190,55 @@ TensorView make_tensor_view(
     return res;
 }
 
+// The view made for a tensor at some place in the host code, along with the metadata of the
+// tensor it was made for.
+struct TensorViewCache
+{
+    c10::TensorImpl* tensorImpl = nullptr;
+    void* data = nullptr;
+    torch::ScalarType scalarType = torch::kFloat32;
+    int64_t dimensionCount = -1;
+    int64_t sizes[kSlangTorchTensorMaxDim];
+    int64_t strides[kSlangTorchTensorMaxDim];
+    TensorView view;
+
+    bool matches(const torch::Tensor& val)
+    {
+        if (val.unsafeGetTensorImpl() != tensorImpl || val.data_ptr() != data ||
+            val.scalar_type() != scalarType || val.dim() != dimensionCount)
+            return false;
+        for (int64_t i = 0; i < dimensionCount; ++i)
+        {
+            if (val.size(i) != sizes[i] || val.stride(i) != strides[i])
+                return false;
+        }
+        return true;
+    }
+};
+
+// Make a view of a tensor, or reuse the one in the cache when it was made for the same tensor
+// with the same data, shape and strides, which have all been checked already.
+TensorView make_tensor_view(
+    torch::Tensor val,
+    const char* name,
+    torch::ScalarType targetScalarType,
+    bool requireContiguous,
+    TensorViewCache& cache)
+{
+    if (cache.matches(val))
+        return cache.view;
+
+    cache.view = make_tensor_view(val, name, targetScalarType, requireContiguous);
+    cache.tensorImpl = val.unsafeGetTensorImpl();
+    cache.data = val.data_ptr();
+    cache.scalarType = val.scalar_type();
+    cache.dimensionCount = val.dim();
+    for (int64_t i = 0; i < cache.dimensionCount; ++i)
+    {
+        cache.sizes[i] = val.size(i);
+        cache.strides[i] = val.stride(i);
+    }
+    return cache.view;
+}
+
 #define SLANG_PRELUDE_EXPORT
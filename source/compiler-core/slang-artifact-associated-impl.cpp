@@ -339,5 +339,49 @@ SlangResult ArtifactPostEmitMetadata::isParameterLocationUsed(
     return SLANG_OK;
 }
 
+SlangResult ArtifactPostEmitMetadata::getUniformDataOffset(
+    SlangParameterCategory category,
+    SlangUInt spaceIndex,
+    SlangUInt registerIndex,
+    SlangUInt offset,
+    SlangUInt& outOffset,
+    bool& outUsed)
+{
+    // The data of buffers that weren't trimmed is where the reflected layout says.
+    bool isBufferTrimmed = false;
+    for (const auto& field : m_uniformFields)
+    {
+        if (!field.isInBuffer((slang::ParameterCategory)category, spaceIndex, registerIndex))
+            continue;
+        isBufferTrimmed = true;
+
+        if (offset < field.offset || offset >= field.offset + field.size)
+            continue;
+        outUsed = field.isUsed;
+        outOffset = field.isUsed ? field.compiledOffset + (offset - field.offset) : 0;
+        return SLANG_OK;
+    }
+
+    // Otherwise the data is padding between the fields of a trimmed buffer.
+    outUsed = !isBufferTrimmed;
+    outOffset = isBufferTrimmed ? 0 : offset;
+    return SLANG_OK;
+}
+
+SlangResult ArtifactPostEmitMetadata::getShaderCost(
+    const char* entryPointName,
+    slang::ShaderCost& outCost)
+{
+    for (const auto& entry : m_shaderCosts)
+    {
+        if (!entryPointName || entry.entryPointName == entryPointName)
+        {
+            outCost = entry.cost;
+            return SLANG_OK;
+        }
+    }
+    return SLANG_E_NOT_FOUND;
+}
+
 
 } // namespace Slang
@@ -170,6 +170,37 @@ struct ShaderBindingRange
     }
 };
 
+/// Where a field of a constant buffer whose unused fields were removed is in the compiled shader.
+struct ShaderUniformFieldLocation
+{
+    // The binding of the buffer.
+    slang::ParameterCategory category = slang::ParameterCategory::None;
+    UInt spaceIndex = 0;
+    UInt registerIndex = 0;
+
+    // The offset and size in bytes of the field in the reflected layout of the buffer.
+    UInt offset = 0;
+    UInt size = 0;
+
+    // Whether the compiled shader still has the field, and its offset there.
+    bool isUsed = true;
+    UInt compiledOffset = 0;
+
+    bool isInBuffer(slang::ParameterCategory _category, UInt _spaceIndex, UInt _registerIndex)
+        const
+    {
+        return category == _category && spaceIndex == _spaceIndex &&
+               registerIndex == _registerIndex;
+    }
+};
+
+/// The static cost of an entry point in the compiled code.
+struct EntryPointShaderCost
+{
+    String entryPointName;
+    slang::ShaderCost cost;
+};
+
 class ArtifactPostEmitMetadata : public ComBaseObject, public IArtifactPostEmitMetadata
 {
 public:
@@ -194,6 +225,16 @@ public:
         SlangUInt spaceIndex,            // `space` for D3D12, `set` for Vulkan
         SlangUInt registerIndex,         // `register` for D3D12, `binding` for Vulkan
         bool& outUsed) SLANG_OVERRIDE;
+    SLANG_NO_THROW virtual SlangResult getUniformDataOffset(
+        SlangParameterCategory category,
+        SlangUInt spaceIndex,
+        SlangUInt registerIndex,
+        SlangUInt offset,
+        SlangUInt& outOffset,
+        bool& outUsed) SLANG_OVERRIDE;
+    SLANG_NO_THROW virtual SlangResult getShaderCost(
+        const char* entryPointName,
+        slang::ShaderCost& outCost) SLANG_OVERRIDE;
 
     void* getInterface(const Guid& uuid);
     void* getObject(const Guid& uuid);
@@ -205,6 +246,8 @@ public:
 
     List<ShaderBindingRange> m_usedBindings;
     List<String> m_exportedFunctionMangledNames;
+    List<ShaderUniformFieldLocation> m_uniformFields;
+    List<EntryPointShaderCost> m_shaderCosts;
 };
 
 } // namespace Slang
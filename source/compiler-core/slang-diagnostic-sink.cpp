@@ -616,7 +616,8 @@ Severity DiagnosticSink::getEffectiveMessageSeverity(DiagnosticInfo const& info)
 {
     Severity effectiveSeverity = info.severity;
 
-    Severity* pSeverityOverride = m_severityOverrides.tryGetValue(info.id);
+    Severity* pSeverityOverride =
+        m_severityOverrides.getCount() ? m_severityOverrides.tryGetValue(info.id) : nullptr;
 
     // See if there is an override
     if (pSeverityOverride)
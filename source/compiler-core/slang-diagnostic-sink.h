@@ -229,6 +229,15 @@ public:
     /// Test if flag is set
     bool isFlagSet(Flag::Enum flag) { return (m_flags & Flags(flag)) != 0; }
 
+    /// Returns false if diagnostics of the kind `info` are disabled, and would not be reported.
+    ///
+    /// Diagnosing a disabled diagnostic is already cheap, so this is for callers that do
+    /// work, such as an analysis, only to find out what to diagnose.
+    bool isDiagnosticEnabled(DiagnosticInfo const& info)
+    {
+        return getEffectiveMessageSeverity(info) != Severity::Disable;
+    }
+
     /// Sets an override on the severity of a specific diagnostic message (by numeric identifier)
     /// info can be set to nullptr if only to override
     void overrideDiagnosticSeverity(
@@ -1,6 +1,10 @@
 // slang-downstream-compiler-set.cpp
 #include "slang-downstream-compiler-set.h"
 
+#include "slang-artifact-associated-impl.h"
+#include "slang-artifact-desc-util.h"
+#include "slang-artifact-util.h"
+
 namespace Slang
 {
 
@@ -96,4 +100,309 @@ void DownstreamCompilerSet::addCompiler(IDownstreamCompiler* compiler)
     }
 }
 
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! Result cache !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!*/
+
+static void _appendSlice(DigestBuilder<SHA1>& builder, const CharSlice& slice)
+{
+    // Include the count, so that adjacent slices can't be confused.
+    builder.append(slice.count);
+    builder.append(slice.data, slice.count);
+}
+
+static SlangResult _appendArtifact(DigestBuilder<SHA1>& builder, IArtifact* artifact)
+{
+    ComPtr<ISlangBlob> blob;
+    SLANG_RETURN_ON_FAIL(artifact->loadBlob(ArtifactKeep::Yes, blob.writeRef()));
+
+    const auto desc = artifact->getDesc();
+    builder.append(desc.kind);
+    builder.append(desc.payload);
+    builder.append(desc.style);
+    builder.append(desc.flags);
+
+    const char* name = artifact->getName();
+    _appendSlice(builder, CharSlice(name ? name : ""));
+
+    builder.append(Int64(blob->getBufferSize()));
+    builder.append(blob);
+    return SLANG_OK;
+}
+
+/* static */ SlangResult DownstreamCompilerSet::calcResultCacheKey(
+    IDownstreamCompiler* compiler,
+    const DownstreamCompileOptions& options,
+    SHA1::Digest& outKey)
+{
+    // Outputs that are files to be loaded or run aren't just a blob, so can't be cached.
+    switch (ArtifactDescUtil::makeDescForCompileTarget(options.targetType).kind)
+    {
+    case ArtifactKind::Executable:
+    case ArtifactKind::SharedLibrary:
+        return SLANG_E_NOT_AVAILABLE;
+    default:
+        break;
+    }
+
+    DigestBuilder<SHA1> builder;
+    builder.append(UnownedStringSlice::fromLiteral("downstreamResult"));
+
+    // The compiler, including its exact version if it has one
+    const auto& desc = compiler->getDesc();
+    builder.append(desc.type);
+    builder.append(desc.version.toInteger());
+    {
+        ComPtr<ISlangBlob> versionString;
+        if (SLANG_SUCCEEDED(compiler->getVersionString(versionString.writeRef())) &&
+            versionString)
+        {
+            builder.append(versionString);
+        }
+    }
+
+    builder.append(options.optimizationLevel);
+    builder.append(options.debugInfoType);
+    builder.append(options.targetType);
+    builder.append(options.sourceLanguage);
+    builder.append(options.floatingPointMode);
+    builder.append(options.pipelineType);
+    builder.append(options.matrixLayout);
+    builder.append(options.flags);
+    builder.append(options.platform);
+    builder.append(options.stage);
+    builder.append(options.m_debugInfoFormat);
+    builder.append(options.spirvOptimizationPreset);
+
+    _appendSlice(builder, options.modulePath);
+    _appendSlice(builder, options.entryPointName);
+    _appendSlice(builder, options.profileName);
+
+    builder.append(options.defines.count);
+    for (const auto& define : options.defines)
+    {
+        _appendSlice(builder, define.nameWithSig);
+        _appendSlice(builder, define.value);
+    }
+
+    builder.append(options.sourceArtifacts.count);
+    for (auto sourceArtifact : options.sourceArtifacts)
+    {
+        SLANG_RETURN_ON_FAIL(_appendArtifact(builder, sourceArtifact));
+    }
+
+    builder.append(options.libraries.count);
+    for (auto library : options.libraries)
+    {
+        SLANG_RETURN_ON_FAIL(_appendArtifact(builder, library));
+    }
+
+    builder.append(options.includePaths.count);
+    for (const auto& path : options.includePaths)
+        _appendSlice(builder, path);
+
+    builder.append(options.libraryPaths.count);
+    for (const auto& path : options.libraryPaths)
+        _appendSlice(builder, path);
+
+    builder.append(options.requiredCapabilityVersions.count);
+    for (const auto& capabilityVersion : options.requiredCapabilityVersions)
+    {
+        builder.append(capabilityVersion.kind);
+        builder.append(capabilityVersion.version.toInteger());
+    }
+
+    builder.append(options.compilerSpecificArguments.count);
+    for (const auto& arg : options.compilerSpecificArguments)
+        _appendSlice(builder, arg);
+
+    outKey = builder.finalize();
+    return SLANG_OK;
+}
+
+static bool _isResultCacheable(IArtifact* artifact)
+{
+    // Anything associated with the result other than (empty) diagnostics, such as debug
+    // information, would be lost by caching just the result blob.
+    for (auto associated : artifact->getAssociated())
+    {
+        if (associated->getDesc().payload != ArtifactPayload::Diagnostics)
+            return false;
+    }
+
+    // Diagnostics would not be reported again on a cache hit.
+    if (auto diagnostics = findAssociatedRepresentation<IArtifactDiagnostics>(artifact))
+    {
+        if (SLANG_FAILED(diagnostics->getResult()) || diagnostics->getCount() != 0)
+            return false;
+    }
+    return true;
+}
+
+static ComPtr<IArtifact> _createCachedResultArtifact(
+    const DownstreamCompileOptions& options,
+    ISlangBlob* blob)
+{
+    auto artifact = ArtifactUtil::createArtifactForCompileTarget(options.targetType);
+    artifact->addRepresentationUnknown(blob);
+
+    // Compilers always associate diagnostics with their results, so do the same here.
+    auto diagnostics = ArtifactDiagnostics::create();
+    ArtifactUtil::addAssociated(artifact, diagnostics);
+    return artifact;
+}
+
+void DownstreamCompilerSet::_addResultToMemory(const SHA1::Digest& key, ISlangBlob* blob)
+{
+    if (m_resultCache.addIfNotExists(key, ComPtr<ISlangBlob>(blob)))
+    {
+        m_resultCacheOrder.add(key);
+    }
+    _trimResultCache();
+}
+
+void DownstreamCompilerSet::_trimResultCache()
+{
+    while (m_resultCacheOrder.getCount() > m_resultCacheMaxEntryCount)
+    {
+        m_resultCache.remove(m_resultCacheOrder[0]);
+        m_resultCacheOrder.removeAt(0);
+    }
+    while (m_hostCallableCacheOrder.getCount() > m_resultCacheMaxEntryCount)
+    {
+        m_hostCallableCache.remove(m_hostCallableCacheOrder[0]);
+        m_hostCallableCacheOrder.removeAt(0);
+    }
+}
+
+SlangResult DownstreamCompilerSet::_compileHostCallableWithResultCache(
+    IDownstreamCompiler* compiler,
+    const DownstreamCompileOptions& options,
+    const SHA1::Digest& key,
+    IArtifact** outArtifact)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_resultCacheMutex);
+        if (auto sharedLibrary = m_hostCallableCache.tryGetValue(key))
+        {
+            m_resultCacheStats.memoryHitCount++;
+
+            auto artifact = ArtifactUtil::createArtifactForCompileTarget(options.targetType);
+            artifact->addRepresentation(*sharedLibrary);
+            ArtifactUtil::addAssociated(artifact, ArtifactDiagnostics::create());
+            *outArtifact = artifact.detach();
+            return SLANG_OK;
+        }
+    }
+
+    ComPtr<IArtifact> artifact;
+    SLANG_RETURN_ON_FAIL(compiler->compile(options, artifact.writeRef()));
+
+    // Holding a reference to the shared library keeps the code it was compiled to loaded.
+    ComPtr<ISlangSharedLibrary> sharedLibrary;
+    if (_isResultCacheable(artifact) &&
+        SLANG_SUCCEEDED(artifact->loadSharedLibrary(ArtifactKeep::Yes, sharedLibrary.writeRef())))
+    {
+        std::lock_guard<std::mutex> lock(m_resultCacheMutex);
+        m_resultCacheStats.missCount++;
+        if (m_hostCallableCache.addIfNotExists(key, sharedLibrary))
+        {
+            m_hostCallableCacheOrder.add(key);
+        }
+        _trimResultCache();
+    }
+
+    *outArtifact = artifact.detach();
+    return SLANG_OK;
+}
+
+SlangResult DownstreamCompilerSet::compileWithResultCache(
+    IDownstreamCompiler* compiler,
+    const DownstreamCompileOptions& options,
+    PersistentCache* persistentCache,
+    IArtifact** outArtifact)
+{
+    SHA1::Digest key;
+    if (SLANG_FAILED(calcResultCacheKey(compiler, options, key)))
+    {
+        return compiler->compile(options, outArtifact);
+    }
+
+    if (ArtifactDescUtil::makeDescForCompileTarget(options.targetType).kind ==
+        ArtifactKind::HostCallable)
+    {
+        return _compileHostCallableWithResultCache(compiler, options, key, outArtifact);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_resultCacheMutex);
+        if (auto blob = m_resultCache.tryGetValue(key))
+        {
+            m_resultCacheStats.memoryHitCount++;
+            *outArtifact = _createCachedResultArtifact(options, *blob).detach();
+            return SLANG_OK;
+        }
+    }
+
+    if (persistentCache)
+    {
+        ComPtr<ISlangBlob> blob;
+        if (SLANG_SUCCEEDED(persistentCache->readEntry(key, blob.writeRef())))
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_resultCacheMutex);
+                m_resultCacheStats.persistentHitCount++;
+                _addResultToMemory(key, blob);
+            }
+            *outArtifact = _createCachedResultArtifact(options, blob).detach();
+            return SLANG_OK;
+        }
+    }
+
+    // The compile itself happens outside of the lock, so different compiles can run at
+    // the same time.
+    ComPtr<IArtifact> artifact;
+    SLANG_RETURN_ON_FAIL(compiler->compile(options, artifact.writeRef()));
+
+    ComPtr<ISlangBlob> blob;
+    if (_isResultCacheable(artifact) &&
+        SLANG_SUCCEEDED(artifact->loadBlob(ArtifactKeep::Yes, blob.writeRef())))
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_resultCacheMutex);
+            m_resultCacheStats.missCount++;
+            _addResultToMemory(key, blob);
+        }
+        if (persistentCache)
+        {
+            // Failing to write to the cache doesn't fail the compile.
+            persistentCache->writeEntry(key, blob);
+        }
+    }
+
+    *outArtifact = artifact.detach();
+    return SLANG_OK;
+}
+
+DownstreamCompilerSet::ResultCacheStats DownstreamCompilerSet::getResultCacheStats()
+{
+    std::lock_guard<std::mutex> lock(m_resultCacheMutex);
+    return m_resultCacheStats;
+}
+
+void DownstreamCompilerSet::clearResultCache()
+{
+    std::lock_guard<std::mutex> lock(m_resultCacheMutex);
+    m_resultCache.clear();
+    m_resultCacheOrder.clear();
+    m_hostCallableCache.clear();
+    m_hostCallableCacheOrder.clear();
+    m_resultCacheStats = ResultCacheStats();
+}
+
+void DownstreamCompilerSet::setResultCacheMaxEntryCount(Count maxEntryCount)
+{
+    std::lock_guard<std::mutex> lock(m_resultCacheMutex);
+    m_resultCacheMaxEntryCount = maxEntryCount > 0 ? maxEntryCount : 0;
+    _trimResultCache();
+}
+
 } // namespace Slang
@@ -1,8 +1,12 @@
 #ifndef SLANG_DOWNSTREAM_COMPILER_SET_H
 #define SLANG_DOWNSTREAM_COMPILER_SET_H
 
+#include "../core/slang-crypto.h"
+#include "../core/slang-persistent-cache.h"
 #include "slang-downstream-compiler.h"
 
+#include <mutex>
+
 namespace Slang
 {
 
@@ -43,9 +47,53 @@ public:
     bool hasSharedLibrary(ISlangSharedLibrary* lib);
     void addSharedLibrary(ISlangSharedLibrary* lib);
 
+    /// Compile with `compiler`, reusing the result of an earlier compile with the same key.
+    ///
+    /// Successful results with no diagnostics and no associated artifacts are kept in memory,
+    /// and also written to `persistentCache` if it is set. A compile that isn't cacheable (see
+    /// `calcResultCacheKey`) just invokes the compiler.
+    ///
+    /// Host callable results are JIT compiled code, so the loaded shared library is kept alive
+    /// in memory instead, and reused by compiles with the same key. They aren't written to
+    /// `persistentCache`.
+    ///
+    /// Files included by the source are not part of the key, so this should only be used
+    /// for self contained (typically generated) source.
+    SlangResult compileWithResultCache(
+        IDownstreamCompiler* compiler,
+        const DownstreamCompileOptions& options,
+        PersistentCache* persistentCache,
+        IArtifact** outArtifact);
+
+    /// Calculate the result cache key for compiling `options` with `compiler`.
+    /// Returns SLANG_E_NOT_AVAILABLE if results for the compile can't be cached, which is
+    /// when the output is an executable or shared library file.
+    static SlangResult calcResultCacheKey(
+        IDownstreamCompiler* compiler,
+        const DownstreamCompileOptions& options,
+        SHA1::Digest& outKey);
+
+    struct ResultCacheStats
+    {
+        Count memoryHitCount = 0;     ///< Results found in memory
+        Count persistentHitCount = 0; ///< Results found in the persistent cache
+        Count missCount = 0;          ///< Cacheable compiles that invoked the compiler
+    };
+
+    ResultCacheStats getResultCacheStats();
+    /// Remove all results held in memory, and reset the stats
+    void clearResultCache();
+
+    /// Set the maximum number of results held in memory, where 0 disables holding results in
+    /// memory. The oldest are removed first.
+    void setResultCacheMaxEntryCount(Count maxEntryCount);
+
     ~DownstreamCompilerSet()
     {
-        // A compiler may be implemented in a shared library, so release all first.
+        // A compiler may be implemented in a shared library, so release all first, along with
+        // any host callable results it loaded.
+        m_hostCallableCache.clear();
+        m_hostCallableCacheOrder.clear();
         m_compilers.clearAndDeallocate();
         for (auto& defaultCompiler : m_defaultCompilers)
         {
@@ -66,6 +114,26 @@ protected:
     List<ComPtr<IDownstreamCompiler>> m_compilers;
 
     List<ComPtr<ISlangSharedLibrary>> m_sharedLibraries;
+
+    void _addResultToMemory(const SHA1::Digest& key, ISlangBlob* blob);
+    void _trimResultCache();
+
+    SlangResult _compileHostCallableWithResultCache(
+        IDownstreamCompiler* compiler,
+        const DownstreamCompileOptions& options,
+        const SHA1::Digest& key,
+        IArtifact** outArtifact);
+
+    // Guards the result cache, which may be used from multiple sessions at once.
+    std::mutex m_resultCacheMutex;
+    Dictionary<SHA1::Digest, ComPtr<ISlangBlob>> m_resultCache;
+    // Keys of m_resultCache in the order they were added, oldest first.
+    List<SHA1::Digest> m_resultCacheOrder;
+    // The loaded host callable results, with their keys in the order they were added.
+    Dictionary<SHA1::Digest, ComPtr<ISlangSharedLibrary>> m_hostCallableCache;
+    List<SHA1::Digest> m_hostCallableCacheOrder;
+    Count m_resultCacheMaxEntryCount = 256;
+    ResultCacheStats m_resultCacheStats;
 };
 
 } // namespace Slang
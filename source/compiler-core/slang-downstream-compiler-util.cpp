@@ -4,7 +4,9 @@
 #include "../core/slang-blob.h"
 #include "../core/slang-char-util.h"
 #include "../core/slang-common.h"
+#include "../core/slang-crypto.h"
 #include "../core/slang-io.h"
+#include "../core/slang-process.h"
 #include "../core/slang-shared-library.h"
 #include "../core/slang-string-util.h"
 #include "../core/slang-type-text-util.h"
@@ -24,6 +26,8 @@
 #include "slang-tint-compiler.h"
 #include "slang-visual-studio-compiler-util.h"
 
+#include <stdio.h>
+
 namespace Slang
 {
 
@@ -517,4 +521,95 @@ static SlangResult _findPaths(
     }
 }
 
+/* static */ bool DownstreamCompilerUtil::findPrelude(
+    const UnownedStringSlice& source,
+    const UnownedStringSlice& includeGuard,
+    Index& outStart,
+    Index& outEnd)
+{
+    bool isInPrelude = false;
+    Index depth = 0;
+
+    const char* cur = source.begin();
+    while (cur < source.end())
+    {
+        const char* lineEnd = cur;
+        while (lineEnd < source.end() && *lineEnd != '\n')
+            lineEnd++;
+        const char* next = lineEnd < source.end() ? lineEnd + 1 : lineEnd;
+
+        const auto line = UnownedStringSlice(cur, lineEnd).trim();
+        if (line.startsWith("#"))
+        {
+            const auto directive = line.tail(1).trim();
+            if (!isInPrelude)
+            {
+                if (directive.startsWith("ifndef") && directive.tail(6).trim() == includeGuard)
+                {
+                    isInPrelude = true;
+                    depth = 1;
+                    outStart = Index(cur - source.begin());
+                }
+            }
+            // Matches #if, #ifdef and #ifndef.
+            else if (directive.startsWith("if"))
+            {
+                depth++;
+            }
+            else if (directive.startsWith("endif") && --depth == 0)
+            {
+                outEnd = Index(next - source.begin());
+                return true;
+            }
+        }
+        cur = next;
+    }
+    return false;
+}
+
+/* static */ SlangResult DownstreamCompilerUtil::requirePreludeHeader(
+    const UnownedStringSlice& prelude,
+    const UnownedStringSlice& key,
+    String& outPath)
+{
+    // There isn't a way to get the temporary directory, so use the one temporary files are
+    // made in.
+    String temporaryPath;
+    SLANG_RETURN_ON_FAIL(File::generateTemporary(toSlice("slang-prelude"), temporaryPath));
+    File::remove(temporaryPath);
+
+    DigestBuilder<SHA1> builder;
+    builder.append(prelude);
+    builder.append(key);
+
+    StringBuilder fileName;
+    fileName << "slang-prelude-" << builder.finalize().toString() << ".h";
+    const String path = Path::combine(Path::getParentDirectory(temporaryPath), fileName);
+
+    if (!File::exists(path))
+    {
+        StringBuilder writePath;
+        writePath << path << "." << Process::getId() << ".tmp";
+        SLANG_RETURN_ON_FAIL(File::writeAllBytes(writePath, prelude.begin(), prelude.getLength()));
+        SLANG_RETURN_ON_FAIL(replaceFile(writePath, path));
+    }
+
+    outPath = path;
+    return SLANG_OK;
+}
+
+/* static */ SlangResult DownstreamCompilerUtil::replaceFile(
+    const String& fromPath,
+    const String& toPath)
+{
+    if (::rename(fromPath.getBuffer(), toPath.getBuffer()) == 0)
+    {
+        return SLANG_OK;
+    }
+
+    // Another compile may have made the same file first.
+    File::remove(fromPath);
+    return File::exists(toPath) ? SLANG_OK : SLANG_FAIL;
+}
+
 } // namespace Slang
@@ -134,6 +134,28 @@ struct DownstreamCompilerUtil : public DownstreamCompilerUtilBase
 
     /// Append the desc as text
     static void appendAsText(const DownstreamCompilerDesc& desc, StringBuilder& out);
+
+    /// Find the prelude that a source emitter put in `source`, the block from `#ifndef
+    /// <includeGuard>` to its matching `#endif`. Returns false if `source` doesn't contain it.
+    static bool findPrelude(
+        const UnownedStringSlice& source,
+        const UnownedStringSlice& includeGuard,
+        Index& outStart,
+        Index& outEnd);
+
+    /// Get the path of a header holding `prelude`, in the temporary directory, named after a
+    /// hash of `prelude` and `key`. The header is written if an earlier compile hasn't already.
+    ///
+    /// Files that are made from the header, such as precompiled headers, can be named after its
+    /// path, and made with `replaceFile` so other processes never see them partially written.
+    static SlangResult requirePreludeHeader(
+        const UnownedStringSlice& prelude,
+        const UnownedStringSlice& key,
+        String& outPath);
+
+    /// Move the file at `fromPath` to `toPath` in a single step. If the move fails because
+    /// `toPath` already exists, `fromPath` is removed and the result is SLANG_OK.
+    static SlangResult replaceFile(const String& fromPath, const String& toPath);
 };
 
 } // namespace Slang
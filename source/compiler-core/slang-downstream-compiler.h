@@ -274,6 +274,9 @@ struct DownstreamCompileOptions
 
     // The debug info format to use.
     SlangDebugInfoFormat m_debugInfoFormat = SLANG_DEBUG_INFO_FORMAT_DEFAULT;
+
+    /// The passes to run when optimizing SPIR-V. If default, they depend on `optimizationLevel`.
+    SlangSpirvOptimizationPreset spirvOptimizationPreset = SLANG_SPIRV_OPTIMIZATION_PRESET_DEFAULT;
 };
 static_assert(std::is_trivially_copyable_v<DownstreamCompileOptions>);
 
@@ -337,6 +340,10 @@ public:
     /// Validate and return the result
     virtual SLANG_NO_THROW SlangResult SLANG_MCALL
     validate(const uint32_t* contents, int contentsSize) = 0;
+    /// Link the modules in `modules` into a single artifact, resolving the imports of each
+    /// against the exports of the others. Diagnostics are associated with the artifact.
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL
+    link(const Slice<IArtifact*>& modules, IArtifact** outArtifact) = 0;
 
     /// True if underlying compiler uses file system to communicate source
     virtual SLANG_NO_THROW bool SLANG_MCALL isFileBased() = 0;
@@ -374,6 +381,13 @@ public:
         SLANG_UNUSED(contentsSize);
         return SLANG_FAIL;
     }
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL
+    link(const Slice<IArtifact*>& modules, IArtifact** outArtifact) SLANG_OVERRIDE
+    {
+        SLANG_UNUSED(modules);
+        *outArtifact = nullptr;
+        return SLANG_E_NOT_IMPLEMENTED;
+    }
 
     DownstreamCompilerBase(const Desc& desc)
         : m_desc(desc)
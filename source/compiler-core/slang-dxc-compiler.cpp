@@ -17,6 +17,8 @@
 #include "slang-include-system.h"
 #include "slang-source-loc.h"
 
+#include <mutex>
+
 // Enable DXIL by default unless told not to
 #ifndef SLANG_ENABLE_DXIL_SUPPORT
 #if SLANG_APPLE_FAMILY
@@ -200,6 +202,30 @@ public:
     DXCDownstreamCompiler() {}
 
 protected:
+    /// The DXC objects a compile or disassembly uses. They can be reused by later
+    /// operations, but not by two operations at once.
+    struct Instances
+    {
+        ComPtr<IDxcCompiler> compiler;
+        ComPtr<IDxcLibrary> library;
+    };
+
+    /// Holds instances taken from the pool, and returns them when it goes out of scope.
+    struct ScopedInstances : Instances
+    {
+        ScopedInstances(DXCDownstreamCompiler* owner)
+            : m_owner(owner)
+        {
+        }
+        ~ScopedInstances() { m_owner->_releaseInstances(*this); }
+
+        DXCDownstreamCompiler* m_owner;
+    };
+
+    /// Take instances from the pool, creating them if the pool is empty.
+    SlangResult _acquireInstances(Instances& outInstances);
+    void _releaseInstances(Instances& instances);
+
     DxcCreateInstanceProc m_createInstance = nullptr;
 
     /// The commit hash associated with the DXC dll used
@@ -209,6 +235,12 @@ protected:
     uint32_t m_commitCount = 0;
 
     ComPtr<ISlangSharedLibrary> m_sharedLibrary;
+
+    // Creating the DXC compiler and library is a noticeable part of the time to compile a
+    // small shader, so the instances of finished operations are kept for later ones. They are
+    // declared after `m_sharedLibrary` so they are released before the library is.
+    std::mutex m_instancesMutex;
+    List<Instances> m_freeInstances;
 };
 
 static String _moveTaskMemAllocatedToString(char* chars)
@@ -303,6 +335,40 @@ SlangResult DXCDownstreamCompiler::init(ISlangSharedLibrary* library)
     return SLANG_OK;
 }
 
+SlangResult DXCDownstreamCompiler::_acquireInstances(Instances& outInstances)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_instancesMutex);
+        if (m_freeInstances.getCount())
+        {
+            outInstances = m_freeInstances.getLast();
+            m_freeInstances.removeLast();
+            return SLANG_OK;
+        }
+    }
+
+    SLANG_RETURN_ON_FAIL(m_createInstance(
+        CLSID_DxcCompiler,
+        __uuidof(outInstances.compiler),
+        (LPVOID*)outInstances.compiler.writeRef()));
+    SLANG_RETURN_ON_FAIL(m_createInstance(
+        CLSID_DxcLibrary,
+        __uuidof(outInstances.library),
+        (LPVOID*)outInstances.library.writeRef()));
+    return SLANG_OK;
+}
+
+void DXCDownstreamCompiler::_releaseInstances(Instances& instances)
+{
+    // Only complete sets are worth keeping.
+    if (!instances.compiler || !instances.library)
+        return;
+
+    std::lock_guard<std::mutex> lock(m_instancesMutex);
+    m_freeInstances.add(instances);
+    instances = Instances();
+}
+
 static SlangResult _parseDiagnosticLine(
     SliceAllocator& allocator,
     const UnownedStringSlice& line,
@@ -444,14 +510,10 @@ SlangResult DXCDownstreamCompiler::compile(const CompileOptions& inOptions, IArt
         }
     }
 
-    ComPtr<IDxcCompiler> dxcCompiler;
-    SLANG_RETURN_ON_FAIL(m_createInstance(
-        CLSID_DxcCompiler,
-        __uuidof(dxcCompiler),
-        (LPVOID*)dxcCompiler.writeRef()));
-    ComPtr<IDxcLibrary> dxcLibrary;
-    SLANG_RETURN_ON_FAIL(
-        m_createInstance(CLSID_DxcLibrary, __uuidof(dxcLibrary), (LPVOID*)dxcLibrary.writeRef()));
+    ScopedInstances instances(this);
+    SLANG_RETURN_ON_FAIL(_acquireInstances(instances));
+    IDxcCompiler* dxcCompiler = instances.compiler;
+    IDxcLibrary* dxcLibrary = instances.library;
 
     ComPtr<IDxcBlobEncoding> dxcSourceBlob = nullptr;
     ComPtr<ISlangBlob> sourceBlob;
@@ -796,14 +858,10 @@ SlangResult DXCDownstreamCompiler::convert(
     ComPtr<ISlangBlob> dxilBlob;
     SLANG_RETURN_ON_FAIL(from->loadBlob(ArtifactKeep::No, dxilBlob.writeRef()));
 
-    ComPtr<IDxcCompiler> dxcCompiler;
-    SLANG_RETURN_ON_FAIL(m_createInstance(
-        CLSID_DxcCompiler,
-        __uuidof(dxcCompiler),
-        (LPVOID*)dxcCompiler.writeRef()));
-    ComPtr<IDxcLibrary> dxcLibrary;
-    SLANG_RETURN_ON_FAIL(
-        m_createInstance(CLSID_DxcLibrary, __uuidof(dxcLibrary), (LPVOID*)dxcLibrary.writeRef()));
+    ScopedInstances instances(this);
+    SLANG_RETURN_ON_FAIL(_acquireInstances(instances));
+    IDxcCompiler* dxcCompiler = instances.compiler;
+    IDxcLibrary* dxcLibrary = instances.library;
 
     // Create blob from the input data
     ComPtr<IDxcBlobEncoding> dxcSourceBlob;
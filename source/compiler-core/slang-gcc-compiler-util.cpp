@@ -4,6 +4,7 @@
 #include "../core/slang-char-util.h"
 #include "../core/slang-common.h"
 #include "../core/slang-io.h"
+#include "../core/slang-process-util.h"
 #include "../core/slang-shared-library.h"
 #include "../core/slang-string-slice-pool.h"
 #include "../core/slang-string-util.h"
@@ -12,6 +13,7 @@
 #include "slang-artifact-representation-impl.h"
 #include "slang-artifact-util.h"
 #include "slang-com-helper.h"
+#include "slang-slice-allocator.h"
 
 namespace Slang
 {
@@ -487,15 +489,20 @@ static SlangResult _parseGCCFamilyLine(
     return SLANG_OK;
 }
 
-/* static */ SlangResult GCCDownstreamCompilerUtil::calcArgs(
-    const CompileOptions& options,
-    CommandLine& cmdLine)
+static PlatformKind _getPlatformKind(const DownstreamCompileOptions& options)
 {
-    SLANG_ASSERT(options.modulePath.count);
+    return (options.platform == PlatformKind::Unknown) ? PlatformUtil::getPlatformKind()
+                                                       : options.platform;
+}
 
-    PlatformKind platformKind = (options.platform == PlatformKind::Unknown)
-                                    ? PlatformUtil::getPlatformKind()
-                                    : options.platform;
+// Add the arguments that control how the source is parsed and what code is generated from it.
+// A precompiled header can only be used by compiles with the same arguments.
+static void _addCodeGenArgs(const DownstreamCompileOptions& options, CommandLine& cmdLine)
+{
+    typedef DownstreamCompileOptions CompileOptions;
+    typedef DownstreamCompileOptions::OptimizationLevel OptimizationLevel;
+    typedef DownstreamCompileOptions::DebugInfoType DebugInfoType;
+    typedef DownstreamCompileOptions::FloatingPointMode FloatingPointMode;
 
     const auto targetDesc = ArtifactDescUtil::makeDescForCompileTarget(options.targetType);
 
@@ -587,6 +594,53 @@ static SlangResult _parseGCCFamilyLine(
         }
     }
 
+    // Position independent code for shared libraries
+    if ((options.targetType == SLANG_SHADER_SHARED_LIBRARY ||
+         options.targetType == SLANG_HOST_SHARED_LIBRARY) &&
+        PlatformUtil::isFamily(PlatformFamily::Unix, _getPlatformKind(options)))
+    {
+        cmdLine.addArg("-fPIC");
+    }
+}
+
+// Add the defines and include paths
+static void _addPreprocessorArgs(const DownstreamCompileOptions& options, CommandLine& cmdLine)
+{
+    // Add defines
+    for (const auto& define : options.defines)
+    {
+        StringBuilder builder;
+
+        builder << "-D";
+        builder << define.nameWithSig;
+        if (define.value.count)
+        {
+            builder << "=" << asStringSlice(define.value);
+        }
+
+        cmdLine.addArg(builder);
+    }
+
+    // Add includes
+    for (const auto& include : options.includePaths)
+    {
+        cmdLine.addArg("-I");
+        cmdLine.addArg(asString(include));
+    }
+}
+
+/* static */ SlangResult GCCDownstreamCompilerUtil::calcArgs(
+    const CompileOptions& options,
+    CommandLine& cmdLine)
+{
+    SLANG_ASSERT(options.modulePath.count);
+
+    PlatformKind platformKind = _getPlatformKind(options);
+
+    const auto targetDesc = ArtifactDescUtil::makeDescForCompileTarget(options.targetType);
+
+    _addCodeGenArgs(options, cmdLine);
+
     StringBuilder moduleFilePath;
     SLANG_RETURN_ON_FAIL(ArtifactDescUtil::calcPathForDesc(
         targetDesc,
@@ -603,12 +657,6 @@ static SlangResult _parseGCCFamilyLine(
         {
             // Shared library
             cmdLine.addArg("-shared");
-
-            if (PlatformUtil::isFamily(PlatformFamily::Unix, platformKind))
-            {
-                // Position independent
-                cmdLine.addArg("-fPIC");
-            }
             break;
         }
     case SLANG_HOST_EXECUTABLE:
@@ -626,26 +674,12 @@ static SlangResult _parseGCCFamilyLine(
         break;
     }
 
-    // Add defines
-    for (const auto& define : options.defines)
-    {
-        StringBuilder builder;
+    _addPreprocessorArgs(options, cmdLine);
 
-        builder << "-D";
-        builder << define.nameWithSig;
-        if (define.value.count)
-        {
-            builder << "=" << asStringSlice(define.value);
-        }
-
-        cmdLine.addArg(builder);
-    }
-
-    // Add includes
-    for (const auto& include : options.includePaths)
+    // Add any compiler specific options
+    for (const auto& arg : options.compilerSpecificArguments)
     {
-        cmdLine.addArg("-I");
-        cmdLine.addArg(asString(include));
+        cmdLine.addArg(asString(arg));
     }
 
     // Link options
@@ -738,6 +772,122 @@ static SlangResult _parseGCCFamilyLine(
     return SLANG_OK;
 }
 
+/* static */ void GCCDownstreamCompilerUtil::calcPrecompiledHeaderArgs(
+    const CompileOptions& options,
+    const String& headerPath,
+    const String& outputPath,
+    CommandLine& cmdLine)
+{
+    _addCodeGenArgs(options, cmdLine);
+    _addPreprocessorArgs(options, cmdLine);
+    for (const auto& arg : options.compilerSpecificArguments)
+    {
+        cmdLine.addArg(asString(arg));
+    }
+
+    cmdLine.addArg("-x");
+    cmdLine.addArg(options.sourceLanguage == SLANG_SOURCE_LANGUAGE_C ? "c-header" : "c++-header");
+    cmdLine.addArg(headerPath);
+    cmdLine.addArg("-o");
+    cmdLine.addArg(outputPath);
+}
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! GCCDownstreamCompiler !!!!!!!!!!!!!!!!!!!!!!*/
+
+SlangResult GCCDownstreamCompiler::_requirePrecompiledPrelude(
+    const CompileOptions& options,
+    String& outHeaderPath)
+{
+    if (options.sourceLanguage != SLANG_SOURCE_LANGUAGE_CPP || options.sourceArtifacts.count != 1)
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    ComPtr<ISlangBlob> sourceBlob;
+    SLANG_RETURN_ON_FAIL(
+        options.sourceArtifacts[0]->loadBlob(ArtifactKeep::Yes, sourceBlob.writeRef()));
+    const auto source = StringUtil::getSlice(sourceBlob);
+
+    Index preludeStart = 0;
+    Index preludeEnd = 0;
+    if (!DownstreamCompilerUtil::findPrelude(
+            source,
+            toSlice("SLANG_CPP_PRELUDE_H"),
+            preludeStart,
+            preludeEnd))
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+    const auto prelude = source.subString(preludeStart, preludeEnd - preludeStart);
+
+    // The compiler only uses a precompiled header made by the same compiler with the same
+    // arguments, so the header is named after both.
+    CommandLine keyCmdLine;
+    Util::calcPrecompiledHeaderArgs(options, String(), String(), keyCmdLine);
+    StringBuilder key;
+    key << m_cmdLine.m_executableLocation.m_pathOrName;
+    for (const auto& arg : keyCmdLine.m_args)
+    {
+        key << " " << arg;
+    }
+
+    String headerPath;
+    SLANG_RETURN_ON_FAIL(
+        DownstreamCompilerUtil::requirePreludeHeader(prelude, key.getUnownedSlice(), headerPath));
+
+    // gcc and clang both look for a precompiled header next to a header passed with -include.
+    const String precompiledPath = headerPath + ".gch";
+    if (!File::exists(precompiledPath))
+    {
+        StringBuilder writePath;
+        writePath << precompiledPath << "." << Process::getId() << ".tmp";
+
+        CommandLine cmdLine(m_cmdLine);
+        Util::calcPrecompiledHeaderArgs(options, headerPath, writePath, cmdLine);
+
+        ExecuteResult exeRes;
+        if (SLANG_FAILED(ProcessUtil::execute(cmdLine, exeRes)) || exeRes.resultCode != 0 ||
+            !File::exists(writePath))
+        {
+            File::remove(writePath);
+            return SLANG_FAIL;
+        }
+        SLANG_RETURN_ON_FAIL(DownstreamCompilerUtil::replaceFile(writePath, precompiledPath));
+    }
+
+    outHeaderPath = headerPath;
+    return SLANG_OK;
+}
+
+SlangResult GCCDownstreamCompiler::compile(const CompileOptions& inOptions, IArtifact** outArtifact)
+{
+    if (!isVersionCompatible(inOptions))
+    {
+        // Not possible to compile with this version of the interface.
+        return SLANG_E_NOT_IMPLEMENTED;
+    }
+
+    CompileOptions options = getCompatibleVersion(&inOptions);
+
+    // Parsing the prelude is most of the work of compiling a small kernel, so it's precompiled
+    // and included ahead of the source. The copy of the prelude in the source is then skipped
+    // by its include guard. If it can't be precompiled the source is just compiled as is.
+    String preludeHeaderPath;
+    List<TerminatedCharSlice> args;
+    if (SLANG_SUCCEEDED(_requirePrecompiledPrelude(options, preludeHeaderPath)))
+    {
+        for (const auto& arg : options.compilerSpecificArguments)
+        {
+            args.add(arg);
+        }
+        args.add(TerminatedCharSlice("-include"));
+        args.add(SliceUtil::asTerminatedCharSlice(preludeHeaderPath));
+        options.compilerSpecificArguments = SliceUtil::asSlice(args);
+    }
+
+    return Super::compile(options, outArtifact);
+}
+
 /* static */ SlangResult GCCDownstreamCompilerUtil::createCompiler(
     const ExecutableLocation& exe,
     ComPtr<IDownstreamCompiler>& outCompiler)
@@ -22,6 +22,14 @@ struct GCCDownstreamCompilerUtil : public DownstreamCompilerUtilBase
     /// Calculate gcc family compilers (including clang) cmdLine arguments from options
     static SlangResult calcArgs(const CompileOptions& options, CommandLine& cmdLine);
 
+    /// Calculate the arguments to precompile the header at `headerPath` into `outputPath`, such
+    /// that compiles with `options` can use it.
+    static void calcPrecompiledHeaderArgs(
+        const CompileOptions& options,
+        const String& headerPath,
+        const String& outputPath,
+        CommandLine& cmdLine);
+
     /// Parse ExecuteResult into diagnostics
     static SlangResult parseOutput(const ExecuteResult& exeRes, IArtifactDiagnostics* diagnostics);
 
@@ -57,6 +65,10 @@ public:
     typedef CommandLineDownstreamCompiler Super;
     typedef GCCDownstreamCompilerUtil Util;
 
+    // IDownstreamCompiler
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL
+    compile(const CompileOptions& options, IArtifact** outArtifact) SLANG_OVERRIDE;
+
     // CommandLineCPPCompiler impl  - just forwards to the Util
     virtual SlangResult calcArgs(const CompileOptions& options, CommandLine& cmdLine) SLANG_OVERRIDE
     {
@@ -81,6 +93,11 @@ public:
         : Super(desc)
     {
     }
+
+protected:
+    /// Precompile the prelude at the start of the generated source of `options`, unless an
+    /// earlier compile already has. Outputs the path of the header to include in place of it.
+    SlangResult _requirePrecompiledPrelude(const CompileOptions& options, String& outHeaderPath);
 };
 
 } // namespace Slang
@@ -47,6 +47,8 @@ public:
         SLANG_OVERRIDE;
     virtual SLANG_NO_THROW SlangResult SLANG_MCALL
     validate(const uint32_t* contents, int contentsSize) SLANG_OVERRIDE;
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL
+    link(const Slice<IArtifact*>& modules, IArtifact** outArtifact) SLANG_OVERRIDE;
 
     /// Must be called before use
     SlangResult init(ISlangSharedLibrary* library);
@@ -63,6 +65,7 @@ protected:
     glslang_CompileFunc_1_1 m_compile_1_1 = nullptr;
     glslang_CompileFunc_1_2 m_compile_1_2 = nullptr;
     glslang_ValidateSPIRVFunc m_validate = nullptr;
+    glslang_LinkSPIRVFunc m_link = nullptr;
 
     ComPtr<ISlangSharedLibrary> m_sharedLibrary;
 
@@ -75,6 +78,7 @@ SlangResult GlslangDownstreamCompiler::init(ISlangSharedLibrary* library)
     m_compile_1_1 = (glslang_CompileFunc_1_1)library->findFuncByName("glslang_compile_1_1");
     m_compile_1_2 = (glslang_CompileFunc_1_2)library->findFuncByName("glslang_compile_1_2");
     m_validate = (glslang_ValidateSPIRVFunc)library->findFuncByName("glslang_validateSPIRV");
+    m_link = (glslang_LinkSPIRVFunc)library->findFuncByName("glslang_linkSPIRV");
 
 
     if (m_compile_1_0 == nullptr && m_compile_1_1 == nullptr && m_compile_1_2 == nullptr)
@@ -252,6 +256,7 @@ SlangResult GlslangDownstreamCompiler::compile(
 
     request.optimizationLevel = (unsigned)options.optimizationLevel;
     request.debugInfoType = (unsigned)options.debugInfoType;
+    request.spirvOptimizationPreset = (unsigned)options.spirvOptimizationPreset;
 
     request.entryPointName = options.entryPointName.begin();
 
@@ -305,6 +310,69 @@ SlangResult GlslangDownstreamCompiler::validate(const uint32_t* contents, int co
     return SLANG_FAIL;
 }
 
+SlangResult GlslangDownstreamCompiler::link(
+    const Slice<IArtifact*>& modules,
+    IArtifact** outArtifact)
+{
+    if (m_link == nullptr)
+    {
+        return SLANG_E_NOT_IMPLEMENTED;
+    }
+
+    // Keep the blobs in scope, as the request only holds their contents.
+    List<ComPtr<ISlangBlob>> blobs;
+    List<const uint32_t*> moduleWords;
+    List<size_t> moduleWordCounts;
+    for (auto module : modules)
+    {
+        ComPtr<ISlangBlob> blob;
+        SLANG_RETURN_ON_FAIL(module->loadBlob(ArtifactKeep::Yes, blob.writeRef()));
+        moduleWords.add((const uint32_t*)blob->getBufferPointer());
+        moduleWordCounts.add(blob->getBufferSize() / sizeof(uint32_t));
+        blobs.add(blob);
+    }
+
+    StringBuilder diagnosticOutput;
+    auto diagnosticOutputFunc = [](void const* data, size_t size, void* userData)
+    { (*(StringBuilder*)userData).append((char const*)data, (char const*)data + size); };
+    List<uint8_t> spirv;
+    auto outputFunc = [](void const* data, size_t size, void* userData)
+    { ((List<uint8_t>*)userData)->addRange((uint8_t*)data, size); };
+
+    glslang_LinkSPIRVRequest request;
+    memset(&request, 0, sizeof(request));
+    request.sizeInBytes = sizeof(request);
+    request.modules = moduleWords.getBuffer();
+    request.moduleWordCounts = moduleWordCounts.getBuffer();
+    request.moduleCount = size_t(moduleWords.getCount());
+    request.diagnosticFunc = diagnosticOutputFunc;
+    request.diagnosticUserData = &diagnosticOutput;
+    request.outputFunc = outputFunc;
+    request.outputUserData = &spirv;
+
+    const SlangResult linkResult = m_link(&request) == 0 ? SLANG_OK : SLANG_FAIL;
+
+    auto artifact = ArtifactUtil::createArtifactForCompileTarget(SLANG_SPIRV);
+
+    auto diagnostics = ArtifactDiagnostics::create();
+    diagnostics->setResult(linkResult);
+    ArtifactUtil::addAssociated(artifact, diagnostics);
+
+    if (SLANG_FAILED(linkResult))
+    {
+        // The linker's messages aren't in the form glslang uses, so they are reported as is.
+        diagnostics->setRaw(SliceUtil::asCharSlice(diagnosticOutput));
+        diagnostics->requireErrorDiagnostic();
+    }
+    else
+    {
+        artifact->addRepresentationUnknown(ListBlob::moveCreate(spirv));
+    }
+
+    *outArtifact = artifact.detach();
+    return SLANG_OK;
+}
+
 bool GlslangDownstreamCompiler::canConvert(const ArtifactDesc& from, const ArtifactDesc& to)
 {
     // Can only disassemble blobs that are SPIR-V
@@ -11,6 +11,75 @@
 namespace Slang
 {
 
+RefPtr<DirectoryListingCache::Listing> DirectoryListingCache::getListing(
+    const String& directoryPath)
+{
+    uint64_t modifiedTime = 0;
+    uint64_t size = 0;
+    if (SLANG_FAILED(File::getModifiedTimeAndSize(directoryPath, modifiedTime, size)))
+        return nullptr;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (auto listing = m_listings.tryGetValue(directoryPath))
+        {
+            if ((*listing)->modifiedTime == modifiedTime)
+                return *listing;
+        }
+    }
+
+    // The directory is listed without holding the lock, so that other directories can be
+    // looked up meanwhile. If the directory changes after its time was read, the listing is
+    // newer than its time, and will just be read again the next time it's needed.
+    RefPtr<Listing> listing = new Listing;
+    listing->modifiedTime = modifiedTime;
+    auto addName = [](SlangPathType, const char* name, void* userData)
+    { ((Listing*)userData)->names.add(String(name).toLower()); };
+    if (SLANG_FAILED(OSFileSystem::getExtSingleton()->enumeratePathContents(
+            directoryPath.getBuffer(),
+            addName,
+            listing.Ptr())))
+    {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_listings.set(directoryPath, listing);
+    return listing;
+}
+
+bool SearchDirectoryIndex::mayContain(const String& directoryPath, const String& path)
+{
+    // Only the first element of the path is looked up
+    const auto slice = path.getUnownedSlice();
+    Index end = 0;
+    while (end < slice.getLength() && !Path::isDelimiter(slice[end]))
+        end++;
+    const UnownedStringSlice firstElement = slice.head(end);
+    if (firstElement.getLength() == 0 || firstElement == toSlice(".") ||
+        firstElement == toSlice(".."))
+    {
+        return true;
+    }
+
+    RefPtr<DirectoryListingCache::Listing> listing;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (auto found = m_listings.tryGetValue(directoryPath))
+        {
+            listing = *found;
+        }
+        else
+        {
+            listing = m_listingCache->getListing(directoryPath);
+            m_listings.add(directoryPath, listing);
+        }
+    }
+
+    // A directory that can't be listed might still hold the path
+    return !listing || listing->names.contains(String(firstElement).toLower());
+}
+
 IncludeSystem::IncludeSystem(
     SearchDirectoryList* searchDirectories,
     ISlangFileSystemExt* fileSystemExt,
@@ -124,6 +193,9 @@ SlangResult IncludeSystem::findFile(
     {
         for (auto& dir : sd->searchDirectories)
         {
+            if (sd->index && !sd->index->mayContain(dir.path, pathToInclude))
+                continue;
+
             SlangResult res =
                 findFile(SLANG_PATH_TYPE_DIRECTORY, dir.path, pathToInclude, outPathInfo);
             if (SLANG_SUCCEEDED(res) || res != SLANG_E_NOT_FOUND)
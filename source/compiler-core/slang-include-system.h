@@ -3,10 +3,61 @@
 // slang-include-system.h
 
 #include "../compiler-core/slang-source-loc.h"
+#include "../core/slang-dictionary.h"
+
+#include <mutex>
 
 namespace Slang
 {
 
+/* The names held by directories of the OS file system, kept so that looking for a file in a
+directory that doesn't hold it doesn't need the file system. The listing of a directory is only
+read again when the time the directory was modified changes, so it can be shared by every session
+of a global session. Can be used from several threads at once. */
+class DirectoryListingCache : public RefObject
+{
+public:
+    struct Listing : public RefObject
+    {
+        uint64_t modifiedTime = 0;
+        /// The names in the directory, in lower case so that they can be looked up on file
+        /// systems that ignore case.
+        HashSet<String> names;
+    };
+
+    /// Get the listing of the directory `directoryPath`, or nullptr if it can't be listed.
+    RefPtr<Listing> getListing(const String& directoryPath);
+
+protected:
+    std::mutex m_mutex;                          ///< Guards m_listings
+    Dictionary<String, RefPtr<Listing>> m_listings; ///< Maps directory paths to their listings
+};
+
+/* Tells which search directories can't hold a path, so that they are skipped without asking the
+file system whether the path exists in them. The listing of a directory is taken from a
+DirectoryListingCache the first time it's needed, and used from then on, in the same way the
+CacheFileSystem of a session keeps whether a path exists once it has been asked. Can be used from
+several threads at once. */
+class SearchDirectoryIndex : public RefObject
+{
+public:
+    /// Returns false if `path`, relative to the directory `directoryPath`, can't exist because the
+    /// directory doesn't hold its first element. Returns true if it may exist.
+    bool mayContain(const String& directoryPath, const String& path);
+
+    SearchDirectoryIndex(DirectoryListingCache* listingCache)
+        : m_listingCache(listingCache)
+    {
+    }
+
+protected:
+    RefPtr<DirectoryListingCache> m_listingCache;
+
+    std::mutex m_mutex; ///< Guards m_listings
+    /// Maps directory paths to their listings, or to nullptr for those that can't be listed
+    Dictionary<String, RefPtr<DirectoryListingCache::Listing>> m_listings;
+};
+
 // A directory to be searched when looking for files (e.g., `#include`)
 struct SearchDirectory
 {
@@ -29,6 +80,9 @@ struct SearchDirectoryList
 
     // Directories to be searched
     List<SearchDirectory> searchDirectories;
+
+    // If set, used to skip the directories of this list that can't hold a file
+    SearchDirectoryIndex* index = nullptr;
 };
 
 /* A helper class that builds basic include handling on top of searchDirectories/fileSystemExt and
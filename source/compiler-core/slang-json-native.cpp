@@ -1,6 +1,7 @@
 #include "slang-json-native.h"
 
 #include "../core/slang-rtti-util.h"
+#include "../core/slang-string-escape-util.h"
 #include "slang-com-helper.h"
 #include "slang-json-diagnostics.h"
 
@@ -342,6 +343,517 @@ SlangResult JSONToNativeConverter::convertArrayToStruct(
     return SLANG_OK;
 }
 
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!! JSONToNativeListener !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+static Index _getTotalFieldCount(const StructRttiInfo* structRttiInfo)
+{
+    Index count = structRttiInfo->m_fieldCount;
+    for (auto super = structRttiInfo->m_super; super; super = super->m_super)
+    {
+        count += super->m_fieldCount;
+    }
+    return count;
+}
+
+// Find the field `name` of the struct or its super types. Fields are indexed in the order of
+// the types from the base type, like JSONToNativeConverter::_findFieldIndex.
+static const StructRttiInfo::Field* _findField(
+    const StructRttiInfo* structRttiInfo,
+    const UnownedStringSlice& name,
+    Index& outIndex)
+{
+    Index superFieldCount = 0;
+    if (auto super = structRttiInfo->m_super)
+    {
+        if (auto field = _findField(super, name, outIndex))
+        {
+            return field;
+        }
+        superFieldCount = _getTotalFieldCount(super);
+    }
+
+    for (Index i = 0; i < structRttiInfo->m_fieldCount; ++i)
+    {
+        const auto& field = structRttiInfo->m_fields[i];
+        if (name == field.m_name)
+        {
+            outIndex = superFieldCount + i;
+            return &field;
+        }
+    }
+    return nullptr;
+}
+
+void JSONToNativeListener::setTarget(const RttiInfo* rttiInfo, void* out)
+{
+    m_rttiInfo = rttiInfo;
+    m_out = (Byte*)out;
+    m_hasValue = false;
+    m_result = SLANG_OK;
+
+    m_stack.clear();
+    m_seenFields.clear();
+    m_skipDepth = 0;
+    m_captureDepth = 0;
+    m_captureDst = nullptr;
+}
+
+SlangResult JSONToNativeListener::_getValueTarget(
+    SourceLoc loc,
+    const RttiInfo*& outType,
+    Byte*& outDst)
+{
+    if (m_stack.getCount() == 0)
+    {
+        // Only a single value can be decoded into the target
+        if (m_hasValue || !m_rttiInfo)
+        {
+            return SLANG_FAIL;
+        }
+        m_hasValue = true;
+        outType = m_rttiInfo;
+        outDst = m_out;
+        return SLANG_OK;
+    }
+
+    auto& frame = m_stack.getLast();
+    switch (frame.rttiInfo->m_kind)
+    {
+    case RttiInfo::Kind::Struct:
+        {
+            outType = frame.fieldType;
+            outDst = frame.fieldDst;
+            return SLANG_OK;
+        }
+    case RttiInfo::Kind::List:
+        {
+            const auto elementType =
+                static_cast<const ListRttiInfo*>(frame.rttiInfo)->m_elementType;
+            auto& list = *(List<Byte>*)frame.dst;
+
+            // The element count isn't known until the end of the array, so the list grows
+            // geometrically, and is shrunk to the elements decoded at the end.
+            if (frame.elementCount >= list.getCount())
+            {
+                SLANG_RETURN_ON_FAIL(RttiUtil::setListCount(
+                    m_typeMap,
+                    elementType,
+                    frame.dst,
+                    Math::Max(Index(4), frame.elementCount * 2)));
+            }
+
+            outType = elementType;
+            outDst = list.getBuffer() + frame.elementCount * elementType->m_size;
+            frame.elementCount++;
+            return SLANG_OK;
+        }
+    case RttiInfo::Kind::FixedArray:
+        {
+            const FixedArrayRttiInfo* fixedArrayRttiInfo =
+                static_cast<const FixedArrayRttiInfo*>(frame.rttiInfo);
+            const Index elementCount = Index(fixedArrayRttiInfo->m_elementCount);
+            if (frame.elementCount >= elementCount)
+            {
+                m_sink->diagnose(
+                    loc,
+                    JSONDiagnostics::tooManyElementsForArray,
+                    frame.elementCount + 1,
+                    elementCount);
+                return SLANG_FAIL;
+            }
+
+            const auto elementType = fixedArrayRttiInfo->m_elementType;
+            outType = elementType;
+            outDst = frame.dst + frame.elementCount * elementType->m_size;
+            frame.elementCount++;
+            return SLANG_OK;
+        }
+    default:
+        break;
+    }
+    return SLANG_FAIL;
+}
+
+SlangResult JSONToNativeListener::_startValue(bool isObject, SourceLoc loc)
+{
+    const RttiInfo* type = nullptr;
+    Byte* dst = nullptr;
+    SLANG_RETURN_ON_FAIL(_getValueTarget(loc, type, dst));
+
+    if (!type)
+    {
+        m_skipDepth = 1;
+        return SLANG_OK;
+    }
+
+    if (type == GetRttiInfo<JSONValue>::get())
+    {
+        // The value is built in the container, as JSONToNativeConverter would have it
+        m_builder.reset();
+        m_captureDst = (JSONValue*)dst;
+        m_captureDepth = 1;
+        if (isObject)
+        {
+            m_builder.startObject(loc);
+        }
+        else
+        {
+            m_builder.startArray(loc);
+        }
+        return SLANG_OK;
+    }
+
+    Frame frame;
+    frame.rttiInfo = type;
+    frame.dst = dst;
+
+    if (isObject)
+    {
+        if (type->m_kind != RttiInfo::Kind::Struct)
+        {
+            return SLANG_FAIL;
+        }
+        const StructRttiInfo* structRttiInfo = static_cast<const StructRttiInfo*>(type);
+
+        frame.seenFieldsStart = m_seenFields.getCount();
+        const Index fieldCount = _getTotalFieldCount(structRttiInfo);
+        for (Index i = 0; i < fieldCount; ++i)
+        {
+            m_seenFields.add(false);
+        }
+    }
+    else if (type->m_kind == RttiInfo::Kind::List)
+    {
+        const auto elementType = static_cast<const ListRttiInfo*>(type)->m_elementType;
+        SLANG_RETURN_ON_FAIL(RttiUtil::setListCount(m_typeMap, elementType, dst, 0));
+    }
+    else if (type->m_kind != RttiInfo::Kind::FixedArray)
+    {
+        return SLANG_FAIL;
+    }
+
+    m_stack.add(frame);
+    return SLANG_OK;
+}
+
+SlangResult JSONToNativeListener::_checkRequiredFields(
+    const StructRttiInfo* structRttiInfo,
+    const bool* seenFields,
+    SourceLoc loc)
+{
+    if (auto super = structRttiInfo->m_super)
+    {
+        SLANG_RETURN_ON_FAIL(_checkRequiredFields(super, seenFields, loc));
+        seenFields += _getTotalFieldCount(super);
+    }
+
+    for (Index i = 0; i < structRttiInfo->m_fieldCount; ++i)
+    {
+        const auto& field = structRttiInfo->m_fields[i];
+        if (!seenFields[i] && (field.m_flags & StructRttiInfo::Flag::Optional) == 0)
+        {
+            m_sink->diagnose(
+                loc,
+                JSONDiagnostics::fieldRequiredOnType,
+                field.m_name,
+                structRttiInfo->m_name);
+            return SLANG_FAIL;
+        }
+    }
+    return SLANG_OK;
+}
+
+SlangResult JSONToNativeListener::_endValue(SourceLoc loc)
+{
+    const Frame frame = m_stack.getLast();
+    m_stack.removeLast();
+
+    switch (frame.rttiInfo->m_kind)
+    {
+    case RttiInfo::Kind::Struct:
+        {
+            const SlangResult res = _checkRequiredFields(
+                static_cast<const StructRttiInfo*>(frame.rttiInfo),
+                m_seenFields.getBuffer() + frame.seenFieldsStart,
+                loc);
+            m_seenFields.setCount(frame.seenFieldsStart);
+            return res;
+        }
+    case RttiInfo::Kind::List:
+        {
+            const auto elementType =
+                static_cast<const ListRttiInfo*>(frame.rttiInfo)->m_elementType;
+            return RttiUtil::setListCount(m_typeMap, elementType, frame.dst, frame.elementCount);
+        }
+    default:
+        break;
+    }
+    return SLANG_OK;
+}
+
+SlangResult JSONToNativeListener::_addKey(const UnownedStringSlice& name, SourceLoc loc)
+{
+    auto& frame = m_stack.getLast();
+    const StructRttiInfo* structRttiInfo = static_cast<const StructRttiInfo*>(frame.rttiInfo);
+
+    Index index = -1;
+    const auto field = _findField(structRttiInfo, name, index);
+    if (!field)
+    {
+        if (!structRttiInfo->m_ignoreUnknownFieldsInJson)
+        {
+            m_sink->diagnose(
+                loc,
+                JSONDiagnostics::fieldNotDefinedOnType,
+                name,
+                structRttiInfo->m_name);
+            return SLANG_FAIL;
+        }
+
+        // The value of the key is skipped
+        frame.fieldType = nullptr;
+        frame.fieldDst = nullptr;
+        return SLANG_OK;
+    }
+
+    m_seenFields[frame.seenFieldsStart + index] = true;
+    frame.fieldType = field->m_type;
+    frame.fieldDst = frame.dst + field->m_offset;
+    return SLANG_OK;
+}
+
+SlangResult JSONToNativeListener::_addScalar(
+    const JSONValue& value,
+    const UnownedStringSlice& lexeme)
+{
+    const RttiInfo* type = nullptr;
+    Byte* dst = nullptr;
+    SLANG_RETURN_ON_FAIL(_getValueTarget(value.loc, type, dst));
+    if (!type)
+    {
+        return SLANG_OK;
+    }
+
+    if ((m_flags & Flag::ReferenceSourceText) && value.type == JSONValue::Type::StringLexeme &&
+        type->m_kind == RttiInfo::Kind::UnownedStringSlice)
+    {
+        auto handler = StringEscapeUtil::getHandler(StringEscapeUtil::Style::JSON);
+        const UnownedStringSlice unquoted = StringEscapeUtil::unquote(handler, lexeme);
+        if (!handler->isUnescapingNeeeded(unquoted))
+        {
+            *(UnownedStringSlice*)dst = unquoted;
+            return SLANG_OK;
+        }
+    }
+
+    return m_converter.convert(value, type, dst);
+}
+
+void JSONToNativeListener::startObject(SourceLoc loc)
+{
+    if (m_captureDepth)
+    {
+        m_captureDepth++;
+        m_builder.startObject(loc);
+    }
+    else if (m_skipDepth)
+    {
+        m_skipDepth++;
+    }
+    else if (SLANG_SUCCEEDED(m_result))
+    {
+        _setResult(_startValue(true, loc));
+    }
+}
+
+void JSONToNativeListener::endObject(SourceLoc loc)
+{
+    if (m_captureDepth)
+    {
+        m_builder.endObject(loc);
+        if (--m_captureDepth == 0)
+        {
+            *m_captureDst = m_builder.getRootValue();
+        }
+    }
+    else if (m_skipDepth)
+    {
+        m_skipDepth--;
+    }
+    else if (SLANG_SUCCEEDED(m_result))
+    {
+        _setResult(_endValue(loc));
+    }
+}
+
+void JSONToNativeListener::startArray(SourceLoc loc)
+{
+    if (m_captureDepth)
+    {
+        m_captureDepth++;
+        m_builder.startArray(loc);
+    }
+    else if (m_skipDepth)
+    {
+        m_skipDepth++;
+    }
+    else if (SLANG_SUCCEEDED(m_result))
+    {
+        _setResult(_startValue(false, loc));
+    }
+}
+
+void JSONToNativeListener::endArray(SourceLoc loc)
+{
+    if (m_captureDepth)
+    {
+        m_builder.endArray(loc);
+        if (--m_captureDepth == 0)
+        {
+            *m_captureDst = m_builder.getRootValue();
+        }
+    }
+    else if (m_skipDepth)
+    {
+        m_skipDepth--;
+    }
+    else if (SLANG_SUCCEEDED(m_result))
+    {
+        _setResult(_endValue(loc));
+    }
+}
+
+void JSONToNativeListener::addQuotedKey(const UnownedStringSlice& key, SourceLoc loc)
+{
+    if (m_captureDepth)
+    {
+        m_builder.addQuotedKey(key, loc);
+    }
+    else if (_shouldDecode())
+    {
+        auto handler = StringEscapeUtil::getHandler(StringEscapeUtil::Style::JSON);
+        UnownedStringSlice name = StringEscapeUtil::unquote(handler, key);
+        if (handler->isUnescapingNeeeded(name))
+        {
+            m_buf.clear();
+            handler->appendUnescaped(name, m_buf);
+            name = m_buf.getUnownedSlice();
+        }
+        _setResult(_addKey(name, loc));
+    }
+}
+
+void JSONToNativeListener::addUnquotedKey(const UnownedStringSlice& key, SourceLoc loc)
+{
+    if (m_captureDepth)
+    {
+        m_builder.addUnquotedKey(key, loc);
+    }
+    else if (_shouldDecode())
+    {
+        _setResult(_addKey(key, loc));
+    }
+}
+
+void JSONToNativeListener::addLexemeValue(
+    JSONTokenType type,
+    const UnownedStringSlice& value,
+    SourceLoc loc)
+{
+    if (m_captureDepth)
+    {
+        m_builder.addLexemeValue(type, value, loc);
+        return;
+    }
+    if (!_shouldDecode())
+    {
+        return;
+    }
+
+    // The values are the same as the ones JSONBuilder makes, so that they are decoded the same
+    switch (type)
+    {
+    case JSONTokenType::True:
+        return _setResult(_addScalar(JSONValue::makeBool(true, loc)));
+    case JSONTokenType::False:
+        return _setResult(_addScalar(JSONValue::makeBool(false, loc)));
+    case JSONTokenType::Null:
+        return _setResult(_addScalar(JSONValue::makeNull(loc)));
+    case JSONTokenType::IntegerLiteral:
+        return _setResult(_addScalar(
+            JSONValue::makeLexeme(JSONValue::Type::IntegerLexeme, loc, value.getLength())));
+    case JSONTokenType::FloatLiteral:
+        return _setResult(_addScalar(
+            JSONValue::makeLexeme(JSONValue::Type::FloatLexeme, loc, value.getLength())));
+    case JSONTokenType::StringLiteral:
+        return _setResult(_addScalar(
+            JSONValue::makeLexeme(JSONValue::Type::StringLexeme, loc, value.getLength()),
+            value));
+    default:
+        return _setResult(SLANG_FAIL);
+    }
+}
+
+void JSONToNativeListener::addIntegerValue(int64_t value, SourceLoc loc)
+{
+    if (m_captureDepth)
+    {
+        m_builder.addIntegerValue(value, loc);
+    }
+    else if (_shouldDecode())
+    {
+        _setResult(_addScalar(JSONValue::makeInt(value, loc)));
+    }
+}
+
+void JSONToNativeListener::addFloatValue(double value, SourceLoc loc)
+{
+    if (m_captureDepth)
+    {
+        m_builder.addFloatValue(value, loc);
+    }
+    else if (_shouldDecode())
+    {
+        _setResult(_addScalar(JSONValue::makeFloat(value, loc)));
+    }
+}
+
+void JSONToNativeListener::addBoolValue(bool value, SourceLoc loc)
+{
+    if (m_captureDepth)
+    {
+        m_builder.addBoolValue(value, loc);
+    }
+    else if (_shouldDecode())
+    {
+        _setResult(_addScalar(JSONValue::makeBool(value, loc)));
+    }
+}
+
+void JSONToNativeListener::addStringValue(const UnownedStringSlice& string, SourceLoc loc)
+{
+    if (m_captureDepth)
+    {
+        m_builder.addStringValue(string, loc);
+    }
+    else if (_shouldDecode())
+    {
+        _setResult(_addScalar(m_container->createString(string, loc)));
+    }
+}
+
+void JSONToNativeListener::addNullValue(SourceLoc loc)
+{
+    if (m_captureDepth)
+    {
+        m_builder.addNullValue(loc);
+    }
+    else if (_shouldDecode())
+    {
+        _setResult(_addScalar(JSONValue::makeNull(loc)));
+    }
+}
+
 /* !!!!!!!!!!!!!!!!!!!!!!!!!!!! NativeToJSONConverter !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
 
 SlangResult NativeToJSONConverter::_structToJSON(
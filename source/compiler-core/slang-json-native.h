@@ -3,6 +3,7 @@
 
 #include "slang-com-helper.h"
 #include "slang-com-ptr.h"
+#include "slang-json-parser.h"
 #include "slang-json-value.h"
 #include "slang.h"
 
@@ -47,6 +48,129 @@ protected:
     JSONContainer* m_container;
 };
 
+/// Decodes JSON into a native type while it is being parsed, without building a JSONValue
+/// tree for it first. Only the values of JSONValue typed fields are built in the container.
+///
+/// Decoding matches JSONToNativeConverter::convert.
+class JSONToNativeListener : public JSONListener
+{
+public:
+    typedef uint32_t Flags;
+    struct Flag
+    {
+        enum Enum : Flags
+        {
+            /// UnownedStringSlice values that need no unescaping refer to the parsed text,
+            /// instead of being copied into the container. The text must outlive them.
+            ReferenceSourceText = 0x01,
+        };
+    };
+
+    // Implement JSONListener
+    virtual void startObject(SourceLoc loc) SLANG_OVERRIDE;
+    virtual void endObject(SourceLoc loc) SLANG_OVERRIDE;
+    virtual void startArray(SourceLoc loc) SLANG_OVERRIDE;
+    virtual void endArray(SourceLoc loc) SLANG_OVERRIDE;
+    virtual void addQuotedKey(const UnownedStringSlice& key, SourceLoc loc) SLANG_OVERRIDE;
+    virtual void addUnquotedKey(const UnownedStringSlice& key, SourceLoc loc) SLANG_OVERRIDE;
+    virtual void addLexemeValue(JSONTokenType type, const UnownedStringSlice& value, SourceLoc loc)
+        SLANG_OVERRIDE;
+    virtual void addIntegerValue(int64_t value, SourceLoc loc) SLANG_OVERRIDE;
+    virtual void addFloatValue(double value, SourceLoc loc) SLANG_OVERRIDE;
+    virtual void addBoolValue(bool value, SourceLoc loc) SLANG_OVERRIDE;
+    virtual void addStringValue(const UnownedStringSlice& string, SourceLoc loc) SLANG_OVERRIDE;
+    virtual void addNullValue(SourceLoc loc) SLANG_OVERRIDE;
+
+    /// Set the native value that the next parsed JSON value is decoded into
+    void setTarget(const RttiInfo* rttiInfo, void* out);
+    template<typename T>
+    void setTarget(T* out) { setTarget(GetRttiInfo<T>::get(), (void*)out); }
+
+    /// Fails if the parsed value didn't match the type of the target, or no value was parsed
+    SlangResult getResult() const { return m_hasValue ? m_result : SLANG_FAIL; }
+
+    JSONToNativeListener(
+        JSONContainer* container,
+        RttiTypeFuncsMap* typeMap,
+        DiagnosticSink* sink,
+        Flags flags = 0)
+        : m_container(container)
+        , m_typeMap(typeMap)
+        , m_sink(sink)
+        , m_flags(flags)
+        , m_converter(container, typeMap, sink)
+        , m_builder(container)
+    {
+    }
+
+protected:
+    /// An object or array whose values are being decoded
+    struct Frame
+    {
+        const RttiInfo* rttiInfo;
+        Byte* dst;
+        /// For arrays, the amount of elements decoded so far
+        Index elementCount = 0;
+        /// For structs, the index of the first flag of the fields of the struct in m_seenFields
+        Index seenFieldsStart = 0;
+        /// For structs, where the value of the current key is decoded to. Null if the key
+        /// isn't a field, and the value is skipped.
+        const RttiInfo* fieldType = nullptr;
+        Byte* fieldDst = nullptr;
+    };
+
+    /// Get where the value that starts next is decoded to. `outType` is set to null if the
+    /// value is skipped.
+    SlangResult _getValueTarget(SourceLoc loc, const RttiInfo*& outType, Byte*& outDst);
+    SlangResult _startValue(bool isObject, SourceLoc loc);
+    SlangResult _endValue(SourceLoc loc);
+    SlangResult _addKey(const UnownedStringSlice& name, SourceLoc loc);
+    /// `lexeme` is the text of the value, if it is a string lexeme
+    SlangResult _addScalar(
+        const JSONValue& value,
+        const UnownedStringSlice& lexeme = UnownedStringSlice());
+    SlangResult _checkRequiredFields(
+        const StructRttiInfo* structRttiInfo,
+        const bool* seenFields,
+        SourceLoc loc);
+
+    /// False while a value is skipped, or after a failure
+    bool _shouldDecode() const { return m_skipDepth == 0 && SLANG_SUCCEEDED(m_result); }
+
+    /// Records the first failure. Events after it are ignored.
+    void _setResult(SlangResult res)
+    {
+        if (SLANG_FAILED(res) && SLANG_SUCCEEDED(m_result))
+            m_result = res;
+    }
+
+    JSONContainer* m_container;
+    RttiTypeFuncsMap* m_typeMap;
+    DiagnosticSink* m_sink;
+    Flags m_flags;
+
+    const RttiInfo* m_rttiInfo = nullptr;
+    Byte* m_out = nullptr;
+    bool m_hasValue = false;
+    SlangResult m_result = SLANG_OK;
+
+    List<Frame> m_stack;
+    List<bool> m_seenFields;
+
+    /// Depth of the value being skipped, if any
+    Index m_skipDepth = 0;
+
+    /// Depth of the value being built for a JSONValue, if any, and where it is written to
+    Index m_captureDepth = 0;
+    JSONValue* m_captureDst = nullptr;
+
+    /// Used to decode scalar values
+    JSONToNativeConverter m_converter;
+    /// Builds the values of JSONValue targets
+    JSONBuilder m_builder;
+    StringBuilder m_buf;
+};
+
 struct NativeToJSONConverter
 {
     SlangResult convert(const RttiInfo* rttiInfo, const void* in, JSONValue& out);
@@ -79,105 +79,6 @@ static const StructRttiInfo _makeJSONSourceMap_Rtti()
 }
 /* static */ const StructRttiInfo JSONSourceMap::g_rttiInfo = _makeJSONSourceMap_Rtti();
 
-// Encode a 6 bit value to VLQ encoding
-static const unsigned char g_vlqEncodeTable[] =
-    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-
-struct VlqDecodeTable
-{
-    VlqDecodeTable()
-    {
-        ::memset(map, -1, sizeof(map));
-        for (Index i = 0; i < SLANG_COUNT_OF(g_vlqEncodeTable); ++i)
-        {
-            map[g_vlqEncodeTable[i]] = int8_t(i);
-        }
-    }
-    /// Returns a *negative* value if invalid
-    SLANG_FORCE_INLINE int8_t operator[](unsigned char c) const
-    {
-        return (c & ~char(0x7f)) ? -1 : map[c];
-    }
-
-    int8_t map[128];
-};
-
-static const VlqDecodeTable g_vlqDecodeTable;
-
-/*
-https://docs.google.com/document/d/1U1RGAehQwRypUTovF1KRlpiOFze0b-_2gc6fAH0KY0k/edit?hl=en_US&pli=1&pli=1#
-The VLQ is a Base64 value, where the most significant bit (the 6th bit) is used as the continuation
-bit, and the “digits” are encoded into the string least significant first, and where the least
-significant bit of the first digit is used as the sign bit. */
-
-static SlangResult _decode(UnownedStringSlice& ioEncoded, Index& out)
-{
-    Index v = 0;
-
-    const char* cur = ioEncoded.begin();
-    const char* end = ioEncoded.end();
-
-    {
-        Index shift = 0;
-        Index decodeValue = 0;
-        do
-        {
-            // Must have a char to decode
-            if (cur >= end)
-            {
-                return SLANG_FAIL;
-            }
-
-            decodeValue = g_vlqDecodeTable[*cur++];
-            if (decodeValue < 0)
-            {
-                return SLANG_FAIL;
-            }
-
-            v += (decodeValue & 0x1f) << shift;
-
-            shift += 5;
-        } while (decodeValue & 0x20);
-    }
-
-    // Save out the remaining part
-    ioEncoded = UnownedStringSlice(cur, end);
-
-    // Handle negating
-    out = (v & 1) ? -(v >> 1) : (v >> 1);
-    return SLANG_OK;
-}
-
-void _encode(Index v, StringBuilder& out)
-{
-    // Double to free up low bit to hold the sign
-    v += v;
-
-    // We want to make v always positive to encode
-    // we use the last bit to indicate negativity
-    v = (v < 0) ? (1 - v) : v;
-
-    // We'll use a simple buffer, so as to not have to constantly update he StringBuffer
-    char dst[8];
-    char* cur = dst;
-
-    do
-    {
-        const Index nextV = v >> 5;
-        const Index encodeValue = (v & 0x1f) + (nextV ? 0x20 : 0);
-
-        // Encode 5 bits, plus continuation bit
-        char c = g_vlqEncodeTable[encodeValue];
-
-        // Save the char
-        *cur++ = c;
-
-        v = nextV;
-    } while (v);
-
-    out.append(dst, cur);
-}
-
 /* static */ SlangResult JSONSourceMapUtil::decode(
     JSONContainer* container,
     JSONValue root,
@@ -245,110 +146,7 @@ void _encode(Index v, StringBuilder& out)
         }
     }
 
-    List<UnownedStringSlice> lines;
-    StringUtil::split(native.mappings, ';', lines);
-
-    List<UnownedStringSlice> segments;
-
-    // Index into sources
-    Index sourceFileIndex = 0;
-
-    Index sourceLine = 0;
-    Index sourceColumn = 0;
-    Index nameIndex = 0;
-
-    const Count linesCount = lines.getCount();
-
-    outSourceMap.m_lineStarts.setCount(linesCount + 1);
-
-    for (Index generatedLine = 0; generatedLine < linesCount; ++generatedLine)
-    {
-        const auto line = lines[generatedLine];
-
-        outSourceMap.m_lineStarts[generatedLine] = outSourceMap.m_lineEntries.getCount();
-
-        // If it's empty move to next line
-        if (line.getLength() == 0)
-        {
-            continue;
-        }
-
-        // Split the line into segments
-        segments.clear();
-        StringUtil::split(line, ',', segments);
-
-        Index generatedColumn = 0;
-
-        for (auto segment : segments)
-        {
-            Index colDelta;
-            SLANG_RETURN_ON_FAIL(_decode(segment, colDelta));
-
-            generatedColumn += colDelta;
-            SLANG_ASSERT(generatedColumn >= 0);
-
-            // It can be 4 or 5 parts
-            if (segment.getLength())
-            {
-                /* If present, an zero-based index into the "sources" list. This field is a base 64
-                   VLQ relative to the previous occurrence of this field, unless this is the first
-                   occurrence of this field, in which case the whole value is represented. If
-                   present, the zero-based starting line in the original source represented. This
-                   field is a base 64 VLQ relative to the previous occurrence of this field, unless
-                   this is the first occurrence of this field, in which case the whole value is
-                   represented. Always present if there is a source field. If present, the
-                   zero-based starting column of the line in the source represented. This field is a
-                   base 64 VLQ relative to the previous occurrence of this field, unless this is the
-                   first occurrence of this field, in which case the whole value is represented.
-                   Always present if there is a source field.
-                */
-
-                Index sourceFileDelta;
-                Index sourceLineDelta;
-                Index sourceColumnDelta;
-
-                SLANG_RETURN_ON_FAIL(_decode(segment, sourceFileDelta));
-                SLANG_RETURN_ON_FAIL(_decode(segment, sourceLineDelta));
-                SLANG_RETURN_ON_FAIL(_decode(segment, sourceColumnDelta));
-
-                sourceFileIndex += sourceFileDelta;
-                sourceLine += sourceLineDelta;
-                sourceColumn += sourceColumnDelta;
-
-                SLANG_ASSERT(sourceFileIndex >= 0);
-                SLANG_ASSERT(sourceLine >= 0);
-                SLANG_ASSERT(sourceColumn >= 0);
-
-                // 5 parts
-                if (segment.getLength() > 0)
-                {
-                    /* If present, the zero - based index into the "names" list associated with this
-                    segment. This field is a base 64 VLQ relative to the previous occurrence of this
-                    field, unless this is the first occurrence of this field, in which case the
-                    whole value is represented.
-                    */
-
-                    Index nameDelta;
-                    SLANG_RETURN_ON_FAIL(_decode(segment, nameDelta));
-
-                    nameIndex += nameDelta;
-                    SLANG_ASSERT(nameIndex >= 0);
-                }
-            }
-
-            SourceMap::Entry entry;
-            entry.generatedColumn = generatedColumn;
-            entry.sourceColumn = sourceColumn;
-            entry.sourceLine = sourceLine;
-            entry.sourceFileIndex = sourceFileIndex;
-            entry.nameIndex = nameIndex;
-
-            outSourceMap.m_lineEntries.add(entry);
-        }
-    }
-
-    // Mark the end
-    outSourceMap.m_lineStarts[linesCount] = outSourceMap.m_lineEntries.getCount();
+    SLANG_RETURN_ON_FAIL(outSourceMap.setMappings(native.mappings));
 
     return SLANG_OK;
 }
@@ -403,77 +201,7 @@ SlangResult JSONSourceMapUtil::encode(
     }
 
     StringBuilder mappings;
-
-    // Do the encoding!
-    {
-        const Count linesCount = sourceMap.getGeneratedLineCount();
-
-        Index sourceFileIndex = 0;
-
-        Index sourceLine = 0;
-        Index sourceColumn = 0;
-        Index nameIndex = 0;
-
-        for (Index i = 0; i < linesCount; ++i)
-        {
-            // Add the semicolon to start the line
-            if (i > 0)
-            {
-                mappings.appendChar(';');
-            }
-
-            const auto entries = sourceMap.getEntriesForLine(i);
-            const auto entriesCount = entries.getCount();
-
-            if (entriesCount == 0)
-            {
-                continue;
-            }
-
-            // We reset the generated column index at the start of each new generated line
-            Index generatedColumn = 0;
-
-            for (Index j = 0; j < entriesCount; ++j)
-            {
-                auto entry = entries[j];
-
-                if (j > 0)
-                {
-                    mappings.appendChar(',');
-                }
-
-                Index generatedDelta = entry.generatedColumn - generatedColumn;
-                generatedColumn = entry.generatedColumn;
-
-                _encode(generatedDelta, mappings);
-
-                // See if there any other deltas we need to handle
-                const Index sourceFileDelta = entry.sourceFileIndex - sourceFileIndex;
-                const Index sourceLineDelta = entry.sourceLine - sourceLine;
-                const Index sourceColumnDelta = entry.sourceColumn - sourceColumn;
-                const Index nameIndexDelta = entry.nameIndex - nameIndex;
-
-                if (sourceFileDelta || sourceLineDelta || sourceColumnDelta || nameIndex)
-                {
-                    // Okay we have to encode all these deltae
-                    _encode(sourceFileDelta, mappings);
-                    _encode(sourceLineDelta, mappings);
-                    _encode(sourceColumnDelta, mappings);
-
-                    // Update these values
-                    sourceFileIndex = entry.sourceFileIndex;
-                    sourceLine = entry.sourceLine;
-                    sourceColumn = entry.sourceColumn;
-
-                    if (nameIndexDelta)
-                    {
-                        _encode(nameIndexDelta, mappings);
-                        nameIndex = entry.nameIndex;
-                    }
-                }
-            }
-        }
-    }
+    sourceMap.appendMappings(mappings);
 
     // Set the mappings
     native.mappings = mappings.getUnownedSlice();
@@ -76,6 +76,16 @@ static const StructRttiInfo _makeSemanticTokensLegendRtti()
 }
 const StructRttiInfo SemanticTokensLegend::g_rttiInfo = _makeSemanticTokensLegendRtti();
 
+static const StructRttiInfo _makeSemanticTokensFullOptionsRtti()
+{
+    SemanticTokensFullOptions obj;
+    StructRttiBuilder builder(&obj, "LanguageServerProtocol::SemanticTokensFullOptions", nullptr);
+    builder.addField("delta", &obj.delta);
+    builder.ignoreUnknownFields();
+    return builder.make();
+}
+const StructRttiInfo SemanticTokensFullOptions::g_rttiInfo = _makeSemanticTokensFullOptionsRtti();
+
 static const StructRttiInfo _makeSemanticTokensOptionsRtti()
 {
     SemanticTokensOptions obj;
@@ -266,6 +276,7 @@ static const StructRttiInfo _makeServerCapabilitiesRtti()
     builder.addField("semanticTokensProvider", &obj.semanticTokensProvider);
     builder.addField("signatureHelpProvider", &obj.signatureHelpProvider);
     builder.addField("documentSymbolProvider", &obj.documentSymbolProvider);
+    builder.addField("workspaceSymbolProvider", &obj.workspaceSymbolProvider);
     builder.ignoreUnknownFields();
     return builder.make();
 }
@@ -288,6 +299,7 @@ static const StructRttiInfo _makeVSServerCapabilitiesRtti()
     builder.addField("semanticTokensProvider", &obj.semanticTokensProvider);
     builder.addField("signatureHelpProvider", &obj.signatureHelpProvider);
     builder.addField("documentSymbolProvider", &obj.documentSymbolProvider);
+    builder.addField("workspaceSymbolProvider", &obj.workspaceSymbolProvider);
     builder.addField("_vs_projectContextProvider", &obj._vs_projectContextProvider);
     builder.ignoreUnknownFields();
     return builder.make();
@@ -546,6 +558,17 @@ static const StructRttiInfo _makeTextEditCompletionItemRtti()
 }
 const StructRttiInfo TextEditCompletionItem::g_rttiInfo = _makeTextEditCompletionItemRtti();
 
+static const StructRttiInfo _makeCompletionListRtti()
+{
+    CompletionList obj;
+    StructRttiBuilder builder(&obj, "LanguageServerProtocol::CompletionList", nullptr);
+    builder.addField("isIncomplete", &obj.isIncomplete);
+    builder.addField("items", &obj.items);
+    builder.ignoreUnknownFields();
+    return builder.make();
+}
+const StructRttiInfo CompletionList::g_rttiInfo = _makeCompletionListRtti();
+
 static const StructRttiInfo _makeSemanticTokensParamsRtti()
 {
     SemanticTokensParams obj;
@@ -572,6 +595,61 @@ static const StructRttiInfo _makeSemanticTokensRtti()
 }
 const StructRttiInfo SemanticTokens::g_rttiInfo = _makeSemanticTokensRtti();
 
+static const StructRttiInfo _makeSemanticTokensRangeParamsRtti()
+{
+    SemanticTokensRangeParams obj;
+    StructRttiBuilder builder(
+        &obj,
+        "LanguageServerProtocol::SemanticTokensRangeParams",
+        &WorkDoneProgressParams::g_rttiInfo);
+    builder.addField("textDocument", &obj.textDocument);
+    builder.addField("range", &obj.range);
+    builder.ignoreUnknownFields();
+    return builder.make();
+}
+const StructRttiInfo SemanticTokensRangeParams::g_rttiInfo = _makeSemanticTokensRangeParamsRtti();
+const UnownedStringSlice SemanticTokensRangeParams::methodName =
+    UnownedStringSlice::fromLiteral("textDocument/semanticTokens/range");
+
+static const StructRttiInfo _makeSemanticTokensDeltaParamsRtti()
+{
+    SemanticTokensDeltaParams obj;
+    StructRttiBuilder builder(
+        &obj,
+        "LanguageServerProtocol::SemanticTokensDeltaParams",
+        &WorkDoneProgressParams::g_rttiInfo);
+    builder.addField("textDocument", &obj.textDocument);
+    builder.addField("previousResultId", &obj.previousResultId);
+    builder.ignoreUnknownFields();
+    return builder.make();
+}
+const StructRttiInfo SemanticTokensDeltaParams::g_rttiInfo = _makeSemanticTokensDeltaParamsRtti();
+const UnownedStringSlice SemanticTokensDeltaParams::methodName =
+    UnownedStringSlice::fromLiteral("textDocument/semanticTokens/full/delta");
+
+static const StructRttiInfo _makeSemanticTokensEditRtti()
+{
+    SemanticTokensEdit obj;
+    StructRttiBuilder builder(&obj, "LanguageServerProtocol::SemanticTokensEdit", nullptr);
+    builder.addField("start", &obj.start);
+    builder.addField("deleteCount", &obj.deleteCount);
+    builder.addField("data", &obj.data);
+    builder.ignoreUnknownFields();
+    return builder.make();
+}
+const StructRttiInfo SemanticTokensEdit::g_rttiInfo = _makeSemanticTokensEditRtti();
+
+static const StructRttiInfo _makeSemanticTokensDeltaRtti()
+{
+    SemanticTokensDelta obj;
+    StructRttiBuilder builder(&obj, "LanguageServerProtocol::SemanticTokensDelta", nullptr);
+    builder.addField("resultId", &obj.resultId);
+    builder.addField("edits", &obj.edits);
+    builder.ignoreUnknownFields();
+    return builder.make();
+}
+const StructRttiInfo SemanticTokensDelta::g_rttiInfo = _makeSemanticTokensDeltaRtti();
+
 static const StructRttiInfo _makeSignatureHelpParamsRtti()
 {
     SignatureHelpParams obj;
@@ -735,6 +813,33 @@ static const StructRttiInfo _makeDocumentSymbolRtti()
 }
 const StructRttiInfo DocumentSymbol::g_rttiInfo = _makeDocumentSymbolRtti();
 
+static const StructRttiInfo _makeWorkspaceSymbolParamsRtti()
+{
+    WorkspaceSymbolParams obj;
+    StructRttiBuilder builder(
+        &obj,
+        "LanguageServerProtocol::WorkspaceSymbolParams",
+        &WorkDoneProgressParams::g_rttiInfo);
+    builder.addField("query", &obj.query);
+    builder.ignoreUnknownFields();
+    return builder.make();
+}
+const StructRttiInfo WorkspaceSymbolParams::g_rttiInfo = _makeWorkspaceSymbolParamsRtti();
+const UnownedStringSlice WorkspaceSymbolParams::methodName =
+    UnownedStringSlice::fromLiteral("workspace/symbol");
+
+static const StructRttiInfo _makeSymbolInformationRtti()
+{
+    SymbolInformation obj;
+    StructRttiBuilder builder(&obj, "LanguageServerProtocol::SymbolInformation", nullptr);
+    builder.addField("name", &obj.name);
+    builder.addField("kind", &obj.kind);
+    builder.addField("location", &obj.location);
+    builder.ignoreUnknownFields();
+    return builder.make();
+}
+const StructRttiInfo SymbolInformation::g_rttiInfo = _makeSymbolInformationRtti();
+
 static const StructRttiInfo _makeInlayHintParamsRtti()
 {
     InlayHintParams obj;
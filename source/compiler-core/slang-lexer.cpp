@@ -6,10 +6,19 @@
 //
 
 #include "core/slang-char-encode.h"
+#include "core/slang-uint-set.h"
 #include "slang-core-diagnostics.h"
 #include "slang-name.h"
 #include "slang-source-loc.h"
 
+#if SLANG_PROCESSOR_X86_64
+#include <emmintrin.h>
+#define SLANG_LEXER_SSE2 1
+#elif SLANG_PROCESSOR_ARM_64
+#include <arm_neon.h>
+#define SLANG_LEXER_NEON 1
+#endif
+
 namespace Slang
 {
 Token TokenReader::getEndOfFileToken()
@@ -279,6 +288,173 @@ static int _advance(Lexer* lexer)
     }
 }
 
+// Most of the time spent scanning goes on runs of bytes that need none of the
+// handling `_advance` does: the characters of an identifier, whitespace, or the
+// body of a comment. `_skipBytes` consumes such a run directly, 16 bytes at a
+// time where SSE2 or NEON is available, and stops at the first byte that does
+// need that handling, such as a `\` that may escape a newline.
+
+#if SLANG_LEXER_SSE2 || SLANG_LEXER_NEON
+#define SLANG_LEXER_SIMD 1
+
+static const Index kByteVecSize = 16;
+
+#if SLANG_LEXER_SSE2
+typedef __m128i ByteVec;
+
+static ByteVec _loadBytes(const char* p)
+{
+    return _mm_loadu_si128((const __m128i*)p);
+}
+static ByteVec _splatByte(char c)
+{
+    return _mm_set1_epi8(c);
+}
+static ByteVec _equalBytes(ByteVec v, char c)
+{
+    return _mm_cmpeq_epi8(v, _splatByte(c));
+}
+static ByteVec _orBytes(ByteVec a, ByteVec b)
+{
+    return _mm_or_si128(a, b);
+}
+static ByteVec _notBytes(ByteVec v)
+{
+    return _mm_xor_si128(v, _splatByte(char(0xff)));
+}
+// Set for bytes in [lo, hi].
+static ByteVec _bytesInRange(ByteVec v, char lo, char hi)
+{
+    const ByteVec offset = _mm_sub_epi8(v, _splatByte(lo));
+    return _mm_cmpeq_epi8(_mm_min_epu8(offset, _splatByte(char(hi - lo))), offset);
+}
+// The number of bytes set in `mask` before the first that isn't.
+static Index _countLeadingSetBytes(ByteVec mask)
+{
+    const uint32_t bits = uint32_t(_mm_movemask_epi8(mask));
+    return bits == 0xffff ? kByteVecSize : bitscanForward(~bits);
+}
+#else
+typedef uint8x16_t ByteVec;
+
+static ByteVec _loadBytes(const char* p)
+{
+    return vld1q_u8((const uint8_t*)p);
+}
+static ByteVec _splatByte(char c)
+{
+    return vdupq_n_u8(uint8_t(c));
+}
+static ByteVec _equalBytes(ByteVec v, char c)
+{
+    return vceqq_u8(v, _splatByte(c));
+}
+static ByteVec _orBytes(ByteVec a, ByteVec b)
+{
+    return vorrq_u8(a, b);
+}
+static ByteVec _notBytes(ByteVec v)
+{
+    return vmvnq_u8(v);
+}
+// Set for bytes in [lo, hi].
+static ByteVec _bytesInRange(ByteVec v, char lo, char hi)
+{
+    return vcleq_u8(vsubq_u8(v, _splatByte(lo)), _splatByte(char(hi - lo)));
+}
+// The number of bytes set in `mask` before the first that isn't.
+static Index _countLeadingSetBytes(ByteVec mask)
+{
+    // Narrow each byte of the mask to a nibble of a 64 bit value.
+    const uint64_t bits =
+        vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(mask), 4)), 0);
+    return bits == ~uint64_t(0) ? kByteVecSize : bitscanForward(~bits) / 4;
+}
+#endif
+#endif
+
+// The bytes that `_skipBytes` consumes, for each kind of run. Each has a scalar
+// test, and where SIMD is available, a test of every byte in a vector.
+
+struct HorizontalSpaceBytes
+{
+    static bool matches(Byte c) { return c == ' ' || c == '\t'; }
+#if SLANG_LEXER_SIMD
+    static ByteVec matches(ByteVec v)
+    {
+        return _orBytes(_equalBytes(v, ' '), _equalBytes(v, '\t'));
+    }
+#endif
+};
+
+// Only ASCII identifier characters, other code points go through `_advance`.
+struct IdentifierBytes
+{
+    static bool matches(Byte c)
+    {
+        return ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z') || ('0' <= c && c <= '9') ||
+               c == '_';
+    }
+#if SLANG_LEXER_SIMD
+    static ByteVec matches(ByteVec v)
+    {
+        // Setting bit 5 maps upper case letters to lower case, and no other byte to one.
+        const ByteVec letters = _bytesInRange(_orBytes(v, _splatByte(0x20)), 'a', 'z');
+        return _orBytes(_orBytes(letters, _bytesInRange(v, '0', '9')), _equalBytes(v, '_'));
+    }
+#endif
+};
+
+// A line comment ends at a newline. The bytes of non-ASCII code points are never
+// newlines, so can be skipped as is.
+struct LineCommentBytes
+{
+    static bool matches(Byte c) { return c != '\n' && c != '\r' && c != '\\'; }
+#if SLANG_LEXER_SIMD
+    static ByteVec matches(ByteVec v)
+    {
+        return _notBytes(_orBytes(
+            _orBytes(_equalBytes(v, '\n'), _equalBytes(v, '\r')),
+            _equalBytes(v, '\\')));
+    }
+#endif
+};
+
+// A block comment ends at `*/`. Newlines don't need handling, as source locations
+// are found from the offset of the cursor.
+struct BlockCommentBytes
+{
+    static bool matches(Byte c) { return c != '*' && c != '\\'; }
+#if SLANG_LEXER_SIMD
+    static ByteVec matches(ByteVec v)
+    {
+        return _notBytes(_orBytes(_equalBytes(v, '*'), _equalBytes(v, '\\')));
+    }
+#endif
+};
+
+template<typename Bytes>
+static void _skipBytes(Lexer* lexer)
+{
+    const char* cursor = lexer->m_cursor;
+    const char* const end = lexer->m_end;
+#if SLANG_LEXER_SIMD
+    while (end - cursor >= kByteVecSize)
+    {
+        const Index count = _countLeadingSetBytes(Bytes::matches(_loadBytes(cursor)));
+        cursor += count;
+        if (count < kByteVecSize)
+        {
+            lexer->m_cursor = cursor;
+            return;
+        }
+    }
+#endif
+    while (cursor != end && Bytes::matches(Byte(*cursor)))
+        cursor++;
+    lexer->m_cursor = cursor;
+}
+
 static void _handleNewLine(Lexer* lexer)
 {
     int c = _advance(lexer);
@@ -289,6 +465,7 @@ static void _lexLineComment(Lexer* lexer)
 {
     for (;;)
     {
+        _skipBytes<LineCommentBytes>(lexer);
         switch (_peek(lexer))
         {
         case '\n':
@@ -307,6 +484,7 @@ static void _lexBlockComment(Lexer* lexer)
 {
     for (;;)
     {
+        _skipBytes<BlockCommentBytes>(lexer);
         switch (_peek(lexer))
         {
         case kEOF:
@@ -341,6 +519,7 @@ static void _lexHorizontalSpace(Lexer* lexer)
 {
     for (;;)
     {
+        _skipBytes<HorizontalSpaceBytes>(lexer);
         switch (_peek(lexer))
         {
         case ' ':
@@ -363,6 +542,7 @@ static void _lexIdentifier(Lexer* lexer)
 {
     for (;;)
     {
+        _skipBytes<IdentifierBytes>(lexer);
         int c = _peek(lexer);
         if (('a' <= c) && (c <= 'z') || ('A' <= c) && (c <= 'Z') || ('0' <= c) && (c <= '9') ||
             (c == '_') || isNonAsciiCodePoint((unsigned int)c))
@@ -23,13 +23,13 @@ const char* getCstr(Name* name)
 
 Name* NamePool::getName(UnownedStringSlice text)
 {
-    RefPtr<Name> name;
-    if (rootPool->names.tryGetValue(text, name))
-        return name;
+    const HashedStringSlice key(text);
+    if (auto found = rootPool->names.tryGetValue(key))
+        return *found;
 
-    name = new Name();
+    RefPtr<Name> name = new Name();
     name->text = text;
-    rootPool->names.add(text, name);
+    rootPool->names.add(HashedStringSlice(name->text.getUnownedSlice(), key.hashCode), name);
     return name;
 }
 
@@ -40,9 +40,8 @@ Name* NamePool::getName(String const& text)
 
 Name* NamePool::tryGetName(String const& text)
 {
-    RefPtr<Name> name;
-    if (rootPool->names.tryGetValue(text, name))
-        return name;
+    if (auto found = rootPool->names.tryGetValue(HashedStringSlice(text.getUnownedSlice())))
+        return *found;
     return nullptr;
 }
 
@@ -7,6 +7,8 @@
 
 #include "../core/slang-basic.h"
 
+#include <atomic>
+
 namespace Slang
 {
 
@@ -31,6 +33,13 @@ public:
     // of name than "simple" names, and so this might change to a structured
     // ADT instead of a simple string.
     String text;
+
+    // Has a `SyntaxDecl` (a keyword) been declared with this name?
+    //
+    // The parser looks up every identifier that could be a keyword, and
+    // checks this first so that it can skip the lookup for the (many)
+    // identifiers that can't be one.
+    std::atomic<bool> isSyntaxDeclName = false;
 };
 
 // Get the textual string representation of a name
@@ -51,7 +60,10 @@ const char* getCstr(Name* name);
 struct RootNamePool
 {
     // The mapping from text strings to the corresponding name.
-    Dictionary<String, RefPtr<Name>> names;
+    //
+    // The keys are slices of the text of their names, held with their hash codes so that
+    // growing the map doesn't rehash the text of every name.
+    Dictionary<HashedStringSlice, RefPtr<Name>> names;
 };
 
 // A `NamePool` is effectively a way of storing a subset of the
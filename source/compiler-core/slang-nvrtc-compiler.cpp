@@ -14,6 +14,7 @@
 #include "slang-artifact-diagnostic-util.h"
 #include "slang-artifact-util.h"
 #include "slang-com-helper.h"
+#include "slang-downstream-compiler-util.h"
 
 namespace nvrtc
 {
@@ -971,6 +972,31 @@ SlangResult NVRTCDownstreamCompiler::compile(
     ComPtr<ISlangBlob> sourceBlob;
     SLANG_RETURN_ON_FAIL(sourceArtifact->loadBlob(ArtifactKeep::Yes, sourceBlob.writeRef()));
 
+    // NVRTC 12.8 and later can precompile the headers a program includes, and reuse them in
+    // later compiles in the same process. The prelude is included ahead of the source from a
+    // header file so that it can be precompiled, and the copy of it in the source is then
+    // skipped by its include guard.
+    if (m_desc.version >= SemanticVersion(12, 8))
+    {
+        const auto source = StringUtil::getSlice(sourceBlob);
+        Index preludeStart = 0;
+        Index preludeEnd = 0;
+        String preludeHeaderPath;
+        if (DownstreamCompilerUtil::findPrelude(
+                source,
+                toSlice("SLANG_CUDA_PRELUDE_H"),
+                preludeStart,
+                preludeEnd) &&
+            SLANG_SUCCEEDED(DownstreamCompilerUtil::requirePreludeHeader(
+                source.subString(preludeStart, preludeEnd - preludeStart),
+                UnownedStringSlice(),
+                preludeHeaderPath)))
+        {
+            cmdLine.addArg("--pch");
+            cmdLine.addArg("--pre-include=" + preludeHeaderPath);
+        }
+    }
+
     auto sourcePath = ArtifactUtil::findPath(sourceArtifact);
 
     StringBuilder storage;
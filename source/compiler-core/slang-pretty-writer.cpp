@@ -11,8 +11,14 @@ void PrettyWriter::writeRaw(char const* begin, char const* end)
     writeRaw(UnownedStringSlice(begin, end));
 }
 
+// How much text is held in the builder before it is passed on to the sink.
+static const Index kSinkFlushSize = 64 * 1024;
+
 void PrettyWriter::adjust()
 {
+    if (m_sink && m_builder.getLength() >= kSinkFlushSize)
+        flush();
+
     // Only indent if at start of a line
     if (m_startOfLine)
     {
@@ -50,11 +56,14 @@ void PrettyWriter::write(const UnownedStringSlice& slice)
 
         if (cur < end && *cur == '\n')
         {
-            writeRawChar('\n');
             // Skip the CR
             cur++;
-            // Mark we are at the start of a line
-            m_startOfLine = true;
+            if (!m_isCompact)
+            {
+                writeRawChar('\n');
+                // Mark we are at the start of a line
+                m_startOfLine = true;
+            }
         }
 
         start = cur;
@@ -68,6 +77,16 @@ void PrettyWriter::writeEscapedString(const UnownedStringSlice& slice)
     StringEscapeUtil::appendQuoted(handler, slice, m_builder);
 }
 
+SlangResult PrettyWriter::flush()
+{
+    if (!m_sink)
+        return SLANG_OK;
+    if (m_builder.getLength() && SLANG_SUCCEEDED(m_sinkResult))
+        m_sinkResult = m_sink->write(m_builder.getBuffer(), m_builder.getLength());
+    m_builder.clear();
+    return m_sinkResult;
+}
+
 void PrettyWriter::maybeComma()
 {
     if (auto state = m_commaState)
@@ -50,6 +50,16 @@ struct PrettyWriter
     /// Get the builder the result is being constructed in
     StringBuilder& getBuilder() { return m_builder; }
 
+    /// Pass the text written on to `sink` once enough of it has accumulated, so that the
+    /// builder never holds the whole output. `flush` must be called once writing is done.
+    void setSink(ISlangWriter* sink) { m_sink = sink; }
+
+    /// When set, the text is written without any new lines or indentation.
+    void setCompact(bool isCompact) { m_isCompact = isCompact; }
+
+    /// Write any text held in the builder to the sink, if there is one.
+    SlangResult flush();
+
     ThisType& operator<<(const UnownedStringSlice& slice)
     {
         write(slice);
@@ -97,6 +107,11 @@ struct PrettyWriter
     int m_indent = 0;
     CommaState* m_commaState = nullptr;
     StringBuilder m_builder;
+
+    ISlangWriter* m_sink = nullptr;
+    bool m_isCompact = false;
+    // Set if writing to the sink failed.
+    SlangResult m_sinkResult = SLANG_OK;
 };
 
 /// Type for tracking whether a comma is needed in a comma-separated JSON list
@@ -740,6 +740,13 @@ void SourceManager::_resetSource()
     m_sourceFiles.clear();
 
     m_sourceFileMap.clear();
+    m_sourceFileByPathMap.clear();
+}
+
+void SourceManager::_addSourceFile(SourceFile* sourceFile)
+{
+    m_sourceFiles.add(sourceFile);
+    m_sourceFileByPathMap.addIfNotExists(sourceFile->getPathInfo().foundPath, sourceFile);
 }
 
 
@@ -779,7 +786,7 @@ SourceRange SourceManager::allocateSourceRange(UInt size)
 SourceFile* SourceManager::createSourceFileWithSize(const PathInfo& pathInfo, size_t contentSize)
 {
     SourceFile* sourceFile = new SourceFile(this, pathInfo, contentSize);
-    m_sourceFiles.add(sourceFile);
+    _addSourceFile(sourceFile);
     return sourceFile;
 }
 
@@ -788,7 +795,7 @@ SourceFile* SourceManager::createSourceFileWithString(
     const String& contents)
 {
     SourceFile* sourceFile = new SourceFile(this, pathInfo, contents.getLength());
-    m_sourceFiles.add(sourceFile);
+    _addSourceFile(sourceFile);
     sourceFile->setContents(contents);
     return sourceFile;
 }
@@ -796,7 +803,7 @@ SourceFile* SourceManager::createSourceFileWithString(
 SourceFile* SourceManager::createSourceFileWithBlob(const PathInfo& pathInfo, ISlangBlob* blob)
 {
     SourceFile* sourceFile = new SourceFile(this, pathInfo, blob->getBufferSize());
-    m_sourceFiles.add(sourceFile);
+    _addSourceFile(sourceFile);
     sourceFile->setContents(blob);
     return sourceFile;
 }
@@ -919,14 +926,8 @@ SourceFile* SourceManager::findSourceFileByPathRecursively(const String& name) c
 
 SourceFile* SourceManager::findSourceFileByPath(const String& name) const
 {
-    for (auto sourceFile : m_sourceFiles)
-    {
-        if (sourceFile->getPathInfo().foundPath == name)
-        {
-            return sourceFile;
-        }
-    }
-    return nullptr;
+    SourceFile* const* filePtr = m_sourceFileByPathMap.tryGetValue(name);
+    return (filePtr) ? *filePtr : nullptr;
 }
 
 SourceFile* SourceManager::findSourceFile(const String& uniqueIdentity) const
@@ -1005,6 +1006,34 @@ HumaneSourceLoc SourceManager::getHumaneLoc(SourceLoc loc, SourceLocType type)
     }
 }
 
+void SourceManager::getHumaneLocs(
+    ConstArrayView<SourceLoc> locs,
+    SourceLocType type,
+    ArrayView<HumaneSourceLoc> outLocs)
+{
+    SLANG_ASSERT(locs.getCount() == outLocs.getCount());
+
+    List<Index> order;
+    order.setCount(locs.getCount());
+    for (Index i = 0; i < order.getCount(); ++i)
+    {
+        order[i] = i;
+    }
+    order.sort([&](Index a, Index b) { return locs[a].getRaw() < locs[b].getRaw(); });
+
+    // Views don't overlap, so sorted locations in the same view are next to each other.
+    SourceView* sourceView = nullptr;
+    for (auto index : order)
+    {
+        const SourceLoc loc = locs[index];
+        if (!sourceView || !sourceView->getRange().contains(loc))
+        {
+            sourceView = findSourceViewRecursively(loc);
+        }
+        outLocs[index] = sourceView ? sourceView->getHumaneLoc(loc, type) : HumaneSourceLoc();
+    }
+}
+
 PathInfo SourceManager::getPathInfo(SourceLoc loc, SourceLocType type)
 {
     SourceView* sourceView = findSourceViewRecursively(loc);
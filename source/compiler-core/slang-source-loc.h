@@ -517,6 +517,14 @@ struct SourceManager
     /// Get the humane source location
     HumaneSourceLoc getHumaneLoc(SourceLoc loc, SourceLocType type = SourceLocType::Nominal);
 
+    /// Get the humane source locations of all of `locs` into `outLocs`, which must have the same
+    /// count. The locations are visited in sorted order, so the view of each is only searched
+    /// for once when there are many locations in a view.
+    void getHumaneLocs(
+        ConstArrayView<SourceLoc> locs,
+        SourceLocType type,
+        ArrayView<HumaneSourceLoc> outLocs);
+
     /// Get the path associated with a location
     PathInfo getPathInfo(SourceLoc loc, SourceLocType type = SourceLocType::Nominal);
 
@@ -598,6 +606,7 @@ struct SourceManager
 protected:
     void _resetLoc();
     void _resetSource();
+    void _addSourceFile(SourceFile* sourceFile);
 
     // The first location available to this source manager
     // (may not be the first location of all, because we might
@@ -624,6 +633,8 @@ protected:
 
     // Maps uniqueIdentities to source files
     Dictionary<String, SourceFile*> m_sourceFileMap;
+    // Maps found paths to the first source file created with them
+    Dictionary<String, SourceFile*> m_sourceFileByPathMap;
 
     ComPtr<ISlangFileSystemExt> m_fileSystemExt;
 };
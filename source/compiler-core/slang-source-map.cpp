@@ -1,8 +1,110 @@
 #include "slang-source-map.h"
 
+#include "../core/slang-string-util.h"
+
 namespace Slang
 {
 
+// Encode a 6 bit value to VLQ encoding
+static const unsigned char g_vlqEncodeTable[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+struct VlqDecodeTable
+{
+    VlqDecodeTable()
+    {
+        ::memset(map, -1, sizeof(map));
+        for (Index i = 0; i < SLANG_COUNT_OF(g_vlqEncodeTable); ++i)
+        {
+            map[g_vlqEncodeTable[i]] = int8_t(i);
+        }
+    }
+    /// Returns a *negative* value if invalid
+    SLANG_FORCE_INLINE int8_t operator[](unsigned char c) const
+    {
+        return (c & ~char(0x7f)) ? -1 : map[c];
+    }
+
+    int8_t map[128];
+};
+
+static const VlqDecodeTable g_vlqDecodeTable;
+
+/*
+https://docs.google.com/document/d/1U1RGAehQwRypUTovF1KRlpiOFze0b-_2gc6fAH0KY0k/edit?hl=en_US&pli=1&pli=1#
+The VLQ is a Base64 value, where the most significant bit (the 6th bit) is used as the continuation
+bit, and the “digits” are encoded into the string least significant first, and where the least
+significant bit of the first digit is used as the sign bit. */
+
+static SlangResult _decodeVlq(UnownedStringSlice& ioEncoded, Index& out)
+{
+    Index v = 0;
+
+    const char* cur = ioEncoded.begin();
+    const char* end = ioEncoded.end();
+
+    {
+        Index shift = 0;
+        Index decodeValue = 0;
+        do
+        {
+            // Must have a char to decode
+            if (cur >= end)
+            {
+                return SLANG_FAIL;
+            }
+
+            decodeValue = g_vlqDecodeTable[*cur++];
+            if (decodeValue < 0)
+            {
+                return SLANG_FAIL;
+            }
+
+            v += (decodeValue & 0x1f) << shift;
+
+            shift += 5;
+        } while (decodeValue & 0x20);
+    }
+
+    // Save out the remaining part
+    ioEncoded = UnownedStringSlice(cur, end);
+
+    // Handle negating
+    out = (v & 1) ? -(v >> 1) : (v >> 1);
+    return SLANG_OK;
+}
+
+static void _encodeVlq(Index v, StringBuilder& out)
+{
+    // Double to free up low bit to hold the sign
+    v += v;
+
+    // We want to make v always positive to encode
+    // we use the last bit to indicate negativity
+    v = (v < 0) ? (1 - v) : v;
+
+    // We'll use a simple buffer, so as to not have to constantly update he StringBuffer
+    char dst[8];
+    char* cur = dst;
+
+    do
+    {
+        const Index nextV = v >> 5;
+        const Index encodeValue = (v & 0x1f) + (nextV ? 0x20 : 0);
+
+        // Encode 5 bits, plus continuation bit
+        char c = g_vlqEncodeTable[encodeValue];
+
+        // Save the char
+        *cur++ = c;
+
+        v = nextV;
+    } while (v);
+
+    out.append(dst, cur);
+}
+
+
 void SourceMap::clear()
 {
     const String empty;
@@ -21,6 +123,10 @@ void SourceMap::clear()
 
     m_lineEntries.clear();
 
+    m_isStreamed = false;
+    m_streamedMappings.clear();
+    m_streamState = EncodeState();
+
     m_slicePool.clear();
 }
 
@@ -33,6 +139,9 @@ void SourceMap::swapWith(ThisType& rhs)
     m_sourcesContent.swapWith(rhs.m_sourcesContent);
     m_lineStarts.swapWith(rhs.m_lineStarts);
     m_lineEntries.swapWith(rhs.m_lineEntries);
+    Swap(m_isStreamed, rhs.m_isStreamed);
+    m_streamedMappings.swapWith(rhs.m_streamedMappings);
+    Swap(m_streamState, rhs.m_streamState);
     m_slicePool.swapWith(rhs.m_slicePool);
 }
 
@@ -101,7 +210,8 @@ bool SourceMap::operator==(const ThisType& rhs) const
     }
 
     if (m_file != rhs.m_file || m_sourceRoot != rhs.m_sourceRoot ||
-        m_lineStarts != rhs.m_lineStarts)
+        m_lineStarts != rhs.m_lineStarts || m_isStreamed != rhs.m_isStreamed ||
+        m_streamedMappings != rhs.m_streamedMappings)
     {
         return false;
     }
@@ -139,8 +249,237 @@ bool SourceMap::operator==(const ThisType& rhs) const
     }
 }
 
+// Append the `;` separating the lines before `lineIndex`
+static void _encodeLinesUpTo(Index lineIndex, SourceMap::EncodeState& ioState, StringBuilder& out)
+{
+    if (lineIndex <= ioState.lineIndex)
+    {
+        return;
+    }
+    for (; ioState.lineIndex < lineIndex; ++ioState.lineIndex)
+    {
+        out.appendChar(';');
+    }
+    // The generated column is relative to the start of each line
+    ioState.generatedColumn = 0;
+    ioState.hasEntryOnLine = false;
+}
+
+// Append a segment for `entry` to the current line
+static void _encodeEntry(
+    const SourceMap::Entry& entry,
+    SourceMap::EncodeState& ioState,
+    StringBuilder& out)
+{
+    if (ioState.hasEntryOnLine)
+    {
+        out.appendChar(',');
+    }
+    ioState.hasEntryOnLine = true;
+
+    // Every entry maps to a source location, so the source fields are always written, even
+    // when they are the same as the previous entry's. A segment of just the column means the
+    // generated code isn't mapped to anything.
+    _encodeVlq(entry.generatedColumn - ioState.generatedColumn, out);
+    _encodeVlq(entry.sourceFileIndex - ioState.sourceFileIndex, out);
+    _encodeVlq(entry.sourceLine - ioState.sourceLine, out);
+    _encodeVlq(entry.sourceColumn - ioState.sourceColumn, out);
+    if (entry.nameIndex != ioState.nameIndex)
+    {
+        _encodeVlq(entry.nameIndex - ioState.nameIndex, out);
+    }
+
+    ioState.generatedColumn = entry.generatedColumn;
+    ioState.sourceFileIndex = entry.sourceFileIndex;
+    ioState.sourceLine = entry.sourceLine;
+    ioState.sourceColumn = entry.sourceColumn;
+    ioState.nameIndex = entry.nameIndex;
+}
+
+void SourceMap::addEntry(const Entry& entry)
+{
+    if (m_isStreamed)
+    {
+        _encodeEntry(entry, m_streamState, m_streamedMappings);
+    }
+    else
+    {
+        m_lineEntries.add(entry);
+    }
+}
+
+SlangResult SourceMap::setStreamed(bool isStreamed)
+{
+    if (isStreamed == m_isStreamed)
+    {
+        return SLANG_OK;
+    }
+
+    if (isStreamed)
+    {
+        // The entries would have to be encoded first
+        if (m_lineEntries.getCount())
+        {
+            return SLANG_FAIL;
+        }
+        const Index lineIndex = getGeneratedLineCount() - 1;
+        m_isStreamed = true;
+        m_streamState = EncodeState();
+        m_streamedMappings.clear();
+        _encodeLinesUpTo(lineIndex, m_streamState, m_streamedMappings);
+        return SLANG_OK;
+    }
+
+    String mappings = m_streamedMappings.produceString();
+    m_isStreamed = false;
+    m_streamedMappings.clear();
+    m_streamState = EncodeState();
+    return setMappings(mappings.getUnownedSlice());
+}
+
+void SourceMap::appendMappings(StringBuilder& out) const
+{
+    if (m_isStreamed)
+    {
+        out.append(m_streamedMappings);
+        return;
+    }
+
+    EncodeState state;
+    const Count linesCount = getGeneratedLineCount();
+    for (Index i = 0; i < linesCount; ++i)
+    {
+        _encodeLinesUpTo(i, state, out);
+        for (const auto& entry : getEntriesForLine(i))
+        {
+            _encodeEntry(entry, state, out);
+        }
+    }
+}
+
+SlangResult SourceMap::setMappings(UnownedStringSlice mappings)
+{
+    SLANG_ASSERT(!m_isStreamed);
+    m_lineStarts.clear();
+    m_lineEntries.clear();
+
+    List<UnownedStringSlice> lines;
+    StringUtil::split(mappings, ';', lines);
+
+    List<UnownedStringSlice> segments;
+
+    // Index into sources
+    Index sourceFileIndex = 0;
+
+    Index sourceLine = 0;
+    Index sourceColumn = 0;
+    Index nameIndex = 0;
+
+    const Count linesCount = lines.getCount();
+
+    m_lineStarts.setCount(linesCount + 1);
+
+    for (Index generatedLine = 0; generatedLine < linesCount; ++generatedLine)
+    {
+        const auto line = lines[generatedLine];
+
+        m_lineStarts[generatedLine] = m_lineEntries.getCount();
+
+        // If it's empty move to next line
+        if (line.getLength() == 0)
+        {
+            continue;
+        }
+
+        // Split the line into segments
+        segments.clear();
+        StringUtil::split(line, ',', segments);
+
+        Index generatedColumn = 0;
+
+        for (auto segment : segments)
+        {
+            Index colDelta;
+            SLANG_RETURN_ON_FAIL(_decodeVlq(segment, colDelta));
+
+            generatedColumn += colDelta;
+            SLANG_ASSERT(generatedColumn >= 0);
+
+            // It can be 4 or 5 parts
+            if (segment.getLength())
+            {
+                /* If present, an zero-based index into the "sources" list. This field is a base 64
+                   VLQ relative to the previous occurrence of this field, unless this is the first
+                   occurrence of this field, in which case the whole value is represented. If
+                   present, the zero-based starting line in the original source represented. This
+                   field is a base 64 VLQ relative to the previous occurrence of this field, unless
+                   this is the first occurrence of this field, in which case the whole value is
+                   represented. Always present if there is a source field. If present, the
+                   zero-based starting column of the line in the source represented. This field is a
+                   base 64 VLQ relative to the previous occurrence of this field, unless this is the
+                   first occurrence of this field, in which case the whole value is represented.
+                   Always present if there is a source field.
+                */
+
+                Index sourceFileDelta;
+                Index sourceLineDelta;
+                Index sourceColumnDelta;
+
+                SLANG_RETURN_ON_FAIL(_decodeVlq(segment, sourceFileDelta));
+                SLANG_RETURN_ON_FAIL(_decodeVlq(segment, sourceLineDelta));
+                SLANG_RETURN_ON_FAIL(_decodeVlq(segment, sourceColumnDelta));
+
+                sourceFileIndex += sourceFileDelta;
+                sourceLine += sourceLineDelta;
+                sourceColumn += sourceColumnDelta;
+
+                SLANG_ASSERT(sourceFileIndex >= 0);
+                SLANG_ASSERT(sourceLine >= 0);
+                SLANG_ASSERT(sourceColumn >= 0);
+
+                // 5 parts
+                if (segment.getLength() > 0)
+                {
+                    /* If present, the zero - based index into the "names" list associated with this
+                    segment. This field is a base 64 VLQ relative to the previous occurrence of this
+                    field, unless this is the first occurrence of this field, in which case the
+                    whole value is represented.
+                    */
+
+                    Index nameDelta;
+                    SLANG_RETURN_ON_FAIL(_decodeVlq(segment, nameDelta));
+
+                    nameIndex += nameDelta;
+                    SLANG_ASSERT(nameIndex >= 0);
+                }
+            }
+
+            SourceMap::Entry entry;
+            entry.generatedColumn = generatedColumn;
+            entry.sourceColumn = sourceColumn;
+            entry.sourceLine = sourceLine;
+            entry.sourceFileIndex = sourceFileIndex;
+            entry.nameIndex = nameIndex;
+
+            m_lineEntries.add(entry);
+        }
+    }
+
+    // Mark the end
+    m_lineStarts[linesCount] = m_lineEntries.getCount();
+
+    return SLANG_OK;
+}
+
 void SourceMap::advanceToLine(Index nextLineIndex)
 {
+    if (m_isStreamed)
+    {
+        SLANG_ASSERT(nextLineIndex >= m_streamState.lineIndex);
+        _encodeLinesUpTo(nextLineIndex, m_streamState, m_streamedMappings);
+        return;
+    }
+
     const Count currentLineIndex = getGeneratedLineCount() - 1;
 
     SLANG_ASSERT(nextLineIndex >= currentLineIndex);
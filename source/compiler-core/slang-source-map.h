@@ -45,9 +45,24 @@ public:
         Index nameIndex;       ///< Name index
     };
 
+    /// The values the next entry is encoded relative to
+    struct EncodeState
+    {
+        Index lineIndex = 0;
+        bool hasEntryOnLine = false;
+        Index generatedColumn = 0;
+        Index sourceFileIndex = 0;
+        Index sourceLine = 0;
+        Index sourceColumn = 0;
+        Index nameIndex = 0;
+    };
+
     /// Get the total number of generated lines
-    Count getGeneratedLineCount() const { return m_lineStarts.getCount(); }
-    /// Get the entries on the line
+    Count getGeneratedLineCount() const
+    {
+        return m_isStreamed ? m_streamState.lineIndex + 1 : m_lineStarts.getCount();
+    }
+    /// Get the entries on the line. A streamed map has no entries.
     SLANG_FORCE_INLINE ConstArrayView<Entry> getEntriesForLine(Index generatedLine) const;
 
     /// Advance to the specified line index.
@@ -56,7 +71,19 @@ public:
     void advanceToLine(Index lineIndex);
 
     /// Add an entry to the current line
-    void addEntry(const Entry& entry) { m_lineEntries.add(entry); }
+    void addEntry(const Entry& entry);
+
+    /// Set whether entries are encoded into the base64 VLQ "mappings" of a source map as they are
+    /// added, instead of being held. A streamed map only holds what is needed to write it out, so
+    /// its entries can't be looked up. Streaming can only be turned on before any entries are
+    /// added, and turning it off decodes the entries added so far.
+    SlangResult setStreamed(bool isStreamed);
+    bool isStreamed() const { return m_isStreamed; }
+
+    /// Append the entries in the base64 VLQ form of the "mappings" of a source map
+    void appendMappings(StringBuilder& out) const;
+    /// Replace the entries with those decoded from the "mappings" of a source map
+    SlangResult setMappings(UnownedStringSlice mappings);
 
     /// Given the slice returns the index
     Index getSourceFileIndex(const UnownedStringSlice& slice);
@@ -113,6 +140,11 @@ public:
     List<Index> m_lineStarts;
     List<Entry> m_lineEntries;
 
+    /// Set if the entries are encoded into `m_streamedMappings` as they are added.
+    bool m_isStreamed = false;
+    StringBuilder m_streamedMappings;
+    EncodeState m_streamState;
+
     StringSlicePool m_slicePool;
 };
 
@@ -120,6 +152,11 @@ public:
 SLANG_FORCE_INLINE ConstArrayView<SourceMap::Entry> SourceMap::getEntriesForLine(
     Index generatedLine) const
 {
+    if (m_isStreamed)
+    {
+        return ConstArrayView<Entry>();
+    }
+
     SLANG_ASSERT(generatedLine >= 0 && generatedLine < m_lineStarts.getCount());
 
     const Index start = m_lineStarts[generatedLine];
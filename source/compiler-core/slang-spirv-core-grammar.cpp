@@ -173,13 +173,14 @@ RefPtr<SPIRVCoreGrammarInfo> SPIRVCoreGrammarInfo::loadFromJSON(
     lexer.init(&source, &sink);
     JSONParser parser;
     JSONContainer container(sink.getSourceManager());
-    JSONBuilder builder(&container);
     RttiTypeFuncsMap typeMap;
     typeMap = JSONNativeUtil::getTypeFuncsMap();
-    SLANG_RETURN_NULL_ON_FAIL(parser.parse(&lexer, &source, &builder, &sink));
-    JSONToNativeConverter converter(&container, &typeMap, &sink);
+    // The grammar is decoded while it is parsed, rather than building a JSON tree of it first.
     SPIRVSpec spec;
-    if (SLANG_FAILED(converter.convert(builder.getRootValue(), &spec)))
+    JSONToNativeListener listener(&container, &typeMap, &sink);
+    listener.setTarget(&spec);
+    SLANG_RETURN_NULL_ON_FAIL(parser.parse(&lexer, &source, &listener, &sink));
+    if (SLANG_FAILED(listener.getResult()))
     {
         // TODO: not having a source loc here is not great...
         sink.diagnoseWithoutSourceView(
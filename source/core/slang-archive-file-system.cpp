@@ -22,9 +22,11 @@ namespace Slang
 SlangResult loadArchiveFileSystem(
     const void* data,
     size_t dataSizeInBytes,
-    ComPtr<ISlangFileSystemExt>& outFileSystem)
+    ComPtr<ISlangFileSystemExt>& outFileSystem,
+    Count decompressThreadCount)
 {
     ComPtr<ISlangMutableFileSystem> fileSystem;
+    RiffFileSystem* riffFileSystem = nullptr;
     if (ZipFileSystem::isArchive(data, dataSizeInBytes))
     {
         // It's a zip
@@ -33,7 +35,8 @@ SlangResult loadArchiveFileSystem(
     else if (RiffFileSystem::isArchive(data, dataSizeInBytes))
     {
         // It's riff contained (Slang specific)
-        fileSystem = new RiffFileSystem(nullptr);
+        riffFileSystem = new RiffFileSystem(nullptr);
+        fileSystem = riffFileSystem;
     }
     else
     {
@@ -48,6 +51,13 @@ SlangResult loadArchiveFileSystem(
 
     SLANG_RETURN_ON_FAIL(archiveFileSystem->loadArchive(data, dataSizeInBytes));
 
+    // Zip entries are read through a single miniz reader, which can't be shared across threads,
+    // so only riff archives are decompressed up front.
+    if (riffFileSystem && decompressThreadCount > 0)
+    {
+        SLANG_RETURN_ON_FAIL(riffFileSystem->decompressAll(decompressThreadCount));
+    }
+
     outFileSystem = fileSystem;
     return SLANG_OK;
 }
@@ -28,10 +28,14 @@ class IArchiveFileSystem : public ISlangCastable
     SLANG_NO_THROW virtual void SLANG_MCALL setCompressionStyle(const CompressionStyle& style) = 0;
 };
 
+/// Load the archive held in data as a file system.
+/// If decompressThreadCount is more than 0 and the archive's files are compressed, they are all
+/// decompressed across that many threads up front, rather than each as it is loaded.
 SlangResult loadArchiveFileSystem(
     const void* data,
     size_t dataSizeInBytes,
-    ComPtr<ISlangFileSystemExt>& outFileSystem);
+    ComPtr<ISlangFileSystemExt>& outFileSystem,
+    Count decompressThreadCount = 0);
 SlangResult createArchiveFileSystem(
     SlangArchiveType type,
     ComPtr<ISlangMutableFileSystem>& outFileSystem);
@@ -87,13 +87,16 @@ protected:
     std::atomic<uint32_t> comRefCount;
 
 public:
+    // COM objects can be shared between threads, so their reference counts must be thread safe.
     ComObject()
         : comRefCount(0)
     {
+        enableThreadSafeReferenceCount();
     }
     ComObject(const ComObject& rhs)
         : RefObject(rhs), comRefCount(0)
     {
+        enableThreadSafeReferenceCount();
     }
 
     ComObject& operator=(const ComObject&) { return *this; }
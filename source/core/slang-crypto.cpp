@@ -11,6 +11,17 @@
 #include "slang-crypto.h"
 
 #include "../core/slang-char-util.h"
+#include "../core/slang-math.h"
+
+#if SLANG_PROCESSOR_X86_64 && (SLANG_GCC_FAMILY || SLANG_VC)
+#include <immintrin.h>
+#if SLANG_VC
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#define SLANG_SHA1_SHA_NI 1
+#endif
 
 namespace Slang
 {
@@ -316,6 +327,221 @@ const void* MD5::processBlock(const void* data, SlangInt size)
 
 // SHA1
 
+#if SLANG_SHA1_SHA_NI
+
+// Most x86 processors made since 2017 have instructions for the rounds and message schedule
+// of SHA1, which we use when the processor we run on has them.
+
+static bool _isSHANIAvailable()
+{
+    static const bool isAvailable = []()
+    {
+        // SHA is leaf 7 EBX bit 29, SSSE3 and SSE4.1 are leaf 1 ECX bits 9 and 19.
+#if SLANG_VC
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7)
+            return false;
+        __cpuid(info, 1);
+        const unsigned int ecx = (unsigned int)info[2];
+        __cpuidex(info, 7, 0);
+        const unsigned int ebx = (unsigned int)info[1];
+#else
+        unsigned int eax, ebx, ecx, edx;
+        if (__get_cpuid_max(0, nullptr) < 7)
+            return false;
+        __get_cpuid(1, &eax, &ebx, &ecx, &edx);
+        const unsigned int leaf1Ecx = ecx;
+        __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx);
+        ecx = leaf1Ecx;
+#endif
+        return (ebx & (1u << 29)) && (ecx & (1u << 9)) && (ecx & (1u << 19));
+    }();
+    return isAvailable;
+}
+
+#if SLANG_GCC_FAMILY
+__attribute__((target("sha,ssse3,sse4.1")))
+#endif
+static void _processBlocksSHANI(uint32_t state[5], const uint8_t* ptr, SlangSizeT blockCount)
+{
+    // The words of each block are big endian.
+    const __m128i byteSwap = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+
+    // The instructions keep a, b, c and d in one register, with a in the highest lane, and e
+    // in the highest lane of another.
+    __m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)state), 0x1b);
+    __m128i e0 = _mm_set_epi32((int)state[4], 0, 0, 0);
+    __m128i e1;
+    __m128i msg0, msg1, msg2, msg3;
+
+    for (; blockCount; blockCount--, ptr += 64)
+    {
+        const __m128i abcdSave = abcd;
+        const __m128i eSave = e0;
+
+        // Rounds 0-3
+        msg0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(ptr + 0)), byteSwap);
+        e0 = _mm_add_epi32(e0, msg0);
+        e1 = abcd;
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+
+        // Rounds 4-7
+        msg1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(ptr + 16)), byteSwap);
+        e1 = _mm_sha1nexte_epu32(e1, msg1);
+        e0 = abcd;
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 0);
+        msg0 = _mm_sha1msg1_epu32(msg0, msg1);
+
+        // Rounds 8-11
+        msg2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(ptr + 32)), byteSwap);
+        e0 = _mm_sha1nexte_epu32(e0, msg2);
+        e1 = abcd;
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+        msg1 = _mm_sha1msg1_epu32(msg1, msg2);
+        msg0 = _mm_xor_si128(msg0, msg2);
+
+        // Rounds 12-15
+        msg3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(ptr + 48)), byteSwap);
+        e1 = _mm_sha1nexte_epu32(e1, msg3);
+        e0 = abcd;
+        msg0 = _mm_sha1msg2_epu32(msg0, msg3);
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 0);
+        msg2 = _mm_sha1msg1_epu32(msg2, msg3);
+        msg1 = _mm_xor_si128(msg1, msg3);
+
+        // Rounds 16-19
+        e0 = _mm_sha1nexte_epu32(e0, msg0);
+        e1 = abcd;
+        msg1 = _mm_sha1msg2_epu32(msg1, msg0);
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+        msg3 = _mm_sha1msg1_epu32(msg3, msg0);
+        msg2 = _mm_xor_si128(msg2, msg0);
+
+        // Rounds 20-23
+        e1 = _mm_sha1nexte_epu32(e1, msg1);
+        e0 = abcd;
+        msg2 = _mm_sha1msg2_epu32(msg2, msg1);
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 1);
+        msg0 = _mm_sha1msg1_epu32(msg0, msg1);
+        msg3 = _mm_xor_si128(msg3, msg1);
+
+        // Rounds 24-27
+        e0 = _mm_sha1nexte_epu32(e0, msg2);
+        e1 = abcd;
+        msg3 = _mm_sha1msg2_epu32(msg3, msg2);
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 1);
+        msg1 = _mm_sha1msg1_epu32(msg1, msg2);
+        msg0 = _mm_xor_si128(msg0, msg2);
+
+        // Rounds 28-31
+        e1 = _mm_sha1nexte_epu32(e1, msg3);
+        e0 = abcd;
+        msg0 = _mm_sha1msg2_epu32(msg0, msg3);
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 1);
+        msg2 = _mm_sha1msg1_epu32(msg2, msg3);
+        msg1 = _mm_xor_si128(msg1, msg3);
+
+        // Rounds 32-35
+        e0 = _mm_sha1nexte_epu32(e0, msg0);
+        e1 = abcd;
+        msg1 = _mm_sha1msg2_epu32(msg1, msg0);
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 1);
+        msg3 = _mm_sha1msg1_epu32(msg3, msg0);
+        msg2 = _mm_xor_si128(msg2, msg0);
+
+        // Rounds 36-39
+        e1 = _mm_sha1nexte_epu32(e1, msg1);
+        e0 = abcd;
+        msg2 = _mm_sha1msg2_epu32(msg2, msg1);
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 1);
+        msg0 = _mm_sha1msg1_epu32(msg0, msg1);
+        msg3 = _mm_xor_si128(msg3, msg1);
+
+        // Rounds 40-43
+        e0 = _mm_sha1nexte_epu32(e0, msg2);
+        e1 = abcd;
+        msg3 = _mm_sha1msg2_epu32(msg3, msg2);
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 2);
+        msg1 = _mm_sha1msg1_epu32(msg1, msg2);
+        msg0 = _mm_xor_si128(msg0, msg2);
+
+        // Rounds 44-47
+        e1 = _mm_sha1nexte_epu32(e1, msg3);
+        e0 = abcd;
+        msg0 = _mm_sha1msg2_epu32(msg0, msg3);
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 2);
+        msg2 = _mm_sha1msg1_epu32(msg2, msg3);
+        msg1 = _mm_xor_si128(msg1, msg3);
+
+        // Rounds 48-51
+        e0 = _mm_sha1nexte_epu32(e0, msg0);
+        e1 = abcd;
+        msg1 = _mm_sha1msg2_epu32(msg1, msg0);
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 2);
+        msg3 = _mm_sha1msg1_epu32(msg3, msg0);
+        msg2 = _mm_xor_si128(msg2, msg0);
+
+        // Rounds 52-55
+        e1 = _mm_sha1nexte_epu32(e1, msg1);
+        e0 = abcd;
+        msg2 = _mm_sha1msg2_epu32(msg2, msg1);
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 2);
+        msg0 = _mm_sha1msg1_epu32(msg0, msg1);
+        msg3 = _mm_xor_si128(msg3, msg1);
+
+        // Rounds 56-59
+        e0 = _mm_sha1nexte_epu32(e0, msg2);
+        e1 = abcd;
+        msg3 = _mm_sha1msg2_epu32(msg3, msg2);
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 2);
+        msg1 = _mm_sha1msg1_epu32(msg1, msg2);
+        msg0 = _mm_xor_si128(msg0, msg2);
+
+        // Rounds 60-63
+        e1 = _mm_sha1nexte_epu32(e1, msg3);
+        e0 = abcd;
+        msg0 = _mm_sha1msg2_epu32(msg0, msg3);
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 3);
+        msg2 = _mm_sha1msg1_epu32(msg2, msg3);
+        msg1 = _mm_xor_si128(msg1, msg3);
+
+        // Rounds 64-67
+        e0 = _mm_sha1nexte_epu32(e0, msg0);
+        e1 = abcd;
+        msg1 = _mm_sha1msg2_epu32(msg1, msg0);
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 3);
+        msg3 = _mm_sha1msg1_epu32(msg3, msg0);
+        msg2 = _mm_xor_si128(msg2, msg0);
+
+        // Rounds 68-71
+        e1 = _mm_sha1nexte_epu32(e1, msg1);
+        e0 = abcd;
+        msg2 = _mm_sha1msg2_epu32(msg2, msg1);
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 3);
+        msg3 = _mm_xor_si128(msg3, msg1);
+
+        // Rounds 72-75
+        e0 = _mm_sha1nexte_epu32(e0, msg2);
+        e1 = abcd;
+        msg3 = _mm_sha1msg2_epu32(msg3, msg2);
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 3);
+
+        // Rounds 76-79
+        e1 = _mm_sha1nexte_epu32(e1, msg3);
+        e0 = abcd;
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 3);
+
+        e0 = _mm_sha1nexte_epu32(e0, eSave);
+        abcd = _mm_add_epi32(abcd, abcdSave);
+    }
+
+    _mm_storeu_si128((__m128i*)state, _mm_shuffle_epi32(abcd, 0x1b));
+    state[4] = (uint32_t)_mm_extract_epi32(e0, 3);
+}
+
+#endif
+
 SHA1::SHA1()
 {
     init();
@@ -340,31 +566,33 @@ void SHA1::update(const void* data, SlangSizeT len)
     }
 
     const uint8_t* ptr = reinterpret_cast<const uint8_t*>(data);
+    m_bits += uint64_t(len) * 8;
 
-    // Fill up buffer if not full.
-    while (len > 0 && m_index != 0)
+    // Fill up buffer if not empty.
+    if (m_index != 0)
     {
-        addByte(*ptr++);
-        m_bits += 8;
-        len--;
+        const SlangSizeT count = Math::Min(len, SlangSizeT(sizeof(m_buf) - m_index));
+        ::memcpy(m_buf + m_index, ptr, count);
+        m_index += uint32_t(count);
+        ptr += count;
+        len -= count;
+        if (m_index < sizeof(m_buf))
+        {
+            return;
+        }
+        m_index = 0;
+        processBlocks(m_buf, 1);
     }
 
     // Process full blocks.
-    while (len >= sizeof(m_buf))
-    {
-        processBlock(ptr);
-        ptr += sizeof(m_buf);
-        len -= sizeof(m_buf);
-        m_bits += sizeof(m_buf) * 8;
-    }
-
-    // Process remaining bytes.
-    while (len > 0)
-    {
-        addByte(*ptr++);
-        m_bits += 8;
-        len--;
-    }
+    const SlangSizeT blockCount = len / sizeof(m_buf);
+    processBlocks(ptr, blockCount);
+    ptr += blockCount * sizeof(m_buf);
+    len -= blockCount * sizeof(m_buf);
+
+    // Keep remaining bytes.
+    ::memcpy(m_buf, ptr, len);
+    m_index = uint32_t(len);
 }
 
 SHA1::Digest SHA1::finalize()
@@ -400,7 +628,22 @@ void SHA1::addByte(uint8_t byte)
     if (m_index >= sizeof(m_buf))
     {
         m_index = 0;
-        processBlock(m_buf);
+        processBlocks(m_buf, 1);
+    }
+}
+
+void SHA1::processBlocks(const uint8_t* ptr, SlangSizeT blockCount)
+{
+#if SLANG_SHA1_SHA_NI
+    if (_isSHANIAvailable())
+    {
+        _processBlocksSHANI(m_state, ptr, blockCount);
+        return;
+    }
+#endif
+    for (; blockCount; blockCount--, ptr += sizeof(m_buf))
+    {
+        processBlock(ptr);
     }
 }
 
@@ -106,6 +106,9 @@ public:
 
 private:
     void addByte(uint8_t x);
+    /// Process `blockCount` 64 byte blocks, with the SHA instructions of the processor if it has
+    /// them.
+    void processBlocks(const uint8_t* ptr, SlangSizeT blockCount);
     void processBlock(const uint8_t* ptr);
 
     uint32_t m_index;
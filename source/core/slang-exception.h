@@ -55,6 +55,18 @@ public:
     {
     }
 };
+
+/// Thrown when compilation is aborted because it was canceled. It is an
+/// `AbortCompilationException`, so is handled wherever compilation can be aborted.
+class CompilationCanceledException : public AbortCompilationException
+{
+public:
+    CompilationCanceledException() {}
+    CompilationCanceledException(const String& message)
+        : AbortCompilationException(message)
+    {
+    }
+};
 } // namespace Slang
 
 #endif
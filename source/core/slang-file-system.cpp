@@ -202,6 +202,18 @@ SlangResult OSFileSystem::loadFile(char const* pathIn, ISlangBlob** outBlob)
         return SLANG_E_NOT_FOUND;
     }
 
+    // Large files are mapped rather than read, so that their pages are loaded as they are used
+    // and shared with other processes through the OS's file cache. A file system that can
+    // modify files doesn't map them, since a mapping can stop files being written or truncated.
+    if (m_style != FileSystemStyle::Mutable)
+    {
+        const auto res = File::mapAllBytesTerminated(path, kMinMappedFileSize, outBlob);
+        if (SLANG_SUCCEEDED(res))
+        {
+            return res;
+        }
+    }
+
     ScopedAllocation alloc;
     SLANG_RETURN_ON_FAIL(File::readAllBytes(path, alloc));
     *outBlob = RawBlob::moveCreate(alloc).detach();
@@ -877,6 +889,128 @@ SlangResult CacheFileSystem::_getCanonicalPath(const char* path, ISlangBlob** ou
     return SLANG_OK;
 }
 
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!  SharedCacheFileSystem  !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+SharedCacheFileSystem::SharedCacheFileSystem()
+    : m_fileSystem(OSFileSystem::getExtSingleton())
+{
+}
+
+void* SharedCacheFileSystem::castAs(const Guid& guid)
+{
+    if (auto ptr = getInterface(guid))
+    {
+        return ptr;
+    }
+    return getObject(guid);
+}
+
+ISlangUnknown* SharedCacheFileSystem::getInterface(const Guid& guid)
+{
+    return _canCast(FileSystemStyle::Ext, guid) ? static_cast<ISlangFileSystemExt*>(this)
+                                                : nullptr;
+}
+
+void* SharedCacheFileSystem::getObject(const Guid& guid)
+{
+    SLANG_UNUSED(guid);
+    return nullptr;
+}
+
+SlangResult SharedCacheFileSystem::loadFile(char const* path, ISlangBlob** outBlob)
+{
+    // If the file can't be identified, or its time and size can't be checked, it can't be
+    // cached
+    ComPtr<ISlangBlob> uniqueIdentityBlob;
+    uint64_t modifiedTime = 0;
+    uint64_t size = 0;
+    if (SLANG_FAILED(m_fileSystem->getFileUniqueIdentity(path, uniqueIdentityBlob.writeRef())) ||
+        SLANG_FAILED(File::getModifiedTimeAndSize(path, modifiedTime, size)))
+    {
+        return m_fileSystem->loadFile(path, outBlob);
+    }
+    const String uniqueIdentity = StringUtil::getString(uniqueIdentityBlob);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (auto entry = m_entries.tryGetValue(uniqueIdentity))
+        {
+            if (entry->modifiedTime == modifiedTime && entry->size == size)
+            {
+                *outBlob = ComPtr<ISlangBlob>(entry->blob).detach();
+                return SLANG_OK;
+            }
+        }
+    }
+
+    // The file is loaded without holding the lock, so that loads of other files aren't held up.
+    // If the file changes after its time was read, the entry will hold contents newer than its
+    // time, and will just be reloaded on the next load.
+    ComPtr<ISlangBlob> blob;
+    SLANG_RETURN_ON_FAIL(m_fileSystem->loadFile(path, blob.writeRef()));
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Entry entry;
+        entry.modifiedTime = modifiedTime;
+        entry.size = size;
+        entry.blob = blob;
+        m_entries.set(uniqueIdentity, entry);
+    }
+
+    *outBlob = blob.detach();
+    return SLANG_OK;
+}
+
+SlangResult SharedCacheFileSystem::getFileUniqueIdentity(
+    const char* path,
+    ISlangBlob** outUniqueIdentity)
+{
+    return m_fileSystem->getFileUniqueIdentity(path, outUniqueIdentity);
+}
+
+SlangResult SharedCacheFileSystem::calcCombinedPath(
+    SlangPathType fromPathType,
+    const char* fromPath,
+    const char* path,
+    ISlangBlob** pathOut)
+{
+    return m_fileSystem->calcCombinedPath(fromPathType, fromPath, path, pathOut);
+}
+
+SlangResult SharedCacheFileSystem::getPathType(const char* path, SlangPathType* outPathType)
+{
+    return m_fileSystem->getPathType(path, outPathType);
+}
+
+SlangResult SharedCacheFileSystem::getPath(
+    PathKind pathKind,
+    const char* path,
+    ISlangBlob** outPath)
+{
+    return m_fileSystem->getPath(pathKind, path, outPath);
+}
+
+void SharedCacheFileSystem::clearCache()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+}
+
+SlangResult SharedCacheFileSystem::enumeratePathContents(
+    const char* path,
+    FileSystemContentsCallBack callback,
+    void* userData)
+{
+    return m_fileSystem->enumeratePathContents(path, callback, userData);
+}
+
+Index SharedCacheFileSystem::getEntryCount()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.getCount();
+}
+
 /* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!  RelativeFileSystem  !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
 
 RelativeFileSystem::RelativeFileSystem(
@@ -8,6 +8,8 @@
 #include "slang-com-ptr.h"
 #include "slang.h"
 
+#include <mutex>
+
 namespace Slang
 {
 
@@ -65,6 +67,10 @@ public:
     virtual SLANG_NO_THROW SlangResult SLANG_MCALL remove(const char* path) SLANG_OVERRIDE;
     virtual SLANG_NO_THROW SlangResult SLANG_MCALL createDirectory(const char* path) SLANG_OVERRIDE;
 
+    /// Files loaded by the non-mutable instances that are at least this size are memory mapped
+    /// rather than read.
+    static const size_t kMinMappedFileSize = 256 * 1024;
+
     /// Get a default instance
     static ISlangFileSystem* getLoadSingleton() { return &g_load; }
     static ISlangFileSystemExt* getExtSingleton() { return &g_ext; }
@@ -268,6 +274,70 @@ protected:
     OSPathKind m_osPathKind = OSPathKind::None; ///< OS path kind
 };
 
+/* A file system over the OS file system, which keeps the contents of the files it loads so that
+they can be shared by everything that loads through it, such as every session of a global session.
+
+A file is identified by its unique identity, and the contents held for it are only used while the
+time it was last written and its size are the same as when it was loaded. Unlike CacheFileSystem
+the contents are checked on every load, so a file that changes on disk is seen to change.
+
+Can be used from several threads at once. */
+class SharedCacheFileSystem : public ISlangFileSystemExt, public ComBaseObject
+{
+public:
+    SLANG_COM_BASE_IUNKNOWN_ALL
+
+    // ISlangFileSystem
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL loadFile(char const* path, ISlangBlob** outBlob)
+        SLANG_OVERRIDE;
+
+    // ISlangCastable
+    virtual SLANG_NO_THROW void* SLANG_MCALL castAs(const Guid& guid) SLANG_OVERRIDE;
+
+    // ISlangFileSystemExt
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL
+    getFileUniqueIdentity(const char* path, ISlangBlob** outUniqueIdentity) SLANG_OVERRIDE;
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL calcCombinedPath(
+        SlangPathType fromPathType,
+        const char* fromPath,
+        const char* path,
+        ISlangBlob** pathOut) SLANG_OVERRIDE;
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL
+    getPathType(const char* path, SlangPathType* outPathType) SLANG_OVERRIDE;
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL
+    getPath(PathKind pathKind, const char* path, ISlangBlob** outPath) SLANG_OVERRIDE;
+    virtual SLANG_NO_THROW void SLANG_MCALL clearCache() SLANG_OVERRIDE;
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL enumeratePathContents(
+        const char* path,
+        FileSystemContentsCallBack callback,
+        void* userData) SLANG_OVERRIDE;
+    virtual SLANG_NO_THROW OSPathKind SLANG_MCALL getOSPathKind() SLANG_OVERRIDE
+    {
+        return OSPathKind::Direct;
+    }
+
+    /// Get the number of files whose contents are held
+    Index getEntryCount();
+
+    SharedCacheFileSystem();
+
+protected:
+    struct Entry
+    {
+        uint64_t modifiedTime;
+        uint64_t size;
+        ComPtr<ISlangBlob> blob;
+    };
+
+    ISlangUnknown* getInterface(const Guid& guid);
+    void* getObject(const Guid& guid);
+
+    ISlangFileSystemExt* m_fileSystem; ///< The OS file system
+
+    std::mutex m_mutex; ///< Guards m_entries
+    Dictionary<String, Entry> m_entries; ///< Maps unique identities to their contents
+};
+
 class RelativeFileSystem : public ISlangMutableFileSystem, public ComBaseObject
 {
 public:
@@ -30,6 +30,7 @@
 #include <fnmatch.h>
 #include <ftw.h> // for nftw
 #include <sys/file.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #endif
 
@@ -194,6 +195,39 @@ bool File::exists(const String& fileName)
 #endif
 }
 
+SlangResult File::getModifiedTimeAndSize(
+    const String& fileName,
+    uint64_t& outModifiedTime,
+    uint64_t& outSize)
+{
+#ifdef _WIN32
+    WIN32_FILE_ATTRIBUTE_DATA data;
+    if (!::GetFileAttributesExW(fileName.toWString(), GetFileExInfoStandard, &data))
+    {
+        return SLANG_E_NOT_FOUND;
+    }
+    outModifiedTime = (uint64_t(data.ftLastWriteTime.dwHighDateTime) << 32) |
+                      data.ftLastWriteTime.dwLowDateTime;
+    outSize = (uint64_t(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+#else
+    struct stat statVar;
+    if (::stat(fileName.getBuffer(), &statVar) != 0)
+    {
+        return SLANG_E_NOT_FOUND;
+    }
+    // Use the time to the nanosecond where it's available, so that a file written twice in a
+    // second is seen to have changed.
+#if SLANG_APPLE_FAMILY
+    const auto& modifiedTime = statVar.st_mtimespec;
+#else
+    const auto& modifiedTime = statVar.st_mtim;
+#endif
+    outModifiedTime = uint64_t(modifiedTime.tv_sec) * 1000000000 + uint64_t(modifiedTime.tv_nsec);
+    outSize = uint64_t(statVar.st_size);
+#endif
+    return SLANG_OK;
+}
+
 String Path::replaceExt(const String& path, const char* newExt)
 {
     StringBuilder sb(path.getLength() + 10);
@@ -1160,6 +1194,164 @@ SlangResult File::readAllBytes(const String& path, ScopedAllocation& out)
     return (sizeInBytes == readSizeInBytes) ? SLANG_OK : SLANG_FAIL;
 }
 
+namespace
+{ // anonymous
+
+/* A blob holding a read only view of the whole of a file, mapped into memory. */
+class MappedFileBlob : public BlobBase
+{
+public:
+    // ISlangBlob
+    SLANG_NO_THROW void const* SLANG_MCALL getBufferPointer() SLANG_OVERRIDE { return m_data; }
+    SLANG_NO_THROW size_t SLANG_MCALL getBufferSize() SLANG_OVERRIDE { return m_size; }
+
+    /// Map the file at `path`. If `mustBeTerminated` is set, fails with SLANG_E_NOT_AVAILABLE
+    /// unless the mapping is followed by a zero byte.
+    SlangResult init(const String& path, size_t minSize, bool mustBeTerminated);
+
+    ~MappedFileBlob();
+
+protected:
+    const void* m_data = nullptr;
+    size_t m_size = 0;
+#if SLANG_WINDOWS_FAMILY
+    HANDLE m_mapping = NULL;
+#endif
+};
+
+// The contents of the last page of a mapping past the end of the file are zeros, so a mapping
+// is terminated like a `ScopedAllocation::allocateTerminated` buffer unless the file ends on a
+// page boundary.
+bool _isMappingTerminated(size_t size)
+{
+#if SLANG_WINDOWS_FAMILY
+    SYSTEM_INFO systemInfo;
+    ::GetSystemInfo(&systemInfo);
+    const size_t pageSize = systemInfo.dwPageSize;
+#else
+    const size_t pageSize = size_t(::sysconf(_SC_PAGESIZE));
+#endif
+    return size % pageSize != 0;
+}
+
+SlangResult MappedFileBlob::init(const String& path, size_t minSize, bool mustBeTerminated)
+{
+#if SLANG_WINDOWS_FAMILY
+    HANDLE file = ::CreateFileW(
+        path.toWString(),
+        GENERIC_READ,
+        FILE_SHARE_READ,
+        NULL,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL,
+        NULL);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return SLANG_E_CANNOT_OPEN;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!::GetFileSizeEx(file, &fileSize) || UInt64(fileSize.QuadPart) > UInt64(~size_t(0)))
+    {
+        ::CloseHandle(file);
+        return SLANG_FAIL;
+    }
+    m_size = size_t(fileSize.QuadPart);
+    if (m_size < minSize || (mustBeTerminated && !_isMappingTerminated(m_size)))
+    {
+        ::CloseHandle(file);
+        m_size = 0;
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    // The mapping keeps the file open, so the handle isn't needed once it's created.
+    m_mapping = m_size ? ::CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL) : NULL;
+    ::CloseHandle(file);
+    if (m_size == 0)
+    {
+        return SLANG_OK;
+    }
+    if (m_mapping == NULL)
+    {
+        return SLANG_FAIL;
+    }
+
+    m_data = ::MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0);
+    return m_data ? SLANG_OK : SLANG_FAIL;
+#else
+    int file = ::open(path.getBuffer(), O_RDONLY);
+    if (file == -1)
+    {
+        return SLANG_E_CANNOT_OPEN;
+    }
+
+    struct stat fileStat;
+    if (::fstat(file, &fileStat) != 0 || UInt64(fileStat.st_size) > UInt64(~size_t(0)))
+    {
+        ::close(file);
+        return SLANG_FAIL;
+    }
+    m_size = size_t(fileStat.st_size);
+    if (m_size < minSize || (mustBeTerminated && !_isMappingTerminated(m_size)))
+    {
+        ::close(file);
+        m_size = 0;
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    // An empty file can't be mapped, and there is nothing to reference anyway.
+    void* data = m_size ? ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, file, 0) : nullptr;
+    // The mapping stays valid once the file is closed.
+    ::close(file);
+    if (data == MAP_FAILED)
+    {
+        m_size = 0;
+        return SLANG_FAIL;
+    }
+    m_data = data;
+    return SLANG_OK;
+#endif
+}
+
+MappedFileBlob::~MappedFileBlob()
+{
+#if SLANG_WINDOWS_FAMILY
+    if (m_data)
+    {
+        ::UnmapViewOfFile(m_data);
+    }
+    if (m_mapping)
+    {
+        ::CloseHandle(m_mapping);
+    }
+#else
+    if (m_data)
+    {
+        ::munmap(const_cast<void*>(m_data), m_size);
+    }
+#endif
+}
+
+} // namespace
+
+SlangResult File::mapAllBytes(const String& path, ISlangBlob** outBlob)
+{
+    MappedFileBlob* mappedBlob = new MappedFileBlob;
+    ComPtr<ISlangBlob> blob(mappedBlob);
+    SLANG_RETURN_ON_FAIL(mappedBlob->init(path, 0, false));
+    *outBlob = blob.detach();
+    return SLANG_OK;
+}
+
+SlangResult File::mapAllBytesTerminated(const String& path, size_t minSize, ISlangBlob** outBlob)
+{
+    MappedFileBlob* mappedBlob = new MappedFileBlob;
+    ComPtr<ISlangBlob> blob(mappedBlob);
+    SLANG_RETURN_ON_FAIL(mappedBlob->init(path, minSize, true));
+    *outBlob = blob.detach();
+    return SLANG_OK;
+}
+
 SlangResult File::writeAllBytes(const String& path, const void* data, size_t size)
 {
     FileStream stream;
@@ -14,11 +14,31 @@ class File
 public:
     static bool exists(const String& fileName);
 
+    /// Get the time the file was last written and its size. The time is only meaningful when
+    /// compared with other times returned for the file.
+    static SlangResult getModifiedTimeAndSize(
+        const String& fileName,
+        uint64_t& outModifiedTime,
+        uint64_t& outSize);
+
     static SlangResult readAllText(const String& fileName, String& outString);
 
     static SlangResult readAllBytes(const String& fileName, List<unsigned char>& out);
     static SlangResult readAllBytes(const String& fileName, ScopedAllocation& out);
 
+    /// Map the whole of the file into memory read only, so its contents are paged in as they
+    /// are accessed rather than copied up front. The mapping lasts as long as the blob, and the
+    /// file must not be modified or truncated while it does.
+    static SlangResult mapAllBytes(const String& fileName, ISlangBlob** outBlob);
+
+    /// Map the file like `mapAllBytes` if it's at least `minSize` bytes, and its contents are
+    /// followed by a zero byte in memory, as they are when read into a `ScopedAllocation`.
+    /// Fails with SLANG_E_NOT_AVAILABLE for other files, which can be read instead.
+    static SlangResult mapAllBytesTerminated(
+        const String& fileName,
+        size_t minSize,
+        ISlangBlob** outBlob);
+
     static SlangResult writeAllText(const String& fileName, const String& text);
 
     static SlangResult writeAllTextIfChanged(const String& fileName, UnownedStringSlice text);
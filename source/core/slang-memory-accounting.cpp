@@ -0,0 +1,56 @@
+#include "slang-memory-accounting.h"
+
+namespace Slang
+{
+
+void MemoryAccounting::Counter::add(size_t size)
+{
+    const uint64_t newCurrent = (current += size);
+    uint64_t oldPeak = peak;
+    while (newCurrent > oldPeak && !peak.compare_exchange_weak(oldPeak, newCurrent))
+    {
+    }
+}
+
+void MemoryAccounting::Counter::remove(size_t size)
+{
+    current -= size;
+}
+
+void MemoryAccounting::add(MemoryCategory category, size_t size)
+{
+    m_categories[Index(category)].add(size);
+    m_total.add(size);
+}
+
+void MemoryAccounting::remove(MemoryCategory category, size_t size)
+{
+    m_categories[Index(category)].remove(size);
+    m_total.remove(size);
+}
+
+SlangResult MemoryAccounting::getUsage(
+    SlangMemoryCategory category,
+    uint64_t* outCurrentBytes,
+    uint64_t* outPeakBytes) const
+{
+    if (category >= SLANG_MEMORY_CATEGORY_COUNT_OF)
+        return SLANG_E_INVALID_ARG;
+
+    const Counter& counter =
+        category == SLANG_MEMORY_CATEGORY_TOTAL ? m_total : m_categories[Index(category) - 1];
+    if (outCurrentBytes)
+        *outCurrentBytes = counter.current;
+    if (outPeakBytes)
+        *outPeakBytes = counter.peak;
+    return SLANG_OK;
+}
+
+void MemoryAccounting::resetPeaks()
+{
+    for (auto& counter : m_categories)
+        counter.peak = uint64_t(counter.current);
+    m_total.peak = uint64_t(m_total.current);
+}
+
+} // namespace Slang
@@ -0,0 +1,67 @@
+#ifndef SLANG_CORE_MEMORY_ACCOUNTING_H
+#define SLANG_CORE_MEMORY_ACCOUNTING_H
+
+#include "slang-smart-pointer.h"
+
+#include <atomic>
+
+namespace Slang
+{
+
+/// The subsystems whose memory is accounted for. The values match `SlangMemoryCategory`, after
+/// its `SLANG_MEMORY_CATEGORY_TOTAL`.
+enum class MemoryCategory
+{
+    IR,  ///< The arenas of IR modules
+    AST, ///< The arenas of AST builders
+    CountOf,
+};
+
+/// Counts the bytes currently allocated, and the most that have been allocated at once, for each
+/// memory category and for all of them together. It is safe to add and remove bytes from several
+/// threads at once.
+class MemoryAccounting : public RefObject
+{
+public:
+    void add(MemoryCategory category, size_t size);
+    void remove(MemoryCategory category, size_t size);
+
+    uint64_t getCurrentBytes(MemoryCategory category) const
+    {
+        return m_categories[Index(category)].current;
+    }
+    uint64_t getPeakBytes(MemoryCategory category) const
+    {
+        return m_categories[Index(category)].peak;
+    }
+    uint64_t getTotalCurrentBytes() const { return m_total.current; }
+    uint64_t getTotalPeakBytes() const { return m_total.peak; }
+
+    /// Get the current and peak bytes of a category of the public API, where
+    /// SLANG_MEMORY_CATEGORY_TOTAL is all of the categories together.
+    SlangResult getUsage(
+        SlangMemoryCategory category,
+        uint64_t* outCurrentBytes,
+        uint64_t* outPeakBytes) const;
+
+    /// Make the peaks the current number of bytes, such that later peaks are only those reached
+    /// from now on.
+    void resetPeaks();
+
+protected:
+    struct Counter
+    {
+        void add(size_t size);
+        void remove(size_t size);
+
+        std::atomic<uint64_t> current{0};
+        std::atomic<uint64_t> peak{0};
+    };
+
+    Counter m_categories[Index(MemoryCategory::CountOf)];
+    Counter m_total;
+};
+
+} // namespace Slang
+
+#endif
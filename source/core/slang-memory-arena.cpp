@@ -79,6 +79,27 @@ void MemoryArena::swapWith(ThisType& rhs)
     Swap(m_usedBlocks, rhs.m_usedBlocks);
 
     m_blockFreeList.swapWith(rhs.m_blockFreeList);
+
+    Swap(m_accounting, rhs.m_accounting);
+    Swap(m_accountingCategory, rhs.m_accountingCategory);
+}
+
+void MemoryArena::setAccounting(MemoryAccounting* accounting, MemoryCategory category)
+{
+    const size_t allocated = calcTotalMemoryAllocated();
+    if (m_accounting)
+        m_accounting->remove(m_accountingCategory, allocated);
+    m_accounting = accounting;
+    m_accountingCategory = category;
+    if (m_accounting)
+        m_accounting->add(m_accountingCategory, allocated);
+}
+
+void MemoryArena::_freeBlockAlloc(Block* block)
+{
+    if (m_accounting)
+        m_accounting->remove(m_accountingCategory, size_t(block->m_end - block->m_alloc));
+    ::free(block->m_alloc);
 }
 
 void MemoryArena::_resetCurrentBlock()
@@ -118,7 +139,7 @@ void MemoryArena::_deallocateBlocksPayload(Block* start)
     while (cur)
     {
         // Deallocate the block
-        ::free(cur->m_alloc);
+        _freeBlockAlloc(cur);
         cur = cur->m_next;
     }
 }
@@ -130,7 +151,7 @@ void MemoryArena::_deallocateBlocks(Block* start)
     {
         Block* next = cur->m_next;
         // Deallocate the block
-        ::free(cur->m_alloc);
+        _freeBlockAlloc(cur);
 
         m_blockFreeList.deallocate(cur);
         cur = next;
@@ -157,7 +178,7 @@ void MemoryArena::_deallocateBlock(Block* block)
     else
     {
         // Must be odd sized so free it
-        ::free(block->m_alloc);
+        _freeBlockAlloc(block);
         // Free it in the block list
         m_blockFreeList.deallocate(block);
     }
@@ -276,6 +297,9 @@ MemoryArena::Block* MemoryArena::_newBlock(size_t allocSize, size_t alignment)
     block->m_end = alloc + allocSize;
     block->m_next = nullptr;
 
+    if (m_accounting)
+        m_accounting->add(m_accountingCategory, allocSize);
+
     return block;
 }
 
@@ -301,6 +325,9 @@ void MemoryArena::addExternalBlock(void* inData, size_t size)
     block->m_end = alloc + size;
     block->m_next = nullptr;
 
+    if (m_accounting)
+        m_accounting->add(m_accountingCategory, size);
+
     // We don't want to place at start, if there is any used blocks - as that is the one
     // that is being split from and can be rewound. So we place just behind in that case
     if (m_usedBlocks)
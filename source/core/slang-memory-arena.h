@@ -2,6 +2,7 @@
 #define SLANG_CORE_MEMORY_ARENA_H
 
 #include "slang-free-list.h"
+#include "slang-memory-accounting.h"
 #include "slang.h"
 
 #include <stdlib.h>
@@ -167,6 +168,10 @@ public:
     // Swap this with rhs
     void swapWith(ThisType& rhs);
 
+    /// Count the memory of the blocks of this arena, including those already allocated, in
+    /// `category` of `accounting` (which can be nullptr), instead of where it was counted before.
+    void setAccounting(MemoryAccounting* accounting, MemoryCategory category);
+
     /// Default Ctor
     MemoryArena();
     /// Construct with block size and alignment. Block alignment must be a power of 2.
@@ -222,6 +227,9 @@ protected:
     /// Handles the rewinding of the cursor for the more complicated cases
     void _rewindToCursor(const void* cursor);
 
+    /// Free the allocation of a block, and remove it from the accounting
+    void _freeBlockAlloc(Block* block);
+
     uint8_t* m_start;   ///< The start of the current block (pointed to by m_usedBlocks)
     uint8_t* m_end;     ///< The end of the current block
     uint8_t* m_current; ///< The current position in current block
@@ -238,6 +246,9 @@ protected:
 
     FreeList m_blockFreeList; ///< Holds all of the blocks for fast allocation/free
 
+    RefPtr<MemoryAccounting> m_accounting; ///< Where block memory is counted, if anywhere
+    MemoryCategory m_accountingCategory = MemoryCategory::IR;
+
 private:
     // Disable
     MemoryArena(const ThisType& rhs) = delete;
@@ -82,6 +82,7 @@ protected:
             m_canonicalPath = String();
             m_uncompressedSizeInBytes = 0;
             m_contents.setNull();
+            m_decompressedContents.setNull();
         }
 
         void initDirectory(const String& canonicalPath)
@@ -90,6 +91,7 @@ protected:
             m_canonicalPath = canonicalPath;
             m_uncompressedSizeInBytes = 0;
             m_contents.setNull();
+            m_decompressedContents.setNull();
         }
         void initFile(const String& canonicalPath, size_t uncompressedSize, ISlangBlob* blob)
         {
@@ -102,6 +104,7 @@ protected:
             m_type = SLANG_PATH_TYPE_FILE;
             m_canonicalPath = canonicalPath;
             m_contents.setNull();
+            m_decompressedContents.setNull();
             m_uncompressedSizeInBytes = 0;
         }
         void setContents(size_t uncompressedSize, ISlangBlob* blob)
@@ -110,6 +113,7 @@ protected:
             SLANG_ASSERT(blob);
             m_uncompressedSizeInBytes = uncompressedSize;
             m_contents = blob;
+            m_decompressedContents.setNull();
         }
 
         SlangPathType m_type;
@@ -119,6 +123,9 @@ protected:
         /// if it's actually being stored in some other representation (such as compressed)
         size_t m_uncompressedSizeInBytes;
         ComPtr<ISlangBlob> m_contents; ///< Can be compressed or not
+        /// If m_contents is compressed, its contents once decompressed, if they have been
+        /// decompressed ahead of being loaded
+        ComPtr<ISlangBlob> m_decompressedContents;
     };
 
     void* getInterface(const Guid& guid);
@@ -1,25 +1,159 @@
 #include "slang-performance-profiler.h"
 
+#include "slang-blob.h"
 #include "slang-dictionary.h"
+#include "slang-string-escape-util.h"
+
+#include <atomic>
+#include <mutex>
 
 namespace Slang
 {
+// All trace timestamps are relative to a single process wide epoch, so that
+// traces recorded on different threads line up when merged.
+static std::chrono::time_point<std::chrono::high_resolution_clock> _getTraceEpoch()
+{
+    static const auto epoch = std::chrono::high_resolution_clock::now();
+    return epoch;
+}
+
+static uint32_t _allocateThreadIndex()
+{
+    static std::atomic<uint32_t> nextThreadIndex{1};
+    return nextThreadIndex++;
+}
+
 class PerformanceProfilerImpl : public PerformanceProfiler
 {
 public:
-    OrderedDictionary<const char*, FuncProfileInfo> data;
+    /// What one thread has recorded. Only that thread adds to it, but the results are merged
+    /// from the buffers of all threads, so both lock `mutex`.
+    struct ThreadBuffer
+    {
+        std::mutex mutex;
+        OrderedDictionary<const char*, FuncProfileInfo> data;
+        List<ProfileTraceEvent> traceEvents;
+        int traceDepth = 0;
+        Index currentTagIndex = -1;
+        uint32_t threadIndex = _allocateThreadIndex();
 
-    virtual FuncProfileContext enterFunction(const char* funcName) override
+        /// False once the thread has exited. Guarded by `threadBuffersMutex`.
+        bool isThreadAlive = true;
+    };
+
+    /// Registers the buffer of the current thread while the thread is alive.
+    struct ThreadBufferHolder
     {
-        auto entry = data.tryGetValue(funcName);
-        if (!entry)
+        ThreadBufferHolder(PerformanceProfilerImpl* profiler)
+            : profiler(profiler), buffer(profiler->_addThreadBuffer())
         {
-            data.add(funcName, FuncProfileInfo());
-            entry = data.tryGetValue(funcName);
         }
-        entry->invocationCount++;
+        ~ThreadBufferHolder() { profiler->_removeThreadBuffer(buffer); }
+
+        PerformanceProfilerImpl* profiler;
+        ThreadBuffer* buffer;
+    };
+
+    // Guards `threadBuffers`, `tags` and `tagIndexMap`. It is taken before the mutex of a
+    // buffer.
+    std::mutex threadBuffersMutex;
+    List<ThreadBuffer*> threadBuffers;
+    List<String> tags;
+    Dictionary<String, Index> tagIndexMap;
+
+    std::atomic<bool> traceEnabled{false};
+
+    ~PerformanceProfilerImpl()
+    {
+        for (auto buffer : threadBuffers)
+            delete buffer;
+    }
+
+    static FuncProfileInfo& _getInfo(
+        OrderedDictionary<const char*, FuncProfileInfo>& data,
+        const char* funcName)
+    {
+        data.addIfNotExists(funcName, FuncProfileInfo());
+        return *data.tryGetValue(funcName);
+    }
+
+    ThreadBuffer* _getThreadBuffer()
+    {
+        thread_local ThreadBufferHolder holder(this);
+        return holder.buffer;
+    }
+
+    ThreadBuffer* _addThreadBuffer()
+    {
+        auto buffer = new ThreadBuffer();
+        std::lock_guard<std::mutex> lock(threadBuffersMutex);
+        threadBuffers.add(buffer);
+        return buffer;
+    }
+
+    void _removeThreadBuffer(ThreadBuffer* buffer)
+    {
+        std::lock_guard<std::mutex> lock(threadBuffersMutex);
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        buffer->isThreadAlive = false;
+    }
+
+    // Delete the buffers of threads that have exited. Must be called with
+    // `threadBuffersMutex` held, once what they recorded is no longer needed.
+    void _deleteExitedThreadBuffers()
+    {
+        Index count = 0;
+        for (auto buffer : threadBuffers)
+        {
+            if (buffer->isThreadAlive)
+                threadBuffers[count++] = buffer;
+            else
+                delete buffer;
+        }
+        threadBuffers.setCount(count);
+    }
+
+    /// Add up what every thread has recorded for each function, in the order the functions
+    /// were first recorded.
+    void getMergedData(OrderedDictionary<const char*, FuncProfileInfo>& outData)
+    {
+        std::lock_guard<std::mutex> lock(threadBuffersMutex);
+        for (auto buffer : threadBuffers)
+        {
+            std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+            for (const auto& func : buffer->data)
+            {
+                auto& merged = _getInfo(outData, func.key);
+                merged.invocationCount += func.value.invocationCount;
+                merged.duration += func.value.duration;
+            }
+        }
+    }
+
+    bool hasTraceEvents()
+    {
+        std::lock_guard<std::mutex> lock(threadBuffersMutex);
+        for (auto buffer : threadBuffers)
+        {
+            std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+            if (buffer->traceEvents.getCount())
+                return true;
+        }
+        return false;
+    }
+
+    virtual FuncProfileContext enterFunction(const char* funcName) override
+    {
+        auto buffer = _getThreadBuffer();
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        _getInfo(buffer->data, funcName).invocationCount++;
         FuncProfileContext ctx;
         ctx.funcName = funcName;
+        if (traceEnabled)
+        {
+            ctx.tagIndex = buffer->currentTagIndex;
+            ctx.depth = buffer->traceDepth++;
+        }
         ctx.startTime = std::chrono::high_resolution_clock::now();
         return ctx;
     }
@@ -27,11 +161,30 @@ public:
     {
         auto endTime = std::chrono::high_resolution_clock::now();
         auto duration = endTime - ctx.startTime;
-        auto entry = data.tryGetValue(ctx.funcName);
-        entry->duration += duration;
+
+        auto buffer = _getThreadBuffer();
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        // The entry may have been cleared since the function was entered.
+        _getInfo(buffer->data, ctx.funcName).duration += duration;
+
+        if (traceEnabled)
+        {
+            ProfileTraceEvent event;
+            event.funcName = ctx.funcName;
+            event.tagIndex = ctx.tagIndex;
+            event.threadIndex = buffer->threadIndex;
+            event.depth = ctx.depth;
+            event.startTime = ctx.startTime - _getTraceEpoch();
+            event.duration = duration;
+            buffer->traceEvents.add(event);
+            buffer->traceDepth = ctx.depth;
+        }
     }
     virtual void getResult(StringBuilder& out) override
     {
+        OrderedDictionary<const char*, FuncProfileInfo> data;
+        getMergedData(data);
+
         char buffer[512];
         for (const auto& func : data)
         {
@@ -44,25 +197,131 @@ public:
                 << static_cast<uint64_t>(milliseconds.count()) << "ms\n";
         }
     }
-    virtual void clear() override { data.clear(); }
-    virtual void dispose() override { data = decltype(data)(); }
+    virtual void clear() override
+    {
+        std::lock_guard<std::mutex> lock(threadBuffersMutex);
+        _deleteExitedThreadBuffers();
+        for (auto buffer : threadBuffers)
+        {
+            std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+            buffer->data.clear();
+            buffer->traceEvents.clear();
+        }
+    }
+    virtual void dispose() override
+    {
+        std::lock_guard<std::mutex> lock(threadBuffersMutex);
+        _deleteExitedThreadBuffers();
+        for (auto buffer : threadBuffers)
+        {
+            std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+            buffer->data = decltype(buffer->data)();
+            buffer->traceEvents = decltype(buffer->traceEvents)();
+            buffer->currentTagIndex = -1;
+            buffer->traceDepth = 0;
+        }
+        tags = decltype(tags)();
+        tagIndexMap = decltype(tagIndexMap)();
+    }
+
+    virtual void setTraceEnabled(bool enable) override
+    {
+        // Make sure the epoch is established before any event is recorded.
+        _getTraceEpoch();
+        traceEnabled = enable;
+    }
+    virtual bool isTraceEnabled() override { return traceEnabled; }
+
+    virtual Index pushTag(const UnownedStringSlice& tag) override
+    {
+        Index tagIndex;
+        {
+            std::lock_guard<std::mutex> lock(threadBuffersMutex);
+            String tagString(tag);
+            if (auto existing = tagIndexMap.tryGetValue(tagString))
+            {
+                tagIndex = *existing;
+            }
+            else
+            {
+                tagIndex = tags.getCount();
+                tags.add(tagString);
+                tagIndexMap.add(tagString, tagIndex);
+            }
+        }
+
+        auto buffer = _getThreadBuffer();
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        const Index previousTagIndex = buffer->currentTagIndex;
+        buffer->currentTagIndex = tagIndex;
+        return previousTagIndex;
+    }
+    virtual void popTag(Index previousTagIndex) override
+    {
+        auto buffer = _getThreadBuffer();
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        buffer->currentTagIndex = previousTagIndex;
+    }
+
+    virtual void getTraceJSON(StringBuilder& out) override
+    {
+        auto handler = StringEscapeUtil::getHandler(StringEscapeUtil::Style::JSON);
+
+        // The events of each thread are written in turn. Every event has the index of its
+        // thread as its "tid", and viewers lay them out by thread and time.
+        std::lock_guard<std::mutex> lock(threadBuffersMutex);
+        out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        bool isFirst = true;
+        for (auto buffer : threadBuffers)
+        {
+            std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+            for (const auto& event : buffer->traceEvents)
+            {
+                if (!isFirst)
+                    out << ",";
+                isFirst = false;
+                out << "\n{\"name\":";
+                StringEscapeUtil::appendQuoted(handler, UnownedStringSlice(event.funcName), out);
+
+                // Chrome trace timestamps are in microseconds.
+                out << ",\"cat\":\"slang\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.threadIndex
+                    << ",\"ts\":" << String(double(event.startTime.count()) / 1000.0, "%.3f")
+                    << ",\"dur\":" << String(double(event.duration.count()) / 1000.0, "%.3f")
+                    << ",\"args\":{\"depth\":" << event.depth;
+                if (event.tagIndex >= 0 && event.tagIndex < tags.getCount())
+                {
+                    out << ",\"tag\":";
+                    StringEscapeUtil::appendQuoted(
+                        handler,
+                        tags[event.tagIndex].getUnownedSlice(),
+                        out);
+                }
+                out << "}}";
+            }
+        }
+        out << "\n]}\n";
+    }
 };
 
 PerformanceProfiler* Slang::PerformanceProfiler::getProfiler()
 {
-    thread_local static PerformanceProfilerImpl profiler = PerformanceProfilerImpl();
+    // The profiler is shared by all threads, so that what is recorded on worker threads is
+    // part of the results. Each thread records into a buffer of its own.
+    static PerformanceProfilerImpl profiler;
     return &profiler;
 }
 
-SlangProfiler::SlangProfiler(PerformanceProfiler* profiler)
+SlangProfiler::SlangProfiler(PerformanceProfiler* profiler, MemoryAccounting* memoryAccounting)
 {
     PerformanceProfilerImpl* profilerImpl = static_cast<PerformanceProfilerImpl*>(profiler);
-    size_t entryCount = profilerImpl->data.getCount();
+    OrderedDictionary<const char*, FuncProfileInfo> data;
+    profilerImpl->getMergedData(data);
+    size_t entryCount = data.getCount();
 
     m_profilEntries.reserve(entryCount);
 
     int index = 0;
-    for (auto func : profilerImpl->data)
+    for (auto func : data)
     {
         ProfileInfo profileEntry{};
         size_t strSize = std::min(sizeof(profileEntry.funcName) - 1, strlen(func.key));
@@ -77,11 +336,31 @@ SlangProfiler::SlangProfiler(PerformanceProfiler* profiler)
         m_profilEntries.insert(index, profileEntry);
         index++;
     }
+
+    if (profilerImpl->isTraceEnabled() || profilerImpl->hasTraceEvents())
+    {
+        StringBuilder traceJSON;
+        profilerImpl->getTraceJSON(traceJSON);
+        m_traceJSON = traceJSON.produceString();
+    }
+
+    if (memoryAccounting)
+    {
+        m_hasMemoryUsage = true;
+        for (uint32_t i = 0; i < SLANG_MEMORY_CATEGORY_COUNT_OF; ++i)
+        {
+            memoryAccounting->getUsage(
+                SlangMemoryCategory(i),
+                &m_memoryCurrentBytes[i],
+                &m_memoryPeakBytes[i]);
+        }
+    }
 }
 
 ISlangUnknown* SlangProfiler::getInterface(const Guid& guid)
 {
-    if (guid == SlangProfiler::getTypeGuid())
+    if (guid == ISlangUnknown::getTypeGuid() || guid == ISlangProfiler::getTypeGuid() ||
+        guid == ISlangProfiler2::getTypeGuid())
         return static_cast<ISlangUnknown*>(this);
     else
         return nullptr;
@@ -117,4 +396,32 @@ uint32_t SlangProfiler::getEntryInvocationTimes(uint32_t index)
 
     return m_profilEntries[index].invocationCount;
 }
+
+SlangResult SlangProfiler::getTraceJSON(ISlangBlob** outTraceJSON)
+{
+    if (!outTraceJSON)
+        return SLANG_E_INVALID_ARG;
+    if (m_traceJSON.getLength() == 0)
+        return SLANG_E_NOT_AVAILABLE;
+
+    *outTraceJSON = StringBlob::create(m_traceJSON).detach();
+    return SLANG_OK;
+}
+
+SlangResult SlangProfiler::getMemoryUsage(
+    SlangMemoryCategory category,
+    uint64_t* outCurrentBytes,
+    uint64_t* outPeakBytes)
+{
+    if (category >= SLANG_MEMORY_CATEGORY_COUNT_OF)
+        return SLANG_E_INVALID_ARG;
+    if (!m_hasMemoryUsage)
+        return SLANG_E_NOT_AVAILABLE;
+
+    if (outCurrentBytes)
+        *outCurrentBytes = m_memoryCurrentBytes[category];
+    if (outPeakBytes)
+        *outPeakBytes = m_memoryPeakBytes[category];
+    return SLANG_OK;
+}
 } // namespace Slang
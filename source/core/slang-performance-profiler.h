@@ -3,6 +3,7 @@
 
 #include "../core/slang-list.h"
 #include "slang-com-helper.h"
+#include "slang-memory-accounting.h"
 #include "slang-string.h"
 
 #include <chrono>
@@ -21,6 +22,25 @@ struct FuncProfileContext
 {
     const char* funcName = nullptr;
     std::chrono::time_point<std::chrono::high_resolution_clock> startTime;
+    /// Index of the trace tag active when the function was entered, or -1 if none.
+    Index tagIndex = -1;
+    /// Nesting depth of the function at entry. Only meaningful when tracing is enabled.
+    int depth = 0;
+};
+
+/// A single complete (enter/exit) event recorded when tracing is enabled.
+struct ProfileTraceEvent
+{
+    const char* funcName = nullptr;
+    /// Index into the profiler's tag list, or -1 if no tag was active.
+    Index tagIndex = -1;
+    /// Small process-unique index of the thread that recorded the event.
+    uint32_t threadIndex = 0;
+    /// Nesting depth, 0 is outermost.
+    int depth = 0;
+    /// Start time relative to the process wide trace epoch.
+    std::chrono::nanoseconds startTime = std::chrono::nanoseconds::zero();
+    std::chrono::nanoseconds duration = std::chrono::nanoseconds::zero();
 };
 
 class PerformanceProfiler
@@ -32,6 +52,20 @@ public:
     virtual void clear() = 0;
     virtual void dispose() = 0;
 
+    /// When enabled, every enter/exit pair is additionally recorded as a ProfileTraceEvent
+    /// with its nesting depth, thread and the currently active tag.
+    virtual void setTraceEnabled(bool enable) = 0;
+    virtual bool isTraceEnabled() = 0;
+
+    /// Make `tag` the active tag for subsequently entered functions.
+    /// Returns the previously active tag index, which should be passed to `popTag`.
+    virtual Index pushTag(const UnownedStringSlice& tag) = 0;
+    virtual void popTag(Index previousTagIndex) = 0;
+
+    /// Write the recorded trace events in the Chrome trace event JSON format
+    /// (loadable by chrome://tracing and Perfetto).
+    virtual void getTraceJSON(StringBuilder& out) = 0;
+
 public:
     static PerformanceProfiler* getProfiler();
 };
@@ -49,7 +83,27 @@ struct PerformanceProfilerFuncRAIIContext
     }
 };
 
-struct SlangProfiler : public ISlangProfiler, public RefObject
+/// Tags all functions profiled within the scope, used to attribute time to
+/// a module or an entry point in trace output.
+struct PerformanceProfilerTagRAIIContext
+{
+    Index previousTagIndex = -1;
+    bool active = false;
+    PerformanceProfilerTagRAIIContext(const UnownedStringSlice& tag)
+    {
+        auto profiler = PerformanceProfiler::getProfiler();
+        active = profiler->isTraceEnabled();
+        if (active)
+            previousTagIndex = profiler->pushTag(tag);
+    }
+    ~PerformanceProfilerTagRAIIContext()
+    {
+        if (active)
+            PerformanceProfiler::getProfiler()->popTag(previousTagIndex);
+    }
+};
+
+struct SlangProfiler : public ISlangProfiler2, public RefObject
 {
 public:
     SLANG_REF_OBJECT_IUNKNOWN_ALL
@@ -59,20 +113,33 @@ public:
         int invocationCount = 0;
         std::chrono::nanoseconds duration = std::chrono::nanoseconds::zero();
     };
-    SlangProfiler(PerformanceProfiler* profiler);
+    /// Takes a snapshot of the entries of `profiler`, and of the memory use counted by
+    /// `memoryAccounting` if it isn't nullptr.
+    SlangProfiler(PerformanceProfiler* profiler, MemoryAccounting* memoryAccounting = nullptr);
     ISlangUnknown* getInterface(const Guid& guid);
 
     virtual SLANG_NO_THROW size_t SLANG_MCALL getEntryCount() override;
     virtual SLANG_NO_THROW const char* SLANG_MCALL getEntryName(uint32_t index) override;
     virtual SLANG_NO_THROW long SLANG_MCALL getEntryTimeMS(uint32_t index) override;
     virtual SLANG_NO_THROW uint32_t SLANG_MCALL getEntryInvocationTimes(uint32_t index) override;
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL getTraceJSON(ISlangBlob** outTraceJSON) override;
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL getMemoryUsage(
+        SlangMemoryCategory category,
+        uint64_t* outCurrentBytes,
+        uint64_t* outPeakBytes) override;
 
 private:
     List<ProfileInfo> m_profilEntries;
+    String m_traceJSON;
+
+    bool m_hasMemoryUsage = false;
+    uint64_t m_memoryCurrentBytes[SLANG_MEMORY_CATEGORY_COUNT_OF] = {};
+    uint64_t m_memoryPeakBytes[SLANG_MEMORY_CATEGORY_COUNT_OF] = {};
 };
 
 #define SLANG_PROFILE PerformanceProfilerFuncRAIIContext _profileContext(__func__)
 #define SLANG_PROFILE_SECTION(s) PerformanceProfilerFuncRAIIContext _profileContext##s(#s)
+#define SLANG_PROFILE_TAG(tag) PerformanceProfilerTagRAIIContext _profileTagContext(tag)
 
 } // namespace Slang
 
@@ -5,133 +5,206 @@
 #include "../core/slang-stream.h"
 #include "../core/slang-string-util.h"
 
+#include <chrono>
+
 namespace Slang
 {
 
+// Once this many accesses have been journaled for a shard, the journal is compacted
+// into the shard's index in the background.
+static const Count kJournalCompactionCount = 4096;
+
+static const char kHexDigits[] = "0123456789abcdef";
+
 PersistentCache::PersistentCache(const Desc& desc)
 {
     m_cacheDirectory = Path::simplify(desc.directory);
     Path::createDirectory(m_cacheDirectory);
 
-    m_lockFileName = Path::simplify(m_cacheDirectory + "/lock");
-    m_indexFileName = Path::simplify(m_cacheDirectory + "/index");
-
-    m_lockFile.open(m_lockFileName);
+    for (Index i = 0; i < kShardCount; ++i)
+    {
+        auto& shard = m_shards[i];
+        const UnownedStringSlice digit(kHexDigits + i, 1);
+        shard.indexFileName = Path::simplify(m_cacheDirectory + "/index-" + digit);
+        shard.journalFileName = Path::simplify(m_cacheDirectory + "/journal-" + digit);
+        shard.lockFile.open(Path::simplify(m_cacheDirectory + "/lock-" + digit));
+    }
+    m_evictionLockFile.open(Path::simplify(m_cacheDirectory + "/lock-evict"));
 
     m_maxEntryCount = desc.maxEntryCount;
 
     resetStats();
 
-    initialize();
+    // Read the existing indices, so the entry count is known.
+    for (auto& shard : m_shards)
+    {
+        refreshIndex(shard);
+    }
 }
 
-PersistentCache::~PersistentCache() {}
+PersistentCache::~PersistentCache()
+{
+    if (m_compactionThread.joinable())
+    {
+        m_compactionThread.join();
+    }
+}
 
 SlangResult PersistentCache::clear()
 {
-    if (!m_lockFile.isOpen())
+    for (auto& shard : m_shards)
     {
-        return SLANG_E_CANNOT_OPEN;
+        if (!shard.lockFile.isOpen())
+        {
+            return SLANG_E_CANNOT_OPEN;
+        }
     }
 
-    // Acquire the exclusive lock.
-    std::lock_guard<std::mutex> mutexLock(m_mutex);
-    LockFileGuard fileLock(m_lockFile);
+    // Acquire the exclusive locks of all shards, in order.
+    for (auto& shard : m_shards)
+    {
+        shard.mutex.lock();
+        shard.lockFile.lock();
+        shard.journalMutex.lock();
+    }
 
     struct Visitor : Path::Visitor
     {
         const String& directory;
-        const String& lockFileName;
 
-        Visitor(const String& directory, const String& lockFileName)
-            : directory(directory), lockFileName(lockFileName)
+        Visitor(const String& directory)
+            : directory(directory)
         {
         }
 
         void accept(Path::Type type, const UnownedStringSlice& fileName) SLANG_OVERRIDE
         {
-            String fullPath = Path::simplify(directory + "/" + fileName);
-            ;
-            if (type == Path::Type::File && lockFileName != fullPath)
+            // Keep the lock files, as they may be held open by other processes.
+            if (type == Path::Type::File && !fileName.startsWith(toSlice("lock")))
             {
-                Path::remove(fullPath);
+                Path::remove(Path::simplify(directory + "/" + fileName));
             }
         }
     };
 
-    Visitor visitor(m_cacheDirectory, m_lockFileName);
+    Visitor visitor(m_cacheDirectory);
     Path::find(m_cacheDirectory, nullptr, &visitor);
 
-    m_stats.entryCount = 0;
+    for (Index i = kShardCount - 1; i >= 0; --i)
+    {
+        auto& shard = m_shards[i];
+        shard.journalCount = 0;
+        publishIndex(shard, CacheIndex(), IndexStamp());
+
+        shard.journalMutex.unlock();
+        shard.lockFile.unlock();
+        shard.mutex.unlock();
+    }
 
     return SLANG_OK;
 }
 
+PersistentCache::Stats PersistentCache::getStats() const
+{
+    Stats stats;
+    stats.hitCount = m_hitCount;
+    stats.missCount = m_missCount;
+    stats.entryCount = 0;
+    for (const auto& shard : m_shards)
+    {
+        std::shared_lock<std::shared_mutex> lock(shard.indexMutex);
+        stats.entryCount += Count(shard.index.getCount());
+    }
+    return stats;
+}
+
 void PersistentCache::resetStats()
 {
-    m_stats.entryCount = 0;
-    m_stats.hitCount = 0;
-    m_stats.missCount = 0;
+    m_hitCount = 0;
+    m_missCount = 0;
 }
 
 SlangResult PersistentCache::readEntry(const Key& key, ISlangBlob** outData)
 {
     // Be pessimistic and assume we have a cache miss.
-    ++m_stats.missCount;
+    ++m_missCount;
 
-    if (!m_lockFile.isOpen())
+    Shard& shard = getShard(key);
+    if (!shard.lockFile.isOpen())
     {
         return SLANG_E_CANNOT_OPEN;
     }
 
+    // Look the entry up without taking any locks. If that fails, which may just be because
+    // the index or entry is being written right now, try again with the shard locked.
+    bool isInIndex = false;
+    SlangResult result = findInIndex(shard, key, isInIndex);
+    if (result == SLANG_E_NOT_FOUND || (SLANG_SUCCEEDED(result) && !isInIndex))
+    {
+        return SLANG_E_NOT_FOUND;
+    }
+    if (SLANG_SUCCEEDED(result))
+    {
+        ScopedAllocation data;
+        if (SLANG_SUCCEEDED(File::readAllBytes(getEntryFileName(key), data)))
+        {
+            --m_missCount;
+            ++m_hitCount;
+            appendJournal(shard, key);
+            auto blob = RawBlob::moveCreate(data);
+            *outData = blob.detach();
+            return SLANG_OK;
+        }
+    }
+
+    return readEntryLocked(shard, key, outData);
+}
+
+SlangResult PersistentCache::readEntryLocked(Shard& shard, const Key& key, ISlangBlob** outData)
+{
     // Acquire the exclusive lock.
-    std::lock_guard<std::mutex> mutexLock(m_mutex);
-    LockFileGuard fileLock(m_lockFile);
+    std::lock_guard<std::mutex> mutexLock(shard.mutex);
+    LockFileGuard fileLock(shard.lockFile);
 
     // Return if index does not exist.
-    if (!File::exists(m_indexFileName))
+    if (!File::exists(shard.indexFileName))
     {
         return SLANG_E_NOT_FOUND;
     }
 
     // Read the cache index.
     CacheIndex cacheIndex;
-    SLANG_RETURN_ON_FAIL(readIndex(m_indexFileName, cacheIndex));
-
-    // Increase the age of all entries in the cache.
-    for (auto& entry : cacheIndex)
-    {
-        ++entry.age;
-    }
+    IndexStamp stamp;
+    SLANG_RETURN_ON_FAIL(readIndex(shard.indexFileName, cacheIndex, stamp));
 
     // Find the entry.
     Index entryIndex =
         cacheIndex.findFirstIndex([&key](const CacheEntry& entry) { return entry.key == key; });
     if (entryIndex == -1)
     {
+        publishIndex(shard, cacheIndex, stamp);
         return SLANG_E_NOT_FOUND;
     }
 
     // Read the entry.
-    String entryFileName = getEntryFileName(key);
     ScopedAllocation data;
-    SlangResult result = File::readAllBytes(entryFileName, data);
+    SlangResult result = File::readAllBytes(getEntryFileName(key), data);
     if (result == SLANG_OK)
     {
-        --m_stats.missCount;
-        ++m_stats.hitCount;
-        cacheIndex[entryIndex].age = 0;
+        --m_missCount;
+        ++m_hitCount;
+        publishIndex(shard, cacheIndex, stamp);
+        appendJournal(shard, key);
         auto blob = RawBlob::moveCreate(data);
         *outData = blob.detach();
-    }
-    else
-    {
-        cacheIndex.removeAt(entryIndex);
+        return SLANG_OK;
     }
 
-    // Write the cache index.
-    SLANG_RETURN_ON_FAIL(writeIndex(m_indexFileName, cacheIndex));
-    m_stats.entryCount = (Count)cacheIndex.getCount();
+    // The entry can't be read, so remove it from the index.
+    std::lock_guard<std::mutex> journalLock(shard.journalMutex);
+    applyJournalLocked(shard, cacheIndex);
+    cacheIndex.removeAt(entryIndex);
+    SLANG_RETURN_ON_FAIL(storeIndexLocked(shard, cacheIndex, stamp));
 
     return result;
 }
@@ -140,87 +213,80 @@ SlangResult PersistentCache::writeEntry(const Key& key, ISlangBlob* data)
 {
     SLANG_ASSERT(data);
 
-    if (!m_lockFile.isOpen())
+    Shard& shard = getShard(key);
+    if (!shard.lockFile.isOpen())
     {
         return SLANG_E_CANNOT_OPEN;
     }
 
-    // Acquire the exclusive lock.
-    std::lock_guard<std::mutex> mutexLock(m_mutex);
-    LockFileGuard fileLock(m_lockFile);
+    {
+        // Acquire the exclusive lock.
+        std::lock_guard<std::mutex> mutexLock(shard.mutex);
+        LockFileGuard fileLock(shard.lockFile);
+        std::lock_guard<std::mutex> journalLock(shard.journalMutex);
+
+        // Read the cache index.
+        // We ignore any errors when reading the index and just write a new one.
+        CacheIndex cacheIndex;
+        IndexStamp stamp;
+        if (SLANG_FAILED(readIndex(shard.indexFileName, cacheIndex, stamp)))
+        {
+            cacheIndex.clear();
+            stamp = IndexStamp();
+        }
+        applyJournalLocked(shard, cacheIndex);
 
-    // Read the cache index.
-    // We ignore any errors when reading the index and just write a new one.
-    CacheIndex cacheIndex;
-    readIndex(m_indexFileName, cacheIndex);
+        const uint64_t accessTime = getAccessTime();
 
-    // Increase the age of all entries in the cache and get the index of
-    // the oldest entry.
-    Index oldestEntryIndex = -1;
-    uint32_t oldestEntryAge = 0;
-    for (Index entryIndex = 0; entryIndex < cacheIndex.getCount(); ++entryIndex)
-    {
-        auto& entry = cacheIndex[entryIndex];
-        ++entry.age;
-        if (entry.age > oldestEntryAge)
+        // Write the cache entry, unless it's already there.
+        String entryFileName = getEntryFileName(key);
+        Index entryIndex = cacheIndex.findFirstIndex([&key](const CacheEntry& entry)
+                                                     { return entry.key == key; });
+        const bool isNewEntry = entryIndex < 0 || !File::exists(entryFileName);
+        if (isNewEntry)
         {
-            oldestEntryIndex = entryIndex;
-            oldestEntryAge = entry.age;
+            SLANG_RETURN_ON_FAIL(File::writeAllBytes(
+                entryFileName,
+                data->getBufferPointer(),
+                data->getBufferSize()));
         }
-    }
 
-    // Write the cache entry.
-    String entryFileName = getEntryFileName(key);
-    SLANG_RETURN_ON_FAIL(
-        File::writeAllBytes(entryFileName, data->getBufferPointer(), data->getBufferSize()));
+        // Update the index.
+        if (entryIndex >= 0)
+        {
+            cacheIndex[entryIndex].lastAccess = accessTime;
+        }
+        else
+        {
+            cacheIndex.add(CacheEntry{key, 0, accessTime});
+        }
 
-    // Update the index.
-    if (m_maxEntryCount > 0 && cacheIndex.getCount() >= m_maxEntryCount)
-    {
-        // Replace oldest entry.
-        SLANG_ASSERT(oldestEntryIndex >= 0);
-        File::remove(getEntryFileName(cacheIndex[oldestEntryIndex].key));
-        cacheIndex[oldestEntryIndex] = CacheEntry{key, 0};
-    }
-    else
-    {
-        // Add new entry.
-        cacheIndex.add(CacheEntry{key, 0});
+        // Write the cache index.
+        SlangResult result = storeIndexLocked(shard, cacheIndex, stamp);
+        if (SLANG_FAILED(result))
+        {
+            // If writing the index failed, remove the entry file to avoid growing the cache.
+            if (isNewEntry)
+            {
+                Path::remove(entryFileName);
+            }
+            return result;
+        }
     }
 
-    // Write the cache index.
-    SlangResult result = writeIndex(m_indexFileName, cacheIndex);
-    if (result == SLANG_OK)
-    {
-        m_stats.entryCount = (Count)cacheIndex.getCount();
-    }
-    else
+    if (m_maxEntryCount > 0)
     {
-        // If writing the index failed, remove the entry file to avoid growing the cache.
-        Path::remove(entryFileName);
+        evictIfNeeded();
     }
 
-    return result;
+    return SLANG_OK;
 }
 
-SlangResult PersistentCache::initialize()
+PersistentCache::Shard& PersistentCache::getShard(const Key& key)
 {
-    if (!m_lockFile.isOpen())
-    {
-        return SLANG_E_CANNOT_OPEN;
-    }
-
-    // Acquire the exclusive lock.
-    std::lock_guard<std::mutex> mutexLock(m_mutex);
-    LockFileGuard fileLock(m_lockFile);
-
-    CacheIndex cacheIndex;
-    if (SLANG_SUCCEEDED(readIndex(m_indexFileName, cacheIndex)))
-    {
-        m_stats.entryCount = (Count)cacheIndex.getCount();
-    }
-
-    return SLANG_OK;
+    // The first hex digit of the key, which is also the first character of its file name.
+    const uint8_t firstByte = reinterpret_cast<const uint8_t*>(key.data)[0];
+    return m_shards[firstByte >> 4];
 }
 
 String PersistentCache::getEntryFileName(const Key& key)
@@ -230,39 +296,89 @@ String PersistentCache::getEntryFileName(const Key& key)
     return str;
 }
 
+uint64_t PersistentCache::getAccessTime()
+{
+    // Use the wall clock so times from different processes can be compared, but make sure
+    // accesses from this process are always ordered.
+    const auto sinceEpoch = std::chrono::system_clock::now().time_since_epoch();
+    const uint64_t now =
+        uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(sinceEpoch).count());
+
+    uint64_t lastTime = m_lastAccessTime.load();
+    uint64_t time;
+    do
+    {
+        time = now > lastTime ? now : lastTime + 1;
+    } while (!m_lastAccessTime.compare_exchange_weak(lastTime, time));
+    return time;
+}
+
 struct CacheIndexHeader
 {
     char magic[4];
     uint32_t version;
     uint32_t count;
-    uint32_t reserved;
+    // Changed each time the index is written.
+    uint32_t generation;
 };
 
 static const char* kMagic = "SLS$";
-static const uint32_t kVersion = 1;
+static const uint32_t kVersion = 2;
 
-SlangResult PersistentCache::readIndex(const String& fileName, CacheIndex& outIndex)
+static SlangResult _readIndexHeader(
+    FileStream& fs,
+    CacheIndexHeader& outHeader,
+    size_t entrySize,
+    Int64& outFileSize)
 {
-    FileStream fs;
-    SLANG_RETURN_ON_FAIL(fs.init(fileName, FileMode::Open));
-
     // Get file size.
     SLANG_RETURN_ON_FAIL(fs.seek(SeekOrigin::End, 0));
-    size_t fileSize = (size_t)fs.getPosition();
+    outFileSize = fs.getPosition();
     SLANG_RETURN_ON_FAIL(fs.seek(SeekOrigin::Start, 0));
 
-    CacheIndexHeader header;
-    SLANG_RETURN_ON_FAIL(fs.readExactly(&header, sizeof(header)));
-    if (::memcmp(header.magic, kMagic, 4) != 0 || header.version != kVersion)
+    SLANG_RETURN_ON_FAIL(fs.readExactly(&outHeader, sizeof(outHeader)));
+    if (::memcmp(outHeader.magic, kMagic, 4) != 0 || outHeader.version != kVersion)
     {
         return SLANG_E_INTERNAL_FAIL;
     }
 
     // Return if payload does not have the right size.
-    if (header.count * sizeof(CacheEntry) != fileSize - sizeof(header))
+    if (Int64(outHeader.count) * Int64(entrySize) != outFileSize - Int64(sizeof(outHeader)))
     {
         return SLANG_E_INTERNAL_FAIL;
     }
+    return SLANG_OK;
+}
+
+SlangResult PersistentCache::readIndexStamp(const String& fileName, IndexStamp& outStamp)
+{
+    if (!File::exists(fileName))
+    {
+        return SLANG_E_NOT_FOUND;
+    }
+
+    FileStream fs;
+    SLANG_RETURN_ON_FAIL(fs.init(fileName, FileMode::Open, FileAccess::Read, FileShare::ReadWrite));
+
+    CacheIndexHeader header;
+    SLANG_RETURN_ON_FAIL(_readIndexHeader(fs, header, sizeof(CacheEntry), outStamp.fileSize));
+    outStamp.generation = header.generation;
+    outStamp.count = header.count;
+    return SLANG_OK;
+}
+
+SlangResult PersistentCache::readIndex(
+    const String& fileName,
+    CacheIndex& outIndex,
+    IndexStamp& outStamp)
+{
+    FileStream fs;
+    SLANG_RETURN_ON_FAIL(fs.init(fileName, FileMode::Open, FileAccess::Read, FileShare::ReadWrite));
+
+    CacheIndexHeader header;
+    SLANG_RETURN_ON_FAIL(_readIndexHeader(fs, header, sizeof(CacheEntry), outStamp.fileSize));
+    outStamp.generation = header.generation;
+    outStamp.count = header.count;
 
     outIndex.setCount(header.count);
     SLANG_RETURN_ON_FAIL(fs.readExactly(outIndex.getBuffer(), header.count * sizeof(CacheEntry)));
@@ -270,21 +386,333 @@ SlangResult PersistentCache::readIndex(const String& fileName, CacheIndex& outIn
     return SLANG_OK;
 }
 
-SlangResult PersistentCache::writeIndex(const String& fileName, const CacheIndex& index)
+SlangResult PersistentCache::writeIndex(
+    const String& fileName,
+    const CacheIndex& index,
+    uint32_t generation,
+    IndexStamp& outStamp)
 {
     FileStream fs;
-    SLANG_RETURN_ON_FAIL(fs.init(fileName, FileMode::Create));
+    SLANG_RETURN_ON_FAIL(
+        fs.init(fileName, FileMode::Create, FileAccess::Write, FileShare::ReadWrite));
 
     CacheIndexHeader header;
     ::memcpy(header.magic, kMagic, 4);
     header.version = kVersion;
     header.count = (uint32_t)index.getCount();
-    header.reserved = 0;
+    header.generation = generation;
     SLANG_RETURN_ON_FAIL(fs.write(&header, sizeof(header)));
 
     SLANG_RETURN_ON_FAIL(fs.write(index.getBuffer(), index.getCount() * sizeof(CacheEntry)));
 
+    outStamp.generation = generation;
+    outStamp.count = header.count;
+    outStamp.fileSize = Int64(sizeof(header) + index.getCount() * sizeof(CacheEntry));
+    return SLANG_OK;
+}
+
+SlangResult PersistentCache::refreshIndex(Shard& shard)
+{
+    IndexStamp stamp;
+    SlangResult result = readIndexStamp(shard.indexFileName, stamp);
+    if (result == SLANG_E_NOT_FOUND)
+    {
+        publishIndex(shard, CacheIndex(), IndexStamp());
+        return SLANG_OK;
+    }
+    SLANG_RETURN_ON_FAIL(result);
+
+    {
+        std::shared_lock<std::shared_mutex> lock(shard.indexMutex);
+        if (shard.indexStamp == stamp)
+        {
+            return SLANG_OK;
+        }
+    }
+
+    // The index has changed since it was last read, so read it again. If it is being
+    // written right now this may fail, or the index may change again before it's published,
+    // which the next refresh will notice.
+    CacheIndex cacheIndex;
+    SLANG_RETURN_ON_FAIL(readIndex(shard.indexFileName, cacheIndex, stamp));
+    publishIndex(shard, cacheIndex, stamp);
+    return SLANG_OK;
+}
+
+void PersistentCache::publishIndex(Shard& shard, const CacheIndex& index, const IndexStamp& stamp)
+{
+    std::unique_lock<std::shared_mutex> lock(shard.indexMutex);
+    shard.index.clear();
+    for (const auto& entry : index)
+    {
+        shard.index[entry.key] = entry.lastAccess;
+    }
+    shard.indexStamp = stamp;
+}
+
+SlangResult PersistentCache::findInIndex(Shard& shard, const Key& key, bool& outIsFound)
+{
+    IndexStamp stamp;
+    SLANG_RETURN_ON_FAIL(readIndexStamp(shard.indexFileName, stamp));
+
+    for (;;)
+    {
+        {
+            std::shared_lock<std::shared_mutex> lock(shard.indexMutex);
+            if (shard.indexStamp == stamp)
+            {
+                outIsFound = shard.index.containsKey(key);
+                return SLANG_OK;
+            }
+        }
+
+        // The index has changed since it was last read, so read it again.
+        CacheIndex cacheIndex;
+        SLANG_RETURN_ON_FAIL(readIndex(shard.indexFileName, cacheIndex, stamp));
+        publishIndex(shard, cacheIndex, stamp);
+    }
+}
+
+SlangResult PersistentCache::readJournal(
+    const String& fileName,
+    Dictionary<Key, uint64_t>& outAccessTimes)
+{
+    if (!File::exists(fileName))
+    {
+        return SLANG_OK;
+    }
+
+    ScopedAllocation data;
+    SLANG_RETURN_ON_FAIL(File::readAllBytes(fileName, data));
+
+    // A record may be being appended right now, so ignore any partial record at the end.
+    const Count recordCount = Count(data.getSizeInBytes() / sizeof(CacheEntry));
+    const CacheEntry* records = (const CacheEntry*)data.getData();
+    for (Count i = 0; i < recordCount; ++i)
+    {
+        CacheEntry record;
+        ::memcpy(&record, records + i, sizeof(record));
+
+        auto accessTime = outAccessTimes.tryGetValue(record.key);
+        if (!accessTime)
+        {
+            outAccessTimes.add(record.key, record.lastAccess);
+        }
+        else if (record.lastAccess > *accessTime)
+        {
+            *accessTime = record.lastAccess;
+        }
+    }
+    return SLANG_OK;
+}
+
+void PersistentCache::appendJournal(Shard& shard, const Key& key)
+{
+    const CacheEntry record{key, 0, getAccessTime()};
+    {
+        std::lock_guard<std::mutex> journalLock(shard.journalMutex);
+
+        // A lost record just makes the entry look older than it is, so errors are ignored.
+        FileStream fs;
+        if (SLANG_FAILED(fs.init(
+                shard.journalFileName,
+                FileMode::Append,
+                FileAccess::Write,
+                FileShare::ReadWrite)) ||
+            SLANG_FAILED(fs.write(&record, sizeof(record))))
+        {
+            return;
+        }
+    }
+
+    if (++shard.journalCount >= kJournalCompactionCount)
+    {
+        requestCompaction(shard);
+    }
+}
+
+void PersistentCache::applyJournalLocked(Shard& shard, CacheIndex& ioIndex)
+{
+    Dictionary<Key, uint64_t> accessTimes;
+    if (SLANG_FAILED(readJournal(shard.journalFileName, accessTimes)) || !accessTimes.getCount())
+    {
+        return;
+    }
+
+    for (auto& entry : ioIndex)
+    {
+        if (auto accessTime = accessTimes.tryGetValue(entry.key))
+        {
+            if (*accessTime > entry.lastAccess)
+                entry.lastAccess = *accessTime;
+        }
+    }
+}
+
+SlangResult PersistentCache::storeIndexLocked(
+    Shard& shard,
+    const CacheIndex& index,
+    const IndexStamp& prevStamp)
+{
+    // If there was no index, start from an arbitrary generation, so it's unlikely to
+    // match that of an index that was removed.
+    const uint32_t generation =
+        prevStamp.fileSize < 0 ? uint32_t(getAccessTime()) : prevStamp.generation + 1;
+
+    IndexStamp stamp;
+    SLANG_RETURN_ON_FAIL(writeIndex(shard.indexFileName, index, generation, stamp));
+
+    // The journal has been applied to the index, so it can be removed.
+    if (File::exists(shard.journalFileName))
+    {
+        File::remove(shard.journalFileName);
+    }
+    shard.journalCount = 0;
+
+    publishIndex(shard, index, stamp);
     return SLANG_OK;
 }
 
+SlangResult PersistentCache::compactShard(Shard& shard)
+{
+    std::lock_guard<std::mutex> mutexLock(shard.mutex);
+    LockFileGuard fileLock(shard.lockFile);
+    std::lock_guard<std::mutex> journalLock(shard.journalMutex);
+
+    CacheIndex cacheIndex;
+    IndexStamp stamp;
+    SLANG_RETURN_ON_FAIL(readIndex(shard.indexFileName, cacheIndex, stamp));
+    applyJournalLocked(shard, cacheIndex);
+    return storeIndexLocked(shard, cacheIndex, stamp);
+}
+
+SlangResult PersistentCache::removeEntry(Shard& shard, const Key& key)
+{
+    std::lock_guard<std::mutex> mutexLock(shard.mutex);
+    LockFileGuard fileLock(shard.lockFile);
+    std::lock_guard<std::mutex> journalLock(shard.journalMutex);
+
+    CacheIndex cacheIndex;
+    IndexStamp stamp;
+    SLANG_RETURN_ON_FAIL(readIndex(shard.indexFileName, cacheIndex, stamp));
+
+    Index entryIndex =
+        cacheIndex.findFirstIndex([&key](const CacheEntry& entry) { return entry.key == key; });
+    if (entryIndex < 0)
+    {
+        publishIndex(shard, cacheIndex, stamp);
+        return SLANG_E_NOT_FOUND;
+    }
+
+    applyJournalLocked(shard, cacheIndex);
+    File::remove(getEntryFileName(key));
+    cacheIndex.removeAt(entryIndex);
+    return storeIndexLocked(shard, cacheIndex, stamp);
+}
+
+void PersistentCache::evictIfNeeded()
+{
+    std::lock_guard<std::mutex> evictionLock(m_evictionMutex);
+    LockFileGuard evictionFileLock(m_evictionLockFile);
+
+    for (;;)
+    {
+        // Count the entries in all shards, and find the least recently used one,
+        // taking into account accesses that are only in the journals so far.
+        Count entryCount = 0;
+        Shard* oldestShard = nullptr;
+        Key oldestKey;
+        uint64_t oldestAccess = 0;
+
+        for (auto& shard : m_shards)
+        {
+            if (SLANG_FAILED(refreshIndex(shard)))
+            {
+                continue;
+            }
+
+            Dictionary<Key, uint64_t> accessTimes;
+            readJournal(shard.journalFileName, accessTimes);
+
+            std::shared_lock<std::shared_mutex> lock(shard.indexMutex);
+            entryCount += Count(shard.index.getCount());
+            for (const auto& entry : shard.index)
+            {
+                uint64_t lastAccess = entry.second;
+                if (auto journalAccess = accessTimes.tryGetValue(entry.first))
+                {
+                    if (*journalAccess > lastAccess)
+                        lastAccess = *journalAccess;
+                }
+
+                if (!oldestShard || lastAccess < oldestAccess)
+                {
+                    oldestShard = &shard;
+                    oldestKey = entry.first;
+                    oldestAccess = lastAccess;
+                }
+            }
+        }
+
+        if (entryCount <= m_maxEntryCount || !oldestShard)
+        {
+            return;
+        }
+
+        // If the entry has already gone, by some other process evicting it for example,
+        // just count again.
+        SlangResult result = removeEntry(*oldestShard, oldestKey);
+        if (SLANG_FAILED(result) && result != SLANG_E_NOT_FOUND)
+        {
+            return;
+        }
+    }
+}
+
+void PersistentCache::requestCompaction(Shard& shard)
+{
+    shard.needsCompaction = true;
+
+    std::lock_guard<std::mutex> lock(m_compactionMutex);
+    if (m_isCompactionRunning)
+    {
+        return;
+    }
+
+    // Any previous compaction thread has finished (or is just about to).
+    if (m_compactionThread.joinable())
+    {
+        m_compactionThread.join();
+    }
+    m_isCompactionRunning = true;
+    m_compactionThread = std::thread([this]() { runCompaction(); });
+}
+
+void PersistentCache::runCompaction()
+{
+    for (;;)
+    {
+        for (auto& shard : m_shards)
+        {
+            if (shard.needsCompaction.exchange(false))
+            {
+                compactShard(shard);
+            }
+        }
+
+        // Stop, unless more compaction was requested in the meantime.
+        std::lock_guard<std::mutex> lock(m_compactionMutex);
+        bool hasRequest = false;
+        for (auto& shard : m_shards)
+        {
+            hasRequest = hasRequest || shard.needsCompaction;
+        }
+        if (!hasRequest)
+        {
+            m_isCompactionRunning = false;
+            return;
+        }
+    }
+}
+
 } // namespace Slang
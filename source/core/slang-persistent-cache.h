@@ -1,10 +1,14 @@
 #pragma once
 #include "../core/slang-crypto.h"
+#include "../core/slang-dictionary.h"
 #include "../core/slang-io.h"
 #include "../core/slang-string.h"
 #include "slang.h"
 
+#include <atomic>
 #include <mutex>
+#include <shared_mutex>
+#include <thread>
 
 namespace Slang
 {
@@ -12,8 +16,15 @@ namespace Slang
 /// Implements a simple persistent cache on the filesystem for storing key/value pairs.
 /// Keys are SHA1 hashes and values are arbitrary blobs of data.
 /// The cache is save for concurrent access from multiple threads/processes by using
-/// a lock file within the cache directory. Furthermore, the cache implements a LRU
+/// lock files within the cache directory. Furthermore, the cache implements a LRU
 /// eviction policy.
+///
+/// The cache index is split into shards by the first hex digit of the key, each with its own
+/// index file and lock, so writes to different shards don't contend. Reading an entry takes no
+/// locks: the reader checks the shard's index file is unchanged from the copy it holds in memory,
+/// and records the access in an append-only journal instead of rewriting the index. The journal
+/// is folded into the index when the shard is next written, or in the background once it grows
+/// large.
 class PersistentCache : public RefObject
 {
 public:
@@ -37,13 +48,16 @@ public:
 
     using Key = SHA1::Digest;
 
+    /// The number of shards the cache index is split into.
+    static const Index kShardCount = 16;
+
     PersistentCache(const Desc& desc);
     ~PersistentCache();
 
     /// Clear the contents of the cache by removing the cache index and all entry files.
     SlangResult clear();
 
-    const Stats& getStats() const { return m_stats; }
+    Stats getStats() const;
     void resetStats();
 
     /// Read an entry from the cache.
@@ -51,6 +65,8 @@ public:
     SlangResult readEntry(const Key& key, ISlangBlob** outData);
 
     /// Write an entry to the cache.
+    /// The data for a key is assumed not to change, so writing an entry that is already in
+    /// the cache only marks it as recently used.
     /// Returns SLANG_OK if successful.
     SlangResult writeEntry(const Key& key, ISlangBlob* data);
 
@@ -58,31 +74,113 @@ private:
     struct CacheEntry
     {
         Key key;
-        uint32_t age;
+        uint32_t reserved;
+        // Time of the most recent access, see `getAccessTime`.
+        uint64_t lastAccess;
     };
 
     using CacheIndex = List<CacheEntry>;
 
-    SlangResult initialize();
+    /// Identifies the contents of an index file, so a reader can check the copy of the index
+    /// it holds is current without locking.
+    struct IndexStamp
+    {
+        uint32_t generation = 0;
+        uint32_t count = 0;
+        // -1 if there is no index file.
+        Int64 fileSize = -1;
+
+        bool operator==(const IndexStamp& rhs) const
+        {
+            return generation == rhs.generation && count == rhs.count && fileSize == rhs.fileSize;
+        }
+    };
+
+    struct Shard
+    {
+        String indexFileName;
+        String journalFileName;
+
+        // For exclusive locking we need both a mutex (acquired first)
+        // followed by a a file lock. The mutex is needed because on Linux
+        // the file lock is only locking between processes, not threads.
+        std::mutex mutex;
+        LockFile lockFile;
+
+        // Serializes appends to the journal within this process.
+        // Acquired after the exclusive locks when both are needed.
+        std::mutex journalMutex;
+        // Number of records this process appended to the journal since it was last compacted.
+        std::atomic<Count> journalCount{0};
+        std::atomic<bool> needsCompaction{false};
+
+        // Guards the in memory copy of the index. It's only held briefly, and readers
+        // share it, so concurrent reads don't block each other.
+        mutable std::shared_mutex indexMutex;
+        IndexStamp indexStamp;
+        Dictionary<Key, uint64_t> index;
+    };
+
+    Shard& getShard(const Key& key);
 
     String getEntryFileName(const Key& key);
 
-    SlangResult readIndex(const String& fileName, CacheIndex& outIndex);
-    SlangResult writeIndex(const String& fileName, const CacheIndex& index);
+    /// Returns a time for an access made now. Times are comparable between processes,
+    /// and strictly increase within a process.
+    uint64_t getAccessTime();
+
+    SlangResult readIndexStamp(const String& fileName, IndexStamp& outStamp);
+    SlangResult readIndex(const String& fileName, CacheIndex& outIndex, IndexStamp& outStamp);
+    SlangResult writeIndex(
+        const String& fileName,
+        const CacheIndex& index,
+        uint32_t generation,
+        IndexStamp& outStamp);
+
+    /// Make the in memory copy of the shard's index current, without locking.
+    SlangResult refreshIndex(Shard& shard);
+    void publishIndex(Shard& shard, const CacheIndex& index, const IndexStamp& stamp);
+    /// Find if `key` is in the shard's index, without locking.
+    SlangResult findInIndex(Shard& shard, const Key& key, bool& outIsFound);
+
+    SlangResult readJournal(const String& fileName, Dictionary<Key, uint64_t>& outAccessTimes);
+    void appendJournal(Shard& shard, const Key& key);
+
+    // These must be called with the shard's mutex, file lock and journal mutex held.
+    void applyJournalLocked(Shard& shard, CacheIndex& ioIndex);
+    SlangResult storeIndexLocked(
+        Shard& shard,
+        const CacheIndex& index,
+        const IndexStamp& prevStamp);
+
+    SlangResult readEntryLocked(Shard& shard, const Key& key, ISlangBlob** outData);
+    SlangResult compactShard(Shard& shard);
+    /// Remove `key`, returning SLANG_E_NOT_FOUND if it is already gone.
+    SlangResult removeEntry(Shard& shard, const Key& key);
+    /// Remove least recently used entries until there are at most `m_maxEntryCount`.
+    void evictIfNeeded();
+
+    void requestCompaction(Shard& shard);
+    void runCompaction();
 
     String m_cacheDirectory;
-    String m_lockFileName;
-    String m_indexFileName;
 
-    // For exclusive locking we need both a mutex (acquired first)
-    // followed by a a file lock. The mutex is needed because on Linux
-    // the file lock is only locking between processes, not threads.
-    std::mutex m_mutex;
-    Slang::LockFile m_lockFile;
+    Shard m_shards[kShardCount];
+
+    // Eviction looks at all shards, so is serialized separately.
+    std::mutex m_evictionMutex;
+    Slang::LockFile m_evictionLockFile;
+
+    std::mutex m_compactionMutex;
+    std::thread m_compactionThread;
+    bool m_isCompactionRunning = false;
+
+    std::atomic<uint64_t> m_lastAccessTime{0};
 
     Count m_maxEntryCount;
 
-    Stats m_stats;
+    std::atomic<Count> m_hitCount{0};
+    std::atomic<Count> m_missCount{0};
 
     // Used for unit tests.
     friend struct PersistentCacheTest;
@@ -8,6 +8,10 @@
 #include "slang-deflate-compression-system.h"
 #include "slang-lz4-compression-system.h"
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 namespace Slang
 {
 
@@ -44,36 +48,98 @@ void* RiffFileSystem::castAs(const Guid& guid)
     return getObject(guid);
 }
 
+SlangResult RiffFileSystem::_decompress(const Entry& entry, ISlangBlob** outBlob)
+{
+    ISlangBlob* contents = entry.m_contents;
+
+    // Okay lets decompress into a blob
+    ScopedAllocation alloc;
+    void* dst = alloc.allocateTerminated(entry.m_uncompressedSizeInBytes);
+    SLANG_RETURN_ON_FAIL(m_compressionSystem->decompress(
+        contents->getBufferPointer(),
+        contents->getBufferSize(),
+        entry.m_uncompressedSizeInBytes,
+        dst));
+
+    auto blob = RawBlob::moveCreate(alloc);
+
+    *outBlob = blob.detach();
+    return SLANG_OK;
+}
+
 SlangResult RiffFileSystem::loadFile(char const* path, ISlangBlob** outBlob)
 {
     Entry* entry;
     SLANG_RETURN_ON_FAIL(_loadFile(path, &entry));
 
-    ISlangBlob* contents = entry->m_contents;
+    ISlangBlob* contents = entry->m_decompressedContents;
+    if (!contents)
+    {
+        if (m_compressionSystem)
+        {
+            return _decompress(*entry, outBlob);
+        }
+        // Just return as is
+        contents = entry->m_contents;
+    }
 
-    if (m_compressionSystem)
+    contents->addRef();
+    *outBlob = contents;
+    return SLANG_OK;
+}
+
+SlangResult RiffFileSystem::decompressAll(Count threadCount)
+{
+    if (!m_compressionSystem)
     {
-        // Okay lets decompress into a blob
-        ScopedAllocation alloc;
-        void* dst = alloc.allocateTerminated(entry->m_uncompressedSizeInBytes);
-        SLANG_RETURN_ON_FAIL(m_compressionSystem->decompress(
-            contents->getBufferPointer(),
-            contents->getBufferSize(),
-            entry->m_uncompressedSizeInBytes,
-            dst));
-
-        auto blob = RawBlob::moveCreate(alloc);
-
-        *outBlob = blob.detach();
         return SLANG_OK;
     }
-    else
+
+    List<Entry*> entries;
+    for (auto& [_, entry] : m_entries)
     {
-        // Just return as is
-        contents->addRef();
-        *outBlob = contents;
-        return SLANG_OK;
+        if (entry.m_type == SLANG_PATH_TYPE_FILE && entry.m_contents &&
+            !entry.m_decompressedContents)
+        {
+            entries.add(&entry);
+        }
+    }
+
+    const Count entryCount = entries.getCount();
+    List<ComPtr<ISlangBlob>> blobs;
+    blobs.setCount(entryCount);
+    List<SlangResult> results;
+    results.setCount(entryCount);
+
+    // The compression systems are stateless, so entries can be decompressed at the same time.
+    // The entries themselves are only written once all the threads are done.
+    std::atomic<Index> nextEntryIndex(0);
+    auto worker = [&]()
+    {
+        for (;;)
+        {
+            const Index entryIndex = nextEntryIndex++;
+            if (entryIndex >= entryCount)
+                break;
+            results[entryIndex] = _decompress(*entries[entryIndex], blobs[entryIndex].writeRef());
+        }
+    };
+
+    // This thread decompresses too, so it only needs `threadCount - 1` helpers.
+    std::vector<std::thread> threads;
+    const Count helperCount = Math::Min(threadCount, entryCount) - 1;
+    for (Index i = 0; i < helperCount; ++i)
+        threads.emplace_back(worker);
+    worker();
+    for (auto& thread : threads)
+        thread.join();
+
+    for (Index i = 0; i < entryCount; ++i)
+    {
+        SLANG_RETURN_ON_FAIL(results[i]);
+        entries[i]->m_decompressedContents = blobs[i];
     }
+    return SLANG_OK;
 }
 
 SlangResult RiffFileSystem::saveFile(const char* path, const void* data, size_t size)
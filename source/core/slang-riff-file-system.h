@@ -85,6 +85,14 @@ public:
     /// Pass in nullptr, if no compression is wanted.
     explicit RiffFileSystem(ICompressionSystem* compressionSystem);
 
+    /// Decompress the contents of every file that hasn't been loaded yet, spread across
+    /// `threadCount` threads (including the calling thread). The contents are then held, so that
+    /// loading a file just returns them rather than decompressing on the loading thread.
+    ///
+    /// Each file is compressed on its own, so without this any file can still be loaded without
+    /// decompressing the others. Does nothing if the contents aren't compressed.
+    SlangResult decompressAll(Count threadCount);
+
     /// True if this appears to be Riff archive
     static bool isArchive(const void* data, size_t sizeInBytes);
 
@@ -92,6 +100,8 @@ protected:
     void* getInterface(const Guid& guid);
     void* getObject(const Guid& guid);
 
+    SlangResult _decompress(const Entry& entry, ISlangBlob** outBlob);
+
     ComPtr<ICompressionSystem> m_compressionSystem;
 
     CompressionStyle m_compressionStyle;
@@ -295,8 +295,15 @@ struct DumpVisitor : public RiffContainer::Visitor
     return write(container->getRoot(), true, stream);
 }
 
-/* static */ SlangResult RiffUtil::read(Stream* stream, RiffContainer& outContainer)
+/* Reads the container from the stream. If `contents` is set it holds `contentsSize` bytes that are
+the whole of what the stream reads, and data payloads are referenced there rather than copied. */
+static SlangResult _read(
+    Stream* stream,
+    const uint8_t* contents,
+    size_t contentsSize,
+    RiffContainer& outContainer)
 {
+    typedef RiffContainer::Chunk Chunk;
     typedef RiffContainer::ScopeChunk ScopeChunk;
     outContainer.reset();
 
@@ -304,13 +311,14 @@ struct DumpVisitor : public RiffContainer::Visitor
     {
         RiffListHeader header;
 
-        SLANG_RETURN_ON_FAIL(readHeader(stream, header));
-        if (!isListType(header.chunk.type))
+        SLANG_RETURN_ON_FAIL(RiffUtil::readHeader(stream, header));
+        if (!RiffUtil::isListType(header.chunk.type))
         {
             return SLANG_FAIL;
         }
 
-        remaining = getPadSize(header.chunk.size) - (sizeof(RiffListHeader) - sizeof(RiffHeader));
+        remaining = RiffUtil::getPadSize(header.chunk.size) -
+                    (sizeof(RiffListHeader) - sizeof(RiffHeader));
         outContainer.startChunk(Chunk::Kind::List, header.subType);
     }
 
@@ -333,7 +341,7 @@ struct DumpVisitor : public RiffContainer::Visitor
         else
         {
             RiffListHeader header;
-            SLANG_RETURN_ON_FAIL(readHeader(stream, header));
+            SLANG_RETURN_ON_FAIL(RiffUtil::readHeader(stream, header));
 
             // The amount of data can't be larger than what remains
             if (header.chunk.size > remaining)
@@ -350,7 +358,7 @@ struct DumpVisitor : public RiffContainer::Visitor
                 }
 
                 // Work out the pad size
-                const size_t padSize = getPadSize(header.chunk.size);
+                const size_t padSize = RiffUtil::getPadSize(header.chunk.size);
 
                 // Subtract the size of this chunk from remaining of the current chunk
                 remaining -= sizeof(RiffHeader) + padSize;
@@ -368,11 +376,29 @@ struct DumpVisitor : public RiffContainer::Visitor
                 ScopeChunk scopeChunk(&outContainer, Chunk::Kind::Data, header.chunk.type);
                 RiffContainer::Data* data = outContainer.addData();
 
-                outContainer.setPayload(data, nullptr, header.chunk.size);
-
                 size_t readSize;
-                SLANG_RETURN_ON_FAIL(
-                    readPayload(stream, header.chunk.size, data->getPayload(), readSize));
+
+                const size_t position = size_t(stream->getPosition());
+                const uint8_t* payload = contents ? contents + position : nullptr;
+                // Payloads are only referenced in place if they have the alignment an arena
+                // allocation would give them, as readers may access the contents directly.
+                if (payload && position + header.chunk.size <= contentsSize &&
+                    (size_t(payload) & (RiffContainer::kPayloadMinAlignment - 1)) == 0)
+                {
+                    outContainer.setUnowned(data, const_cast<uint8_t*>(payload), header.chunk.size);
+
+                    readSize = RiffUtil::getPadSize(header.chunk.size);
+                    SLANG_RETURN_ON_FAIL(stream->seek(SeekOrigin::Current, readSize));
+                }
+                else
+                {
+                    outContainer.setPayload(data, nullptr, header.chunk.size);
+                    SLANG_RETURN_ON_FAIL(RiffUtil::readPayload(
+                        stream,
+                        header.chunk.size,
+                        data->getPayload(),
+                        readSize));
+                }
 
                 // All read sizes must end up aligned
                 SLANG_ASSERT((readSize & kRiffPadMask) == 0);
@@ -386,6 +412,20 @@ struct DumpVisitor : public RiffContainer::Visitor
     return outContainer.isFullyConstructed() ? SLANG_OK : SLANG_FAIL;
 }
 
+/* static */ SlangResult RiffUtil::read(Stream* stream, RiffContainer& outContainer)
+{
+    return _read(stream, nullptr, 0, outContainer);
+}
+
+/* static */ SlangResult RiffUtil::readInPlace(
+    const void* data,
+    size_t size,
+    RiffContainer& outContainer)
+{
+    MemoryStreamBase stream(FileAccess::Read, data, size);
+    return _read(&stream, (const uint8_t*)data, size, outContainer);
+}
+
 // !!!!!!!!!!!!!!!!!!!!!!!!!!!!!! RiffContainer::Chunk !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
 
 SlangResult RiffContainer::Chunk::visit(Visitor* visitor)
@@ -526,6 +526,10 @@ struct RiffUtil
 
     /// Read the stream into the container
     static SlangResult read(Stream* stream, RiffContainer& outContainer);
+    /// Read `size` bytes of `data` into the container. Unlike `read`, data payloads are
+    /// referenced in place where their alignment allows, rather than copied, so `data` must
+    /// outlive the container.
+    static SlangResult readInPlace(const void* data, size_t size, RiffContainer& outContainer);
 };
 
 } // namespace Slang
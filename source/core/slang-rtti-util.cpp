@@ -65,13 +65,18 @@ struct ListFuncs
                 const Index dstCapacity = dstList.getCapacity();
                 void* oldBuffer = dstList.detachBuffer();
 
-                void* newBuffer = ::malloc(count * elementType->m_size);
+                void* newBuffer = ::malloc(srcCount * elementType->m_size);
                 // Initialize it all first
-                typeFuncs.ctorArray(typeMap, elementType, newBuffer, count);
-                typeFuncs.copyArray(typeMap, elementType, newBuffer, oldBuffer, count);
+                typeFuncs.ctorArray(typeMap, elementType, newBuffer, srcCount);
+                typeFuncs.copyArray(
+                    typeMap,
+                    elementType,
+                    newBuffer,
+                    srcList.getBuffer(),
+                    srcCount);
 
                 // Attach the new buffer
-                dstList.attachBuffer((Byte*)newBuffer, count, count);
+                dstList.attachBuffer((Byte*)newBuffer, srcCount, srcCount);
 
                 // Free the old buffer
                 if (oldBuffer)
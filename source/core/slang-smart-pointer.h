@@ -6,13 +6,46 @@
 #include "slang-type-traits.h"
 #include "slang.h"
 
+#include <atomic>
+
 namespace Slang
 {
 // Base class for all reference-counted objects
+//
+// The reference count is only changed with atomic operations for objects that call
+// `enableThreadSafeReferenceCount`, so that objects used by a single thread, like strings, don't
+// pay for them.
 class SLANG_RT_API RefObject
 {
 private:
-    UInt referenceCount;
+    // Set in `referenceCount` for objects whose count is changed with atomic operations.
+    static const UInt kThreadSafeFlag = UInt(1) << (sizeof(UInt) * 8 - 1);
+
+    std::atomic<UInt> referenceCount;
+
+    UInt _changeReferenceCount(bool increment)
+    {
+        UInt count = referenceCount.load(std::memory_order_relaxed);
+        if (count & kThreadSafeFlag)
+        {
+            count = increment ? referenceCount.fetch_add(1, std::memory_order_relaxed) + 1
+                              : referenceCount.fetch_sub(1, std::memory_order_acq_rel) - 1;
+        }
+        else
+        {
+            count = increment ? count + 1 : count - 1;
+            referenceCount.store(count, std::memory_order_relaxed);
+        }
+        return count & ~kThreadSafeFlag;
+    }
+
+protected:
+    // Make the reference count of this object safe to change from several threads at once.
+    // Must be called before the object is shared with other threads.
+    void enableThreadSafeReferenceCount()
+    {
+        referenceCount.fetch_or(kThreadSafeFlag, std::memory_order_relaxed);
+    }
 
 public:
     RefObject()
@@ -29,28 +62,32 @@ public:
 
     virtual ~RefObject() {}
 
-    UInt addReference() { return ++referenceCount; }
+    UInt addReference() { return _changeReferenceCount(true); }
 
-    UInt decreaseReference() { return --referenceCount; }
+    UInt decreaseReference() { return _changeReferenceCount(false); }
 
     UInt releaseReference()
     {
-        SLANG_ASSERT(referenceCount != 0);
-        if (--referenceCount == 0)
+        SLANG_ASSERT(debugGetReferenceCount() != 0);
+        UInt count = _changeReferenceCount(false);
+        if (count == 0)
         {
             delete this;
             return 0;
         }
-        return referenceCount;
+        return count;
     }
 
     bool isUniquelyReferenced()
     {
-        SLANG_ASSERT(referenceCount != 0);
-        return referenceCount == 1;
+        SLANG_ASSERT(debugGetReferenceCount() != 0);
+        return debugGetReferenceCount() == 1;
     }
 
-    UInt debugGetReferenceCount() { return referenceCount; }
+    UInt debugGetReferenceCount()
+    {
+        return referenceCount.load(std::memory_order_relaxed) & ~kThreadSafeFlag;
+    }
 };
 
 SLANG_FORCE_INLINE void addReference(RefObject* obj)
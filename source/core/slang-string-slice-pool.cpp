@@ -147,27 +147,16 @@ void StringSlicePool::swapWith(ThisType& rhs)
 
 StringSlicePool::Handle StringSlicePool::add(const Slice& slice)
 {
-    const Handle* handlePtr = m_map.tryGetValue(slice);
-    if (handlePtr)
-    {
-        return *handlePtr;
-    }
-
-    // Create a scoped copy
-    UnownedStringSlice scopePath(
-        m_arena.allocateString(slice.begin(), slice.getLength()),
-        slice.getLength());
-
-    const auto index = m_slices.getCount();
-
-    m_slices.add(scopePath);
-    m_map.add(scopePath, Handle(index));
-    return Handle(index);
+    Handle handle;
+    findOrAdd(slice, handle);
+    return handle;
 }
 
 bool StringSlicePool::findOrAdd(const Slice& slice, Handle& outHandle)
 {
-    const Handle* handlePtr = m_map.tryGetValue(slice);
+    // Hashed once, for both the lookup and the add
+    const HashedStringSlice key(slice);
+    const Handle* handlePtr = m_map.tryGetValue(key);
     if (handlePtr)
     {
         outHandle = *handlePtr;
@@ -183,7 +172,7 @@ bool StringSlicePool::findOrAdd(const Slice& slice, Handle& outHandle)
 
     // Add using the arenas copy
     Handle newHandle = Handle(m_slices.getCount());
-    m_map.add(scopeSlice, newHandle);
+    m_map.add(HashedStringSlice(scopeSlice, key.hashCode), newHandle);
 
     // Add to slices list
     m_slices.add(scopeSlice);
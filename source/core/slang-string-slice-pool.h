@@ -129,7 +129,7 @@ protected:
 
     Style m_style;
     List<UnownedStringSlice> m_slices;
-    Dictionary<UnownedStringSlice, Handle> m_map;
+    Dictionary<HashedStringSlice, Handle> m_map; ///< Keys are slices of m_arena
     MemoryArena m_arena;
 };
 
@@ -792,20 +792,18 @@ public:
 
 class SLANG_RT_API StringBuilder : public String
 {
-private:
-    enum
-    {
-        InitialSize = 1024
-    };
-
 public:
     typedef String Super;
     using Super::append;
 
-    explicit StringBuilder(UInt bufferSize = InitialSize)
-    {
-        ensureUniqueStorageWithCapacity(bufferSize);
-    }
+    /// Storage is only allocated by the first append, and grows from the size of that append,
+    /// so that the many short temporary builders don't each take a large buffer. As the result
+    /// of `toString` and `produceString` shares the storage, this also means the strings
+    /// produced hold little more than their contents.
+    StringBuilder() {}
+    /// Allocate storage for at least `bufferSize` chars up front, for when the size of the
+    /// result is known or expected to be large.
+    explicit StringBuilder(UInt bufferSize) { ensureUniqueStorageWithCapacity(bufferSize); }
 
     void ensureCapacity(UInt size) { ensureUniqueStorageWithCapacity(size); }
     StringBuilder& operator<<(char ch)
@@ -892,6 +890,70 @@ int stringToInt(const String& str, int radix = 10);
 unsigned int stringToUInt(const String& str, int radix = 10);
 double stringToDouble(const String& str);
 float stringToFloat(const String& str);
+
+/// A string slice held with its hash code.
+///
+/// Used as the key of maps whose strings are long, such as mangled names, or are looked up in
+/// several maps, so that each string is only hashed once rather than on every lookup, insertion
+/// and rehash. The slice is not owned.
+struct HashedStringSlice
+{
+    static constexpr bool kHasUniformHash = true;
+
+    HashCode64 getHashCode() const { return hashCode; }
+
+    bool operator==(const HashedStringSlice& rhs) const
+    {
+        return hashCode == rhs.hashCode && slice == rhs.slice;
+    }
+    bool operator!=(const HashedStringSlice& rhs) const { return !(*this == rhs); }
+
+    HashedStringSlice() = default;
+    HashedStringSlice(const UnownedStringSlice& inSlice)
+        : slice(inSlice)
+        , hashCode(inSlice.getHashCode())
+    {
+    }
+    /// Use when the hash code of the slice is already known
+    HashedStringSlice(const UnownedStringSlice& inSlice, HashCode64 inHashCode)
+        : slice(inSlice)
+        , hashCode(inHashCode)
+    {
+    }
+
+    UnownedStringSlice slice;
+    HashCode64 hashCode = 0;
+};
+
+/// As HashedStringSlice, but owns the string.
+struct HashedString
+{
+    static constexpr bool kHasUniformHash = true;
+
+    HashCode64 getHashCode() const { return hashCode; }
+
+    bool operator==(const HashedString& rhs) const
+    {
+        return hashCode == rhs.hashCode && string == rhs.string;
+    }
+    bool operator!=(const HashedString& rhs) const { return !(*this == rhs); }
+
+    HashedString() = default;
+    HashedString(const String& inString)
+        : string(inString)
+        , hashCode(inString.getHashCode())
+    {
+    }
+    HashedString(const UnownedStringSlice& slice)
+        : string(slice)
+        , hashCode(slice.getHashCode())
+    {
+    }
+
+    String string;
+    HashCode64 hashCode = 0;
+};
+
 } // namespace Slang
 
 std::ostream& operator<<(std::ostream& stream, const Slang::String& s);
@@ -176,6 +176,36 @@ static const NamesDescriptionValue s_optimizationLevels[] = {
      "involve unwanted tradeoffs in terms of code size."},
 };
 
+static const NamesDescriptionValue s_spirvOptimizationPresets[] = {
+    {SLANG_SPIRV_OPTIMIZATION_PRESET_DEFAULT,
+     "default",
+     "Pick the spirv-opt passes from the optimization level."},
+    {SLANG_SPIRV_OPTIMIZATION_PRESET_FAST_COMPILE,
+     "fast-compile",
+     "Only run a few cheap passes that remove dead code."},
+    {SLANG_SPIRV_OPTIMIZATION_PRESET_PERFORMANCE,
+     "performance",
+     "Run the passes spirv-opt runs for -O, to make the code fast."},
+    {SLANG_SPIRV_OPTIMIZATION_PRESET_SIZE,
+     "size",
+     "Run the passes spirv-opt runs for -Os, to make the code small."},
+};
+
+static const NamesDescriptionValue s_autodiffCheckpointPolicies[] = {
+    {SLANG_AUTODIFF_CHECKPOINT_POLICY_DEFAULT,
+     "default",
+     "Store the results of calls that may have side effects, and recompute the rest."},
+    {SLANG_AUTODIFF_CHECKPOINT_POLICY_STORE_ALL,
+     "store-all",
+     "Store every value computed in the primal pass that can be stored."},
+    {SLANG_AUTODIFF_CHECKPOINT_POLICY_RECOMPUTE_ALL,
+     "recompute-all",
+     "Recompute every value that has no side effects and can be recomputed."},
+    {SLANG_AUTODIFF_CHECKPOINT_POLICY_BUDGET,
+     "budget",
+     "Recompute the values that cost no more than the recompute budget, and store the rest."},
+};
+
 static const NamesDescriptionValue s_debugLevels[] = {
     {SLANG_DEBUG_INFO_LEVEL_NONE, "0,none", "Don't emit debug information at all."},
     {SLANG_DEBUG_INFO_LEVEL_MINIMAL,
@@ -246,6 +276,16 @@ static const NamesDescriptionValue s_fileSystemTypes[] = {
     return makeConstArrayView(s_optimizationLevels);
 }
 
+/* static */ ConstArrayView<NamesDescriptionValue> TypeTextUtil::getSpirvOptimizationPresetInfos()
+{
+    return makeConstArrayView(s_spirvOptimizationPresets);
+}
+
+/* static */ ConstArrayView<NamesDescriptionValue> TypeTextUtil::getAutodiffCheckpointPolicyInfos()
+{
+    return makeConstArrayView(s_autodiffCheckpointPolicies);
+}
+
 /* static */ ConstArrayView<NamesDescriptionValue> TypeTextUtil::getDebugLevelInfos()
 {
     return makeConstArrayView(s_debugLevels);
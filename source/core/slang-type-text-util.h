@@ -47,6 +47,10 @@ struct TypeTextUtil
     static ConstArrayView<NamesDescriptionValue> getLineDirectiveInfos();
     /// Get the optimization level info
     static ConstArrayView<NamesDescriptionValue> getOptimizationLevelInfos();
+    /// Get the SPIR-V optimization preset infos
+    static ConstArrayView<NamesDescriptionValue> getSpirvOptimizationPresetInfos();
+    /// Get the autodiff checkpoint policy infos
+    static ConstArrayView<NamesDescriptionValue> getAutodiffCheckpointPolicyInfos();
     /// Get the file system type infos
     static ConstArrayView<NamesDescriptionValue> getFileSystemTypeInfos();
 
@@ -176,21 +176,9 @@ void UIntSet::subtractWith(const UIntSet& set)
 
 Index UIntSet::countElements() const
 {
-    // TODO: This can be made faster using SIMD intrinsics to count set bits.
-    uint64_t tmp;
-    constexpr Index loopSize =
-        ((sizeof(Element) / sizeof(tmp)) != 0) ? sizeof(Element) / sizeof(tmp) : 1;
     Index count = 0;
-    for (auto index = 0; index < this->m_buffer.getCount(); index++)
-    {
-        for (auto i = 0; i < loopSize; i++)
-        {
-            tmp = m_buffer[index] >> (sizeof(tmp) * i);
-            tmp = tmp - ((tmp >> 1) & 0x5555555555555555);
-            tmp = (tmp & 0x3333333333333333) + ((tmp >> 2) & 0x3333333333333333);
-            count += ((tmp + (tmp >> 4) & 0xF0F0F0F0F0F0F0F) * 0x101010101010101) >> 56;
-        }
-    }
+    for (auto element : m_buffer)
+        count += bitCount(element);
     return count;
 }
 
@@ -43,6 +43,17 @@ static inline Index bitscanForward(uint64_t in)
 #endif // #if defined(_MSC_VER)
 }
 
+static inline Index bitCount(uint64_t in)
+{
+#if defined(_MSC_VER) && defined(_WIN64)
+    return Index(__popcnt64(in));
+#elif defined(_MSC_VER)
+    return Index(__popcnt(uint32_t(in)) + __popcnt(uint32_t(in >> 32)));
+#else
+    return Index(__builtin_popcountll(in));
+#endif
+}
+
 /* Hold a set of UInt values. Implementation works by storing as a bit per value */
 /// UIntSet is essentially a Element[], where each Element is `b` bits big.
 /// Each index has `b` number of integers. If the bit is 1, we have an element there.
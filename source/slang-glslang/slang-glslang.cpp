@@ -7,6 +7,7 @@
 #include "glslang/Public/ShaderLang.h"
 #include "slang.h"
 #include "spirv-tools/libspirv.h"
+#include "spirv-tools/linker.hpp"
 #include "spirv-tools/optimizer.hpp"
 
 #ifdef _WIN32
@@ -16,6 +17,7 @@
 #include <memory>
 #include <mutex>
 #include <sstream>
+#include <vector>
 
 // This is a wrapper to allow us to run the `glslang` compiler
 // in a controlled fashion.
@@ -170,79 +172,101 @@ extern "C"
 #endif
         bool glslang_validateSPIRV(const uint32_t* contents, int contentsSize)
 {
-    spv_target_env target_env = SPV_ENV_VULKAN_1_3;
+    // Creating a validator context sets up the grammar tables of the target environment, which
+    // costs about as much as validating a small module. The contexts are therefore kept for
+    // the next module to be validated, rather than created for each one. A context is only
+    // used by one thread at a time, so modules can still be validated concurrently.
+    static std::mutex freeToolsMutex;
+    static std::vector<std::unique_ptr<spvtools::SpirvTools>> freeTools;
+
+    std::unique_ptr<spvtools::SpirvTools> tools;
+    {
+        std::lock_guard<std::mutex> lock(freeToolsMutex);
+        if (!freeTools.empty())
+        {
+            tools = std::move(freeTools.back());
+            freeTools.pop_back();
+        }
+    }
+    if (!tools)
+    {
+        tools.reset(new spvtools::SpirvTools(SPV_ENV_VULKAN_1_3));
+        tools->SetMessageConsumer(validationMessageConsumer);
+    }
 
     spvtools::ValidatorOptions options;
     options.SetScalarBlockLayout(true);
 
-    spvtools::SpirvTools tools(target_env);
-    tools.SetMessageConsumer(validationMessageConsumer);
+    const bool isValid = tools->Validate(contents, contentsSize, options);
 
-    return tools.Validate(contents, contentsSize, options);
+    {
+        std::lock_guard<std::mutex> lock(freeToolsMutex);
+        freeTools.push_back(std::move(tools));
+    }
+    return isValid;
 }
 
-// Apply the SPIRV-Tools optimizer to generated SPIR-V based on the desired optimization level
-// TODO: add flag for optimizing SPIR-V size as well
-static void glslang_optimizeSPIRV(
-    spv_target_env targetEnv,
-    const glslang_CompileRequest_1_2& request,
-    std::vector<SPIRVOptimizationDiagnostic>& outDiags,
-    std::vector<unsigned int>& ioSpirv)
+// Link the given SPIR-V modules, as produced by precompiling slang modules, into one module.
+extern "C"
+#ifdef _MSC_VER
+    _declspec(dllexport)
+#else
+    __attribute__((__visibility__("default")))
+#endif
+        int glslang_linkSPIRV(glslang_LinkSPIRVRequest* request)
 {
-    const auto optimizationLevel = request.optimizationLevel;
-
-    // If there is no optimization then we are done
-    if (optimizationLevel == SLANG_OPTIMIZATION_LEVEL_NONE)
+    if (request->sizeInBytes < sizeof(glslang_LinkSPIRVRequest))
     {
-        return;
+        return 1;
     }
 
-    const auto debugInfoType = request.debugInfoType;
-
-    spvtools::Optimizer optimizer(targetEnv);
-
-    optimizer.SetMessageConsumer(
+    spvtools::Context context(SPV_ENV_UNIVERSAL_1_6);
+    context.SetMessageConsumer(
         [&](spv_message_level_t level,
             const char* source,
             const spv_position_t& position,
             const char* message)
         {
-            SPIRVOptimizationDiagnostic diag;
-            diag.level = level;
-            if (source)
+            if (!request->diagnosticFunc)
             {
-                diag.source = source;
+                return;
             }
+            SPIRVOptimizationDiagnostic diag;
+            diag.level = level;
+            diag.source = source ? source : "";
             diag.position = position;
-            if (message)
-            {
-                diag.message = message;
-            }
-            outDiags.push_back(diag);
+            diag.message = message ? message : "";
+            std::string text = diag.toString() + "\n";
+            request->diagnosticFunc(text.data(), text.size(), request->diagnosticUserData);
         });
 
-    // If debug info is being generated, propagate
-    // line information into all SPIR-V instructions. This avoids loss of
-    // information when instructions are deleted or moved. Later, remove
-    // redundant information to minimize final SPRIR-V size.
-    if (debugInfoType != SLANG_DEBUG_INFO_LEVEL_NONE)
+    std::vector<uint32_t> linked;
+    const spv_result_t result = spvtools::Link(
+        context,
+        request->modules,
+        request->moduleWordCounts,
+        request->moduleCount,
+        &linked);
+    if (result != SPV_SUCCESS)
     {
-        optimizer.RegisterPass(spvtools::CreatePropagateLineInfoPass());
+        return 1;
     }
 
-    spvtools::OptimizerOptions spvOptOptions;
-
-    // To compile some large shaders the default is not enough.
-    // That although this limit is exceeded, the final optimized output is typically well
-    // within the range.
-    //
-    // See kDefaultMaxIdBound for description of this limit.
-    //
-    // If a compilation produces a warning like
-    // `0:0: ID overflow. Try running compact-ids.`
-    // it might be fixable by raising the multiplier to a larger value.
-    spvOptOptions.set_max_id_bound(kDefaultMaxIdBound * 4);
+    if (request->outputFunc)
+    {
+        request->outputFunc(
+            linked.data(),
+            linked.size() * sizeof(uint32_t),
+            request->outputUserData);
+    }
+    return 0;
+}
 
+// Register the passes to run for `optimizationLevel`, when no SPIR-V optimization preset is set.
+static void _registerOptimizationLevelPasses(
+    spvtools::Optimizer& optimizer,
+    unsigned optimizationLevel)
+{
     // TODO confirm which passes we want to invoke for each level
     switch (optimizationLevel)
     {
@@ -439,6 +463,90 @@ static void glslang_optimizeSPIRV(
             break;
         }
     }
+}
+
+// Apply the SPIRV-Tools optimizer to generated SPIR-V based on the desired optimization level,
+// or the SPIR-V optimization preset if one is set.
+static void glslang_optimizeSPIRV(
+    spv_target_env targetEnv,
+    const glslang_CompileRequest_1_2& request,
+    std::vector<SPIRVOptimizationDiagnostic>& outDiags,
+    std::vector<unsigned int>& ioSpirv)
+{
+    const auto optimizationLevel = request.optimizationLevel;
+
+    // If there is no optimization then we are done
+    if (optimizationLevel == SLANG_OPTIMIZATION_LEVEL_NONE &&
+        request.spirvOptimizationPreset == SLANG_SPIRV_OPTIMIZATION_PRESET_DEFAULT)
+    {
+        return;
+    }
+
+    const auto debugInfoType = request.debugInfoType;
+
+    spvtools::Optimizer optimizer(targetEnv);
+
+    optimizer.SetMessageConsumer(
+        [&](spv_message_level_t level,
+            const char* source,
+            const spv_position_t& position,
+            const char* message)
+        {
+            SPIRVOptimizationDiagnostic diag;
+            diag.level = level;
+            if (source)
+            {
+                diag.source = source;
+            }
+            diag.position = position;
+            if (message)
+            {
+                diag.message = message;
+            }
+            outDiags.push_back(diag);
+        });
+
+    // If debug info is being generated, propagate
+    // line information into all SPIR-V instructions. This avoids loss of
+    // information when instructions are deleted or moved. Later, remove
+    // redundant information to minimize final SPRIR-V size.
+    if (debugInfoType != SLANG_DEBUG_INFO_LEVEL_NONE)
+    {
+        optimizer.RegisterPass(spvtools::CreatePropagateLineInfoPass());
+    }
+
+    spvtools::OptimizerOptions spvOptOptions;
+
+    // To compile some large shaders the default is not enough.
+    // That although this limit is exceeded, the final optimized output is typically well
+    // within the range.
+    //
+    // See kDefaultMaxIdBound for description of this limit.
+    //
+    // If a compilation produces a warning like
+    // `0:0: ID overflow. Try running compact-ids.`
+    // it might be fixable by raising the multiplier to a larger value.
+    spvOptOptions.set_max_id_bound(kDefaultMaxIdBound * 4);
+
+    switch (request.spirvOptimizationPreset)
+    {
+    case SLANG_SPIRV_OPTIMIZATION_PRESET_FAST_COMPILE:
+        // Only remove code that is dead, which stays cheap on large modules.
+        optimizer.RegisterPass(spvtools::CreateDeadBranchElimPass());
+        optimizer.RegisterPass(spvtools::CreateEliminateDeadFunctionsPass());
+        optimizer.RegisterPass(spvtools::CreateAggressiveDCEPass());
+        optimizer.RegisterPass(spvtools::CreateCFGCleanupPass());
+        break;
+    case SLANG_SPIRV_OPTIMIZATION_PRESET_PERFORMANCE:
+        optimizer.RegisterPerformancePasses();
+        break;
+    case SLANG_SPIRV_OPTIMIZATION_PRESET_SIZE:
+        optimizer.RegisterSizePasses();
+        break;
+    default:
+        _registerOptimizationLevelPasses(optimizer, optimizationLevel);
+        break;
+    }
 
     if (debugInfoType != SLANG_DEBUG_INFO_LEVEL_NONE)
     {
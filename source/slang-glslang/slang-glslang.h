@@ -135,6 +135,10 @@ struct glslang_CompileRequest_1_2
 
     // glslang_CompileRequest_1_2 fields
     const char* entryPointName; // The name of the entrypoint that will appear in output spirv.
+
+    /// A SlangSpirvOptimizationPreset. Requests from before this field existed are zero
+    /// filled, which picks the passes from `optimizationLevel`.
+    unsigned spirvOptimizationPreset;
 };
 
 inline void glslang_CompileRequest_1_0::set(const glslang_CompileRequest_1_1& in)
@@ -157,4 +161,23 @@ typedef int (*glslang_CompileFunc_1_1)(glslang_CompileRequest_1_1* request);
 typedef int (*glslang_CompileFunc_1_2)(glslang_CompileRequest_1_2* request);
 typedef bool (*glslang_ValidateSPIRVFunc)(const uint32_t* contents, int contentsSize);
 
+// Links SPIR-V modules into a single module, resolving functions one module imports by name
+// against those another exports.
+struct glslang_LinkSPIRVRequest
+{
+    size_t sizeInBytes; ///< Size in bytes of this structure
+
+    const uint32_t* const* modules; ///< The words of each module
+    const size_t* moduleWordCounts; ///< The number of words in each module
+    size_t moduleCount;
+
+    glslang_OutputFunc diagnosticFunc;
+    void* diagnosticUserData;
+
+    glslang_OutputFunc outputFunc; ///< Receives the linked module
+    void* outputUserData;
+};
+
+typedef int (*glslang_LinkSPIRVFunc)(glslang_LinkSPIRVRequest* request);
+
 #endif
@@ -11,6 +11,7 @@
 #include "clang/Frontend/CompilerInvocation.h"
 #include "clang/Frontend/FrontendAction.h"
 #include "clang/Frontend/FrontendDiagnostic.h"
+#include "clang/Frontend/PrecompiledPreamble.h"
 #include "clang/Frontend/TextDiagnosticBuffer.h"
 #include "clang/Frontend/TextDiagnosticPrinter.h"
 #include "clang/Frontend/Utils.h"
@@ -33,6 +34,7 @@
 #include "llvm/Support/TargetSelect.h"
 #include "llvm/Support/TimeProfiler.h"
 #include "llvm/Support/Timer.h"
+#include "llvm/Support/VirtualFileSystem.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Target/TargetMachine.h"
 
@@ -54,6 +56,7 @@
 
 #include <compiler-core/slang-artifact-associated-impl.h>
 #include <compiler-core/slang-artifact-desc-util.h>
+#include <compiler-core/slang-downstream-compiler-util.h>
 #include <compiler-core/slang-downstream-compiler.h>
 #include <compiler-core/slang-slice-allocator.h>
 #include <core/slang-com-object.h>
@@ -62,6 +65,7 @@
 #include <core/slang-shared-library.h>
 #include <core/slang-string-util.h>
 #include <core/slang-string.h>
+#include <mutex>
 #include <stdio.h>
 
 // We want to make math functions available to the JIT
@@ -151,7 +155,20 @@ public:
     void* getInterface(const Guid& guid);
     void* getObject(const Guid& guid);
 
+    /// Get a precompiled preamble of the part of `source` in `bounds`, reusing the one built by
+    /// an earlier compile if it matches. Returns nullptr if the preamble couldn't be built.
+    std::shared_ptr<PrecompiledPreamble> _getPreamble(
+        const CompilerInvocation& invocation,
+        const llvm::MemoryBuffer* source,
+        PreambleBounds bounds,
+        IntrusiveRefCntPtr<llvm::vfs::FileSystem> fileSystem,
+        std::shared_ptr<PCHContainerOperations> pchOps);
+
     Desc m_desc;
+
+    // Guards m_preamble, as compiles may run on multiple threads at once.
+    std::mutex m_preambleMutex;
+    std::shared_ptr<PrecompiledPreamble> m_preamble;
 };
 
 
@@ -223,6 +240,24 @@ void* LLVMJITSharedLibrary::findSymbolAddressByName(char const* name)
 
 static void _ensureSufficientStack() {}
 
+// The name that generated source with a preamble is compiled as. Precompiled preambles only
+// work for sources with a file name, so the source is remapped to this name.
+static const char kGeneratedSourcePath[] = "slang-generated-source";
+
+// The C++ emitter puts the prelude, wrapped in the include guard of slang-cpp-prelude.h, at the
+// start of the generated source. Returns the size of the source up to and including the end of
+// that block, or 0 if the source doesn't contain it.
+static Index _findPreludeSize(const UnownedStringSlice& source)
+{
+    Index start = 0;
+    Index end = 0;
+    if (!DownstreamCompilerUtil::findPrelude(source, toSlice("SLANG_CPP_PRELUDE_H"), start, end))
+    {
+        return 0;
+    }
+    return end;
+}
+
 static void _llvmErrorHandler(void* userData, const std::string& message, bool genCrashDiag)
 {
     // DiagnosticsEngine& diags = *static_cast<DiagnosticsEngine*>(userData);
@@ -606,6 +641,46 @@ void* LLVMDownstreamCompiler::getObject(const Guid& guid)
     return nullptr;
 }
 
+std::shared_ptr<PrecompiledPreamble> LLVMDownstreamCompiler::_getPreamble(
+    const CompilerInvocation& invocation,
+    const llvm::MemoryBuffer* source,
+    PreambleBounds bounds,
+    IntrusiveRefCntPtr<llvm::vfs::FileSystem> fileSystem,
+    std::shared_ptr<PCHContainerOperations> pchOps)
+{
+    std::lock_guard<std::mutex> lock(m_preambleMutex);
+
+    // CanReuse checks the contents of the preamble, and the options it was compiled with.
+    if (m_preamble &&
+        m_preamble->CanReuse(invocation, source->getMemBufferRef(), bounds, *fileSystem))
+    {
+        return m_preamble;
+    }
+    m_preamble.reset();
+
+    // Any problem in the preamble is reported by compiling the source without it.
+    IntrusiveRefCntPtr<DiagnosticsEngine> diags =
+        CompilerInstance::createDiagnostics(new DiagnosticOptions(), new IgnoringDiagConsumer());
+
+    PreambleCallbacks callbacks;
+    auto preamble = PrecompiledPreamble::Build(
+        invocation,
+        source,
+        bounds,
+        *diags,
+        fileSystem,
+        pchOps,
+        true,
+        callbacks);
+    if (!preamble)
+    {
+        return nullptr;
+    }
+
+    m_preamble = std::make_shared<PrecompiledPreamble>(std::move(*preamble));
+    return m_preamble;
+}
+
 SlangResult LLVMDownstreamCompiler::compile(
     const CompileOptions& inOptions,
     IArtifact** outArtifact)
@@ -657,6 +732,7 @@ SlangResult LLVMDownstreamCompiler::compile(
     StringRef sourceStringRef(sourceSlice.begin(), sourceSlice.getLength());
 
     auto sourceBuffer = llvm::MemoryBuffer::getMemBuffer(sourceStringRef);
+    const Index preludeSize = _findPreludeSize(sourceSlice);
 
     auto& invocation = clang->getInvocation();
 
@@ -716,8 +792,13 @@ SlangResult LLVMDownstreamCompiler::compile(
         // not super surprising as one isn't set, but it's not clear how one would be set when the
         // input is a memory buffer. For Slang usage, this probably isn't an issue, because it's
         // *output* typically holds #line directives.
+        if (preludeSize > 0)
+        {
+            FrontendInputFile inputFile(kGeneratedSourcePath, inputKind);
+            opts.Inputs.push_back(inputFile);
+        }
+        else
         {
-
             FrontendInputFile inputFile(*sourceBuffer, inputKind);
             opts.Inputs.push_back(inputFile);
         }
@@ -806,6 +887,28 @@ SlangResult LLVMDownstreamCompiler::compile(
         opts.CodeModel = invocation.getTargetOpts().CodeModel;
     }
 
+    // Parsing the prelude is most of the work of compiling a small kernel, and it is the same
+    // for every compile with the same options, so it is precompiled once and reused.
+    IntrusiveRefCntPtr<llvm::vfs::FileSystem> fileSystem = llvm::vfs::getRealFileSystem();
+    std::shared_ptr<PrecompiledPreamble> preamble;
+    if (preludeSize > 0)
+    {
+        preamble = _getPreamble(
+            invocation,
+            sourceBuffer.get(),
+            PreambleBounds(unsigned(preludeSize), true),
+            fileSystem,
+            pchOps);
+        if (preamble)
+        {
+            preamble->AddImplicitPreamble(invocation, fileSystem, sourceBuffer.get());
+        }
+
+        auto& opts = invocation.getPreprocessorOpts();
+        opts.RetainRemappedFileBuffers = true;
+        opts.addRemappedFile(kGeneratedSourcePath, sourceBuffer.get());
+    }
+
     // const llvm::opt::OptTable& opts = clang::driver::getDriverOptTable();
 
     // TODO(JS): Need a way to find in system search paths, for now we just don't bother
@@ -845,7 +948,7 @@ SlangResult LLVMDownstreamCompiler::compile(
         return SLANG_FAIL;
 
     //
-    clang->createFileManager();
+    clang->createFileManager(fileSystem);
     clang->createSourceManager(clang->getFileManager());
 
 
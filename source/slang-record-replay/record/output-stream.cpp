@@ -32,6 +32,79 @@ void FileOutputStream::write(const void* data, size_t len)
     SLANG_RECORD_CHECK(m_fileStream.write(data, len));
 }
 
+AsyncFileOutputStream::AsyncFileOutputStream(const Slang::String& fileName, bool append)
+    : m_fileStream(fileName, append)
+{
+    m_writerThread = std::thread([this]() { writerThreadMain(); });
+}
+
+AsyncFileOutputStream::~AsyncFileOutputStream()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isClosing = true;
+    }
+    m_dataAvailable.notify_one();
+    m_writerThread.join();
+}
+
+void AsyncFileOutputStream::write(const void* data, size_t len)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    // Don't let the buffer grow without bound if the file can't keep up with the recording.
+    m_spaceAvailable.wait(
+        lock,
+        [&]()
+        {
+            return m_pendingData.getCount() == 0 ||
+                   size_t(m_pendingData.getCount()) + len <= kMaxPendingSizeInBytes;
+        });
+
+    m_pendingData.addRange((const uint8_t*)data, (Slang::Index)len);
+}
+
+void AsyncFileOutputStream::flush()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isFlushRequested = true;
+    }
+    m_dataAvailable.notify_one();
+}
+
+void AsyncFileOutputStream::writerThreadMain()
+{
+    Slang::List<uint8_t> writingData;
+    for (;;)
+    {
+        bool isClosing = false;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_dataAvailable.wait_for(
+                lock,
+                std::chrono::milliseconds(kWriteIntervalMs),
+                [&]() { return m_isFlushRequested || m_isClosing; });
+
+            // Swap the buffers so that the recording thread can keep appending while the
+            // data is written.
+            writingData.swapWith(m_pendingData);
+            m_isFlushRequested = false;
+            isClosing = m_isClosing;
+        }
+        m_spaceAvailable.notify_all();
+
+        if (writingData.getCount())
+        {
+            m_fileStream.write(writingData.getBuffer(), writingData.getCount());
+            m_fileStream.flush();
+            writingData.clear();
+        }
+        if (isClosing)
+            break;
+    }
+}
+
 MemoryStream::MemoryStream()
     : m_memoryStream(Slang::FileAccess::Write)
 {
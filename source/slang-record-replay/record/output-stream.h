@@ -2,8 +2,13 @@
 #define OUTPUT_STREAM_H
 
 #include "../../core/slang-stream.h"
+#include "../../core/slang-list.h"
 #include "../../core/slang-string.h"
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 namespace SlangRecord
 {
 class OutputStream : public Slang::RefObject
@@ -26,6 +31,40 @@ private:
     Slang::FileStream m_fileStream;
 };
 
+// A file output stream that doesn't write to the file on the calling thread. Writes are
+// appended to a buffer that a background thread swaps out and writes to the file, either when
+// `flush` is called or at least every `kWriteIntervalMs` milliseconds. Everything written is in
+// the file once the stream is destroyed, but the data of the last few calls can be lost if the
+// process crashes.
+class AsyncFileOutputStream : public OutputStream
+{
+public:
+    AsyncFileOutputStream(const Slang::String& fileName, bool append = false);
+    virtual ~AsyncFileOutputStream() override;
+    virtual void write(const void* data, size_t len) override;
+    // Wakes up the writer thread, without waiting for the data to be written.
+    virtual void flush() override;
+
+private:
+    static const size_t kMaxPendingSizeInBytes = 64 * 1024 * 1024;
+    static const int kWriteIntervalMs = 100;
+
+    void writerThreadMain();
+
+    FileOutputStream m_fileStream;
+
+    std::mutex m_mutex;
+    // Signaled when there is data to write, or the stream is being destroyed.
+    std::condition_variable m_dataAvailable;
+    // Signaled when the writer thread has taken the pending data.
+    std::condition_variable m_spaceAvailable;
+    Slang::List<uint8_t> m_pendingData;
+    bool m_isFlushRequested = false;
+    bool m_isClosing = false;
+
+    std::thread m_writerThread;
+};
+
 // The reason we inherit from OwnedMemoryStream instead of declaring it
 // as a member is because OwnedMemoryStream lacks some of the functionality
 // of operating on the underlying buffer directly.
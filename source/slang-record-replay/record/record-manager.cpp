@@ -28,7 +28,10 @@ RecordManager::RecordManager(uint64_t globalSessionHandle)
 
     Slang::String recordFilePath =
         Slang::Path::combine(m_recordFileDirectory, Slang::String(ss.str().c_str()));
-    m_fileStream = new FileOutputStream(recordFilePath);
+    if (isRecordAsyncWriteEnabled())
+        m_fileStream = new AsyncFileOutputStream(recordFilePath);
+    else
+        m_fileStream = new FileOutputStream(recordFilePath);
 }
 
 void RecordManager::clearWithHeader(const ApiCallId& callId, uint64_t handleId)
@@ -157,6 +157,33 @@ SLANG_NO_THROW SlangResult SLANG_MCALL IComponentTypeRecorder::getTargetMetadata
     return m_actualComponentType->getTargetMetadata(targetIndex, outMetadata, outDiagnostics);
 }
 
+SLANG_NO_THROW SlangResult SLANG_MCALL IComponentTypeRecorder::getEntryPointCodes(
+    SlangInt entryPointCount,
+    SlangInt const* entryPointIndices,
+    SlangInt targetIndex,
+    slang::IBlob** outCodes,
+    slang::IBlob** outDiagnostics)
+{
+    // This call is recorded as the getEntryPointCode calls it is made of, so that it can be
+    // replayed without a method of its own.
+    for (SlangInt i = 0; i < entryPointCount; ++i)
+    {
+        outCodes[i] = nullptr;
+        SlangResult res =
+            getEntryPointCode(entryPointIndices[i], targetIndex, &outCodes[i], outDiagnostics);
+        if (SLANG_FAILED(res))
+        {
+            for (SlangInt j = 0; j < i; ++j)
+            {
+                outCodes[j]->release();
+                outCodes[j] = nullptr;
+            }
+            return res;
+        }
+    }
+    return SLANG_OK;
+}
+
 SLANG_NO_THROW SlangResult IComponentTypeRecorder::getResultAsFileSystem(
     SlangInt entryPointIndex,
     SlangInt targetIndex,
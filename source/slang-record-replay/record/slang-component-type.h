@@ -71,6 +71,12 @@ public:
         SlangInt targetIndex,
         slang::IMetadata** outMetadata,
         slang::IBlob** outDiagnostics = nullptr) override;
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL getEntryPointCodes(
+        SlangInt entryPointCount,
+        SlangInt const* entryPointIndices,
+        SlangInt targetIndex,
+        slang::IBlob** outCodes,
+        slang::IBlob** outDiagnostics = nullptr) override;
 
 protected:
     virtual ApiClassId getClassId() = 0;
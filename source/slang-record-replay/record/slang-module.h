@@ -112,6 +112,21 @@ public:
         return Super::getTargetMetadata(targetIndex, outMetadata, outDiagnostics);
     }
 
+    SLANG_NO_THROW SlangResult SLANG_MCALL getEntryPointCodes(
+        SlangInt entryPointCount,
+        SlangInt const* entryPointIndices,
+        SlangInt targetIndex,
+        slang::IBlob** outCodes,
+        slang::IBlob** outDiagnostics) SLANG_OVERRIDE
+    {
+        return Super::getEntryPointCodes(
+            entryPointCount,
+            entryPointIndices,
+            targetIndex,
+            outCodes,
+            outDiagnostics);
+    }
+
     virtual SLANG_NO_THROW SlangResult SLANG_MCALL getResultAsFileSystem(
         SlangInt entryPointIndex,
         SlangInt targetIndex,
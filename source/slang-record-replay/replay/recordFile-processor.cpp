@@ -3,6 +3,8 @@
 #include "../util/record-format.h"
 #include "parameter-decoder.h"
 
+#include <chrono>
+
 namespace SlangRecord
 {
 RecordFileProcessor::RecordFileProcessor(const Slang::String& filePath)
@@ -77,6 +79,7 @@ bool RecordFileProcessor::processNextBlock()
     paramBlock.outputBuffer = m_outputBuffer.getBuffer();
     paramBlock.outputBufferSize = tailer.dataSizeInBytes;
 
+    auto startTime = std::chrono::steady_clock::now();
     if (classId == ApiClassId::GlobalFunction)
     {
         ret = m_decoder->processFunctionCall(header, paramBlock);
@@ -85,6 +88,12 @@ bool RecordFileProcessor::processNextBlock()
     {
         ret = m_decoder->processMethodCall(header, paramBlock);
     }
+    if (m_timings)
+    {
+        std::chrono::duration<double, std::micro> elapsed =
+            std::chrono::steady_clock::now() - startTime;
+        m_timings->addCallTime(header.callId, elapsed.count());
+    }
 
     m_parameterBuffer.clear();
     m_outputBuffer.clear();
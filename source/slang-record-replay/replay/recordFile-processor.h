@@ -3,6 +3,7 @@
 
 #include "../../core/slang-stream.h"
 #include "../util/record-utility.h"
+#include "replay-timings.h"
 #include "slang-decoder.h"
 
 #include <cstdlib>
@@ -33,6 +34,9 @@ public:
         return true;
     }
 
+    // Record how long each call takes to decode and replay in `timings`.
+    void setTimings(ReplayTimings* timings) { m_timings = timings; }
+
     bool processNextBlock();
     bool processHeader(FunctionHeader& header);
     RecordFileResultCode processTailer(FunctionTailer& tailer);
@@ -45,6 +49,7 @@ private:
     Slang::List<uint8_t> m_outputBuffer;
 
     SlangDecoder* m_decoder = nullptr;
+    ReplayTimings* m_timings = nullptr;
 };
 
 } // namespace SlangRecord
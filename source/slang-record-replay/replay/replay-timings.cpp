@@ -0,0 +1,209 @@
+#include "replay-timings.h"
+
+#include "../../core/slang-io.h"
+#include "../../core/slang-math.h"
+#include "../../core/slang-string-util.h"
+
+namespace SlangRecord
+{
+static const char kTimingsFileHeader[] = "slang-replay-timings 1";
+
+const char* getApiCallIdName(ApiCallId callId)
+{
+#define CASE(x) \
+    case x:     \
+        return #x
+
+    switch (callId)
+    {
+        CASE(CreateGlobalSession);
+        CASE(IGlobalSession_createSession);
+        CASE(IGlobalSession_findProfile);
+        CASE(IGlobalSession_setDownstreamCompilerPath);
+        CASE(IGlobalSession_setDownstreamCompilerPrelude);
+        CASE(IGlobalSession_getDownstreamCompilerPrelude);
+        CASE(IGlobalSession_getBuildTagString);
+        CASE(IGlobalSession_setDefaultDownstreamCompiler);
+        CASE(IGlobalSession_getDefaultDownstreamCompiler);
+        CASE(IGlobalSession_setLanguagePrelude);
+        CASE(IGlobalSession_getLanguagePrelude);
+        CASE(IGlobalSession_createCompileRequest);
+        CASE(IGlobalSession_addBuiltins);
+        CASE(IGlobalSession_setSharedLibraryLoader);
+        CASE(IGlobalSession_getSharedLibraryLoader);
+        CASE(IGlobalSession_checkCompileTargetSupport);
+        CASE(IGlobalSession_checkPassThroughSupport);
+        CASE(IGlobalSession_compileCoreModule);
+        CASE(IGlobalSession_loadCoreModule);
+        CASE(IGlobalSession_saveCoreModule);
+        CASE(IGlobalSession_findCapability);
+        CASE(IGlobalSession_setDownstreamCompilerForTransition);
+        CASE(IGlobalSession_getDownstreamCompilerForTransition);
+        CASE(IGlobalSession_getCompilerElapsedTime);
+        CASE(IGlobalSession_setSPIRVCoreGrammar);
+        CASE(IGlobalSession_parseCommandLineArguments);
+        CASE(IGlobalSession_getSessionDescDigest);
+        CASE(ISession_getGlobalSession);
+        CASE(ISession_loadModule);
+        CASE(ISession_loadModuleFromIRBlob);
+        CASE(ISession_loadModuleFromSource);
+        CASE(ISession_loadModuleFromSourceString);
+        CASE(ISession_createCompositeComponentType);
+        CASE(ISession_specializeType);
+        CASE(ISession_getTypeLayout);
+        CASE(ISession_getContainerType);
+        CASE(ISession_getDynamicType);
+        CASE(ISession_getTypeRTTIMangledName);
+        CASE(ISession_getTypeConformanceWitnessMangledName);
+        CASE(ISession_getTypeConformanceWitnessSequentialID);
+        CASE(ISession_createTypeConformanceComponentType);
+        CASE(ISession_createCompileRequest);
+        CASE(ISession_getLoadedModuleCount);
+        CASE(ISession_getLoadedModule);
+        CASE(ISession_isBinaryModuleUpToDate);
+        CASE(IModule_findEntryPointByName);
+        CASE(IModule_getDefinedEntryPointCount);
+        CASE(IModule_getDefinedEntryPoint);
+        CASE(IModule_serialize);
+        CASE(IModule_writeToFile);
+        CASE(IModule_getName);
+        CASE(IModule_getFilePath);
+        CASE(IModule_getUniqueIdentity);
+        CASE(IModule_findAndCheckEntryPoint);
+        CASE(IModule_getSession);
+        CASE(IModule_getLayout);
+        CASE(IModule_getSpecializationParamCount);
+        CASE(IModule_getEntryPointCode);
+        CASE(IModule_getTargetCode);
+        CASE(IModule_getResultAsFileSystem);
+        CASE(IModule_getEntryPointHash);
+        CASE(IModule_specialize);
+        CASE(IModule_link);
+        CASE(IModule_getEntryPointHostCallable);
+        CASE(IModule_renameEntryPoint);
+        CASE(IModule_linkWithOptions);
+        CASE(IEntryPoint_getSession);
+        CASE(IEntryPoint_getLayout);
+        CASE(IEntryPoint_getSpecializationParamCount);
+        CASE(IEntryPoint_getEntryPointCode);
+        CASE(IEntryPoint_getTargetCode);
+        CASE(IEntryPoint_getResultAsFileSystem);
+        CASE(IEntryPoint_getEntryPointHash);
+        CASE(IEntryPoint_specialize);
+        CASE(IEntryPoint_link);
+        CASE(IEntryPoint_getEntryPointHostCallable);
+        CASE(IEntryPoint_renameEntryPoint);
+        CASE(IEntryPoint_linkWithOptions);
+        CASE(ICompositeComponentType_getSession);
+        CASE(ICompositeComponentType_getLayout);
+        CASE(ICompositeComponentType_getSpecializationParamCount);
+        CASE(ICompositeComponentType_getEntryPointCode);
+        CASE(ICompositeComponentType_getTargetCode);
+        CASE(ICompositeComponentType_getResultAsFileSystem);
+        CASE(ICompositeComponentType_getEntryPointHash);
+        CASE(ICompositeComponentType_specialize);
+        CASE(ICompositeComponentType_link);
+        CASE(ICompositeComponentType_getEntryPointHostCallable);
+        CASE(ICompositeComponentType_renameEntryPoint);
+        CASE(ICompositeComponentType_linkWithOptions);
+        CASE(ITypeConformance_getSession);
+        CASE(ITypeConformance_getLayout);
+        CASE(ITypeConformance_getSpecializationParamCount);
+        CASE(ITypeConformance_getEntryPointCode);
+        CASE(ITypeConformance_getTargetCode);
+        CASE(ITypeConformance_getResultAsFileSystem);
+        CASE(ITypeConformance_getEntryPointHash);
+        CASE(ITypeConformance_specialize);
+        CASE(ITypeConformance_link);
+        CASE(ITypeConformance_getEntryPointHostCallable);
+        CASE(ITypeConformance_renameEntryPoint);
+        CASE(ITypeConformance_linkWithOptions);
+    default:
+        return "Unknown";
+    }
+#undef CASE
+}
+
+void ReplayTimings::addCallTime(ApiCallId callId, double microseconds)
+{
+    m_callTimes.getOrAddValue(callId, Slang::List<double>()).add(microseconds);
+}
+
+// Nearest-rank percentile of sorted `values`.
+static double _getPercentile(const Slang::List<double>& values, double percentile)
+{
+    Slang::Index rank = Slang::Index(percentile / 100.0 * double(values.getCount()) + 0.5);
+    rank = Slang::Math::Clamp<Slang::Index>(rank, 1, values.getCount());
+    return values[rank - 1];
+}
+
+void ReplayTimings::computeStats(Slang::List<CallStats>& outStats) const
+{
+    outStats.clear();
+    for (const auto& [callId, times] : m_callTimes)
+    {
+        Slang::List<double> sortedTimes = times;
+        sortedTimes.sort();
+
+        CallStats stats;
+        stats.name = getApiCallIdName(callId);
+        stats.callCount = sortedTimes.getCount();
+        stats.p50 = _getPercentile(sortedTimes, 50);
+        stats.p90 = _getPercentile(sortedTimes, 90);
+        stats.p99 = _getPercentile(sortedTimes, 99);
+        outStats.add(stats);
+    }
+    outStats.sort([](const CallStats& a, const CallStats& b) { return a.name < b.name; });
+}
+
+SlangResult ReplayTimings::saveStats(
+    const Slang::String& filePath,
+    const Slang::List<CallStats>& stats)
+{
+    Slang::StringBuilder sb;
+    sb << kTimingsFileHeader << "\n";
+    for (const auto& callStats : stats)
+    {
+        sb << callStats.name << "\t" << Slang::Int64(callStats.callCount) << "\t"
+           << callStats.p50 << "\t" << callStats.p90 << "\t" << callStats.p99 << "\n";
+    }
+    return Slang::File::writeAllText(filePath, sb);
+}
+
+SlangResult ReplayTimings::loadStats(
+    const Slang::String& filePath,
+    Slang::List<CallStats>& outStats)
+{
+    Slang::String text;
+    SLANG_RETURN_ON_FAIL(Slang::File::readAllText(filePath, text));
+    Slang::List<Slang::UnownedStringSlice> lines;
+    Slang::StringUtil::calcLines(text.getUnownedSlice(), lines);
+    if (lines.getCount() == 0 || lines[0] != Slang::UnownedStringSlice(kTimingsFileHeader))
+        return SLANG_FAIL;
+
+    outStats.clear();
+    Slang::List<Slang::UnownedStringSlice> fields;
+    for (Slang::Index i = 1; i < lines.getCount(); i++)
+    {
+        if (lines[i].getLength() == 0)
+            continue;
+        fields.clear();
+        Slang::StringUtil::split(lines[i], '\t', fields);
+
+        CallStats stats;
+        Slang::Int callCount = 0;
+        if (fields.getCount() != 5 ||
+            SLANG_FAILED(Slang::StringUtil::parseInt(fields[1], callCount)) ||
+            SLANG_FAILED(Slang::StringUtil::parseDouble(fields[2], stats.p50)) ||
+            SLANG_FAILED(Slang::StringUtil::parseDouble(fields[3], stats.p90)) ||
+            SLANG_FAILED(Slang::StringUtil::parseDouble(fields[4], stats.p99)))
+        {
+            return SLANG_FAIL;
+        }
+        stats.name = fields[0];
+        stats.callCount = callCount;
+        outStats.add(stats);
+    }
+    return SLANG_OK;
+}
+} // namespace SlangRecord
@@ -0,0 +1,43 @@
+#ifndef REPLAY_TIMINGS_H
+#define REPLAY_TIMINGS_H
+
+#include "../../core/slang-dictionary.h"
+#include "../../core/slang-list.h"
+#include "../../core/slang-string.h"
+#include "../util/record-format.h"
+
+namespace SlangRecord
+{
+// Collects how long each API call takes to replay, so that a recorded session can be used as
+// a benchmark.
+class ReplayTimings
+{
+public:
+    struct CallStats
+    {
+        Slang::String name;
+        Slang::Index callCount = 0;
+        // Latency percentiles, in microseconds.
+        double p50 = 0;
+        double p90 = 0;
+        double p99 = 0;
+    };
+
+    void addCallTime(ApiCallId callId, double microseconds);
+
+    // Compute the latency percentiles of each API call that was replayed, sorted by name.
+    void computeStats(Slang::List<CallStats>& outStats) const;
+
+    static SlangResult saveStats(
+        const Slang::String& filePath,
+        const Slang::List<CallStats>& stats);
+    static SlangResult loadStats(const Slang::String& filePath, Slang::List<CallStats>& outStats);
+
+private:
+    Slang::Dictionary<ApiCallId, Slang::List<double>> m_callTimes;
+};
+
+const char* getApiCallIdName(ApiCallId callId);
+} // namespace SlangRecord
+
+#endif // REPLAY_TIMINGS_H
@@ -18,6 +18,9 @@ enum LogLevel : unsigned int
 };
 
 bool isRecordLayerEnabled();
+// Whether the record file should be written by a background thread, which makes recording
+// cheaper, but can lose the last calls recorded before a crash.
+bool isRecordAsyncWriteEnabled();
 void slangRecordLog(LogLevel logLevel, const char* fmt, ...);
 void setLogLevel();
 } // namespace SlangRecord
@@ -6,6 +6,7 @@
 
 #include <slang.h>
 #include <string>
+#include <thread>
 #include <vector>
 
 using namespace slang;
@@ -81,6 +82,15 @@ Session* GlobalSession::createSession(int compileTarget)
         }
         sessionDesc.targets = &target;
         sessionDesc.targetCount = targetCount;
+#ifdef __EMSCRIPTEN_PTHREADS__
+        // Threads are only available when the module was built with `-pthread`, and the page
+        // is cross-origin isolated, so the front end only uses them in that build.
+        CompilerOptionEntry threadCountOption = {};
+        threadCountOption.name = CompilerOptionName::FrontEndThreadCount;
+        threadCountOption.value.intValue0 = (int32_t)std::thread::hardware_concurrency();
+        sessionDesc.compilerOptionEntries = &threadCountOption;
+        sessionDesc.compilerOptionEntryCount = 1;
+#endif
         SlangResult result = m_interface->createSession(sessionDesc, session.writeRef());
         if (result != SLANG_OK)
         {
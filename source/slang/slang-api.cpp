@@ -151,7 +151,9 @@ SLANG_API void slang_shutdown()
     Slang::PerformanceProfiler::getProfiler()->dispose();
     Slang::SPIRVCoreGrammarInfo::freeEmbeddedGrammerInfo();
     Slang::RttiInfo::deallocateAll();
+    Slang::freeCapabilitySetsOfNames();
     Slang::freeCapabilityDefs();
+    Slang::SharedCoreModule::freeAll();
 }
 
 SLANG_API SlangResult slang_createGlobalSessionWithoutCoreModule(
@@ -239,15 +239,16 @@ ASTBuilder::ASTBuilder(SharedASTBuilder* sharedASTBuilder, const String& name)
     , m_name(name)
     , m_id(sharedASTBuilder->m_id++)
     , m_arena(2097152)
+    , m_valArena(524288)
 {
     SLANG_ASSERT(sharedASTBuilder);
-    // Copy Val deduplication map over so we don't create duplicate Vals that are already
-    // existent in the core module.
-    m_cachedNodes = sharedASTBuilder->getInnerASTBuilder()->m_cachedNodes;
+    // Look up Vals in the deduplication map of the core module too, so we don't create
+    // duplicates of Vals that already exist there.
+    m_builtinCachedNodes = &sharedASTBuilder->getInnerASTBuilder()->m_cachedNodes;
 }
 
 ASTBuilder::ASTBuilder()
-    : m_sharedASTBuilder(nullptr), m_id(-1), m_arena(2097152)
+    : m_sharedASTBuilder(nullptr), m_id(-1), m_arena(2097152), m_valArena(524288)
 {
     m_name = "SharedASTBuilder::m_astBuilder";
 }
@@ -263,6 +264,22 @@ ASTBuilder::~ASTBuilder()
     incrementEpoch();
 }
 
+void ASTBuilder::setMemoryAccounting(MemoryAccounting* accounting)
+{
+    m_memoryAccounting = accounting;
+    m_arena.setAccounting(accounting, MemoryCategory::AST);
+    m_valArena.setAccounting(accounting, MemoryCategory::AST);
+}
+
+ASTBuilder::ValCacheStats ASTBuilder::getValCacheStats()
+{
+    ValCacheStats stats = m_valCacheStats;
+    stats.entryCount = m_cachedNodes.getCount();
+    stats.memoryUsed = m_valArena.calcTotalMemoryUsed() +
+                       size_t(stats.entryCount) * sizeof(KeyValuePair<ValKey, Val*>);
+    return stats;
+}
+
 Index ASTBuilder::getEpoch()
 {
     return getSharedASTBuilder()->m_session->m_epochId;
@@ -194,13 +194,46 @@ class ASTBuilder : public RefObject
     friend class SharedASTBuilder;
 
 public:
+    /// Statistics about the deduplication of `Val`s.
+    struct ValCacheStats
+    {
+        /// Number of requests for a `Val` that found an existing one.
+        Count hitCount = 0;
+        /// Number of those hits that found a `Val` of the builtin modules.
+        Count builtinHitCount = 0;
+        /// Number of requests that created a new `Val`.
+        Count missCount = 0;
+        /// Number of `Val`s in this builder's table, not counting those of the builtin modules.
+        Count entryCount = 0;
+        /// Bytes used by this builder's `Val`s and its table.
+        size_t memoryUsed = 0;
+    };
+
+    ValCacheStats getValCacheStats();
+
     Val* _getOrCreateImpl(ValNodeDesc&& desc)
     {
         if (auto found = m_cachedNodes.tryGetValue(desc))
+        {
+            m_valCacheStats.hitCount++;
             return *found;
+        }
+        // The `Val`s of the builtin modules are found in the table of the builder that
+        // created them, rather than copying that table into every builder.
+        if (m_builtinCachedNodes)
+        {
+            if (auto found = m_builtinCachedNodes->tryGetValue(desc))
+            {
+                m_valCacheStats.hitCount++;
+                m_valCacheStats.builtinHitCount++;
+                return *found;
+            }
+        }
+        m_valCacheStats.missCount++;
 
         auto node = as<Val>(createByNodeType(desc.type));
         SLANG_ASSERT(node);
+        node->m_operands.reserve(desc.operands.getCount());
         for (auto& operand : desc.operands)
             node->m_operands.add(operand);
         auto result = node;
@@ -212,13 +245,31 @@ public:
     /// no need for additional state.
     Dictionary<ValKey, Val*, Hash<ValKey>, ValKeyEqual> m_cachedNodes;
 
+    /// The cache of the builder for the builtin modules, which is looked in after
+    /// `m_cachedNodes`, or null if this is that builder.
+    Dictionary<ValKey, Val*, Hash<ValKey>, ValKeyEqual>* m_builtinCachedNodes = nullptr;
+
+    ValCacheStats m_valCacheStats;
+
     Dictionary<GenericDecl*, List<Val*>> m_cachedGenericDefaultArgs;
 
+    /// The names produced by `slang-mangle.cpp` for decl refs, which are reused for as long
+    /// as the epoch they were computed in is current. The qualified names are the prefixes
+    /// that the mangled names of the members and specializations of a decl are built on.
+    struct MangledNameCache
+    {
+        Index epoch = -1;
+        Dictionary<DeclRefBase*, String> mangledNames;
+        Dictionary<DeclRefBase*, String> qualifiedNames;
+        Dictionary<DeclRefBase*, String> qualifiedNamesWithoutModule;
+    };
+    MangledNameCache m_mangledNameCache;
+
     /// Create AST types
     template<typename T>
     T* createImpl()
     {
-        auto alloced = m_arena.allocate(sizeof(T));
+        auto alloced = _getArenaFor<T>().allocate(sizeof(T));
         memset(alloced, 0, sizeof(T));
         auto result = _initAndAdd(new (alloced) T);
         return result;
@@ -227,7 +278,7 @@ public:
     template<typename T, typename... TArgs>
     T* createImpl(TArgs&&... args)
     {
-        auto alloced = m_arena.allocate(sizeof(T));
+        auto alloced = _getArenaFor<T>().allocate(sizeof(T));
         memset(alloced, 0, sizeof(T));
         auto result = _initAndAdd(new (alloced) T(std::forward<TArgs>(args)...));
         return result;
@@ -657,6 +708,11 @@ public:
 
     MemoryArena& getMemoryArena() { return m_arena; }
 
+    /// Count the memory of the nodes against `accounting`, which the IR modules created while
+    /// this is the current AST builder are also counted against.
+    void setMemoryAccounting(MemoryAccounting* accounting);
+    MemoryAccounting* getMemoryAccounting() { return m_memoryAccounting; }
+
     /// Get the shared AST builder
     SharedASTBuilder* getSharedASTBuilder() { return m_sharedASTBuilder; }
 
@@ -676,6 +732,14 @@ protected:
     ASTBuilder();
 
 
+    /// `Val`s are deduplicated, and so are hashed and compared with each other throughout
+    /// checking, so they are kept together in an arena apart from the syntax nodes.
+    template<typename T>
+    SLANG_FORCE_INLINE MemoryArena& _getArenaFor()
+    {
+        return IsBaseOf<Val, T>::Value ? m_valArena : m_arena;
+    }
+
     template<typename T>
     SLANG_FORCE_INLINE T* _initAndAdd(T* node)
     {
@@ -688,7 +752,8 @@ protected:
             // Keep such that dtor can be run on ASTBuilder being dtored
             m_dtorNodes.add(node);
         }
-        if (node->getClassInfo().isSubClassOf(*ASTClassInfo::getInfo(Val::kType)))
+        // The type is known here, so there is no need to look up its class info.
+        if (IsBaseOf<Val, T>::Value)
         {
             auto val = (Val*)(node);
             val->m_resolvedValEpoch = getEpoch();
@@ -706,6 +771,11 @@ protected:
     SharedASTBuilder* m_sharedASTBuilder;
 
     MemoryArena m_arena;
+
+    /// Holds the `Val` nodes, see `_getArenaFor`.
+    MemoryArena m_valArena;
+
+    RefPtr<MemoryAccounting> m_memoryAccounting;
 };
 
 // Retrieves the ASTBuilder for the current compilation session.
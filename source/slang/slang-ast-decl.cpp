@@ -102,6 +102,7 @@ void ContainerDecl::buildMemberDictionary()
     }
 
     dictionaryLastCount = membersCount;
+    dictionaryVersion++;
     SLANG_ASSERT(isMemberDictionaryValid());
 }
 
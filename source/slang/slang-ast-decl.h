@@ -45,6 +45,10 @@ class ContainerDecl : public Decl
 
     void invalidateMemberDictionary() { dictionaryLastCount = -1; }
 
+    /// Changes each time members are added to the dictionary, so lookup results that were
+    /// cached can be checked against it.
+    Index getMemberDictionaryVersion() const { return dictionaryVersion; }
+
     Dictionary<Name*, Decl*>& getMemberDictionary()
     {
         buildMemberDictionary();
@@ -76,6 +80,9 @@ class ContainerDecl : public Decl
         // recreated.
         Index dictionaryLastCount = 0;
 
+    // Incremented each time the dictionary/transparentMembers are built or extended.
+    Index dictionaryVersion = 0;
+
     // Dictionary for looking up members by name.
     // This is built on demand before performing lookup.
     Dictionary<Name*, Decl*> memberDictionary;
@@ -1286,6 +1286,15 @@ class AnyValueSizeAttribute : public Attribute
     int32_t size;
 };
 
+/// An attribute that selects the implementation type of the dynamically dispatched values of
+/// the decorated interface type with a specialization constant.
+class SpecializationConstantDispatchAttribute : public Attribute
+{
+    SLANG_AST_CLASS(SpecializationConstantDispatchAttribute)
+
+    int32_t constantId;
+};
+
 /// This is a stop-gap solution to break overload ambiguity in the core module.
 /// When there is a function overload ambiguity, the compiler will pick the one with higher rank
 /// specified by this attribute. An overload without this attribute will have a rank of 0.
@@ -1395,6 +1404,19 @@ class PreferCheckpointAttribute : public Attribute
     SLANG_AST_CLASS(PreferCheckpointAttribute)
 };
 
+class CheckpointPolicyAttribute : public Attribute
+{
+    SLANG_AST_CLASS(CheckpointPolicyAttribute)
+
+    // A `SlangAutodiffCheckpointPolicy`.
+    int32_t policy;
+};
+
+class ProfileCountersAttribute : public Attribute
+{
+    SLANG_AST_CLASS(ProfileCountersAttribute)
+};
+
 class DerivativeMemberAttribute : public Attribute
 {
     SLANG_AST_CLASS(DerivativeMemberAttribute)
@@ -1575,6 +1597,14 @@ class NoInlineAttribute : public Attribute
     SLANG_AST_CLASS(NoInlineAttribute)
 };
 
+/// A `[PreferHalf]` attribute marks a function whose floating-point arithmetic can be
+/// evaluated at half precision.
+///
+class PreferHalfAttribute : public Attribute
+{
+    SLANG_AST_CLASS(PreferHalfAttribute)
+};
+
 /// A `[noRefInline]` attribute represents a request to not force inline a
 /// function specifically due to a refType parameter.
 class NoRefInlineAttribute : public Attribute
@@ -1462,6 +1462,8 @@ struct LookupResult
 struct SemanticsVisitor;
 ASTBuilder* semanticsVisitorGetASTBuilder(SemanticsVisitor*);
 
+struct MemberLookupCacheEntry;
+
 struct LookupRequest
 {
     SemanticsVisitor* semantics = nullptr;
@@ -1474,6 +1476,10 @@ struct LookupRequest
     LookupMask mask = LookupMask::Default;
     LookupOptions options = LookupOptions::None;
 
+    // If set, the lookup records the containers it looks in to this entry, so its result
+    // can be cached.
+    MemberLookupCacheEntry* memberLookupCacheEntry = nullptr;
+
     bool isCompletionRequest() const
     {
         return (options & LookupOptions::Completion) != LookupOptions::None;
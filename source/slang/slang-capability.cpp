@@ -3,6 +3,8 @@
 
 #include "../core/slang-dictionary.h"
 
+#include <atomic>
+
 // This file implements the core of the "capability" system.
 
 namespace Slang
@@ -358,9 +360,43 @@ CapabilitySet::CapabilitySet(Int atomCount, CapabilityName const* atoms)
 }
 
 CapabilitySet::CapabilitySet(CapabilityName atom)
+    : CapabilitySet(_getSetOfName(atom))
 {
-    this->m_targetSets.reserve(kCapabilityTargetCount);
-    addUnexpandedCapabilites(atom);
+}
+
+// Expanding a name adds a conjunction of it for every target and stage it doesn't name, so
+// the expansion of each name is only done once.
+static std::atomic<CapabilitySet*> s_setOfName[Count(CapabilityName::Count)];
+
+/* static */ const CapabilitySet& CapabilitySet::_getSetOfName(CapabilityName name)
+{
+    SLANG_ASSERT(Int(name) < Int(CapabilityName::Count));
+    auto& slot = s_setOfName[Int(name)];
+    if (auto set = slot.load(std::memory_order_acquire))
+    {
+        return *set;
+    }
+
+    CapabilitySet* set = new CapabilitySet();
+    set->m_targetSets.reserve(kCapabilityTargetCount);
+    set->addUnexpandedCapabilites(name);
+
+    // Another thread may have built the set at the same time, in which case use theirs
+    CapabilitySet* expected = nullptr;
+    if (!slot.compare_exchange_strong(expected, set, std::memory_order_acq_rel))
+    {
+        delete set;
+        return *expected;
+    }
+    return *set;
+}
+
+void freeCapabilitySetsOfNames()
+{
+    for (auto& slot : s_setOfName)
+    {
+        delete slot.exchange(nullptr);
+    }
 }
 
 CapabilitySet::CapabilitySet(List<CapabilityName> const& atoms)
@@ -384,7 +420,7 @@ CapabilitySet CapabilitySet::makeInvalid()
 
 void CapabilitySet::addCapability(CapabilityName name)
 {
-    join(CapabilitySet(name));
+    join(_getSetOfName(name));
 }
 
 bool CapabilitySet::isEmpty() const
@@ -404,16 +440,14 @@ bool CapabilitySet::isIncompatibleWith(CapabilityAtom other) const
     if (isEmpty())
         return false;
 
-    CapabilitySet otherSet((CapabilityName)other);
-    return isIncompatibleWith(otherSet);
+    return isIncompatibleWith(_getSetOfName((CapabilityName)other));
 }
 
 bool CapabilitySet::isIncompatibleWith(CapabilityName other) const
 {
     if (isEmpty())
         return false;
-    auto otherSet = CapabilitySet(other);
-    return isIncompatibleWith(otherSet);
+    return isIncompatibleWith(_getSetOfName(other));
 }
 
 bool CapabilitySet::isIncompatibleWith(CapabilitySet const& other) const
@@ -469,9 +503,7 @@ bool CapabilitySet::implies(CapabilityAtom atom) const
     if (isEmpty() || atom == CapabilityAtom::Invalid)
         return false;
 
-    CapabilitySet tmpSet = CapabilitySet(CapabilityName(atom));
-
-    return this->implies(tmpSet);
+    return this->implies(_getSetOfName(CapabilityName(atom)));
 }
 
 CapabilitySet::ImpliesReturnFlags CapabilitySet::_implies(
@@ -323,6 +323,10 @@ private:
 
     void addCapability(CapabilityName name);
 
+    /// Get the expanded set of a single capability `name`. The set is built the first time it
+    /// is asked for, and shared from then on.
+    static const CapabilitySet& _getSetOfName(CapabilityName name);
+
     bool hasSameTargets(const CapabilitySet& other) const;
 
     enum class ImpliesFlags
@@ -375,6 +379,9 @@ bool hasTargetAtom(const CapabilityAtomSet& setIn, CapabilityAtom& targetAtom);
 
 void freeCapabilityDefs();
 
+/// Free the sets shared by `CapabilitySet`s constructed from a single capability name.
+void freeCapabilitySetsOfNames();
+
 // #define UNIT_TEST_CAPABILITIES
 #ifdef UNIT_TEST_CAPABILITIES
 void TEST_CapabilitySet();
@@ -1270,6 +1270,13 @@ void SemanticsVisitor::ensureDecl(Decl* decl, DeclCheckState state, SemanticsCon
 ///
 void SemanticsVisitor::ensureAllDeclsRec(Decl* decl, DeclCheckState state)
 {
+    getLinkage()->checkForCancellation(getSink());
+
+    // A function whose body checking was deferred is only checked once it is referenced.
+    if (state >= DeclCheckState::DefinitionChecked &&
+        getShared()->isFunctionBodyCheckingDeferred(decl))
+        return;
+
     // Ensure `decl` itself first.
     ensureDecl(decl, state);
 
@@ -3171,6 +3178,16 @@ void SemanticsDeclVisitorBase::checkModule(ModuleDecl* moduleDecl)
     // TODO: This could be factored into another visitor pass
     // that fits more with the standard checking below.
     //
+    {
+        List<Name*> importedNames;
+        SourceLoc importLoc;
+        for (auto importDecl : moduleDecl->getMembersOfType<ImportDecl>())
+        {
+            importedNames.add(importDecl->moduleNameAndLoc.name);
+            importLoc = importDecl->moduleNameAndLoc.loc;
+        }
+        getLinkage()->prefetchImportedModuleFiles(importedNames, importLoc);
+    }
     for (auto importDecl : moduleDecl->getMembersOfType<ImportDecl>())
     {
         ensureDecl(importDecl, DeclCheckState::DefinitionChecked);
@@ -3283,6 +3300,16 @@ void SemanticsDeclVisitorBase::checkModule(ModuleDecl* moduleDecl)
     // With extensions taken care of, we can now check the remaining decls.
     for (auto s : states)
     {
+        // Attributes have been checked by now, so we can tell which functions are entry
+        // points or otherwise used from outside the module.
+        //
+        if (s == DeclCheckState::DefinitionChecked &&
+            getOptionSet().getBoolOption(CompilerOptionName::DeferFunctionBodyChecking) &&
+            !getShared()->isInLanguageServer())
+        {
+            _deferFunctionBodyChecking(moduleDecl);
+        }
+
         // When advancing to state `s` we will recursively
         // advance all declarations rooted in the module
         // up to `s`.
@@ -3300,11 +3327,150 @@ void SemanticsDeclVisitorBase::checkModule(ModuleDecl* moduleDecl)
         ensureAllDeclsRec(moduleDecl, s);
     }
 
+    // The bodies of deferred functions that were referenced by the code checked above are
+    // checked now, and can in turn reference more of them.
+    //
+    while (auto decl = getShared()->takeReferencedDeferredFunction())
+    {
+        ensureAllDeclsRec(decl, DeclCheckState::DefinitionChecked);
+        ensureAllDeclsRec(decl, DeclCheckState::CapabilityChecked);
+    }
+
     // Once we have completed the above loop, all declarations not
     // nested in function bodies should be in `DeclState::Checked`.
     // Furthermore, because a fully checked function will have checked
     // its body, this also means that all function bodies and the
-    // declarations they contain should be fully checked.
+    // declarations they contain should be fully checked, other than
+    // those of deferred functions that are never referenced.
+}
+
+/// Get the declaration `decl` wraps if it is a generic, or else `decl` itself.
+static Decl* _getGenericInnerOrSelf(Decl* decl)
+{
+    if (auto genericDecl = as<GenericDecl>(decl))
+        return genericDecl->inner;
+    return decl;
+}
+
+/// Is `funcDecl`, a global function in `moduleDecl`, used from outside the module in a way
+/// that doesn't go through checked code? `entryPointNames` are the names of the entry points
+/// and patch-constant functions that will be looked up.
+///
+static bool _isFunctionUsedOutsideModule(
+    ModuleDecl* moduleDecl,
+    FunctionDeclBase* funcDecl,
+    HashSet<Name*> const& entryPointNames)
+{
+    // Attributes mark entry points (`[shader]`, `[numthreads]`), exports (`[DllExport]`),
+    // and functions that are found through other functions, such as derivatives.
+    if (funcDecl->findModifier<AttributeBase>())
+        return true;
+    if (funcDecl->hasModifier<HLSLExportModifier>() || funcDecl->hasModifier<ExternCppModifier>())
+        return true;
+    if (entryPointNames.contains(funcDecl->getName()))
+        return true;
+
+    // Everything in a legacy module is public by default, so we only treat the functions
+    // that say so as visible to other modules.
+    if (funcDecl->hasModifier<PublicModifier>())
+        return true;
+    return !moduleDecl->isInLegacyLanguage &&
+           getDeclVisibility(funcDecl) == DeclVisibility::Public;
+}
+
+static void _addEntryPointNames(
+    NamePool* namePool,
+    ContainerDecl* containerDecl,
+    HashSet<Name*>& ioEntryPointNames)
+{
+    for (auto member : containerDecl->members)
+    {
+        if (as<FileDecl>(member) || as<NamespaceDecl>(member))
+        {
+            _addEntryPointNames(namePool, as<ContainerDecl>(member), ioEntryPointNames);
+            continue;
+        }
+        auto funcDecl = as<FuncDecl>(_getGenericInnerOrSelf(member));
+        if (!funcDecl)
+            continue;
+
+        // A hull shader names its patch-constant function with a string.
+        auto attr = funcDecl->findModifier<PatchConstantFuncAttribute>();
+        if (!attr || attr->args.getCount() != 1)
+            continue;
+        if (auto stringLit = as<StringLiteralExpr>(attr->args[0]))
+            ioEntryPointNames.add(namePool->getName(stringLit->value));
+    }
+}
+
+static void _deferFunctionBodyCheckingRec(
+    SharedSemanticsContext* shared,
+    ModuleDecl* moduleDecl,
+    ContainerDecl* containerDecl,
+    HashSet<Name*> const& entryPointNames)
+{
+    for (auto member : containerDecl->members)
+    {
+        // Member functions of types are left alone, since witness tables and synthesized
+        // code can refer to them without going through checked code.
+        if (as<FileDecl>(member) || as<NamespaceDecl>(member))
+        {
+            _deferFunctionBodyCheckingRec(
+                shared,
+                moduleDecl,
+                as<ContainerDecl>(member),
+                entryPointNames);
+            continue;
+        }
+        auto funcDecl = as<FunctionDeclBase>(_getGenericInnerOrSelf(member));
+        if (!funcDecl || !funcDecl->body || funcDecl->isChecked(DeclCheckState::DefinitionChecked))
+            continue;
+        if (_isFunctionUsedOutsideModule(moduleDecl, funcDecl, entryPointNames))
+            continue;
+        shared->deferFunctionBodyChecking(member);
+    }
+}
+
+void SemanticsDeclVisitorBase::_deferFunctionBodyChecking(ModuleDecl* moduleDecl)
+{
+    auto namePool = getLinkage()->getNamePool();
+
+    HashSet<Name*> entryPointNames;
+    if (auto translationUnit = getShared()->getTranslationUnitRequest())
+    {
+        for (auto entryPointReq : translationUnit->compileRequest->getEntryPointReqs())
+            entryPointNames.add(entryPointReq->getName());
+    }
+    _addEntryPointNames(namePool, moduleDecl, entryPointNames);
+
+    _deferFunctionBodyCheckingRec(getShared(), moduleDecl, moduleDecl, entryPointNames);
+}
+
+void SharedSemanticsContext::noteDeclReferenced(Decl* decl)
+{
+    if (!decl)
+        return;
+
+    // The module of a function referenced from here must generate IR for it.
+    if (m_lowersReferencedFunctionsOnly && as<FunctionDeclBase>(decl))
+    {
+        if (auto module = Slang::getModule(decl))
+            module->noteFunctionReferenced(decl);
+    }
+
+    if (m_deferredFunctionDecls.getCount() == 0)
+        return;
+
+    // A generic function is deferred as a whole.
+    if (auto genericDecl = as<GenericDecl>(decl->parentDecl))
+    {
+        if (genericDecl->inner == decl)
+            decl = genericDecl;
+    }
+    if (!m_deferredFunctionDecls.contains(decl))
+        return;
+    m_deferredFunctionDecls.remove(decl);
+    m_referencedDeferredFunctionDecls.add(decl);
 }
 
 bool SemanticsVisitor::doesSignatureMatchRequirement(
@@ -10381,6 +10547,11 @@ void SharedSemanticsContext::registerCandidateExtension(
     //
     _getCandidateExtensionList(typeDecl, m_mapTypeDeclToCandidateExtensions).add(extDecl);
 
+    // The extension's members are visible to lookup in any type it applies to, so none of
+    // the cached member lookup results can be trusted any more.
+    m_mapMemberLookupToResult.clear();
+    m_memberLookupCacheGeneration++;
+
     // Remove the cached inheritanceInfo about typeDecl, if `extDecl` inherits new types.
     bool invalidateSubtypes = false;
     if (as<InterfaceDecl>(typeDecl))
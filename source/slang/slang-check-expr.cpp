@@ -347,6 +347,9 @@ DeclRefExpr* SemanticsVisitor::ConstructDeclRefExpr(
     // deprecated, diagnose here.
     diagnoseDeprecatedDeclRefUsage(declRef, loc, originalExpr);
 
+    // A function whose body checking was deferred needs to be checked once it is used.
+    getShared()->noteDeclReferenced(declRef.getDecl());
+
     // Construct an appropriate expression based on the structured of
     // the declaration reference.
     //
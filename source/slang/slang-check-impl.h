@@ -243,6 +243,74 @@ struct OperatorOverloadCacheKey
     }
 };
 
+/// A key for caching the result of resolving a call to an overloaded core module function,
+/// such as `max(a, b)` or `dot(u, v)`, where all the arguments have basic types.
+struct FunctionOverloadCacheKey
+{
+    static const Index kMaxArgCount = 4;
+
+    // The candidates found by lookup, so calls that see different overloads don't share a key.
+    List<DeclRefBase*> candidates;
+    BasicTypeKey args[kMaxArgCount];
+    Index argCount = 0;
+
+    bool operator==(FunctionOverloadCacheKey const& key) const
+    {
+        if (argCount != key.argCount || !(candidates == key.candidates))
+            return false;
+        for (Index i = 0; i < argCount; i++)
+        {
+            if (!(args[i] == key.args[i]))
+                return false;
+        }
+        return true;
+    }
+    HashCode getHashCode() const
+    {
+        HashCode hash = Slang::getHashCode(argCount);
+        for (auto candidate : candidates)
+            hash = combineHash(hash, Slang::getHashCode(candidate));
+        for (Index i = 0; i < argCount; i++)
+            hash = combineHash(hash, args[i].getRaw());
+        return hash;
+    }
+    bool fromInvokeExpr(InvokeExpr* invokeExpr)
+    {
+        // Operators have a cache of their own.
+        if (as<OperatorExpr>(invokeExpr))
+            return false;
+
+        argCount = invokeExpr->arguments.getCount();
+        if (argCount > kMaxArgCount)
+            return false;
+        for (Index i = 0; i < argCount; i++)
+        {
+            auto arg = invokeExpr->arguments[i];
+            args[i] = makeBasicTypeKey(arg->type, arg);
+            if (args[i].getRaw() == BasicTypeKey::invalid().getRaw())
+                return false;
+        }
+
+        // Only a plain name that refers to functions of the core module is cached. Anything
+        // else may resolve differently depending on where the call appears.
+        auto overloadedExpr = as<OverloadedExpr>(invokeExpr->functionExpr);
+        if (!overloadedExpr || overloadedExpr->base)
+            return false;
+        for (auto item : overloadedExpr->lookupResult2)
+        {
+            if (item.breadcrumbs)
+                return false;
+            Decl* funcDecl = item.declRef.getDecl();
+            if (auto genDecl = as<GenericDecl>(funcDecl))
+                funcDecl = genDecl->inner;
+            if (!as<CallableDecl>(funcDecl) || !isFromCoreModule(funcDecl))
+                return false;
+            candidates.add(item.declRef.declRefBase);
+        }
+        return candidates.getCount() != 0;
+    }
+};
+
 struct OverloadCandidate
 {
     enum class Flavor
@@ -302,9 +370,67 @@ struct OverloadCandidate
 struct TypeCheckingCache
 {
     Dictionary<OperatorOverloadCacheKey, OverloadCandidate> resolvedOperatorOverloadCache;
+    Dictionary<FunctionOverloadCacheKey, OverloadCandidate> resolvedFunctionOverloadCache;
     Dictionary<BasicTypeKeyPair, ConversionCost> conversionCostCache;
 };
 
+/// A key for caching the result of looking up a member by name in a type.
+struct MemberLookupCacheKey
+{
+    Type* type = nullptr;
+    Name* name = nullptr;
+    LookupMask mask = LookupMask::Default;
+    LookupOptions options = LookupOptions::None;
+
+    bool operator==(MemberLookupCacheKey const& key) const
+    {
+        return type == key.type && name == key.name && mask == key.mask && options == key.options;
+    }
+    HashCode getHashCode() const
+    {
+        return combineHash(
+            combineHash(Slang::getHashCode(type), Slang::getHashCode(name)),
+            combineHash(Slang::getHashCode(int(mask)), Slang::getHashCode(int(options))));
+    }
+};
+
+/// The cached result of looking up a member in a type, along with the member dictionaries
+/// that were looked in, so the result can be discarded once any of them change.
+struct MemberLookupCacheEntry
+{
+    struct Container
+    {
+        ContainerDecl* decl;
+        Index memberDictionaryVersion;
+    };
+
+    LookupResult result;
+    List<Container> containers;
+
+    // False if the result depends on something other than the member dictionaries, such as
+    // the type of a transparent member, that might change as checking goes on.
+    bool isCacheable = true;
+
+    // The generation of the cache when the lookup started, see `SharedSemanticsContext`.
+    Index generation = 0;
+
+    void addContainer(ContainerDecl* decl)
+    {
+        containers.add(Container{decl, decl->getMemberDictionaryVersion()});
+    }
+
+    bool isCurrent() const
+    {
+        for (auto& container : containers)
+        {
+            if (!container.decl->isMemberDictionaryValid() ||
+                container.decl->getMemberDictionaryVersion() != container.memberDictionaryVersion)
+                return false;
+        }
+        return true;
+    }
+};
+
 enum class CoercionSite
 {
     General,
@@ -657,6 +783,9 @@ public:
         , m_sink(sink)
         , m_environmentModules(environmentModules)
         , m_translationUnitRequest(translationUnit)
+        , m_lowersReferencedFunctionsOnly(
+              linkage &&
+              linkage->m_optionSet.getBoolOption(CompilerOptionName::LowerReferencedFunctionsOnly))
     {
     }
 
@@ -745,6 +874,53 @@ public:
         m_mapTypePairToImplicitCastMethod[key] = candidate;
     }
 
+    /// Try get the result of a member lookup from cache, returns null if there is no current
+    /// result for the query.
+    MemberLookupCacheEntry* tryGetCachedMemberLookup(MemberLookupCacheKey const& key)
+    {
+        auto entry = m_mapMemberLookupToResult.tryGetValue(key);
+        if (entry && !entry->isCurrent())
+        {
+            m_mapMemberLookupToResult.remove(key);
+            return nullptr;
+        }
+        return entry;
+    }
+    Index getMemberLookupCacheGeneration() { return m_memberLookupCacheGeneration; }
+    /// Is inheritance information being calculated? Lookup in the middle of that can see an
+    /// incomplete inheritance list, so its result shouldn't be cached.
+    bool isCalculatingInheritanceInfo() { return m_inheritanceInfoCalcDepth != 0; }
+    void cacheMemberLookup(MemberLookupCacheKey const& key, MemberLookupCacheEntry const& entry)
+    {
+        // Don't cache a result if the cache was cleared while it was being looked up.
+        if (entry.isCacheable && entry.generation == m_memberLookupCacheGeneration)
+            m_mapMemberLookupToResult[key] = entry;
+    }
+
+    /// Defer checking the body of `decl`, a global function or generic function, until it is
+    /// referenced. See `CompilerOptionName::DeferFunctionBodyChecking`.
+    void deferFunctionBodyChecking(Decl* decl) { m_deferredFunctionDecls.add(decl); }
+    bool isFunctionBodyCheckingDeferred(Decl* decl)
+    {
+        return m_deferredFunctionDecls.contains(decl);
+    }
+
+    /// Note that `decl` has been referenced, so its body must be checked if that was deferred,
+    /// and its module must generate IR for it, see
+    /// `CompilerOptionName::LowerReferencedFunctionsOnly`.
+    void noteDeclReferenced(Decl* decl);
+
+    /// Take a function whose body was deferred and has since been referenced, or return null
+    /// if there are none.
+    Decl* takeReferencedDeferredFunction()
+    {
+        if (m_referencedDeferredFunctionDecls.getCount() == 0)
+            return nullptr;
+        auto decl = m_referencedDeferredFunctionDecls.getLast();
+        m_referencedDeferredFunctionDecls.removeLast();
+        return decl;
+    }
+
     // Get the inner most generic decl that a decl-ref is dependent on.
     // For example, `Foo<T>` depends on the generic decl that defines `T`.
     //
@@ -874,6 +1050,21 @@ private:
     Dictionary<DeclRef<Decl>, InheritanceInfo> m_mapDeclRefToInheritanceInfo;
     Dictionary<TypePair, SubtypeWitness*> m_mapTypePairToSubtypeWitness;
     Dictionary<ImplicitCastMethodKey, ImplicitCastMethod> m_mapTypePairToImplicitCastMethod;
+
+    /// Results of looking up members in types. This is cleared when a new extension is
+    /// registered, since the extension can add members to any type it applies to.
+    Dictionary<MemberLookupCacheKey, MemberLookupCacheEntry> m_mapMemberLookupToResult;
+    /// Incremented each time `m_mapMemberLookupToResult` is cleared.
+    Index m_memberLookupCacheGeneration = 0;
+    /// The number of inheritance info calculations in progress.
+    Index m_inheritanceInfoCalcDepth = 0;
+
+    /// Functions whose bodies won't be checked unless they are referenced.
+    HashSet<Decl*> m_deferredFunctionDecls;
+    /// Functions removed from `m_deferredFunctionDecls` that still need their bodies checked.
+    List<Decl*> m_referencedDeferredFunctionDecls;
+
+    bool m_lowersReferencedFunctionsOnly = false;
 };
 
 /// Local/scoped state of the semantic-checking system
@@ -2938,6 +3129,10 @@ struct SemanticsDeclVisitorBase : public SemanticsVisitor
     }
 
     void checkModule(ModuleDecl* programNode);
+
+    /// Defer checking the bodies of the global functions in `moduleDecl` that nothing outside
+    /// the module uses directly, for `CompilerOptionName::DeferFunctionBodyChecking`.
+    void _deferFunctionBodyChecking(ModuleDecl* moduleDecl);
 };
 
 bool isUnsizedArrayType(Type* type);
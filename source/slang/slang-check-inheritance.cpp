@@ -31,7 +31,9 @@ InheritanceInfo SharedSemanticsContext::getInheritanceInfo(
     //
     m_mapTypeToInheritanceInfo[type] = InheritanceInfo();
 
+    m_inheritanceInfoCalcDepth++;
     auto info = _calcInheritanceInfo(type, circularityInfo);
+    m_inheritanceInfoCalcDepth--;
     m_mapTypeToInheritanceInfo[type] = info;
 
     return info;
@@ -95,7 +97,9 @@ InheritanceInfo SharedSemanticsContext::_getInheritanceInfo(
     //
     m_mapDeclRefToInheritanceInfo[declRef] = InheritanceInfo();
 
+    m_inheritanceInfoCalcDepth++;
     auto info = _calcInheritanceInfo(declRef, declRefType, circularityInfo);
+    m_inheritanceInfoCalcDepth--;
     m_mapDeclRefToInheritanceInfo[declRef] = info;
 
     getSession()->m_typeDictionarySize = Math::Max(
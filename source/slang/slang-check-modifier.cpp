@@ -468,6 +468,16 @@ Modifier* SemanticsVisitor::validateAttribute(
 
         anyValueSizeAttr->size = int32_t(value->getValue());
     }
+    else if (auto specConstDispatchAttr = as<SpecializationConstantDispatchAttribute>(attr))
+    {
+        SLANG_ASSERT(attr->args.getCount() == 1);
+
+        auto value = checkConstantIntVal(attr->args[0]);
+        if (!value)
+            return nullptr;
+
+        specConstDispatchAttr->constantId = int32_t(value->getValue());
+    }
     else if (
         auto glslRequireShaderInputParameter = as<GLSLRequireShaderInputParameterAttribute>(attr))
     {
@@ -936,6 +946,17 @@ Modifier* SemanticsVisitor::validateAttribute(
         preferRecomputeAttr->sideEffectBehavior =
             (PreferRecomputeAttribute::SideEffectBehavior)val->getValue();
     }
+    else if (auto checkpointPolicyAttr = as<CheckpointPolicyAttribute>(attr))
+    {
+        SLANG_ASSERT(attr->args.getCount() == 1);
+        SLANG_ASSERT(as<Decl>(attrTarget));
+
+        auto val = checkConstantIntVal(attr->args[0]);
+        if (!val)
+            return nullptr;
+
+        checkpointPolicyAttr->policy = int32_t(val->getValue());
+    }
     else if (auto comInterfaceAttr = as<ComInterfaceAttribute>(attr))
     {
         SLANG_ASSERT(attr->args.getCount() == 1);
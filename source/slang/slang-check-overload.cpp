@@ -2469,10 +2469,12 @@ String SemanticsVisitor::getCallSignatureString(OverloadResolveContext& context)
 Expr* SemanticsVisitor::ResolveInvoke(InvokeExpr* expr)
 {
     OverloadResolveContext context;
-    // check if this is a core module operator call, if so we want to use cached results
-    // to speed up compilation
+    // check if this is a core module operator or function call, if so we want to use cached
+    // results to speed up compilation
     bool shouldAddToCache = false;
     OperatorOverloadCacheKey key;
+    bool shouldAddToFunctionCache = false;
+    FunctionOverloadCacheKey functionKey;
     TypeCheckingCache* typeCheckingCache = getLinkage()->getTypeCheckingCache();
     if (auto opExpr = as<OperatorExpr>(expr))
     {
@@ -2490,6 +2492,19 @@ Expr* SemanticsVisitor::ResolveInvoke(InvokeExpr* expr)
             }
         }
     }
+    else if (functionKey.fromInvokeExpr(expr))
+    {
+        auto& functionCache = typeCheckingCache->resolvedFunctionOverloadCache;
+        if (auto candidate = functionCache.tryGetValue(functionKey))
+        {
+            context.bestCandidateStorage = *candidate;
+            context.bestCandidate = &context.bestCandidateStorage;
+        }
+        else
+        {
+            shouldAddToFunctionCache = true;
+        }
+    }
 
     // Look at the base expression for the call, and figure out how to invoke it.
     auto funcExpr = expr->functionExpr;
@@ -2693,6 +2708,14 @@ Expr* SemanticsVisitor::ResolveInvoke(InvokeExpr* expr)
         // the user the most help we can.
         if (shouldAddToCache)
             typeCheckingCache->resolvedOperatorOverloadCache[key] = *context.bestCandidate;
+        // Only applicable candidates are cached for functions, so calls that fail are
+        // diagnosed as usual.
+        if (shouldAddToFunctionCache &&
+            context.bestCandidate->status == OverloadCandidate::Status::Applicable)
+        {
+            typeCheckingCache->resolvedFunctionOverloadCache[functionKey] =
+                *context.bestCandidate;
+        }
 
         // Now that we have resolved the overload candidate, we need to undo an `openExistential`
         // operation that was applied to `out` arguments.
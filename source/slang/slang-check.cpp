@@ -5,6 +5,7 @@
 // checking that don't cleanly land in one of the more
 // specialized `slang-check-*` files.
 
+#include "../core/slang-performance-profiler.h"
 #include "../core/slang-type-text-util.h"
 #include "slang-check-impl.h"
 
@@ -79,6 +80,8 @@ void Session::_setSharedLibraryLoader(ISlangSharedLibraryLoader* loader)
 
 void Session::resetDownstreamCompiler(PassThroughMode type)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_codeGenStateMutex);
+
     // Mark as initialized
     m_downstreamCompilerInitialized &= ~(1 << int(type));
     m_downstreamCompilers[int(type)].setNull();
@@ -88,6 +91,8 @@ IDownstreamCompiler* Session::getOrLoadDownstreamCompiler(
     PassThroughMode type,
     DiagnosticSink* sink)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_codeGenStateMutex);
+
     if (m_downstreamCompilerInitialized & (1 << int(type)))
     {
         return m_downstreamCompilers[int(type)];
@@ -95,11 +100,23 @@ IDownstreamCompiler* Session::getOrLoadDownstreamCompiler(
 
     if (type == PassThroughMode::GenericCCpp)
     {
-        // try testing for availability on all C/C++ compilers
-        getOrLoadDownstreamCompiler(PassThroughMode::Clang, nullptr);
-        getOrLoadDownstreamCompiler(PassThroughMode::Gcc, nullptr);
-        getOrLoadDownstreamCompiler(PassThroughMode::VisualStudio, nullptr);
-        getOrLoadDownstreamCompiler(PassThroughMode::LLVM, nullptr);
+        // The default C/C++ compiler is the one closest to the compiler that Slang
+        // was built with, so we start by looking for that kind of compiler. Locating
+        // a compiler can mean running it or loading a library, so we only look for
+        // the others if that doesn't give us a default.
+        const auto compiledType =
+            PassThroughMode(DownstreamCompilerUtil::getCompiledVersion().type);
+        if (compiledType != PassThroughMode::None)
+            getOrLoadDownstreamCompiler(compiledType, nullptr);
+
+        if (!m_downstreamCompilerSet->getDefaultCompiler(SLANG_SOURCE_LANGUAGE_CPP))
+        {
+            // try testing for availability on all C/C++ compilers
+            getOrLoadDownstreamCompiler(PassThroughMode::Clang, nullptr);
+            getOrLoadDownstreamCompiler(PassThroughMode::Gcc, nullptr);
+            getOrLoadDownstreamCompiler(PassThroughMode::VisualStudio, nullptr);
+            getOrLoadDownstreamCompiler(PassThroughMode::LLVM, nullptr);
+        }
     }
 
     // Mark that we have tried to load it
@@ -174,6 +191,8 @@ void checkTranslationUnit(
     LoadedModuleDictionary& loadedModules)
 {
     SLANG_AST_BUILDER_RAII(translationUnit->compileRequest->getLinkage()->getASTBuilder());
+    SLANG_PROFILE_TAG(getUnownedStringSliceText(translationUnit->moduleName));
+    SLANG_PROFILE;
 
     SharedSemanticsContext sharedSemanticsContext(
         translationUnit->compileRequest->getLinkage(),
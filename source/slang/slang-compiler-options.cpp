@@ -156,6 +156,21 @@ void CompilerOptionSet::buildHash(DigestBuilder<SHA1>& builder)
 {
     for (auto& kv : options)
     {
+        // Whether and where compilation results are cached doesn't affect the results themselves.
+        if (kv.key == CompilerOptionName::CompilationCachePath ||
+            kv.key == CompilerOptionName::CompilationCacheMaxEntryCount ||
+            kv.key == CompilerOptionName::DownstreamResultCache)
+            continue;
+        // Nor does how precompiled modules are read, or how many threads lex the source or
+        // optimize the IR, or whether generic specializations and derivatives are shared across
+        // programs.
+        if (kv.key == CompilerOptionName::MapBinaryModules ||
+            kv.key == CompilerOptionName::ShareGenericSpecializations ||
+            kv.key == CompilerOptionName::ShareForwardDerivatives ||
+            kv.key == CompilerOptionName::OptimizationThreadCount ||
+            kv.key == CompilerOptionName::FrontEndThreadCount)
+            continue;
+
         builder.append(kv.key);
         builder.append(kv.value.getCount());
         for (auto& v : kv.value)
@@ -187,6 +202,7 @@ bool CompilerOptionSet::allowDuplicate(CompilerOptionName name)
     case CompilerOptionName::DownstreamArgs:
     case CompilerOptionName::VulkanBindShift:
     case CompilerOptionName::VulkanBindShiftAll:
+    case CompilerOptionName::DebugInfoFunctions:
         return true;
     }
     return false;
@@ -93,16 +93,19 @@ static bool attemptPrecompiledExport(IRInst* inst)
 SLANG_NO_THROW SlangResult SLANG_MCALL
 Module::precompileForTarget(SlangCompileTarget target, slang::IBlob** outDiagnostics)
 {
+    auto threadSafetyLock = getLinkage()->lockIfThreadSafe();
+
     CodeGenTarget targetEnum = CodeGenTarget(target);
 
-    auto module = getIRModule();
     auto linkage = getLinkage();
-    auto builder = IRBuilder(module);
-
     DiagnosticSink sink(linkage->getSourceManager(), Lexer::sourceLocationLexer);
     applySettingsToDiagnosticSink(&sink, &sink, linkage->m_optionSet);
     applySettingsToDiagnosticSink(&sink, &sink, m_optionSet);
 
+    linkage->generateCompleteModuleIR(this, &sink);
+    auto module = getIRModule();
+    auto builder = IRBuilder(module);
+
     RefPtr<TargetRequest> targetReq = new TargetRequest(linkage, targetEnum);
 
     List<RefPtr<ComponentType>> allComponentTypes;
@@ -212,6 +215,7 @@ Module::precompileForTarget(SlangCompileTarget target, slang::IBlob** outDiagnos
     builder.setInsertInto(module);
 
     builder.emitEmbeddedDownstreamIR(targetReq->getTarget(), blob);
+    module->invalidateMangledNameIndex();
     return SLANG_OK;
 }
 
@@ -220,6 +224,8 @@ SLANG_NO_THROW SlangResult SLANG_MCALL Module::getPrecompiledTargetCode(
     slang::IBlob** outCode,
     slang::IBlob** outDiagnostics)
 {
+    auto threadSafetyLock = getLinkage()->lockIfThreadSafe();
+
     SLANG_UNUSED(outDiagnostics);
     for (auto globalInst : getIRModule()->getModuleInst()->getChildren())
     {
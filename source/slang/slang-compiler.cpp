@@ -38,6 +38,11 @@
 #include "slang-serialize-container.h"
 #include "slang-type-layout.h"
 
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <vector>
+
 namespace Slang
 {
 
@@ -1577,6 +1582,9 @@ SlangResult CodeGenContext::emitWithDownstreamForEntryPoints(ComPtr<IArtifact>&
             SLANG_ASSERT(!"Unhandled optimization level");
             break;
         }
+        options.spirvOptimizationPreset =
+            getTargetProgram()->getOptionSet().getEnumOption<SlangSpirvOptimizationPreset>(
+                CompilerOptionName::SpirvOptimizationPreset);
 
         switch (getTargetProgram()->getOptionSet().getEnumOption<DebugInfoLevel>(
             CompilerOptionName::DebugInformation))
@@ -1729,7 +1737,24 @@ SlangResult CodeGenContext::emitWithDownstreamForEntryPoints(ComPtr<IArtifact>&
     // Compile
     ComPtr<IArtifact> artifact;
     auto downstreamStartTime = std::chrono::high_resolution_clock::now();
-    SLANG_RETURN_ON_FAIL(compiler->compile(options, artifact.writeRef()));
+    // Only source we generated is known to be self contained, so pass-through compiles
+    // never use the result cache.
+    if (!isPassThroughEnabled() &&
+        getTargetProgram()->getOptionSet().getBoolOption(CompilerOptionName::DownstreamResultCache))
+    {
+        auto compilationCache = getLinkage()->getCompilationCache();
+        DownstreamScope downstreamScope(this);
+        SLANG_RETURN_ON_FAIL(session->m_downstreamCompilerSet->compileWithResultCache(
+            compiler,
+            options,
+            compilationCache,
+            artifact.writeRef()));
+    }
+    else
+    {
+        DownstreamScope downstreamScope(this);
+        SLANG_RETURN_ON_FAIL(compiler->compile(options, artifact.writeRef()));
+    }
     auto downstreamElapsedTime =
         (std::chrono::high_resolution_clock::now() - downstreamStartTime).count() * 0.000000001;
     getSession()->addDownstreamCompileTime(downstreamElapsedTime);
@@ -2050,13 +2075,176 @@ IArtifact* TargetProgram::_createEntryPointResult(
     CodeGenContext::Shared sharedCodeGenContext(this, entryPointIndices, sink, endToEndReq);
     CodeGenContext codeGenContext(&sharedCodeGenContext);
 
+    // Attribute all code generation time to this entry point when tracing.
+    SLANG_PROFILE_TAG(
+        getUnownedStringSliceText(codeGenContext.getEntryPoint(entryPointIndex)->getName()));
+
     codeGenContext.emitEntryPoints(m_entryPointResults[entryPointIndex]);
 
     return m_entryPointResults[entryPointIndex];
 }
 
+void TargetProgram::_createEntryPointResultsInParallel(
+    Count threadCount,
+    DiagnosticSink* sink,
+    EndToEndCompileRequest* endToEndReq)
+{
+    const Index entryPointCount = m_program->getEntryPointCount();
+
+    // Size the results up front, as the workers write to them concurrently.
+    if (m_entryPointResults.getCount() < entryPointCount)
+        m_entryPointResults.setCount(entryPointCount);
+
+    // The first entry point is generated on this thread. That way state which is lazily
+    // created and then shared between entry points (such as the IR module for layout, and
+    // loaded downstream compilers) exists before any worker starts.
+    if (entryPointCount > 0)
+        _createEntryPointResult(0, sink, endToEndReq);
+    if (entryPointCount <= 1 || sink->getErrorCount() != 0)
+        return;
+
+    // Every entry point gets a sink of its own, and the diagnostics are passed on to
+    // `sink` in order once all the workers are done.
+    struct EntryPointJob
+    {
+        DiagnosticSink sink;
+        std::exception_ptr exception;
+    };
+    List<EntryPointJob> jobs;
+    jobs.setCount(entryPointCount);
+    for (auto& job : jobs)
+    {
+        job.sink.init(sink->getSourceManager(), sink->getSourceLocationLexer());
+        job.sink.setFlags(sink->getFlags());
+        job.sink.setSourceLineMaxLength(sink->getSourceLineMaxLength());
+        applySettingsToDiagnosticSink(&job.sink, sink, m_optionSet);
+    }
+
+    // The workers share the AST builder, and the rest of the state of the linkage, under the
+    // lock that `CodeGenContext::Shared` takes. This thread must not hold it while joining.
+    ASTBuilder* astBuilder = getCurrentASTBuilder();
+    std::atomic<Index> nextEntryPointIndex(1);
+    auto worker = [&]()
+    {
+        SLANG_AST_BUILDER_RAII(astBuilder);
+        for (;;)
+        {
+            const Index entryPointIndex = nextEntryPointIndex++;
+            if (entryPointIndex >= entryPointCount)
+                break;
+
+            auto& job = jobs[entryPointIndex];
+            try
+            {
+                _createEntryPointResult(entryPointIndex, &job.sink, endToEndReq);
+            }
+            catch (...)
+            {
+                job.exception = std::current_exception();
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    const Count workerCount = Math::Min(threadCount, Count(entryPointCount - 1));
+    for (Index i = 0; i < workerCount; ++i)
+        threads.emplace_back(worker);
+    for (auto& thread : threads)
+        thread.join();
+
+    for (Index i = 1; i < entryPointCount; ++i)
+    {
+        auto& job = jobs[i];
+        if (job.sink.outputBuffer.getLength())
+        {
+            sink->diagnoseRaw(
+                job.sink.getErrorCount() ? Severity::Error : Severity::Warning,
+                job.sink.outputBuffer.getUnownedSlice());
+        }
+        // Rethrow the first failure in entry point order, as the serial path would have.
+        if (job.exception)
+            std::rethrow_exception(job.exception);
+    }
+}
+
+bool TargetProgram::shouldBatchEntryPoints()
+{
+    if (!m_optionSet.getBoolOption(CompilerOptionName::BatchEntryPoints) ||
+        m_program->getEntryPointCount() <= 1)
+        return false;
+
+    // A CUDA module holds any number of kernels, and a Metal library any number of functions,
+    // which the application looks up by name. Other targets either compile a single entry
+    // point per artifact, or, like DXIL libraries, produce something that can't be used in
+    // place of a compiled entry point.
+    //
+    switch (m_targetReq->getTarget())
+    {
+    case CodeGenTarget::PTX:
+    case CodeGenTarget::MetalLib:
+    case CodeGenTarget::MetalLibAssembly:
+        return true;
+    default:
+        return false;
+    }
+}
+
+void TargetProgram::_createBatchedEntryPointResults(
+    DiagnosticSink* sink,
+    EndToEndCompileRequest* endToEndReq)
+{
+    const Index entryPointCount = m_program->getEntryPointCount();
+    if (m_entryPointResults.getCount() < entryPointCount)
+        m_entryPointResults.setCount(entryPointCount);
+
+    CodeGenContext::EntryPointIndices entryPointIndices;
+    for (Index i = 0; i < entryPointCount; ++i)
+        entryPointIndices.add(i);
+
+    CodeGenContext::Shared sharedCodeGenContext(this, entryPointIndices, sink, endToEndReq);
+    CodeGenContext codeGenContext(&sharedCodeGenContext);
+
+    ComPtr<IArtifact> artifact;
+    if (SLANG_FAILED(codeGenContext.emitEntryPoints(artifact)))
+        return;
+
+    for (Index i = 0; i < entryPointCount; ++i)
+        m_entryPointResults[i] = artifact;
+}
+
+void TargetProgram::_releaseIntermediateIRIfComplete()
+{
+    if (!m_optionSet.getBoolOption(CompilerOptionName::ReleaseIntermediateIR))
+        return;
+
+    if (!m_wholeProgramResult)
+    {
+        const Index entryPointCount = m_program->getEntryPointCount();
+        if (m_entryPointResults.getCount() < entryPointCount)
+            return;
+        for (Index i = 0; i < entryPointCount; ++i)
+        {
+            if (!m_entryPointResults[i])
+                return;
+        }
+    }
+
+    auto codeGenLock = m_program->getLinkage()->lockForCodeGen();
+    m_irModuleForLayout = nullptr;
+    setIRLinkSymbols(nullptr, nullptr);
+}
+
+std::unique_lock<std::mutex> TargetProgram::_lockResultsIfThreadSafe()
+{
+    if (!m_program->getLinkage()->isThreadSafe())
+        return std::unique_lock<std::mutex>();
+    return std::unique_lock<std::mutex>(m_resultMutex);
+}
+
 IArtifact* TargetProgram::getOrCreateWholeProgramResult(DiagnosticSink* sink)
 {
+    auto resultLock = _lockResultsIfThreadSafe();
+
     if (m_wholeProgramResult)
         return m_wholeProgramResult;
 
@@ -2064,16 +2252,36 @@ IArtifact* TargetProgram::getOrCreateWholeProgramResult(DiagnosticSink* sink)
     // program, we need to make sure that is done before
     // code generation.
     //
-    if (!getOrCreateIRModuleForLayout(sink))
+    // The layout is built by the front end, so it needs the linkage lock. The
+    // code generation that follows takes it again, see `Linkage::lockForCodeGen`.
+    //
+    // A canceled compilation produces no code, and leaves the result to be created by a later
+    // request after the cancellation has been reset.
+    //
+    try
+    {
+        {
+            auto linkageLock = m_program->getLinkage()->lockIfThreadSafe();
+            if (!getOrCreateIRModuleForLayout(sink))
+            {
+                return nullptr;
+            }
+        }
+
+        IArtifact* artifact = _createWholeProgramResult(sink);
+        _releaseIntermediateIRIfComplete();
+        return artifact;
+    }
+    catch (const CompilationCanceledException&)
     {
         return nullptr;
     }
-
-    return _createWholeProgramResult(sink);
 }
 
 IArtifact* TargetProgram::getOrCreateEntryPointResult(Int entryPointIndex, DiagnosticSink* sink)
 {
+    auto resultLock = _lockResultsIfThreadSafe();
+
     if (entryPointIndex >= m_entryPointResults.getCount())
         m_entryPointResults.setCount(entryPointIndex + 1);
 
@@ -2084,12 +2292,28 @@ IArtifact* TargetProgram::getOrCreateEntryPointResult(Int entryPointIndex, Diagn
     // program, we need to make sure that is done before
     // code generation.
     //
-    if (!getOrCreateIRModuleForLayout(sink))
+    try
+    {
+        {
+            auto linkageLock = m_program->getLinkage()->lockIfThreadSafe();
+            if (!getOrCreateIRModuleForLayout(sink))
+            {
+                return nullptr;
+            }
+        }
+
+        if (shouldBatchEntryPoints())
+            _createBatchedEntryPointResults(sink);
+        else
+            _createEntryPointResult(entryPointIndex, sink);
+    }
+    catch (const CompilationCanceledException&)
     {
         return nullptr;
     }
 
-    return _createEntryPointResult(entryPointIndex, sink);
+    _releaseIntermediateIRIfComplete();
+    return m_entryPointResults[entryPointIndex];
 }
 
 void EndToEndCompileRequest::generateOutput(TargetProgram* targetProgram)
@@ -2099,10 +2323,20 @@ void EndToEndCompileRequest::generateOutput(TargetProgram* targetProgram)
     // Generate target code any entry points that
     // have been requested for compilation.
     auto entryPointCount = program->getEntryPointCount();
+    const Count downstreamThreadCount =
+        targetProgram->getOptionSet().getIntOption(CompilerOptionName::DownstreamThreadCount);
     if (targetProgram->getOptionSet().getBoolOption(CompilerOptionName::GenerateWholeProgram))
     {
         targetProgram->_createWholeProgramResult(getSink(), this);
     }
+    else if (targetProgram->shouldBatchEntryPoints())
+    {
+        targetProgram->_createBatchedEntryPointResults(getSink(), this);
+    }
+    else if (downstreamThreadCount > 1 && entryPointCount > 1)
+    {
+        targetProgram->_createEntryPointResultsInParallel(downstreamThreadCount, getSink(), this);
+    }
     else
     {
         for (Index ii = 0; ii < entryPointCount; ++ii)
@@ -2110,6 +2344,8 @@ void EndToEndCompileRequest::generateOutput(TargetProgram* targetProgram)
             targetProgram->_createEntryPointResult(ii, getSink(), this);
         }
     }
+
+    targetProgram->_releaseIntermediateIRIfComplete();
 }
 
 
@@ -2424,6 +2660,102 @@ static SlangResult _writeDependencyFile(EndToEndCompileRequest* compileRequest)
     return SLANG_OK;
 }
 
+SlangResult EndToEndCompileRequest::writePrecompiledModules()
+{
+    struct ModuleOutput
+    {
+        String modulePath;
+        ComPtr<ISlangBlob> moduleBlob;
+        String dependencies;
+        bool failed = false;
+    };
+    List<ModuleOutput> outputs;
+
+    // Serializing a module reads state it shares with the modules it imports, such as the
+    // digests of their source files, so the modules are serialized one at a time. Only the
+    // files are written in parallel.
+    for (auto translationUnit : getFrontEndReq()->translationUnits)
+    {
+        auto module = translationUnit->getModule();
+
+        // Name the file after the source file, so `import` finds it next to where the source
+        // would be.
+        String fileName;
+        const auto& sourceFiles = translationUnit->getSourceFiles();
+        if (sourceFiles.getCount() && sourceFiles[0]->getPathInfo().hasFileFoundPath())
+            fileName = Path::getFileNameWithoutExt(sourceFiles[0]->getPathInfo().foundPath);
+        else if (module->getName())
+            fileName = module->getName();
+        else
+            return SLANG_FAIL;
+
+        ModuleOutput output;
+        output.modulePath =
+            Path::combine(m_precompiledModuleOutputDir, fileName + ".slang-module");
+        SLANG_RETURN_ON_FAIL(module->serialize(output.moduleBlob.writeRef()));
+
+        // The module depends on the files of the modules it imports too.
+        StringBuilder builder;
+        _escapeDependencyString(output.modulePath.getBuffer(), builder);
+        builder << ":";
+        for (auto sourceFile : module->getFileDependencies())
+        {
+            if (!sourceFile->getPathInfo().hasFoundPath())
+                continue;
+            builder << " ";
+            _escapeDependencyString(
+                sourceFile->getPathInfo().getMostUniqueIdentity().getBuffer(),
+                builder);
+        }
+        builder << "\n";
+        output.dependencies = builder.produceString();
+        outputs.add(output);
+    }
+
+    std::atomic<Index> nextOutputIndex(0);
+    auto worker = [&]()
+    {
+        for (;;)
+        {
+            const Index outputIndex = nextOutputIndex++;
+            if (outputIndex >= outputs.getCount())
+                break;
+
+            auto& output = outputs[outputIndex];
+            output.failed = SLANG_FAILED(File::writeAllBytes(
+                                output.modulePath,
+                                output.moduleBlob->getBufferPointer(),
+                                output.moduleBlob->getBufferSize())) ||
+                            SLANG_FAILED(File::writeAllText(
+                                output.modulePath + ".d",
+                                output.dependencies));
+        }
+    };
+
+    // The calling thread writes files too.
+    std::vector<std::thread> threads;
+    const Count threadCount = getOptionSet().getIntOption(CompilerOptionName::FrontEndThreadCount);
+    const Count workerCount = Math::Min(threadCount, outputs.getCount()) - 1;
+    for (Index i = 0; i < workerCount; ++i)
+        threads.emplace_back(worker);
+    worker();
+    for (auto& thread : threads)
+        thread.join();
+
+    SlangResult result = SLANG_OK;
+    for (const auto& output : outputs)
+    {
+        if (output.failed)
+        {
+            getSink()->diagnose(
+                SourceLoc(),
+                Diagnostics::unableToWriteModuleContainer,
+                output.modulePath);
+            result = SLANG_FAIL;
+        }
+    }
+    return result;
+}
 
 void EndToEndCompileRequest::generateOutput(ComponentType* program)
 {
@@ -2642,6 +2974,13 @@ bool CodeGenContext::shouldReportCheckpointIntermediates()
         CompilerOptionName::ReportCheckpointIntermediates);
 }
 
+bool CodeGenContext::shouldReportIRPassStatistics()
+{
+    auto& optionSet = getTargetProgram()->getOptionSet();
+    return optionSet.getBoolOption(CompilerOptionName::ReportIRPassStatistics) ||
+           optionSet.getStringOption(CompilerOptionName::IRPassStatisticsJSON).getLength() != 0;
+}
+
 bool CodeGenContext::shouldDumpIntermediates()
 {
     return getTargetProgram()->getOptionSet().getBoolOption(CompilerOptionName::DumpIntermediates);
@@ -2672,6 +3011,11 @@ bool CodeGenContext::isSpecializationDisabled()
 
 SLANG_NO_THROW SlangResult SLANG_MCALL Module::serialize(ISlangBlob** outSerializedBlob)
 {
+    auto threadSafetyLock = getLinkage()->lockIfThreadSafe();
+
+    DiagnosticSink sink(getLinkage()->getSourceManager(), Lexer::sourceLocationLexer);
+    getLinkage()->generateCompleteModuleIR(this, &sink);
+
     SerialContainerUtil::WriteOptions writeOptions;
     writeOptions.sourceManager = getLinkage()->getSourceManager();
     OwnedMemoryStream memoryStream(FileAccess::Write);
@@ -2685,6 +3029,11 @@ SLANG_NO_THROW SlangResult SLANG_MCALL Module::serialize(ISlangBlob** outSeriali
 
 SLANG_NO_THROW SlangResult SLANG_MCALL Module::writeToFile(char const* fileName)
 {
+    auto threadSafetyLock = getLinkage()->lockIfThreadSafe();
+
+    DiagnosticSink sink(getLinkage()->getSourceManager(), Lexer::sourceLocationLexer);
+    getLinkage()->generateCompleteModuleIR(this, &sink);
+
     SerialContainerUtil::WriteOptions writeOptions;
     writeOptions.sourceManager = getLinkage()->getSourceManager();
     FileStream fileStream;
@@ -13,6 +13,7 @@
 #include "../core/slang-command-options.h"
 #include "../core/slang-crypto.h"
 #include "../core/slang-file-system.h"
+#include "../core/slang-persistent-cache.h"
 #include "../core/slang-shared-library.h"
 #include "../core/slang-std-writers.h"
 #include "slang-capability.h"
@@ -27,6 +28,9 @@
 #include "slang-syntax.h"
 #include "slang.h"
 
+#include <atomic>
+#include <mutex>
+
 namespace Slang
 {
 struct PathInfo;
@@ -35,9 +39,13 @@ struct SharedSemanticsContext;
 
 class ProgramLayout;
 class PtrType;
+struct IRLinkModuleSymbols;
+struct IRLinkSymbols;
+class IRSpecializationCache;
 class TargetProgram;
 class TargetRequest;
 class TypeLayout;
+struct TypeLayoutCache;
 class Artifact;
 
 enum class CompilerMode
@@ -163,6 +171,8 @@ class EndToEndCompileRequest;
 class FrontEndCompileRequest;
 class Linkage;
 class Module;
+class SerialCompressedIRModule;
+class SerialDeferredIRModule;
 class TranslationUnitRequest;
 
 /// Information collected about global or entry-point shader parameters
@@ -276,6 +286,32 @@ class EntryPoint;
 class ComponentType;
 class ComponentTypeVisitor;
 
+// The `ISlangUnknown` methods for component types. These match `SLANG_REF_OBJECT_IUNKNOWN_ALL`,
+// except that the reference count is changed with the linkage locked if it is thread safe,
+// because component types can then be shared between threads.
+#define SLANG_COMPONENT_TYPE_IUNKNOWN_ALL                        \
+    SLANG_NO_THROW SlangResult SLANG_MCALL queryInterface(       \
+        SlangUUID const& uuid,                                   \
+        void** outObject) SLANG_OVERRIDE                         \
+    {                                                            \
+        void* intf = getInterface(uuid);                         \
+        if (intf)                                                \
+        {                                                        \
+            ComponentType::_addRefThreadSafe();                  \
+            *outObject = intf;                                   \
+            return SLANG_OK;                                     \
+        }                                                        \
+        return SLANG_E_NO_INTERFACE;                             \
+    }                                                            \
+    SLANG_NO_THROW uint32_t SLANG_MCALL addRef() SLANG_OVERRIDE  \
+    {                                                            \
+        return ComponentType::_addRefThreadSafe();               \
+    }                                                            \
+    SLANG_NO_THROW uint32_t SLANG_MCALL release() SLANG_OVERRIDE \
+    {                                                            \
+        return ComponentType::_releaseThreadSafe();              \
+    }
+
 /// Base class for "component types" that represent the pieces a final
 /// shader program gets linked together from.
 ///
@@ -288,9 +324,12 @@ public:
     // ISlangUnknown interface
     //
 
-    SLANG_REF_OBJECT_IUNKNOWN_ALL;
+    SLANG_COMPONENT_TYPE_IUNKNOWN_ALL
     ISlangUnknown* getInterface(Guid const& guid);
 
+    uint32_t _addRefThreadSafe();
+    uint32_t _releaseThreadSafe();
+
     //
     // slang::IComponentType interface
     //
@@ -304,8 +343,22 @@ public:
         slang::IBlob** outCode,
         slang::IBlob** outDiagnostics) SLANG_OVERRIDE;
 
+    SLANG_NO_THROW SlangResult SLANG_MCALL getEntryPointCodes(
+        SlangInt entryPointCount,
+        SlangInt const* entryPointIndices,
+        SlangInt targetIndex,
+        slang::IBlob** outCodes,
+        slang::IBlob** outDiagnostics) SLANG_OVERRIDE;
+
+    /// Get the code `getEntryPointCode` already produced for the entry point, or null.
+    ISlangBlob* findExistingEntryPointCode(SlangInt entryPointIndex, SlangInt targetIndex);
+
     IArtifact* getTargetArtifact(SlangInt targetIndex, slang::IBlob** outDiagnostics);
 
+    /// Build the key that the result of `getTargetCode` is stored under in the linkage's
+    /// compilation cache.
+    void buildTargetCodeHash(DigestBuilder<SHA1>& builder, SlangInt targetIndex);
+
     SLANG_NO_THROW SlangResult SLANG_MCALL getTargetCode(
         SlangInt targetIndex,
         slang::IBlob** outCode,
@@ -384,6 +437,10 @@ public:
     /// The `target` must be a target on the `Linkage` that was used to create this program.
     TargetProgram* getTargetProgram(TargetRequest* target);
 
+    /// Get the symbols of the IR modules linked for this program that are the same for every
+    /// target, finding them the first time they are asked for.
+    IRLinkModuleSymbols* getOrCreateIRLinkModuleSymbols();
+
     /// Update the hash builder with the dependencies for this component type.
     virtual void buildHash(DigestBuilder<SHA1>& builder) = 0;
 
@@ -574,6 +631,7 @@ public:
 
 protected:
     ComponentType(Linkage* linkage);
+    ~ComponentType();
 
 protected:
     Linkage* m_linkage;
@@ -583,6 +641,15 @@ protected:
     // Cache of target-specific programs for each target.
     Dictionary<TargetRequest*, RefPtr<TargetProgram>> m_targetPrograms;
 
+    // The code of each entry point for each target, once `getEntryPointCode` has produced it,
+    // indexed by target and then by entry point. The code is returned from here when it is
+    // asked for again, without going through the `TargetProgram`.
+    List<List<ComPtr<ISlangBlob>>> m_entryPointCodes;
+    std::mutex m_entryPointCodesMutex;
+
+    // The symbols of the IR modules linked for this program, shared by its targets.
+    RefPtr<IRLinkModuleSymbols> m_irLinkModuleSymbols;
+
     // Any types looked up dynamically using `getTypeFromString`
     //
     // TODO: Remove this. Type lookup should only be supported on `Module`s.
@@ -796,6 +863,21 @@ public:
         return Super::getEntryPointCode(entryPointIndex, targetIndex, outCode, outDiagnostics);
     }
 
+    SLANG_NO_THROW SlangResult SLANG_MCALL getEntryPointCodes(
+        SlangInt entryPointCount,
+        SlangInt const* entryPointIndices,
+        SlangInt targetIndex,
+        slang::IBlob** outCodes,
+        slang::IBlob** outDiagnostics) SLANG_OVERRIDE
+    {
+        return Super::getEntryPointCodes(
+            entryPointCount,
+            entryPointIndices,
+            targetIndex,
+            outCodes,
+            outDiagnostics);
+    }
+
     SLANG_NO_THROW SlangResult SLANG_MCALL specialize(
         slang::SpecializationArg const* specializationArgs,
         SlangInt specializationArgCount,
@@ -914,7 +996,7 @@ class EntryPoint : public ComponentType, public slang::IEntryPoint
     typedef ComponentType Super;
 
 public:
-    SLANG_REF_OBJECT_IUNKNOWN_ALL
+    SLANG_COMPONENT_TYPE_IUNKNOWN_ALL
 
     ISlangUnknown* getInterface(const Guid& guid);
 
@@ -941,6 +1023,21 @@ public:
         return Super::getEntryPointCode(entryPointIndex, targetIndex, outCode, outDiagnostics);
     }
 
+    SLANG_NO_THROW SlangResult SLANG_MCALL getEntryPointCodes(
+        SlangInt entryPointCount,
+        SlangInt const* entryPointIndices,
+        SlangInt targetIndex,
+        slang::IBlob** outCodes,
+        slang::IBlob** outDiagnostics) SLANG_OVERRIDE
+    {
+        return Super::getEntryPointCodes(
+            entryPointCount,
+            entryPointIndices,
+            targetIndex,
+            outCodes,
+            outDiagnostics);
+    }
+
     SLANG_NO_THROW SlangResult SLANG_MCALL getTargetCode(
         SlangInt targetIndex,
         slang::IBlob** outCode,
@@ -1188,7 +1285,7 @@ class TypeConformance : public ComponentType, public slang::ITypeConformance
     typedef ComponentType Super;
 
 public:
-    SLANG_REF_OBJECT_IUNKNOWN_ALL
+    SLANG_COMPONENT_TYPE_IUNKNOWN_ALL
 
     ISlangUnknown* getInterface(const Guid& guid);
 
@@ -1220,6 +1317,21 @@ public:
         return Super::getEntryPointCode(entryPointIndex, targetIndex, outCode, outDiagnostics);
     }
 
+    SLANG_NO_THROW SlangResult SLANG_MCALL getEntryPointCodes(
+        SlangInt entryPointCount,
+        SlangInt const* entryPointIndices,
+        SlangInt targetIndex,
+        slang::IBlob** outCodes,
+        slang::IBlob** outDiagnostics) SLANG_OVERRIDE
+    {
+        return Super::getEntryPointCodes(
+            entryPointCount,
+            entryPointIndices,
+            targetIndex,
+            outCodes,
+            outDiagnostics);
+    }
+
     SLANG_NO_THROW SlangResult SLANG_MCALL getTargetCode(
         SlangInt targetIndex,
         slang::IBlob** outCode,
@@ -1400,7 +1512,7 @@ class Module : public ComponentType, public slang::IModule
     typedef ComponentType Super;
 
 public:
-    SLANG_REF_OBJECT_IUNKNOWN_ALL
+    SLANG_COMPONENT_TYPE_IUNKNOWN_ALL
 
     ISlangUnknown* getInterface(const Guid& guid);
 
@@ -1427,6 +1539,21 @@ public:
         return Super::getEntryPointCode(entryPointIndex, targetIndex, outCode, outDiagnostics);
     }
 
+    SLANG_NO_THROW SlangResult SLANG_MCALL getEntryPointCodes(
+        SlangInt entryPointCount,
+        SlangInt const* entryPointIndices,
+        SlangInt targetIndex,
+        slang::IBlob** outCodes,
+        slang::IBlob** outDiagnostics) SLANG_OVERRIDE
+    {
+        return Super::getEntryPointCodes(
+            entryPointCount,
+            entryPointIndices,
+            targetIndex,
+            outCodes,
+            outDiagnostics);
+    }
+
     SLANG_NO_THROW SlangResult SLANG_MCALL getTargetCode(
         SlangInt targetIndex,
         slang::IBlob** outCode,
@@ -1629,12 +1756,13 @@ public:
 
     /// Create a module (initially empty).
     Module(Linkage* linkage, ASTBuilder* astBuilder = nullptr);
+    ~Module();
 
     /// Get the AST for the module (if it has been parsed)
     ModuleDecl* getModuleDecl() { return m_moduleDecl; }
 
     /// The the IR for the module (if it has been generated)
-    IRModule* getIRModule() { return m_irModule; }
+    IRModule* getIRModule();
 
     /// Get the list of other modules this module depends on
     List<Module*> const& getModuleDependencyList()
@@ -1666,7 +1794,43 @@ public:
     ///
     /// This should only be called once, during creation of the module.
     ///
-    void setIRModule(IRModule* irModule) { m_irModule = irModule; }
+    void setIRModule(IRModule* irModule);
+    /// Set the IR for this module to be read from `deferredIRModule` when it's first needed.
+    void setDeferredIRModule(SerialDeferredIRModule* deferredIRModule);
+    SerialDeferredIRModule* getDeferredIRModule() { return m_deferredIRModule; }
+
+    /// Release the IR of this module, keeping it serialized and compressed instead, if nothing
+    /// else refers to it. It is read back the next time the IR is asked for.
+    /// See `CompilerOptionName::CompressIdleModuleIR`.
+    ///
+    /// Holds `Linkage::lockForCodeGen`, so that the IR isn't released while code is being
+    /// generated from it.
+    SlangResult compressIRModule();
+    /// True if the IR of this module is held compressed.
+    bool isIRModuleCompressed();
+
+    /// When the IR of this module was last asked for or set, as nanoseconds of the steady clock.
+    int64_t getLastIRUseTime() { return m_lastIRUseTime; }
+
+    /// Set whether the IR generated for this module only holds the global functions that are
+    /// referenced, see `CompilerOptionName::LowerReferencedFunctionsOnly`.
+    ///
+    /// This is set before each time the IR is generated, and forgets which functions the
+    /// previous IR skipped.
+    void setLowersReferencedFunctionsOnly(bool value);
+    bool lowersReferencedFunctionsOnly() { return m_lowersReferencedFunctionsOnly; }
+
+    /// Note that `decl`, a function of this module, is referenced from checked code or is an
+    /// entry point.
+    void noteFunctionReferenced(Decl* decl);
+
+    /// Should IR generation skip `decl`, a global function or generic function of this module
+    /// that nothing in it has to keep? The functions that are skipped are remembered, so that
+    /// the IR can be generated again if they are referenced later.
+    bool shouldSkipLoweringFunction(Decl* decl);
+
+    /// Has a function that the IR of this module skipped been referenced since?
+    bool isIRMissingReferencedFunctions() { return m_isIRMissingReferencedFunctions; }
 
     Index getEntryPointCount() SLANG_OVERRIDE { return 0; }
     RefPtr<EntryPoint> getEntryPoint(Index index) SLANG_OVERRIDE
@@ -1781,6 +1945,22 @@ private:
 
     // The IR for the module
     RefPtr<IRModule> m_irModule = nullptr;
+    // Set if the IR is read on demand, in which case it holds the IR rather than `m_irModule`.
+    RefPtr<SerialDeferredIRModule> m_deferredIRModule;
+    // Set while the IR is released by `compressIRModule`, in which case `m_irModule` is null.
+    RefPtr<SerialCompressedIRModule> m_compressedIRModule;
+    std::atomic<int64_t> m_lastIRUseTime{0};
+    // Guards `m_irModule` and `m_compressedIRModule`.
+    std::mutex m_compressedIRModuleMutex;
+
+    void _noteIRUsed();
+
+    // The functions referenced from checked code, and the functions the IR skipped because they
+    // weren't, when `m_lowersReferencedFunctionsOnly` is set.
+    bool m_lowersReferencedFunctionsOnly = false;
+    bool m_isIRMissingReferencedFunctions = false;
+    HashSet<Decl*> m_referencedFunctionDecls;
+    HashSet<Decl*> m_unloweredFunctionDecls;
 
     List<ShaderParamInfo> m_shaderParams;
     SpecializationParams m_specializationParams;
@@ -1969,6 +2149,8 @@ public:
 
     TargetRequest(const TargetRequest& other);
 
+    ~TargetRequest();
+
     Linkage* getLinkage() { return linkage; }
 
     Session* getSession();
@@ -2001,6 +2183,14 @@ public:
 
     TypeLayout* getTypeLayout(Type* type, slang::LayoutRules rules);
 
+    /// The layouts of types computed for this target, shared by all the programs linked for it
+    /// whose layouts can't depend on global generic parameters.
+    TypeLayoutCache* getTypeLayoutCache();
+
+    /// The specializations of generic functions made for this target, shared by all the
+    /// programs linked for it when `ShareGenericSpecializations` is set.
+    IRSpecializationCache* getIRSpecializationCache() { return m_irSpecializationCache; }
+
     CompilerOptionSet& getOptionSet() { return optionSet; }
 
     CapabilitySet getTargetCaps();
@@ -2012,6 +2202,8 @@ public:
 private:
     Linkage* linkage = nullptr;
     CompilerOptionSet optionSet;
+    RefPtr<TypeLayoutCache> m_typeLayoutCache;
+    RefPtr<IRSpecializationCache> m_irSpecializationCache;
     CapabilitySet cookedCapabilities;
     RefPtr<HLSLToVulkanLayoutOptions> hlslToVulkanOptions;
 };
@@ -2067,6 +2259,27 @@ struct ContainerTypeKey
     }
 };
 
+/// Identifies the result of specializing a component type with a list of arguments.
+///
+/// The arguments are values created by the AST builder of the linkage, which are
+/// deduplicated, so that equal arguments are the same object.
+struct SpecializedComponentTypeKey
+{
+    ComponentType* base;
+    List<Val*> args;
+    bool operator==(SpecializedComponentTypeKey const& other) const
+    {
+        return base == other.base && args == other.args;
+    }
+    Slang::HashCode getHashCode() const
+    {
+        auto hash = Slang::getHashCode(base);
+        for (auto arg : args)
+            hash = Slang::combineHash(hash, Slang::getHashCode(arg));
+        return hash;
+    }
+};
+
 /// A dictionary of currently loaded modules. Used by `findOrImportModule` to
 /// lookup additional loaded modules.
 typedef Dictionary<Name*, Module*> LoadedModuleDictionary;
@@ -2080,7 +2293,11 @@ enum ModuleBlobType
 struct SerialContainerDataModule;
 
 /// A context for loading and re-using code modules.
-class Linkage : public RefObject, public slang::ISession
+class Linkage : public RefObject,
+                public slang::ISession,
+                public slang::IBatchCompileService_Experimental,
+                public slang::IMemoryStats,
+                public slang::ICompileCancellation
 {
 public:
     SLANG_REF_OBJECT_IUNKNOWN_ALL
@@ -2156,11 +2373,40 @@ public:
     virtual SLANG_NO_THROW bool SLANG_MCALL
     isBinaryModuleUpToDate(const char* modulePath, slang::IBlob* binaryModuleBlob) override;
 
+    // IBatchCompileService_Experimental
+    SLANG_NO_THROW SlangResult SLANG_MCALL compileBatch(
+        slang::BatchCompileItem const* items,
+        SlangInt itemCount,
+        SlangInt threadCount,
+        slang::BatchCompileCallback callback,
+        void* userData) override;
+
+    // IMemoryStats
+    SLANG_NO_THROW SlangResult SLANG_MCALL getMemoryUsage(
+        SlangMemoryCategory category,
+        uint64_t* outCurrentBytes,
+        uint64_t* outPeakBytes) override;
+    SLANG_NO_THROW void SLANG_MCALL resetPeakMemoryUsage() override;
+
+    // ICompileCancellation
+    SLANG_NO_THROW void SLANG_MCALL cancel() override;
+    SLANG_NO_THROW void SLANG_MCALL cancelAfter(uint32_t milliseconds) override;
+    SLANG_NO_THROW void SLANG_MCALL resetCancellation() override;
+    SLANG_NO_THROW bool SLANG_MCALL isCanceled() override;
+
+    /// If the compilations of this linkage are being canceled, report it to `sink` and abort
+    /// compilation with a `CompilationCanceledException`.
+    void checkForCancellation(DiagnosticSink* sink);
+
     // Updates the supplied builder with linkage-related information, which includes preprocessor
     // defines, the compiler version, and other compiler options. This is then merged with the hash
     // produced for the program to produce a key that can be used with the shader cache.
     void buildHash(DigestBuilder<SHA1>& builder, SlangInt targetIndex = -1);
 
+    /// Get the persistent cache for compiled code, or nullptr if
+    /// `CompilerOptionName::CompilationCachePath` isn't set.
+    PersistentCache* getCompilationCache();
+
     void addTarget(slang::TargetDesc const& desc);
     SlangResult addSearchPath(char const* path);
     SlangResult addPreprocessorDefine(char const* name, char const* value);
@@ -2179,6 +2425,38 @@ public:
     /// Get the parent session for this linkage
     Session* getSessionImpl() { return m_session; }
 
+    /// True if the linkage was created with `kSessionFlags_ThreadSafe`.
+    bool isThreadSafe() const { return m_isThreadSafe; }
+    void setThreadSafe(bool isThreadSafe) { m_isThreadSafe = isThreadSafe; }
+
+    /// Lock the linkage for as long as the returned lock is held, if it is thread safe.
+    ///
+    /// All of the front end (loading, checking, specializing, linking and layout) runs with
+    /// this held, so loaded modules can be shared between threads. Code generation holds the
+    /// same lock, see `lockForCodeGen`, so the only work on a linkage that runs concurrently
+    /// is that of downstream compilers.
+    ///
+    std::unique_lock<std::recursive_mutex> lockIfThreadSafe()
+    {
+        if (!m_isThreadSafe)
+            return std::unique_lock<std::recursive_mutex>();
+        return std::unique_lock<std::recursive_mutex>(m_threadSafetyMutex);
+    }
+
+    /// Lock the linkage for code generation, for as long as the returned lock is held.
+    ///
+    /// IR linking, the IR passes and emitting use state owned by the linkage, such as its AST
+    /// builder, name pool, `Val` cache and the IDs used for dynamic dispatch. Code generation
+    /// holds this lock throughout (see `CodeGenContext::Shared`) except while a downstream
+    /// compiler runs (see `CodeGenContext::DownstreamScope`). Unlike `lockIfThreadSafe` it is
+    /// always taken, as the entry points of a single request can be generated on several
+    /// threads, see `CompilerOptionName::DownstreamThreadCount`.
+    ///
+    std::unique_lock<std::recursive_mutex> lockForCodeGen()
+    {
+        return std::unique_lock<std::recursive_mutex>(m_threadSafetyMutex);
+    }
+
     // Information on the targets we are being asked to
     // generate code for.
     List<RefPtr<TargetRequest>> targets;
@@ -2196,19 +2474,75 @@ public:
 
     NamePool* getNamePool() { return &namePool; }
 
+    /// Tokens lexed from included files, shared by the translation units of this linkage.
+    PreprocessorTokenCache* getPreprocessorTokenCache() { return &m_preprocessorTokenCache; }
+    PreprocessorTokenCache m_preprocessorTokenCache;
+
     ASTBuilder* getASTBuilder() { return m_astBuilder; }
 
     RefPtr<ASTBuilder> m_astBuilder;
 
+    /// Counts the memory of the AST builder, and of the IR modules created for this linkage.
+    MemoryAccounting* getMemoryAccounting() { return m_memoryAccounting; }
+
+    /// True if `CompilerOptionName::MemoryBudget` is set, and the memory counted by the
+    /// memory accounting is over it.
+    bool isOverMemoryBudget();
+
+    /// Compress the IR of the loaded modules that hasn't been used for the time set by
+    /// `CompilerOptionName::CompressIdleModuleIR`, if it is set.
+    ///
+    /// This is called when a module is loaded or a composite is created, with the linkage
+    /// locked if it is thread safe, so no IR of the modules is in use at the time.
+    void compressIdleModuleIR();
+
+    RefPtr<MemoryAccounting> m_memoryAccounting;
+
+    std::atomic<bool> m_isCanceled{false};
+    /// When compilations are canceled by `cancelAfter`, as nanoseconds of the steady clock, or
+    /// 0 if they aren't.
+    std::atomic<int64_t> m_cancelTime{0};
+
     // Cache for container types.
     Dictionary<ContainerTypeKey, Type*> m_containerTypes;
 
+    /// Find the result of an earlier `ComponentType::specialize` with `key`, or nullptr.
+    ComponentType* findSpecializedComponentType(SpecializedComponentTypeKey const& key);
+
+    /// Remember `componentType` as the result of specializing with `key`.
+    ///
+    /// Only the `kMaxSpecializedComponentTypeCount` most recently used results are kept, so
+    /// the cache doesn't hold on to every specialization a long-lived session has created.
+    void addSpecializedComponentType(
+        SpecializedComponentTypeKey const& key,
+        ComponentType* componentType);
+
+    static const Count kMaxSpecializedComponentTypeCount = 256;
+
+    struct SpecializedComponentTypeEntry
+    {
+        RefPtr<ComponentType> componentType;
+        /// The value of `m_specializedComponentTypeUseCount` when the entry was last used.
+        uint64_t lastUse = 0;
+    };
+
+    // Cache of the results of `ComponentType::specialize`, so that specializing a component
+    // type with the same arguments again doesn't redo the checking and IR generation.
+    Dictionary<SpecializedComponentTypeKey, SpecializedComponentTypeEntry>
+        m_specializedComponentTypes;
+    uint64_t m_specializedComponentTypeUseCount = 0;
+
     // cache used by type checking, implemented in check.cpp
     TypeCheckingCache* getTypeCheckingCache();
     void destroyTypeCheckingCache();
 
     TypeCheckingCache* m_typeCheckingCache = nullptr;
 
+    bool m_isThreadSafe = false;
+    std::recursive_mutex m_threadSafetyMutex;
+
+    RefPtr<PersistentCache> m_compilationCache;
+
     // Modules that have been dynamically loaded via `import`
     //
     // This is a list of unique modules loaded, in the order they were encountered.
@@ -2229,6 +2563,10 @@ public:
 
     SearchDirectoryList searchDirectoryCache;
 
+    // The index of the search directories, with `IndexSearchDirectories` and the default file
+    // system.
+    RefPtr<SearchDirectoryIndex> m_searchDirectoryIndex;
+
     // The resulting specialized IR module for each entry point request
     List<RefPtr<IRModule>> compiledModules;
 
@@ -2292,15 +2630,33 @@ public:
 
     SourceFile* loadSourceFile(String pathFrom, String path);
 
+    /// Map the precompiled module file at `pathInfo` into memory, for `MapBinaryModules`.
+    SlangResult mapBinaryModuleFile(const PathInfo& pathInfo, ComPtr<ISlangBlob>& outBlob);
+
     void loadParsedModule(
         RefPtr<FrontEndCompileRequest> compileRequest,
         RefPtr<TranslationUnitRequest> translationUnit,
         Name* name,
         PathInfo const& pathInfo);
 
+    /// Forget that `modules` were loaded, so that importing them parses them again.
+    ///
+    /// None of the modules that remain loaded may depend on `modules`.
+    void unloadModules(const HashSet<Module*>& modules);
+
     /// Load a module of the given name.
     Module* loadModule(String const& name);
 
+    /// Generate the IR of the modules imported with
+    /// `CompilerOptionName::LowerReferencedFunctionsOnly` that don't have IR yet, or whose IR
+    /// is missing functions that were referenced after it was generated.
+    void generatePendingModuleIR(DiagnosticSink* sink);
+
+    /// Generate IR with all of the functions of `module`, if it was imported with
+    /// `CompilerOptionName::LowerReferencedFunctionsOnly`, so that it can be serialized or
+    /// precompiled.
+    void generateCompleteModuleIR(Module* module, DiagnosticSink* sink);
+
     bool isBinaryModuleUpToDate(String fromPath, RiffContainer* container);
 
     RefPtr<Module> findOrImportModule(
@@ -2309,6 +2665,12 @@ public:
         DiagnosticSink* sink,
         const LoadedModuleDictionary* loadedModules = nullptr);
 
+    /// With `CompilerOptionName::PrefetchImportedModules`, find the files of the modules named
+    /// by the imports at `loc` that haven't been loaded yet, and read them concurrently into the
+    /// file system of the global session. `findOrImportModule` then finds their contents held
+    /// there, so reading the files overlaps rather than adding up.
+    void prefetchImportedModuleFiles(const List<Name*>& names, SourceLoc const& loc);
+
     void prepareDeserializedModule(
         SerialContainerDataModule& moduleEntry,
         const PathInfo& pathInfo,
@@ -2406,6 +2768,25 @@ private:
     // Any modules currently being imported will be listed here
     ModuleBeingImportedRAII* m_modulesBeingImported = nullptr;
 
+    /// A module imported with `CompilerOptionName::LowerReferencedFunctionsOnly`, with what
+    /// is needed to generate its IR after the import.
+    struct LazilyLoweredModule
+    {
+        RefPtr<FrontEndCompileRequest> frontEndReq;
+        RefPtr<TranslationUnitRequest> translationUnit;
+
+        /// IR that was replaced when the IR was generated again, kept because the linked
+        /// programs of components that used it still refer to it.
+        List<RefPtr<IRModule>> replacedIRModules;
+    };
+    Dictionary<Module*, LazilyLoweredModule> m_lazilyLoweredModules;
+
+    void _generateLazilyLoweredModuleIR(
+        Module* module,
+        LazilyLoweredModule& lazilyLoweredModule,
+        bool lowerReferencedFunctionsOnly,
+        DiagnosticSink* sink);
+
     /// Is the given module in the middle of being imported?
     bool isBeingImported(Module* module);
 
@@ -2439,6 +2820,8 @@ public:
     Session* getSession();
     Linkage* getLinkage() { return m_linkage; }
     DiagnosticSink* getSink() { return m_sink; }
+    /// Replace the sink, for work done on behalf of the request after it has completed.
+    void setSink(DiagnosticSink* sink) { m_sink = sink; }
     SourceManager* getSourceManager() { return getLinkage()->getSourceManager(); }
     NamePool* getNamePool() { return getLinkage()->getNamePool(); }
     ISlangFileSystemExt* getFileSystemExt() { return getLinkage()->getFileSystemExt(); }
@@ -2491,6 +2874,10 @@ public:
     UInt getEntryPointReqCount() { return m_entryPointReqs.getCount(); }
     FrontEndEntryPointRequest* getEntryPointReq(UInt index) { return m_entryPointReqs[index]; }
 
+    /// Lex the source files of all the translation units on up to `threadCount` threads, and
+    /// add their tokens to the linkage's token cache for `parseTranslationUnit` to use.
+    void lexSourceFilesInParallel(Count threadCount);
+
     void parseTranslationUnit(TranslationUnitRequest* translationUnit);
 
     // Perform primary semantic checking on all
@@ -2630,6 +3017,7 @@ class TargetProgram : public RefObject
 {
 public:
     TargetProgram(ComponentType* componentType, TargetRequest* targetReq);
+    ~TargetProgram();
 
     /// Get the underlying program
     ComponentType* getProgram() { return m_program; }
@@ -2692,10 +3080,49 @@ public:
         DiagnosticSink* sink,
         EndToEndCompileRequest* endToEndReq = nullptr);
 
+    /// Create the results for all entry points, using up to `threadCount` threads.
+    ///
+    /// Each entry point is still compiled on its own linked copy of the IR, exactly as
+    /// `_createEntryPointResult` does. Code generation holds `Linkage::lockForCodeGen`, so
+    /// the threads only overlap while downstream compilers run. Diagnostics are reported to
+    /// `sink` in entry point order, so the output does not depend on how the work was
+    /// scheduled.
+    ///
+    void _createEntryPointResultsInParallel(
+        Count threadCount,
+        DiagnosticSink* sink,
+        EndToEndCompileRequest* endToEndReq);
+
+    /// True if the entry points of the program are compiled together, because the
+    /// `BatchEntryPoints` option is set and the target can hold several entry points in one
+    /// artifact.
+    bool shouldBatchEntryPoints();
+
+    /// Create the results for all entry points with a single downstream compile.
+    ///
+    /// The entry points are linked and emitted into one translation unit, and each entry
+    /// point's result is the shared artifact, which the entry points are found in by name.
+    ///
+    void _createBatchedEntryPointResults(
+        DiagnosticSink* sink,
+        EndToEndCompileRequest* endToEndReq = nullptr);
+
+    /// Release the IR module for layout and the symbols found for linking, if the
+    /// `ReleaseIntermediateIR` option is set and the code of the whole program, or of every entry
+    /// point, has been generated. The layout and the generated code are kept, and the IR is
+    /// created again if more code is generated.
+    void _releaseIntermediateIRIfComplete();
+
     RefPtr<IRModule> getOrCreateIRModuleForLayout(DiagnosticSink* sink);
 
     RefPtr<IRModule> getExistingIRModuleForLayout() { return m_irModuleForLayout; }
 
+    /// Get the symbols found in the modules linked for this program, if they were found
+    /// along with `irModuleForLayout`.
+    IRLinkSymbols* getIRLinkSymbols(IRModule* irModuleForLayout);
+
+    void setIRLinkSymbols(IRModule* irModuleForLayout, IRLinkSymbols* linkSymbols);
+
     CompilerOptionSet& getOptionSet() { return m_optionSet; }
 
     HLSLToVulkanLayoutOptions* getHLSLToVulkanLayoutOptions()
@@ -2711,6 +3138,10 @@ public:
 private:
     RefPtr<IRModule> createIRModuleForLayout(DiagnosticSink* sink);
 
+    /// Lock `m_resultMutex` for as long as the returned lock is held, if the linkage is
+    /// thread safe.
+    std::unique_lock<std::mutex> _lockResultsIfThreadSafe();
+
     // The program being compiled or laid out
     ComponentType* m_program;
 
@@ -2729,6 +3160,14 @@ private:
     List<ComPtr<IArtifact>> m_entryPointResults;
 
     RefPtr<IRModule> m_irModuleForLayout;
+
+    // The symbols found in the modules linked for this program, shared by its entry points,
+    // and the IR module for layout they were found along with.
+    RefPtr<IRLinkSymbols> m_irLinkSymbols;
+    RefPtr<IRModule> m_irLinkSymbolsModuleForLayout;
+
+    // Serializes code generation for this program when its linkage is thread safe.
+    std::mutex m_resultMutex;
 };
 
 /// A back-end-specific object to track optional feaures/capabilities/extensions
@@ -2779,6 +3218,7 @@ public:
             , entryPointIndices(entryPointIndices)
             , sink(sink)
             , endToEndReq(endToEndReq)
+            , codeGenLock(targetProgram->getProgram()->getLinkage()->lockForCodeGen())
         {
         }
 
@@ -2790,6 +3230,28 @@ public:
         EntryPointIndices entryPointIndices;
         DiagnosticSink* sink = nullptr;
         EndToEndCompileRequest* endToEndReq = nullptr;
+
+        /// Held for as long as code is being generated, see `Linkage::lockForCodeGen`.
+        std::unique_lock<std::recursive_mutex> codeGenLock;
+    };
+
+    /// Releases the code generation lock of the linkage for as long as it is alive.
+    ///
+    /// Only work that uses nothing but a downstream compiler and data owned by the caller,
+    /// such as invoking the compiler on an artifact, may run in the scope.
+    ///
+    class DownstreamScope
+    {
+    public:
+        explicit DownstreamScope(CodeGenContext* context)
+            : m_lock(context->m_shared->codeGenLock)
+        {
+            m_lock.unlock();
+        }
+        ~DownstreamScope() { m_lock.lock(); }
+
+    private:
+        std::unique_lock<std::recursive_mutex>& m_lock;
     };
 
     CodeGenContext(Shared* shared)
@@ -2857,6 +3319,9 @@ public:
     bool shouldDumpIR();
     bool shouldReportCheckpointIntermediates();
 
+    /// True if per pass IR statistics should be collected by `linkAndOptimizeIR`.
+    bool shouldReportIRPassStatistics();
+
     bool shouldTrackLiveness();
 
     bool shouldDumpIntermediates();
@@ -3188,6 +3653,13 @@ public:
 
     String m_dependencyOutputPath;
 
+    /// If set, each translation unit is written to this directory as a precompiled module with a
+    /// dependency file next to it, and no code is generated.
+    String m_precompiledModuleOutputDir;
+
+    /// Write the modules of the translation units to `m_precompiledModuleOutputDir`
+    SlangResult writePrecompiledModules();
+
     /// Writes the modules in a container to the stream
     SlangResult writeContainerToStream(Stream* stream);
 
@@ -3371,6 +3843,33 @@ protected:
     Dictionary<Pair, PassThroughMode> m_map;
 };
 
+class SerialSharedIRModuleSlot;
+
+/// A serialized core module, and what can be shared between the global sessions in the
+/// process that load it. Once added they're kept until `slang_shutdown`, so their contents
+/// are never released while a session might use them.
+class SharedCoreModule : public RefObject
+{
+public:
+    /// Find the shared core module for the serialized core module `data`, adding it if it's
+    /// the first time it's been loaded.
+    static SharedCoreModule* findOrAdd(const void* data, size_t size);
+    static void freeAll();
+
+    std::mutex mutex;
+    /// The core module's serialized modules, extracted from the archive.
+    ComPtr<ISlangBlob> moduleBlob;
+    /// Once a session has read the core module, the range of builtin source locations it
+    /// used, and a slot for the IR of each module it contains.
+    bool hasIRModuleSlots = false;
+    SourceRange sourceRange;
+    List<RefPtr<SerialSharedIRModuleSlot>> irModuleSlots;
+
+private:
+    static std::mutex s_mutex;
+    static Dictionary<SHA1::Digest, RefPtr<SharedCoreModule>>* s_sharedCoreModules;
+};
+
 class Session : public RefObject, public slang::IGlobalSession
 {
 public:
@@ -3513,8 +4012,19 @@ public:
 
     RefPtr<SharedASTBuilder> m_sharedASTBuilder;
 
+    /// The file system that linkages created without a file system of their own load through.
+    /// It holds the contents of the files it loads, so that the sessions of this global session
+    /// don't each load and hold the files they have in common, such as shared include files.
+    ComPtr<ISlangFileSystemExt> m_sharedFileSystem =
+        ComPtr<ISlangFileSystemExt>(new SharedCacheFileSystem());
+
+    /// The listings of search directories, shared by the linkages that use
+    /// `IndexSearchDirectories`.
+    RefPtr<DirectoryListingCache> m_directoryListingCache = new DirectoryListingCache();
+
     SPIRVCoreGrammarInfo& getSPIRVCoreGrammarInfo()
     {
+        std::lock_guard<std::recursive_mutex> lock(m_codeGenStateMutex);
         if (!spirvCoreGrammarInfo)
             setSPIRVCoreGrammar(nullptr);
         SLANG_ASSERT(spirvCoreGrammarInfo);
@@ -3538,6 +4048,12 @@ public:
         return m_languagePreludes[int(language)];
     }
 
+    /// Get the digest of the prelude associated with the language, computed when it was set
+    const SHA1::Digest& getPreludeDigestForLanguage(SourceLanguage language)
+    {
+        return m_languagePreludeDigests[int(language)];
+    }
+
     /// Get the built in linkage -> handy to get the core module from
     Linkage* getBuiltinLinkage() const { return m_builtinLinkage; }
 
@@ -3555,6 +4071,15 @@ public:
         m_sharedLibraryLoader; ///< The shared library loader (never null)
 
     int m_downstreamCompilerInitialized = 0;
+    /// Guards state the back end creates lazily, such as loaded downstream compilers,
+    /// since code generation may run on several threads at once.
+    std::recursive_mutex m_codeGenStateMutex;
+
+    /// Code generated with `CompilerOptionName::IncrementalCodeGen`, keyed by the hash of the
+    /// linked IR it was generated from and the target options. It is kept here rather than by a
+    /// linkage, so that the sessions created to reload changed modules can reuse the code of the
+    /// programs that the change didn't affect. Guarded by `m_codeGenStateMutex`.
+    Dictionary<SHA1::Digest, ComPtr<IArtifact>> m_incrementalCodeGenArtifacts;
 
     RefPtr<DownstreamCompilerSet>
         m_downstreamCompilerSet; ///< Information about all available downstream compilers.
@@ -3571,7 +4096,8 @@ public:
 private:
     void _initCodeGenTransitionMap();
 
-    SlangResult _readBuiltinModule(ISlangFileSystem* fileSystem, Scope* scope, String moduleName);
+    /// Read the builtin module `moduleName` from the serialized `moduleBlob`.
+    SlangResult _readBuiltinModule(ISlangBlob* moduleBlob, Scope* scope, String moduleName);
 
     SlangResult _loadRequest(EndToEndCompileRequest* request, const void* data, size_t size);
 
@@ -3581,6 +4107,7 @@ private:
     String
         m_downstreamCompilerPaths[int(PassThroughMode::CountOf)]; ///< Paths for each pass through
     String m_languagePreludes[int(SourceLanguage::CountOf)]; ///< Prelude for each source language
+    SHA1::Digest m_languagePreludeDigests[int(SourceLanguage::CountOf)];
     PassThroughMode m_defaultDownstreamCompilers[int(SourceLanguage::CountOf)];
 
     // Describes a conversion from one code gen target (source) to another (target)
@@ -3,40 +3,56 @@
 
 #include "../core/slang-dictionary.h"
 #include "../core/slang-list.h"
-#include "../core/slang-virtual-object-pool.h"
 
 // A pool to allow reuse of common types of containers to avoid
 // frequent resizing and rehashing.
 
 namespace Slang
 {
+// The number of containers of each type allocated at a time.
 static const int kContainerPoolSize = 1024;
 
 template<typename T>
 struct ObjectPool
 {
-    ObjectPool(int maxElementCount)
+    ObjectPool(int blockElementCount)
+        : m_blockElementCount(blockElementCount)
     {
-        m_pool.initPool(maxElementCount);
-        m_objects.setCount(maxElementCount);
     }
-
-    T* getObject()
+    ~ObjectPool()
     {
-        auto id = m_pool.alloc(1);
-        if (id == -1)
-            SLANG_UNEXPECTED("container pool allocation failure.");
-        return &m_objects[id];
+        for (auto block : m_blocks)
+            delete[] block;
     }
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
 
-    void freeObject(T* object)
+    T* getObject()
     {
-        auto id = (int)(object - m_objects.getBuffer());
-        m_pool.free(id, 1);
+        // The pool grows by a block at a time, rather than failing once the objects of the first
+        // block are all in use. Blocks are never freed or moved, as objects handed out must stay
+        // where they are.
+        if (m_freeObjects.getCount() == 0)
+        {
+            T* block = new T[m_blockElementCount];
+            m_blocks.add(block);
+            // Added in reverse, so that objects are handed out in the order they are in the block
+            for (Index i = m_blockElementCount - 1; i >= 0; --i)
+                m_freeObjects.add(block + i);
+        }
+
+        // The object freed last is handed out first, as its storage is the most likely to
+        // still be in the cache.
+        T* object = m_freeObjects.getLast();
+        m_freeObjects.removeLast();
+        return object;
     }
 
-    VirtualObjectPool m_pool;
-    List<T> m_objects;
+    void freeObject(T* object) { m_freeObjects.add(object); }
+
+    Index m_blockElementCount;
+    List<T*> m_blocks;
+    List<T*> m_freeObjects;
 };
 
 struct ContainerPool
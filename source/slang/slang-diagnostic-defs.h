@@ -107,6 +107,8 @@ DIAGNOSTIC(
     outputPathsImplyDifferentFormats,
     "the output paths '$0' and '$1' require different code-generation targets")
 
+DIAGNOSTIC(9, Error, compilationCanceled, "compilation was canceled")
+
 DIAGNOSTIC(
     10,
     Error,
@@ -291,6 +293,7 @@ DIAGNOSTIC(
     "downstream compiler '$0' doesn't support whole program compilation")
 DIAGNOSTIC(102, Note, downstreamCompileTime, "downstream compile time: $0s")
 DIAGNOSTIC(103, Note, performanceBenchmarkResult, "compiler performance benchmark:\n$0")
+DIAGNOSTIC(104, Note, irPassStatisticsResult, "IR pass statistics:\n$0")
 DIAGNOSTIC(99999, Note, noteFailedToLoadDynamicLibrary, "failed to load dynamic library '$0'")
 
 //
@@ -2000,12 +2003,32 @@ DIAGNOSTIC(
     cannotUnrollLoop,
     "loop does not terminate within the limited number of iterations, unrolling is aborted.")
 
+DIAGNOSTIC(
+    40021,
+    Error,
+    loopUnrollBudgetExceeded,
+    "unrolling the loop is aborted after $0 iterations, because they add more than the "
+    "$1 instructions allowed by -loop-unroll-budget.")
+
 DIAGNOSTIC(
     40030,
     Fatal,
     functionNeverReturnsFatal,
     "function '$0' never returns, compilation ceased.")
 
+DIAGNOSTIC(
+    40040,
+    Error,
+    missingProfileCounterBuffer,
+    "-instrument-profile-counters requires a global 'RWStructuredBuffer<uint>' marked "
+    "[ProfileCounters].")
+DIAGNOSTIC(40041, Error, invalidProfileCount, "invalid count '$1' in profile '$0'.")
+DIAGNOSTIC(
+    40042,
+    Warning,
+    profileCountMismatch,
+    "profile '$0' has $1 counts but the program has $2 counters, the profile is ignored.")
+
 // 41000 - IR-level validation issues
 
 DIAGNOSTIC(41000, Warning, unreachableCode, "unreachable code detected")
@@ -2432,6 +2455,7 @@ DIAGNOSTIC(
 DIAGNOSTIC(57001, Warning, spirvOptFailed, "spirv-opt failed. $0")
 DIAGNOSTIC(57002, Error, unknownPatchConstantParameter, "unknown patch constant parameter '$0'.")
 DIAGNOSTIC(57003, Error, unknownTessPartitioning, "unknown tessellation partitioning '$0'.")
+DIAGNOSTIC(57004, Error, spirvLinkFailed, "failed to link precompiled SPIR-V. $0")
 
 // GLSL Compatibility
 DIAGNOSTIC(
@@ -2466,6 +2490,34 @@ DIAGNOSTIC(
 DIAGNOSTIC(-1, Note, reportCheckpointCounter, "$0 bytes ($1) used for a loop counter here:")
 DIAGNOSTIC(-1, Note, reportCheckpointNone, "no checkpoint contexts to report")
 
+// Register pressure reporting
+DIAGNOSTIC(
+    -1,
+    Note,
+    reportRegisterPressure,
+    "at most $1 values are live at once in function '$0' ($2 before scheduling)")
+
+// Groupshared array padding
+DIAGNOSTIC(
+    -1,
+    Note,
+    paddedGroupSharedArray,
+    "padded the rows of groupshared array '$0' from $1 to $2 elements to avoid bank conflicts")
+
+// Optimization remarks
+DIAGNOSTIC(-1, Note, optimizationRemark, "optimization remark [$0]: $1")
+
+// Shader cost reports
+DIAGNOSTIC(-1, Note, reportShaderCost, "static cost of entry point '$0': $1")
+
+// Profile counters
+DIAGNOSTIC(-1, Note, profileCounterForFunction, "profile counter $0 counts the calls to '$1'")
+DIAGNOSTIC(
+    -1,
+    Note,
+    profileCounterForLoop,
+    "profile counter $0 counts the iterations of a loop in '$1'")
+
 // 9xxxx - Documentation generation
 DIAGNOSTIC(
     90001,
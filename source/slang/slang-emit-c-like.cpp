@@ -11,6 +11,7 @@
 #include "slang-ir-entry-point-uniforms.h"
 #include "slang-ir-glsl-legalize.h"
 #include "slang-ir-link.h"
+#include "slang-ir-pass-profile.h"
 #include "slang-ir-restructure-scoping.h"
 #include "slang-ir-specialize-resources.h"
 #include "slang-ir-specialize.h"
@@ -109,6 +110,9 @@ CLikeSourceEmitter::CLikeSourceEmitter(const Desc& desc)
     m_codeGenContext = desc.codeGenContext;
     m_entryPointStage = desc.entryPointStage;
     m_effectiveProfile = desc.effectiveProfile;
+    m_foldsExpressionsAggressively =
+        desc.codeGenContext->getTargetProgram()->getOptionSet().getBoolOption(
+            CompilerOptionName::AggressiveExpressionFolding);
 }
 
 SlangResult CLikeSourceEmitter::init()
@@ -1419,10 +1423,17 @@ bool CLikeSourceEmitter::shouldFoldInstIntoUseSites(IRInst* inst)
     // them to initializer lists, which aren't allowed in
     // general expression contexts.
     //
+    // Targets with constructor expressions can fold them like any other
+    // instruction, except at global scope, where folding would copy
+    // the whole constant into every use.
+    //
     case kIROp_MakeStruct:
     case kIROp_MakeArray:
-    case kIROp_swizzleSet:
     case kIROp_MakeArrayFromElement:
+        if (!canFoldAggregateConstructionIntoUseSites() || as<IRModuleInst>(inst->getParent()))
+            return false;
+        break;
+    case kIROp_swizzleSet:
         return false;
     }
 
@@ -1636,7 +1647,9 @@ bool CLikeSourceEmitter::shouldFoldInstIntoUseSites(IRInst* inst)
         }
     }
 
-    // If this is a call to a ResourceType's member function, don't fold for readability.
+    // If this is a call to a ResourceType's member function, don't fold for readability,
+    // unless the smaller output was asked for.
+    bool isFoldedAggressively = false;
     if (auto call = as<IRCall>(inst))
     {
         auto callee = getResolvedInstForDecorations(call->getCallee());
@@ -1648,14 +1661,15 @@ bool CLikeSourceEmitter::shouldFoldInstIntoUseSites(IRInst* inst)
                 if (funcType->getParamCount() > 0)
                 {
                     auto firstParamType = funcType->getParamType(0);
-                    if (as<IRResourceTypeBase>(firstParamType))
-                        return false;
-                    if (as<IRHLSLStructuredBufferTypeBase>(firstParamType))
-                        return false;
-                    if (as<IRUntypedBufferResourceType>(firstParamType))
-                        return false;
-                    if (as<IRSamplerStateTypeBase>(firstParamType))
-                        return false;
+                    if (as<IRResourceTypeBase>(firstParamType) ||
+                        as<IRHLSLStructuredBufferTypeBase>(firstParamType) ||
+                        as<IRUntypedBufferResourceType>(firstParamType) ||
+                        as<IRSamplerStateTypeBase>(firstParamType))
+                    {
+                        if (!m_foldsExpressionsAggressively)
+                            return false;
+                        isFoldedAggressively = true;
+                    }
                 }
             }
         }
@@ -1683,7 +1697,9 @@ bool CLikeSourceEmitter::shouldFoldInstIntoUseSites(IRInst* inst)
 
     // Now let's look at all the instructions between this instruction
     // and the user. If any of them might have side effects, then lets
-    // bail out now.
+    // bail out now, unless the value of our instruction can't be
+    // changed by them.
+    bool isFoldedPastSideEffects = false;
     for (auto ii = inst->getNextInst(); ii != user; ii = ii->getNextInst())
     {
         if (!ii)
@@ -1694,8 +1710,12 @@ bool CLikeSourceEmitter::shouldFoldInstIntoUseSites(IRInst* inst)
             return false;
         }
 
-        if (ii->mightHaveSideEffects())
-            return false;
+        if (!isFoldedPastSideEffects && ii->mightHaveSideEffects())
+        {
+            if (!m_foldsExpressionsAggressively || !isValueIndependentOfMemory(inst, 8))
+                return false;
+            isFoldedPastSideEffects = true;
+        }
     }
 
     // As a safeguard, we should not allow an instruction that references
@@ -1711,7 +1731,77 @@ bool CLikeSourceEmitter::shouldFoldInstIntoUseSites(IRInst* inst)
 
     // Okay, if we reach this point then the user comes later in
     // the same block, and there are no instructions with side
-    // effects in between, so it seems safe to fold things in.
+    // effects in between that could change its value, so it seems
+    // safe to fold things in.
+    if (isFoldedAggressively || isFoldedPastSideEffects)
+        m_instsFoldedAggressively.add(inst);
+    return true;
+}
+
+bool CLikeSourceEmitter::isValueIndependentOfMemory(IRInst* inst, Index depth)
+{
+    // Only arithmetic on values, and the construction and access of
+    // vectors, matrices and tuples, give the same result wherever they
+    // are evaluated. Anything else might read memory, so that moving
+    // it past a store or a call could change its result.
+    //
+    switch (inst->getOp())
+    {
+    case kIROp_Add:
+    case kIROp_Sub:
+    case kIROp_Mul:
+    case kIROp_Div:
+    case kIROp_IRem:
+    case kIROp_FRem:
+    case kIROp_Lsh:
+    case kIROp_Rsh:
+    case kIROp_Eql:
+    case kIROp_Neq:
+    case kIROp_Greater:
+    case kIROp_Less:
+    case kIROp_Geq:
+    case kIROp_Leq:
+    case kIROp_BitAnd:
+    case kIROp_BitXor:
+    case kIROp_BitOr:
+    case kIROp_And:
+    case kIROp_Or:
+    case kIROp_Neg:
+    case kIROp_Not:
+    case kIROp_BitNot:
+    case kIROp_Select:
+    case kIROp_BitCast:
+    case kIROp_IntCast:
+    case kIROp_FloatCast:
+    case kIROp_CastIntToFloat:
+    case kIROp_CastFloatToInt:
+    case kIROp_MakeVector:
+    case kIROp_MakeVectorFromScalar:
+    case kIROp_MakeMatrix:
+    case kIROp_MakeMatrixFromScalar:
+    case kIROp_MakeTuple:
+    case kIROp_GetTupleElement:
+    case kIROp_FieldExtract:
+    case kIROp_GetElement:
+    case kIROp_swizzle:
+        break;
+    default:
+        return false;
+    }
+
+    // The operands in the same block might be folded into the
+    // instruction in turn, and so must not read memory either.
+    // Operands from other blocks have already been computed.
+    //
+    for (UInt i = 0; i < inst->getOperandCount(); ++i)
+    {
+        auto operand = inst->getOperand(i);
+        if (operand->getParent() != inst->getParent() || as<IRParam>(operand) ||
+            as<IRConstant>(operand))
+            continue;
+        if (depth == 0 || !isValueIndependentOfMemory(operand, depth - 1))
+            return false;
+    }
     return true;
 }
 
@@ -2993,6 +3083,8 @@ void CLikeSourceEmitter::_emitInst(IRInst* inst)
 {
     if (shouldFoldInstIntoUseSites(inst))
     {
+        if (m_instsFoldedAggressively.contains(inst))
+            m_aggressivelyFoldedInstCount++;
         return;
     }
 
@@ -3572,6 +3664,17 @@ void CLikeSourceEmitter::emitFunctionBody(IRGlobalValueWithCode* code)
     // Now emit high-level code from that structured region tree.
     //
     emitRegionTree(regionTree);
+
+    // Report how many temporaries `AggressiveExpressionFolding` saved.
+    auto passProfiler = IRPassProfiler::getProfiler();
+    if (m_aggressivelyFoldedInstCount && passProfiler->isEnabled())
+    {
+        passProfiler->addCounter(
+            "emitSource",
+            "aggressivelyFoldedTemporaries",
+            m_aggressivelyFoldedInstCount);
+    }
+    m_aggressivelyFoldedInstCount = 0;
 }
 
 void CLikeSourceEmitter::emitSimpleFuncParamImpl(IRParam* param)
@@ -310,6 +310,16 @@ public:
 
     virtual bool shouldFoldInstIntoUseSites(IRInst* inst);
 
+    /// Whether the value of `inst` is computed without reading memory, so that it can be
+    /// evaluated after side effects that come before its use. Looks through at most `depth`
+    /// levels of operands that might be folded into it.
+    bool isValueIndependentOfMemory(IRInst* inst, Index depth);
+
+    /// Whether `MakeStruct` and `MakeArray` values are emitted as constructor expressions that
+    /// can be used anywhere an expression can, so that they can be folded into their use sites
+    /// like other instructions instead of always getting a temporary.
+    virtual bool canFoldAggregateConstructionIntoUseSites() { return false; }
+
     void emitOperand(IRInst* inst, EmitOpInfo const& outerPrec)
     {
         emitOperandImpl(inst, outerPrec);
@@ -711,6 +721,15 @@ protected:
     // to use for it when emitting code.
     Dictionary<IRInst*, String> m_mapInstToName;
 
+    // Set by `CompilerOptionName::AggressiveExpressionFolding`.
+    bool m_foldsExpressionsAggressively = false;
+
+    // The instructions that are folded into their use only because of
+    // `m_foldsExpressionsAggressively`, and the number of them whose temporary was
+    // left out of the current function.
+    HashSet<IRInst*> m_instsFoldedAggressively;
+    Int64 m_aggressivelyFoldedInstCount = 0;
+
     OrderedHashSet<IRStringLit*> m_requiredPreludes;
     struct RequiredAfter
     {
@@ -2078,27 +2078,49 @@ void CPPSourceEmitter::_emitEntryPointGroup(
     List<AxisWithSize> axes;
     _calcAxisOrder(sizeAlongAxis, false, axes);
 
+    // If asked to, the inner loop is marked for the downstream compiler to run its threads in
+    // the lanes of SIMD instructions. Each thread of it then gets its own copy of the input, so
+    // that the iterations don't depend on each other through it.
+    //
+    const Int simdWidth =
+        getTargetProgram()->getOptionSet().getIntOption(CompilerOptionName::CPUThreadSIMDWidth);
+    const bool useSIMDLoop = simdWidth > 0 && axes.getCount() > 0;
+
     // Open all the loops
     StringBuilder builder;
     for (Index i = 0; i < axes.getCount(); ++i)
     {
         const auto& axis = axes[i];
+        const bool isSIMDLoop = useSIMDLoop && i == axes.getCount() - 1;
         builder.clear();
         const char elem[2] = {s_xyzwNames[axis.axis], 0};
+        if (isSIMDLoop)
+        {
+            builder << "SLANG_PRELUDE_SIMD_LOOP(" << simdWidth << ")\n";
+        }
         builder << "for (uint32_t " << elem << " = 0; " << elem << " < " << axis.size << "; ++"
                 << elem << ")\n{\n";
         m_writer->emit(builder);
         m_writer->indent();
 
         builder.clear();
-        builder << "threadInput.groupThreadID." << elem << " = " << elem << ";\n";
+        if (isSIMDLoop)
+        {
+            builder << "ComputeThreadVaryingInput laneInput = threadInput;\n";
+            builder << "laneInput.groupThreadID." << elem << " = " << elem << ";\n";
+        }
+        else
+        {
+            builder << "threadInput.groupThreadID." << elem << " = " << elem << ";\n";
+        }
         m_writer->emit(builder);
     }
 
     // just call at inner loop point
     m_writer->emit("_");
     m_writer->emit(funcName);
-    m_writer->emit("(&threadInput, entryPointParams, globalParams);\n");
+    m_writer->emit(useSIMDLoop ? "(&laneInput" : "(&threadInput");
+    m_writer->emit(", entryPointParams, globalParams);\n");
 
     // Close all the loops
     for (Index i = Index(axes.getCount() - 1); i >= 0; --i)
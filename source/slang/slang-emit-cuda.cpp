@@ -198,7 +198,10 @@ SlangResult CUDASourceEmitter::calcTypeName(IRType* type, CodeGenTarget target,
         }
     case kIROp_TensorViewType:
         {
-            out << "TensorView";
+            if (as<IRTensorViewType>(type)->hasContiguousInnermostDim())
+                out << "ContiguousTensorView";
+            else
+                out << "TensorView";
             return SLANG_OK;
         }
     default:
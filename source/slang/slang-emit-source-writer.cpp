@@ -25,6 +25,30 @@ SourceWriter::SourceWriter(
     m_sourceManager = sourceManager;
 }
 
+// Once the current chunk holds at least this many bytes, it is finished at the next end
+// of a line.
+static const Count kChunkSize = 256 * 1024;
+
+String SourceWriter::getContent()
+{
+    if (m_chunks.getCount() == 0)
+        return m_builder.produceString();
+
+    StringBuilder builder;
+    builder.ensureCapacity(getContentLength());
+    for (const auto& chunk : m_chunks)
+        builder.append(chunk);
+    builder.append(m_builder);
+    return builder.produceString();
+}
+
+void SourceWriter::clearContent()
+{
+    m_chunks.clear();
+    m_chunksLength = 0;
+    m_builder.clear();
+}
+
 String SourceWriter::getContentAndClear()
 {
     String content(getContent());
@@ -32,11 +56,41 @@ String SourceWriter::getContentAndClear()
     return content;
 }
 
+void SourceWriter::moveContentAndClear(List<String>& outChunks)
+{
+    for (auto& chunk : m_chunks)
+        outChunks.add(_Move(chunk));
+    if (m_builder.getLength())
+        outChunks.add(m_builder.produceString());
+    clearContent();
+}
+
+void SourceWriter::_finishChunk()
+{
+    // The source location tracking scans the text after `m_currentOutputOffset`, which
+    // needs to be in `m_builder`, so bring it up to date first.
+    if (m_sourceMap)
+    {
+        Index lineIndex, columnIndex;
+        _calcLocation(lineIndex, columnIndex);
+    }
+
+    m_chunksLength += m_builder.getLength();
+    m_chunks.add(m_builder.produceString());
+    m_builder.clear();
+
+    // The output is large, so start the next chunk at its full size.
+    m_builder.ensureCapacity(kChunkSize + kChunkSize / 8);
+}
+
 void SourceWriter::emitRawTextSpan(char const* textBegin, char const* textEnd)
 {
     // TODO(tfoley): Need to make "corelib" not use `int` for pointer-sized things...
     auto len = textEnd - textBegin;
     m_builder.append(textBegin, len);
+
+    if (m_builder.getLength() >= kChunkSize && len && textEnd[-1] == '\n')
+        _finishChunk();
 }
 
 void SourceWriter::emitRawText(char const* text)
@@ -196,32 +250,45 @@ void SourceWriter::emitInt64(int64_t value)
     emit(value);
 }
 
+// Write the decimal digits of `value` to the end of the buffer that ends at `bufferEnd`,
+// and return where they start. Unlike `snprintf`, this doesn't need to parse a format.
+static char* _formatDecimal(uint64_t value, char* bufferEnd)
+{
+    char* cur = bufferEnd;
+    do
+    {
+        *--cur = char('0' + value % 10);
+        value /= 10;
+    } while (value);
+    return cur;
+}
+
 void SourceWriter::emit(Int32 value)
 {
-    char buffer[16];
-    snprintf(buffer, sizeof(buffer), "%" PRId32, value);
-    emit(buffer);
+    emit(Int64(value));
 }
 
 void SourceWriter::emit(Int64 value)
 {
-    char buffer[32];
-    snprintf(buffer, sizeof(buffer), "%" PRId64, value);
-    emit(buffer);
+    char buffer[24];
+    char* end = buffer + SLANG_COUNT_OF(buffer);
+    char* start = _formatDecimal(value < 0 ? 0 - uint64_t(value) : uint64_t(value), end);
+    if (value < 0)
+        *--start = '-';
+    // Digits never contain a new line, so the text doesn't need to be split into lines.
+    _emitTextSpan(start, end);
 }
 
 void SourceWriter::emit(UInt32 value)
 {
-    char buffer[32];
-    snprintf(buffer, sizeof(buffer), "%" PRIu32, value);
-    emit(buffer);
+    emit(UInt64(value));
 }
 
 void SourceWriter::emit(UInt64 value)
 {
-    char buffer[32];
-    snprintf(buffer, sizeof(buffer), "%" PRIu64, value);
-    emit(buffer);
+    char buffer[24];
+    char* end = buffer + SLANG_COUNT_OF(buffer);
+    _emitTextSpan(_formatDecimal(value, end), end);
 }
 
 void SourceWriter::emit(double value)
@@ -552,9 +619,10 @@ void SourceWriter::_emitLineDirective(const HumaneSourceLoc& sourceLocation)
 void SourceWriter::_calcLocation(Index& outLineIndex, Index& outColumnIndex)
 {
     // If there are move chars we need to update
-    if (m_currentOutputOffset < m_builder.getLength())
+    if (m_currentOutputOffset < getContentLength())
     {
-        const char* cur = m_builder.getBuffer() + m_currentOutputOffset;
+        SLANG_ASSERT(m_currentOutputOffset >= m_chunksLength);
+        const char* cur = m_builder.getBuffer() + (m_currentOutputOffset - m_chunksLength);
         const char* end = m_builder.end();
 
         const char* start = cur;
@@ -593,7 +661,7 @@ void SourceWriter::_calcLocation(Index& outLineIndex, Index& outColumnIndex)
         }
 
         // Set the current offset to the end
-        m_currentOutputOffset = m_builder.getLength();
+        m_currentOutputOffset = getContentLength();
 
         // Get the bytes remaining on this line (which may not be complete)
         const UnownedStringSlice lineRemaining(start, m_builder.end());
@@ -1,4 +1,4 @@
-// slang-source-stream.h
+// slang-emit-source-writer.h
 #ifndef SLANG_EMIT_SOURCE_WRITER_H
 #define SLANG_EMIT_SOURCE_WRITER_H
 
@@ -64,11 +64,16 @@ public:
     void advanceToSourceLocationIfValid(const SourceLoc& sourceLocation);
 
     /// Get the content as a string
-    String getContent() { return m_builder.produceString(); }
+    String getContent();
     /// Clear the content
-    void clearContent() { m_builder.clear(); }
+    void clearContent();
     /// Get the content as a string and clear the internal representation
     String getContentAndClear();
+    /// Get the length of the content in bytes
+    Count getContentLength() const { return m_chunksLength + m_builder.getLength(); }
+    /// Add the chunks the content is stored in to `outChunks`, and clear the internal
+    /// representation. The chunks are moved, so no text is copied.
+    void moveContentAndClear(List<String>& outChunks);
 
     /// Get the line directive mode used
     LineDirectiveMode getLineDirectiveMode() const { return m_lineDirectiveMode; }
@@ -104,11 +109,14 @@ protected:
     /// Calculate the current location in the ouput
     void _calcLocation(Index& outLineIndex, Index& outColumnIndex);
 
-    // The string of code we've built so far.
-    // TODO(JS): We could store the text in chunks, and then only sew together into one buffer
-    // when we are done. Doing so would not require copies/reallocs until the full buffer has been
-    // produced. A downside to doing this is that it won't be so simple to debug by trying to
-    // look at the current contents of the buffer
+    /// Move the text in `m_builder` to the end of `m_chunks`
+    void _finishChunk();
+
+    // The text is stored in chunks, so that emitting large outputs doesn't repeatedly
+    // reallocate and copy everything emitted so far. `m_chunks` holds the finished chunks,
+    // which always end at the end of a line, and `m_builder` the text after them.
+    List<String> m_chunks;
+    Count m_chunksLength = 0;
     StringBuilder m_builder;
 
     // Current source position for tracking purposes...
@@ -196,7 +196,7 @@ SpvInst* emitOpDebugTypeFunction(
 {
     static_assert(isSingular<T>);
     static_assert(isPlural<Ts>);
-    return emitInst(
+    return emitInstWithResultTypeMemoized(
         parent,
         inst,
         SpvOpExtInst,
@@ -292,7 +292,7 @@ SpvInst* emitOpDebugTypeArray(
     IRInst* elementCount)
 {
     static_assert(isSingular<T>);
-    return emitInst(
+    return emitInstWithResultTypeMemoized(
         parent,
         inst,
         SpvOpExtInst,
@@ -316,7 +316,7 @@ SpvInst* emitOpDebugTypeBasic(
     IRInst* flags)
 {
     static_assert(isSingular<T>);
-    return emitInst(
+    return emitInstWithResultTypeMemoized(
         parent,
         inst,
         SpvOpExtInst,
@@ -340,7 +340,7 @@ SpvInst* emitOpDebugTypeVector(
     IRInst* elementCount)
 {
     static_assert(isSingular<T>);
-    return emitInst(
+    return emitInstWithResultTypeMemoized(
         parent,
         inst,
         SpvOpExtInst,
@@ -363,7 +363,7 @@ SpvInst* emitOpDebugTypeMatrix(
     IRInst* columnMajor)
 {
     static_assert(isSingular<T>);
-    return emitInst(
+    return emitInstWithResultTypeMemoized(
         parent,
         inst,
         SpvOpExtInst,
@@ -387,7 +387,7 @@ SpvInst* emitOpDebugTypePointer(
     IRInst* flags)
 {
     static_assert(isSingular<T>);
-    return emitInst(
+    return emitInstWithResultTypeMemoized(
         parent,
         inst,
         SpvOpExtInst,
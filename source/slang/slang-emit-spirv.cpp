@@ -134,8 +134,12 @@ public:
     /// Add an instruction to the end of the list of children
     void addInst(SpvInst* inst);
 
-    /// Dump all children, recursively, to a flattened list of SPIR-V words
-    void dumpTo(List<SpvWord>& ioWords);
+    /// Get the number of SPIR-V words all children, recursively, encode to
+    size_t getWordCount() const;
+
+    /// Write all children, recursively, as SPIR-V words starting at `ioCursor`,
+    /// and advance it past them
+    void writeTo(uint8_t*& ioCursor) const;
 
     /// The first child, if any.
     SpvInst* m_firstChild = nullptr;
@@ -209,8 +213,16 @@ struct SpvInst : SpvInstParent
     /// The result <id> produced by this instruction, or zero if it has no result.
     SpvWord id = 0;
 
-    /// Dump the instruction (and any children, recursively) into the flat array of SPIR-V words.
-    void dumpTo(List<SpvWord>& ioWords)
+    /// Get the number of SPIR-V words the instruction (and any children, recursively)
+    /// encodes to.
+    size_t getWordCount() const
+    {
+        return 1 + size_t(operandWordsCount) + SpvInstParent::getWordCount();
+    }
+
+    /// Write the instruction (and any children, recursively) as SPIR-V words
+    /// starting at `ioCursor`, and advance it past them.
+    void writeTo(uint8_t*& ioCursor) const
     {
         // [2.2: Terms]
         //
@@ -225,11 +237,20 @@ struct SpvInst : SpvInstParent
         // > Opcode: The 16 high-order bits are the WordCount of the instruction.
         // >         The 16 low-order bits are the opcode enumerant.
         //
-        ioWords.add(wordCount << 16 | opcode);
+        // The output is a byte buffer with no alignment guarantees, so words
+        // are copied into it rather than stored.
+        //
+        const SpvWord opcodeWord = wordCount << 16 | opcode;
+        ::memcpy(ioCursor, &opcodeWord, sizeof(SpvWord));
+        ioCursor += sizeof(SpvWord);
 
         // The operand words simply follow the opcode word.
         //
-        ioWords.addRange(operandWords, operandWordsCount);
+        if (operandWordsCount)
+        {
+            ::memcpy(ioCursor, operandWords, operandWordsCount * sizeof(SpvWord));
+            ioCursor += operandWordsCount * sizeof(SpvWord);
+        }
 
         // In our representation choice, the children of a
         // parent instruction will always follow the encoded
@@ -238,7 +259,7 @@ struct SpvInst : SpvInstParent
         // * The instructions inside a function always follow the `OpFunction`
         // * The instructions inside a block always follow the `OpLabel`
         //
-        SpvInstParent::dumpTo(ioWords);
+        SpvInstParent::writeTo(ioCursor);
     }
 
     void removeFromParent()
@@ -308,14 +329,127 @@ void SpvInstParent::addInst(SpvInst* inst)
     m_lastChild = inst;
 }
 
-void SpvInstParent::dumpTo(List<SpvWord>& ioWords)
+size_t SpvInstParent::getWordCount() const
 {
+    size_t wordCount = 0;
     for (auto child = m_firstChild; child; child = child->nextSibling)
     {
-        child->dumpTo(ioWords);
+        wordCount += child->getWordCount();
     }
+    return wordCount;
 }
 
+void SpvInstParent::writeTo(uint8_t*& ioCursor) const
+{
+    for (auto child = m_firstChild; child; child = child->nextSibling)
+    {
+        child->writeTo(ioCursor);
+    }
+}
+
+/// Interns the instructions SPIR-V requires to be unique, such as types, by their opcode and
+/// operand words, not counting any result ID.
+///
+/// The table is open addressed with linear probing, and the keys are stored back to back in
+/// one list, so looking up or adding an instruction doesn't allocate per key.
+struct SpvInstInternTable
+{
+    /// Find the instruction interned for `opcode` and `operands`, or nullptr if there is none.
+    SpvInst* find(SpvOp opcode, ConstArrayView<SpvWord> operands) const
+    {
+        if (m_slots.getCount() == 0)
+            return nullptr;
+
+        const HashCode32 hash = _getHash(opcode, operands);
+        const Index mask = m_slots.getCount() - 1;
+        for (Index i = Index(hash) & mask;; i = (i + 1) & mask)
+        {
+            const Slot& slot = m_slots[i];
+            if (!slot.inst)
+                return nullptr;
+            if (slot.hash == hash && _isKeyEqual(slot, opcode, operands))
+                return slot.inst;
+        }
+    }
+
+    /// Intern `inst` for `opcode` and `operands`, which must not have been added before.
+    void add(SpvOp opcode, ConstArrayView<SpvWord> operands, SpvInst* inst)
+    {
+        SLANG_ASSERT(inst);
+
+        // Keep the table at most half full, so probe sequences stay short.
+        if ((m_count + 1) * 2 > m_slots.getCount())
+            _grow();
+
+        Slot slot;
+        slot.hash = _getHash(opcode, operands);
+        slot.keyOffset = uint32_t(m_keyWords.getCount());
+        slot.keyCount = uint32_t(operands.getCount());
+        slot.inst = inst;
+
+        m_keyWords.add(SpvWord(opcode));
+        m_keyWords.addRange(operands.getBuffer(), operands.getCount());
+
+        _insert(slot);
+        m_count++;
+    }
+
+private:
+    struct Slot
+    {
+        HashCode32 hash = 0;
+        // The opcode is stored at `keyOffset`, followed by `keyCount` operand words.
+        uint32_t keyOffset = 0;
+        uint32_t keyCount = 0;
+        // nullptr if the slot is empty.
+        SpvInst* inst = nullptr;
+    };
+
+    static HashCode32 _getHash(SpvOp opcode, ConstArrayView<SpvWord> operands)
+    {
+        const HashCode64 hash = combineHash(
+            Slang::getHashCode(
+                reinterpret_cast<const char*>(operands.getBuffer()),
+                operands.getCount() * sizeof(SpvWord)),
+            HashCode64(opcode));
+        return HashCode32(hash ^ (hash >> 32));
+    }
+
+    bool _isKeyEqual(const Slot& slot, SpvOp opcode, ConstArrayView<SpvWord> operands) const
+    {
+        if (slot.keyCount != uint32_t(operands.getCount()))
+            return false;
+        const SpvWord* key = m_keyWords.getBuffer() + slot.keyOffset;
+        return key[0] == SpvWord(opcode) &&
+               ::memcmp(key + 1, operands.getBuffer(), operands.getCount() * sizeof(SpvWord)) ==
+                   0;
+    }
+
+    void _insert(const Slot& slot)
+    {
+        const Index mask = m_slots.getCount() - 1;
+        Index i = Index(slot.hash) & mask;
+        while (m_slots[i].inst)
+            i = (i + 1) & mask;
+        m_slots[i] = slot;
+    }
+
+    void _grow()
+    {
+        List<Slot> oldSlots = _Move(m_slots);
+        m_slots.setCount(oldSlots.getCount() ? oldSlots.getCount() * 2 : 64);
+        for (const auto& slot : oldSlots)
+        {
+            if (slot.inst)
+                _insert(slot);
+        }
+    }
+
+    List<Slot> m_slots;
+    List<SpvWord> m_keyWords;
+    Count m_count = 0;
+};
+
 /// The context for inlining a SPV assembly snippet.
 struct SpvSnippetEmitContext
 {
@@ -513,42 +647,43 @@ struct SPIRVEmitContext : public SourceEmitterBase, public SPIRVEmitSharedContex
 
     // At the end of emission we need a single linear stream of words,
     // so we will eventually flatten `m_sections` into a single array.
-
-    /// The final array of SPIR-V words that defines the encoded module
-    List<SpvWord> m_words;
+    //
+    // The size of the encoded module is known before anything is written,
+    // so it is written directly into the output with a single allocation,
+    // instead of growing an array of words and then copying that.
 
     /// Emit the concrete words that make up the binary SPIR-V module.
     ///
-    /// This function fills in `m_words` based on the data in `m_sections`.
-    /// This function should only be called once.
+    /// This function appends the module, based on the data in `m_sections`,
+    /// to `ioBytes`. This function should only be called once.
     ///
-    void emitPhysicalLayout()
+    void emitPhysicalLayout(List<uint8_t>& ioBytes)
     {
         // [2.3: Physical Layout of a SPIR-V Module and Instruction]
         //
         // > Magic Number
-        //
-        m_words.add(SpvMagicNumber);
-
         // > Version nuumber
-        //
-        m_words.add(m_spvVersion);
-
         // > Generator's magic number.
-        //
-        m_words.add(kSPIRVSlangCompilerId);
-
         // > Bound
+        // > 0 (Reserved for instruction schema, if needed.)
         //
         // As described above, we use `m_nextID` to allocate
         // <id>s, so its value when we are done emitting code
         // can serve as the bound.
         //
-        m_words.add(m_nextID);
+        const SpvWord header[] =
+            {SpvMagicNumber, m_spvVersion, kSPIRVSlangCompilerId, m_nextID, 0};
 
-        // > 0 (Reserved for instruction schema, if needed.)
-        //
-        m_words.add(0);
+        size_t wordCount = SLANG_COUNT_OF(header);
+        for (int ii = 0; ii < int(SpvLogicalSectionID::Count); ++ii)
+            wordCount += m_sections[ii].getWordCount();
+
+        const Index startOffset = ioBytes.getCount();
+        ioBytes.setCount(startOffset + Index(wordCount * sizeof(SpvWord)));
+        uint8_t* cursor = ioBytes.getBuffer() + startOffset;
+
+        ::memcpy(cursor, header, sizeof(header));
+        cursor += sizeof(header);
 
         // > First word of instruction stream
         // > All remaining words are a linear sequence of instructions.
@@ -558,8 +693,9 @@ struct SPIRVEmitContext : public SourceEmitterBase, public SPIRVEmitSharedContex
         //
         for (int ii = 0; ii < int(SpvLogicalSectionID::Count); ++ii)
         {
-            m_sections[ii].dumpTo(m_words);
+            m_sections[ii].writeTo(cursor);
         }
+        SLANG_ASSERT(cursor == ioBytes.getBuffer() + ioBytes.getCount());
     }
 
     // We will often need to refer to an instrcition by its
@@ -605,6 +741,18 @@ struct SPIRVEmitContext : public SourceEmitterBase, public SPIRVEmitSharedContex
         m_mapIRInstToSpvDebugInst.add(irInst, spvDebugInst);
     }
 
+    /// The names of the functions to emit debug info for, from
+    /// `CompilerOptionName::DebugInfoFunctions`, or empty to emit it for all functions.
+    HashSet<String> m_debugInfoFunctionNames;
+
+    bool shouldEmitDebugInfoForFunction(IRFunc* func)
+    {
+        if (m_debugInfoFunctionNames.getCount() == 0)
+            return true;
+        auto nameHint = func->findDecoration<IRNameHintDecoration>();
+        return nameHint && m_debugInfoFunctionNames.contains(String(nameHint->getName()));
+    }
+
     SpvInst* findDebugScope(IRInst* inst)
     {
         for (auto parent = inst; parent; parent = parent->getParent())
@@ -612,6 +760,14 @@ struct SPIRVEmitContext : public SourceEmitterBase, public SPIRVEmitSharedContex
             if (!as<IRFunc>(parent) && !as<IRModuleInst>(parent))
                 continue;
 
+            // The instructions of a function that doesn't get debug info
+            // have no scope, rather than the scope of the module.
+            if (auto func = as<IRFunc>(parent))
+            {
+                if (!shouldEmitDebugInfoForFunction(func))
+                    return nullptr;
+            }
+
             SpvInst* spvInst = nullptr;
             if (m_mapIRInstToSpvDebugInst.tryGetValue(parent, spvInst))
                 return spvInst;
@@ -673,6 +829,9 @@ struct SPIRVEmitContext : public SourceEmitterBase, public SPIRVEmitSharedContex
     // is set, or we are peeking at some operands to see if we have them memoized
     SpvInst* m_currentInst = nullptr;
     bool m_peekingOperands = false;
+    // Operand stacks left by finished `OperandMemoizeScope`s, kept so that peeking at operands
+    // can reuse their storage.
+    List<List<SpvWord>> m_spareOperandStacks;
 
     // Operands can only be added when inside of a InstConstructScope or...
     struct InstConstructScope
@@ -699,6 +858,12 @@ struct SPIRVEmitContext : public SourceEmitterBase, public SPIRVEmitSharedContex
             : m_context(context)
         {
             m_tmpOperandStack.swapWith(m_context->m_operandStack);
+            auto& spareOperandStacks = m_context->m_spareOperandStacks;
+            if (spareOperandStacks.getCount())
+            {
+                m_context->m_operandStack.swapWith(spareOperandStacks.getLast());
+                spareOperandStacks.removeLast();
+            }
             std::swap(m_tmpPeeking, m_context->m_peekingOperands);
             std::swap(m_tmpInst, m_context->m_currentInst);
         }
@@ -706,6 +871,8 @@ struct SPIRVEmitContext : public SourceEmitterBase, public SPIRVEmitSharedContex
         {
             std::swap(m_tmpInst, m_context->m_currentInst);
             std::swap(m_tmpPeeking, m_context->m_peekingOperands);
+            m_context->m_operandStack.clear();
+            m_context->m_spareOperandStacks.add(_Move(m_context->m_operandStack));
             m_tmpOperandStack.swapWith(m_context->m_operandStack);
         }
 
@@ -1139,38 +1306,75 @@ struct SPIRVEmitContext : public SourceEmitterBase, public SPIRVEmitSharedContex
         {
             auto scopePeek = OperandMemoizeScope(this);
             f();
+
+            // If we have seen this before, return the memoized instruction
+            if (SpvInst* memoized = m_spvTypeInsts.find(opcode, m_operandStack.getArrayView()))
+            {
+                // There could be another different slang IR inst that translates to
+                // the same spir-v inst.
+                // For example, both Ptr<T> and Ref<T> translates to the same pointer
+                // type in spirv.
+                // In this case we need to make sure we also
+                // register `inst` to map it to the memoized spir-v inst.
+                if (irInst)
+                    m_mapIRInstToSpvInst.addIfNotExists(irInst, memoized);
+                return memoized;
+            }
+
             // Steal our operands back, so we don't have to calculate them
             // again
             ourOperands = std::move(m_operandStack);
         }
 
-        // Hash the whole global stack and opcode
-        SpvTypeInstKey key;
-        key.words.add(opcode);
-        key.words.addRange(ourOperands);
+        // Otherwise, we can construct our instruction and record the result
+        InstConstructScope scopeInst(this, opcode, irInst);
+        SpvInst* spvInst = scopeInst;
+        m_spvTypeInsts.add(opcode, ourOperands.getArrayView(), spvInst);
 
-        // If we have seen this before, return the memoized instruction
-        if (SpvInst** memoized = m_spvTypeInsts.tryGetValue(key))
+        // Emit our operands, this time with the resultId too
+        emitOperand(resultId);
+        m_operandStack.addRange(ourOperands);
+
+        parent->addInst(spvInst);
+        return spvInst;
+    }
+
+    // Emits a SPV Inst with a result type, such as an `OpExtInst`, with deduplication.
+    // This is used for the types of NonSemantic.Shader.DebugInfo, which SPIR-V
+    // doesn't require to be unique, but which would otherwise be repeated for
+    // each IR type that translates to them.
+    template<typename T, typename... Operands>
+    SpvInst* emitInstWithResultTypeMemoized(
+        SpvInstParent* parent,
+        IRInst* irInst,
+        SpvOp opcode,
+        const T& idResultType,
+        ResultIDToken resultId,
+        const Operands&... ops)
+    {
+        List<SpvWord> ourOperands;
         {
-            // There could be another different slang IR inst that translates to
-            // the same spir-v inst.
-            // For example, both Ptr<T> and Ref<T> translates to the same pointer
-            // type in spirv.
-            // In this case we need to make sure we also
-            // register `inst` to map it to the memoized spir-v inst.
-            if (irInst)
-                m_mapIRInstToSpvInst.addIfNotExists(irInst, *memoized);
-            return *memoized;
+            auto scopePeek = OperandMemoizeScope(this);
+            emitOperand(idResultType);
+            (emitOperand(ops), ...);
+
+            if (SpvInst* memoized = m_spvTypeInsts.find(opcode, m_operandStack.getArrayView()))
+            {
+                if (irInst)
+                    m_mapIRInstToSpvInst.addIfNotExists(irInst, memoized);
+                return memoized;
+            }
+            ourOperands = std::move(m_operandStack);
         }
 
-        // Otherwise, we can construct our instruction and record the result
         InstConstructScope scopeInst(this, opcode, irInst);
         SpvInst* spvInst = scopeInst;
-        m_spvTypeInsts[key] = spvInst;
+        m_spvTypeInsts.add(opcode, ourOperands.getArrayView(), spvInst);
 
-        // Emit our operands, this time with the resultId too
+        // The result id comes after the result type.
+        m_operandStack.add(ourOperands[0]);
         emitOperand(resultId);
-        m_operandStack.addRange(ourOperands);
+        m_operandStack.addRange(ourOperands.getArrayView(1, ourOperands.getCount() - 1));
 
         parent->addInst(spvInst);
         return spvInst;
@@ -1187,24 +1391,20 @@ struct SPIRVEmitContext : public SourceEmitterBase, public SPIRVEmitSharedContex
         {
             auto scopePeek = OperandMemoizeScope(this);
             f();
+
+            // If we have seen this before, return the memoized instruction
+            if (SpvInst* memoized = m_spvTypeInsts.find(opcode, m_operandStack.getArrayView()))
+                return memoized;
+
             // Steal our operands back, so we don't have to calculate them
             // again
             ourOperands = std::move(m_operandStack);
         }
 
-        // Hash the whole global stack and opcode
-        SpvTypeInstKey key;
-        key.words.add(opcode);
-        key.words.addRange(ourOperands);
-
-        // If we have seen this before, return the memoized instruction
-        if (SpvInst** memoized = m_spvTypeInsts.tryGetValue(key))
-            return *memoized;
-
         // Otherwise, we can construct our instruction and record the result
         InstConstructScope scopeInst(this, opcode, irInst);
         SpvInst* spvInst = scopeInst;
-        m_spvTypeInsts[key] = spvInst;
+        m_spvTypeInsts.add(opcode, ourOperands.getArrayView(), spvInst);
 
         m_operandStack.addRange(ourOperands);
 
@@ -1404,20 +1604,7 @@ struct SPIRVEmitContext : public SourceEmitterBase, public SPIRVEmitSharedContex
         return m_extensionInsts.containsKey(name);
     }
 
-    struct SpvTypeInstKey
-    {
-        List<SpvWord> words;
-        bool operator==(const SpvTypeInstKey& other) const { return words == other.words; }
-        const static bool kHasUniformHash = true;
-        auto getHashCode() const
-        {
-            return Slang::getHashCode(
-                reinterpret_cast<const char*>(words.getBuffer()),
-                words.getCount() * sizeof(SpvWord));
-        }
-    };
-
-    Dictionary<SpvTypeInstKey, SpvInst*> m_spvTypeInsts;
+    SpvInstInternTable m_spvTypeInsts;
 
     bool shouldEmitSPIRVReflectionInfo()
     {
@@ -6899,11 +7086,39 @@ struct SPIRVEmitContext : public SourceEmitterBase, public SPIRVEmitSharedContex
             operands.getView());
     }
 
+    /// The last `DebugLine` emitted, and the block it was emitted into.
+    IRDebugLine* m_lastDebugLine = nullptr;
+    SpvInstParent* m_lastDebugLineParent = nullptr;
+
     SpvInst* emitDebugLine(SpvInstParent* parent, IRDebugLine* debugLine)
     {
         auto scope = findDebugScope(debugLine);
         if (!scope)
             return nullptr;
+
+        // A `DebugLine` applies until the next one or the end of the block, so
+        // there is no need to repeat it for a run of instructions on the same
+        // line. The operands are hoisted IR values, so identical lines have
+        // identical operands.
+        //
+        if (parent == m_lastDebugLineParent && m_lastDebugLine &&
+            m_lastDebugLine->getOperandCount() == debugLine->getOperandCount())
+        {
+            bool isSameLine = true;
+            for (UInt ii = 0; ii < debugLine->getOperandCount(); ++ii)
+            {
+                if (debugLine->getOperand(ii) != m_lastDebugLine->getOperand(ii))
+                {
+                    isSameLine = false;
+                    break;
+                }
+            }
+            if (isSameLine)
+                return nullptr;
+        }
+        m_lastDebugLine = debugLine;
+        m_lastDebugLineParent = parent;
+
         return emitOpDebugLine(
             parent,
             debugLine,
@@ -7865,6 +8080,18 @@ struct SPIRVEmitContext : public SourceEmitterBase, public SPIRVEmitSharedContex
     SPIRVEmitContext(IRModule* module, TargetProgram* program, DiagnosticSink* sink)
         : SPIRVEmitSharedContext(module, program, sink), m_irModule(module), m_memoryArena(2048)
     {
+        for (auto& value :
+             program->getOptionSet().getArray(CompilerOptionName::DebugInfoFunctions))
+        {
+            List<UnownedStringSlice> names;
+            StringUtil::split(value.stringValue.getUnownedSlice(), ',', names);
+            for (auto name : names)
+            {
+                name = name.trim();
+                if (name.getLength())
+                    m_debugInfoFunctionNames.add(String(name));
+            }
+        }
     }
 };
 
@@ -7982,11 +8209,7 @@ SlangResult emitSPIRVFromIR(
 
     context.emitFrontMatter();
 
-    context.emitPhysicalLayout();
-
-    spirvOut.addRange(
-        (uint8_t const*)context.m_words.getBuffer(),
-        context.m_words.getCount() * Index(sizeof(context.m_words[0])));
+    context.emitPhysicalLayout(spirvOut);
 
     return SLANG_OK;
 }
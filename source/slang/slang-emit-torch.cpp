@@ -69,6 +69,23 @@ bool TorchCppSourceEmitter::tryEmitInstStmtImpl(IRInst* inst)
     case kIROp_CudaKernelLaunch:
         {
             m_writer->emit("AT_CUDA_CHECK(cudaLaunchKernel(");
+            // If the kernel has a contiguous variant, it is launched instead when all the
+            // tensors it was specialized for have a contiguous innermost dimension.
+            if (inst->getOperandCount() > 5)
+            {
+                m_writer->emit("(");
+                for (UInt i = 6; i < inst->getOperandCount(); i++)
+                {
+                    if (i > 6)
+                        m_writer->emit(" && ");
+                    m_writer->emit("is_innermost_contiguous(");
+                    emitOperand(inst->getOperand(i), getInfo(EmitOp::General));
+                    m_writer->emit(")");
+                }
+                m_writer->emit(") ? (const void*)(");
+                emitOperand(inst->getOperand(5), getInfo(EmitOp::General));
+                m_writer->emit(") : ");
+            }
             // func
             m_writer->emit("(const void*)(");
             emitOperand(inst->getOperand(0), getInfo(EmitOp::General));
@@ -125,6 +142,15 @@ bool TorchCppSourceEmitter::tryEmitInstExprImpl(IRInst* inst, const EmitOpInfo&
             else
                 m_writer->emit("false");
 
+            // Each place a view is made at gets a cache of its own, the static local of the
+            // lambda, which holds the view made there last.
+            if (getTargetProgram()->getOptionSet().getBoolOption(
+                    CompilerOptionName::CacheTensorViews))
+            {
+                m_writer->emit(", []() -> TensorViewCache& { static thread_local TensorViewCache "
+                               "cache; return cache; }()");
+            }
+
             m_writer->emit(")");
             return true;
         }
@@ -196,7 +222,10 @@ SlangResult TorchCppSourceEmitter::calcTypeName(
         return Super::calcTypeName(type, target, out);
     case kIROp_TensorViewType:
         {
-            out << "TensorView";
+            if (as<IRTensorViewType>(type)->hasContiguousInnermostDim())
+                out << "ContiguousTensorView";
+            else
+                out << "TensorView";
             return SLANG_OK;
         }
     case kIROp_TorchTensorType:
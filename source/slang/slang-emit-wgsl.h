@@ -56,6 +56,7 @@ public:
     void emit(const AddressSpace addressSpace);
 
     virtual bool shouldFoldInstIntoUseSites(IRInst* inst) SLANG_OVERRIDE;
+    virtual bool canFoldAggregateConstructionIntoUseSites() SLANG_OVERRIDE { return true; }
     Dictionary<const char*, IRStringLit*> m_builtinPreludes;
 
 protected:
@@ -29,8 +29,10 @@
 #include "slang-ir-collect-global-uniforms.h"
 #include "slang-ir-com-interface.h"
 #include "slang-ir-composite-reg-to-mem.h"
+#include "slang-ir-content-hash.h"
 #include "slang-ir-dce.h"
 #include "slang-ir-defer-buffer-load.h"
+#include "slang-ir-demote-to-half.h"
 #include "slang-ir-defunctionalization.h"
 #include "slang-ir-diff-call.h"
 #include "slang-ir-dll-export.h"
@@ -57,6 +59,7 @@
 #include "slang-ir-legalize-vector-types.h"
 #include "slang-ir-link.h"
 #include "slang-ir-liveness.h"
+#include "slang-ir-loop-invariant-code-motion.h"
 #include "slang-ir-loop-unroll.h"
 #include "slang-ir-lower-append-consume-structured-buffer.h"
 #include "slang-ir-lower-binding-query.h"
@@ -72,13 +75,19 @@
 #include "slang-ir-lower-tuple-types.h"
 #include "slang-ir-metadata.h"
 #include "slang-ir-metal-legalize.h"
+#include "slang-ir-optimization-remarks.h"
 #include "slang-ir-optix-entry-point-uniforms.h"
+#include "slang-ir-pad-groupshared-arrays.h"
+#include "slang-ir-pass-profile.h"
+#include "slang-ir-profile-guided-optimization.h"
 #include "slang-ir-pytorch-cpp-binding.h"
 #include "slang-ir-redundancy-removal.h"
 #include "slang-ir-resolve-texture-format.h"
 #include "slang-ir-restructure-scoping.h"
 #include "slang-ir-restructure.h"
 #include "slang-ir-sccp.h"
+#include "slang-ir-schedule-insts.h"
+#include "slang-ir-shader-cost.h"
 #include "slang-ir-simplify-for-emit.h"
 #include "slang-ir-specialize-arrays.h"
 #include "slang-ir-specialize-buffer-load-arg.h"
@@ -94,10 +103,12 @@
 #include "slang-ir-strip.h"
 #include "slang-ir-synthesize-active-mask.h"
 #include "slang-ir-translate-glsl-global-var.h"
+#include "slang-ir-trim-uniform-fields.h"
 #include "slang-ir-uniformity.h"
 #include "slang-ir-user-type-hint.h"
 #include "slang-ir-validate.h"
 #include "slang-ir-variable-scope-correction.h"
+#include "slang-ir-vectorize-scalar-ops.h"
 #include "slang-ir-vk-invert-y.h"
 #include "slang-ir-wgsl-legalize.h"
 #include "slang-ir-wrap-structured-buffers.h"
@@ -110,6 +121,7 @@
 #include "slang-visitor.h"
 
 #include <assert.h>
+#include <future>
 
 Slang::String get_slang_cpp_host_prelude();
 Slang::String get_slang_torch_prelude();
@@ -537,6 +549,64 @@ static void unexportNonEmbeddableIR(CodeGenTarget target, IRModule* irModule)
     }
 }
 
+// With incremental code generation, the IR is linked before it is optimized, and the hash of
+// the linked IR is used to look up the code generated for an identical program before.
+//
+// A context whose extension tracker is read by the downstream compile that follows has results
+// other than its artifact, so its code isn't cached.
+//
+static bool _isIncrementalCodeGenEnabled(CodeGenContext* codeGenContext)
+{
+    if (!codeGenContext->getTargetProgram()->getOptionSet().getBoolOption(
+            CompilerOptionName::IncrementalCodeGen))
+        return false;
+    return !codeGenContext->getExtensionTracker() ||
+           codeGenContext->getTargetFormat() == codeGenContext->getFinalTargetFormat();
+}
+
+static SHA1::Digest _getIncrementalCodeGenKey(CodeGenContext* codeGenContext, IRModule* irModule)
+{
+    DigestBuilder<SHA1> builder;
+    builder.append(codeGenContext->getTargetFormat());
+    codeGenContext->getTargetProgram()->getOptionSet().buildHash(builder);
+    buildIRContentHash(irModule, codeGenContext->getSourceManager(), builder);
+    return builder.finalize();
+}
+
+static bool _findIncrementalCodeGenArtifact(
+    CodeGenContext* codeGenContext,
+    SHA1::Digest const& key,
+    ComPtr<IArtifact>& outArtifact)
+{
+    auto session = codeGenContext->getSession();
+    std::lock_guard<std::recursive_mutex> lock(session->m_codeGenStateMutex);
+    return session->m_incrementalCodeGenArtifacts.tryGetValue(key, outArtifact);
+}
+
+static void _addIncrementalCodeGenArtifact(
+    CodeGenContext* codeGenContext,
+    SHA1::Digest const& key,
+    IArtifact* artifact)
+{
+    auto session = codeGenContext->getSession();
+    std::lock_guard<std::recursive_mutex> lock(session->m_codeGenStateMutex);
+    session->m_incrementalCodeGenArtifacts[key] = ComPtr<IArtifact>(artifact);
+}
+
+// Run the IR pass `passFunc` on the arguments that follow, unless compilation has been
+// canceled. When IR pass statistics are requested, the run is timed and its effect on the
+// module recorded under the pass's name (see `IRPassProfileScope`).
+#define SLANG_PASS(passFunc, ...)                              \
+    (codeGenContext->getLinkage()->checkForCancellation(sink), \
+     IRPassProfileScope(passProfiler, irModule, #passFunc),    \
+     passFunc(__VA_ARGS__))
+
+// Record that the optional pass `passFunc` was not run, because only the minimum
+// optimizations were requested, or because it only produces diagnostics and the
+// non-essential validations were disabled.
+#define SLANG_SKIP_PASS(passFunc) \
+    (passProfiler ? passProfiler->recordSkipped(#passFunc) : void())
+
 Result linkAndOptimizeIR(
     CodeGenContext* codeGenContext,
     LinkingAndOptimizationOptions const& options,
@@ -560,10 +630,24 @@ Result linkAndOptimizeIR(
     // modules, and also select between the definitions of
     // any "profile-overloaded" symbols.
     //
-    outLinkedIR = linkIR(codeGenContext);
+    // The caller may have linked the IR already, to look for code generated from it before.
+    //
+    if (!outLinkedIR.module)
+        outLinkedIR = linkIR(codeGenContext);
     auto irModule = outLinkedIR.module;
     auto irEntryPoints = outLinkedIR.entryPoints;
 
+    // The remarks of the passes below are reported when this function returns, including
+    // when a pass fails.
+    OptimizationRemarksScope optimizationRemarksScope(
+        irModule,
+        sink,
+        targetProgram->getOptionSet().getBoolOption(CompilerOptionName::ReportOptimizationRemarks),
+        targetProgram->getOptionSet().getStringOption(CompilerOptionName::OptimizationRemarksFile));
+
+    IRPassProfiler* passProfiler =
+        codeGenContext->shouldReportIRPassStatistics() ? IRPassProfiler::getProfiler() : nullptr;
+
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "LINKED");
 #endif
@@ -580,14 +664,14 @@ Result linkAndOptimizeIR(
     calcRequiredLoweringPassSet(requiredLoweringPassSet, codeGenContext, irModule->getModuleInst());
 
     if (!isKhronosTarget(targetRequest) && requiredLoweringPassSet.glslSSBO)
-        lowerGLSLShaderStorageBufferObjectsToStructuredBuffers(irModule, sink);
+        SLANG_PASS(lowerGLSLShaderStorageBufferObjectsToStructuredBuffers, irModule, sink);
 
     if (requiredLoweringPassSet.glslGlobalVar)
-        translateGLSLGlobalVar(codeGenContext, irModule);
+        SLANG_PASS(translateGLSLGlobalVar, codeGenContext, irModule);
 
     // Replace any global constants with their values.
     //
-    replaceGlobalConstants(irModule);
+    SLANG_PASS(replaceGlobalConstants, irModule);
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "GLOBAL CONSTANTS REPLACED");
 #endif
@@ -602,7 +686,7 @@ Result linkAndOptimizeIR(
     // use sites.
     //
     if (requiredLoweringPassSet.bindExistential)
-        bindExistentialSlots(irModule, sink);
+        SLANG_PASS(bindExistentialSlots, irModule, sink);
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "EXISTENTIALS BOUND");
 #endif
@@ -626,7 +710,7 @@ Result linkAndOptimizeIR(
     // can assume that all ordinary/uniform data is strictly
     // passed using constant buffers.
     //
-    collectGlobalUniformParameters(irModule, outLinkedIR.globalScopeVarLayout);
+    SLANG_PASS(collectGlobalUniformParameters, irModule, outLinkedIR.globalScopeVarLayout);
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "GLOBAL UNIFORMS COLLECTED");
 #endif
@@ -648,7 +732,7 @@ Result linkAndOptimizeIR(
         case CodeGenTarget::HostCPPSource:
             break;
         case CodeGenTarget::CUDASource:
-            collectOptiXEntryPointUniformParams(irModule);
+            SLANG_PASS(collectOptiXEntryPointUniformParams, irModule);
 #if 0
             dumpIRIfEnabled(codeGenContext, irModule, "OPTIX ENTRY POINT UNIFORMS COLLECTED");
 #endif
@@ -659,7 +743,7 @@ Result linkAndOptimizeIR(
             passOptions.alwaysCreateCollectedParam = true;
             [[fallthrough]];
         default:
-            collectEntryPointUniformParams(irModule, passOptions);
+            SLANG_PASS(collectEntryPointUniformParams, irModule, passOptions);
 #if 0
             dumpIRIfEnabled(codeGenContext, irModule, "ENTRY POINT UNIFORMS COLLECTED");
 #endif
@@ -671,7 +755,7 @@ Result linkAndOptimizeIR(
     switch (target)
     {
     default:
-        moveEntryPointUniformParamsToGlobalScope(irModule);
+        SLANG_PASS(moveEntryPointUniformParamsToGlobalScope, irModule);
 #if 0
         dumpIRIfEnabled(codeGenContext, irModule, "ENTRY POINT UNIFORMS MOVED");
 #endif
@@ -684,7 +768,7 @@ Result linkAndOptimizeIR(
     }
 
     if (requiredLoweringPassSet.optionalType)
-        lowerOptionalType(irModule, sink);
+        SLANG_PASS(lowerOptionalType, irModule, sink);
 
     switch (target)
     {
@@ -693,7 +777,7 @@ Result linkAndOptimizeIR(
         break;
 
     default:
-        removeTorchAndCUDAEntryPoints(irModule);
+        SLANG_PASS(removeTorchAndCUDAEntryPoints, irModule);
         break;
     }
 
@@ -702,9 +786,9 @@ Result linkAndOptimizeIR(
     case CodeGenTarget::CPPSource:
     case CodeGenTarget::HostCPPSource:
         {
-            lowerComInterfaces(irModule, artifactDesc.style, sink);
-            generateDllImportFuncs(codeGenContext->getTargetProgram(), irModule, sink);
-            generateDllExportFuncs(irModule, sink);
+            SLANG_PASS(lowerComInterfaces, irModule, artifactDesc.style, sink);
+            SLANG_PASS(generateDllImportFuncs, codeGenContext->getTargetProgram(), irModule, sink);
+            SLANG_PASS(generateDllExportFuncs, irModule, sink);
             break;
         }
     default:
@@ -713,7 +797,7 @@ Result linkAndOptimizeIR(
 
     // Lower `Result<T,E>` types into ordinary struct types.
     if (requiredLoweringPassSet.resultType)
-        lowerResultType(irModule, sink);
+        SLANG_PASS(lowerResultType, irModule, sink);
 
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "UNIONS DESUGARED");
@@ -721,7 +805,7 @@ Result linkAndOptimizeIR(
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
     // Lower all the LValue implict casts (used for out/inout/ref scenarios)
-    lowerLValueCast(targetProgram, irModule);
+    SLANG_PASS(lowerLValueCast, targetProgram, irModule);
 
     IRSimplificationOptions defaultIRSimplificationOptions =
         IRSimplificationOptions::getDefault(targetProgram);
@@ -734,23 +818,25 @@ Result linkAndOptimizeIR(
     deadCodeEliminationOptions.keepGlobalParamsAlive =
         targetProgram->getOptionSet().getBoolOption(CompilerOptionName::PreserveParameters);
 
-    simplifyIR(targetProgram, irModule, defaultIRSimplificationOptions, sink);
+    SLANG_PASS(simplifyIR, targetProgram, irModule, defaultIRSimplificationOptions, sink);
 
     if (targetProgram->getOptionSet().getBoolOption(CompilerOptionName::ValidateUniformity))
     {
-        validateUniformity(irModule, sink);
+        SLANG_PASS(validateUniformity, irModule, sink);
         if (sink->getErrorCount() != 0)
             return SLANG_FAIL;
     }
 
     // Fill in default matrix layout into matrix types that left layout unspecified.
-    specializeMatrixLayout(targetProgram, irModule);
+    SLANG_PASS(specializeMatrixLayout, targetProgram, irModule);
 
     // It's important that this takes place before defunctionalization as we
     // want to be able to easily discover the cooperate and fallback funcitons
     // being passed to saturated_cooperation
     if (!targetProgram->getOptionSet().shouldPerformMinimumOptimizations())
-        fuseCallsToSaturatedCooperation(irModule);
+        SLANG_PASS(fuseCallsToSaturatedCooperation, irModule);
+    else
+        SLANG_SKIP_PASS(fuseCallsToSaturatedCooperation);
 
     switch (target)
     {
@@ -759,7 +845,7 @@ Result linkAndOptimizeIR(
         {
             // Generate any requested derivative wrappers
             if (requiredLoweringPassSet.derivativePyBindWrapper)
-                generateDerivativeWrappers(irModule, sink);
+                SLANG_PASS(generateDerivativeWrappers, irModule, sink);
             break;
         }
     default:
@@ -769,9 +855,32 @@ Result linkAndOptimizeIR(
     if (requiredLoweringPassSet.autodiff)
     {
         // Generate warnings for potentially incorrect or badly-performing autodiff patterns.
-        checkAutodiffPatterns(targetProgram, irModule, sink);
+        if (targetProgram->getOptionSet().shouldRunNonEssentialValidation())
+            SLANG_PASS(checkAutodiffPatterns, targetProgram, irModule, sink);
+        else
+            SLANG_SKIP_PASS(checkAutodiffPatterns);
     }
 
+    // Count the executions of functions and loops for a profile, or use a profile
+    // to select the loops to unroll and the functions to inline. Both happen at the
+    // same point of the pipeline, so that the counters of the instrumented build
+    // identify the same functions and loops as the build that reads the profile.
+    //
+    if (targetProgram->getOptionSet().getBoolOption(CompilerOptionName::InstrumentProfileCounters))
+    {
+        SLANG_PASS(instrumentProfileCounters, irModule, sink);
+    }
+    else if (targetProgram->getOptionSet().hasOption(CompilerOptionName::ProfileCounts))
+    {
+        SLANG_PASS(
+            applyProfileCounts,
+            irModule,
+            targetProgram->getOptionSet().getStringOption(CompilerOptionName::ProfileCounts),
+            sink);
+    }
+    if (sink->getErrorCount() != 0)
+        return SLANG_FAIL;
+
     // Next, we need to ensure that the code we emit for
     // the target doesn't contain any operations that would
     // be illegal on the target platform. For example,
@@ -798,30 +907,39 @@ Result linkAndOptimizeIR(
         bool changed = false;
         dumpIRIfEnabled(codeGenContext, irModule, "BEFORE-SPECIALIZE");
         if (!codeGenContext->isSpecializationDisabled())
-            changed |= specializeModule(targetProgram, irModule, codeGenContext->getSink());
+            changed |= SLANG_PASS(
+                specializeModule,
+                targetProgram,
+                irModule,
+                codeGenContext->getSink());
         if (codeGenContext->getSink()->getErrorCount() != 0)
             return SLANG_FAIL;
         dumpIRIfEnabled(codeGenContext, irModule, "AFTER-SPECIALIZE");
 
         if (changed)
         {
-            applySparseConditionalConstantPropagation(irModule, codeGenContext->getSink());
+            SLANG_PASS(
+                applySparseConditionalConstantPropagation,
+                irModule,
+                codeGenContext->getSink());
         }
         validateIRModuleIfEnabled(codeGenContext, irModule);
 
         // Inline calls to any functions marked with [__unsafeInlineEarly] again,
         // since we may be missing out cases prevented by the functions that we just specialzied.
-        performMandatoryEarlyInlining(irModule);
-        eliminateDeadCode(irModule, deadCodeEliminationOptions);
+        SLANG_PASS(performMandatoryEarlyInlining, irModule);
+        SLANG_PASS(eliminateDeadCode, irModule, deadCodeEliminationOptions);
 
-        // Unroll loops.
-        if (!fastIRSimplificationOptions.minimalOptimization)
+        // Unroll loops. Only the loops marked `[ForceUnroll]` are unrolled, which the
+        // target may need to be valid, so this is done even for minimum optimization.
+        if (codeGenContext->getSink()->getErrorCount() == 0)
         {
-            if (codeGenContext->getSink()->getErrorCount() == 0)
-            {
-                if (!unrollLoopsInModule(targetProgram, irModule, codeGenContext->getSink()))
-                    return SLANG_FAIL;
-            }
+            if (!SLANG_PASS(
+                    unrollLoopsInModule,
+                    targetProgram,
+                    irModule,
+                    codeGenContext->getSink()))
+                return SLANG_FAIL;
         }
 
         // Few of our targets support higher order functions, and
@@ -830,13 +948,13 @@ Result linkAndOptimizeIR(
         // Specialize away these parameters
         // TODO: We should implement a proper defunctionalization pass
         if (requiredLoweringPassSet.higherOrderFunc)
-            changed |= specializeHigherOrderParameters(codeGenContext, irModule);
+            changed |= SLANG_PASS(specializeHigherOrderParameters, codeGenContext, irModule);
 
         if (requiredLoweringPassSet.autodiff)
         {
             dumpIRIfEnabled(codeGenContext, irModule, "BEFORE-AUTODIFF");
             enableIRValidationAtInsert();
-            changed |= processAutodiffCalls(targetProgram, irModule, sink);
+            changed |= SLANG_PASS(processAutodiffCalls, targetProgram, irModule, sink);
             disableIRValidationAtInsert();
             dumpIRIfEnabled(codeGenContext, irModule, "AFTER-AUTODIFF");
         }
@@ -852,25 +970,32 @@ Result linkAndOptimizeIR(
     // Finalization is always run so AD-related instructions can be removed,
     // even the AD pass itself is not run.
     //
-    finalizeAutoDiffPass(targetProgram, irModule);
+    SLANG_PASS(finalizeAutoDiffPass, targetProgram, irModule);
 
-    finalizeSpecialization(irModule);
+    SLANG_PASS(finalizeSpecialization, irModule);
 
     requiredLoweringPassSet = {};
     calcRequiredLoweringPassSet(requiredLoweringPassSet, codeGenContext, irModule->getModuleInst());
 
+    // The CUDA source and the torch host code must agree on the kernel variants they have.
+    bool shouldGenerateContiguousVariants = targetProgram->getOptionSet().getBoolOption(
+        CompilerOptionName::ContiguousTensorVariants);
     switch (target)
     {
     case CodeGenTarget::PyTorchCppBinding:
-        generateHostFunctionsForAutoBindCuda(irModule, sink);
-        lowerBuiltinTypesForKernelEntryPoints(irModule, sink);
-        generatePyTorchCppBinding(irModule, sink);
-        handleAutoBindNames(irModule);
+        if (shouldGenerateContiguousVariants)
+            SLANG_PASS(generateContiguousTensorViewKernelVariants, irModule);
+        SLANG_PASS(generateHostFunctionsForAutoBindCuda, irModule, sink);
+        SLANG_PASS(lowerBuiltinTypesForKernelEntryPoints, irModule, sink);
+        SLANG_PASS(generatePyTorchCppBinding, irModule, sink);
+        SLANG_PASS(handleAutoBindNames, irModule);
         break;
     case CodeGenTarget::CUDASource:
-        lowerBuiltinTypesForKernelEntryPoints(irModule, sink);
-        removeTorchKernels(irModule);
-        handleAutoBindNames(irModule);
+        if (shouldGenerateContiguousVariants)
+            SLANG_PASS(generateContiguousTensorViewKernelVariants, irModule);
+        SLANG_PASS(lowerBuiltinTypesForKernelEntryPoints, irModule, sink);
+        SLANG_PASS(removeTorchKernels, irModule);
+        SLANG_PASS(handleAutoBindNames, irModule);
         break;
     default:
         break;
@@ -878,17 +1003,22 @@ Result linkAndOptimizeIR(
 
     if (codeGenContext->removeAvailableInDownstreamIR)
     {
-        removeAvailableInDownstreamModuleDecorations(target, irModule);
+        SLANG_PASS(removeAvailableInDownstreamModuleDecorations, target, irModule);
     }
 
     if (targetProgram->getOptionSet().shouldRunNonEssentialValidation())
     {
-        checkForRecursiveTypes(irModule, sink);
+        SLANG_PASS(checkForRecursiveTypes, irModule, sink);
 
         // For some targets, we are more restrictive about what types are allowed
         // to be used as shader parameters in ConstantBuffer/ParameterBlock.
         // We will check for these restrictions here.
-        checkForInvalidShaderParameterType(targetRequest, irModule, sink);
+        SLANG_PASS(checkForInvalidShaderParameterType, targetRequest, irModule, sink);
+    }
+    else
+    {
+        SLANG_SKIP_PASS(checkForRecursiveTypes);
+        SLANG_SKIP_PASS(checkForInvalidShaderParameterType);
     }
 
     if (sink->getErrorCount() != 0)
@@ -901,11 +1031,11 @@ Result linkAndOptimizeIR(
     {
         // We could fail because
         // 1) It's not inlinable for some reason (for example if it's recursive)
-        SLANG_RETURN_ON_FAIL(performTypeInlining(irModule, sink));
+        SLANG_RETURN_ON_FAIL(SLANG_PASS(performTypeInlining, irModule, sink));
     }
 
     if (requiredLoweringPassSet.reinterpret)
-        lowerReinterpret(targetProgram, irModule, sink);
+        SLANG_PASS(lowerReinterpret, targetProgram, irModule, sink);
 
     if (sink->getErrorCount() != 0)
         return SLANG_FAIL;
@@ -915,23 +1045,34 @@ Result linkAndOptimizeIR(
     // If we have any witness tables that are marked as `KeepAlive`,
     // but are not used for dynamic dispatch, unpin them so we don't
     // do unnecessary work to lower them.
-    unpinWitnessTables(irModule);
+    SLANG_PASS(unpinWitnessTables, irModule);
 
     if (!fastIRSimplificationOptions.minimalOptimization)
     {
-        simplifyIR(targetProgram, irModule, fastIRSimplificationOptions, sink);
+        SLANG_PASS(simplifyIR, targetProgram, irModule, fastIRSimplificationOptions, sink);
     }
-    else if (requiredLoweringPassSet.generics)
+    else
     {
-        eliminateDeadCode(irModule, fastIRSimplificationOptions.deadCodeElimOptions);
+        SLANG_SKIP_PASS(simplifyIR);
+        if (requiredLoweringPassSet.generics)
+            SLANG_PASS(
+                eliminateDeadCode,
+                irModule,
+                fastIRSimplificationOptions.deadCodeElimOptions);
     }
 
-    if (!ArtifactDescUtil::isCpuLikeTarget(artifactDesc) &&
-        targetProgram->getOptionSet().shouldRunNonEssentialValidation())
+    if (!ArtifactDescUtil::isCpuLikeTarget(artifactDesc))
     {
         // We could fail because (perhaps, somehow) end up with getStringHash that the operand is
         // not a string literal
-        SLANG_RETURN_ON_FAIL(checkGetStringHashInsts(irModule, sink));
+        if (targetProgram->getOptionSet().shouldRunNonEssentialValidation())
+        {
+            SLANG_RETURN_ON_FAIL(SLANG_PASS(checkGetStringHashInsts, irModule, sink));
+        }
+        else
+        {
+            SLANG_SKIP_PASS(checkGetStringHashInsts);
+        }
     }
 
     // For targets that supports dynamic dispatch, we need to lower the
@@ -939,9 +1080,9 @@ Result linkAndOptimizeIR(
     // function pointers.
     dumpIRIfEnabled(codeGenContext, irModule, "BEFORE-LOWER-GENERICS");
     if (requiredLoweringPassSet.generics)
-        lowerGenerics(targetProgram, irModule, sink);
+        SLANG_PASS(lowerGenerics, targetProgram, irModule, sink);
     else
-        cleanupGenerics(targetProgram, irModule, sink);
+        SLANG_PASS(cleanupGenerics, targetProgram, irModule, sink);
     dumpIRIfEnabled(codeGenContext, irModule, "AFTER-LOWER-GENERICS");
 
     if (sink->getErrorCount() != 0)
@@ -952,12 +1093,21 @@ Result linkAndOptimizeIR(
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
     // Inline calls to any functions marked with [__unsafeInlineEarly] or [ForceInline].
-    performForceInlining(irModule);
+    SLANG_PASS(performForceInlining, irModule);
 
     // Push `structuredBufferLoad` to the end of access chain to avoid loading unnecessary data.
     if (isKhronosTarget(targetRequest) || isMetalTarget(targetRequest) ||
         isWGPUTarget(targetRequest))
-        deferBufferLoad(irModule);
+        SLANG_PASS(deferBufferLoad, irModule);
+
+    // Evaluate the arithmetic of functions marked `[PreferHalf]` at half precision, before the
+    // simplification below removes the conversions that are no longer used.
+    if (!isCPUTarget(targetRequest))
+        SLANG_PASS(demoteToHalfPrecision, irModule);
+
+    if (!isCPUTarget(targetRequest) &&
+        targetProgram->getOptionSet().getBoolOption(CompilerOptionName::PadGroupSharedArrays))
+        SLANG_PASS(padGroupSharedArrays, irModule, sink);
 
     // Specialization can introduce dead code that could trip
     // up downstream passes like type legalization, so we
@@ -965,11 +1115,12 @@ Result linkAndOptimizeIR(
     //
     if (fastIRSimplificationOptions.minimalOptimization)
     {
-        eliminateDeadCode(irModule, deadCodeEliminationOptions);
+        SLANG_SKIP_PASS(simplifyIR);
+        SLANG_PASS(eliminateDeadCode, irModule, deadCodeEliminationOptions);
     }
     else
     {
-        simplifyIR(targetProgram, irModule, defaultIRSimplificationOptions, sink);
+        SLANG_PASS(simplifyIR, targetProgram, irModule, defaultIRSimplificationOptions, sink);
     }
 
     validateIRModuleIfEnabled(codeGenContext, irModule);
@@ -979,7 +1130,7 @@ Result linkAndOptimizeIR(
     // of `RWStructuredBuffer` typed fields now.
     if (target != CodeGenTarget::HLSL)
     {
-        lowerAppendConsumeStructuredBuffers(targetProgram, irModule, sink);
+        SLANG_PASS(lowerAppendConsumeStructuredBuffers, targetProgram, irModule, sink);
     }
 
     switch (target)
@@ -994,14 +1145,14 @@ Result linkAndOptimizeIR(
     case CodeGenTarget::MetalLibAssembly:
     case CodeGenTarget::WGSL:
         if (requiredLoweringPassSet.combinedTextureSamplers)
-            lowerCombinedTextureSamplers(codeGenContext, irModule, sink);
+            SLANG_PASS(lowerCombinedTextureSamplers, codeGenContext, irModule, sink);
         break;
     }
 
     if (codeGenContext->getTargetProgram()->getOptionSet().getBoolOption(
             CompilerOptionName::VulkanEmitReflection))
     {
-        addUserTypeHintDecorations(irModule);
+        SLANG_PASS(addUserTypeHintDecorations, irModule);
     }
 
     // We don't need the legalize pass for C/C++ based types
@@ -1034,7 +1185,7 @@ Result linkAndOptimizeIR(
         //
         if (requiredLoweringPassSet.existentialTypeLayout)
         {
-            legalizeExistentialTypeLayout(targetProgram, irModule, sink);
+            SLANG_PASS(legalizeExistentialTypeLayout, targetProgram, irModule, sink);
         }
 
 #if 0
@@ -1053,7 +1204,7 @@ Result linkAndOptimizeIR(
         // What used to be individual variables/parameters/arguments/etc.
         // then become multiple variables/parameters/arguments/etc.
         //
-        legalizeResourceTypes(targetProgram, irModule, sink);
+        SLANG_PASS(legalizeResourceTypes, targetProgram, irModule, sink);
 
         //  Debugging output of legalization
 #if 0
@@ -1065,10 +1216,10 @@ Result linkAndOptimizeIR(
     {
         // On CPU/CUDA targets, we simply elminate any empty types if
         // they are not part of public interface.
-        legalizeEmptyTypes(targetProgram, irModule, sink);
+        SLANG_PASS(legalizeEmptyTypes, targetProgram, irModule, sink);
     }
 
-    legalizeVectorTypes(irModule, sink);
+    SLANG_PASS(legalizeVectorTypes, irModule, sink);
 
     // Once specialization and type legalization have been performed,
     // we should perform some of our basic optimization steps again,
@@ -1076,9 +1227,14 @@ Result linkAndOptimizeIR(
     // (e.g., things that used to be aggregated might now be split up,
     // so that we can work with the individual fields).
     if (fastIRSimplificationOptions.minimalOptimization)
-        eliminateDeadCode(irModule, deadCodeEliminationOptions);
+    {
+        SLANG_SKIP_PASS(simplifyIR);
+        SLANG_PASS(eliminateDeadCode, irModule, deadCodeEliminationOptions);
+    }
     else
-        simplifyIR(targetProgram, irModule, fastIRSimplificationOptions, sink);
+    {
+        SLANG_PASS(simplifyIR, targetProgram, irModule, fastIRSimplificationOptions, sink);
+    }
 
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "AFTER SSA");
@@ -1094,8 +1250,8 @@ Result linkAndOptimizeIR(
     // resource types can be used, so that having them as
     // function parameters, reults, etc. is invalid.
     // We clean up the usages of resource values here.
-    specializeResourceUsage(codeGenContext, irModule);
-    specializeFuncsForBufferLoadArgs(codeGenContext, irModule);
+    SLANG_PASS(specializeResourceUsage, codeGenContext, irModule);
+    SLANG_PASS(specializeFuncsForBufferLoadArgs, codeGenContext, irModule);
 
     // We also want to specialize calls to functions that
     // takes unsized array parameters if possible.
@@ -1103,7 +1259,22 @@ Result linkAndOptimizeIR(
     // that takes arrays/structs containing arrays as parameters with the actual
     // global array object to avoid loading big arrays into SSA registers, which seems
     // to cause performance issues.
-    specializeArrayParameters(codeGenContext, irModule);
+    SLANG_PASS(specializeArrayParameters, codeGenContext, irModule);
+
+    // Now that resources are specialized, indices marked with `NonUniformResourceIndex`
+    // that turn out to be uniform don't need to be treated as non-uniform by the target.
+    // This changes the decorations the code is emitted with, so it is only done at higher
+    // optimization levels, and by default the marking is kept as written.
+    if (!fastIRSimplificationOptions.minimalOptimization &&
+        targetProgram->getOptionSet().getEnumOption<OptimizationLevel>(
+            CompilerOptionName::Optimization) >= OptimizationLevel::High)
+    {
+        SLANG_PASS(removeRedundantNonUniformResourceIndex, irModule);
+    }
+    else
+    {
+        SLANG_SKIP_PASS(removeRedundantNonUniformResourceIndex);
+    }
 
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "AFTER RESOURCE SPECIALIZATION");
@@ -1113,7 +1284,9 @@ Result linkAndOptimizeIR(
 
     // Process `static_assert` after the specialization is done.
     // Some information for `static_assert` is available only after the specialization.
-    checkStaticAssert(irModule->getModuleInst(), sink);
+    // This is not skipped with the non-essential validations: the assertions are part of
+    // the program, and the same walk has to remove them from the module anyway.
+    SLANG_PASS(checkStaticAssert, irModule->getModuleInst(), sink);
 
     // For HLSL (and fxc/dxc) only, we need to "wrap" any
     // structured buffers defined over matrix types so
@@ -1126,7 +1299,7 @@ Result linkAndOptimizeIR(
     {
     case CodeGenTarget::HLSL:
         {
-            wrapStructuredBuffersOfMatrices(irModule);
+            SLANG_PASS(wrapStructuredBuffersOfMatrices, irModule);
 #if 0
             dumpIRIfEnabled(codeGenContext, irModule, "STRUCTURED BUFFERS WRAPPED");
 #endif
@@ -1221,6 +1394,11 @@ Result linkAndOptimizeIR(
         {
         case CodeGenTarget::HLSL:
             {
+                // D3D byte-address buffers can be loaded from in units of up
+                // to four `uint`s at any 4-byte aligned offset.
+                //
+                byteAddressBufferOptions.coalesceStructLoads = true;
+
                 auto profile = codeGenContext->getTargetProgram()->getOptionSet().getProfile();
                 if (profile.getFamily() == ProfileFamily::DX)
                 {
@@ -1242,7 +1420,8 @@ Result linkAndOptimizeIR(
             break;
         }
 
-        legalizeByteAddressBufferOps(
+        SLANG_PASS(
+            legalizeByteAddressBufferOps,
             session,
             targetProgram,
             irModule,
@@ -1259,7 +1438,7 @@ Result linkAndOptimizeIR(
     case CodeGenTarget::CUDASource:
     case CodeGenTarget::PTX:
         {
-            synthesizeActiveMask(irModule, codeGenContext->getSink());
+            SLANG_PASS(synthesizeActiveMask, irModule, codeGenContext->getSink());
 
 #if 0
             dumpIRIfEnabled(codeGenContext, irModule, "AFTER synthesizeActiveMask");
@@ -1277,7 +1456,7 @@ Result linkAndOptimizeIR(
     case CodeGenTarget::GLSL:
     case CodeGenTarget::SPIRV:
     case CodeGenTarget::WGSL:
-        resolveTextureFormat(irModule);
+        SLANG_PASS(resolveTextureFormat, irModule);
         break;
     }
 
@@ -1304,7 +1483,8 @@ Result linkAndOptimizeIR(
             dumpIRIfEnabled(codeGenContext, irModule, "PRE GLSL LEGALIZED");
 #endif
 
-            legalizeEntryPointsForGLSL(
+            SLANG_PASS(
+                legalizeEntryPointsForGLSL,
                 session,
                 irModule,
                 irEntryPoints,
@@ -1321,19 +1501,19 @@ Result linkAndOptimizeIR(
     case CodeGenTarget::MetalLib:
     case CodeGenTarget::MetalLibAssembly:
         {
-            legalizeIRForMetal(irModule, sink);
+            SLANG_PASS(legalizeIRForMetal, irModule, sink);
         }
         break;
     case CodeGenTarget::CSource:
     case CodeGenTarget::CPPSource:
         {
-            legalizeEntryPointVaryingParamsForCPU(irModule, codeGenContext->getSink());
+            SLANG_PASS(legalizeEntryPointVaryingParamsForCPU, irModule, codeGenContext->getSink());
         }
         break;
 
     case CodeGenTarget::CUDASource:
         {
-            legalizeEntryPointVaryingParamsForCUDA(irModule, codeGenContext->getSink());
+            SLANG_PASS(legalizeEntryPointVaryingParamsForCUDA, irModule, codeGenContext->getSink());
         }
         break;
 
@@ -1341,7 +1521,7 @@ Result linkAndOptimizeIR(
     case CodeGenTarget::WGSLSPIRV:
     case CodeGenTarget::WGSLSPIRVAssembly:
         {
-            legalizeIRForWGSL(irModule, sink);
+            SLANG_PASS(legalizeIRForWGSL, irModule, sink);
         }
         break;
 
@@ -1351,11 +1531,11 @@ Result linkAndOptimizeIR(
 
     // Legalize non struct parameters that are expected to be structs for HLSL.
     if (isD3DTarget(targetRequest))
-        legalizeNonStructParameterToStructForHLSL(irModule);
+        SLANG_PASS(legalizeNonStructParameterToStructForHLSL, irModule);
 
     // Create aliases for all dynamic resource parameters.
     if (requiredLoweringPassSet.dynamicResource && isKhronosTarget(targetRequest))
-        legalizeDynamicResourcesForGLSL(codeGenContext, irModule);
+        SLANG_PASS(legalizeDynamicResourcesForGLSL, codeGenContext, irModule);
 
     // Legalize `ImageSubscript` loads.
     switch (target)
@@ -1367,7 +1547,7 @@ Result linkAndOptimizeIR(
     case CodeGenTarget::SPIRV:
     case CodeGenTarget::SPIRVAssembly:
         {
-            legalizeImageSubscript(targetRequest, irModule, sink);
+            SLANG_PASS(legalizeImageSubscript, targetRequest, irModule, sink);
         }
         break;
     default:
@@ -1381,8 +1561,8 @@ Result linkAndOptimizeIR(
     case CodeGenTarget::SPIRV:
     case CodeGenTarget::SPIRVAssembly:
         {
-            legalizeConstantBufferLoadForGLSL(irModule);
-            legalizeDispatchMeshPayloadForGLSL(irModule);
+            SLANG_PASS(legalizeConstantBufferLoadForGLSL, irModule);
+            SLANG_PASS(legalizeDispatchMeshPayloadForGLSL, irModule);
         }
         break;
     default:
@@ -1394,15 +1574,15 @@ Result linkAndOptimizeIR(
     default:
         break;
     case CodeGenTarget::GLSL:
-        moveGlobalVarInitializationToEntryPoints(irModule);
+        SLANG_PASS(moveGlobalVarInitializationToEntryPoints, irModule);
         break;
     // For SPIR-V to SROA across 2 entry-points a value must not be a global
     case CodeGenTarget::SPIRV:
     case CodeGenTarget::SPIRVAssembly:
-        moveGlobalVarInitializationToEntryPoints(irModule);
+        SLANG_PASS(moveGlobalVarInitializationToEntryPoints, irModule);
         if (targetProgram->getOptionSet().getBoolOption(
                 CompilerOptionName::EnableExperimentalPasses))
-            introduceExplicitGlobalContext(irModule, target);
+            SLANG_PASS(introduceExplicitGlobalContext, irModule, target);
 #if 0
         dumpIRIfEnabled(codeGenContext, irModule, "EXPLICIT GLOBAL CONTEXT INTRODUCED");
 #endif
@@ -1410,11 +1590,11 @@ Result linkAndOptimizeIR(
     case CodeGenTarget::Metal:
     case CodeGenTarget::CPPSource:
     case CodeGenTarget::CUDASource:
-        moveGlobalVarInitializationToEntryPoints(irModule);
-        introduceExplicitGlobalContext(irModule, target);
+        SLANG_PASS(moveGlobalVarInitializationToEntryPoints, irModule);
+        SLANG_PASS(introduceExplicitGlobalContext, irModule, target);
         if (target == CodeGenTarget::CPPSource)
         {
-            convertEntryPointPtrParamsToRawPtrs(irModule);
+            SLANG_PASS(convertEntryPointPtrParamsToRawPtrs, irModule);
         }
 #if 0
         dumpIRIfEnabled(codeGenContext, irModule, "EXPLICIT GLOBAL CONTEXT INTRODUCED");
@@ -1423,12 +1603,12 @@ Result linkAndOptimizeIR(
         break;
     }
 
-    stripCachedDictionaries(irModule);
+    SLANG_PASS(stripCachedDictionaries, irModule);
 
     // TODO: our current dynamic dispatch pass will remove all uses of witness tables.
     // If we are going to support function-pointer based, "real" modular dynamic dispatch,
     // we will need to disable this pass.
-    stripWitnessTables(irModule);
+    SLANG_PASS(stripWitnessTables, irModule);
 
     switch (target)
     {
@@ -1437,7 +1617,7 @@ Result linkAndOptimizeIR(
     //
     case CodeGenTarget::SPIRV:
         if (targetProgram->shouldEmitSPIRVDirectly())
-            removeRawDefaultConstructors(irModule);
+            SLANG_PASS(removeRawDefaultConstructors, irModule);
         break;
     default:
         break;
@@ -1456,26 +1636,26 @@ Result linkAndOptimizeIR(
     //
     // We run DCE pass again to clean things up.
     //
-    eliminateDeadCode(irModule, deadCodeEliminationOptions);
+    SLANG_PASS(eliminateDeadCode, irModule, deadCodeEliminationOptions);
 
     if (isKhronosTarget(targetRequest))
     {
         // As a fallback, if the above specialization steps failed to remove resource type
         // parameters, we will inline the functions in question to make sure we can produce valid
         // GLSL.
-        performGLSLResourceReturnFunctionInlining(targetProgram, irModule);
+        SLANG_PASS(performGLSLResourceReturnFunctionInlining, targetProgram, irModule);
     }
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "AFTER DCE");
 #endif
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
-    cleanUpVoidType(irModule);
+    SLANG_PASS(cleanUpVoidType, irModule);
 
     // Lower the `getRegisterIndex` and `getRegisterSpace` intrinsics.
     //
     if (requiredLoweringPassSet.bindingQuery)
-        lowerBindingQueries(irModule, sink);
+        SLANG_PASS(lowerBindingQueries, irModule, sink);
 
     // For some small improvement in type safety we represent these as opaque
     // structs instead of regular arrays.
@@ -1483,48 +1663,112 @@ Result linkAndOptimizeIR(
     // If any have survived this far, change them back to regular (decorated)
     // arrays that the emitters can deal with.
     if (requiredLoweringPassSet.meshOutput)
-        legalizeMeshOutputTypes(irModule);
+        SLANG_PASS(legalizeMeshOutputTypes, irModule);
+
+    // Now that the entry points are specialized and dead code is removed, the fields of the
+    // constant buffers that are still unused will never be read, and can be removed before the
+    // buffers are laid out for the target.
+    //
+    List<ShaderUniformFieldLocation> trimmedUniformFields;
+    if (targetProgram->getOptionSet().getBoolOption(CompilerOptionName::TrimUnusedUniformFields) &&
+        !targetProgram->getOptionSet().getBoolOption(CompilerOptionName::PreserveParameters))
+        SLANG_PASS(trimUnusedUniformFields, targetProgram, irModule, trimmedUniformFields);
 
     BufferElementTypeLoweringOptions bufferElementTypeLoweringOptions;
     bufferElementTypeLoweringOptions.use16ByteArrayElementForConstantBuffer =
         isWGPUTarget(targetRequest);
-    lowerBufferElementTypeToStorageType(targetProgram, irModule, bufferElementTypeLoweringOptions);
+    SLANG_PASS(
+        lowerBufferElementTypeToStorageType,
+        targetProgram,
+        irModule,
+        bufferElementTypeLoweringOptions);
 
     // Rewrite functions that return arrays to return them via `out` parameter,
     // since our target languages doesn't allow returning arrays.
     if (!isMetalTarget(targetRequest))
-        legalizeArrayReturnType(irModule);
+        SLANG_PASS(legalizeArrayReturnType, irModule);
 
     if (isKhronosTarget(targetRequest) || target == CodeGenTarget::HLSL)
     {
-        legalizeUniformBufferLoad(irModule);
+        SLANG_PASS(legalizeUniformBufferLoad, irModule);
         if (targetProgram->getOptionSet().getBoolOption(CompilerOptionName::VulkanInvertY))
-            invertYOfPositionOutput(irModule);
+            SLANG_PASS(invertYOfPositionOutput, irModule);
         if (targetProgram->getOptionSet().getBoolOption(CompilerOptionName::VulkanUseDxPositionW))
-            rcpWOfPositionInput(irModule);
+            SLANG_PASS(rcpWOfPositionInput, irModule);
     }
 
     // Lower all bit_cast operations on complex types into leaf-level
     // bit_cast on basic types.
     if (requiredLoweringPassSet.bitcast)
-        lowerBitCast(targetProgram, irModule, sink);
+        SLANG_PASS(lowerBitCast, targetProgram, irModule, sink);
 
     bool emitSpirvDirectly = targetProgram->shouldEmitSPIRVDirectly();
 
     if (emitSpirvDirectly)
     {
-        performIntrinsicFunctionInlining(irModule);
-        eliminateDeadCode(irModule, deadCodeEliminationOptions);
+        SLANG_PASS(performIntrinsicFunctionInlining, irModule);
+        SLANG_PASS(eliminateDeadCode, irModule, deadCodeEliminationOptions);
     }
-    eliminateMultiLevelBreak(irModule);
+    SLANG_PASS(eliminateMultiLevelBreak, irModule);
 
     if (!fastIRSimplificationOptions.minimalOptimization)
     {
+        // The compilers we hand C++, CUDA, Metal and WGSL source to don't reliably
+        // turn per-component arithmetic back into vector arithmetic, so we do it
+        // before emitting code for them.
+        //
+        if (isCPUTarget(targetRequest) || isCUDATarget(targetRequest) ||
+            isMetalTarget(targetRequest) || isWGPUTarget(targetRequest))
+            SLANG_PASS(vectorizeScalarOps, irModule);
+
         IRSimplificationOptions simplificationOptions = fastIRSimplificationOptions;
         simplificationOptions.cfgOptions.removeTrivialSingleIterationLoops = true;
-        simplifyIR(targetProgram, irModule, simplificationOptions, sink);
+        // No downstream optimizer runs on SPIR-V we emit directly, so values
+        // computed again in dominated blocks need to be reused here. Loads from
+        // structured buffers become indistinguishable from loads from writable
+        // buffers once the SPIR-V legalization lowers them.
+        simplificationOptions.removeRedundancy = emitSpirvDirectly;
+        SLANG_PASS(simplifyIR, targetProgram, irModule, simplificationOptions, sink);
+    }
+    else
+    {
+        SLANG_SKIP_PASS(vectorizeScalarOps);
+        SLANG_SKIP_PASS(simplifyIR);
+    }
+
+    // At higher optimization levels, move computations that don't change between
+    // iterations out of loops, since downstream compilers for text targets don't
+    // reliably do so themselves.
+    //
+    if (targetProgram->getOptionSet().getEnumOption<OptimizationLevel>(
+            CompilerOptionName::Optimization) >= OptimizationLevel::High)
+    {
+        if (!fastIRSimplificationOptions.minimalOptimization)
+            SLANG_PASS(hoistLoopInvariantInsts, irModule);
+        else
+            SLANG_SKIP_PASS(hoistLoopInvariantInsts);
     }
 
+    // Drivers that compile the SPIR-V we emit directly are sensitive to the
+    // number of values live at once, which passes like autodiff and loop
+    // unrolling tend to raise by computing values long before they are used.
+    //
+    if (emitSpirvDirectly && !fastIRSimplificationOptions.minimalOptimization)
+    {
+        bool reportPressure = targetProgram->getOptionSet().getBoolOption(
+            CompilerOptionName::ReportRegisterPressure);
+        SLANG_PASS(scheduleInstsForRegisterPressure, irModule, reportPressure ? sink : nullptr);
+    }
+    else if (emitSpirvDirectly)
+    {
+        SLANG_SKIP_PASS(scheduleInstsForRegisterPressure);
+    }
+
+    // Report the local variables of composite type that are still in memory, before phi
+    // elimination introduces variables of its own.
+    if (irModule->getOptimizationRemarks())
+        SLANG_PASS(addLocalMemoryRemarks, irModule);
+
     // As a late step, we need to take the SSA-form IR and move things *out*
     // of SSA form, by eliminating all "phi nodes" (block parameters) and
     // introducing explicit temporaries instead. Doing this at the IR level
@@ -1557,7 +1801,7 @@ Result linkAndOptimizeIR(
             phiEliminationOptions.eliminateCompositeTypedPhiOnly = false;
             phiEliminationOptions.useRegisterAllocation = true;
         }
-        eliminatePhis(livenessMode, irModule, phiEliminationOptions);
+        SLANG_PASS(eliminatePhis, livenessMode, irModule, phiEliminationOptions);
 #if 0
         dumpIRIfEnabled(codeGenContext, irModule, "PHIS ELIMINATED");
 #endif
@@ -1596,19 +1840,19 @@ Result linkAndOptimizeIR(
     {
         if (isKhronosTarget(targetRequest))
         {
-            applyGLSLLiveness(irModule);
+            SLANG_PASS(applyGLSLLiveness, irModule);
         }
     }
 
     if (isKhronosTarget(targetRequest) && emitSpirvDirectly)
     {
-        replaceLocationIntrinsicsWithRaytracingObject(targetProgram, irModule, sink);
+        SLANG_PASS(replaceLocationIntrinsicsWithRaytracingObject, targetProgram, irModule, sink);
     }
 
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
     // Run a final round of simplifications to clean up unused things after phi-elimination.
-    simplifyNonSSAIR(targetProgram, irModule, fastIRSimplificationOptions);
+    SLANG_PASS(simplifyNonSSAIR, targetProgram, irModule, fastIRSimplificationOptions);
 
     // We include one final step to (optionally) dump the IR and validate
     // it after all of the optimization passes are complete. This should
@@ -1627,7 +1871,7 @@ Result linkAndOptimizeIR(
         // This is a separate pass because it needs to run after
         // all the other optimization passes have been performed.
 
-        applyVariableScopeCorrection(irModule, targetRequest);
+        SLANG_PASS(applyVariableScopeCorrection, irModule, targetRequest);
         validateIRModuleIfEnabled(codeGenContext, irModule);
     }
 
@@ -1636,19 +1880,33 @@ Result linkAndOptimizeIR(
 
     if (targetProgram->getOptionSet().getBoolOption(CompilerOptionName::EmbedDownstreamIR))
     {
-        unexportNonEmbeddableIR(target, irModule);
+        SLANG_PASS(unexportNonEmbeddableIR, target, irModule);
     }
 
-    collectMetadata(irModule, *metadata);
+    SLANG_PASS(collectMetadata, irModule, *metadata);
+    metadata->m_uniformFields = _Move(trimmedUniformFields);
+    SLANG_PASS(
+        collectShaderCosts,
+        targetProgram,
+        irModule,
+        metadata->m_shaderCosts,
+        targetProgram->getOptionSet().getBoolOption(CompilerOptionName::ReportShaderCost)
+            ? sink
+            : nullptr);
 
     outLinkedIR.metadata = metadata;
 
     if (!targetProgram->getOptionSet().shouldPerformMinimumOptimizations())
-        checkUnsupportedInst(codeGenContext->getTargetReq(), irModule, sink);
+        SLANG_PASS(checkUnsupportedInst, codeGenContext->getTargetReq(), irModule, sink);
+    else
+        SLANG_SKIP_PASS(checkUnsupportedInst);
 
     return sink->getErrorCount() == 0 ? SLANG_OK : SLANG_FAIL;
 }
 
+#undef SLANG_SKIP_PASS
+#undef SLANG_PASS
+
 SlangResult CodeGenContext::emitEntryPointsSourceFromIR(ComPtr<IArtifact>& outArtifact)
 {
     SLANG_PROFILE;
@@ -1694,6 +1952,8 @@ SlangResult CodeGenContext::emitEntryPointsSourceFromIR(ComPtr<IArtifact>& outAr
     if (lineDirectiveMode == LineDirectiveMode::SourceMap)
     {
         sourceMap = new BoxValue<SourceMap>;
+        // The map is only ever written out, so encode it as it's emitted
+        SLANG_RETURN_ON_FAIL(sourceMap->getPtr()->setStreamed(true));
     }
 
     SourceWriter sourceWriter(sourceManager, lineDirectiveMode, sourceMap);
@@ -1719,6 +1979,16 @@ SlangResult CodeGenContext::emitEntryPointsSourceFromIR(ComPtr<IArtifact>& outAr
     // reference items in the linkedIR module
     LinkedIR linkedIR;
 
+    SHA1::Digest incrementalCodeGenKey;
+    const bool isIncrementalCodeGen = _isIncrementalCodeGenEnabled(this);
+    if (isIncrementalCodeGen)
+    {
+        linkedIR = linkIR(this);
+        incrementalCodeGenKey = _getIncrementalCodeGenKey(this, linkedIR.module);
+        if (_findIncrementalCodeGenArtifact(this, incrementalCodeGenKey, outArtifact))
+            return SLANG_OK;
+    }
+
     RefPtr<CLikeSourceEmitter> sourceEmitter;
     SourceLanguage sourceLanguage = CLikeSourceEmitter::getSourceLanguage(target);
 
@@ -1811,8 +2081,10 @@ SlangResult CodeGenContext::emitEntryPointsSourceFromIR(ComPtr<IArtifact>& outAr
         sourceEmitter->emitModule(irModule, sink);
     }
 
-    String code = sourceWriter.getContent();
-    sourceWriter.clearContent();
+    // Keep the chunks of the module's code as they are, so that the code is only copied once,
+    // into the final result.
+    List<String> codeChunks;
+    sourceWriter.moveContentAndClear(codeChunks);
 
     // Now that we've emitted the code for all the declarations in the file,
     // it is time to stitch together the final output.
@@ -1868,14 +2140,23 @@ SlangResult CodeGenContext::emitEntryPointsSourceFromIR(ComPtr<IArtifact>& outAr
 
     // Get the content built so far from the front matter/prelude/preModule
     // By getting in this way, the content is no longer referenced by the sourceWriter.
-    String finalResult = sourceWriter.getContentAndClear();
-
-    // Append the modules output code
-    finalResult.append(code);
+    String frontMatter = sourceWriter.getContentAndClear();
 
     // Append all content that should be at the end of a module
     sourceEmitter->emitPostModule();
-    finalResult.append(sourceWriter.getContentAndClear());
+    String postModule = sourceWriter.getContentAndClear();
+
+    // Stitch the parts together in a buffer allocated at its final size.
+    StringBuilder finalResult;
+    Count finalLength = frontMatter.getLength() + postModule.getLength();
+    for (const auto& chunk : codeChunks)
+        finalLength += chunk.getLength();
+    finalResult.ensureCapacity(finalLength);
+
+    finalResult.append(frontMatter);
+    for (const auto& chunk : codeChunks)
+        finalResult.append(chunk);
+    finalResult.append(postModule);
 
     // Write out the result
 
@@ -1896,6 +2177,9 @@ SlangResult CodeGenContext::emitEntryPointsSourceFromIR(ComPtr<IArtifact>& outAr
         artifact->addAssociated(sourceMapArtifact);
     }
 
+    if (isIncrementalCodeGen && sink->getErrorCount() == 0)
+        _addIncrementalCodeGenArtifact(this, incrementalCodeGenKey, artifact);
+
     outArtifact.swap(artifact);
     return SLANG_OK;
 }
@@ -1906,21 +2190,112 @@ SlangResult emitSPIRVFromIR(
     const List<IRFunc*>& irEntryPoints,
     List<uint8_t>& spirvOut);
 
+// Functions that a module precompiled to SPIR-V (see `Module::precompileForTarget`) are emitted
+// as imports, see `removeAvailableInDownstreamModuleDecorations`. Link the precompiled SPIR-V
+// that defines them into `ioSpirv`, leaving it unchanged if there is none.
+static SlangResult _linkPrecompiledSPIRV(CodeGenContext* codeGenContext, List<uint8_t>& ioSpirv)
+{
+    List<ComPtr<IArtifact>> modules;
+    codeGenContext->getProgram()->enumerateIRModules(
+        [&](IRModule* irModule)
+        {
+            for (auto globalInst : irModule->getModuleInst()->getChildren())
+            {
+                auto inst = as<IREmbeddedDownstreamIR>(globalInst);
+                if (!inst || inst->getTarget() != CodeGenTarget::SPIRV)
+                    continue;
+
+                auto module = ArtifactUtil::createArtifactForCompileTarget(SLANG_SPIRV);
+                module->addRepresentationUnknown(
+                    StringBlob::create(inst->getBlob()->getStringSlice()));
+                modules.add(module);
+            }
+        });
+    if (modules.getCount() == 0)
+        return SLANG_OK;
+
+    auto sink = codeGenContext->getSink();
+    IDownstreamCompiler* compiler =
+        codeGenContext->getSession()->getOrLoadDownstreamCompiler(PassThroughMode::SpirvOpt, sink);
+    if (!compiler)
+    {
+        sink->diagnose(SourceLoc(), Diagnostics::spirvLinkFailed, "spirv-opt is not available.");
+        return SLANG_FAIL;
+    }
+
+    // The emitted module goes first, so the linked module keeps its header.
+    auto emitted = ArtifactUtil::createArtifactForCompileTarget(SLANG_SPIRV);
+    emitted->addRepresentationUnknown(ListBlob::moveCreate(ioSpirv));
+
+    List<IArtifact*> linkInputs;
+    linkInputs.add(emitted);
+    for (auto& module : modules)
+        linkInputs.add(module);
+
+    ComPtr<IArtifact> linked;
+    SlangResult linkResult;
+    {
+        CodeGenContext::DownstreamScope downstreamScope(codeGenContext);
+        linkResult = compiler->link(
+            makeSlice(linkInputs.getBuffer(), linkInputs.getCount()),
+            linked.writeRef());
+    }
+    if (SLANG_FAILED(linkResult))
+    {
+        sink->diagnose(
+            SourceLoc(),
+            Diagnostics::spirvLinkFailed,
+            "spirv-opt doesn't support linking.");
+        return linkResult;
+    }
+    SLANG_RETURN_ON_FAIL(passthroughDownstreamDiagnostics(sink, compiler, linked));
+
+    ComPtr<ISlangBlob> blob;
+    SLANG_RETURN_ON_FAIL(linked->loadBlob(ArtifactKeep::No, blob.writeRef()));
+    ioSpirv.setCount(Index(blob->getBufferSize()));
+    memcpy(ioSpirv.getBuffer(), blob->getBufferPointer(), blob->getBufferSize());
+    return SLANG_OK;
+}
+
 SlangResult emitSPIRVForEntryPointsDirectly(
     CodeGenContext* codeGenContext,
     ComPtr<IArtifact>& outArtifact)
 {
     // Outside because we want to keep IR in scope whilst we are processing emits
     LinkedIR linkedIR;
+
+    SHA1::Digest incrementalCodeGenKey;
+    const bool isIncrementalCodeGen = _isIncrementalCodeGenEnabled(codeGenContext);
+    if (isIncrementalCodeGen)
+    {
+        linkedIR = linkIR(codeGenContext);
+        incrementalCodeGenKey = _getIncrementalCodeGenKey(codeGenContext, linkedIR.module);
+        if (_findIncrementalCodeGenArtifact(codeGenContext, incrementalCodeGenKey, outArtifact))
+            return SLANG_OK;
+    }
+
     LinkingAndOptimizationOptions linkingAndOptimizationOptions;
     SLANG_RETURN_ON_FAIL(
         linkAndOptimizeIR(codeGenContext, linkingAndOptimizationOptions, linkedIR));
 
-    auto irModule = linkedIR.module;
-    auto irEntryPoints = linkedIR.entryPoints;
-
     List<uint8_t> spirv, outSpirv;
-    emitSPIRVFromIR(codeGenContext, irModule, irEntryPoints, spirv);
+    emitSPIRVFromIR(codeGenContext, linkedIR.module, linkedIR.entryPoints, spirv);
+
+    // The linked IR is no longer needed once the SPIR-V has been emitted, so when the session is
+    // over its memory budget it is released before spirv-opt is run, rather than after.
+    if (codeGenContext->getLinkage()->isOverMemoryBudget())
+    {
+        linkedIR.module = nullptr;
+        linkedIR.entryPoints = List<IRFunc*>();
+        linkedIR.globalScopeVarLayout = nullptr;
+    }
+
+    // When precompiling, the imports of precompiled functions are left for the final link.
+    if (!codeGenContext->getTargetProgram()->getOptionSet().getBoolOption(
+            CompilerOptionName::EmbedDownstreamIR))
+    {
+        SLANG_RETURN_ON_FAIL(_linkPrecompiledSPIRV(codeGenContext, spirv));
+    }
 
 #if 0
     String optErr;
@@ -1932,7 +2307,8 @@ SlangResult emitSPIRVForEntryPointsDirectly(
 #endif
     auto artifact =
         ArtifactUtil::createArtifactForCompileTarget(asExternal(codeGenContext->getTargetFormat()));
-    artifact->addRepresentationUnknown(ListBlob::moveCreate(spirv));
+    auto spirvBlob = ListBlob::moveCreate(spirv);
+    artifact->addRepresentationUnknown(spirvBlob);
 
 #if 0
     // Dump the unoptimized SPIRV after lowering from slang IR -> SPIRV
@@ -1946,6 +2322,9 @@ SlangResult emitSPIRVForEntryPointsDirectly(
         codeGenContext->getSink());
     if (compiler)
     {
+        // Validation only reads the unoptimized SPIR-V, so it runs on another thread while the
+        // SPIR-V is optimized on this one, rather than adding its time to the compile.
+        std::future<SlangResult> validationResult;
         if (!codeGenContext->shouldSkipSPIRVValidation())
         {
             StringBuilder runSpirvValEnvVar;
@@ -1954,18 +2333,14 @@ SlangResult emitSPIRVForEntryPointsDirectly(
                 runSpirvValEnvVar);
             if (runSpirvValEnvVar.getUnownedSlice() == "1")
             {
-                if (SLANG_FAILED(compiler->validate(
-                        (uint32_t*)spirv.getBuffer(),
-                        int(spirv.getCount() / 4))))
-                {
-                    String err;
-                    String dis;
-                    disassembleSPIRV(spirv, err, dis);
-                    codeGenContext->getSink()->diagnoseWithoutSourceView(
-                        SourceLoc{},
-                        Diagnostics::spirvValidationFailed,
-                        dis);
-                }
+                validationResult = std::async(
+                    std::launch::async,
+                    [compiler, spirvBlob]()
+                    {
+                        return compiler->validate(
+                            (const uint32_t*)spirvBlob->getBufferPointer(),
+                            int(spirvBlob->getBufferSize() / 4));
+                    });
             }
         }
 
@@ -1995,21 +2370,48 @@ SlangResult emitSPIRVForEntryPointsDirectly(
             SLANG_ASSERT(!"Unhandled optimization level");
             break;
         }
+        auto& targetOptionSet = codeGenContext->getTargetProgram()->getOptionSet();
+        downstreamOptions.spirvOptimizationPreset =
+            targetOptionSet.getEnumOption<SlangSpirvOptimizationPreset>(
+                CompilerOptionName::SpirvOptimizationPreset);
         auto downstreamStartTime = std::chrono::high_resolution_clock::now();
-        if (SLANG_SUCCEEDED(compiler->compile(downstreamOptions, optimizedArtifact.writeRef())))
         {
-            artifact = _Move(optimizedArtifact);
+            SLANG_PROFILE_SECTION(spirvOpt);
+            CodeGenContext::DownstreamScope downstreamScope(codeGenContext);
+            if (SLANG_SUCCEEDED(
+                    compiler->compile(downstreamOptions, optimizedArtifact.writeRef())))
+            {
+                artifact = _Move(optimizedArtifact);
+            }
         }
         auto downstreamElapsedTime =
             (std::chrono::high_resolution_clock::now() - downstreamStartTime).count() * 0.000000001;
         codeGenContext->getSession()->addDownstreamCompileTime(downstreamElapsedTime);
 
+        if (validationResult.valid() && SLANG_FAILED(validationResult.get()))
+        {
+            List<uint8_t> unoptimizedSpirv;
+            unoptimizedSpirv.addRange(
+                (const uint8_t*)spirvBlob->getBufferPointer(),
+                Index(spirvBlob->getBufferSize()));
+            String err;
+            String dis;
+            disassembleSPIRV(unoptimizedSpirv, err, dis);
+            codeGenContext->getSink()->diagnoseWithoutSourceView(
+                SourceLoc{},
+                Diagnostics::spirvValidationFailed,
+                dis);
+        }
+
         SLANG_RETURN_ON_FAIL(
             passthroughDownstreamDiagnostics(codeGenContext->getSink(), compiler, artifact));
     }
 
     ArtifactUtil::addAssociated(artifact, linkedIR.metadata);
 
+    if (isIncrementalCodeGen && codeGenContext->getSink()->getErrorCount() == 0)
+        _addIncrementalCodeGenArtifact(codeGenContext, incrementalCodeGenKey, artifact);
+
     outArtifact.swap(artifact);
 
     return SLANG_OK;
@@ -1,6 +1,7 @@
 #include "slang-ir-any-value-inference.h"
 
 #include "../core/slang-func-ptr.h"
+#include "slang-ir-any-value-marshalling.h"
 #include "slang-ir-generics-lowering-context.h"
 #include "slang-ir-insts.h"
 #include "slang-ir-layout.h"
@@ -216,13 +217,24 @@ void inferAnyValueSizeWhereNecessary(TargetProgram* targetProgram, IRModule* mod
         IRIntegerValue maxAnyValueSize = -1;
         for (auto implType : mapInterfaceToImplementations[interfaceType])
         {
-            IRSizeAndAlignment sizeAndAlignment;
-            getNaturalSizeAndAlignment(
-                targetProgram->getOptionSet(),
-                (IRType*)implType,
-                &sizeAndAlignment);
+            // Use the size that the marshalling code packs the type into, when the type can be
+            // packed at all. Packing only aligns to 4 bytes, so it doesn't need the padding the
+            // natural layout puts before 8-byte aligned fields such as resource handles. The
+            // natural size is kept for the types that can't be packed, so that an error is
+            // still reported when they are.
+            //
+            IRIntegerValue implSize = getAnyValueSize((IRType*)implType);
+            if (implSize < 0)
+            {
+                IRSizeAndAlignment sizeAndAlignment;
+                getNaturalSizeAndAlignment(
+                    targetProgram->getOptionSet(),
+                    (IRType*)implType,
+                    &sizeAndAlignment);
+                implSize = sizeAndAlignment.size;
+            }
 
-            maxAnyValueSize = Math::Max(maxAnyValueSize, sizeAndAlignment.size);
+            maxAnyValueSize = Math::Max(maxAnyValueSize, implSize);
         }
 
         // Should not encounter interface types without any conforming implementations.
@@ -2,6 +2,7 @@
 
 #include "../core/slang-func-ptr.h"
 #include "slang-ast-support-types.h"
+#include "slang-compiler.h"
 #include "slang-ir-autodiff-region.h"
 #include "slang-ir-insts.h"
 #include "slang-ir-simplify-cfg.h"
@@ -2009,7 +2010,10 @@ void buildIndexedBlocks(
 // For each primal inst that is used in reverse blocks, decide if we should recompute or store
 // its value, then make them accessible in reverse blocks based the decision.
 //
-RefPtr<HoistedPrimalsInfo> applyCheckpointPolicy(IRGlobalValueWithCode* func)
+RefPtr<HoistedPrimalsInfo> applyCheckpointPolicy(
+    IRGlobalValueWithCode* func,
+    SlangAutodiffCheckpointPolicy policy,
+    Count recomputeBudget)
 {
     sortBlocksInFunc(func);
 
@@ -2031,7 +2035,8 @@ RefPtr<HoistedPrimalsInfo> applyCheckpointPolicy(IRGlobalValueWithCode* func)
     // If we decide to recompute the inst, emit the recompute inst in the corresponding recompute
     // block.
     //
-    RefPtr<AutodiffCheckpointPolicyBase> chkPolicy = new DefaultCheckpointPolicy(func->getModule());
+    RefPtr<AutodiffCheckpointPolicyBase> chkPolicy =
+        new DefaultCheckpointPolicy(func->getModule(), policy, recomputeBudget);
     chkPolicy->preparePolicy(func);
     auto primalsInfo = chkPolicy->processFunc(func, recomputeBlockMap, cloneCtx, indexedBlockInfo);
 
@@ -2041,9 +2046,36 @@ RefPtr<HoistedPrimalsInfo> applyCheckpointPolicy(IRGlobalValueWithCode* func)
     return ensurePrimalAvailability(primalsInfo, func, indexedBlockInfo);
 }
 
+SlangAutodiffCheckpointPolicy getCheckpointPolicy(
+    TargetProgram* targetProgram,
+    IRInst* primalFunc,
+    Count& outRecomputeBudget)
+{
+    outRecomputeBudget = kDefaultAutodiffRecomputeBudget;
+    auto policy = SLANG_AUTODIFF_CHECKPOINT_POLICY_DEFAULT;
+    if (targetProgram)
+    {
+        auto& optionSet = targetProgram->getOptionSet();
+        policy = optionSet.getEnumOption<SlangAutodiffCheckpointPolicy>(
+            CompilerOptionName::AutodiffCheckpointPolicy);
+        if (optionSet.hasOption(CompilerOptionName::AutodiffRecomputeBudget))
+        {
+            outRecomputeBudget =
+                optionSet.getIntOption(CompilerOptionName::AutodiffRecomputeBudget);
+        }
+    }
+
+    // A `[CheckpointPolicy]` attribute on the function overrides the option.
+    auto decoratedFunc = getResolvedInstForDecorations(primalFunc, true);
+    if (auto policyDecor = decoratedFunc->findDecoration<IRCheckpointPolicyDecoration>())
+        policy = policyDecor->getPolicy();
+    return policy;
+}
+
 void DefaultCheckpointPolicy::preparePolicy(IRGlobalValueWithCode* func)
 {
     SLANG_UNUSED(func)
+    recomputeCosts.clear();
     return;
 }
 
@@ -2088,19 +2120,13 @@ static bool isInstInPrimalOrTransposedParameterBlocks(IRInst* inst)
     return false;
 }
 
-static bool shouldStoreInst(IRInst* inst)
+// Whether `inst` computes a value, rather than packing, unpacking or reinterpreting
+// other values.
+//
+static bool isRealComputation(IRInst* inst)
 {
-    if (!inst->getDataType())
-    {
-        return false;
-    }
-
-    if (!canTypeBeStored(inst->getDataType()))
-        return false;
-
     switch (inst->getOp())
     {
-    // Never store these opcodes because they are not real computations.
     case kIROp_CastFloatToInt:
     case kIROp_CastIntToFloat:
     case kIROp_IntCast:
@@ -2139,7 +2165,26 @@ static bool shouldStoreInst(IRInst* inst)
     case kIROp_Param:
     case kIROp_DetachDerivative:
         return false;
+    default:
+        return true;
+    }
+}
+
+static bool shouldStoreInst(IRInst* inst)
+{
+    if (!inst->getDataType())
+    {
+        return false;
+    }
 
+    if (!canTypeBeStored(inst->getDataType()))
+        return false;
+
+    if (!isRealComputation(inst))
+        return false;
+
+    switch (inst->getOp())
+    {
     // Never store these op codes because they are trivial to compute.
     case kIROp_Add:
     case kIROp_Sub:
@@ -2224,7 +2269,105 @@ static bool shouldStoreInst(IRInst* inst)
     return true;
 }
 
-static bool shouldStoreVar(IRVar* var)
+static bool canStoreComputation(IRInst* inst)
+{
+    if (!inst->getDataType() || !canTypeBeStored(inst->getDataType()))
+        return false;
+    return isRealComputation(inst) && !as<IRType>(inst);
+}
+
+bool DefaultCheckpointPolicy::shouldStoreValue(IRInst* inst)
+{
+    switch (policy)
+    {
+    default:
+    case SLANG_AUTODIFF_CHECKPOINT_POLICY_DEFAULT:
+        return shouldStoreInst(inst);
+
+    case SLANG_AUTODIFF_CHECKPOINT_POLICY_STORE_ALL:
+        // Store every real computation whose value can be stored, including the ones
+        // that are trivial to compute.
+        //
+        return canStoreComputation(inst);
+
+    case SLANG_AUTODIFF_CHECKPOINT_POLICY_RECOMPUTE_ALL:
+        // Only store the values that can't be recomputed without repeating
+        // their side effects, ignoring `[PreferCheckpoint]` hints.
+        //
+        if (!shouldStoreInst(inst))
+            return false;
+        return inst->mightHaveSideEffects();
+
+    case SLANG_AUTODIFF_CHECKPOINT_POLICY_BUDGET:
+        if (auto call = as<IRCall>(inst))
+        {
+            // Follow the hint of the callee, if any.
+            if (getCheckpointPreference(call->getCallee()) != CheckpointPreference::None)
+                return shouldStoreInst(inst);
+        }
+        if (!canStoreComputation(inst))
+            return false;
+        if (shouldStoreInst(inst) && inst->mightHaveSideEffects())
+            return true;
+        return getRecomputeCost(inst) > recomputeBudget;
+    }
+}
+
+Count DefaultCheckpointPolicy::getCallCost(IRInst* callee)
+{
+    auto func = as<IRGlobalValueWithCode>(getResolvedInstForDecorations(callee));
+    if (!func || !func->getFirstBlock())
+        return 1;
+    if (auto cost = callCosts.tryGetValue(func))
+        return *cost;
+
+    Count cost = 1;
+    for (auto block : func->getBlocks())
+    {
+        for (auto inst : block->getChildren())
+        {
+            SLANG_UNUSED(inst);
+            cost++;
+        }
+    }
+    callCosts[func] = cost;
+    return cost;
+}
+
+Count DefaultCheckpointPolicy::getRecomputeCost(IRInst* inst)
+{
+    if (auto cost = recomputeCosts.tryGetValue(inst))
+        return *cost;
+
+    // Global values, parameters and variables are made available on their own, so what
+    // they cost isn't part of the cost of the values computed from them.
+    //
+    auto parentFunc = getParentFunc(inst);
+    if (!parentFunc || as<IRParam>(inst) || as<IRVar>(inst))
+        return 0;
+
+    // Break cycles through instructions whose cost is being computed.
+    recomputeCosts[inst] = 0;
+
+    Count cost = 0;
+    if (auto call = as<IRCall>(inst))
+        cost += getCallCost(call->getCallee());
+    else if (isRealComputation(inst))
+        cost += 1;
+
+    for (UInt i = 0; i < inst->getOperandCount() && cost <= recomputeBudget; i++)
+    {
+        auto operand = inst->getOperand(i);
+        if (getParentFunc(operand) == parentFunc)
+            cost += getRecomputeCost(operand);
+    }
+
+    cost = Math::Min(cost, recomputeBudget + 1);
+    recomputeCosts[inst] = cost;
+    return cost;
+}
+
+bool DefaultCheckpointPolicy::shouldStoreVar(IRVar* var)
 {
     if (const auto typeDecor = var->findDecoration<IRBackwardDerivativePrimalContextDecoration>())
     {
@@ -2249,7 +2392,7 @@ static bool shouldStoreVar(IRVar* var)
         {
             // If the var is being written to by a call, the decision
             // of the var will be the same as the decision for the call.
-            return shouldStoreInst(callUser);
+            return shouldStoreValue(callUser);
         }
         // Default behavior is to recompute stuff.
         return false;
@@ -2313,7 +2456,7 @@ HoistResult DefaultCheckpointPolicy::classify(UseOrPseudoUse use)
     }
     else
     {
-        if (shouldStoreInst(use.usedVal))
+        if (shouldStoreValue(use.usedVal))
         {
             return HoistResult::store(use.usedVal);
         }
@@ -320,11 +320,18 @@ protected:
     void collectInductionValues(IRGlobalValueWithCode* func);
 };
 
+/// The number of instructions a primal value may cost to recompute under
+/// `SLANG_AUTODIFF_CHECKPOINT_POLICY_BUDGET`, unless `-autodiff-recompute-budget` is set.
+const Count kDefaultAutodiffRecomputeBudget = 16;
+
 class DefaultCheckpointPolicy : public AutodiffCheckpointPolicyBase
 {
 public:
-    DefaultCheckpointPolicy(IRModule* module)
-        : AutodiffCheckpointPolicyBase(module)
+    DefaultCheckpointPolicy(
+        IRModule* module,
+        SlangAutodiffCheckpointPolicy policy = SLANG_AUTODIFF_CHECKPOINT_POLICY_DEFAULT,
+        Count recomputeBudget = kDefaultAutodiffRecomputeBudget)
+        : AutodiffCheckpointPolicyBase(module), policy(policy), recomputeBudget(recomputeBudget)
     {
     }
 
@@ -333,7 +340,29 @@ public:
 
 private:
     bool canRecompute(UseOrPseudoUse use);
+    bool shouldStoreValue(IRInst* inst);
+    bool shouldStoreVar(IRVar* var);
+
+    /// Estimate the number of instructions it takes to recompute `inst` and the operands it
+    /// is computed from. Costs over the budget are clamped to one more than the budget.
+    Count getRecomputeCost(IRInst* inst);
+    Count getCallCost(IRInst* callee);
+
+    SlangAutodiffCheckpointPolicy policy;
+    Count recomputeBudget;
+    Dictionary<IRInst*, Count> recomputeCosts;
+    Dictionary<IRInst*, Count> callCosts;
 };
 
-RefPtr<HoistedPrimalsInfo> applyCheckpointPolicy(IRGlobalValueWithCode* func);
+/// Get the checkpoint policy of the backward derivative of `primalFunc`, from its
+/// `[CheckpointPolicy]` attribute or the options of `targetProgram`.
+SlangAutodiffCheckpointPolicy getCheckpointPolicy(
+    TargetProgram* targetProgram,
+    IRInst* primalFunc,
+    Count& outRecomputeBudget);
+
+RefPtr<HoistedPrimalsInfo> applyCheckpointPolicy(
+    IRGlobalValueWithCode* func,
+    SlangAutodiffCheckpointPolicy policy = SLANG_AUTODIFF_CHECKPOINT_POLICY_DEFAULT,
+    Count recomputeBudget = kDefaultAutodiffRecomputeBudget);
 }; // namespace Slang
@@ -836,7 +836,10 @@ void BackwardDiffTranscriberBase::transcribeFuncImpl(
 
     // Apply checkpointing policy to legalize cross-scope uses of primal values
     // using either recompute or store strategies.
-    auto primalsInfo = applyCheckpointPolicy(diffPropagateFunc);
+    Count recomputeBudget = 0;
+    auto checkpointPolicy =
+        getCheckpointPolicy(autoDiffSharedContext->targetProgram, primalFunc, recomputeBudget);
+    auto primalsInfo = applyCheckpointPolicy(diffPropagateFunc, checkpointPolicy, recomputeBudget);
 
     eliminateDeadCode(diffPropagateFunc);
 
@@ -1,12 +1,15 @@
 #include "slang-ir-autodiff.h"
 
 #include "../core/slang-performance-profiler.h"
+#include "slang-compiler.h"
 #include "slang-ir-address-analysis.h"
 #include "slang-ir-autodiff-fwd.h"
 #include "slang-ir-autodiff-pairs.h"
 #include "slang-ir-autodiff-rev.h"
 #include "slang-ir-inline.h"
+#include "slang-ir-pass-profile.h"
 #include "slang-ir-single-return.h"
+#include "slang-ir-specialization-cache.h"
 #include "slang-ir-ssa-simplification.h"
 #include "slang-ir-validate.h"
 
@@ -2401,16 +2404,87 @@ struct AutoDiffPass : public InstPassBase
         return true;
     }
 
+    // When `ShareForwardDerivatives` is set, the forward derivatives of functions
+    // with linkage are also looked up in, and added to, a cache kept by the target,
+    // so that the other programs linked for the same target don't need to
+    // transcribe them again.
+    //
+    IRSpecializationCache* getDerivativeCache()
+    {
+        auto targetProgram = autodiffContext->targetProgram;
+        if (!targetProgram ||
+            !targetProgram->getOptionSet().getBoolOption(
+                CompilerOptionName::ShareForwardDerivatives))
+            return nullptr;
+        return targetProgram->getTargetReq()->getIRSpecializationCache();
+    }
+
+    String derivativeCacheOptionsKey;
+
+    String const& getDerivativeCacheOptionsKey()
+    {
+        if (!derivativeCacheOptionsKey.getLength())
+        {
+            derivativeCacheOptionsKey = IRSpecializationCache::getOptionsKey(
+                autodiffContext->targetProgram->getOptionSet());
+        }
+        return derivativeCacheOptionsKey;
+    }
+
+    // The global values of the module with linkage, by mangled name, which
+    // cached derivatives are connected to.
+    //
+    IRSpecializationCache::GlobalsByName globalsByName;
+    bool isGlobalsByNameValid = false;
+
+    static bool canShareForwardDerivative(IRInst* primalFunc)
+    {
+        auto func = as<IRFunc>(primalFunc);
+        return func && as<IRModuleInst>(func->getParent()) &&
+               func->findDecoration<IRLinkageDecoration>() &&
+               !func->findDecoration<IRForwardDerivativeDecoration>();
+    }
+
+    // Find a forward derivative of `primalFunc` transcribed for another program,
+    // and clone it into the module as if it had been transcribed here.
+    //
+    IRInst* findCachedForwardDerivative(IRSpecializationCache* cache, IRInst* primalFunc)
+    {
+        if (!canShareForwardDerivative(primalFunc))
+            return nullptr;
+
+        if (!isGlobalsByNameValid)
+        {
+            IRSpecializationCache::collectGlobalsByName(module, globalsByName);
+            isGlobalsByNameValid = true;
+        }
+
+        IRBuilder builder(module);
+        builder.setInsertBefore(primalFunc);
+        List<IRInst*> newInsts;
+        auto diffFunc = cache->findForwardDerivative(
+            getDerivativeCacheOptionsKey(),
+            as<IRFunc>(primalFunc),
+            globalsByName,
+            &builder,
+            newInsts);
+        if (diffFunc)
+            builder.addForwardDerivativeDecoration(primalFunc, diffFunc);
+        return diffFunc;
+    }
+
     // Process all differentiate calls, and recursively generate code for forward and backward
     // derivative functions.
     //
     bool processReferencedFunctions(IRBuilder* builder)
     {
+        auto derivativeCache = getDerivativeCache();
         fullyDifferentiatedInsts.clear();
         bool hasChanges = false;
         for (;;)
         {
             bool changed = false;
+            isGlobalsByNameValid = false;
             List<IRInst*> autoDiffWorkList;
             // Collect all `ForwardDifferentiate`/`BackwardDifferentiate` insts from the call graph.
             processAllReachableInsts(
@@ -2475,7 +2549,10 @@ struct AutoDiffPass : public InstPassBase
                 case kIROp_ForwardDifferentiate:
                     {
                         auto baseFunc = as<IRForwardDifferentiate>(differentiateInst)->getBaseFn();
-                        diffFunc = forwardTranscriber.transcribe(&subBuilder, baseFunc);
+                        if (derivativeCache)
+                            diffFunc = findCachedForwardDerivative(derivativeCache, baseFunc);
+                        if (!diffFunc)
+                            diffFunc = forwardTranscriber.transcribe(&subBuilder, baseFunc);
                     }
                     break;
                 case kIROp_BackwardDifferentiatePrimal:
@@ -2512,11 +2589,20 @@ struct AutoDiffPass : public InstPassBase
             // Run transcription logic to generate the body of forward/backward derivatives
             // functions. While doing so, we may discover new functions to differentiate, so we keep
             // running until the worklist goes dry.
+            //
+            // The bodies are transcribed one at a time, even when the functions don't call each
+            // other: every transcription clones, creates and deduplicates instructions in the
+            // shared module, and none of that is safe to do from several threads. How many
+            // bodies are transcribed, and in how many rounds, is reported to the pass profiler
+            // to tell how much there would be to gain from doing it in parallel.
+            //
             List<IRFunc*> autodiffCleanupList;
+            List<KeyValuePair<IRFunc*, IRFunc*>> sharedForwardDerivatives;
             while (autodiffContext->followUpFunctionsToTranscribe.getCount() != 0)
             {
                 changed = true;
                 auto followUpWorkList = _Move(autodiffContext->followUpFunctionsToTranscribe);
+                transcriptionRoundCount++;
                 for (auto task : followUpWorkList)
                 {
                     auto diffFunc = as<IRFunc>(task.resultFunc);
@@ -2534,12 +2620,18 @@ struct AutoDiffPass : public InstPassBase
                     switch (task.type)
                     {
                     case FuncBodyTranscriptionTaskType::Forward:
+                        forwardFuncCount++;
                         forwardTranscriber.transcribeFunc(builder, primalFunc, diffFunc);
+                        if (derivativeCache && primalFunc->findDecoration<IRLinkageDecoration>())
+                            sharedForwardDerivatives.add(
+                                KeyValuePair<IRFunc*, IRFunc*>(primalFunc, diffFunc));
                         break;
                     case FuncBodyTranscriptionTaskType::BackwardPrimal:
+                        backwardPrimalFuncCount++;
                         backwardPrimalTranscriber.transcribeFunc(builder, primalFunc, diffFunc);
                         break;
                     case FuncBodyTranscriptionTaskType::BackwardPropagate:
+                        backwardPropagateFuncCount++;
                         backwardPropagateTranscriber.transcribeFunc(builder, primalFunc, diffFunc);
                         break;
                     default:
@@ -2560,6 +2652,19 @@ struct AutoDiffPass : public InstPassBase
                 stripTempDecorations(diffFunc);
             }
 
+            // Functions whose derivatives are nested in generics, or use values
+            // made for this program only, are left out of the cache.
+            for (auto pair : sharedForwardDerivatives)
+            {
+                if (as<IRModuleInst>(pair.value->getParent()))
+                {
+                    derivativeCache->addForwardDerivative(
+                        getDerivativeCacheOptionsKey(),
+                        pair.key,
+                        pair.value);
+                }
+            }
+
             autodiffCleanupList.clear();
 
 #if _DEBUG
@@ -2640,6 +2745,14 @@ struct AutoDiffPass : public InstPassBase
         context->transcriberSet.backwardTranscriber = &backwardTranscriber;
     }
 
+    // The number of function bodies transcribed, by kind, and the number of
+    // rounds of follow-up transcription they were transcribed in.
+    //
+    Count forwardFuncCount = 0;
+    Count backwardPrimalFuncCount = 0;
+    Count backwardPropagateFuncCount = 0;
+    Count transcriptionRoundCount = 0;
+
 protected:
     // A transcriber object that handles the main job of
     // processing instructions while maintaining state.
@@ -2727,6 +2840,24 @@ bool processAutodiffCalls(
 
     modified |= pass.processModule();
 
+    auto passProfiler = IRPassProfiler::getProfiler();
+    if (passProfiler->isEnabled())
+    {
+        passProfiler->addCounter("processAutodiffCalls", "forwardFuncs", pass.forwardFuncCount);
+        passProfiler->addCounter(
+            "processAutodiffCalls",
+            "backwardPrimalFuncs",
+            pass.backwardPrimalFuncCount);
+        passProfiler->addCounter(
+            "processAutodiffCalls",
+            "backwardPropagateFuncs",
+            pass.backwardPropagateFuncCount);
+        passProfiler->addCounter(
+            "processAutodiffCalls",
+            "transcriptionRounds",
+            pass.transcriptionRoundCount);
+    }
+
     return modified;
 }
 
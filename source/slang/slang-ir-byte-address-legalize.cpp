@@ -130,6 +130,19 @@ struct ByteAddressBufferLegalizationContext
         auto buffer = load->getOperand(0);
         auto offset = load->getOperand(1);
         auto alignment = load->getOperand(2);
+
+        // Where the target allows it, we try to load a `struct` with
+        // as few wide loads as possible first.
+        //
+        if (m_options.coalesceStructLoads)
+        {
+            if (auto structType = as<IRStructType>(type))
+            {
+                if (tryEmitCoalescedStructLoad(load, structType, buffer, offset))
+                    return;
+            }
+        }
+
         auto legalLoad = emitLegalLoad(type, buffer, offset, 0, alignment);
 
         // If it currently possible for the legalization
@@ -148,6 +161,256 @@ struct ByteAddressBufferLegalizationContext
         load->removeAndDeallocate();
     }
 
+    // The default handling of a `struct` load in `emitLegalLoad` emits one
+    // load per field, or per element of a field that is an array. When a
+    // `struct` is made of 32-bit scalars, we can instead load each run of
+    // up to four adjacent 32-bit words with a single `uint2`, `uint3`, or
+    // `uint4` load, and bit-cast the words back to the types of the values
+    // they hold. Such loads only require the 4-byte alignment that loading
+    // each word on its own already requires.
+    //
+    // When the loaded value is only used to extract fields, we only load
+    // the words of the fields that are extracted.
+    //
+    struct LoadedWord
+    {
+        IRType* type = nullptr;
+        IRIntegerValue offset = 0;
+        IRInst* value = nullptr;
+    };
+
+    // Collect the words of a value of `type` stored at `offset`, in the
+    // order that `buildValueFromWords` consumes them. Fails if the value
+    // has parts that aren't 32-bit scalars.
+    //
+    bool collectWords(IRType* type, IRIntegerValue offset, List<LoadedWord>& outWords)
+    {
+        if (auto structType = as<IRStructType>(type))
+        {
+            for (auto field : structType->getFields())
+            {
+                IRIntegerValue fieldOffset = 0;
+                if (SLANG_FAILED(getOffset(m_targetProgram, field, &fieldOffset)))
+                    return false;
+                if (!collectWords(field->getFieldType(), offset + fieldOffset, outWords))
+                    return false;
+            }
+            return true;
+        }
+
+        IRType* elementType = nullptr;
+        IRInst* elementCount = nullptr;
+        if (auto vecType = as<IRVectorType>(type))
+        {
+            elementType = vecType->getElementType();
+            elementCount = vecType->getElementCount();
+        }
+        else if (auto arrayType = as<IRArrayType>(type))
+        {
+            elementType = arrayType->getElementType();
+            elementCount = arrayType->getElementCount();
+        }
+        if (elementType)
+        {
+            auto elementCountInst = as<IRIntLit>(elementCount);
+            if (!elementCountInst)
+                return false;
+            IRSizeAndAlignment elementLayout;
+            if (SLANG_FAILED(getNaturalSizeAndAlignment(
+                    m_targetProgram->getOptionSet(),
+                    elementType,
+                    &elementLayout)))
+                return false;
+            for (IRIntegerValue ii = 0; ii < elementCountInst->getValue(); ++ii)
+            {
+                if (!collectWords(elementType, offset + ii * elementLayout.getStride(), outWords))
+                    return false;
+            }
+            return true;
+        }
+
+        switch (type->getOp())
+        {
+        case kIROp_IntType:
+        case kIROp_UIntType:
+        case kIROp_FloatType:
+            {
+                LoadedWord word;
+                word.type = type;
+                word.offset = offset;
+                outWords.add(word);
+                return true;
+            }
+        default:
+            return false;
+        }
+    }
+
+    // Load the values of `ioWords`, from `buffer` at `baseOffset` plus the
+    // offset of each word.
+    //
+    void loadWords(IRInst* buffer, IRInst* baseOffset, List<LoadedWord>& ioWords)
+    {
+        auto uintType = m_builder.getUIntType();
+        for (Index i = 0; i < ioWords.getCount();)
+        {
+            Index runLength = countAdjacentWords(ioWords, i);
+            IRType* loadType =
+                runLength == 1 ? (IRType*)uintType : m_builder.getVectorType(uintType, runLength);
+            auto loaded = emitSimpleLoad(loadType, buffer, baseOffset, ioWords[i].offset);
+            for (Index j = 0; j < runLength; j++)
+            {
+                auto& word = ioWords[i + j];
+                auto bits = runLength == 1 ? loaded : m_builder.emitElementExtract(loaded, j);
+                word.value = word.type->getOp() == kIROp_UIntType
+                                 ? bits
+                                 : m_builder.emitBitCast(word.type, bits);
+            }
+            i += runLength;
+        }
+    }
+
+    // Count the words starting at `start` that can be loaded with a single load.
+    //
+    static Index countAdjacentWords(List<LoadedWord> const& words, Index start)
+    {
+        Index runLength = 1;
+        while (runLength < 4 && start + runLength < words.getCount() &&
+               words[start + runLength].offset == words[start].offset + runLength * 4)
+        {
+            runLength++;
+        }
+        return runLength;
+    }
+
+    static bool hasAdjacentWords(List<LoadedWord> const& words)
+    {
+        for (Index i = 0; i < words.getCount(); i++)
+        {
+            if (countAdjacentWords(words, i) > 1)
+                return true;
+        }
+        return false;
+    }
+
+    // Build the value of `type` out of the loaded words, starting at `ioIndex`.
+    //
+    IRInst* buildValueFromWords(IRType* type, List<LoadedWord> const& words, Index& ioIndex)
+    {
+        if (auto structType = as<IRStructType>(type))
+        {
+            List<IRInst*> fieldVals;
+            for (auto field : structType->getFields())
+                fieldVals.add(buildValueFromWords(field->getFieldType(), words, ioIndex));
+            return m_builder.emitMakeStruct(type, fieldVals);
+        }
+
+        IRType* elementType = nullptr;
+        IRInst* elementCount = nullptr;
+        if (auto vecType = as<IRVectorType>(type))
+        {
+            elementType = vecType->getElementType();
+            elementCount = vecType->getElementCount();
+        }
+        else if (auto arrayType = as<IRArrayType>(type))
+        {
+            elementType = arrayType->getElementType();
+            elementCount = arrayType->getElementCount();
+        }
+        if (elementType)
+        {
+            List<IRInst*> elementVals;
+            auto count = getIntVal(elementCount);
+            for (IRIntegerValue ii = 0; ii < count; ++ii)
+                elementVals.add(buildValueFromWords(elementType, words, ioIndex));
+            if (as<IRVectorType>(type))
+                return m_builder.emitMakeVector(type, elementVals);
+            return m_builder.emitMakeArray(
+                type,
+                (UInt)elementVals.getCount(),
+                elementVals.getBuffer());
+        }
+
+        return words[ioIndex++].value;
+    }
+
+    bool tryEmitCoalescedStructLoad(
+        IRInst* load,
+        IRStructType* structType,
+        IRInst* buffer,
+        IRInst* offset)
+    {
+        // Find out if the value is only used to extract fields.
+        //
+        bool onlyFieldsUsed = load->hasUses();
+        HashSet<IRInst*> usedKeys;
+        for (auto use = load->firstUse; use; use = use->nextUse)
+        {
+            auto fieldExtract = as<IRFieldExtract>(use->getUser());
+            if (!fieldExtract || fieldExtract->getBase() != load)
+            {
+                onlyFieldsUsed = false;
+                break;
+            }
+            usedKeys.add(fieldExtract->getField());
+        }
+
+        // We collect the words of the fields that need to be loaded, along
+        // with the index of the first word of each of them.
+        //
+        List<LoadedWord> words;
+        List<IRStructField*> loadedFields;
+        List<Index> firstWordIndices;
+        for (auto field : structType->getFields())
+        {
+            if (onlyFieldsUsed && !usedKeys.contains(field->getKey()))
+                continue;
+            IRIntegerValue fieldOffset = 0;
+            if (SLANG_FAILED(getOffset(m_targetProgram, field, &fieldOffset)))
+                return false;
+            loadedFields.add(field);
+            firstWordIndices.add(words.getCount());
+            if (!collectWords(field->getFieldType(), fieldOffset, words))
+                return false;
+        }
+
+        // If no two words are adjacent, there is nothing to gain over
+        // the default handling.
+        //
+        if (!hasAdjacentWords(words))
+            return false;
+
+        loadWords(buffer, offset, words);
+
+        if (!onlyFieldsUsed)
+        {
+            Index wordIndex = 0;
+            auto legalLoad = buildValueFromWords(structType, words, wordIndex);
+            load->replaceUsesWith(legalLoad);
+            load->removeAndDeallocate();
+            return true;
+        }
+
+        Dictionary<IRInst*, IRInst*> mapKeyToFieldVal;
+        for (Index i = 0; i < loadedFields.getCount(); i++)
+        {
+            Index wordIndex = firstWordIndices[i];
+            mapKeyToFieldVal[loadedFields[i]->getKey()] =
+                buildValueFromWords(loadedFields[i]->getFieldType(), words, wordIndex);
+        }
+        traverseUses(
+            load,
+            [&](IRUse* use)
+            {
+                auto fieldExtract = use->getUser();
+                fieldExtract->replaceUsesWith(
+                    mapKeyToFieldVal.getValue(as<IRFieldExtract>(fieldExtract)->getField()));
+                fieldExtract->removeAndDeallocate();
+            });
+        load->removeAndDeallocate();
+        return true;
+    }
+
     bool isTypeLegalForByteAddressLoadStore(IRType* type)
     {
         // Whether or not a type is legal to use for
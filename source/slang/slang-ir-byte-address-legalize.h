@@ -15,6 +15,11 @@ struct ByteAddressBufferLegalizationOptions
     bool translateToStructuredBufferOps = false;
     bool lowerBasicTypeOps = false;
 
+    /// Load `struct` values made of 32-bit scalars with as few `uint` vector loads as
+    /// possible, which requires the target to allow such loads at any 4-byte aligned
+    /// offset.
+    bool coalesceStructLoads = false;
+
     /// Causes all calls to `getEquivlentStructuredBuffer` to return a `ByteAddressBuffer` (this)
     /// instead of a `StructuredBuffer`. This option is used for targets that do not distinctly
     /// define `ByteAddressBuffer`/`StructuredBuffer` and introduce operations which prevent DCE
@@ -116,4 +116,94 @@ HashSet<IRFunc*>* getReferencingEntryPoints(
     return referencingEntryPoints;
 }
 
+static IRFunc* _getStaticCallee(IRCall* call)
+{
+    auto callee = call->getCallee();
+    if (auto specialize = as<IRSpecialize>(callee))
+    {
+        auto generic = findSpecializedGeneric(specialize);
+        if (!generic)
+            return nullptr;
+        callee = findGenericReturnVal(generic);
+    }
+    return as<IRFunc>(callee);
+}
+
+List<IRFunc*> getFuncsInCalleeFirstOrder(IRInst* root)
+{
+    // Find all the functions, looking inside generics too.
+    HashSet<IRFunc*> funcSet;
+    List<IRFunc*> funcs;
+    List<IRInst*> instsToVisit;
+    instsToVisit.add(root);
+    while (instsToVisit.getCount())
+    {
+        auto inst = instsToVisit.getLast();
+        instsToVisit.removeLast();
+        if (auto func = as<IRFunc>(inst))
+        {
+            if (funcSet.add(func))
+                funcs.add(func);
+            continue;
+        }
+        switch (inst->getOp())
+        {
+        case kIROp_Module:
+        case kIROp_Generic:
+        case kIROp_Block:
+            for (auto child = inst->getLastChild(); child; child = child->getPrevInst())
+                instsToVisit.add(child);
+            break;
+        }
+    }
+
+    // Then order them with a depth-first walk of the calls between them, which is done
+    // iteratively since call chains can be deep.
+    struct Frame
+    {
+        IRFunc* func;
+        List<IRFunc*> callees;
+        Index nextCallee = 0;
+    };
+    List<IRFunc*> result;
+    HashSet<IRFunc*> visited;
+    List<Frame> stack;
+    auto pushFunc = [&](IRFunc* func)
+    {
+        if (!visited.add(func))
+            return;
+        Frame frame;
+        frame.func = func;
+        for (auto block : func->getBlocks())
+        {
+            for (auto inst : block->getChildren())
+            {
+                auto call = as<IRCall>(inst);
+                if (!call)
+                    continue;
+                auto callee = _getStaticCallee(call);
+                if (callee && funcSet.contains(callee))
+                    frame.callees.add(callee);
+            }
+        }
+        stack.add(_Move(frame));
+    };
+    for (auto func : funcs)
+    {
+        pushFunc(func);
+        while (stack.getCount())
+        {
+            auto& frame = stack.getLast();
+            if (frame.nextCallee < frame.callees.getCount())
+            {
+                pushFunc(frame.callees[frame.nextCallee++]);
+                continue;
+            }
+            result.add(frame.func);
+            stack.removeLast();
+        }
+    }
+    return result;
+}
+
 } // namespace Slang
@@ -12,4 +12,10 @@ HashSet<IRFunc*>* getReferencingEntryPoints(
     Dictionary<IRInst*, HashSet<IRFunc*>>& m_referencingEntryPoints,
     IRInst* inst);
 
+/// Get the functions at or under `root`, including those inside generics, ordered so that
+/// every function comes after the functions it calls, either directly or through a
+/// specialization of a generic. Functions that call each other recursively are ordered
+/// arbitrarily among themselves.
+List<IRFunc*> getFuncsInCalleeFirstOrder(IRInst* root);
+
 } // namespace Slang
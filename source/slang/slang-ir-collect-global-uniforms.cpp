@@ -64,6 +64,12 @@ struct CollectGlobalUniformParametersContext
         }
     }
 
+    static UInt _getUniformOffset(IRStructFieldLayoutAttr* fieldLayoutAttr)
+    {
+        auto offsetAttr = fieldLayoutAttr->getLayout()->findOffsetAttr(LayoutResourceKind::Uniform);
+        return offsetAttr ? offsetAttr->getOffset() : 0;
+    }
+
     // This is a relatively simple pass, and it is all driven
     // by a single subroutine.
     //
@@ -174,7 +180,19 @@ struct CollectGlobalUniformParametersContext
         // parameters that were present in the layout information (they are
         // represented as the fields of the global-scope `struct` layout).
         //
+        // The layout lists the parameters in declaration order, but their
+        // ordinary data may have been reordered to reduce padding, so we visit
+        // them in the order of their uniform offsets. This way targets that
+        // lay out the fields of `GlobalParams` in order agree with the layout.
+        //
+        List<IRStructFieldLayoutAttr*> fieldLayoutAttrs;
         for (auto fieldLayoutAttr : globalParamsStructTypeLayout->getFieldLayoutAttrs())
+            fieldLayoutAttrs.add(fieldLayoutAttr);
+        fieldLayoutAttrs.stableSort(
+            [](IRStructFieldLayoutAttr* a, IRStructFieldLayoutAttr* b)
+            { return _getUniformOffset(a) < _getUniformOffset(b); });
+
+        for (auto fieldLayoutAttr : fieldLayoutAttrs)
         {
             // We expect the IR layout pass to have encoded field per-field
             // layout so that the "key" for the field is the corresponding
@@ -0,0 +1,110 @@
+// slang-ir-content-hash.cpp
+#include "slang-ir-content-hash.h"
+
+#include "../compiler-core/slang-source-loc.h"
+#include "slang-ir-insts.h"
+#include "slang-ir.h"
+
+namespace Slang
+{
+
+struct IRContentHashContext
+{
+    SourceManager* sourceManager;
+    DigestBuilder<SHA1>& builder;
+    Dictionary<IRInst*, Index> instIndices;
+    List<IRInst*> insts;
+
+    IRContentHashContext(SourceManager* inSourceManager, DigestBuilder<SHA1>& inBuilder)
+        : sourceManager(inSourceManager), builder(inBuilder)
+    {
+    }
+
+    void appendInstRef(IRInst* inst)
+    {
+        Index index = -1;
+        if (inst)
+            instIndices.tryGetValue(inst, index);
+        builder.append(index);
+    }
+
+    void appendSourceLoc(SourceLoc loc)
+    {
+        if (!loc.isValid() || !sourceManager)
+        {
+            builder.append(Int(-1));
+            return;
+        }
+        auto humaneLoc = sourceManager->getHumaneLoc(loc, SourceLocType::Emit);
+        builder.append(humaneLoc.pathInfo.getName());
+        builder.append(humaneLoc.line);
+        builder.append(humaneLoc.column);
+    }
+
+    void appendConstant(IRConstant* constant)
+    {
+        switch (constant->getOp())
+        {
+        case kIROp_BoolLit:
+        case kIROp_FloatLit:
+        case kIROp_IntLit:
+            builder.append(constant->value.intVal);
+            break;
+        case kIROp_BlobLit:
+        case kIROp_StringLit:
+            {
+                auto slice = constant->getStringSlice();
+                builder.append(slice.getLength());
+                builder.append(slice);
+                break;
+            }
+        default:
+            // Pointer literals refer to front-end objects, which are created again when a
+            // module is reloaded, so only the instructions that use them are hashed.
+            break;
+        }
+    }
+
+    void hashModule(IRModule* module)
+    {
+        // Number the instructions first, since operands can refer to the instructions that
+        // come after them.
+        List<IRInst*> workList;
+        workList.add(module->getModuleInst());
+        while (workList.getCount())
+        {
+            auto inst = workList.getLast();
+            workList.removeLast();
+            instIndices.add(inst, insts.getCount());
+            insts.add(inst);
+
+            // Add the children last to first, so that they are numbered in order.
+            for (auto child = inst->getLastDecorationOrChild(); child; child = child->getPrevInst())
+                workList.add(child);
+        }
+
+        for (auto inst : insts)
+        {
+            builder.append(inst->getOp());
+            appendInstRef(inst->getParent());
+            appendInstRef(inst->getFullType());
+            builder.append(inst->getOperandCount());
+            for (UInt i = 0; i < inst->getOperandCount(); i++)
+                appendInstRef(inst->getOperand(i));
+            if (auto constant = as<IRConstant>(inst))
+                appendConstant(constant);
+            appendSourceLoc(inst->sourceLoc);
+        }
+    }
+};
+
+void buildIRContentHash(
+    IRModule* module,
+    SourceManager* sourceManager,
+    DigestBuilder<SHA1>& builder)
+{
+    IRContentHashContext context(sourceManager, builder);
+    context.hashModule(module);
+}
+
+} // namespace Slang
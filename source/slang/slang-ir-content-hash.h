@@ -0,0 +1,21 @@
+// slang-ir-content-hash.h
+#pragma once
+
+#include "../core/slang-crypto.h"
+
+namespace Slang
+{
+struct IRModule;
+class SourceManager;
+
+/// Add a hash of the contents of `module` to `builder`, that is the same for two modules
+/// with the same instructions in the same order, even if they were created separately.
+///
+/// Instructions are identified by their position in the module, and source locations by
+/// their file, line and column in `sourceManager`, so that the hash of a module linked again
+/// from modules that were reloaded without change is the same.
+void buildIRContentHash(
+    IRModule* module,
+    SourceManager* sourceManager,
+    DigestBuilder<SHA1>& builder);
+} // namespace Slang
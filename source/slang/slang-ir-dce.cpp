@@ -53,7 +53,10 @@ struct DeadCodeEliminationContext
     // looked at their impact on other
     // instructions.
     //
-    List<IRInst*> workList;
+    // The list comes from the container pool of the module, so that
+    // the storage it grew to is reused by the next run of the pass.
+    //
+    InstWorkList workList;
 
     // When we discover that an instruction seems
     // to be live, we will add it to our set,
@@ -93,7 +96,7 @@ struct DeadCodeEliminationContext
     {
         bool result = false;
 
-        module->invalidateAllAnalysis();
+        module->invalidateUntrackedAnalysis();
 
         for (;;)
         {
@@ -696,6 +699,7 @@ bool eliminateDeadCode(IRModule* module, IRDeadCodeEliminationOptions const& opt
     DeadCodeEliminationContext context;
     context.module = module;
     context.options = options;
+    context.workList = InstWorkList(module);
     return context.processModule();
 }
 
@@ -704,6 +708,7 @@ bool eliminateDeadCode(IRInst* root, IRDeadCodeEliminationOptions const& options
     DeadCodeEliminationContext context;
     context.module = root->getModule();
     context.options = options;
+    context.workList = InstWorkList(context.module);
     return context.processInst(root);
 }
 
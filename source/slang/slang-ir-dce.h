@@ -35,4 +35,11 @@ bool shouldInstBeLiveIfParentIsLive(IRInst* inst, IRDeadCodeEliminationOptions o
 bool isWeakReferenceOperand(IRInst* inst, UInt operandIndex);
 
 bool trimOptimizableTypes(IRModule* module);
+
+/// Is the value of `field` read anywhere, either directly or as part of a containing struct?
+bool isFieldUsed(IRStructField* field);
+
+/// Remove the operands for `field` from the `makeStruct`s of its struct type, before the field is
+/// removed. Returns true if changed.
+bool trimMakeStructOperands(IRStructField* field);
 } // namespace Slang
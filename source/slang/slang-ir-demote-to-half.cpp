@@ -0,0 +1,120 @@
+// slang-ir-demote-to-half.cpp
+#include "slang-ir-demote-to-half.h"
+
+#include "slang-ir-insts.h"
+#include "slang-ir.h"
+
+namespace Slang
+{
+
+struct DemoteToHalfContext
+{
+    IRModule* module;
+
+    // Returns the half precision equivalent of a `float` or `vector<float, N>` type, or
+    // nullptr for any other type.
+    IRType* getHalfType(IRBuilder& builder, IRType* type)
+    {
+        if (type->getOp() == kIROp_FloatType)
+            return builder.getBasicType(BaseType::Half);
+        if (auto vectorType = as<IRVectorType>(type))
+        {
+            if (vectorType->getElementType()->getOp() == kIROp_FloatType)
+                return builder.getVectorType(
+                    builder.getBasicType(BaseType::Half),
+                    vectorType->getElementCount());
+        }
+        return nullptr;
+    }
+
+    IRInst* getHalfOperand(IRBuilder& builder, IRType* halfType, IRInst* operand)
+    {
+        // The operand is the result of an operation that has already been demoted, so we
+        // use the half precision value directly. This is exact, since every half value is
+        // representable as a float.
+        if (auto cast = as<IRFloatCast>(operand))
+        {
+            if (isTypeEqual(cast->getOperand(0)->getDataType(), halfType))
+                return cast->getOperand(0);
+        }
+        return builder.emitCast(halfType, operand);
+    }
+
+    bool isDemotableOp(IRInst* inst)
+    {
+        switch (inst->getOp())
+        {
+        case kIROp_Add:
+        case kIROp_Sub:
+        case kIROp_Mul:
+        case kIROp_Div:
+        case kIROp_Neg:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    void demoteInst(IRBuilder& builder, IRInst* inst)
+    {
+        auto type = inst->getDataType();
+        auto halfType = getHalfType(builder, type);
+        if (!halfType)
+            return;
+
+        // Operations that mix a vector with a scalar are left alone.
+        for (UInt i = 0; i < inst->getOperandCount(); i++)
+        {
+            if (!isTypeEqual(inst->getOperand(i)->getDataType(), type))
+                return;
+        }
+
+        builder.setInsertBefore(inst);
+        List<IRInst*> halfOperands;
+        for (UInt i = 0; i < inst->getOperandCount(); i++)
+            halfOperands.add(getHalfOperand(builder, halfType, inst->getOperand(i)));
+        auto halfInst = builder.emitIntrinsicInst(
+            halfType,
+            inst->getOp(),
+            (UInt)halfOperands.getCount(),
+            halfOperands.getBuffer());
+        auto floatInst = builder.emitCast(type, halfInst);
+        inst->replaceUsesWith(floatInst);
+        inst->removeAndDeallocate();
+    }
+
+    void processFunc(IRFunc* func)
+    {
+        IRBuilder builder(module);
+        for (auto block : func->getBlocks())
+        {
+            for (auto inst = block->getFirstInst(); inst;)
+            {
+                auto next = inst->getNextInst();
+                if (isDemotableOp(inst))
+                    demoteInst(builder, inst);
+                inst = next;
+            }
+        }
+    }
+
+    void processModule()
+    {
+        for (auto globalInst : module->getGlobalInsts())
+        {
+            auto func = as<IRFunc>(getResolvedInstForDecorations(globalInst));
+            if (!func || !func->findDecoration<IRPreferHalfDecoration>())
+                continue;
+            processFunc(func);
+        }
+    }
+};
+
+void demoteToHalfPrecision(IRModule* module)
+{
+    DemoteToHalfContext context;
+    context.module = module;
+    context.processModule();
+}
+
+} // namespace Slang
@@ -0,0 +1,24 @@
+// slang-ir-demote-to-half.h
+#pragma once
+
+namespace Slang
+{
+
+/*
+This pass evaluates the floating-point arithmetic of functions marked `[PreferHalf]` at half
+precision. For example, if we see:
+    b = Mul<float>(y, z)
+    c = Add<float>(b, w)
+We rewrite the code into:
+    b = Mul<half>(FloatCast<half>(y), FloatCast<half>(z))
+    c = Add<half>(b, FloatCast<half>(w))
+    c' = FloatCast<float>(c)
+and the uses of `c` are replaced with `c'`. Only the values that leave the arithmetic are
+converted back to `float`, so that chains of operations stay in half precision.
+*/
+
+struct IRModule;
+
+void demoteToHalfPrecision(IRModule* module);
+
+} // namespace Slang
@@ -14,6 +14,11 @@
 // in order to get something up and running with a reasonable level of
 // confidence that the results are correct.
 //
+// For large CFGs, such as those from unrolled loops, we instead use the
+// Semi-NCA algorithm presented in "Finding Dominators in Practice" by
+// Loukas Georgiadis, Robert E. Tarjan, and Renato F. Werneck, which
+// doesn't need to iterate to a fixed point.
+//
 
 #include "slang-ir.h"
 
@@ -322,6 +327,38 @@ struct PostorderComputationContext : public DepthFirstSearchContext
     virtual void postVisit(IRBlock* block) SLANG_OVERRIDE { order->add(block); }
 };
 
+/// A visitor that computes a postorder traversal for a CFG, along with the preorder
+/// traversal and the parent of each block in the depth-first search tree.
+struct DepthFirstSearchTreeComputationContext : public PostorderComputationContext
+{
+    /// The blocks in preorder
+    List<IRBlock*> preorder;
+
+    /// The index in `preorder` of each block
+    Dictionary<IRBlock*, Int> mapBlockToPreorderIndex;
+
+    /// The preorder index of the parent of each block, by preorder index, or -1 for the root
+    List<Int> parents;
+
+    /// The preorder indices of the blocks on the path from the root to the current block
+    List<Int> path;
+
+    virtual void preVisit(IRBlock* block) SLANG_OVERRIDE
+    {
+        Int index = preorder.getCount();
+        preorder.add(block);
+        mapBlockToPreorderIndex[block] = index;
+        parents.add(path.getCount() ? path.getLast() : -1);
+        path.add(index);
+    }
+
+    virtual void postVisit(IRBlock* block) SLANG_OVERRIDE
+    {
+        PostorderComputationContext::postVisit(block);
+        path.removeLast();
+    }
+};
+
 void computeReachableSet(IRGlobalValueWithCode* code, HashSet<IRBlock*>& outSet)
 {
     DepthFirstSearchContext context;
@@ -340,12 +377,12 @@ void computePostorder(IRGlobalValueWithCode* code, List<IRBlock*>& outOrder)
 
 /// Compute a postorder traversal of the blocks in `code`, writing the resulting order to
 /// `outOrder`.
-void computePostorder(
+static void _computePostorder(
     IRGlobalValueWithCode* code,
+    PostorderComputationContext& context,
     List<IRBlock*>& outOrder,
     HashSet<IRBlock*>& outReachableSet)
 {
-    PostorderComputationContext context;
     context.order = &outOrder;
     if (code->getFirstBlock())
         context.walk(code->getFirstBlock(), [](IRBlock* block) { return block->getSuccessors(); });
@@ -364,6 +401,15 @@ void computePostorder(
     outReachableSet = _Move(context.visited);
 }
 
+void computePostorder(
+    IRGlobalValueWithCode* code,
+    List<IRBlock*>& outOrder,
+    HashSet<IRBlock*>& outReachableSet)
+{
+    PostorderComputationContext context;
+    _computePostorder(code, context, outOrder, outReachableSet);
+}
+
 void computePostorderOnReverseCFG(IRGlobalValueWithCode* code, List<IRBlock*>& outOrder)
 {
     PostorderComputationContext context;
@@ -570,6 +616,148 @@ struct DominatorTreeComputationContext
         doms[startNode] = kUndefined;
     }
 
+    //
+    // Each iteration of the algorithm above visits every block, and on
+    // large CFGs the number of iterations, and the length of the walks
+    // in `intersect()`, grow with the size of the CFG. So for CFGs with
+    // at least this many blocks we use Semi-NCA instead, which computes
+    // the same `doms` array in O(N log N) time.
+    //
+    static const Count kMinBlockCountForSemiNCA = 1024;
+
+    //
+    // Semi-NCA works with blocks numbered in the preorder of a depth-first
+    // search. It first computes the semidominator of each block: the
+    // smallest-numbered block `s` with a path to the block on which all
+    // blocks except `s` are numbered after the block. Then the immediate
+    // dominator of a block is its nearest common ancestor, in the tree built
+    // so far, with its semidominator.
+    //
+    // We use the same depth-first search as `computePostorder()` so that
+    // the postorder, and therefore the layout of the dominator tree, is the
+    // same as for Cooper et al.
+    //
+    void computeImmediateDominatorsSemiNCA(IRGlobalValueWithCode* code)
+    {
+        DepthFirstSearchTreeComputationContext dfs;
+        _computePostorder(code, dfs, postorder, reachableSet);
+
+        BlockName blockCount = BlockName(postorder.getCount());
+        for (BlockName bb = 0; bb < blockCount; ++bb)
+        {
+            mapBlockToName[postorder[bb]] = bb;
+        }
+
+        // The predecessors of each reachable block, as preorder indices, with the
+        // predecessors of block `w` at `predIndices[predOffsets[w]]` up to
+        // `predIndices[predOffsets[w + 1]]`.
+        //
+        Count n = dfs.preorder.getCount();
+        List<Int> predOffsets;
+        List<Int> predIndices;
+        predOffsets.setCount(n + 1);
+        for (Int w = 0; w < n; ++w)
+        {
+            predOffsets[w] = predIndices.getCount();
+            for (auto pred : dfs.preorder[w]->getPredecessors())
+            {
+                // Unreachable predecessors don't have a preorder index.
+                if (auto v = dfs.mapBlockToPreorderIndex.tryGetValue(pred))
+                    predIndices.add(*v);
+            }
+        }
+        predOffsets[n] = predIndices.getCount();
+
+        List<Int> idom;
+        computeSemiNCA(dfs.parents, predOffsets, predIndices, idom);
+
+        doms.setCount(blockCount);
+        for (BlockName bb = 0; bb < blockCount; ++bb)
+        {
+            doms[bb] = kUndefined;
+        }
+        for (Int w = 1; w < n; ++w)
+        {
+            doms[getBlockName(dfs.preorder[w])] = getBlockName(dfs.preorder[idom[w]]);
+        }
+    }
+
+    /// Compute the immediate dominator `outIdom[w]` of each node `w` of a graph whose nodes
+    /// are numbered in the preorder of a depth-first search from node 0, where `parents` are
+    /// the parents in the search tree, and `predOffsets` and `predIndices` give the
+    /// predecessors of each node.
+    ///
+    static void computeSemiNCA(
+        List<Int> const& parents,
+        List<Int> const& predOffsets,
+        List<Int> const& predIndices,
+        List<Int>& outIdom)
+    {
+        Count n = parents.getCount();
+
+        // `ancestor` and `label` represent the forest of the nodes processed so
+        // far, linked to their parents, with `label[v]` the node with the
+        // smallest semidominator on the compressed path from `v` to its root.
+        //
+        List<Int> semi;
+        List<Int> ancestor;
+        List<Int> label;
+        semi.setCount(n);
+        ancestor.setCount(n);
+        label.setCount(n);
+        outIdom.setCount(n);
+        for (Int v = 0; v < n; ++v)
+        {
+            semi[v] = v;
+            ancestor[v] = -1;
+            label[v] = v;
+            outIdom[v] = parents[v];
+        }
+
+        List<Int> compressPath;
+        auto eval = [&](Int v)
+        {
+            if (ancestor[v] == -1)
+                return v;
+
+            // Compress the path from `v` up to the child of the root of its tree,
+            // starting from the top of the path.
+            compressPath.clear();
+            for (Int x = v; ancestor[ancestor[x]] != -1; x = ancestor[x])
+                compressPath.add(x);
+            for (Index i = compressPath.getCount() - 1; i >= 0; --i)
+            {
+                Int x = compressPath[i];
+                Int a = ancestor[x];
+                if (semi[label[a]] < semi[label[x]])
+                    label[x] = label[a];
+                ancestor[x] = ancestor[a];
+            }
+            return label[v];
+        };
+
+        for (Int w = n - 1; w > 0; --w)
+        {
+            for (Int i = predOffsets[w]; i < predOffsets[w + 1]; ++i)
+            {
+                Int u = eval(predIndices[i]);
+                if (semi[u] < semi[w])
+                    semi[w] = semi[u];
+            }
+            ancestor[w] = parents[w];
+        }
+
+        // Nodes are processed in preorder, so the immediate dominators of the
+        // ancestors of `w` are already known.
+        for (Int w = 1; w < n; ++w)
+        {
+            Int d = outIdom[w];
+            while (d > semi[w])
+                d = outIdom[d];
+            outIdom[w] = d;
+        }
+    }
+
     //
     // The algorithm above relied on a utility routine `intersect()` that
     // is implicitly used to compute intersections between sets of nodes,
@@ -647,10 +835,20 @@ struct DominatorTreeComputationContext
         if (code->getFirstBlock() == nullptr)
             return nullptr;
 
-        // We first run the Cooper et al. algorithm to compute the `doms` array
-        // which encodes immediate dominators.
+        // We first run the Cooper et al. algorithm, or Semi-NCA for large CFGs,
+        // to compute the `doms` array which encodes immediate dominators.
         //
-        iterativelyComputeImmediateDominators(code);
+        Count codeBlockCount = 0;
+        for (auto block = code->getFirstBlock();
+             block && codeBlockCount < kMinBlockCountForSemiNCA;
+             block = block->getNextBlock())
+        {
+            codeBlockCount++;
+        }
+        if (codeBlockCount >= kMinBlockCountForSemiNCA)
+            computeImmediateDominatorsSemiNCA(code);
+        else
+            iterativelyComputeImmediateDominators(code);
 
         // We will build some intermediate information on each
         // block to help us fill out the tree.
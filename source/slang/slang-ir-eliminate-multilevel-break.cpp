@@ -302,8 +302,29 @@ struct EliminateMultiLevelBreakContext
         }
     }
 
+    static bool hasBreakableRegion(IRGlobalValueWithCode* func)
+    {
+        for (auto block : func->getBlocks())
+        {
+            switch (block->getTerminator()->getOp())
+            {
+            case kIROp_loop:
+            case kIROp_Switch:
+                return true;
+            default:
+                break;
+            }
+        }
+        return false;
+    }
+
     void processFunc(IRGlobalValueWithCode* func)
     {
+        // Most functions have no loop or `switch` to break out of, and can skip
+        // building the region information altogether.
+        if (!hasBreakableRegion(func))
+            return;
+
         normalizeBranchesIntoBreakBlocks(func);
 
         // If func does not have any multi-level breaks, return.
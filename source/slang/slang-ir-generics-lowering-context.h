@@ -39,6 +39,10 @@ struct SharedGenericsLoweringContext
     // Map from interface requirement keys to its corresponding dispatch method.
     OrderedDictionary<IRInst*, IRFunc*> mapInterfaceRequirementKeyToDispatchMethods;
 
+    // Map from interface types with a `[SpecializationConstantDispatch]` attribute to the
+    // specialization constant that their dispatch functions switch on.
+    Dictionary<IRInst*, IRGlobalParam*> mapInterfaceToDispatchSelector;
+
     // We will use a single work list of instructions that need
     // to be considered for lowering.
     //
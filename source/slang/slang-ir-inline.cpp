@@ -2,6 +2,7 @@
 #include "slang-ir-inline.h"
 
 #include "../core/slang-performance-profiler.h"
+#include "slang-ir-call-graph.h"
 #include "slang-ir-ssa-simplification.h"
 // This file provides general facilities for inlining function calls.
 
@@ -18,6 +19,7 @@
 
 #include "slang-ir-clone.h"
 #include "slang-ir-insts.h"
+#include "slang-ir-optimization-remarks.h"
 #include "slang-ir.h"
 
 namespace Slang
@@ -37,7 +39,40 @@ struct InliningPassBase
     }
 
     /// Consider all the call sites in the module for inlining
-    bool considerAllCallSites() { return considerAllCallSitesRec(m_module->getModuleInst()); }
+    ///
+    /// Functions are visited callees first, so that by the time a call site is
+    /// inlined the body of its callee has already had its own call sites inlined.
+    /// Each callee body is then only processed once, instead of once more for
+    /// every copy of it inlined into a caller, which matters for deep call chains.
+    ///
+    bool considerAllCallSites()
+    {
+        bool changed = false;
+        for (auto func : getFuncsInCalleeFirstOrder(m_module->getModuleInst()))
+        {
+            changed |= considerCallSiteInFunc(func);
+        }
+        changed |= considerCallSitesOutsideFuncsRec(m_module->getModuleInst());
+        return changed;
+    }
+
+    /// Consider the call sites at or under `inst` that aren't inside a function
+    bool considerCallSitesOutsideFuncsRec(IRInst* inst)
+    {
+        if (as<IRFunc>(inst))
+            return false;
+
+        bool changed = false;
+        if (auto call = as<IRCall>(inst))
+        {
+            changed = considerCallSite(call);
+        }
+        for (auto child : inst->getModifiableChildren())
+        {
+            changed |= considerCallSitesOutsideFuncsRec(child);
+        }
+        return changed;
+    }
 
     bool considerCallSiteInFunc(IRFunc* func)
     {
@@ -842,11 +877,47 @@ struct ForceInliningPass : InliningPassBase
 
     bool shouldInline(CallSiteInfo const& info)
     {
-        if (info.callee->findDecoration<IRForceInlineDecoration>() ||
-            info.callee->findDecoration<IRUnsafeForceInlineEarlyDecoration>() ||
+        if (info.callee->findDecoration<IRUnsafeForceInlineEarlyDecoration>() ||
             info.callee->findDecoration<IRIntrinsicOpDecoration>())
             return true;
-        return false;
+
+        bool result = info.callee->findDecoration<IRForceInlineDecoration>() != nullptr;
+        if (auto remarks = m_module->getOptimizationRemarks())
+            addRemark(remarks, info, result);
+        return result;
+    }
+
+    static void addRemark(OptimizationRemarks* remarks, CallSiteInfo const& info, bool inlined)
+    {
+        // Functions that are implemented by the target, like most of the core module, have
+        // nothing to inline.
+        if (info.callee->findDecoration<IRTargetIntrinsicDecoration>() ||
+            hasGenericAsmInst(info.callee))
+            return;
+
+        const char* reason = "the callee is marked [ForceInline]";
+        if (!inlined)
+        {
+            reason = info.callee->findDecoration<IRNoInlineDecoration>()
+                         ? "the callee is marked [noinline]"
+                         : "the callee isn't marked [ForceInline]";
+        }
+        Count calleeInstCount = 0;
+        for (auto block : info.callee->getBlocks())
+        {
+            for (auto inst : block->getChildren())
+            {
+                SLANG_UNUSED(inst);
+                calleeInstCount++;
+            }
+        }
+        remarks->add(
+            "inline",
+            inlined,
+            getDiagnosticPos(info.call),
+            info.callee,
+            reason,
+            calleeInstCount);
     }
 };
 
@@ -855,6 +855,10 @@ INST_RANGE(BindingQuery, GetRegisterIndex, GetRegisterSpace)
     INST(AutoPyBindCudaDecoration,          AutoPyBindCUDA,         0, 0)
     INST(CudaKernelForwardDerivativeDecoration,          CudaKernelFwdDiffRef,         0, 0)
     INST(CudaKernelBackwardDerivativeDecoration,         CudaKernelBwdDiffRef,         0, 0)
+
+        /// Marks a CUDA kernel with the variant of it in which the views of scalar tensors have a
+        /// contiguous innermost dimension, which a launch of the kernel can use instead.
+    INST(CudaKernelContiguousVariantDecoration,          CudaKernelContiguousVariant,  1, 0)
     INST(AutoPyBindExportInfoDecoration,    PyBindExportFuncInfo,   0, 0)
     INST(PyExportDecoration,    PyExportDecoration,   0, 0)
     
@@ -923,6 +927,9 @@ INST_RANGE(BindingQuery, GetRegisterIndex, GetRegisterSpace)
     INST(RTTITypeSizeDecoration, RTTI_typeSize, 1, 0)
     INST(AnyValueSizeDecoration, AnyValueSize, 1, 0)
     INST(SpecializeDecoration, SpecializeDecoration, 0, 0)
+        /// Selects the implementation of an interface in its dispatch functions with the
+        /// specialization constant of the given ID.
+    INST(SpecializationConstantDispatchDecoration, SpecializationConstantDispatchDecoration, 1, 0)
     INST(SequentialIDDecoration, SequentialIDDecoration, 1, 0)
     INST(DynamicDispatchWitnessDecoration, DynamicDispatchWitnessDecoration, 0, 0)
     INST(StaticRequirementDecoration, StaticRequirementDecoration, 0, 0)
@@ -946,6 +953,9 @@ INST_RANGE(BindingQuery, GetRegisterIndex, GetRegisterSpace)
     INST(NoInlineDecoration, noInline, 0, 0)
     INST(NoRefInlineDecoration, noRefInline, 0, 0)
 
+        /// Applied to an IR function whose float arithmetic should be evaluated at half precision.
+    INST(PreferHalfDecoration, preferHalf, 0, 0)
+
     INST(DerivativeGroupQuadDecoration, DerivativeGroupQuad, 0, 0)
     INST(DerivativeGroupLinearDecoration, DerivativeGroupLinear, 0, 0)
 
@@ -1093,6 +1103,12 @@ INST_RANGE(BindingQuery, GetRegisterIndex, GetRegisterSpace)
         /// Hint that a struct is used for reverse mode checkpointing
     INST(CheckpointIntermediateDecoration, CheckpointIntermediateDecoration, 1, 0)
 
+        /// Selects the `SlangAutodiffCheckpointPolicy` of the backward derivative of a function.
+    INST(CheckpointPolicyDecoration, CheckpointPolicyDecoration, 1, 0)
+
+        /// Marks the global buffer that the counters of an instrumented program are written to.
+    INST(ProfileCountersDecoration, ProfileCountersDecoration, 0, 0)
+
     INST_RANGE(CheckpointHintDecoration, PreferCheckpointDecoration, PreferRecomputeDecoration)
 
         /// Marks a function whose return value is never dynamic uniform.
@@ -250,6 +250,18 @@ struct IRAnyValueSizeDecoration : IRDecoration
     IRIntegerValue getSize() { return getSizeOperand()->getValue(); }
 };
 
+struct IRSpecializationConstantDispatchDecoration : IRDecoration
+{
+    enum
+    {
+        kOp = kIROp_SpecializationConstantDispatchDecoration
+    };
+    IR_LEAF_ISA(SpecializationConstantDispatchDecoration)
+
+    IRIntLit* getConstantIdOperand() { return cast<IRIntLit>(getOperand(0)); }
+    IRIntegerValue getConstantId() { return getConstantIdOperand()->getValue(); }
+};
+
 struct IRDispatchFuncDecoration : IRDecoration
 {
     enum
@@ -443,6 +455,7 @@ IR_SIMPLE_DECORATION(KeepAliveDecoration)
 IR_SIMPLE_DECORATION(RequiresNVAPIDecoration)
 IR_SIMPLE_DECORATION(NoInlineDecoration)
 IR_SIMPLE_DECORATION(NoRefInlineDecoration)
+IR_SIMPLE_DECORATION(PreferHalfDecoration)
 IR_SIMPLE_DECORATION(DerivativeGroupQuadDecoration)
 IR_SIMPLE_DECORATION(DerivativeGroupLinearDecoration)
 IR_SIMPLE_DECORATION(AlwaysFoldIntoUseSiteDecoration)
@@ -637,6 +650,17 @@ struct IRCudaKernelBackwardDerivativeDecoration : IRDecoration
     IRInst* getBackwardDerivativeFunc() { return getOperand(0); }
 };
 
+struct IRCudaKernelContiguousVariantDecoration : IRDecoration
+{
+    enum
+    {
+        kOp = kIROp_CudaKernelContiguousVariantDecoration
+    };
+    IR_LEAF_ISA(CudaKernelContiguousVariantDecoration)
+
+    IRFunc* getContiguousVariantFunc() { return cast<IRFunc>(getOperand(0)); }
+};
+
 struct IRGeometryInputPrimitiveTypeDecoration : IRDecoration
 {
     IR_PARENT_ISA(GeometryInputPrimitiveTypeDecoration)
@@ -1036,6 +1060,24 @@ struct IRCheckpointIntermediateDecoration : IRCheckpointHintDecoration
     IRInst* getSourceFunction() { return getOperand(0); }
 };
 
+struct IRCheckpointPolicyDecoration : IRDecoration
+{
+    enum
+    {
+        kOp = kIROp_CheckpointPolicyDecoration
+    };
+    IR_LEAF_ISA(CheckpointPolicyDecoration)
+
+    IRIntLit* getPolicyOperand() { return cast<IRIntLit>(getOperand(0)); }
+
+    SlangAutodiffCheckpointPolicy getPolicy()
+    {
+        return (SlangAutodiffCheckpointPolicy)getPolicyOperand()->getValue();
+    }
+};
+
+IR_SIMPLE_DECORATION(ProfileCountersDecoration)
+
 struct IRLoopCounterDecoration : IRDecoration
 {
     enum
@@ -3700,6 +3742,7 @@ public:
 
     IRArrayListType* getArrayListType(IRType* elementType);
     IRTensorViewType* getTensorViewType(IRType* elementType);
+    IRTensorViewType* getContiguousTensorViewType(IRType* elementType);
     IRTorchTensorType* getTorchTensorType(IRType* elementType);
 
     IRDifferentialPairType* getDifferentialPairType(IRType* valueType, IRInst* witnessTable);
@@ -3843,7 +3886,9 @@ public:
         IRInst* gridDim,
         IRInst* blockDim,
         IRInst* argsArray,
-        IRInst* cudaStream);
+        IRInst* cudaStream,
+        IRInst* contiguousVariantFn = nullptr,
+        List<IRInst*> const& contiguousTensors = List<IRInst*>());
     IRInst* emitGetTorchCudaStream();
 
     IRInst* emitMakeDifferentialPair(IRType* type, IRInst* primal, IRInst* differential);
@@ -4993,6 +5038,11 @@ public:
         addDecoration(value, kIROp_CudaKernelBackwardDerivativeDecoration, func);
     }
 
+    void addCudaKernelContiguousVariantDecoration(IRInst* value, IRInst* func)
+    {
+        addDecoration(value, kIROp_CudaKernelContiguousVariantDecoration, func);
+    }
+
     void addAutoPyBindExportInfoDecoration(IRInst* value)
     {
         addDecoration(value, kIROp_AutoPyBindExportInfoDecoration);
@@ -3844,7 +3844,14 @@ struct IRTypeLegalizationPass
             //
             List<IRInst*> workListCopy = _Move(workList);
 
-            resetScratchDataBit(module->getModuleInst(), kHasBeenAddedScratchBitIndex);
+            // Only the instructions on the work list can have the "added" bit set, so it is
+            // cleared from them rather than from every instruction in the module, which
+            // would make each step cost as much as the module is large.
+            //
+            for (auto inst : workListCopy)
+            {
+                inst->scratchData &= ~(1u << kHasBeenAddedScratchBitIndex);
+            }
 
             // Now we simply process each instruction on the copy of
             // the work list, knowing that `processInst` may add additional
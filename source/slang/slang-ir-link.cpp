@@ -27,6 +27,11 @@ struct IRSpecSymbol : RefObject
 {
     IRInst* irGlobalValue;
     RefPtr<IRSpecSymbol> nextWithSameName;
+
+    // The value in this list that is best for the target, once it
+    // has been chosen. Only set on the first symbol of the list.
+    IRInst* bestValueForTarget = nullptr;
+    bool isBestValueForTargetChosen = false;
 };
 
 struct IRSpecEnv
@@ -46,13 +51,26 @@ struct IRSharedSpecContext
     // The API-level target request
     TargetRequest* targetReq = nullptr;
 
+    // The capabilities of the target
+    CapabilitySet targetCaps;
+
+    // The capabilities of the best target specialization of each
+    // value that has been considered for the target.
+    Dictionary<IRInst*, CapabilitySet> specializationCaps;
+
     // The specialized module we are building
     RefPtr<IRModule> module;
 
+    // The modules being linked, and the other
+    // information found in them. They are owned
+    // by the `TargetProgram` being linked for.
+    IRLinkSymbols* linkSymbols = nullptr;
+
     // A map from mangled symbol names to zero or
     // more global IR values that have that name,
-    // in the *original* module.
-    typedef Dictionary<String, RefPtr<IRSpecSymbol>> SymbolDictionary;
+    // in the *original* modules. Symbols are only
+    // added when they are first looked up.
+    typedef Dictionary<MangledNamePool::Id, RefPtr<IRSpecSymbol>> SymbolDictionary;
     SymbolDictionary symbols;
 
     IRBuilder builderStorage;
@@ -69,7 +87,8 @@ struct IRSpecContextBase
 
     IRModule* getModule() { return getShared()->module; }
 
-    IRSharedSpecContext::SymbolDictionary& getSymbols() { return getShared()->symbols; }
+    /// Find the global values named `mangledName` in the modules being linked.
+    IRSpecSymbol* findSymbol(String const& mangledName);
 
     // The current specialization environment to use.
     IRSpecEnv* env = nullptr;
@@ -94,6 +113,45 @@ struct IRSpecContextBase
     virtual IRInst* maybeCloneValue(IRInst* originalVal) { return originalVal; }
 };
 
+IRSpecSymbol* IRSpecContextBase::findSymbol(String const& mangledName)
+{
+    // The name is only hashed to find its id, the lookups below just compare ids
+    const auto id = MangledNamePool::getSingleton().add(mangledName.getUnownedSlice());
+
+    auto& symbols = getShared()->symbols;
+    if (auto found = symbols.tryGetValue(id))
+        return *found;
+
+    // The first value found is the head of the list, and the others
+    // are inserted right after it, so that those found last come first.
+    //
+    RefPtr<IRSpecSymbol> first;
+    for (auto module : getShared()->linkSymbols->modules)
+    {
+        auto insts = module->getMangledNameIndex().tryGetValue(id);
+        if (!insts)
+            continue;
+        for (auto inst : *insts)
+        {
+            RefPtr<IRSpecSymbol> sym = new IRSpecSymbol();
+            sym->irGlobalValue = inst;
+            if (first)
+            {
+                sym->nextWithSameName = first->nextWithSameName;
+                first->nextWithSameName = sym;
+            }
+            else
+            {
+                first = sym;
+            }
+        }
+    }
+
+    // Names that aren't found are remembered too.
+    symbols.add(id, first);
+    return first;
+}
+
 void registerClonedValue(IRSpecContextBase* context, IRInst* clonedValue, IRInst* originalValue)
 {
     if (!originalValue)
@@ -668,12 +726,78 @@ IRInterfaceType* cloneInterfaceTypeImpl(
     return clonedInterface;
 }
 
+// Find the blocks of `code` that are still reachable once every `__target_switch` in it
+// branches to the case for the target, which is recorded in `outTargetSwitchCases`.
+//
+// Returns false if there is no target switch that can be resolved, in which case every
+// block is needed.
+//
+static bool _findBlocksReachableForTarget(
+    IRSpecContextBase* context,
+    IRGlobalValueWithCode* code,
+    HashSet<IRBlock*>& outReachableBlocks,
+    Dictionary<IRInst*, IRBlock*>& outTargetSwitchCases)
+{
+    auto targetReq = context->getShared()->targetReq;
+    if (!targetReq)
+        return false;
+
+    for (auto block : code->getBlocks())
+    {
+        auto targetSwitch = as<IRTargetSwitch>(block->getTerminator());
+        if (!targetSwitch)
+            continue;
+
+        // A switch without a matching case is left to `specializeTargetSwitch`, which
+        // diagnoses it.
+        bool failedImplies = false;
+        if (auto caseBlock = findTargetSwitchCase(targetReq, targetSwitch, failedImplies))
+            outTargetSwitchCases.add(targetSwitch, caseBlock);
+    }
+    if (outTargetSwitchCases.getCount() == 0)
+        return false;
+
+    List<IRBlock*> workList;
+    workList.add(code->getFirstBlock());
+    outReachableBlocks.add(code->getFirstBlock());
+    while (workList.getCount())
+    {
+        auto block = workList.getLast();
+        workList.removeLast();
+
+        auto addSuccessor = [&](IRBlock* successor)
+        {
+            if (outReachableBlocks.add(successor))
+                workList.add(successor);
+        };
+        if (auto caseBlock = outTargetSwitchCases.tryGetValue(block->getTerminator()))
+        {
+            addSuccessor(*caseBlock);
+            continue;
+        }
+        for (auto successor : block->getSuccessors())
+            addSuccessor(successor);
+    }
+    return true;
+}
+
 void cloneGlobalValueWithCodeCommon(
     IRSpecContextBase* context,
     IRGlobalValueWithCode* clonedValue,
     IRGlobalValueWithCode* originalValue,
     IROriginalValuesForClone const& originalValues)
 {
+    // The cases of a `__target_switch` for other targets would otherwise pull everything
+    // they call into the linked module, only to be removed again by `specializeTargetSwitch`,
+    // so the switches are resolved here, and the blocks only reachable through other cases
+    // are not cloned.
+    //
+    HashSet<IRBlock*> reachableBlocks;
+    Dictionary<IRInst*, IRBlock*> targetSwitchCases;
+    const bool pruneBlocks =
+        _findBlocksReachableForTarget(context, originalValue, reachableBlocks, targetSwitchCases);
+    List<IRBlock*> prunedBlocks;
+
     // Next we are going to clone the actual code.
     IRBuilder builderStorage = *context->builder;
     IRBuilder* builder = &builderStorage;
@@ -727,9 +851,23 @@ void cloneGlobalValueWithCodeCommon(
             SLANG_ASSERT(cb);
 
             builder->setInsertInto(cb);
+            if (pruneBlocks && !reachableBlocks.contains(ob))
+            {
+                // The block may still be named as the merge point of a construct that is
+                // cloned, so it is kept until it is known to be unused.
+                builder->emitUnreachable();
+                prunedBlocks.add(cb);
+                ob = ob->getNextBlock();
+                cb = cb->getNextBlock();
+                continue;
+            }
             for (auto oi = ob->getFirstInst(); oi; oi = oi->getNextInst())
             {
-                if (oi->getOp() == kIROp_Param)
+                if (auto caseBlock = targetSwitchCases.tryGetValue(oi))
+                {
+                    builder->emitBranch(as<IRBlock>(cloneValue(context, *caseBlock)));
+                }
+                else if (oi->getOp() == kIROp_Param)
                 {
                     // Params may have forward references in its type and
                     // decorations, so we just create a placeholder for it
@@ -756,6 +894,12 @@ void cloneGlobalValueWithCodeCommon(
             cb = cb->getNextBlock();
         }
     }
+
+    for (auto block : prunedBlocks)
+    {
+        if (!block->hasUses())
+            block->removeAndDeallocate();
+    }
 }
 
 void checkIRDuplicate(IRInst* inst, IRInst* moduleInst, UnownedStringSlice const& mangledName)
@@ -886,12 +1030,13 @@ IRFunc* specializeIRForEntryPoint(
     // so that the mangled name of the decl-ref is
     // not the same as the mangled name of the decl.
     //
-    RefPtr<IRSpecSymbol> sym;
-    if (!context->getSymbols().tryGetValue(mangledName, sym))
+    RefPtr<IRSpecSymbol> sym = context->findSymbol(mangledName);
+    if (!sym)
     {
         String hashedName = getHashedName(mangledName.getUnownedSlice());
 
-        if (!context->getSymbols().tryGetValue(hashedName, sym))
+        sym = context->findSymbol(hashedName);
+        if (!sym)
         {
             SLANG_UNEXPECTED("no matching IR symbol");
             return nullptr;
@@ -1017,9 +1162,9 @@ IRFunc* specializeIRForEntryPoint(
 // Get a string form of the target so that we can
 // use it to match against target-specialization modifiers
 //
-CapabilitySet getTargetCapabilities(IRSpecContext* context)
+CapabilitySet const& getTargetCapabilities(IRSpecContext* context)
 {
-    return context->getShared()->targetReq->getTargetCaps();
+    return context->getShared()->targetCaps;
 }
 
 /// Get the most appropriate ("best") capability requirements for `inVal` based on the `targetCaps`.
@@ -1047,6 +1192,16 @@ static CapabilitySet _getBestSpecializationCaps(IRInst* inVal, CapabilitySet con
     }
 }
 
+/// Get the best specialization caps of `val` for the target, computing them the first time.
+static CapabilitySet const& _getBestSpecializationCaps(IRSpecContext* context, IRInst* val)
+{
+    auto& specializationCaps = context->getShared()->specializationCaps;
+    if (auto found = specializationCaps.tryGetValue(val))
+        return *found;
+    auto caps = _getBestSpecializationCaps(val, getTargetCapabilities(context));
+    return specializationCaps.getOrAddValue(val, caps);
+}
+
 // Is `newVal` marked as being a better match for our
 // chosen code-generation target?
 //
@@ -1099,9 +1254,12 @@ bool isBetterForTarget(IRSpecContext* context, IRInst* newVal, IRInst* oldVal)
     // push back on the automatic inference of extensions/versions in
     // the compiler as much as possible.
     //
-    CapabilitySet targetCaps = getTargetCapabilities(context);
-    CapabilitySet newCaps = _getBestSpecializationCaps(newVal, targetCaps);
-    CapabilitySet oldCaps = _getBestSpecializationCaps(oldVal, targetCaps);
+    // Finding the caps of `oldVal` may add to the cache and move the caps
+    // found for `newVal`, so those are copied.
+    //
+    auto& targetCaps = getTargetCapabilities(context);
+    CapabilitySet newCaps = _getBestSpecializationCaps(context, newVal);
+    auto& oldCaps = _getBestSpecializationCaps(context, oldVal);
 
     // If either value returned an invalid capability set, it implies
     // that it cannot be used on this target at all, and the other
@@ -1327,8 +1485,8 @@ IRInst* cloneGlobalValueWithLinkage(
     // to pick the "best" one for our target.
 
     auto mangledName = String(originalLinkage->getMangledName());
-    RefPtr<IRSpecSymbol> sym;
-    if (!context->getSymbols().tryGetValue(mangledName, sym))
+    RefPtr<IRSpecSymbol> sym = context->findSymbol(mangledName);
+    if (!sym)
     {
         if (!originalVal)
             return nullptr;
@@ -1344,13 +1502,21 @@ IRInst* cloneGlobalValueWithLinkage(
     // more specialized for the chosen target. Otherwise, we simply favor
     // definitions over declarations.
     //
-    IRInst* bestVal = nullptr;
-    for (IRSpecSymbol* ss = sym; ss; ss = ss->nextWithSameName)
+    // The choice only depends on the target, so it is made once for each symbol.
+    //
+    if (!sym->isBestValueForTargetChosen)
     {
-        IRInst* newVal = ss->irGlobalValue;
-        if (isBetterForTarget(context, newVal, bestVal))
-            bestVal = newVal;
+        IRInst* bestVal = nullptr;
+        for (IRSpecSymbol* ss = sym; ss; ss = ss->nextWithSameName)
+        {
+            IRInst* newVal = ss->irGlobalValue;
+            if (isBetterForTarget(context, newVal, bestVal))
+                bestVal = newVal;
+        }
+        sym->bestValueForTarget = bestVal;
+        sym->isBestValueForTargetChosen = true;
     }
+    IRInst* bestVal = sym->bestValueForTarget;
 
     if (!bestVal)
     {
@@ -1385,44 +1551,6 @@ IRInst* cloneGlobalValue(IRSpecContext* context, IRInst* originalVal)
         originalVal->findDecoration<IRLinkageDecoration>());
 }
 
-void insertGlobalValueSymbol(IRSharedSpecContext* sharedContext, IRInst* gv)
-{
-    auto linkage = gv->findDecoration<IRLinkageDecoration>();
-
-    // Don't try to register a symbol for global values
-    // that don't have linkage.
-    //
-    if (!linkage)
-        return;
-
-    auto mangledName = String(linkage->getMangledName());
-
-    RefPtr<IRSpecSymbol> sym = new IRSpecSymbol();
-    sym->irGlobalValue = gv;
-
-    RefPtr<IRSpecSymbol> prev;
-    if (sharedContext->symbols.tryGetValue(mangledName, prev))
-    {
-        sym->nextWithSameName = prev->nextWithSameName;
-        prev->nextWithSameName = sym;
-    }
-    else
-    {
-        sharedContext->symbols.add(mangledName, sym);
-    }
-}
-
-void insertGlobalValueSymbols(IRSharedSpecContext* sharedContext, IRModule* originalModule)
-{
-    if (!originalModule)
-        return;
-
-    for (auto ii : originalModule->getGlobalInsts())
-    {
-        insertGlobalValueSymbol(sharedContext, ii);
-    }
-}
-
 void initializeSharedSpecContext(
     IRSharedSpecContext* sharedContext,
     Session* session,
@@ -1441,6 +1569,7 @@ void initializeSharedSpecContext(
     sharedContext->module = module;
     sharedContext->target = target;
     sharedContext->targetReq = targetReq;
+    sharedContext->targetCaps = targetReq->getTargetCaps();
 }
 
 struct IRSpecializationState
@@ -1734,17 +1863,105 @@ void GLSLReplaceAtomicUint(IRSpecContext* context, TargetProgram* targetProgram,
     convertAtomicToStorageBuffer(context, bindingToInstMapUnsorted);
 }
 
+IRLinkSymbols* TargetProgram::getIRLinkSymbols(IRModule* irModuleForLayout)
+{
+    if (irModuleForLayout != m_irLinkSymbolsModuleForLayout)
+        return nullptr;
+    return m_irLinkSymbols;
+}
+
+void TargetProgram::setIRLinkSymbols(IRModule* irModuleForLayout, IRLinkSymbols* linkSymbols)
+{
+    m_irLinkSymbols = linkSymbols;
+    m_irLinkSymbolsModuleForLayout = irModuleForLayout;
+}
+
+IRLinkModuleSymbols* ComponentType::getOrCreateIRLinkModuleSymbols()
+{
+    // The targets of a thread safe linkage can be compiled on several threads at once.
+    auto threadSafetyLock = getLinkage()->lockIfThreadSafe();
+    if (m_irLinkModuleSymbols)
+        return m_irLinkModuleSymbols;
+
+    RefPtr<IRLinkModuleSymbols> moduleSymbols = new IRLinkModuleSymbols();
+
+    // Link the core modules.
+    auto& coreModules = static_cast<Session*>(getLinkage()->getGlobalSession())->coreModules;
+    for (auto& m : coreModules)
+        moduleSymbols->modules.add(m->getIRModule());
+
+    // Link modules in the program.
+    enumerateIRModules([&](IRModule* irModule) { moduleSymbols->modules.add(irModule); });
+
+    bool shouldCopyGlobalParams =
+        getLinkage()->m_optionSet.getBoolOption(CompilerOptionName::PreserveParameters);
+
+    for (IRModule* irModule : moduleSymbols->modules)
+    {
+        // Combine all of the contents of IRGlobalHashedStringLiterals
+        findGlobalHashedStringLiterals(irModule, moduleSymbols->hashedStringLiterals);
+
+        for (auto inst : irModule->getGlobalInsts())
+        {
+            if (as<IRBindGlobalGenericParam>(inst))
+            {
+                moduleSymbols->globalGenericParamBindings.add(inst);
+            }
+        }
+    }
+
+    for (IRModule* irModule : moduleSymbols->modules)
+    {
+        for (auto inst : irModule->getGlobalInsts())
+        {
+            // We need to copy over exported symbols,
+            // and any global parameters if preserve-params option is set.
+            if (_isHLSLExported(inst) || shouldCopyGlobalParams && as<IRGlobalParam>(inst))
+            {
+                moduleSymbols->keepAliveInsts.add(inst);
+            }
+        }
+    }
+
+    m_irLinkModuleSymbols = moduleSymbols;
+    return m_irLinkModuleSymbols;
+}
+
+static RefPtr<IRLinkSymbols> _findIRLinkSymbols(
+    IRLinkModuleSymbols* moduleSymbols,
+    IRModule* irModuleForLayout)
+{
+    RefPtr<IRLinkSymbols> linkSymbols = new IRLinkSymbols();
+    linkSymbols->moduleSymbols = moduleSymbols;
+
+    // Symbols are looked up in any modules that were loaded as libraries.
+    //
+    // We will also look them up in the IR module attached to the
+    // `TargetProgram`, since this module is responsible for associating
+    // layout information to those global symbols via decorations.
+    //
+    for (auto& irModule : moduleSymbols->modules)
+        linkSymbols->modules.add(irModule);
+    if (irModuleForLayout)
+        linkSymbols->modules.add(irModuleForLayout);
+
+    return linkSymbols;
+}
+
 LinkedIR linkIR(CodeGenContext* codeGenContext)
 {
     SLANG_PROFILE;
 
-    auto linkage = codeGenContext->getLinkage();
     auto program = codeGenContext->getProgram();
     auto session = codeGenContext->getSession();
     auto target = codeGenContext->getTargetFormat();
     auto targetProgram = codeGenContext->getTargetProgram();
     auto targetReq = codeGenContext->getTargetReq();
 
+    // The modules imported with `LowerReferencedFunctionsOnly` get the IR for the functions
+    // referenced since they were lowered, before we gather the IR to link.
+    program->getLinkage()->generatePendingModuleIR(codeGenContext->getSink());
+
     // TODO: We need to make sure that the program we are being asked
     // to compile has been "resolved" so that it has no outstanding
     // unsatisfied requirements.
@@ -1767,42 +1984,27 @@ LinkedIR linkIR(CodeGenContext* codeGenContext)
     // accelerate lookup, we will create a symbol table for looking
     // up IR definitions by their mangled name.
     //
+    // The modules being linked are the same for every entry point of the
+    // target program, so the symbols are only found by the first one; and
+    // the symbols that don't depend on the target are only found by the
+    // first target the program is compiled for.
+    //
+    auto irModuleForLayout = targetProgram->getExistingIRModuleForLayout();
 
-    List<IRModule*> irModules;
-
-    // Link the core modules.
-    auto& coreModules = static_cast<Session*>(linkage->getGlobalSession())->coreModules;
-    for (auto& m : coreModules)
-        irModules.add(m->getIRModule());
-
-    // Link modules in the program.
-    program->enumerateIRModules([&](IRModule* irModule) { irModules.add(irModule); });
-
-    // Add any modules that were loaded as libraries
-    for (IRModule* irModule : irModules)
+    RefPtr<IRLinkSymbols> linkSymbols = targetProgram->getIRLinkSymbols(irModuleForLayout);
+    if (!linkSymbols)
     {
-        insertGlobalValueSymbols(sharedContext, irModule);
+        linkSymbols =
+            _findIRLinkSymbols(program->getOrCreateIRLinkModuleSymbols(), irModuleForLayout);
+        targetProgram->setIRLinkSymbols(irModuleForLayout, linkSymbols);
     }
-
-    // We will also insert the IR global symbols from the IR module
-    // attached to the `TargetProgram`, since this module is
-    // responsible for associating layout information to those
-    // global symbols via decorations.
-    //
-    auto irModuleForLayout = targetProgram->getExistingIRModuleForLayout();
-    insertGlobalValueSymbols(sharedContext, irModuleForLayout);
+    IRLinkModuleSymbols* moduleSymbols = linkSymbols->moduleSymbols;
+    auto& irModules = moduleSymbols->modules;
+    sharedContext->linkSymbols = linkSymbols;
 
     auto context = state->getContext();
 
-    // Combine all of the contents of IRGlobalHashedStringLiterals
-    {
-        StringSlicePool pool(StringSlicePool::Style::Empty);
-        for (IRModule* irModule : irModules)
-        {
-            findGlobalHashedStringLiterals(irModule, pool);
-        }
-        addGlobalHashedStringLiterals(pool, state->irModule);
-    }
+    addGlobalHashedStringLiterals(moduleSymbols->hashedStringLiterals, state->irModule);
 
     // Set up shared and builder insert point
 
@@ -1866,34 +2068,17 @@ LinkedIR linkIR(CodeGenContext* codeGenContext)
     // instructions in all the input modules.
     //
 
-    for (IRModule* irModule : irModules)
+    for (auto bindInst : moduleSymbols->globalGenericParamBindings)
     {
-        for (auto inst : irModule->getGlobalInsts())
-        {
-            if (auto bindInst = as<IRBindGlobalGenericParam>(inst))
-            {
-                cloneValue(context, bindInst);
-            }
-        }
+        cloneValue(context, bindInst);
     }
 
-    bool shouldCopyGlobalParams =
-        linkage->m_optionSet.getBoolOption(CompilerOptionName::PreserveParameters);
-
-    for (IRModule* irModule : irModules)
+    for (auto inst : moduleSymbols->keepAliveInsts)
     {
-        for (auto inst : irModule->getGlobalInsts())
+        auto cloned = cloneValue(context, inst);
+        if (!cloned->findDecorationImpl(kIROp_KeepAliveDecoration))
         {
-            // We need to copy over exported symbols,
-            // and any global parameters if preserve-params option is set.
-            if (_isHLSLExported(inst) || shouldCopyGlobalParams && as<IRGlobalParam>(inst))
-            {
-                auto cloned = cloneValue(context, inst);
-                if (!cloned->findDecorationImpl(kIROp_KeepAliveDecoration))
-                {
-                    context->builder->addKeepAliveDecoration(cloned);
-                }
-            }
+            context->builder->addKeepAliveDecoration(cloned);
         }
     }
 
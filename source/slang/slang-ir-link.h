@@ -2,12 +2,53 @@
 #pragma once
 
 #include "../compiler-core/slang-artifact-associated.h"
+#include "../core/slang-string-slice-pool.h"
 #include "slang-compiler.h"
 
 namespace Slang
 {
 struct IRVarLayout;
 
+/// What linking needs to know about the modules a program is linked from, which is the same
+/// for every target.
+///
+/// Finding it means visiting every global instruction of every module the program
+/// depends on, including the core module, while linking an entry point usually only
+/// clones a small part of them. A `ComponentType` therefore finds it once, and shares
+/// it between the targets it is compiled for.
+///
+struct IRLinkModuleSymbols : RefObject
+{
+    /// The modules linked from, which are the core modules and those of the program.
+    ///
+    /// They are held so that the IR of a module isn't released, as by
+    /// `CompilerOptionName::CompressIdleModuleIR`, while the symbols refer to it.
+    List<RefPtr<IRModule>> modules;
+
+    /// The bindings of global generic parameters, which are always cloned.
+    List<IRInst*> globalGenericParamBindings;
+
+    /// The exported values, and the global parameters if they are preserved, which are
+    /// always cloned.
+    List<IRInst*> keepAliveInsts;
+
+    /// The hashed string literals of all the modules.
+    StringSlicePool hashedStringLiterals = StringSlicePool(StringSlicePool::Style::Empty);
+};
+
+/// What linking needs to know about the modules a target program is linked from.
+///
+/// A `TargetProgram` finds it once, and shares it between the entry points it links.
+///
+struct IRLinkSymbols : RefObject
+{
+    /// The modules to look up symbols in, by their mangled name index.
+    List<IRModule*> modules;
+
+    /// The symbols of the modules that don't depend on the target.
+    RefPtr<IRLinkModuleSymbols> moduleSymbols;
+};
+
 struct LinkedIR
 {
     RefPtr<IRModule> module;
@@ -0,0 +1,135 @@
+// slang-ir-loop-invariant-code-motion.cpp
+#include "slang-ir-loop-invariant-code-motion.h"
+
+#include "slang-ir-dominators.h"
+#include "slang-ir-insts.h"
+#include "slang-ir-util.h"
+#include "slang-ir.h"
+
+namespace Slang
+{
+
+struct LoopInvariantCodeMotionContext
+{
+    struct LoopInfo
+    {
+        IRLoop* loopInst;
+        List<IRBlock*> blocks;
+        HashSet<IRBlock*> blockSet;
+    };
+
+    List<LoopInfo> loops;
+
+    bool isDefinedInLoop(LoopInfo const& loop, IRInst* value)
+    {
+        if (!value)
+            return false;
+        auto block = as<IRBlock>(value->getParent());
+        return block && loop.blockSet.contains(block);
+    }
+
+    bool isLoopInvariant(LoopInfo const& loop, IRInst* inst)
+    {
+        if (isDefinedInLoop(loop, inst->getFullType()))
+            return false;
+        for (UInt i = 0; i < inst->getOperandCount(); i++)
+        {
+            if (isDefinedInLoop(loop, inst->getOperand(i)))
+                return false;
+        }
+        return true;
+    }
+
+    bool canHoist(IRInst* inst)
+    {
+        // Hoisting a remainder out of a branch may make it evaluate with a
+        // zero divisor that the branch was guarding against, which traps on
+        // CPU targets.
+        //
+        if (inst->getOp() == kIROp_IRem)
+            return false;
+
+        return isMovableInst(inst);
+    }
+
+    bool hoistFromLoop(LoopInfo const& loop)
+    {
+        // The loop instruction is the terminator of the block that enters the
+        // loop, which dominates every block of the loop, so any value that is
+        // available in the loop and not defined in it is available there.
+        //
+        bool changed = false;
+        for (auto block : loop.blocks)
+        {
+            IRInst* nextInst = nullptr;
+            for (auto inst = block->getFirstOrdinaryInst(); inst; inst = nextInst)
+            {
+                nextInst = inst->getNextInst();
+                if (!canHoist(inst) || !isLoopInvariant(loop, inst))
+                    continue;
+                inst->insertBefore(loop.loopInst);
+                changed = true;
+            }
+        }
+        return changed;
+    }
+
+    bool processFunc(IRGlobalValueWithCode* func)
+    {
+        auto dom = computeDominatorTree(func);
+        for (auto block : func->getBlocks())
+        {
+            auto loopInst = as<IRLoop>(block->getTerminator());
+            if (!loopInst)
+                continue;
+            LoopInfo loop;
+            loop.loopInst = loopInst;
+            loop.blocks = collectBlocksInRegion(dom, loopInst);
+            for (auto loopBlock : loop.blocks)
+                loop.blockSet.add(loopBlock);
+            loops.add(_Move(loop));
+        }
+
+        // Inner loops come after the loops that contain them in the block list.
+        // Processing them first lets an instruction hoisted out of an inner loop
+        // be hoisted out of the outer loop in the same round, and we repeat
+        // until an instruction depending on a hoisted one has been moved too.
+        //
+        // Moving instructions from one block to another doesn't change the
+        // control flow graph, so the dominator tree and loop blocks stay valid.
+        //
+        bool changed = false;
+        for (;;)
+        {
+            bool roundChanged = false;
+            for (Index i = loops.getCount() - 1; i >= 0; i--)
+                roundChanged |= hoistFromLoop(loops[i]);
+            if (!roundChanged)
+                break;
+            changed = true;
+        }
+        loops.clear();
+        return changed;
+    }
+};
+
+bool hoistLoopInvariantInsts(IRGlobalValueWithCode* func)
+{
+    if (!func->getFirstBlock())
+        return false;
+    LoopInvariantCodeMotionContext context;
+    return context.processFunc(func);
+}
+
+bool hoistLoopInvariantInsts(IRModule* module)
+{
+    bool changed = false;
+    for (auto inst : module->getGlobalInsts())
+    {
+        if (auto func = as<IRFunc>(inst))
+            changed |= hoistLoopInvariantInsts(func);
+    }
+    return changed;
+}
+
+} // namespace Slang
@@ -0,0 +1,20 @@
+// slang-ir-loop-invariant-code-motion.h
+#pragma once
+
+namespace Slang
+{
+struct IRModule;
+struct IRGlobalValueWithCode;
+
+/// Move instructions that compute the same value on every iteration of a loop
+/// out of the loop, to the block that enters it.
+///
+/// Only instructions without side effects that are safe to move (see `isMovableInst`)
+/// are hoisted, so calls are only hoisted when the callee has been found to
+/// not access memory.
+///
+/// Returns true if any instruction was moved.
+bool hoistLoopInvariantInsts(IRGlobalValueWithCode* func);
+
+bool hoistLoopInvariantInsts(IRModule* module);
+} // namespace Slang
@@ -5,6 +5,7 @@
 #include "slang-ir-dce.h"
 #include "slang-ir-dominators.h"
 #include "slang-ir-insts.h"
+#include "slang-ir-optimization-remarks.h"
 #include "slang-ir-peephole.h"
 #include "slang-ir-simplify-cfg.h"
 #include "slang-ir-util.h"
@@ -66,6 +67,139 @@ static int _getLoopMaxIterationsToUnroll(IRLoop* loopInst)
     return maxIterations;
 }
 
+// Replace the terminator of `block` with an unconditional branch if it is a conditional branch or
+// a switch on a known value.
+static void _foldConstantBranch(IRBuilder& builder, IRBlock* block)
+{
+    auto terminator = block->getTerminator();
+    if (auto cbranch = as<IRConditionalBranch>(terminator))
+    {
+        if (auto constCondition = as<IRConstant>(cbranch->getCondition()))
+        {
+            auto targetBlock = (constCondition->value.intVal != 0) ? cbranch->getTrueBlock()
+                                                                    : cbranch->getFalseBlock();
+            builder.setInsertBefore(cbranch);
+            builder.emitBranch(targetBlock);
+            cbranch->removeAndDeallocate();
+        }
+    }
+    else if (auto switchInst = as<IRSwitch>(terminator))
+    {
+        if (auto constCondition = as<IRConstant>(switchInst->condition.get()))
+        {
+            for (UInt i = 0; i < switchInst->getCaseCount(); i++)
+            {
+                if (constCondition == switchInst->getCaseValue(i))
+                {
+                    builder.setInsertBefore(switchInst);
+                    builder.emitBranch(switchInst->getCaseLabel(i));
+                    switchInst->removeAndDeallocate();
+                    break;
+                }
+            }
+        }
+    }
+}
+
+static Count _countInstsInBlocks(List<IRBlock*> const& blocks)
+{
+    Count count = 0;
+    for (auto block : blocks)
+    {
+        for (auto inst : block->getChildren())
+        {
+            SLANG_UNUSED(inst);
+            count++;
+        }
+    }
+    return count;
+}
+
+// Clone one iteration of the loop body `blocks` into `clonedBlocks`, which have been created
+// for every block of the body and whose mapping is in `cloneEnv`.
+//
+// The blocks are cloned on demand: starting from the first block, each cloned block is simplified
+// and its branch is folded if its condition is known, and only the blocks it can still branch to
+// are cloned next. The blocks of the body that the iteration never reaches are not cloned at
+// all, and are removed from `clonedBlocks`.
+//
+// A block is only cloned after the block that reaches it, so it is also cloned after all the
+// blocks that dominate it, and the values it uses are always cloned before it.
+static void _cloneReachableLoopIteration(
+    TargetProgram* targetProgram,
+    IRBuilder& builder,
+    IRCloneEnv& cloneEnv,
+    List<IRBlock*> const& blocks,
+    List<IRBlock*>& clonedBlocks,
+    IRBlock* unreachableBlock)
+{
+    Dictionary<IRBlock*, Index> clonedBlockIndices;
+    for (Index i = 0; i < clonedBlocks.getCount(); i++)
+        clonedBlockIndices[clonedBlocks[i]] = i;
+
+    List<bool> isReached;
+    isReached.setCount(blocks.getCount());
+    for (auto& reached : isReached)
+        reached = false;
+
+    List<Index> workList;
+    workList.add(0);
+    isReached[0] = true;
+    for (Index i = 0; i < workList.getCount(); i++)
+    {
+        auto blockIndex = workList[i];
+        auto clonedBlock = clonedBlocks[blockIndex];
+        builder.setInsertInto(clonedBlock);
+        for (auto inst : blocks[blockIndex]->getChildren())
+        {
+            cloneInst(&cloneEnv, &builder, inst);
+        }
+
+        // The params of a block are left alone here, because there may be branches into the
+        // block that are yet to be cloned. They are simplified with the rest of the iteration
+        // once it is complete.
+        for (auto inst : clonedBlock->getChildren())
+        {
+            if (as<IRParam>(inst))
+                continue;
+            tryReplaceInstUsesWithSimplifiedValue(targetProgram, builder.getModule(), inst);
+        }
+        _foldConstantBranch(builder, clonedBlock);
+
+        // Every block that the terminator names is reached, which also covers the break and
+        // merge blocks of the control flow that is left in the iteration.
+        auto terminator = clonedBlock->getTerminator();
+        if (!terminator)
+            continue;
+        for (UInt j = 0; j < terminator->getOperandCount(); j++)
+        {
+            Index targetIndex = 0;
+            auto targetBlock = as<IRBlock>(terminator->getOperand(j));
+            if (!targetBlock || !clonedBlockIndices.tryGetValue(targetBlock, targetIndex))
+                continue;
+            if (isReached[targetIndex])
+                continue;
+            isReached[targetIndex] = true;
+            workList.add(targetIndex);
+        }
+    }
+
+    Index reachedCount = 0;
+    for (Index i = 0; i < clonedBlocks.getCount(); i++)
+    {
+        auto clonedBlock = clonedBlocks[i];
+        if (isReached[i])
+        {
+            clonedBlocks[reachedCount++] = clonedBlock;
+            continue;
+        }
+        if (clonedBlock->hasUses())
+            clonedBlock->replaceUsesWith(unreachableBlock);
+        clonedBlock->removeAndDeallocate();
+    }
+    clonedBlocks.setCount(reachedCount);
+}
+
 static void _foldAndSimplifyLoopIteration(
     TargetProgram* targetProgram,
     IRBuilder& builder,
@@ -95,35 +229,7 @@ static void _foldAndSimplifyLoopIteration(
         // Fold conditional branches into unconditional branches if the condition is known.
         for (auto b : clonedBlocks)
         {
-            auto terminator = b->getTerminator();
-            if (auto cbranch = as<IRConditionalBranch>(terminator))
-            {
-                if (auto constCondition = as<IRConstant>(cbranch->getCondition()))
-                {
-                    auto targetBlock = (constCondition->value.intVal != 0)
-                                           ? cbranch->getTrueBlock()
-                                           : cbranch->getFalseBlock();
-                    builder.setInsertBefore(cbranch);
-                    builder.emitBranch(targetBlock);
-                    cbranch->removeAndDeallocate();
-                }
-            }
-            else if (auto switchInst = as<IRSwitch>(terminator))
-            {
-                if (auto constCondition = as<IRConstant>(switchInst->condition.get()))
-                {
-                    for (UInt i = 0; i < switchInst->getCaseCount(); i++)
-                    {
-                        if (constCondition == switchInst->getCaseValue(i))
-                        {
-                            builder.setInsertBefore(switchInst);
-                            builder.emitBranch(switchInst->getCaseLabel(i));
-                            switchInst->removeAndDeallocate();
-                            break;
-                        }
-                    }
-                }
-            }
+            _foldConstantBranch(builder, b);
         }
 
         // DCE on CFG.
@@ -146,15 +252,25 @@ static void _foldAndSimplifyLoopIteration(
     }
 }
 
+enum class UnrollLoopResult
+{
+    Unrolled,
+    NotTerminated, ///< The loop did not terminate within the iteration limit.
+    OverBudget,    ///< The unrolled iterations grew the code by more than the budget.
+};
+
 // Unroll loop up to a predefined maximum number of iterations.
-// Returns true if we can statically determine that the loop terminated within the iteration limit.
+// Returns `Unrolled` if we can statically determine that the loop terminated within the iteration
+// limit, and before the code the unrolled iterations add exceeds the `LoopUnrollBudget`, which is
+// diagnosed here.
 // This operation assumes the loop does not have `continue` jumps, i.e. continueBlock ==
 // targetBlock.
-static bool _unrollLoop(
+static UnrollLoopResult _unrollLoop(
     TargetProgram* targetProgram,
     IRModule* module,
     IRLoop* loopInst,
-    List<IRBlock*>& blocks)
+    List<IRBlock*>& blocks,
+    DiagnosticSink* sink)
 {
     if (blocks.getCount() == 0)
     {
@@ -162,12 +278,19 @@ static bool _unrollLoop(
         subBuilder.setInsertBefore(loopInst);
         subBuilder.emitBranch(loopInst->getBreakBlock());
         loopInst->removeAndDeallocate();
-        return true;
+        return UnrollLoopResult::Unrolled;
     }
 
     auto maxIterations = _getLoopMaxIterationsToUnroll(loopInst);
     if (maxIterations < 0)
-        return true;
+        return UnrollLoopResult::Unrolled;
+
+    // The number of instructions that the unrolled iterations may add, after each of them has
+    // been simplified, before unrolling is aborted. There is no limit when it is 0.
+    const Count unrollBudget =
+        targetProgram->getOptionSet().getIntOption(CompilerOptionName::LoopUnrollBudget);
+    Count unrolledInstCount = 0;
+    auto loopLoc = loopInst->sourceLoc;
 
     // We assume all `continue`s are eliminated and turned into multi-level breaks
     // before this operation.
@@ -237,6 +360,8 @@ static bool _unrollLoop(
     bool loopTerminated = false;
     for (int attempedIterations = 0; attempedIterations < maxIterations; attempedIterations++)
     {
+        targetProgram->getProgram()->getLinkage()->checkForCancellation(sink);
+
         // Our task is to peel off the first iteration and put it in front of the
         // loop.
         // We will create a breakable region (via single iteration loop), and clone the loop body
@@ -322,18 +447,15 @@ static bool _unrollLoop(
             clonedBlocks.add(clonedBlock);
         }
 
-        // Now clone the insts inside each block.
+        // Now clone the insts of the blocks that this iteration reaches.
 
-        for (Index i = 0; i < blocks.getCount(); i++)
-        {
-            auto originalBlock = blocks[i];
-            auto clonedBlock = clonedBlocks[i];
-            builder.setInsertInto(clonedBlock);
-            for (auto inst : originalBlock->getChildren())
-            {
-                cloneInst(&cloneEnv, &builder, inst);
-            }
-        }
+        _cloneReachableLoopIteration(
+            targetProgram,
+            builder,
+            cloneEnv,
+            blocks,
+            clonedBlocks,
+            unreachableBlock);
 
         // Wire the break region header to jump to the first loop body block.
 
@@ -357,6 +479,23 @@ static bool _unrollLoop(
             firstIterationBreakBlock,
             unreachableBlock);
 
+        // Each iteration is simplified before the next one is cloned, so this counts what the
+        // unrolled loop really adds to the code.
+
+        unrolledInstCount += _countInstsInBlocks(clonedBlocks);
+        if (unrollBudget > 0 && unrolledInstCount > unrollBudget)
+        {
+            if (sink)
+            {
+                sink->diagnose(
+                    loopLoc,
+                    Diagnostics::loopUnrollBudgetExceeded,
+                    attempedIterations + 1,
+                    unrollBudget);
+            }
+            return UnrollLoopResult::OverBudget;
+        }
+
         // Now we have peeled off one iteration from the loop, we check if there are any
         // branches into next iteration, if not, the loop terminates and we are done.
 
@@ -423,7 +562,7 @@ static bool _unrollLoop(
         }
     }
 
-    return loopTerminated;
+    return loopTerminated ? UnrollLoopResult::Unrolled : UnrollLoopResult::NotTerminated;
 }
 
 // Visits all loop insts in a func, inner loop first.
@@ -448,12 +587,42 @@ List<IRLoop*> collectLoopsInFunc(IRGlobalValueWithCode* func, const TFunc& filte
     return loops;
 }
 
+// Add a remark for each loop in `func` that isn't unrolled by Slang, since it isn't
+// marked [ForceUnroll].
+//
+static void _addMissedUnrollRemarks(OptimizationRemarks* remarks, IRGlobalValueWithCode* func)
+{
+    auto loops = collectLoopsInFunc(
+        func,
+        [](IRLoop* l) { return l->findDecoration<IRForceUnrollDecoration>() == nullptr; });
+    for (auto loop : loops)
+    {
+        const char* reason = "the loop isn't marked [ForceUnroll]";
+        auto loopControl = loop->findDecoration<IRLoopControlDecoration>();
+        if (loopControl && loopControl->getMode() == kIRLoopControl_Unroll)
+            reason = "the loop is marked [unroll], which is left to the downstream compiler";
+        else if (loopControl && loopControl->getMode() == kIRLoopControl_Loop)
+            reason = "the loop is marked [loop]";
+        remarks->add(
+            "loop-unroll",
+            false,
+            loop->sourceLoc,
+            func,
+            reason,
+            _countInstsInBlocks(collectBlocksInRegion(func, loop)));
+    }
+}
+
 bool unrollLoopsInFunc(
     TargetProgram* targetProgram,
     IRModule* module,
     IRGlobalValueWithCode* func,
     DiagnosticSink* sink)
 {
+    auto remarks = module->getOptimizationRemarks();
+    if (remarks)
+        _addMissedUnrollRemarks(remarks, func);
+
     List<IRLoop*> loops = collectLoopsInFunc(
         func,
         [](IRLoop* l) { return l->findDecoration<IRForceUnrollDecoration>() != nullptr; });
@@ -468,12 +637,24 @@ bool unrollLoopsInFunc(
 
         auto blocks = collectBlocksInRegion(func, loop);
         auto loopLoc = loop->sourceLoc;
-        if (!_unrollLoop(targetProgram, module, loop, blocks))
+        auto loopInstCount = _countInstsInBlocks(blocks);
+        auto result = _unrollLoop(targetProgram, module, loop, blocks, sink);
+        if (result != UnrollLoopResult::Unrolled)
         {
-            if (sink)
+            if (sink && result == UnrollLoopResult::NotTerminated)
                 sink->diagnose(loopLoc, Diagnostics::cannotUnrollLoop);
             return false;
         }
+        if (remarks)
+        {
+            remarks->add(
+                "loop-unroll",
+                true,
+                loopLoc,
+                func,
+                "the loop is marked [ForceUnroll]",
+                loopInstCount);
+        }
 
         // Make sure we simplify things as much as possible before
         // attempting to potentially unroll outer loop.
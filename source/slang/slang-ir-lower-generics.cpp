@@ -14,6 +14,7 @@
 #include "slang-ir-lower-generic-function.h"
 #include "slang-ir-lower-generic-type.h"
 #include "slang-ir-lower-tuple-types.h"
+#include "slang-ir-optimization-remarks.h"
 #include "slang-ir-specialize-dispatch.h"
 #include "slang-ir-specialize-dynamic-associatedtype-lookup.h"
 #include "slang-ir-ssa-simplification.h"
@@ -218,10 +219,67 @@ void stripWrapExistential(IRModule* module)
     }
 }
 
+// Add a remark for each call through an interface requirement that specialization couldn't
+// resolve, and is about to be lowered to a dynamic dispatch. The cost of a remark is the
+// number of implementations of the interface that the dispatch chooses between.
+//
+static void addDynamicDispatchRemarks(OptimizationRemarks* remarks, IRModule* module)
+{
+    Dictionary<IRInst*, Count> witnessTableCounts;
+    List<IRLookupWitnessMethod*> lookups;
+    List<IRInst*> workList;
+    workList.add(module->getModuleInst());
+    while (workList.getCount())
+    {
+        auto inst = workList.getLast();
+        workList.removeLast();
+        if (auto witnessTable = as<IRWitnessTable>(inst))
+        {
+            witnessTableCounts.getOrAddValue(witnessTable->getConformanceType(), 0)++;
+            continue;
+        }
+        if (auto lookup = as<IRLookupWitnessMethod>(inst))
+        {
+            if (!as<IRWitnessTable>(lookup->getWitnessTable()))
+                lookups.add(lookup);
+            continue;
+        }
+        for (auto child : inst->getChildren())
+            workList.add(child);
+    }
+
+    for (auto lookup : lookups)
+    {
+        for (auto use = lookup->firstUse; use; use = use->nextUse)
+        {
+            auto call = as<IRCall>(use->getUser());
+            if (!call || call->getCallee() != lookup)
+                continue;
+            Count implementationCount = -1;
+            if (auto witnessTableType =
+                    as<IRWitnessTableTypeBase>(lookup->getWitnessTable()->getDataType()))
+            {
+                implementationCount =
+                    witnessTableCounts.getOrAddValue(witnessTableType->getConformanceType(), 0);
+            }
+            remarks->add(
+                "dynamic-dispatch",
+                false,
+                getDiagnosticPos(call),
+                lookup->getRequirementKey(),
+                "the type that implements the requirement is only known at runtime",
+                implementationCount);
+        }
+    }
+}
+
 void lowerGenerics(TargetProgram* targetProgram, IRModule* module, DiagnosticSink* sink)
 {
     SLANG_PROFILE;
 
+    if (auto remarks = module->getOptimizationRemarks())
+        addDynamicDispatchRemarks(remarks, module);
+
     SharedGenericsLoweringContext sharedContext(module);
     sharedContext.targetProgram = targetProgram;
     sharedContext.sink = sink;
@@ -0,0 +1,198 @@
+// slang-ir-optimization-remarks.cpp
+#include "slang-ir-optimization-remarks.h"
+
+#include "../core/slang-io.h"
+#include "../core/slang-string-escape-util.h"
+#include "slang-ir-insts.h"
+#include "slang-ir.h"
+
+namespace Slang
+{
+
+void OptimizationRemarks::add(
+    const char* pass,
+    bool applied,
+    IRInst* inst,
+    String const& reason,
+    Count cost)
+{
+    add(pass, applied, getDiagnosticPos(inst), inst, reason, cost);
+}
+
+void OptimizationRemarks::add(
+    const char* pass,
+    bool applied,
+    SourceLoc loc,
+    IRInst* subjectInst,
+    String const& reason,
+    Count cost)
+{
+    OptimizationRemark remark;
+    remark.pass = pass;
+    remark.applied = applied;
+    remark.loc = loc;
+    StringBuilder subject;
+    printDiagnosticArg(subject, subjectInst);
+    remark.subject = subject.produceString();
+    remark.reason = reason;
+    remark.cost = cost;
+
+    StringBuilder key;
+    key << pass << ":" << remark.loc.getRaw() << ":" << remark.subject << ":" << reason;
+    if (!m_remarkKeys.add(key.produceString()))
+        return;
+    m_remarks.add(remark);
+}
+
+void OptimizationRemarks::report(DiagnosticSink* sink)
+{
+    for (auto& remark : m_remarks)
+    {
+        StringBuilder message;
+        message << (remark.applied ? "applied" : "missed");
+        if (remark.subject.getLength())
+            message << " for '" << remark.subject << "'";
+        message << ": " << remark.reason;
+        if (remark.cost >= 0)
+            message << " (cost " << remark.cost << ")";
+        sink->diagnose(remark.loc, Diagnostics::optimizationRemark, remark.pass, message);
+    }
+}
+
+void OptimizationRemarks::writeJSON(SourceManager* sourceManager, StringBuilder& out)
+{
+    auto handler = StringEscapeUtil::getHandler(StringEscapeUtil::Style::JSON);
+
+    out << "{\"remarks\":[";
+    for (Index i = 0; i < m_remarks.getCount(); ++i)
+    {
+        auto& remark = m_remarks[i];
+        if (i)
+            out << ",";
+        out << "\n{\"pass\":";
+        StringEscapeUtil::appendQuoted(handler, UnownedStringSlice(remark.pass), out);
+        out << ",\"kind\":\"" << (remark.applied ? "applied" : "missed") << "\"";
+        if (sourceManager && remark.loc.isValid())
+        {
+            auto humaneLoc = sourceManager->getHumaneLoc(remark.loc);
+            out << ",\"file\":";
+            StringEscapeUtil::appendQuoted(
+                handler,
+                humaneLoc.pathInfo.foundPath.getUnownedSlice(),
+                out);
+            out << ",\"line\":" << humaneLoc.line << ",\"column\":" << humaneLoc.column;
+        }
+        out << ",\"subject\":";
+        StringEscapeUtil::appendQuoted(handler, remark.subject.getUnownedSlice(), out);
+        out << ",\"reason\":";
+        StringEscapeUtil::appendQuoted(handler, remark.reason.getUnownedSlice(), out);
+        if (remark.cost >= 0)
+            out << ",\"cost\":" << remark.cost;
+        out << "}";
+    }
+    out << "\n]}\n";
+}
+
+// Describe why `addr`, the address of a local variable or of a part of one, keeps the
+// variable in memory, or return null if it is only loaded from and stored to.
+//
+static const char* _findLocalMemoryReason(IRInst* addr, bool isPart)
+{
+    for (auto use = addr->firstUse; use; use = use->nextUse)
+    {
+        auto user = use->getUser();
+        switch (user->getOp())
+        {
+        case kIROp_Load:
+            break;
+        case kIROp_Store:
+            if (use != user->getOperands())
+                return "its address is stored";
+            if (isPart)
+                return "a part of it is stored to on its own";
+            break;
+        case kIROp_GetElementPtr:
+        case kIROp_FieldAddress:
+            if (use != user->getOperands())
+                return "its address is used as an index";
+            if (auto reason = _findLocalMemoryReason(user, true))
+                return reason;
+            break;
+        case kIROp_Call:
+            return "its address is passed to a function";
+        default:
+            return "its address is used by an operation that promotion doesn't handle";
+        }
+    }
+    return nullptr;
+}
+
+void addLocalMemoryRemarks(IRModule* module)
+{
+    auto remarks = module->getOptimizationRemarks();
+    if (!remarks)
+        return;
+    for (auto globalInst : module->getGlobalInsts())
+    {
+        auto func = as<IRFunc>(globalInst);
+        if (!func)
+            continue;
+        for (auto block : func->getBlocks())
+        {
+            for (auto inst : block->getChildren())
+            {
+                auto var = as<IRVar>(inst);
+                if (!var)
+                    continue;
+                auto type = var->getDataType()->getValueType();
+                if (!as<IRStructType>(type) && !as<IRArrayTypeBase>(type))
+                    continue;
+                auto reason = _findLocalMemoryReason(var, false);
+                if (!reason)
+                    reason = "it wasn't promoted";
+                Count useCount = 0;
+                for (auto use = var->firstUse; use; use = use->nextUse)
+                    useCount++;
+                remarks->add(
+                    "local-memory",
+                    false,
+                    var,
+                    String("variable is kept in memory because ") + reason,
+                    useCount);
+            }
+        }
+    }
+}
+
+OptimizationRemarksScope::OptimizationRemarksScope(
+    IRModule* module,
+    DiagnosticSink* sink,
+    bool reportRemarks,
+    String const& remarksFilePath)
+    : m_module(module)
+    , m_sink(sink)
+    , m_reportRemarks(reportRemarks)
+    , m_remarksFilePath(remarksFilePath)
+{
+    if (m_reportRemarks || m_remarksFilePath.getLength())
+        m_module->setOptimizationRemarks(&m_remarks);
+}
+
+OptimizationRemarksScope::~OptimizationRemarksScope()
+{
+    if (m_module->getOptimizationRemarks() != &m_remarks)
+        return;
+    m_module->setOptimizationRemarks(nullptr);
+
+    if (m_reportRemarks)
+        m_remarks.report(m_sink);
+    if (m_remarksFilePath.getLength())
+    {
+        StringBuilder json;
+        m_remarks.writeJSON(m_sink->getSourceManager(), json);
+        if (SLANG_FAILED(File::writeAllText(m_remarksFilePath, json.produceString())))
+            m_sink->diagnose(SourceLoc(), Diagnostics::cannotWriteOutputFile, m_remarksFilePath);
+    }
+}
+
+} // namespace Slang
@@ -0,0 +1,89 @@
+// slang-ir-optimization-remarks.h
+#pragma once
+
+#include "../compiler-core/slang-source-loc.h"
+#include "../core/slang-basic.h"
+
+namespace Slang
+{
+struct IRInst;
+struct IRModule;
+class DiagnosticSink;
+
+/// A decision that an IR pass made about an optimization.
+struct OptimizationRemark
+{
+    /// The name of the pass that made the decision, such as `"loop-unroll"`.
+    const char* pass = nullptr;
+    /// True if the optimization was applied, false if it was missed.
+    bool applied = false;
+    SourceLoc loc;
+    /// The name of what the optimization applies to, such as a function.
+    String subject;
+    String reason;
+    /// The number of IR instructions the decision affects, or -1 if it doesn't apply.
+    Count cost = -1;
+};
+
+/// Collects the remarks that IR passes make about the optimizations they apply or miss.
+///
+/// Passes find the collector of the module they are run on with
+/// `IRModule::getOptimizationRemarks`, which returns null unless remarks were asked for
+/// with `-report-optimization-remarks` or `-optimization-remarks-file`, so that passes
+/// don't spend time describing decisions nobody reads.
+///
+class OptimizationRemarks
+{
+public:
+    /// Add a remark about `inst`, which gives the location and the subject of the remark.
+    ///
+    /// Some passes run several times over the same code, so a remark that has already been
+    /// made about the same instruction for the same reason is ignored.
+    void add(const char* pass, bool applied, IRInst* inst, String const& reason, Count cost = -1);
+
+    /// Add a remark about `subject`, at `loc`.
+    void add(
+        const char* pass,
+        bool applied,
+        SourceLoc loc,
+        IRInst* subject,
+        String const& reason,
+        Count cost = -1);
+
+    List<OptimizationRemark> const& getRemarks() const { return m_remarks; }
+
+    /// Report each remark as a note.
+    void report(DiagnosticSink* sink);
+
+    /// Write the remarks as a JSON object with a `remarks` array of records.
+    void writeJSON(SourceManager* sourceManager, StringBuilder& out);
+
+private:
+    List<OptimizationRemark> m_remarks;
+    HashSet<String> m_remarkKeys;
+};
+
+/// Add a remark for each local variable of struct or array type in `module` that is kept
+/// in memory instead of being promoted to SSA values.
+void addLocalMemoryRemarks(IRModule* module);
+
+/// Collects the remarks of the passes run on a module for the lifetime of the scope, if the
+/// options ask for them, and reports or writes them out when the scope ends.
+struct OptimizationRemarksScope
+{
+    OptimizationRemarksScope(
+        IRModule* module,
+        DiagnosticSink* sink,
+        bool reportRemarks,
+        String const& remarksFilePath);
+    ~OptimizationRemarksScope();
+
+private:
+    IRModule* m_module;
+    DiagnosticSink* m_sink;
+    bool m_reportRemarks;
+    String m_remarksFilePath;
+    OptimizationRemarks m_remarks;
+};
+
+} // namespace Slang
@@ -0,0 +1,148 @@
+// slang-ir-pad-groupshared-arrays.cpp
+#include "slang-ir-pad-groupshared-arrays.h"
+
+#include "slang-ir-insts.h"
+#include "slang-ir-util.h"
+#include "slang-ir.h"
+
+namespace Slang
+{
+
+// Shared memory is split into banks of 32-bit words, and the words at the same
+// address modulo `kBankCount` words are in the same bank. The accesses of a
+// wave to different words in one bank are serialized.
+//
+// When the rows of an array `T[N][M]` are a multiple of `kBankCount` words
+// long, the element `[i][j]` is in the same bank for every row `i`, so threads
+// that access a column of the array all wait on one bank. With a row of
+// `M + 1` elements, consecutive rows start in consecutive banks instead.
+//
+// We treat an access with a row index that isn't a compile-time constant as
+// one that may step across rows from thread to thread. That may pad arrays
+// that are only accessed by rows, which costs a word per row but doesn't
+// introduce any bank conflicts.
+//
+static const IRIntegerValue kBankCount = 32;
+
+struct GroupSharedArrayPaddingContext
+{
+    IRModule* module;
+    DiagnosticSink* sink;
+
+    static bool is32BitScalarType(IRType* type)
+    {
+        switch (type->getOp())
+        {
+        case kIROp_FloatType:
+        case kIROp_IntType:
+        case kIROp_UIntType:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    static bool isElementAddress(IRUse* use)
+    {
+        auto user = use->getUser();
+        return user->getOp() == kIROp_GetElementPtr && use == user->getOperands();
+    }
+
+    // Collect the addresses of the rows of `globalVar`, and determine whether
+    // they are all only used to address their elements. Returns false if the
+    // array is used in any other way.
+    //
+    bool collectRowAddresses(
+        IRGlobalVar* globalVar,
+        List<IRInst*>& outRowAddresses,
+        bool& outHasVaryingRow)
+    {
+        outHasVaryingRow = false;
+        for (auto use = globalVar->firstUse; use; use = use->nextUse)
+        {
+            if (!isElementAddress(use))
+                return false;
+            auto rowAddress = use->getUser();
+            for (auto rowUse = rowAddress->firstUse; rowUse; rowUse = rowUse->nextUse)
+            {
+                if (!isElementAddress(rowUse))
+                    return false;
+            }
+            if (!as<IRIntLit>(rowAddress->getOperand(1)))
+                outHasVaryingRow = true;
+            outRowAddresses.add(rowAddress);
+        }
+        return true;
+    }
+
+    void processGlobalVar(IRGlobalVar* globalVar)
+    {
+        if (!as<IRGroupSharedRate>(globalVar->getRate()) || globalVar->getFirstBlock())
+            return;
+
+        auto ptrType = globalVar->getDataType();
+        auto arrayType = as<IRArrayType>(ptrType->getValueType());
+        if (!arrayType)
+            return;
+        auto rowType = as<IRArrayType>(arrayType->getElementType());
+        if (!rowType || !is32BitScalarType(rowType->getElementType()))
+            return;
+        if (arrayType->getArrayStride() || rowType->getArrayStride())
+            return;
+        auto rowCount = as<IRIntLit>(arrayType->getElementCount());
+        auto rowLength = as<IRIntLit>(rowType->getElementCount());
+        if (!rowCount || !rowLength || rowLength->getValue() % kBankCount != 0)
+            return;
+
+        List<IRInst*> rowAddresses;
+        bool hasVaryingRow = false;
+        if (!collectRowAddresses(globalVar, rowAddresses, hasVaryingRow) || !hasVaryingRow)
+            return;
+
+        IRBuilder builder(module);
+        builder.setInsertBefore(globalVar);
+        auto paddedRowType = builder.getArrayType(
+            rowType->getElementType(),
+            builder.getIntValue(rowLength->getDataType(), rowLength->getValue() + 1));
+        auto paddedArrayType = builder.getArrayType(paddedRowType, rowCount);
+        auto paddedPtrType = builder.getPtrTypeWithAddressSpace(paddedArrayType, ptrType);
+        globalVar->setFullType(
+            builder.getRateQualifiedType(builder.getGroupSharedRate(), paddedPtrType));
+
+        for (auto rowAddress : rowAddresses)
+        {
+            auto rowPtrType = as<IRPtrTypeBase>(rowAddress->getDataType());
+            rowAddress->setFullType(
+                builder.getPtrTypeWithAddressSpace(paddedRowType, rowPtrType));
+        }
+
+        if (sink)
+        {
+            sink->diagnose(
+                globalVar,
+                Diagnostics::paddedGroupSharedArray,
+                globalVar,
+                rowLength->getValue(),
+                rowLength->getValue() + 1);
+        }
+    }
+
+    void processModule()
+    {
+        for (auto inst : module->getGlobalInsts())
+        {
+            if (auto globalVar = as<IRGlobalVar>(inst))
+                processGlobalVar(globalVar);
+        }
+    }
+};
+
+void padGroupSharedArrays(IRModule* module, DiagnosticSink* sink)
+{
+    GroupSharedArrayPaddingContext context;
+    context.module = module;
+    context.sink = sink;
+    context.processModule();
+}
+
+} // namespace Slang
@@ -0,0 +1,20 @@
+// slang-ir-pad-groupshared-arrays.h
+#pragma once
+
+namespace Slang
+{
+struct IRModule;
+class DiagnosticSink;
+
+/// Pad the rows of two-dimensional `groupshared` arrays whose accesses would
+/// otherwise hit the same shared memory bank from every thread.
+///
+/// An array `T[N][M]` of 32-bit scalars is padded to `T[N][M+1]` when a row
+/// spans a whole number of banks and the array is indexed by a row that isn't
+/// a compile-time constant, as in the column accesses of a transpose. Arrays
+/// that are used other than through element accesses are left alone, since
+/// their layout could be observed.
+///
+/// A note is reported to `sink` for each array that is padded.
+void padGroupSharedArrays(IRModule* module, DiagnosticSink* sink);
+} // namespace Slang
@@ -0,0 +1,301 @@
+// slang-ir-pass-profile.cpp
+#include "slang-ir-pass-profile.h"
+
+#include "../core/slang-string-escape-util.h"
+#include "slang-ir.h"
+
+namespace Slang
+{
+
+/// What one thread has recorded. Only that thread adds to it, but the reports merge the
+/// buffers of all threads, so both lock `mutex`.
+struct IRPassProfiler::ThreadBuffer
+{
+    std::mutex mutex;
+    OrderedDictionary<const char*, IRPassStatistics> passes;
+
+    /// False once the thread has exited. Guarded by `m_threadBuffersMutex`.
+    bool isThreadAlive = true;
+};
+
+/// Registers the buffer of the current thread while the thread is alive.
+struct IRPassProfiler::ThreadBufferHolder
+{
+    ThreadBufferHolder(IRPassProfiler* profiler)
+        : profiler(profiler), buffer(new ThreadBuffer())
+    {
+        std::lock_guard<std::mutex> lock(profiler->m_threadBuffersMutex);
+        profiler->m_threadBuffers.add(buffer);
+    }
+    ~ThreadBufferHolder()
+    {
+        std::lock_guard<std::mutex> lock(profiler->m_threadBuffersMutex);
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        buffer->isThreadAlive = false;
+    }
+
+    IRPassProfiler* profiler;
+    ThreadBuffer* buffer;
+};
+
+IRPassProfiler::~IRPassProfiler()
+{
+    for (auto buffer : m_threadBuffers)
+        delete buffer;
+}
+
+IRPassProfiler::ThreadBuffer* IRPassProfiler::_getThreadBuffer()
+{
+    thread_local ThreadBufferHolder holder(this);
+    return holder.buffer;
+}
+
+IRPassStatistics& IRPassProfiler::_getPass(
+    OrderedDictionary<const char*, IRPassStatistics>& passes,
+    const char* passName)
+{
+    passes.addIfNotExists(passName, IRPassStatistics());
+    return *passes.tryGetValue(passName);
+}
+
+void IRPassProfiler::clear()
+{
+    std::lock_guard<std::mutex> lock(m_threadBuffersMutex);
+
+    // What exited threads recorded is no longer needed, so their buffers are deleted.
+    Index count = 0;
+    for (auto buffer : m_threadBuffers)
+    {
+        if (buffer->isThreadAlive)
+            m_threadBuffers[count++] = buffer;
+        else
+            delete buffer;
+    }
+    m_threadBuffers.setCount(count);
+
+    for (auto buffer : m_threadBuffers)
+    {
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        buffer->passes.clear();
+    }
+}
+
+void IRPassProfiler::record(
+    const char* passName,
+    std::chrono::nanoseconds duration,
+    Count instCountBefore,
+    Count instCountAfter,
+    Int64 arenaBytesDelta)
+{
+    auto buffer = _getThreadBuffer();
+    std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+    auto& entry = _getPass(buffer->passes, passName);
+    entry.invocationCount++;
+    entry.duration += duration;
+    entry.instCountDelta += Int64(instCountAfter) - Int64(instCountBefore);
+    entry.lastInstCount = instCountAfter;
+    entry.lastInstCountOrder = ++m_recordCount;
+    entry.arenaBytesDelta += arenaBytesDelta;
+}
+
+void IRPassProfiler::recordSkipped(const char* passName)
+{
+    auto buffer = _getThreadBuffer();
+    std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+    _getPass(buffer->passes, passName).skippedCount++;
+}
+
+void IRPassProfiler::addCounter(const char* passName, const char* counterName, Int64 value)
+{
+    auto buffer = _getThreadBuffer();
+    std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+    auto& counters = _getPass(buffer->passes, passName).counters;
+    if (auto counter = counters.tryGetValue(counterName))
+        *counter += value;
+    else
+        counters.add(counterName, value);
+}
+
+void IRPassProfiler::getMergedPasses(OrderedDictionary<const char*, IRPassStatistics>& outPasses)
+{
+    std::lock_guard<std::mutex> lock(m_threadBuffersMutex);
+    for (auto buffer : m_threadBuffers)
+    {
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        for (const auto& pass : buffer->passes)
+        {
+            const auto& stats = pass.value;
+            auto& merged = _getPass(outPasses, pass.key);
+            merged.invocationCount += stats.invocationCount;
+            merged.skippedCount += stats.skippedCount;
+            merged.duration += stats.duration;
+            merged.instCountDelta += stats.instCountDelta;
+            merged.arenaBytesDelta += stats.arenaBytesDelta;
+            if (stats.lastInstCountOrder > merged.lastInstCountOrder)
+            {
+                merged.lastInstCount = stats.lastInstCount;
+                merged.lastInstCountOrder = stats.lastInstCountOrder;
+            }
+            for (const auto& counter : stats.counters)
+            {
+                if (auto mergedCounter = merged.counters.tryGetValue(counter.key))
+                    *mergedCounter += counter.value;
+                else
+                    merged.counters.add(counter.key, counter.value);
+            }
+        }
+    }
+}
+
+void IRPassProfiler::writeReport(StringBuilder& out)
+{
+    OrderedDictionary<const char*, IRPassStatistics> passes;
+    getMergedPasses(passes);
+
+    char buffer[512];
+    snprintf(
+        buffer,
+        sizeof(buffer),
+        "%40s %6s %7s %10s %10s %10s %12s\n",
+        "pass",
+        "runs",
+        "skipped",
+        "time(ms)",
+        "insts",
+        "delta",
+        "arena(B)");
+    out << buffer;
+
+    for (const auto& pass : passes)
+    {
+        const auto& stats = pass.value;
+        const double milliseconds = double(stats.duration.count()) / 1000000.0;
+        snprintf(
+            buffer,
+            sizeof(buffer),
+            "%40s %6d %7d %10.3f %10lld %+10lld %+12lld\n",
+            pass.key,
+            int(stats.invocationCount),
+            int(stats.skippedCount),
+            milliseconds,
+            (long long)stats.lastInstCount,
+            (long long)stats.instCountDelta,
+            (long long)stats.arenaBytesDelta);
+        out << buffer;
+
+        // Counters are listed under their pass, indented.
+        for (const auto& counter : stats.counters)
+        {
+            snprintf(
+                buffer,
+                sizeof(buffer),
+                "%40s   %s: %lld\n",
+                "",
+                counter.key,
+                (long long)counter.value);
+            out << buffer;
+        }
+    }
+}
+
+void IRPassProfiler::writeJSON(StringBuilder& out)
+{
+    auto handler = StringEscapeUtil::getHandler(StringEscapeUtil::Style::JSON);
+
+    OrderedDictionary<const char*, IRPassStatistics> passes;
+    getMergedPasses(passes);
+
+    out << "[";
+    bool isFirst = true;
+    for (const auto& pass : passes)
+    {
+        const auto& stats = pass.value;
+        if (!isFirst)
+            out << ",";
+        isFirst = false;
+
+        out << "\n{\"name\":";
+        StringEscapeUtil::appendQuoted(handler, UnownedStringSlice(pass.key), out);
+        out << ",\"invocations\":" << stats.invocationCount;
+        out << ",\"skipped\":" << stats.skippedCount;
+        out << ",\"timeMS\":" << String(double(stats.duration.count()) / 1000000.0, "%.3f");
+        out << ",\"instCount\":" << stats.lastInstCount;
+        out << ",\"instCountDelta\":" << stats.instCountDelta;
+        out << ",\"arenaBytesDelta\":" << stats.arenaBytesDelta;
+        if (stats.counters.getCount())
+        {
+            out << ",\"counters\":{";
+            bool isFirstCounter = true;
+            for (const auto& counter : stats.counters)
+            {
+                if (!isFirstCounter)
+                    out << ",";
+                isFirstCounter = false;
+                StringEscapeUtil::appendQuoted(handler, UnownedStringSlice(counter.key), out);
+                out << ":" << counter.value;
+            }
+            out << "}";
+        }
+        out << "}";
+    }
+    out << "\n]\n";
+}
+
+IRPassProfiler* IRPassProfiler::getProfiler()
+{
+    static IRPassProfiler profiler;
+    return &profiler;
+}
+
+Count countIRInsts(IRModule* module)
+{
+    Count count = 0;
+    List<IRInst*> workList;
+    workList.add(module->getModuleInst());
+    while (workList.getCount())
+    {
+        IRInst* inst = workList.getLast();
+        workList.removeLast();
+        count++;
+        for (auto child : inst->getDecorationsAndChildren())
+            workList.add(child);
+    }
+    return count;
+}
+
+IRPassProfileScope::IRPassProfileScope(
+    IRPassProfiler* profiler,
+    IRModule* module,
+    const char* passName)
+    : m_profiler(profiler), m_module(module), m_passName(passName)
+{
+    if (!m_profiler)
+        return;
+
+    m_instCountBefore = countIRInsts(m_module);
+    m_arenaBytesBefore = m_module->getMemoryArena().calcTotalMemoryUsed();
+
+    // Start timing last, so the counting above isn't attributed to the pass.
+    m_context = PerformanceProfiler::getProfiler()->enterFunction(m_passName);
+}
+
+IRPassProfileScope::~IRPassProfileScope()
+{
+    if (!m_profiler)
+        return;
+
+    const auto duration = std::chrono::high_resolution_clock::now() - m_context.startTime;
+    PerformanceProfiler::getProfiler()->exitFunction(m_context);
+
+    const Count instCountAfter = countIRInsts(m_module);
+    const size_t arenaBytesAfter = m_module->getMemoryArena().calcTotalMemoryUsed();
+
+    m_profiler->record(
+        m_passName,
+        std::chrono::duration_cast<std::chrono::nanoseconds>(duration),
+        m_instCountBefore,
+        instCountAfter,
+        Int64(arenaBytesAfter) - Int64(m_arenaBytesBefore));
+}
+
+} // namespace Slang
@@ -0,0 +1,119 @@
+// slang-ir-pass-profile.h
+#pragma once
+
+#include "../core/slang-dictionary.h"
+#include "../core/slang-performance-profiler.h"
+#include "../core/slang-string.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+
+namespace Slang
+{
+struct IRModule;
+
+/// Statistics accumulated over every invocation of a single IR pass.
+struct IRPassStatistics
+{
+    Count invocationCount = 0;
+    /// The number of times the pass was skipped because only the minimum optimizations were
+    /// requested.
+    Count skippedCount = 0;
+    std::chrono::nanoseconds duration = std::chrono::nanoseconds::zero();
+
+    /// Sum over all invocations of (instruction count after - instruction count before).
+    Int64 instCountDelta = 0;
+    /// Instruction count of the module after the most recent invocation.
+    Count lastInstCount = 0;
+    /// Orders the most recent invocation among those of all threads.
+    uint64_t lastInstCountOrder = 0;
+    /// Sum over all invocations of the growth in bytes used by the module's memory arena.
+    Int64 arenaBytesDelta = 0;
+    /// Counters reported by the pass itself with `IRPassProfiler::addCounter`, summed over all
+    /// invocations.
+    OrderedDictionary<const char*, Int64> counters;
+};
+
+/// Collects per-pass statistics for the IR passes run during `linkAndOptimizeIR`.
+///
+/// There is a single instance for the process, and it only records anything once enabled.
+/// Like `PerformanceProfiler`, each thread records into its own buffer, and the reports add
+/// up what all the threads have recorded, so that passes run on the threads of
+/// `-downstream-threads` or `compileBatch` are included.
+class IRPassProfiler
+{
+public:
+    bool isEnabled() const { return m_enabled; }
+    void setEnabled(bool enabled) { m_enabled = enabled; }
+
+    void clear();
+
+    void record(
+        const char* passName,
+        std::chrono::nanoseconds duration,
+        Count instCountBefore,
+        Count instCountAfter,
+        Int64 arenaBytesDelta);
+
+    /// Record that the optional pass `passName` was not run.
+    void recordSkipped(const char* passName);
+
+    /// Add `value` to the counter `counterName` of the pass `passName`, e.g. to report how
+    /// many iterations the pass took to converge.
+    void addCounter(const char* passName, const char* counterName, Int64 value);
+
+    /// Add up what every thread has recorded for each pass, in the order the passes were
+    /// first recorded on any thread.
+    void getMergedPasses(OrderedDictionary<const char*, IRPassStatistics>& outPasses);
+
+    /// Write a human readable table, one pass per line in first-run order.
+    void writeReport(StringBuilder& out);
+    /// Write the statistics as a JSON array of pass objects.
+    void writeJSON(StringBuilder& out);
+
+    static IRPassProfiler* getProfiler();
+
+    ~IRPassProfiler();
+
+protected:
+    struct ThreadBuffer;
+    struct ThreadBufferHolder;
+
+    ThreadBuffer* _getThreadBuffer();
+    static IRPassStatistics& _getPass(
+        OrderedDictionary<const char*, IRPassStatistics>& passes,
+        const char* passName);
+
+    std::atomic<bool> m_enabled{false};
+
+    // Guards `m_threadBuffers`. It is taken before the mutex of a buffer.
+    std::mutex m_threadBuffersMutex;
+    List<ThreadBuffer*> m_threadBuffers;
+
+    // Orders the invocations recorded on all threads, to find the most recent.
+    std::atomic<uint64_t> m_recordCount{0};
+};
+
+/// Count all instructions in `module`, including decorations and nested children.
+Count countIRInsts(IRModule* module);
+
+/// Instruments a single run of an IR pass.
+///
+/// When `profiler` is null this does nothing. Otherwise the pass's time is reported
+/// through the `PerformanceProfiler` (and so `ISlangProfiler` and trace output) under
+/// `passName`, and its effect on instruction count and arena usage is recorded in `profiler`.
+struct IRPassProfileScope
+{
+    IRPassProfileScope(IRPassProfiler* profiler, IRModule* module, const char* passName);
+    ~IRPassProfileScope();
+
+    IRPassProfiler* m_profiler;
+    IRModule* m_module;
+    const char* m_passName;
+    Count m_instCountBefore = 0;
+    size_t m_arenaBytesBefore = 0;
+    FuncProfileContext m_context;
+};
+
+} // namespace Slang
@@ -1195,7 +1195,7 @@ struct PeepholeContext : InstPassBase
     bool processFunc(IRInst* func)
     {
         if (!useFastAnalysis)
-            func->getModule()->invalidateAllAnalysis();
+            func->getModule()->invalidateUntrackedAnalysis();
 
         bool lastIsInGeneric = isInGeneric;
         if (!isInGeneric)
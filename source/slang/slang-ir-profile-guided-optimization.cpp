@@ -0,0 +1,281 @@
+// slang-ir-profile-guided-optimization.cpp
+#include "slang-ir-profile-guided-optimization.h"
+
+#include "../core/slang-io.h"
+#include "../core/slang-string-util.h"
+#include "slang-ir-insts.h"
+#include "slang-ir-util.h"
+#include "slang-ir.h"
+
+namespace Slang
+{
+
+// A loop or function is hot if its count is at least this fraction of the
+// largest count in the profile.
+//
+static const IRIntegerValue kHotCountDivisor = 8;
+
+// Hot loops are only unrolled if they run at most this many iterations,
+// so that unrolling them doesn't blow up the size of the code.
+//
+static const IRIntegerValue kMaxProfileGuidedUnrollIterations = 16;
+
+/// A block whose executions are counted: the first block of a function,
+/// or the header of a loop.
+struct ProfileCounterSite
+{
+    IRFunc* func = nullptr;
+    IRLoop* loop = nullptr;
+    IRBlock* block = nullptr;
+};
+
+static bool _shouldCountFunc(IRFunc* func)
+{
+    if (!func->getFirstBlock())
+        return false;
+
+    // Functions that are always inlined or replaced by the target
+    // don't need to be counted.
+    //
+    for (auto decoration : func->getDecorations())
+    {
+        switch (decoration->getOp())
+        {
+        case kIROp_TargetIntrinsicDecoration:
+        case kIROp_IntrinsicOpDecoration:
+        case kIROp_ForceInlineDecoration:
+        case kIROp_UnsafeForceInlineEarlyDecoration:
+            return false;
+        default:
+            break;
+        }
+    }
+    return true;
+}
+
+// The counters are numbered in the order of the functions in the module,
+// and of the loops in each function. The instrumented build and the build
+// that reads the profile number them at the same point of the pipeline, so
+// the numbers identify the same blocks as long as the two builds compile the
+// same program with the same options.
+//
+static void _collectProfileCounterSites(IRModule* module, List<ProfileCounterSite>& outSites)
+{
+    for (auto globalInst : module->getGlobalInsts())
+    {
+        auto func = as<IRFunc>(globalInst);
+        if (auto generic = as<IRGeneric>(globalInst))
+            func = as<IRFunc>(findGenericReturnVal(generic));
+        if (!func || !_shouldCountFunc(func))
+            continue;
+
+        ProfileCounterSite funcSite;
+        funcSite.func = func;
+        funcSite.block = func->getFirstBlock();
+        outSites.add(funcSite);
+
+        for (auto block : func->getBlocks())
+        {
+            auto loop = as<IRLoop>(block->getTerminator());
+            if (!loop)
+                continue;
+
+            ProfileCounterSite loopSite;
+            loopSite.func = func;
+            loopSite.loop = loop;
+            loopSite.block = loop->getTargetBlock();
+            outSites.add(loopSite);
+        }
+    }
+}
+
+static IRGlobalParam* _findProfileCounterBuffer(IRModule* module)
+{
+    for (auto globalInst : module->getGlobalInsts())
+    {
+        auto param = as<IRGlobalParam>(globalInst);
+        if (param && param->findDecoration<IRProfileCountersDecoration>())
+            return param;
+    }
+    return nullptr;
+}
+
+void instrumentProfileCounters(IRModule* module, DiagnosticSink* sink)
+{
+    auto counterBuffer = _findProfileCounterBuffer(module);
+    auto bufferType =
+        counterBuffer ? as<IRHLSLRWStructuredBufferType>(counterBuffer->getDataType()) : nullptr;
+    if (!bufferType || bufferType->getElementType()->getOp() != kIROp_UIntType)
+    {
+        sink->diagnose(
+            counterBuffer ? counterBuffer->sourceLoc : SourceLoc(),
+            Diagnostics::missingProfileCounterBuffer);
+        return;
+    }
+
+    List<ProfileCounterSite> sites;
+    _collectProfileCounterSites(module, sites);
+
+    IRBuilder builder(module);
+    for (Index i = 0; i < sites.getCount(); i++)
+    {
+        auto& site = sites[i];
+        builder.setInsertBefore(site.block->getFirstOrdinaryInst());
+
+        auto counterPtr = builder.emitRWStructuredBufferGetElementPtr(
+            counterBuffer,
+            builder.getIntValue(builder.getUIntType(), i));
+        IRInst* atomicAddArgs[] = {
+            counterPtr,
+            builder.getIntValue(builder.getUIntType(), 1),
+            builder.getIntValue(builder.getIntType(), kIRMemoryOrder_Relaxed)};
+        builder.emitIntrinsicInst(builder.getUIntType(), kIROp_AtomicAdd, 3, atomicAddArgs);
+
+        if (site.loop)
+            sink->diagnose(site.loop, Diagnostics::profileCounterForLoop, i, site.func);
+        else
+            sink->diagnose(site.func, Diagnostics::profileCounterForFunction, i, site.func);
+    }
+}
+
+// Get the number of iterations of `loop`, if the front end found it to run a
+// constant number of iterations, and its header compares an induction variable
+// that starts at a constant with a constant. Returns 0 otherwise.
+//
+static IRIntegerValue _getConstantIterationCount(IRLoop* loop)
+{
+    auto maxItersDecoration = loop->findDecoration<IRLoopMaxItersDecoration>();
+    if (!maxItersDecoration || !as<IRIntLit>(maxItersDecoration->getMaxItersInst()))
+        return 0;
+
+    auto header = loop->getTargetBlock();
+    auto ifElse = as<IRIfElse>(header->getTerminator());
+    if (!ifElse)
+        return 0;
+
+    auto condition = ifElse->getCondition();
+    switch (condition->getOp())
+    {
+    case kIROp_Less:
+    case kIROp_Leq:
+    case kIROp_Greater:
+    case kIROp_Geq:
+    case kIROp_Neq:
+        break;
+    default:
+        return 0;
+    }
+
+    for (UInt i = 0; i < 2; i++)
+    {
+        auto param = as<IRParam>(condition->getOperand(i));
+        if (!param || param->getParent() != header || !as<IRIntLit>(condition->getOperand(1 - i)))
+            continue;
+
+        UInt paramIndex = 0;
+        for (auto headerParam : header->getParams())
+        {
+            if (headerParam == param)
+                break;
+            paramIndex++;
+        }
+        if (paramIndex >= loop->getArgCount() || !as<IRIntLit>(loop->getArg(paramIndex)))
+            return 0;
+
+        return maxItersDecoration->getMaxIters();
+    }
+    return 0;
+}
+
+static bool _isRecursive(IRFunc* func)
+{
+    for (auto use = func->firstUse; use; use = use->nextUse)
+    {
+        if (as<IRCall>(use->getUser()) && isChildInstOf(use->getUser(), func))
+            return true;
+    }
+    return false;
+}
+
+static void _optimizeHotLoop(IRBuilder& builder, IRLoop* loop)
+{
+    // Loops that the user already controls the unrolling of are left alone.
+    if (loop->findDecoration<IRForceUnrollDecoration>() ||
+        loop->findDecoration<IRLoopControlDecoration>())
+        return;
+
+    auto iterationCount = _getConstantIterationCount(loop);
+    if (iterationCount <= 0 || iterationCount > kMaxProfileGuidedUnrollIterations)
+        return;
+
+    builder.addLoopForceUnrollDecoration(loop, iterationCount);
+}
+
+static void _optimizeHotFunc(IRBuilder& builder, IRFunc* func)
+{
+    if (func->findDecoration<IREntryPointDecoration>() ||
+        func->findDecoration<IRNoInlineDecoration>() || _isRecursive(func))
+        return;
+
+    builder.addForceInlineDecoration(func);
+}
+
+void applyProfileCounts(IRModule* module, String const& path, DiagnosticSink* sink)
+{
+    String text;
+    if (SLANG_FAILED(File::readAllText(path, text)))
+    {
+        sink->diagnose(SourceLoc(), Diagnostics::cannotOpenFile, path);
+        return;
+    }
+
+    List<UnownedStringSlice> tokens;
+    StringUtil::splitOnWhitespace(text.getUnownedSlice(), tokens);
+
+    List<IRIntegerValue> counts;
+    for (auto token : tokens)
+    {
+        int64_t count = 0;
+        if (SLANG_FAILED(StringUtil::parseInt64(token, count)) || count < 0)
+        {
+            sink->diagnose(SourceLoc(), Diagnostics::invalidProfileCount, path, token);
+            return;
+        }
+        counts.add(count);
+    }
+
+    List<ProfileCounterSite> sites;
+    _collectProfileCounterSites(module, sites);
+    if (counts.getCount() != sites.getCount())
+    {
+        sink->diagnose(
+            SourceLoc(),
+            Diagnostics::profileCountMismatch,
+            path,
+            counts.getCount(),
+            sites.getCount());
+        return;
+    }
+
+    IRIntegerValue maxCount = 0;
+    for (auto count : counts)
+        maxCount = Math::Max(maxCount, count);
+    if (maxCount == 0)
+        return;
+
+    IRBuilder builder(module);
+    for (Index i = 0; i < sites.getCount(); i++)
+    {
+        auto count = counts[i];
+        if (count == 0 || count * kHotCountDivisor < maxCount)
+            continue;
+
+        auto& site = sites[i];
+        if (site.loop)
+            _optimizeHotLoop(builder, site.loop);
+        else
+            _optimizeHotFunc(builder, site.func);
+    }
+}
+
+} // namespace Slang
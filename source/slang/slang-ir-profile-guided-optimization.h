@@ -0,0 +1,24 @@
+// slang-ir-profile-guided-optimization.h
+#pragma once
+
+#include "../core/slang-basic.h"
+
+namespace Slang
+{
+class DiagnosticSink;
+struct IRModule;
+
+/// Count the calls to each function and the iterations of each loop of `module`, by atomically
+/// incrementing a counter in the global `RWStructuredBuffer<uint>` marked `[ProfileCounters]`
+/// when their first block runs. A note reports what each counter counts.
+void instrumentProfileCounters(IRModule* module, DiagnosticSink* sink);
+
+/// Read the counts of a build of the same program instrumented with `instrumentProfileCounters`
+/// from the file at `path`, and optimize the hot parts of `module` with them.
+///
+/// Hot loops that run a small, constant number of iterations are marked to be unrolled, and hot
+/// functions are marked to be inlined.
+///
+void applyProfileCounts(IRModule* module, String const& path, DiagnosticSink* sink);
+
+} // namespace Slang
@@ -2,6 +2,7 @@
 
 #include "slang-diagnostics.h"
 #include "slang-ir-autodiff.h"
+#include "slang-ir-clone.h"
 #include "slang-ir-insts.h"
 #include "slang-ir-lower-cuda-builtin-types.h"
 #include "slang-ir.h"
@@ -455,12 +456,40 @@ static void generateCppBindingForFunc(IRFunc* func, DiagnosticSink* sink)
                 auto argArrayPtr = builder.emitElementAddress(
                     argArrayVar,
                     builder.getIntValue(builder.getIntType(), 0));
+
+                // The contiguous variant of the kernel can only be picked when the tensor
+                // behind each of the views it was specialized for is known.
+                IRInst* contiguousVariant = nullptr;
+                List<IRInst*> contiguousTensors;
+                if (auto variantDecor =
+                        kernelDispatch->getBaseFn()
+                            ->findDecoration<IRCudaKernelContiguousVariantDecoration>())
+                {
+                    auto variantFunc = variantDecor->getContiguousVariantFunc();
+                    contiguousVariant = variantFunc;
+                    auto variantParam = variantFunc->getFirstParam();
+                    for (UInt i = 0; i < kernelArgCount && variantParam && contiguousVariant;
+                         i++)
+                    {
+                        auto viewType = as<IRTensorViewType>(variantParam->getDataType());
+                        variantParam = variantParam->getNextParam();
+                        if (!viewType || !viewType->hasContiguousInnermostDim())
+                            continue;
+                        auto arg = kernelDispatch->getArg(i);
+                        if (arg->getOp() == kIROp_MakeTensorView)
+                            contiguousTensors.add(arg->getOperand(0));
+                        else
+                            contiguousVariant = nullptr;
+                    }
+                }
                 builder.emitCudaKernelLaunch(
                     kernelDispatch->getBaseFn(),
                     kernelDispatch->getDispatchSize(),
                     kernelDispatch->getThreadGroupSize(),
                     argArrayPtr,
-                    builder.emitGetTorchCudaStream());
+                    builder.emitGetTorchCudaStream(),
+                    contiguousVariant,
+                    contiguousTensors);
                 instsToRemove.add(inst);
             }
             else if (auto getView = as<IRTorchTensorGetView>(inst))
@@ -1227,6 +1256,87 @@ void lowerBuiltinTypesForKernelEntryPoints(IRModule* module, DiagnosticSink*)
     }
 }
 
+// A view of scalars is specialized in the contiguous variant of a kernel. The views of vectors
+// are left as they are, since their tensors are always contiguous already.
+static bool shouldSpecializeForContiguousTensor(IRType* type)
+{
+    auto tensorViewType = as<IRTensorViewType>(type);
+    return tensorViewType && !as<IRVectorType>(tensorViewType->getElementType());
+}
+
+void generateContiguousTensorViewKernelVariants(IRModule* module)
+{
+    List<IRFunc*> kernels;
+    for (auto globalInst : module->getGlobalInsts())
+    {
+        auto func = as<IRFunc>(globalInst);
+        if (!func || !func->isDefinition() || !func->findDecoration<IRCudaKernelDecoration>())
+            continue;
+
+        // The variant has to be named the same way in the CUDA source and the host code.
+        if (!func->findDecoration<IRExternCppDecoration>())
+            continue;
+
+        for (auto param : func->getParams())
+        {
+            if (shouldSpecializeForContiguousTensor(param->getDataType()))
+            {
+                kernels.add(func);
+                break;
+            }
+        }
+    }
+
+    IRBuilder builder(module);
+    for (auto func : kernels)
+    {
+        builder.setInsertAfter(func);
+        IRCloneEnv cloneEnv;
+        auto variant = as<IRFunc>(cloneInst(&cloneEnv, &builder, func));
+
+        // The variant is only ever launched in place of the kernel, so it doesn't take part in
+        // linking or in generating bindings of its own.
+        List<IRDecoration*> decorationsToRemove;
+        for (auto decor : variant->getDecorations())
+        {
+            switch (decor->getOp())
+            {
+            case kIROp_ExternCppDecoration:
+            case kIROp_AutoPyBindCudaDecoration:
+            case kIROp_AutoPyBindExportInfoDecoration:
+            case kIROp_TorchEntryPointDecoration:
+            case kIROp_CudaKernelForwardDerivativeDecoration:
+            case kIROp_CudaKernelBackwardDerivativeDecoration:
+                decorationsToRemove.add(decor);
+                break;
+            default:
+                if (as<IRLinkageDecoration>(decor))
+                    decorationsToRemove.add(decor);
+                break;
+            }
+        }
+        for (auto decor : decorationsToRemove)
+            decor->removeAndDeallocate();
+
+        StringBuilder nameBuilder;
+        nameBuilder << func->findDecoration<IRExternCppDecoration>()->getName() << "_contiguous";
+        builder.addExternCppDecoration(variant, nameBuilder.getUnownedSlice());
+        if (!variant->findDecoration<IRKeepAliveDecoration>())
+            builder.addKeepAliveDecoration(variant);
+
+        for (auto param : variant->getParams())
+        {
+            if (!shouldSpecializeForContiguousTensor(param->getDataType()))
+                continue;
+            auto elementType = as<IRTensorViewType>(param->getDataType())->getElementType();
+            param->setFullType(builder.getContiguousTensorViewType(elementType));
+        }
+        fixUpFuncType(variant);
+
+        builder.addCudaKernelContiguousVariantDecoration(func, variant);
+    }
+}
+
 void generateHostFunctionsForAutoBindCuda(IRModule* module, DiagnosticSink* sink)
 {
     List<IRFunc*> autoBindRequests;
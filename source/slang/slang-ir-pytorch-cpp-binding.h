@@ -11,6 +11,11 @@ void removeTorchKernels(IRModule* module);
 void handleAutoBindNames(IRModule* module);
 void generateDerivativeWrappers(IRModule* module, DiagnosticSink* sink);
 void lowerBuiltinTypesForKernelEntryPoints(IRModule* module, DiagnosticSink* sink);
+
+/// Add a variant of each CUDA kernel that takes views of scalar tensors, in which those views
+/// are known to have a contiguous innermost dimension. The host code launches the variant
+/// instead of the kernel when the tensors it is given allow it.
+void generateContiguousTensorViewKernelVariants(IRModule* module);
 void removeTorchAndCUDAEntryPoints(IRModule* module);
 
 } // namespace Slang
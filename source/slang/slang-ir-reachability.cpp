@@ -57,12 +57,32 @@ ReachabilityContext::ReachabilityContext(IRGlobalValueWithCode* code)
     }
 }
 
+void ReachabilityContext::numberInsts()
+{
+    mapInstToOrder.clear();
+    for (auto block : allBlocks)
+    {
+        Index order = 0;
+        for (auto inst : block->getChildren())
+            mapInstToOrder[inst] = order++;
+    }
+}
+
 bool ReachabilityContext::isInstReachable(IRInst* from, IRInst* to)
 {
     // If inst1 and inst2 are in the same block,
     // we test if inst2 appears after inst1.
     if (getBlock(from) == getBlock(to))
     {
+        auto fromOrder = mapInstToOrder.tryGetValue(from);
+        auto toOrder = mapInstToOrder.tryGetValue(to);
+        if (fromOrder && toOrder)
+        {
+            if (*toOrder > *fromOrder)
+                return true;
+            return isBlockReachable(getBlock(from), getBlock(to));
+        }
+
         for (auto inst = from->getNextInst(); inst; inst = inst->getNextInst())
         {
             if (inst == to)
@@ -14,9 +14,19 @@ struct ReachabilityContext
     List<UIntSet> sourceBlocks; // sourcesBlocks[i] stores the set of blocks from which block i can
                                 // be reached.
 
+    // The position of each instruction in its block, if `numberInsts` was called.
+    Dictionary<IRInst*, Index> mapInstToOrder;
+
     ReachabilityContext() = default;
     ReachabilityContext(IRGlobalValueWithCode* code);
 
+    // Number the instructions of each block, so that `isInstReachable` can tell if one
+    // instruction comes after another in the same block without walking the block, which
+    // otherwise makes the queries on large blocks, such as unrolled loops, quadratic.
+    // The numbering needs to be computed again if instructions are added to or moved
+    // within the blocks.
+    void numberInsts();
+
     bool isInstReachable(IRInst* from, IRInst* to);
     bool isBlockReachable(IRBlock* from, IRBlock* to);
 };
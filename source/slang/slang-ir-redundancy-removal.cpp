@@ -6,9 +6,41 @@
 namespace Slang
 {
 
+// Is `inst` a load from a resource that shaders can't write to, such as a
+// `StructuredBuffer` or a constant buffer?
+//
+// Like `isGlobalOrUnknownMutableAddress`, we assume that such resources don't
+// share memory with a writable resource, so the memory they read from is in the
+// same state during the whole shader, and two loads with the same operands
+// produce the same value no matter what is written in between.
+//
+static bool isReadOnlyResourceLoad(IRInst* inst)
+{
+    switch (inst->getOp())
+    {
+    case kIROp_StructuredBufferLoad:
+        return as<IRHLSLStructuredBufferType>(inst->getOperand(0)->getDataType()) != nullptr;
+    case kIROp_ByteAddressBufferLoad:
+        return as<IRHLSLByteAddressBufferType>(inst->getOperand(0)->getDataType()) != nullptr;
+    case kIROp_Load:
+        {
+            auto root = getRootAddr(inst->getOperand(0));
+            return root && as<IRUniformParameterGroupType>(root->getDataType());
+        }
+    default:
+        return false;
+    }
+}
+
 struct RedundancyRemovalContext
 {
     RefPtr<IRDominatorTree> dom;
+
+    bool canDeduplicate(IRInst* inst)
+    {
+        return isMovableInst(inst) || isReadOnlyResourceLoad(inst);
+    }
+
     bool isSingleIterationLoop(IRLoop* loop)
     {
         int useCount = 0;
@@ -86,7 +118,7 @@ struct RedundancyRemovalContext
                         return false;
                     if (dom->isUnreachable(parentBlock))
                         return false;
-                    return isMovableInst(inst);
+                    return canDeduplicate(inst);
                 });
             if (resultInst != instP)
             {
@@ -98,6 +130,9 @@ struct RedundancyRemovalContext
             {
                 // This inst is unique, we should consider hoisting it
                 // if it is inside a loop.
+                //
+                // Loads from read-only resources are not hoisted, since a
+                // loop that runs no iterations may be guarding the index.
                 result |= tryHoistInstToOuterMostLoop(func, resultInst);
             }
         }
@@ -135,7 +170,13 @@ bool removeRedundancyInFunc(IRGlobalValueWithCode* func)
         return false;
 
     RedundancyRemovalContext context;
-    context.dom = computeDominatorTree(func);
+    // This pass doesn't change the CFG, so when changes are being tracked the
+    // dominator tree cached for the function can be used.
+    auto module = func->getModule();
+    if (module && module->isTrackingAnalysisChanges())
+        context.dom = module->findOrCreateDominatorTree(func);
+    else
+        context.dom = computeDominatorTree(func);
     Dictionary<IRBlock*, DeduplicateContext> mapBlockToDeduplicateContext;
     for (auto block : func->getBlocks())
     {
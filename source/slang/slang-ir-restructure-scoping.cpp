@@ -37,82 +37,25 @@ static SimpleRegion* getFirstRegionForInst(RegionTree* regionTree, IRInst* inst)
     return nullptr;
 }
 
-/// Compute the depth of a node in the region tree.
-///
-/// This is the number of nodes (including `region`)
-/// on a path from `region` to the root.
-///
-static Int computeDepth(Region* region)
-{
-    Int depth = 0;
-    for (Region* rr = region; rr; rr = rr->getParent())
-    {
-        depth++;
-    }
-    return depth;
-}
-
-/// Get the `n`th ancestor of `region`.
-///
-/// When `n` is zero, this returns `region`.
-/// When `n` is one, this returns the parent of `region`, and so forth.
-///
-static Region* getAncestor(Region* region, Int n)
-{
-    Region* rr = region;
-    for (Int ii = 0; ii < n; ++ii)
-    {
-        SLANG_ASSERT(rr);
-        rr = rr->getParent();
-    }
-    return rr;
-}
-
 /// Find a region that is an ancestor of both `left` and `right`.
 static Region* findCommonAncestorRegion(Region* left, Region* right)
 {
-    // Rather than blinding search through each ancestor of `left`
-    // and see if it is also an ancestor of `right` and vice-versa,
-    // let's try to be smart about this.
-    //
-    // We will start by computing the depth of `left` and `right`:
-    //
-    Int leftDepth = computeDepth(left);
-    Int rightDepth = computeDepth(right);
-
-    // Whatever the common ancestor is, it can't be any deeper
-    // than the minimum of these two depths.
+    // The regions of a tree are numbered such that checking whether
+    // one is a descendent of another is constant time, so we can
+    // walk up from `left` until we reach an ancestor of `right`,
+    // rather than first measuring the depth of both.
     //
-    Int minDepth = Math::Min(leftDepth, rightDepth);
-
-    // Let's fetch the ancestor of each of `left` and `right`
-    // corresponding to that depth:
-    //
-    Region* leftAncestor = getAncestor(left, leftDepth - minDepth);
-    Region* rightAncestor = getAncestor(right, rightDepth - minDepth);
-
-    // Now we know that `leftAncestor` and `rightAncestor`
-    // must have the same depth. Let's go ahead and assert
-    // it just to be safe:
-    //
-    SLANG_ASSERT(computeDepth(leftAncestor) == minDepth);
-    SLANG_ASSERT(computeDepth(rightAncestor) == minDepth);
-
-    // If `leftAncestor` and `rightAncestor` are the same node,
-    // then we've found a common ancestor, otherwise we should
-    // look at their parents. Because the depth must match
-    // on both sides, we will never risk missing an ancestor.
-    //
-    while (leftAncestor != rightAncestor)
+    Region* ancestor = left;
+    while (ancestor && !right->isDescendentOf(ancestor))
     {
-        leftAncestor = leftAncestor->getParent();
-        rightAncestor = rightAncestor->getParent();
+        ancestor = ancestor->getParent();
     }
 
-    // Okay, we've found a common ancestor.
+    // The root of the tree is an ancestor of every region, so we
+    // will always find one.
     //
-    Region* commonAncestor = leftAncestor;
-    return commonAncestor;
+    SLANG_ASSERT(ancestor);
+    return ancestor;
 }
 
 /// Find a simple region that is an ancestor of both `left` and `right`.
@@ -196,6 +139,7 @@ void defaultInitializeVar(IRBuilder* builder, IRVar* var, IRType* type)
 /// should be the region tree for the function that contains `def`.
 ///
 static void fixValueScopingForInst(
+    IRBuilder& builder,
     IRInst* def,
     SimpleRegion* defRegion,
     RegionTree* regionTree,
@@ -234,16 +178,6 @@ static void fixValueScopingForInst(
     SimpleRegion* insertRegion = defRegion;
     IRVar* tmp = nullptr;
 
-    // If we end up needing to insert code we'll need an IR builder,
-    // so we will go ahead and create one now.
-    //
-    // TODO: the logic to compute `module` here could be hoisted
-    // out earlier, rather than being done per-instruction.
-    //
-    IRModule* module = regionTree->irCode->getModule();
-
-    IRBuilder builder(module);
-
     // Because we will be changing some of the uses of `def`
     // to use other values while we iterate the list, we
     // need to be a bit careful and extract the next use
@@ -287,7 +221,7 @@ static void fixValueScopingForInst(
         // of a region that has the same block as `defRegion`.
         // If it is, then there is no scoping problem with this use.
         //
-        if (useRegion->isDescendentOf(defRegion->block))
+        if (regionTree->isRegionDescendentOfBlock(useRegion, defRegion->block))
             continue;
 
         // If we've gotten this far, we know that `u` is a "bad"
@@ -434,6 +368,12 @@ void fixValueScoping(RegionTree* regionTree, const Func<bool, IRInst*>& shouldAl
     // in the code of the function to detect an bad cases.
     //
     auto code = regionTree->irCode;
+
+    // If we end up needing to insert code we'll need an IR builder,
+    // which can be shared by all of the instructions.
+    //
+    IRBuilder builder(code->getModule());
+
     for (auto block : code->getBlocks())
     {
         // All of the instruction in `block` will have the same
@@ -471,7 +411,7 @@ void fixValueScoping(RegionTree* regionTree, const Func<bool, IRInst*>& shouldAl
         {
             nextInst = inst->getNextInst();
             bool isInstAlwaysFolded = shouldAlwaysFoldInst(inst);
-            fixValueScopingForInst(inst, parentRegion, regionTree, isInstAlwaysFolded);
+            fixValueScopingForInst(builder, inst, parentRegion, regionTree, isInstAlwaysFolded);
         }
     }
 }
@@ -8,6 +8,11 @@ namespace Slang
 {
 bool Region::isDescendentOf(Region* other)
 {
+    if (preorderIndex >= 0 && other->preorderIndex >= 0)
+    {
+        return other->preorderIndex <= preorderIndex && preorderIndex < other->descendentEndIndex;
+    }
+
     Region* rr = this;
     while (rr)
     {
@@ -36,6 +41,18 @@ bool Region::isDescendentOf(IRBlock* block)
     return false;
 }
 
+bool RegionTree::isRegionDescendentOfBlock(Region* region, IRBlock* block)
+{
+    SimpleRegion* blockRegion = nullptr;
+    mapBlockToRegion.tryGetValue(block, blockRegion);
+    for (auto rr = blockRegion; rr; rr = rr->nextSimpleRegionForSameBlock)
+    {
+        if (region->isDescendentOf(rr))
+            return true;
+    }
+    return false;
+}
+
 /// An "active" label during control flow (re)structuring.
 struct LabelStack
 {
@@ -75,6 +92,24 @@ struct ControlFlowRestructuringContext
 
     /// The region tree we are in the process of building.
     RegionTree* regionTree = nullptr;
+
+    /// The regions of the tree in the order they were created.
+    ///
+    /// A region is always created before the regions nested
+    /// in it, and those are all created before any region
+    /// outside of it, so this is a pre-order walk of the tree.
+    ///
+    List<Region*> regions;
+
+    template<typename T, typename... TArgs>
+    RefPtr<T> createRegion(TArgs... args)
+    {
+        RefPtr<T> region = new T(args...);
+        region->preorderIndex = regions.getCount();
+        region->descendentEndIndex = region->preorderIndex + 1;
+        regions.add(region);
+        return region;
+    }
 };
 
 /// Convert a range of blocks in the IR CFG into a region.
@@ -188,7 +223,8 @@ static RefPtr<Region> generateRegionsForIRBlocks(
             case LabelStack::Op::Break:
                 {
                     auto outerRegion = (BreakableRegion*)ll->region;
-                    RefPtr<BreakRegion> breakRegion = new BreakRegion(parentRegion, outerRegion);
+                    RefPtr<BreakRegion> breakRegion =
+                        ctx->createRegion<BreakRegion>(parentRegion, outerRegion);
 
                     *resultLink = breakRegion;
                     resultLink = nullptr;
@@ -199,7 +235,7 @@ static RefPtr<Region> generateRegionsForIRBlocks(
                 {
                     auto outerRegion = (LoopRegion*)ll->region;
                     RefPtr<ContinueRegion> continueRegion =
-                        new ContinueRegion(parentRegion, outerRegion);
+                        ctx->createRegion<ContinueRegion>(parentRegion, outerRegion);
 
                     *resultLink = continueRegion;
                     resultLink = nullptr;
@@ -215,7 +251,7 @@ static RefPtr<Region> generateRegionsForIRBlocks(
         // We now know that the given `block` is part of our control-flow region,
         // so we need to output a simple region that executes the code in that block.
         //
-        RefPtr<SimpleRegion> simpleRegion = new SimpleRegion(parentRegion, block);
+        RefPtr<SimpleRegion> simpleRegion = ctx->createRegion<SimpleRegion>(parentRegion, block);
 
         // We need to register the mapping from `block` to this region, but in
         // general this isn't a one-to-one mapping, but rather one-to-many.
@@ -231,6 +267,7 @@ static RefPtr<Region> generateRegionsForIRBlocks(
         //
         SimpleRegion* nextSimpleRegionForSameBlock = nullptr;
         ctx->regionTree->mapBlockToRegion.tryGetValue(block, nextSimpleRegionForSameBlock);
+        simpleRegion->nextSimpleRegionForSameBlock = nextSimpleRegionForSameBlock;
         ctx->regionTree->mapBlockToRegion[block] = simpleRegion;
 
         *resultLink = simpleRegion;
@@ -276,7 +313,7 @@ static RefPtr<Region> generateRegionsForIRBlocks(
                 auto afterBlock = ifInst->getAfterBlock();
 
 
-                RefPtr<IfRegion> ifRegion = new IfRegion(parentRegion, ifInst);
+                RefPtr<IfRegion> ifRegion = ctx->createRegion<IfRegion>(parentRegion, ifInst);
 
                 // The region for the "then" part of things will consist of
                 // the range of blocks `[trueBlock, afterBlock)`.
@@ -313,7 +350,8 @@ static RefPtr<Region> generateRegionsForIRBlocks(
                 auto bodyBlock = loopInst->getTargetBlock();
                 auto afterBlock = loopInst->getBreakBlock();
 
-                RefPtr<LoopRegion> loopRegion = new LoopRegion(parentRegion, loopInst);
+                RefPtr<LoopRegion> loopRegion =
+                    ctx->createRegion<LoopRegion>(parentRegion, loopInst);
 
                 // We will need to set up entries on our label stack to
                 // represent the targets for `break` or `continue`
@@ -456,7 +494,8 @@ static RefPtr<Region> generateRegionsForIRBlocks(
                 auto breakLabel = switchInst->getBreakLabel();
                 auto defaultLabel = switchInst->getDefaultLabel();
 
-                RefPtr<SwitchRegion> switchRegion = new SwitchRegion(parentRegion, switchInst);
+                RefPtr<SwitchRegion> switchRegion =
+                    ctx->createRegion<SwitchRegion>(parentRegion, switchInst);
 
                 // A direct branch to the block after the `switch` can
                 // be emitted as a `break` statement, so we will register
@@ -647,6 +686,20 @@ RefPtr<RegionTree> generateRegionTreeForFunc(IRGlobalValueWithCode* code, Diagno
         nullptr,
         nullptr);
 
+    // The descendents of a region were all created after it, so walking the regions
+    // backwards extends the range of each parent over the ranges of its children.
+    //
+    auto& regions = restructuringContext.regions;
+    for (Index i = regions.getCount() - 1; i >= 0; --i)
+    {
+        auto region = regions[i];
+        if (auto parent = region->getParent())
+        {
+            parent->descendentEndIndex =
+                Math::Max(parent->descendentEndIndex, region->descendentEndIndex);
+        }
+    }
+
     return regionTree;
 }
 } // namespace Slang
@@ -48,6 +48,17 @@ public:
     /// of any simple region for `block`.
     bool isDescendentOf(IRBlock* block);
 
+    /// The index of this region in a pre-order walk of its tree.
+    ///
+    /// The descendents of a region are the regions with indices
+    /// in `[preorderIndex, descendentEndIndex)`, which lets
+    /// `isDescendentOf` answer without walking the ancestors.
+    /// Both are set by `generateRegionTreeForFunc`, and are -1
+    /// for a region that isn't part of a tree.
+    ///
+    Index preorderIndex = -1;
+    Index descendentEndIndex = -1;
+
 protected:
     Region(Flavor flavor, Region* parent)
         : flavor(flavor), parent(parent)
@@ -252,6 +263,14 @@ public:
 
     /// The IR function that was used to compute the region tree.
     IRGlobalValueWithCode* irCode = nullptr;
+
+    /// Is `region` a descendent of any simple region for `block`?
+    ///
+    /// This is the same test as `Region::isDescendentOf(IRBlock*)`, but
+    /// only looks at the regions for `block` rather than all the
+    /// ancestors of `region`.
+    ///
+    bool isRegionDescendentOfBlock(Region* region, IRBlock* block);
 };
 
 /// Construct structrured regions to represent the control flow in an IR function.
@@ -1385,6 +1385,7 @@ struct SCCPContext
 
         bool changed = false;
         // Replace the insts with their values.
+        IRInstReplacements replacements;
         List<IRInst*> instsToRemove;
         for (auto child : scopeInst->getChildren())
         {
@@ -1394,10 +1395,11 @@ struct SCCPContext
             auto latticeVal = getLatticeVal(child);
             if (latticeVal.flavor == LatticeVal::Flavor::Constant && latticeVal.value != child)
             {
-                child->replaceUsesWith(latticeVal.value);
+                replacements.add(child, latticeVal.value);
                 instsToRemove.add(child);
             }
         }
+        replacements.apply();
 
         if (instsToRemove.getCount())
         {
@@ -1541,6 +1543,7 @@ struct SCCPContext
         // First, we will walk through all the code and replace instructions
         // with constants where it is possible.
         //
+        IRInstReplacements replacements;
         List<IRInst*> instsToRemove;
         for (auto block : code->getBlocks())
         {
@@ -1567,7 +1570,10 @@ struct SCCPContext
                 // instructions to be removed *iff* the instruction
                 // is known to have no obersvable side effects.
                 //
-                inst->replaceUsesWith(constantVal);
+                // The uses of all the instructions are replaced
+                // together once the walk is done.
+                //
+                replacements.add(inst, constantVal);
                 if (!inst->mightHaveSideEffects())
                 {
                     // Don't delete phi parameters, they will be cleaned up in CFG simplification.
@@ -1576,6 +1582,7 @@ struct SCCPContext
                 }
             }
         }
+        replacements.apply();
 
         if (instsToRemove.getCount() != 0)
             changed = true;
@@ -1596,6 +1603,7 @@ struct SCCPContext
         // need to be emitted using a builder.
         //
         auto builder = getBuilder();
+        bool cfgChanged = false;
         for (auto block : code->getBlocks())
         {
             auto terminator = block->getTerminator();
@@ -1634,6 +1642,7 @@ struct SCCPContext
                     builder->emitBranch(target);
                     terminator->removeAndDeallocate();
                     changed = true;
+                    cfgChanged = true;
                 }
             }
             else if (auto condBranchInst = as<IRConditionalBranch>(terminator))
@@ -1650,6 +1659,7 @@ struct SCCPContext
                     builder->emitBranch(target);
                     terminator->removeAndDeallocate();
                     changed = true;
+                    cfgChanged = true;
                 }
             }
         }
@@ -1760,6 +1770,15 @@ struct SCCPContext
                 builder->emitUnreachable();
             }
         }
+
+        // Folding branches and removing unreachable blocks changes the CFG,
+        // so any analyses cached for the function are now stale.
+        //
+        if (cfgChanged || unreachableBlocks.getCount() != 0)
+        {
+            if (auto module = code->getModule())
+                module->invalidateAnalysisForInst(code);
+        }
         return changed;
     }
 };
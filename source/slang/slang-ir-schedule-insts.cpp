@@ -0,0 +1,263 @@
+// slang-ir-schedule-insts.cpp
+#include "slang-ir-schedule-insts.h"
+
+#include "slang-ir-insts.h"
+#include "slang-ir-util.h"
+#include "slang-ir.h"
+
+namespace Slang
+{
+
+// Passes like automatic differentiation and loop unrolling compute values long
+// before they are needed, and drivers that compile the SPIR-V we emit directly
+// don't always reorder instructions to keep fewer values in registers.
+//
+// We estimate the register pressure of a block as the largest number of values
+// that are live at once in it. A value defined in another block is counted as
+// live across the whole block if it is used anywhere else, and until its last
+// use otherwise, and a value defined in the block is live from its definition
+// until its last use in the block, or until the end of the block if it is used
+// elsewhere. This doesn't account for liveness across blocks precisely, but
+// it measures the effect of reordering the block.
+//
+struct InstSchedulingContext
+{
+    IRGlobalValueWithCode* func = nullptr;
+
+    // Does `inst` hold a value in a register while it is live?
+    //
+    bool occupiesRegister(IRInst* inst)
+    {
+        auto block = as<IRBlock>(inst->getParent());
+        if (!block || block->getParent() != func)
+            return false;
+        if (inst->getOp() == kIROp_Var)
+            return false;
+        auto type = inst->getDataType();
+        return type && !as<IRVoidType>(type);
+    }
+
+    static bool isUsedOutsideBlock(IRInst* inst, IRBlock* block)
+    {
+        for (auto use = inst->firstUse; use; use = use->nextUse)
+        {
+            if (use->getUser()->getParent() != block)
+                return true;
+        }
+        return false;
+    }
+
+    // Compute the register pressure of `block` if its ordinary instructions,
+    // other than the terminator, were in `order`.
+    //
+    Count computePressure(IRBlock* block, List<IRInst*> const& order)
+    {
+        HashSet<IRInst*> live;
+        auto addOperands = [&](IRInst* inst)
+        {
+            for (UInt i = 0; i < inst->getOperandCount(); i++)
+            {
+                auto operand = inst->getOperand(i);
+                if (occupiesRegister(operand))
+                    live.add(operand);
+            }
+        };
+
+        auto terminator = block->getTerminator();
+        addOperands(terminator);
+        for (auto inst : order)
+        {
+            if (occupiesRegister(inst) && isUsedOutsideBlock(inst, block))
+                live.add(inst);
+            for (UInt i = 0; i < inst->getOperandCount(); i++)
+            {
+                auto operand = inst->getOperand(i);
+                if (operand->getParent() != block && occupiesRegister(operand) &&
+                    isUsedOutsideBlock(operand, block))
+                    live.add(operand);
+            }
+        }
+
+        Count maxPressure = (Count)live.getCount();
+        for (Index i = order.getCount() - 1; i >= 0; i--)
+        {
+            auto inst = order[i];
+            addOperands(inst);
+            maxPressure = Math::Max(maxPressure, (Count)live.getCount());
+            live.remove(inst);
+        }
+        return maxPressure;
+    }
+
+    static bool isSchedulable(IRInst* inst)
+    {
+        if (!isMovableInst(inst))
+            return false;
+
+        // Uses from decorations or nested instructions would need to be
+        // ordered after `inst` in ways we don't track.
+        //
+        for (auto use = inst->firstUse; use; use = use->nextUse)
+        {
+            if (!as<IRBlock>(use->getUser()->getParent()))
+                return false;
+        }
+        return true;
+    }
+
+    // Add the schedulable instructions that `inst` depends on, and that
+    // haven't been scheduled yet, to `ioOrder`, operands first.
+    //
+    static void scheduleOperands(
+        IRInst* inst,
+        HashSet<IRInst*> const& schedulable,
+        HashSet<IRInst*>& ioScheduled,
+        List<IRInst*>& ioOrder)
+    {
+        List<IRInst*> stack;
+        stack.add(inst);
+        while (stack.getCount())
+        {
+            auto current = stack.getLast();
+            bool pushedOperand = false;
+            for (UInt i = 0; i < current->getOperandCount(); i++)
+            {
+                auto operand = current->getOperand(i);
+                if (schedulable.contains(operand) && !ioScheduled.contains(operand))
+                {
+                    stack.add(operand);
+                    pushedOperand = true;
+                    break;
+                }
+            }
+            if (pushedOperand)
+                continue;
+            stack.removeLast();
+            if (current != inst && ioScheduled.add(current))
+                ioOrder.add(current);
+        }
+    }
+
+    // Collect the ordinary instructions of `block`, other than the terminator, in order.
+    //
+    static void getBlockOrder(IRBlock* block, List<IRInst*>& outOrder)
+    {
+        auto terminator = block->getTerminator();
+        for (auto inst = block->getFirstOrdinaryInst(); inst && inst != terminator;
+             inst = inst->getNextInst())
+        {
+            outOrder.add(inst);
+        }
+    }
+
+    // Schedule the instructions of `block`, and return its pressure before and after.
+    //
+    void scheduleBlock(IRBlock* block, Count& outPressureBefore, Count& outPressureAfter)
+    {
+        auto terminator = block->getTerminator();
+
+        List<IRInst*> originalOrder;
+        getBlockOrder(block, originalOrder);
+        HashSet<IRInst*> schedulable;
+        for (auto inst : originalOrder)
+        {
+            if (isSchedulable(inst))
+                schedulable.add(inst);
+        }
+
+        outPressureBefore = computePressure(block, originalOrder);
+        outPressureAfter = outPressureBefore;
+        if (schedulable.getCount() == 0)
+            return;
+
+        // Instructions that can't be moved keep their relative order, and the
+        // ones that can are placed just before the first instruction that needs
+        // them. Those only needed by other blocks are placed before the terminator.
+        //
+        List<IRInst*> newOrder;
+        HashSet<IRInst*> scheduled;
+        for (auto inst : originalOrder)
+        {
+            if (schedulable.contains(inst))
+                continue;
+            scheduleOperands(inst, schedulable, scheduled, newOrder);
+            scheduled.add(inst);
+            newOrder.add(inst);
+        }
+        scheduleOperands(terminator, schedulable, scheduled, newOrder);
+        for (auto inst : originalOrder)
+        {
+            if (!scheduled.contains(inst))
+            {
+                scheduleOperands(inst, schedulable, scheduled, newOrder);
+                scheduled.add(inst);
+                newOrder.add(inst);
+            }
+        }
+        SLANG_ASSERT(newOrder.getCount() == originalOrder.getCount());
+
+        auto newPressure = computePressure(block, newOrder);
+        if (newPressure >= outPressureBefore)
+            return;
+        for (auto inst : newOrder)
+            inst->insertBefore(terminator);
+        outPressureAfter = newPressure;
+    }
+
+    void scheduleFunc(
+        IRGlobalValueWithCode* inFunc,
+        Count& outPressureBefore,
+        Count& outPressureAfter)
+    {
+        func = inFunc;
+        outPressureBefore = 0;
+        outPressureAfter = 0;
+        for (auto block : func->getBlocks())
+        {
+            Count blockPressureBefore = 0;
+            Count blockPressureAfter = 0;
+            scheduleBlock(block, blockPressureBefore, blockPressureAfter);
+            outPressureBefore = Math::Max(outPressureBefore, blockPressureBefore);
+            outPressureAfter = Math::Max(outPressureAfter, blockPressureAfter);
+        }
+    }
+};
+
+Count estimateRegisterPressure(IRGlobalValueWithCode* func)
+{
+    InstSchedulingContext context;
+    context.func = func;
+    Count pressure = 0;
+    for (auto block : func->getBlocks())
+    {
+        List<IRInst*> order;
+        context.getBlockOrder(block, order);
+        pressure = Math::Max(pressure, context.computePressure(block, order));
+    }
+    return pressure;
+}
+
+void scheduleInstsForRegisterPressure(IRModule* module, DiagnosticSink* reportSink)
+{
+    InstSchedulingContext context;
+    for (auto inst : module->getGlobalInsts())
+    {
+        auto func = as<IRFunc>(inst);
+        if (!func || !func->getFirstBlock())
+            continue;
+        Count pressureBefore = 0;
+        Count pressureAfter = 0;
+        context.scheduleFunc(func, pressureBefore, pressureAfter);
+        if (reportSink)
+        {
+            reportSink->diagnose(
+                func,
+                Diagnostics::reportRegisterPressure,
+                func,
+                pressureAfter,
+                pressureBefore);
+        }
+    }
+}
+
+} // namespace Slang
@@ -0,0 +1,28 @@
+// slang-ir-schedule-insts.h
+#pragma once
+
+#include "../core/slang-basic.h"
+
+namespace Slang
+{
+struct IRGlobalValueWithCode;
+struct IRModule;
+class DiagnosticSink;
+
+/// Reorder the instructions within each block of the functions in `module`
+/// to reduce the number of values that are live at the same time.
+///
+/// Instructions without side effects (see `isMovableInst`) are moved to just
+/// before the first instruction in their block that uses them, and the new
+/// order of a block is only kept if it lowers the number of values live at
+/// once in the block.
+///
+/// If `reportSink` is not null, a note is reported for each function with
+/// the largest number of values live at once in it, before and after
+/// scheduling.
+void scheduleInstsForRegisterPressure(IRModule* module, DiagnosticSink* reportSink);
+
+/// Estimate the number of values live at once in `func`, as the largest number of
+/// values live at once in any of its blocks, in the same way scheduling measures it.
+Count estimateRegisterPressure(IRGlobalValueWithCode* func);
+} // namespace Slang
@@ -0,0 +1,287 @@
+// slang-ir-shader-cost.cpp
+#include "slang-ir-shader-cost.h"
+
+#include "../compiler-core/slang-artifact-associated-impl.h"
+#include "slang-compiler.h"
+#include "slang-ir-insts.h"
+#include "slang-ir-layout.h"
+#include "slang-ir-schedule-insts.h"
+#include "slang-ir.h"
+
+namespace Slang
+{
+
+// The cost of an entry point counts each instruction of the functions reachable from it once,
+// so a function called from two places, or an instruction in a loop, is only counted once.
+// Calls to built-in functions are classified by what they do, instead of by their bodies,
+// which are either target intrinsics or target specific code.
+//
+struct ShaderCostContext
+{
+    CompilerOptionSet& optionSet;
+    slang::ShaderCost cost;
+    HashSet<IRGlobalValueWithCode*> visitedFuncs;
+    HashSet<IRInst*> visitedGroupSharedVars;
+    List<IRGlobalValueWithCode*> workList;
+
+    ShaderCostContext(CompilerOptionSet& inOptionSet)
+        : optionSet(inOptionSet)
+    {
+    }
+
+    SlangUInt getSize(IRType* type)
+    {
+        IRSizeAndAlignment sizeAndAlignment;
+        if (SLANG_FAILED(getNaturalSizeAndAlignment(optionSet, type, &sizeAndAlignment)) ||
+            sizeAndAlignment.size == IRSizeAndAlignment::kIndeterminateSize)
+            return 0;
+        return (SlangUInt)sizeAndAlignment.size;
+    }
+
+    static bool isALUOp(IROp op)
+    {
+        switch (op)
+        {
+        case kIROp_Add:
+        case kIROp_Sub:
+        case kIROp_Mul:
+        case kIROp_Div:
+        case kIROp_IRem:
+        case kIROp_FRem:
+        case kIROp_Lsh:
+        case kIROp_Rsh:
+        case kIROp_Eql:
+        case kIROp_Neq:
+        case kIROp_Greater:
+        case kIROp_Less:
+        case kIROp_Geq:
+        case kIROp_Leq:
+        case kIROp_BitAnd:
+        case kIROp_BitXor:
+        case kIROp_BitOr:
+        case kIROp_And:
+        case kIROp_Or:
+        case kIROp_Neg:
+        case kIROp_Not:
+        case kIROp_BitNot:
+        case kIROp_Select:
+        case kIROp_IntCast:
+        case kIROp_FloatCast:
+        case kIROp_CastIntToFloat:
+        case kIROp_CastFloatToInt:
+        case kIROp_SPIRVAsm:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Find the buffer or variable that the memory at `addr` belongs to.
+    //
+    static IRInst* getRootAddr(IRInst* addr)
+    {
+        for (;;)
+        {
+            switch (addr->getOp())
+            {
+            case kIROp_GetElementPtr:
+            case kIROp_FieldAddress:
+            case kIROp_RWStructuredBufferGetElementPtr:
+                addr = addr->getOperand(0);
+                continue;
+            default:
+                return addr;
+            }
+        }
+    }
+
+    void addMemoryAccess(IRInst* addr, IRType* valueType, bool isStore)
+    {
+        auto root = getRootAddr(addr);
+        if (auto globalVar = as<IRGlobalVar>(root))
+        {
+            if (as<IRGroupSharedRate>(globalVar->getRate()) &&
+                visitedGroupSharedVars.add(globalVar))
+                cost.groupSharedBytes += getSize(globalVar->getDataType()->getValueType());
+            return;
+        }
+        if (!as<IRGlobalParam>(root))
+            return;
+        if (isStore)
+        {
+            cost.bufferStoreCount++;
+            cost.bufferStoreBytes += getSize(valueType);
+        }
+        else
+        {
+            cost.bufferLoadCount++;
+            cost.bufferLoadBytes += getSize(valueType);
+        }
+    }
+
+    static UnownedStringSlice getCalleeName(IRInst* callee)
+    {
+        if (auto nameHint = callee->findDecoration<IRNameHintDecoration>())
+            return nameHint->getName();
+        return UnownedStringSlice();
+    }
+
+    void addCall(IRCall* call)
+    {
+        auto callee = as<IRGlobalValueWithCode>(call->getCallee());
+        if (!callee)
+            return;
+        auto name = getCalleeName(callee);
+
+        // Texture operations are methods of the texture types, which are the first argument.
+        if (call->getArgCount() && as<IRTextureTypeBase>(call->getArg(0)->getDataType()))
+        {
+            if (name.indexOf(UnownedStringSlice("Sample")) >= 0 ||
+                name.indexOf(UnownedStringSlice("Gather")) >= 0)
+                cost.textureSampleCount++;
+            else
+                cost.textureAccessCount++;
+            return;
+        }
+        if (name.indexOf(UnownedStringSlice("Barrier")) >= 0)
+        {
+            cost.barrierCount++;
+            return;
+        }
+        if (!callee->getFirstBlock() || callee->findDecoration<IRTargetIntrinsicDecoration>())
+        {
+            cost.aluOpCount++;
+            return;
+        }
+        if (visitedFuncs.add(callee))
+            workList.add(callee);
+    }
+
+    void addInst(IRInst* inst)
+    {
+        auto op = inst->getOp();
+        if (isALUOp(op))
+        {
+            cost.aluOpCount++;
+            return;
+        }
+        switch (op)
+        {
+        case kIROp_Call:
+            addCall(as<IRCall>(inst));
+            break;
+        case kIROp_Load:
+            addMemoryAccess(inst->getOperand(0), inst->getDataType(), false);
+            break;
+        case kIROp_Store:
+            {
+                auto store = as<IRStore>(inst);
+                addMemoryAccess(store->getPtr(), store->getVal()->getDataType(), true);
+                break;
+            }
+        case kIROp_StructuredBufferLoad:
+        case kIROp_StructuredBufferLoadStatus:
+        case kIROp_RWStructuredBufferLoad:
+        case kIROp_RWStructuredBufferLoadStatus:
+        case kIROp_ByteAddressBufferLoad:
+            cost.bufferLoadCount++;
+            cost.bufferLoadBytes += getSize(inst->getDataType());
+            break;
+        case kIROp_RWStructuredBufferStore:
+            cost.bufferStoreCount++;
+            cost.bufferStoreBytes += getSize(inst->getOperand(2)->getDataType());
+            break;
+        case kIROp_ByteAddressBufferStore:
+            cost.bufferStoreCount++;
+            cost.bufferStoreBytes += getSize(inst->getOperand(3)->getDataType());
+            break;
+        case kIROp_ImageLoad:
+        case kIROp_ImageStore:
+            cost.textureAccessCount++;
+            break;
+        case kIROp_GroupMemoryBarrierWithGroupSync:
+        case kIROp_ControlBarrier:
+            cost.barrierCount++;
+            break;
+        case kIROp_Var:
+            {
+                auto valueType = as<IRVar>(inst)->getDataType()->getValueType();
+                if (as<IRArrayTypeBase>(valueType))
+                {
+                    cost.localArrayCount++;
+                    cost.localArrayBytes += getSize(valueType);
+                }
+                break;
+            }
+        default:
+            break;
+        }
+    }
+
+    void collectEntryPointCost(IRFunc* entryPoint)
+    {
+        visitedFuncs.add(entryPoint);
+        workList.add(entryPoint);
+        while (workList.getCount())
+        {
+            auto func = workList.getLast();
+            workList.removeLast();
+            for (auto block : func->getBlocks())
+            {
+                for (auto inst : block->getChildren())
+                    addInst(inst);
+            }
+            cost.estimatedLiveValueCount = Math::Max(
+                cost.estimatedLiveValueCount,
+                (SlangUInt)estimateRegisterPressure(func));
+        }
+    }
+};
+
+static String _formatShaderCost(const slang::ShaderCost& cost)
+{
+    StringBuilder sb;
+    sb << cost.aluOpCount << " ALU ops, " << cost.textureSampleCount << " texture samples, "
+       << cost.textureAccessCount << " other texture accesses, " << cost.bufferLoadCount
+       << " buffer loads (" << cost.bufferLoadBytes << " bytes), " << cost.bufferStoreCount
+       << " buffer stores (" << cost.bufferStoreBytes << " bytes), " << cost.groupSharedBytes
+       << " bytes of groupshared memory, " << cost.barrierCount << " barriers, "
+       << cost.localArrayCount << " local arrays in memory (" << cost.localArrayBytes
+       << " bytes), about " << cost.estimatedLiveValueCount << " live values";
+    return sb.produceString();
+}
+
+void collectShaderCosts(
+    TargetProgram* targetProgram,
+    IRModule* module,
+    List<EntryPointShaderCost>& outCosts,
+    DiagnosticSink* reportSink)
+{
+    for (auto inst : module->getGlobalInsts())
+    {
+        auto func = as<IRFunc>(inst);
+        if (!func || !func->getFirstBlock())
+            continue;
+        auto entryPointDecoration = func->findDecoration<IREntryPointDecoration>();
+        if (!entryPointDecoration)
+            continue;
+
+        ShaderCostContext context(targetProgram->getOptionSet());
+        context.collectEntryPointCost(func);
+
+        EntryPointShaderCost entry;
+        entry.entryPointName = entryPointDecoration->getName()->getStringSlice();
+        entry.cost = context.cost;
+        if (reportSink)
+        {
+            reportSink->diagnose(
+                func,
+                Diagnostics::reportShaderCost,
+                entry.entryPointName,
+                _formatShaderCost(entry.cost));
+        }
+        outCosts.add(entry);
+    }
+}
+
+} // namespace Slang
@@ -0,0 +1,24 @@
+// slang-ir-shader-cost.h
+#pragma once
+
+#include "../core/slang-basic.h"
+
+namespace Slang
+{
+struct IRModule;
+struct EntryPointShaderCost;
+class DiagnosticSink;
+class TargetProgram;
+
+/// Estimate the static cost of each entry point in `module`, from the instructions of the
+/// functions it calls, and add it to `outCosts`.
+///
+/// This is meant to run on the IR as it is about to be emitted, and gives a cost that doesn't
+/// depend on the downstream compiler. If `reportSink` is not null, the cost of each entry
+/// point is also reported as a note.
+void collectShaderCosts(
+    TargetProgram* targetProgram,
+    IRModule* module,
+    List<EntryPointShaderCost>& outCosts,
+    DiagnosticSink* reportSink);
+} // namespace Slang
@@ -0,0 +1,312 @@
+// slang-ir-specialization-cache.cpp
+#include "slang-ir-specialization-cache.h"
+
+#include "slang-ir-insts.h"
+#include "slang-ir-util.h"
+
+namespace Slang
+{
+
+static bool _canShareGlobalWithLinkage(IROp op)
+{
+    switch (op)
+    {
+    case kIROp_Func:
+    case kIROp_Generic:
+    case kIROp_StructType:
+    case kIROp_ClassType:
+    case kIROp_StructKey:
+    case kIROp_WitnessTable:
+    case kIROp_InterfaceType:
+    case kIROp_InterfaceRequirementEntry:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/// Clone the constant `inst` with `builder`, whose type has already been cloned as `type`.
+static IRInst* _cloneConstant(IRBuilder* builder, IRConstant* inst, IRType* type)
+{
+    switch (inst->getOp())
+    {
+    case kIROp_BoolLit:
+        return builder->getBoolValue(inst->value.intVal != 0);
+    case kIROp_IntLit:
+        return builder->getIntValue(type, inst->value.intVal);
+    case kIROp_FloatLit:
+        return builder->getFloatValue(type, inst->value.floatVal);
+    case kIROp_StringLit:
+        return builder->getStringValue(inst->getStringSlice());
+    case kIROp_PtrLit:
+        if (inst->value.ptrVal != nullptr)
+            return nullptr;
+        return builder->getNullPtrValue(type);
+    case kIROp_VoidLit:
+        return builder->getVoidValue();
+    default:
+        return nullptr;
+    }
+}
+
+IRModule* IRSpecializationCache::_getModule()
+{
+    if (!m_module)
+        m_module = IRModule::create(m_session);
+    return m_module;
+}
+
+IRInst* IRSpecializationCache::_importGlobal(IRCloneEnv* env, IRInst* inst)
+{
+    if (auto found = env->mapOldValToNew.tryGetValue(inst))
+        return *found;
+
+    IRBuilder builder(_getModule());
+    builder.setInsertInto(_getModule()->getModuleInst());
+
+    IRInst* result = nullptr;
+    if (auto constant = as<IRConstant>(inst))
+    {
+        IRType* type = nullptr;
+        if (auto originalType = constant->getFullType())
+        {
+            type = (IRType*)_importGlobal(env, originalType);
+            if (!type)
+                return nullptr;
+        }
+        result = _cloneConstant(&builder, constant, type);
+    }
+    else if (auto linkage = inst->findDecoration<IRLinkageDecoration>())
+    {
+        if (!_canShareGlobalWithLinkage(inst->getOp()))
+            return nullptr;
+
+        // Global values with linkage are represented by a placeholder with
+        // the same opcode and mangled name.
+        //
+        auto mangledName = String(linkage->getMangledName());
+        auto& placeholder = m_placeholders.getOrAddValue(mangledName, nullptr);
+        if (!placeholder)
+        {
+            placeholder = builder.emitIntrinsicInst(nullptr, inst->getOp(), 0, nullptr);
+            builder.addImportDecoration(placeholder, mangledName.getUnownedSlice());
+        }
+        if (placeholder->getOp() != inst->getOp())
+            return nullptr;
+        result = placeholder;
+    }
+    else if (getIROpInfo(inst->getOp()).isHoistable() && !inst->getFirstDecorationOrChild())
+    {
+        IRType* type = nullptr;
+        if (auto originalType = inst->getFullType())
+        {
+            type = (IRType*)_importGlobal(env, originalType);
+            if (!type)
+                return nullptr;
+        }
+        ShortList<IRInst*> operands;
+        for (UInt i = 0; i < inst->getOperandCount(); i++)
+        {
+            auto operand = _importGlobal(env, inst->getOperand(i));
+            if (!operand)
+                return nullptr;
+            operands.add(operand);
+        }
+        result = builder.emitIntrinsicInst(
+            type,
+            inst->getOp(),
+            operands.getCount(),
+            operands.getArrayView().getBuffer());
+    }
+
+    if (result)
+        env->mapOldValToNew[inst] = result;
+    return result;
+}
+
+bool IRSpecializationCache::_importUsedGlobals(
+    IRCloneEnv* env,
+    IRInst* root,
+    IRInst* inst,
+    HashSet<IRInst*>& ioUsedGlobals)
+{
+    auto moduleInst = root->getParent();
+    auto importUsedValue = [&](IRInst* value)
+    {
+        if (!value)
+            return true;
+        if (value->getParent() == moduleInst)
+        {
+            auto imported = _importGlobal(env, value);
+            if (!imported)
+                return false;
+            ioUsedGlobals.add(imported);
+            return true;
+        }
+        return isChildInstOf(value, root);
+    };
+
+    if (!importUsedValue(inst->getFullType()))
+        return false;
+    for (UInt i = 0; i < inst->getOperandCount(); i++)
+    {
+        if (!importUsedValue(inst->getOperand(i)))
+            return false;
+    }
+    for (auto child : inst->getDecorationsAndChildren())
+    {
+        if (!_importUsedGlobals(env, root, child, ioUsedGlobals))
+            return false;
+    }
+    return true;
+}
+
+IRInst* IRSpecializationCache::_exportGlobal(
+    IRCloneEnv* env,
+    IRBuilder* builder,
+    IRInst* inst,
+    GlobalsByName const& globalsByName,
+    List<IRInst*>& ioNewInsts)
+{
+    if (auto found = env->mapOldValToNew.tryGetValue(inst))
+        return *found;
+
+    IRInst* result = nullptr;
+    if (auto constant = as<IRConstant>(inst))
+    {
+        IRType* type = nullptr;
+        if (auto cachedType = constant->getFullType())
+        {
+            type = (IRType*)_exportGlobal(env, builder, cachedType, globalsByName, ioNewInsts);
+            if (!type)
+                return nullptr;
+        }
+        result = _cloneConstant(builder, constant, type);
+    }
+    else if (auto linkage = inst->findDecoration<IRImportDecoration>())
+    {
+        auto found = globalsByName.tryGetValue(String(linkage->getMangledName()));
+        if (!found || !*found || (*found)->getOp() != inst->getOp())
+            return nullptr;
+        result = *found;
+    }
+    else
+    {
+        IRType* type = nullptr;
+        if (auto cachedType = inst->getFullType())
+        {
+            type = (IRType*)_exportGlobal(env, builder, cachedType, globalsByName, ioNewInsts);
+            if (!type)
+                return nullptr;
+        }
+        ShortList<IRInst*> operands;
+        for (UInt i = 0; i < inst->getOperandCount(); i++)
+        {
+            auto operand =
+                _exportGlobal(env, builder, inst->getOperand(i), globalsByName, ioNewInsts);
+            if (!operand)
+                return nullptr;
+            operands.add(operand);
+        }
+        result = builder->emitIntrinsicInst(
+            type,
+            inst->getOp(),
+            operands.getCount(),
+            operands.getArrayView().getBuffer());
+        ioNewInsts.add(result);
+    }
+
+    if (result)
+        env->mapOldValToNew[inst] = result;
+    return result;
+}
+
+void IRSpecializationCache::collectGlobalsByName(IRModule* module, GlobalsByName& outGlobals)
+{
+    outGlobals.clear();
+    for (auto inst : module->getGlobalInsts())
+    {
+        auto linkage = inst->findDecoration<IRLinkageDecoration>();
+        if (!linkage)
+            continue;
+        auto& value = outGlobals.getOrAddValue(String(linkage->getMangledName()), inst);
+        if (value != inst)
+            value = nullptr;
+    }
+}
+
+String IRSpecializationCache::getOptionsKey(CompilerOptionSet& optionSet)
+{
+    DigestBuilder<SHA1> builder;
+    optionSet.buildHash(builder);
+    return builder.finalize().toString();
+}
+
+IRInst* IRSpecializationCache::_find(
+    String const& optionsKey,
+    IROp op,
+    IRInst* source,
+    GlobalsByName const& globalsByName,
+    IRBuilder* builder,
+    List<IRInst*>& outNewInsts)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Identical `specialize` instructions are the same instruction in the
+    // cache module, since they are hoistable.
+    //
+    IRCloneEnv importEnv;
+    Key key;
+    key.optionsKey = optionsKey;
+    key.op = op;
+    key.source = _importGlobal(&importEnv, source);
+    if (!key.source)
+        return nullptr;
+    auto entry = m_entries.tryGetValue(key);
+    if (!entry)
+        return nullptr;
+
+    // All the global values the function uses need to be available
+    // in the module before it can be cloned into it.
+    //
+    IRCloneEnv exportEnv;
+    List<IRInst*> newInsts;
+    for (auto usedGlobal : entry->usedGlobals)
+    {
+        if (!_exportGlobal(&exportEnv, builder, usedGlobal, globalsByName, newInsts))
+            return nullptr;
+    }
+
+    auto func = cloneInst(&exportEnv, builder, entry->func);
+    outNewInsts.addRange(newInsts);
+    outNewInsts.add(func);
+    return func;
+}
+
+void IRSpecializationCache::_add(String const& optionsKey, IROp op, IRInst* source, IRFunc* func)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    IRCloneEnv env;
+    Key key;
+    key.optionsKey = optionsKey;
+    key.op = op;
+    key.source = _importGlobal(&env, source);
+    if (!key.source || m_entries.containsKey(key))
+        return;
+
+    HashSet<IRInst*> usedGlobals;
+    if (!_importUsedGlobals(&env, func, func, usedGlobals))
+        return;
+
+    IRBuilder builder(_getModule());
+    builder.setInsertInto(_getModule()->getModuleInst());
+
+    Entry entry;
+    entry.func = as<IRFunc>(cloneInst(&env, &builder, func));
+    for (auto usedGlobal : usedGlobals)
+        entry.usedGlobals.add(usedGlobal);
+    m_entries.add(key, entry);
+}
+
+} // namespace Slang
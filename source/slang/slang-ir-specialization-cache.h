@@ -0,0 +1,180 @@
+// slang-ir-specialization-cache.h
+#pragma once
+
+#include "slang-compiler-options.h"
+#include "slang-ir-clone.h"
+#include "slang-ir-insts.h"
+#include "slang-ir.h"
+
+#include <mutex>
+
+namespace Slang
+{
+class Session;
+
+/// Specializations of generic functions, and forward derivatives of functions, shared by the
+/// modules compiled for a target.
+///
+/// Each program linked for a target gets a new IR module, so the generic functions it uses
+/// are specialized again, and the functions it differentiates are differentiated again, even
+/// when another program for the same target has already done so. The cache keeps a copy of
+/// such functions in a module of its own, in which the global values they refer to are
+/// represented by placeholders with the same mangled name, so that they can be cloned into the
+/// next module that needs them.
+///
+/// Only functions made from a generic or function with linkage, that refer to nothing but
+/// hoistable values and to functions, types, keys and witness tables with linkage, are cached.
+/// Those have the same meaning in every module linked for the target, unlike global parameters
+/// and variables whose types may be specialized differently for each program.
+///
+class IRSpecializationCache : public RefObject
+{
+public:
+    IRSpecializationCache(Session* session)
+        : m_session(session)
+    {
+    }
+
+    /// The global values of a module being specialized, by mangled name. Names shared by more
+    /// than one value map to nullptr.
+    typedef Dictionary<String, IRInst*> GlobalsByName;
+
+    /// Collect the global values of `module` that have linkage into `outGlobals`.
+    static void collectGlobalsByName(IRModule* module, GlobalsByName& outGlobals);
+
+    /// Get the key that identifies the options a module is compiled with, which cached
+    /// functions are only shared between.
+    static String getOptionsKey(CompilerOptionSet& optionSet);
+
+    /// Find a specialization of `specializeInst` made for another module, and clone it into
+    /// the module of `builder`, at its insertion point.
+    ///
+    /// `optionsKey` identifies the options the specialization was made with. On success, the
+    /// instructions created at global scope, including the specialization, are added to
+    /// `outNewInsts`. Returns nullptr if no specialization can be reused.
+    ///
+    IRInst* findSpecialization(
+        String const& optionsKey,
+        IRSpecialize* specializeInst,
+        GlobalsByName const& globalsByName,
+        IRBuilder* builder,
+        List<IRInst*>& outNewInsts)
+    {
+        return _find(
+            optionsKey,
+            kIROp_Specialize,
+            specializeInst,
+            globalsByName,
+            builder,
+            outNewInsts);
+    }
+
+    /// Add `specializedFunc`, the result of specializing `specializeInst`, to the cache, if it
+    /// can be shared.
+    void addSpecialization(
+        String const& optionsKey,
+        IRSpecialize* specializeInst,
+        IRFunc* specializedFunc)
+    {
+        _add(optionsKey, kIROp_Specialize, specializeInst, specializedFunc);
+    }
+
+    /// Find the forward derivative of `primalFunc` made for another module, and clone it into
+    /// the module of `builder`, like `findSpecialization`.
+    IRInst* findForwardDerivative(
+        String const& optionsKey,
+        IRFunc* primalFunc,
+        GlobalsByName const& globalsByName,
+        IRBuilder* builder,
+        List<IRInst*>& outNewInsts)
+    {
+        return _find(
+            optionsKey,
+            kIROp_ForwardDifferentiate,
+            primalFunc,
+            globalsByName,
+            builder,
+            outNewInsts);
+    }
+
+    /// Add `derivativeFunc`, the forward derivative of `primalFunc`, to the cache, if it can be
+    /// shared.
+    void addForwardDerivative(String const& optionsKey, IRFunc* primalFunc, IRFunc* derivativeFunc)
+    {
+        _add(optionsKey, kIROp_ForwardDifferentiate, primalFunc, derivativeFunc);
+    }
+
+private:
+    /// A function is identified by the options it was made with, the operation that made it,
+    /// and the clone in the cache module of the value it was made from.
+    struct Key
+    {
+        String optionsKey;
+        IROp op = kIROp_Nop;
+        IRInst* source = nullptr;
+
+        bool operator==(Key const& other) const
+        {
+            return optionsKey == other.optionsKey && op == other.op && source == other.source;
+        }
+        HashCode getHashCode() const
+        {
+            return combineHash(
+                optionsKey.getHashCode(),
+                combineHash(Slang::getHashCode(op), Slang::getHashCode(source)));
+        }
+    };
+
+    struct Entry
+    {
+        IRFunc* func = nullptr;
+
+        // The global values of the cache module that `func` refers to.
+        List<IRInst*> usedGlobals;
+    };
+
+    IRInst* _find(
+        String const& optionsKey,
+        IROp op,
+        IRInst* source,
+        GlobalsByName const& globalsByName,
+        IRBuilder* builder,
+        List<IRInst*>& outNewInsts);
+
+    void _add(String const& optionsKey, IROp op, IRInst* source, IRFunc* func);
+
+    IRModule* _getModule();
+
+    /// Get the clone of `inst`, a global value of another module, in the cache module, or
+    /// nullptr if it can't be shared.
+    IRInst* _importGlobal(IRCloneEnv* env, IRInst* inst);
+
+    /// Import the global values used by `inst` and its descendents, which must otherwise only
+    /// use values within `root`. Returns false if they can't be shared.
+    bool _importUsedGlobals(
+        IRCloneEnv* env,
+        IRInst* root,
+        IRInst* inst,
+        HashSet<IRInst*>& ioUsedGlobals);
+
+    /// Get the clone of `inst`, a global value of the cache module, in the module of `builder`.
+    IRInst* _exportGlobal(
+        IRCloneEnv* env,
+        IRBuilder* builder,
+        IRInst* inst,
+        GlobalsByName const& globalsByName,
+        List<IRInst*>& ioNewInsts);
+
+    Session* m_session;
+    RefPtr<IRModule> m_module;
+
+    // The placeholders for global values with linkage, by mangled name.
+    Dictionary<String, IRInst*> m_placeholders;
+
+    Dictionary<Key, Entry> m_entries;
+
+    // Entry points of a target program may be specialized on several threads.
+    std::mutex m_mutex;
+};
+
+} // namespace Slang
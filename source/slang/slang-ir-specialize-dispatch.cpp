@@ -7,6 +7,57 @@
 
 namespace Slang
 {
+/// Get the specialization constant that selects the implementation of `interfaceType` in its
+/// dispatch functions, or nullptr if they should switch on the type ID of the dispatched value.
+static IRInst* getDispatchSelector(
+    SharedGenericsLoweringContext* sharedContext,
+    IRInst* interfaceType)
+{
+    auto decoration = interfaceType->findDecoration<IRSpecializationConstantDispatchDecoration>();
+    if (!decoration || !isKhronosTarget(sharedContext->targetProgram->getTargetReq()))
+        return nullptr;
+
+    // All the dispatch functions of an interface switch on the same constant.
+    auto originalInterfaceType = as<IRInterfaceType>(interfaceType);
+    sharedContext->mapLoweredInterfaceToOriginal.tryGetValue(
+        originalInterfaceType,
+        originalInterfaceType);
+    IRInst* key = originalInterfaceType ? originalInterfaceType : interfaceType;
+    if (auto found = sharedContext->mapInterfaceToDispatchSelector.tryGetValue(key))
+        return *found;
+
+    IRBuilder builder(sharedContext->module);
+    builder.setInsertBefore(interfaceType);
+
+    IRTypeLayout::Builder typeLayoutBuilder(&builder);
+    typeLayoutBuilder.addResourceUsage(LayoutResourceKind::SpecializationConstant, 1);
+    auto typeLayout = typeLayoutBuilder.build();
+
+    IRVarLayout::Builder varLayoutBuilder(&builder, typeLayout);
+    varLayoutBuilder.findOrAddResourceInfo(LayoutResourceKind::SpecializationConstant)->offset =
+        (UInt)decoration->getConstantId();
+    auto varLayout = varLayoutBuilder.build();
+
+    // Without a specialized value, the constant selects the conformance with sequential ID 0.
+    //
+    auto selector = builder.createGlobalParam(builder.getUIntType());
+    builder.addLayoutDecoration(selector, varLayout);
+    builder.addDefaultValueDecoration(selector, builder.getIntValue(builder.getUIntType(), 0));
+    if (auto nameHint = key->findDecoration<IRNameHintDecoration>())
+    {
+        builder.addNameHintDecoration(
+            selector,
+            (String(nameHint->getName()) + "_dispatchSelector").getUnownedSlice());
+    }
+
+    sharedContext->mapInterfaceToDispatchSelector[key] = selector;
+    return selector;
+}
+
+/// The largest number of conformances of an interface for which its dispatch functions are
+/// inlined into their call sites.
+static const Index kMaxInlinedDispatchCaseCount = 4;
+
 IRFunc* specializeDispatchFunction(
     SharedGenericsLoweringContext* sharedContext,
     IRFunc* dispatchFunc)
@@ -87,9 +138,19 @@ IRFunc* specializeDispatchFunction(
     // to store the sequential ID and reserve the second 32-bit value for future
     // pointer-compatibility. We insert a member extract inst right now
     // to obtain the first element and use it in our switch statement.
-    UInt elemIdx = 0;
-    auto witnessTableSequentialID =
-        builder->emitSwizzle(builder->getUIntType(), witnessTableParam, 1, &elemIdx);
+    //
+    // If the interface selects its implementation with a specialization constant,
+    // we switch on the constant instead, and the sequential ID is left unused.
+    // Drivers fold a switch on a specialization constant when the pipeline is created,
+    // so that only the selected implementation is left in the shader.
+    //
+    IRInst* witnessTableSequentialID = getDispatchSelector(sharedContext, conformanceType);
+    if (!witnessTableSequentialID)
+    {
+        UInt elemIdx = 0;
+        witnessTableSequentialID =
+            builder->emitSwizzle(builder->getUIntType(), witnessTableParam, 1, &elemIdx);
+    }
 
     // Generate case blocks for each possible witness table.
     List<IRInst*> caseBlocks;
@@ -170,6 +231,18 @@ IRFunc* specializeDispatchFunction(
             builder->emitReturn(defaultValue);
         }
     }
+    // When only a few types conform to the interface, the dispatch is inlined into each of its
+    // call sites. A call site that already knows the sequential ID, such as one passing the
+    // witness table of a concrete type, then has the switch folded down to a direct call by the
+    // simplification passes that follow, and the others are left with a small guarded switch
+    // instead of a call to the dispatch function.
+    //
+    if (witnessTables.getCount() <= kMaxInlinedDispatchCaseCount &&
+        !newDispatchFunc->findDecoration<IRNoInlineDecoration>())
+    {
+        builder->addForceInlineDecoration(newDispatchFunc);
+    }
+
     // Remove old implementation.
     dispatchFunc->replaceUsesWith(newDispatchFunc);
     dispatchFunc->removeAndDeallocate();
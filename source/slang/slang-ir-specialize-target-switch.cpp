@@ -8,6 +8,50 @@
 
 namespace Slang
 {
+IRBlock* findTargetSwitchCase(
+    TargetRequest* target,
+    IRTargetSwitch* targetSwitch,
+    bool& outFailedImplies)
+{
+    outFailedImplies = false;
+
+    bool isEqual;
+    CapabilitySet bestCapSet = CapabilitySet::makeInvalid();
+    IRBlock* targetBlock = nullptr;
+    CapabilitySet::ImpliesReturnFlags impliesReturnType =
+        CapabilitySet::ImpliesReturnFlags::NotImplied;
+    for (UInt i = 0; i < targetSwitch->getCaseCount(); i++)
+    {
+        auto cap = (CapabilityName)getIntVal(targetSwitch->getCaseValue(i));
+        if (target->getTargetCaps().isIncompatibleWith(cap))
+            continue;
+        CapabilitySet capSet;
+        if (cap == CapabilityName::Invalid) // `default` case
+            capSet = CapabilitySet::makeEmpty();
+        else
+            capSet = CapabilitySet(cap);
+        bool isBetterForTarget =
+            capSet.isBetterForTarget(bestCapSet, target->getTargetCaps(), isEqual);
+        if (isBetterForTarget)
+        {
+            impliesReturnType = target->getTargetCaps().atLeastOneSetImpliedInOther(capSet);
+            bool targetImpliesCapSet =
+                ((int)impliesReturnType & (int)CapabilitySet::ImpliesReturnFlags::Implied ||
+                 capSet.isEmpty());
+            if (targetImpliesCapSet)
+            {
+                // Now check if bestCapSet contains targetCaps. If it does not then this is
+                // an invalid target
+                targetBlock = targetSwitch->getCaseBlock(i);
+                bestCapSet = capSet;
+            }
+            else
+                outFailedImplies = true;
+        }
+    }
+    return targetBlock;
+}
+
 void specializeTargetSwitch(
     TargetRequest* target,
     IRGlobalValueWithCode* code,
@@ -26,43 +70,10 @@ void specializeTargetSwitch(
     bool changed = false;
     for (auto block : code->getBlocks())
     {
-        bool failedImplies = false;
         if (auto targetSwitch = as<IRTargetSwitch>(block->getTerminator()))
         {
-            bool isEqual;
-            CapabilitySet bestCapSet = CapabilitySet::makeInvalid();
-            IRBlock* targetBlock = nullptr;
-            CapabilitySet::ImpliesReturnFlags impliesReturnType =
-                CapabilitySet::ImpliesReturnFlags::NotImplied;
-            for (UInt i = 0; i < targetSwitch->getCaseCount(); i++)
-            {
-                auto cap = (CapabilityName)getIntVal(targetSwitch->getCaseValue(i));
-                if (target->getTargetCaps().isIncompatibleWith(cap))
-                    continue;
-                CapabilitySet capSet;
-                if (cap == CapabilityName::Invalid) // `default` case
-                    capSet = CapabilitySet::makeEmpty();
-                else
-                    capSet = CapabilitySet(cap);
-                bool isBetterForTarget =
-                    capSet.isBetterForTarget(bestCapSet, target->getTargetCaps(), isEqual);
-                if (isBetterForTarget)
-                {
-                    impliesReturnType = target->getTargetCaps().atLeastOneSetImpliedInOther(capSet);
-                    bool targetImpliesCapSet =
-                        ((int)impliesReturnType & (int)CapabilitySet::ImpliesReturnFlags::Implied ||
-                         capSet.isEmpty());
-                    if (targetImpliesCapSet)
-                    {
-                        // Now check if bestCapSet contains targetCaps. If it does not then this is
-                        // an invalid target
-                        targetBlock = targetSwitch->getCaseBlock(i);
-                        bestCapSet = capSet;
-                    }
-                    else
-                        failedImplies = true;
-                }
-            }
+            bool failedImplies = false;
+            IRBlock* targetBlock = findTargetSwitchCase(target, targetSwitch, failedImplies);
             IRBuilder builder(targetSwitch);
             builder.setInsertBefore(targetSwitch);
             if (targetBlock)
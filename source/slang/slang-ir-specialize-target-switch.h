@@ -3,7 +3,9 @@
 
 namespace Slang
 {
+struct IRBlock;
 struct IRModule;
+struct IRTargetSwitch;
 class TargetRequest;
 class DiagnosticSink;
 
@@ -11,6 +13,15 @@ class DiagnosticSink;
 //
 void specializeTargetSwitch(TargetRequest* target, IRModule* module, DiagnosticSink* sink);
 
+// Find the case of `targetSwitch` that matches the target best, or null if no case matches.
+// `outFailedImplies` is set if a case of the right target was rejected because the profile
+// doesn't support it.
+//
+IRBlock* findTargetSwitchCase(
+    TargetRequest* target,
+    IRTargetSwitch* targetSwitch,
+    bool& outFailedImplies);
+
 } // namespace Slang
 
 #endif
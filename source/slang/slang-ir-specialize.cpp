@@ -2,12 +2,15 @@
 #include "slang-ir-specialize.h"
 
 #include "../core/slang-performance-profiler.h"
+#include "slang-compiler.h"
 #include "slang-ir-clone.h"
 #include "slang-ir-dce.h"
 #include "slang-ir-insts.h"
 #include "slang-ir-lower-witness-lookup.h"
+#include "slang-ir-pass-profile.h"
 #include "slang-ir-peephole.h"
 #include "slang-ir-sccp.h"
+#include "slang-ir-specialization-cache.h"
 #include "slang-ir-ssa-simplification.h"
 #include "slang-ir-util.h"
 #include "slang-ir.h"
@@ -213,6 +216,74 @@ struct SpecializationContext
     typedef IRSimpleSpecializationKey Key;
     Dictionary<Key, IRInst*> genericSpecializations;
 
+    // When `ShareGenericSpecializations` is set, specializations of generic
+    // functions are also looked up in, and added to, a cache kept by the
+    // target, so that the other programs linked for the same target don't
+    // need to make them again.
+    //
+    IRSpecializationCache* getSpecializationCache()
+    {
+        if (!targetProgram ||
+            !targetProgram->getOptionSet().getBoolOption(
+                CompilerOptionName::ShareGenericSpecializations))
+            return nullptr;
+        return targetProgram->getTargetReq()->getIRSpecializationCache();
+    }
+
+    // Specializations are only shared between programs compiled with the
+    // same options.
+    //
+    String specializationCacheOptionsKey;
+
+    String const& getSpecializationCacheOptionsKey()
+    {
+        if (!specializationCacheOptionsKey.getLength())
+        {
+            specializationCacheOptionsKey =
+                IRSpecializationCache::getOptionsKey(targetProgram->getOptionSet());
+        }
+        return specializationCacheOptionsKey;
+    }
+
+    // The global values of the module with linkage, by mangled name, which
+    // cached specializations are connected to. It is built when first needed,
+    // and reset whenever global values are removed.
+    //
+    IRSpecializationCache::GlobalsByName globalsByName;
+    bool isGlobalsByNameValid = false;
+
+    IRSpecializationCache::GlobalsByName const& getGlobalsByName()
+    {
+        if (!isGlobalsByNameValid)
+        {
+            IRSpecializationCache::collectGlobalsByName(module, globalsByName);
+            isGlobalsByNameValid = true;
+        }
+        return globalsByName;
+    }
+
+    IRInst* findCachedSpecialization(
+        IRSpecializationCache* cache,
+        IRGeneric* genericVal,
+        IRSpecialize* specializeInst)
+    {
+        IRBuilder builder(module);
+        builder.setInsertBefore(genericVal);
+        List<IRInst*> newInsts;
+        auto specializedVal = cache->findSpecialization(
+            getSpecializationCacheOptionsKey(),
+            specializeInst,
+            getGlobalsByName(),
+            &builder,
+            newInsts);
+        if (!specializedVal)
+            return nullptr;
+
+        for (Index ii = newInsts.getCount() - 1; ii >= 0; ii--)
+            addToWorkList(newInsts[ii]);
+        return specializedVal;
+    }
+
 
     // Now let's look at the task of finding or generation a
     // specialization of some generic `g`, given a specialization
@@ -283,7 +354,17 @@ struct SpecializationContext
         // can be re-used in other cases that need to
         // do one-off specialization.
         //
-        IRInst* specializedVal = specializeGenericImpl(genericVal, specializeInst, module, this);
+        auto cache = getSpecializationCache();
+        IRInst* specializedVal = nullptr;
+        if (cache)
+            specializedVal = findCachedSpecialization(cache, genericVal, specializeInst);
+        if (!specializedVal)
+        {
+            specializedVal = specializeGenericImpl(genericVal, specializeInst, module, this);
+            auto func = as<IRFunc>(specializedVal);
+            if (func && cache)
+                cache->addSpecialization(getSpecializationCacheOptionsKey(), specializeInst, func);
+        }
 
         // The body of the specialized generic may expose more specialization opportunities, so
         // we add the children to workList.
@@ -1020,18 +1101,38 @@ struct SpecializationContext
         // We start out simple by putting the root instruction for the
         // module onto our work list.
         //
+        // Specializing an instruction can expose opportunities in code that
+        // the work list doesn't reach through use-def edges, so we sweep the
+        // module again after every sweep that made a change. Only the global
+        // values that changed, and the global values using them, are swept
+        // again though, until such a sweep makes no change. A final sweep of
+        // the whole module then checks that nothing was missed.
+        //
         for (;;)
         {
             bool iterChanged = false;
+            bool isFullSweep = true;
             for (;;)
             {
                 bool hasSpecialization = false;
-                addToWorkList(module->getModuleInst());
+                sweepCount++;
+                if (isFullSweep)
+                {
+                    fullSweepCount++;
+                    changedRoots.clear();
+                    addToWorkList(module->getModuleInst());
+                }
+                else
+                {
+                    addChangedRootsToWorkList();
+                }
 
                 // We will then iterate until our work list goes dry.
                 //
                 while (workList.getCount() != 0)
                 {
+                    targetProgram->getProgram()->getLinkage()->checkForCancellation(sink);
+
                     IRInst* inst = workList.getLast();
 
                     workList.removeLast();
@@ -1039,6 +1140,7 @@ struct SpecializationContext
 
                     if (!inst->getParent() && inst->getOp() != kIROp_Module)
                         continue;
+                    workListItemCount++;
 
                     // For each instruction we process, we want to perform
                     // a few steps.
@@ -1049,7 +1151,13 @@ struct SpecializationContext
                     //
                     if (inst->hasUses() || inst->mightHaveSideEffects() || isWitnessTableType(inst))
                     {
-                        hasSpecialization |= maybeSpecializeInst(inst);
+                        auto root = getGlobalScopeRoot(inst);
+                        if (maybeSpecializeInst(inst))
+                        {
+                            hasSpecialization = true;
+                            if (root)
+                                changedRoots.add(root);
+                        }
                     }
 
                     // Finally, we need to make our logic recurse through
@@ -1075,15 +1183,21 @@ struct SpecializationContext
                     }
                 }
                 if (hasSpecialization)
+                {
                     iterChanged = true;
-                else
+                    isFullSweep = false;
+                }
+                else if (isFullSweep)
                     break;
+                else
+                    isFullSweep = true;
             }
 
             if (iterChanged)
             {
                 this->changed = true;
                 eliminateDeadCode(module->getModuleInst());
+                isGlobalsByNameValid = false;
             }
 
             // Once the work list has gone dry, we should have the invariant
@@ -1108,6 +1222,61 @@ struct SpecializationContext
         writeSpecializationDictionaries();
     }
 
+    // The number of sweeps, of sweeps over the whole module, and of
+    // instructions taken from the work list, over all the sweeps.
+    //
+    Count sweepCount = 0;
+    Count fullSweepCount = 0;
+    Count workListItemCount = 0;
+
+    // The global values that contain an instruction that was specialized
+    // during the current sweep.
+    //
+    HashSet<IRInst*> changedRoots;
+
+    // Get the global value that `inst` is, or is nested in, or nullptr if
+    // it isn't in the module.
+    //
+    IRInst* getGlobalScopeRoot(IRInst* inst)
+    {
+        auto moduleInst = module->getModuleInst();
+        for (; inst; inst = inst->getParent())
+        {
+            if (inst->getParent() == moduleInst)
+                return inst;
+        }
+        return nullptr;
+    }
+
+    // Add the global values in `changedRoots` that are still in the module,
+    // and the global values that use them, directly or not, to the work list.
+    //
+    void addChangedRootsToWorkList()
+    {
+        auto moduleInst = module->getModuleInst();
+        List<IRInst*> roots;
+        HashSet<IRInst*> rootSet;
+        for (auto root : changedRoots)
+        {
+            if (root->getParent() == moduleInst && rootSet.add(root))
+                roots.add(root);
+        }
+        changedRoots.clear();
+
+        for (Index ii = 0; ii < roots.getCount(); ii++)
+        {
+            for (auto use = roots[ii]->firstUse; use; use = use->nextUse)
+            {
+                auto userRoot = getGlobalScopeRoot(use->getUser());
+                if (userRoot && rootSet.add(userRoot))
+                    roots.add(userRoot);
+            }
+        }
+
+        for (Index ii = roots.getCount() - 1; ii >= 0; ii--)
+            addToWorkList(roots[ii]);
+    }
+
     void addInstsToWorkListRec(IRInst* inst)
     {
         addToWorkList(inst);
@@ -2882,6 +3051,14 @@ bool specializeModule(TargetProgram* target, IRModule* module, DiagnosticSink* s
     SpecializationContext context(module, target);
     context.sink = sink;
     context.processModule();
+
+    auto passProfiler = IRPassProfiler::getProfiler();
+    if (passProfiler->isEnabled())
+    {
+        passProfiler->addCounter("specializeModule", "sweeps", context.sweepCount);
+        passProfiler->addCounter("specializeModule", "fullSweeps", context.fullSweepCount);
+        passProfiler->addCounter("specializeModule", "workListItems", context.workListItemCount);
+    }
     return context.changed;
 }
 
@@ -158,7 +158,10 @@ struct RegisterAllocateContext
         IRGlobalValueWithCode* func,
         RefPtr<IRDominatorTree>& inOutDom)
     {
+        // Instructions are assigned to registers without modifying the function, so
+        // the order of the instructions in each block stays valid.
         ReachabilityContext reachabilityContext(func);
+        reachabilityContext.numberInsts();
         mapTypeToRegisterList.clear();
 
         auto dom = computeDominatorTree(func);
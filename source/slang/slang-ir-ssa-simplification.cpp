@@ -30,6 +30,9 @@ IRSimplificationOptions IRSimplificationOptions::getDefault(TargetProgram* targe
         result.deadCodeElimOptions.keepGlobalParamsAlive =
             targetProgram->getOptionSet().getBoolOption(CompilerOptionName::PreserveParameters);
     result.deadCodeElimOptions.useFastAnalysis = result.minimalOptimization;
+    if (targetProgram)
+        result.threadCount =
+            targetProgram->getOptionSet().getIntOption(CompilerOptionName::OptimizationThreadCount);
     return result;
 }
 
@@ -44,9 +47,73 @@ IRSimplificationOptions IRSimplificationOptions::getFast(TargetProgram* targetPr
         result.deadCodeElimOptions.keepGlobalParamsAlive =
             targetProgram->getOptionSet().getBoolOption(CompilerOptionName::PreserveParameters);
     result.deadCodeElimOptions.useFastAnalysis = result.minimalOptimization;
+    if (targetProgram)
+        result.threadCount =
+            targetProgram->getOptionSet().getIntOption(CompilerOptionName::OptimizationThreadCount);
     return result;
 }
 
+// Add the code-bearing global values that reference `inst`, directly or through
+// global instructions such as specializations, to `ioFuncs`.
+static void addReferencingFuncs(
+    IRInst* inst,
+    HashSet<IRInst*>& ioVisited,
+    HashSet<IRInst*>& ioFuncs)
+{
+    if (!ioVisited.add(inst))
+        return;
+    for (auto use = inst->firstUse; use; use = use->nextUse)
+    {
+        auto user = use->getUser();
+        auto globalUser = user;
+        while (globalUser->getParent() && globalUser->getParent()->getOp() != kIROp_Module)
+            globalUser = globalUser->getParent();
+        if (!globalUser->getParent())
+            continue;
+
+        if (as<IRGlobalValueWithCode>(globalUser))
+            ioFuncs.add(globalUser);
+        else if (globalUser == user)
+            addReferencingFuncs(globalUser, ioVisited, ioFuncs);
+    }
+}
+
+// Returns true if the peephole pass may need the dominator tree of `func`, which is
+// when one of its blocks, other than the first, has parameters.
+static bool mayNeedDominatorTree(IRGlobalValueWithCode* func)
+{
+    auto firstBlock = func->getFirstBlock();
+    if (!firstBlock)
+        return false;
+    for (auto block = firstBlock->getNextBlock(); block; block = block->getNextBlock())
+    {
+        if (block->getFirstParam())
+            return true;
+    }
+    return false;
+}
+
+// Compute the dominator trees the function level passes are likely to need for
+// `funcs` in parallel, rather than one at a time as each is needed.
+static void createDominatorTreesAhead(
+    IRModule* module,
+    const List<IRGlobalValueWithCode*>& funcs,
+    Count threadCount)
+{
+    List<IRGlobalValueWithCode*> funcsToAnalyze;
+    for (auto func : funcs)
+    {
+        // A generic is simplified along with the function it returns.
+        IRGlobalValueWithCode* code = func;
+        if (auto generic = as<IRGeneric>(func))
+            code = as<IRGlobalValueWithCode>(findInnerMostGenericReturnVal(generic));
+        if (code && mayNeedDominatorTree(code) && !module->findDominatorTree(code))
+            funcsToAnalyze.add(code);
+    }
+    if (funcsToAnalyze.getCount() > 1)
+        module->createDominatorTreesInParallel(funcsToAnalyze.getArrayView(), threadCount);
+}
+
 // Run a combination of SSA, SCCP, SimplifyCFG, and DeadCodeElimination pass
 // until no more changes are possible.
 void simplifyIR(
@@ -57,10 +124,23 @@ void simplifyIR(
 {
     SLANG_PROFILE;
     bool changed = true;
-    const int kMaxIterations = 8;
+    // For minimum optimization, a single round simplifies each function as far as it will go
+    // on its own, and only the opportunities across functions are left.
+    const int kMaxIterations = options.minimalOptimization ? 1 : 8;
     const int kMaxFuncIterations = 16;
     int iterationCounter = 0;
 
+    // The passes below all report the functions whose CFG they change, so the
+    // dominator trees of unchanged functions are kept between iterations.
+    IRAnalysisTrackingScope analysisTrackingScope(module);
+
+    // The functions to run the function level passes on in the next round. Only
+    // the ones that changed in the last round, and the functions that reference them,
+    // can have new opportunities, unless the module level passes changed something.
+    //
+    HashSet<IRInst*> dirtyFuncs;
+    bool allFuncsDirty = true;
+
     while (changed && iterationCounter < kMaxIterations)
     {
         if (sink && sink->getErrorCount())
@@ -68,18 +148,42 @@ void simplifyIR(
 
         changed = false;
 
-        changed |= deduplicateGenericChildren(module);
-        changed |= propagateFuncProperties(module);
-        changed |= removeUnusedGenericParam(module);
-        changed |= applySparseConditionalConstantPropagationForGlobalScope(module, sink);
-        changed |= peepholeOptimizeGlobalScope(target, module);
-        changed |= trimOptimizableTypes(module);
+        bool globalChanged = false;
+        globalChanged |= deduplicateGenericChildren(module);
+        globalChanged |= propagateFuncProperties(module);
+        globalChanged |= removeUnusedGenericParam(module);
+        globalChanged |= applySparseConditionalConstantPropagationForGlobalScope(module, sink);
+        globalChanged |= peepholeOptimizeGlobalScope(target, module);
+        globalChanged |= trimOptimizableTypes(module);
+        changed |= globalChanged;
+        if (globalChanged)
+            allFuncsDirty = true;
+
+        IRSimplificationStats::Round round;
+        round.globalChanged = globalChanged;
 
+        List<IRGlobalValueWithCode*> funcsToVisit;
         for (auto inst : module->getGlobalInsts())
         {
             auto func = as<IRGlobalValueWithCode>(inst);
             if (!func)
                 continue;
+            if (!allFuncsDirty && !dirtyFuncs.contains(func))
+                continue;
+            funcsToVisit.add(func);
+        }
+        round.visitedFuncCount = funcsToVisit.getCount();
+
+        // Only the peephole pass uses the cached trees, and only when it has a target
+        // and doesn't restrict itself to fast analysis.
+        if (target && options.threadCount > 1 && !options.minimalOptimization)
+            createDominatorTreesAhead(module, funcsToVisit, options.threadCount);
+
+        List<IRInst*> changedFuncs;
+        for (auto func : funcsToVisit)
+        {
+
+            bool anyFuncChanged = false;
             bool funcChanged = true;
             int funcIterationCount = 0;
             while (funcChanged && funcIterationCount < kMaxFuncIterations)
@@ -101,9 +205,28 @@ void simplifyIR(
                 eliminateDeadCode(func, options.deadCodeElimOptions);
                 if (funcIterationCount == 0)
                     funcChanged |= constructSSA(func);
-                changed |= funcChanged;
+                anyFuncChanged |= funcChanged;
                 funcIterationCount++;
             }
+            if (anyFuncChanged)
+                changedFuncs.add(func);
+        }
+        round.changedFuncCount = changedFuncs.getCount();
+        changed |= changedFuncs.getCount() != 0;
+
+        if (options.stats)
+            options.stats->rounds.add(round);
+
+        // A change to a function can create opportunities in the functions that call it,
+        // for example through the properties `propagateFuncProperties` infers for it.
+        //
+        dirtyFuncs.clear();
+        allFuncsDirty = false;
+        HashSet<IRInst*> visited;
+        for (auto func : changedFuncs)
+        {
+            dirtyFuncs.add(func);
+            addReferencingFuncs(func, visited, dirtyFuncs);
         }
         iterationCounter++;
     }
@@ -116,6 +239,8 @@ void simplifyNonSSAIR(TargetProgram* target, IRModule* module, IRSimplificationO
     const int kMaxIterations = 8;
     int iterationCounter = 0;
 
+    IRAnalysisTrackingScope analysisTrackingScope(module);
+
     while (changed && iterationCounter < kMaxIterations)
     {
         changed = false;
@@ -144,6 +269,8 @@ void simplifyFunc(
     bool changed = true;
     const int kMaxIterations = 8;
     int iterationCounter = 0;
+
+    IRAnalysisTrackingScope analysisTrackingScope(func->getModule());
     while (changed && iterationCounter < kMaxIterations)
     {
         if (sink && sink->getErrorCount())
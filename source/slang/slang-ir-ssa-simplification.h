@@ -1,6 +1,7 @@
 // slang-ir-ssa-simplification.h
 #pragma once
 
+#include "../core/slang-list.h"
 #include "slang-ir-dce.h"
 #include "slang-ir-peephole.h"
 #include "slang-ir-simplify-cfg.h"
@@ -12,6 +13,23 @@ struct IRGlobalValueWithCode;
 class DiagnosticSink;
 class TargetProgram;
 
+/// Statistics collected by `simplifyIR`.
+struct IRSimplificationStats
+{
+    struct Round
+    {
+        /// The number of functions the function level passes were run on.
+        Index visitedFuncCount = 0;
+        /// The number of those functions the passes changed.
+        Index changedFuncCount = 0;
+        /// Whether the module level passes changed anything.
+        bool globalChanged = false;
+    };
+
+    /// One entry for each round of `simplifyIR`, in order.
+    List<Round> rounds;
+};
+
 struct IRSimplificationOptions
 {
     CFGSimplificationOptions cfgOptions;
@@ -21,13 +39,24 @@ struct IRSimplificationOptions
     bool minimalOptimization = false;
     bool removeRedundancy = false;
 
+    /// The number of threads `simplifyIR` computes dominator trees on ahead of the
+    /// function level passes, see `CompilerOptionName::OptimizationThreadCount`.
+    Count threadCount = 1;
+
+    /// If set, `simplifyIR` appends statistics about each round it runs.
+    IRSimplificationStats* stats = nullptr;
+
     static IRSimplificationOptions getDefault(TargetProgram* targetProgram);
 
     static IRSimplificationOptions getFast(TargetProgram* targetProgram);
 };
 
 // Run a combination of SSA, SCCP, SimplifyCFG, and DeadCodeElimination pass
-// until no more changes are possible.
+// until no more changes are possible, or for a single round with `minimalOptimization`.
+//
+// The function level passes are only rerun on the functions that changed in the
+// previous round, and the functions that reference them, unless the module level
+// passes changed something.
 void simplifyIR(
     TargetProgram* target,
     IRModule* module,
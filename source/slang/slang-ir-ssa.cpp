@@ -35,6 +35,10 @@ struct PhiInfo : RefObject
     // If this phi ended up being removed as trivial, then
     // this will be the value that we replaced it with.
     IRInst* replacement = nullptr;
+
+    // Did this phi end up being removed because its value
+    // is never used, other than by other removed phis?
+    bool isDead = false;
 };
 
 // Information about a basic block that we generate/use
@@ -867,6 +871,15 @@ void processBlock(ConstructSSAContext* context, IRBlock* block, SSABlockInfo* bl
 
                 if (auto var = asPromotableVarAccessChain(context, ptrArg))
                 {
+                    // If the loaded value is never used, then there is
+                    // no need to look it up, and doing so could add phis
+                    // that are then dead.
+                    if (!loadInst->hasUses())
+                    {
+                        loadInst->removeAndDeallocate();
+                        break;
+                    }
+
                     // We are loading from a promotable variable.
                     // Look up the value in the context of this
                     // block.
@@ -1038,9 +1051,82 @@ static void breakCriticalEdges(ConstructSSAContext* context)
     {
         IRBuilder::insertBlockAlongEdge(context->module, edge);
     }
+    if (criticalEdges.getCount() != 0)
+        context->module->invalidateAnalysisForInst(globalVal);
 }
 
 // Construct SSA form for a global value with code
+// A phi that isn't trivial may still be dead, if its value is only
+// used by other phis that are themselves dead. This happens when the
+// values of variables are only copied between the variables in a loop,
+// and are never used after it, so that the phis added to the loop header
+// only use each other.
+//
+// A phi is live if it has a use other than as an operand of another phi,
+// or if it is an operand of a live phi, so we find the live phis starting
+// from the former, and remove the others.
+//
+void removeDeadPhis(ConstructSSAContext* context)
+{
+    auto isPhiOperandUse = [&](IRUse* use)
+    {
+        auto user = as<IRParam>(use->getUser());
+        return user && context->getPhiInfo(user);
+    };
+
+    HashSet<PhiInfo*> livePhis;
+    List<PhiInfo*> workList;
+    for (auto& [phi, phiInfo] : context->phiInfos)
+    {
+        if (phiInfo->replacement)
+            continue;
+        for (auto use = phi->firstUse; use; use = use->nextUse)
+        {
+            if (!isPhiOperandUse(use))
+            {
+                livePhis.add(phiInfo);
+                workList.add(phiInfo);
+                break;
+            }
+        }
+    }
+    while (workList.getCount())
+    {
+        auto phiInfo = workList.getLast();
+        workList.removeLast();
+        for (auto& operand : phiInfo->operands)
+        {
+            auto operandPhi = as<IRParam>(operand.get());
+            if (!operandPhi)
+                continue;
+            auto operandPhiInfo = context->getPhiInfo(operandPhi);
+            if (operandPhiInfo && livePhis.add(operandPhiInfo))
+                workList.add(operandPhiInfo);
+        }
+    }
+
+    if (livePhis.getCount() == context->phiInfos.getCount())
+        return;
+
+    // The dead phis may use each other, so we clear all
+    // of their operands before removing any of them.
+    List<PhiInfo*> deadPhis;
+    for (auto& [phi, phiInfo] : context->phiInfos)
+    {
+        if (phiInfo->replacement || livePhis.contains(phiInfo))
+            continue;
+        for (auto& operand : phiInfo->operands)
+            operand.clear();
+        phiInfo->isDead = true;
+        deadPhis.add(phiInfo);
+    }
+    for (auto phiInfo : deadPhis)
+    {
+        SLANG_ASSERT(!phiInfo->phi->hasUses());
+        phiInfo->phi->removeAndDeallocate();
+    }
+}
+
 bool constructSSA(ConstructSSAContext* context)
 {
     // First, detect and and break any critical edges in the CFG,
@@ -1081,6 +1167,10 @@ bool constructSSA(ConstructSSAContext* context)
         processBlock(context, bb, blockInfo);
     }
 
+    // Rather than leaving dead phis for later passes to clean up,
+    // we remove them before they get turned into block parameters.
+    removeDeadPhis(context);
+
     // We need to transfer the logical arguments to our phi nodes
     // from the phi nodes back to the predecessor blocks that will
     // pass them in.
@@ -1090,7 +1180,7 @@ bool constructSSA(ConstructSSAContext* context)
 
         // First remove phis from their parent blocks.
         for (auto phiInfo : blockInfo->phis)
-            if (!phiInfo->replacement)
+            if (!phiInfo->replacement && !phiInfo->isDead)
                 phiInfo->phi->removeFromParent();
 
         // Then, add them back in a consistent order, and add predecessor
@@ -1098,9 +1188,9 @@ bool constructSSA(ConstructSSAContext* context)
         //
         for (auto phiInfo : blockInfo->phis)
         {
-            // If we replaced this phi with another value,
-            // then we had better not include it in the result.
-            if (phiInfo->replacement)
+            // If we replaced this phi with another value, or removed
+            // it as dead, then we had better not include it in the result.
+            if (phiInfo->replacement || phiInfo->isDead)
                 continue;
 
             // We should add the phi as an explicit parameter of
@@ -0,0 +1,296 @@
+// slang-ir-trim-uniform-fields.cpp
+#include "slang-ir-trim-uniform-fields.h"
+
+#include "../compiler-core/slang-artifact-associated-impl.h"
+#include "slang-ir-dce.h"
+#include "slang-ir-insts.h"
+#include "slang-ir-layout.h"
+#include "slang-ir-lower-buffer-element-type.h"
+#include "slang-ir-util.h"
+#include "slang-ir.h"
+
+namespace Slang
+{
+
+struct TrimUniformFieldsContext
+{
+    TargetProgram* targetProgram;
+    IRModule* module;
+
+    // The element types of the constant buffers, and the buffers of each type.
+    List<IRStructType*> elementTypes;
+    Dictionary<IRStructType*, List<IRGlobalParam*>> buffersOfElementType;
+
+    // Get the rules that the target lays out the data of a constant buffer with.
+    IRTypeLayoutRules* getLayoutRules(IRUniformParameterGroupType* bufferType)
+    {
+        auto targetReq = targetProgram->getTargetReq();
+        if (isD3DTarget(targetReq))
+            return IRTypeLayoutRules::getConstantBuffer();
+
+        // Unlike SPIR-V, GLSL is emitted without explicit offsets, and the downstream
+        // compiler lays out uniform blocks with the std140 rules unless told otherwise.
+        //
+        auto rules = getTypeLayoutRuleForBuffer(targetProgram, bufferType);
+        if (!targetProgram->shouldEmitSPIRVDirectly() &&
+            rules->ruleName == IRTypeLayoutRuleName::Natural &&
+            !targetProgram->getOptionSet().shouldUseScalarLayout())
+        {
+            auto dataLayout = bufferType->getDataLayout();
+            if (dataLayout && dataLayout->getOp() == kIROp_Std430BufferLayoutType)
+                return IRTypeLayoutRules::getStd430();
+            if (!dataLayout || dataLayout->getOp() != kIROp_ScalarBufferLayoutType)
+                return IRTypeLayoutRules::getStd140();
+        }
+        return rules;
+    }
+
+    static IRStructTypeLayout* getElementTypeLayout(IRGlobalParam* param)
+    {
+        auto varLayout = findVarLayout(param);
+        if (!varLayout)
+            return nullptr;
+        auto groupTypeLayout = as<IRParameterGroupTypeLayout>(varLayout->getTypeLayout());
+        if (!groupTypeLayout)
+            return nullptr;
+        return as<IRStructTypeLayout>(groupTypeLayout->getElementVarLayout()->getTypeLayout());
+    }
+
+    // Find the binding that identifies the constant buffer `param` to the application. Push
+    // constants and buffers without a binding of their own are not trimmed.
+    static IRVarOffsetAttr* findBindingAttr(IRGlobalParam* param)
+    {
+        auto varLayout = findVarLayout(param);
+        if (!varLayout)
+            return nullptr;
+        if (auto attr = varLayout->findOffsetAttr(LayoutResourceKind::ConstantBuffer))
+            return attr;
+        return varLayout->findOffsetAttr(LayoutResourceKind::DescriptorTableSlot);
+    }
+
+    // Is `pointerType` a pointer to memory that the layout of its value type doesn't matter for?
+    static bool isLogicalPointerType(IRPtrTypeBase* pointerType)
+    {
+        if (!pointerType->hasAddressSpace())
+            return true;
+        switch (pointerType->getAddressSpace())
+        {
+        case AddressSpace::ThreadLocal:
+        case AddressSpace::GroupShared:
+        case AddressSpace::Uniform:
+        case AddressSpace::Function:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Can the fields of `structType` be removed without changing the layout of anything
+    // but its constant buffers?
+    bool canTrimElementType(IRStructType* structType)
+    {
+        for (auto field : structType->getFields())
+        {
+            if (field->getKey()->findDecoration<IRPackOffsetDecoration>())
+                return false;
+        }
+
+        for (auto use = structType->firstUse; use; use = use->nextUse)
+        {
+            auto user = use->getUser();
+            if (as<IRStructField>(user))
+                return false;
+            if (!as<IRType>(user))
+                continue;
+            if (auto pointerType = as<IRPtrTypeBase>(user))
+            {
+                if (!isLogicalPointerType(pointerType))
+                    return false;
+                continue;
+            }
+
+            auto bufferType = as<IRConstantBufferType>(user);
+            if (!bufferType)
+                return false;
+            for (auto bufferTypeUse = bufferType->firstUse; bufferTypeUse;
+                 bufferTypeUse = bufferTypeUse->nextUse)
+            {
+                auto bufferTypeUser = bufferTypeUse->getUser();
+                if (as<IRType>(bufferTypeUser))
+                    return false;
+                auto param = as<IRGlobalParam>(bufferTypeUser);
+                if (param && (!getElementTypeLayout(param) || !findBindingAttr(param)))
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    // Is the field of `fieldLayout` made of nothing but uniform data?
+    static bool isOrdinaryField(IRVarLayout* fieldLayout)
+    {
+        for (auto sizeAttr : fieldLayout->getTypeLayout()->getSizeAttrs())
+        {
+            if (sizeAttr->getResourceKind() != LayoutResourceKind::Uniform)
+                return false;
+        }
+        return fieldLayout->findOffsetAttr(LayoutResourceKind::Uniform) != nullptr;
+    }
+
+    static void removeCachedLayout(IRInst* inst)
+    {
+        List<IRDecoration*> decorations;
+        for (auto decoration : inst->getDecorations())
+        {
+            switch (decoration->getOp())
+            {
+            case kIROp_SizeAndAlignmentDecoration:
+            case kIROp_OffsetDecoration:
+                decorations.add(decoration);
+                break;
+            default:
+                break;
+            }
+        }
+        for (auto decoration : decorations)
+            decoration->removeAndDeallocate();
+    }
+
+    // Remove the unused ordinary fields of `structType`. Returns false if none could be removed.
+    bool trimElementType(IRStructType* structType, IRStructTypeLayout* typeLayout)
+    {
+        List<IRStructField*> fieldsToRemove;
+        Index fieldCount = 0;
+        for (auto field : structType->getFields())
+        {
+            fieldCount++;
+            IRVarLayout* fieldLayout = nullptr;
+            for (auto fieldAttr : typeLayout->getFieldLayoutAttrs())
+            {
+                if (fieldAttr->getFieldKey() == field->getKey())
+                    fieldLayout = fieldAttr->getLayout();
+            }
+            if (fieldLayout && isOrdinaryField(fieldLayout) && !isFieldUsed(field))
+                fieldsToRemove.add(field);
+        }
+        // Keep a field in buffers that the shader only uses the resources of, since a
+        // constant buffer can't be empty on every target.
+        //
+        if (fieldsToRemove.getCount() == fieldCount)
+            fieldsToRemove.removeAt(0);
+        if (fieldsToRemove.getCount() == 0)
+            return false;
+
+        for (auto field : fieldsToRemove)
+        {
+            trimMakeStructOperands(field);
+            field->removeFromParent();
+        }
+        for (auto field : fieldsToRemove)
+            field->removeAndDeallocate();
+
+        // The offsets of the remaining fields may have been computed with the removed
+        // fields before.
+        //
+        removeCachedLayout(structType);
+        for (auto field : structType->getFields())
+            removeCachedLayout(field);
+        return true;
+    }
+
+    // Record where the fields of `param` were in its reflected layout, and where the remaining
+    // fields are now.
+    void addFieldLocations(
+        IRGlobalParam* param,
+        IRStructTypeLayout* typeLayout,
+        List<ShaderUniformFieldLocation>& outFields)
+    {
+        auto bindingAttr = findBindingAttr(param);
+        auto bufferType = cast<IRUniformParameterGroupType>(param->getDataType());
+        auto structType = cast<IRStructType>(bufferType->getElementType());
+        auto rules = getLayoutRules(bufferType);
+
+        for (auto fieldAttr : typeLayout->getFieldLayoutAttrs())
+        {
+            auto fieldLayout = fieldAttr->getLayout();
+            auto sizeAttr = fieldLayout->getTypeLayout()->findSizeAttr(LayoutResourceKind::Uniform);
+            if (!isOrdinaryField(fieldLayout) || !sizeAttr || !sizeAttr->getSize().isFinite())
+                continue;
+
+            ShaderUniformFieldLocation location;
+            location.category = slang::ParameterCategory(bindingAttr->getResourceKind());
+            location.spaceIndex = bindingAttr->getSpace();
+            location.registerIndex = bindingAttr->getOffset();
+            location.offset = fieldLayout->findOffsetAttr(LayoutResourceKind::Uniform)->getOffset();
+            location.size = sizeAttr->getFiniteSize();
+            location.isUsed = false;
+
+            for (auto field : structType->getFields())
+            {
+                IRIntegerValue compiledOffset = 0;
+                if (field->getKey() == fieldAttr->getFieldKey() &&
+                    SLANG_SUCCEEDED(getOffset(
+                        targetProgram->getOptionSet(),
+                        rules,
+                        field,
+                        &compiledOffset)))
+                {
+                    location.isUsed = true;
+                    location.compiledOffset = UInt(compiledOffset);
+                }
+            }
+            outFields.add(location);
+        }
+    }
+
+    void processModule(List<ShaderUniformFieldLocation>& outFields)
+    {
+        auto targetReq = targetProgram->getTargetReq();
+        if (!isD3DTarget(targetReq) && !isKhronosTarget(targetReq))
+            return;
+
+        for (auto globalInst : module->getGlobalInsts())
+        {
+            auto param = as<IRGlobalParam>(globalInst);
+            if (!param)
+                continue;
+            auto bufferType = as<IRConstantBufferType>(param->getDataType());
+            if (!bufferType || !getElementTypeLayout(param) || !findBindingAttr(param))
+                continue;
+            auto structType = as<IRStructType>(bufferType->getElementType());
+            if (!structType)
+                continue;
+            if (!buffersOfElementType.containsKey(structType))
+                elementTypes.add(structType);
+            buffersOfElementType[structType].add(param);
+        }
+
+        for (auto structType : elementTypes)
+        {
+            auto& params = buffersOfElementType[structType];
+            if (!canTrimElementType(structType))
+                continue;
+
+            // All the buffers of a type were laid out alike by the front end.
+            auto typeLayout = getElementTypeLayout(params[0]);
+            if (!trimElementType(structType, typeLayout))
+                continue;
+
+            for (auto param : params)
+                addFieldLocations(param, getElementTypeLayout(param), outFields);
+        }
+    }
+};
+
+void trimUnusedUniformFields(
+    TargetProgram* targetProgram,
+    IRModule* module,
+    List<ShaderUniformFieldLocation>& outFields)
+{
+    TrimUniformFieldsContext context;
+    context.targetProgram = targetProgram;
+    context.module = module;
+    context.processModule(outFields);
+}
+
+} // namespace Slang
@@ -0,0 +1,25 @@
+// slang-ir-trim-uniform-fields.h
+#pragma once
+
+#include "../core/slang-basic.h"
+
+namespace Slang
+{
+struct IRModule;
+struct ShaderUniformFieldLocation;
+class TargetProgram;
+
+/// Remove the fields of the constant buffers of `module` that the shader doesn't use, so that
+/// the fields it uses are packed together.
+///
+/// Only the ordinary data fields of constant buffers whose element type isn't stored anywhere
+/// else are removed, and only for D3D and Khronos targets. The fields of each trimmed buffer,
+/// with their offset in the reflected layout and in the compiled shader, are added to
+/// `outFields`.
+///
+void trimUnusedUniformFields(
+    TargetProgram* targetProgram,
+    IRModule* module,
+    List<ShaderUniformFieldLocation>& outFields);
+
+} // namespace Slang
@@ -500,4 +500,135 @@ void validateUniformity(IRModule* module, DiagnosticSink* sink)
     context.sink = sink;
     context.analyzeModule();
 }
+
+// Finds the values that are provably the same for every invocation of a dispatch.
+//
+// Unlike `ValidateUniformityContext`, which assumes values are uniform unless they come
+// from a known non-uniform source, this is conservative: only constants, uniform shader
+// parameters, and pure operations on them are uniform.
+//
+struct DynamicUniformityContext
+{
+    // The uniformity of the insts analyzed so far. An inst is mapped to `false` while it
+    // is being analyzed, so that cycles are treated as non-uniform.
+    Dictionary<IRInst*, bool> uniformInsts;
+
+    bool isUniformGlobalParam(IRGlobalParam* param)
+    {
+        auto varLayout = findVarLayout(param);
+        if (!varLayout || isVaryingParameter(varLayout))
+            return false;
+        return varLayout->findSystemValueSemanticAttr() == nullptr;
+    }
+
+    // Is `addr` the address of a part of a uniform parameter group, such as a constant
+    // buffer, at a uniform offset?
+    bool isUniformParameterGroupAddr(IRInst* addr)
+    {
+        for (;;)
+        {
+            switch (addr->getOp())
+            {
+            case kIROp_FieldAddress:
+                addr = addr->getOperand(0);
+                continue;
+            case kIROp_GetElementPtr:
+                if (!isUniform(addr->getOperand(1)))
+                    return false;
+                addr = addr->getOperand(0);
+                continue;
+            default:
+                break;
+            }
+            break;
+        }
+
+        auto param = as<IRGlobalParam>(addr);
+        return param && as<IRUniformParameterGroupType>(param->getDataType()) &&
+               isUniformGlobalParam(param);
+    }
+
+    bool areOperandsUniform(IRInst* inst)
+    {
+        for (UInt i = 0; i < inst->getOperandCount(); i++)
+        {
+            if (!isUniform(inst->getOperand(i)))
+                return false;
+        }
+        return true;
+    }
+
+    bool computeIsUniform(IRInst* inst)
+    {
+        if (as<IRConstant>(inst))
+            return true;
+        if (auto param = as<IRGlobalParam>(inst))
+            return isUniformGlobalParam(param);
+        if (as<IRModuleInst>(inst->getParent()))
+            return !as<IRGlobalVar>(inst);
+
+        switch (inst->getOp())
+        {
+        case kIROp_Param:
+            // The arguments of a function, and the values of a block parameter coming from
+            // different branches, may differ between invocations.
+            return false;
+        case kIROp_Load:
+            return isUniformParameterGroupAddr(as<IRLoad>(inst)->getPtr());
+        case kIROp_StructuredBufferLoad:
+            // Read-only buffers can't change during a dispatch.
+            return as<IRHLSLStructuredBufferType>(inst->getOperand(0)->getDataType()) &&
+                   areOperandsUniform(inst);
+        case kIROp_ByteAddressBufferLoad:
+            return as<IRHLSLByteAddressBufferType>(inst->getOperand(0)->getDataType()) &&
+                   areOperandsUniform(inst);
+        case kIROp_Div:
+            // The division of uniform values is uniform, even though it can't be freely
+            // moved like the other arithmetic operations.
+            return areOperandsUniform(inst);
+        case kIROp_Call:
+            return false;
+        default:
+            return isMovableInst(inst) && areOperandsUniform(inst);
+        }
+    }
+
+    bool isUniform(IRInst* inst)
+    {
+        if (auto result = uniformInsts.tryGetValue(inst))
+            return *result;
+
+        uniformInsts[inst] = false;
+        bool result = computeIsUniform(inst);
+        uniformInsts[inst] = result;
+        return result;
+    }
+};
+
+void removeRedundantNonUniformResourceIndex(IRModule* module)
+{
+    List<IRInst*> nonUniformResourceIndexInsts;
+    List<IRInst*> workList;
+    workList.add(module->getModuleInst());
+    for (Index i = 0; i < workList.getCount(); i++)
+    {
+        for (auto child : workList[i]->getChildren())
+        {
+            if (child->getOp() == kIROp_NonUniformResourceIndex)
+                nonUniformResourceIndexInsts.add(child);
+            else if (child->getFirstChild())
+                workList.add(child);
+        }
+    }
+
+    DynamicUniformityContext context;
+    for (auto inst : nonUniformResourceIndexInsts)
+    {
+        auto index = inst->getOperand(0);
+        if (!context.isUniform(index))
+            continue;
+        inst->replaceUsesWith(index);
+        inst->removeAndDeallocate();
+    }
+}
 } // namespace Slang
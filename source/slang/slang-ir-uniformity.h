@@ -7,4 +7,9 @@ struct IRModule;
 class DiagnosticSink;
 
 void validateUniformity(IRModule* module, DiagnosticSink* sink);
+
+/// Remove the `NonUniformResourceIndex` around indices that are provably the same for every
+/// invocation, such as constants and values loaded from constant buffers, so that the targets
+/// don't access the resource as if the index were non-uniform.
+void removeRedundantNonUniformResourceIndex(IRModule* module);
 } // namespace Slang
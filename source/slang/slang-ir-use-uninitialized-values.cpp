@@ -521,8 +521,23 @@ static List<IRStructField*> checkFieldsFromExit(
     return uninitializedFields;
 }
 
+static bool isConstructorCheckEnabled(DiagnosticSink* sink)
+{
+    return sink->isDiagnosticEnabled(Diagnostics::fieldNotDefaultInitialized) ||
+           sink->isDiagnosticEnabled(Diagnostics::constructorUninitializedField);
+}
+
+static bool isOutParameterCheckEnabled(DiagnosticSink* sink)
+{
+    return sink->isDiagnosticEnabled(Diagnostics::returningWithUninitializedOut) ||
+           sink->isDiagnosticEnabled(Diagnostics::usingUninitializedOut);
+}
+
 static void checkConstructor(IRFunc* func, ReachabilityContext& reachability, DiagnosticSink* sink)
 {
+    if (!isConstructorCheckEnabled(sink))
+        return;
+
     auto constructor = func->findDecoration<IRConstructorDecorartion>();
     if (!constructor)
         return;
@@ -598,7 +613,16 @@ static void checkUninitializedValues(IRFunc* func, DiagnosticSink* sink)
     if (!firstBlock)
         return;
 
+    // The checks are only done for their warnings, so there is no need to
+    // analyze the function if all of them are disabled.
+    const bool checkOutParameters = isOutParameterCheckEnabled(sink);
+    const bool checkVariables = sink->isDiagnosticEnabled(Diagnostics::usingUninitializedVariable);
+    if (!checkOutParameters && !checkVariables && !isConstructorCheckEnabled(sink))
+        return;
+
+    // The checks only read the function, so the order of its instructions stays valid.
     ReachabilityContext reachability(func);
+    reachability.numberInsts();
 
     // Used for a further analysis and to skip usual return checks
     auto constructor = func->findDecoration<IRConstructorDecorartion>();
@@ -609,7 +633,7 @@ static void checkUninitializedValues(IRFunc* func, DiagnosticSink* sink)
         stage = entry->getProfile().getStage();
 
     // Check out parameters
-    if (!isUnmodifying(func))
+    if (checkOutParameters && !isUnmodifying(func))
     {
         int index = 0;
         for (auto param : firstBlock->getParams())
@@ -622,25 +646,28 @@ static void checkUninitializedValues(IRFunc* func, DiagnosticSink* sink)
     }
 
     // Check ordinary instructions
-    for (auto block : func->getBlocks())
+    if (checkVariables)
     {
-        for (auto inst = block->getFirstInst(); inst; inst = inst->getNextInst())
+        for (auto block : func->getBlocks())
         {
-            if (!isUninitializedValue(inst))
-                continue;
-
-            // This will be looked into later
-            if (constructor && isReturnedValue(inst))
-                continue;
-
-            IRType* type = inst->getFullType();
-            if (canIgnoreType(type, nullptr))
-                continue;
-
-            auto loads = getUnresolvedVariableLoads(reachability, inst);
-            for (auto load : loads)
+            for (auto inst = block->getFirstInst(); inst; inst = inst->getNextInst())
             {
-                sink->diagnose(load, Diagnostics::usingUninitializedVariable, inst);
+                if (!isUninitializedValue(inst))
+                    continue;
+
+                // This will be looked into later
+                if (constructor && isReturnedValue(inst))
+                    continue;
+
+                IRType* type = inst->getFullType();
+                if (canIgnoreType(type, nullptr))
+                    continue;
+
+                auto loads = getUnresolvedVariableLoads(reachability, inst);
+                for (auto load : loads)
+                {
+                    sink->diagnose(load, Diagnostics::usingUninitializedVariable, inst);
+                }
             }
         }
     }
@@ -651,6 +678,9 @@ static void checkUninitializedValues(IRFunc* func, DiagnosticSink* sink)
 
 static void checkUninitializedGlobals(IRGlobalVar* variable, DiagnosticSink* sink)
 {
+    if (!sink->isDiagnosticEnabled(Diagnostics::usingUninitializedGlobalVariable))
+        return;
+
     IRType* type = variable->getFullType();
     if (canIgnoreType(type, nullptr))
         return;
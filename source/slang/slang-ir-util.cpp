@@ -1444,7 +1444,7 @@ void resetScratchDataBit(IRInst* inst, int bitIndex)
     {
         auto item = workList.getLast();
         workList.removeLast();
-        item->scratchData &= ~(1ULL << bitIndex);
+        item->scratchData &= ~(1u << bitIndex);
         for (auto child = item->getLastDecorationOrChild(); child; child = child->getPrevInst())
             workList.add(child);
     }
@@ -0,0 +1,253 @@
+// slang-ir-vectorize-scalar-ops.cpp
+#include "slang-ir-vectorize-scalar-ops.h"
+
+#include "slang-ir-insts.h"
+#include "slang-ir-util.h"
+#include "slang-ir.h"
+
+namespace Slang
+{
+
+// Type legalization and the lowering of some vector operations leave code
+// that computes each component of a vector separately, and only puts the
+// components back together at the end. Text targets like C++, CUDA, Metal
+// and WGSL pass such code on to compilers that don't reliably vectorize it
+// again, so we do it ourselves.
+//
+// Starting from a `makeVector`, we look at its operands (the "lanes"), and
+// check whether they can be computed as one vector:
+//
+// * lanes that extract components 0..N-1, in order, from the same N-component
+//   vector are just that vector,
+// * lanes that are all the same value are a splat of that value,
+// * lanes that are all constants are a vector constant, and
+// * lanes that are the same operation on scalars of the same type, each used
+//   only by the vector being built, are that operation on vectors, as long as
+//   the lanes of each of their operands can in turn be computed as one vector.
+//
+struct ScalarOpVectorizationContext
+{
+    // Don't follow chains of scalar operations too deep.
+    static const int kMaxDepth = 8;
+
+    static bool isVectorizableOp(IROp op)
+    {
+        switch (op)
+        {
+        case kIROp_Add:
+        case kIROp_Sub:
+        case kIROp_Mul:
+        case kIROp_Div:
+        case kIROp_Neg:
+        case kIROp_BitAnd:
+        case kIROp_BitOr:
+        case kIROp_BitXor:
+        case kIROp_BitNot:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // If `inst` extracts a constant component of a vector, return the vector
+    // and the index of the component.
+    //
+    static IRInst* getExtractedVector(IRInst* inst, IRIntegerValue& outIndex)
+    {
+        IRInst* base = nullptr;
+        IRInst* index = nullptr;
+        if (inst->getOp() == kIROp_GetElement)
+        {
+            base = inst->getOperand(0);
+            index = inst->getOperand(1);
+        }
+        else if (auto swizzle = as<IRSwizzle>(inst))
+        {
+            if (swizzle->getElementCount() != 1)
+                return nullptr;
+            base = swizzle->getBase();
+            index = swizzle->getElementIndex(0);
+        }
+        auto indexLit = as<IRIntLit>(index);
+        if (!base || !indexLit || !as<IRVectorType>(base->getDataType()))
+            return nullptr;
+        outIndex = indexLit->getValue();
+        return base;
+    }
+
+    // Are `lanes` the components of an existing vector of the same size?
+    //
+    static IRInst* findExistingVector(ArrayView<IRInst*> lanes)
+    {
+        IRInst* vector = nullptr;
+        for (Index i = 0; i < lanes.getCount(); i++)
+        {
+            IRIntegerValue index = 0;
+            auto base = getExtractedVector(lanes[i], index);
+            if (!base || index != i || (vector && base != vector))
+                return nullptr;
+            vector = base;
+        }
+        auto vectorType = as<IRVectorType>(vector->getDataType());
+        auto elementCount = as<IRIntLit>(vectorType->getElementCount());
+        if (!elementCount || elementCount->getValue() != lanes.getCount())
+            return nullptr;
+        return vector;
+    }
+
+    static bool isSplat(ArrayView<IRInst*> lanes)
+    {
+        for (auto lane : lanes)
+        {
+            if (lane != lanes[0])
+                return false;
+        }
+        return true;
+    }
+
+    static bool areAllConstants(ArrayView<IRInst*> lanes)
+    {
+        for (auto lane : lanes)
+        {
+            if (!as<IRConstant>(lane))
+                return false;
+        }
+        return true;
+    }
+
+    // Are `lanes` the same vectorizable operation, on scalars of a type, each
+    // used only once?
+    //
+    static bool areIsomorphicOps(ArrayView<IRInst*> lanes)
+    {
+        auto first = lanes[0];
+        if (!isVectorizableOp(first->getOp()) || !as<IRBasicType>(first->getDataType()))
+            return false;
+        for (auto lane : lanes)
+        {
+            if (lane->getOp() != first->getOp() || lane->getFullType() != first->getFullType())
+                return false;
+            if (lane->getOperandCount() != first->getOperandCount())
+                return false;
+            if (!lane->hasUses() || lane->hasMoreThanOneUse())
+                return false;
+            for (UInt i = 0; i < lane->getOperandCount(); i++)
+            {
+                if (lane->getOperand(i)->getFullType() != first->getFullType())
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    static void getOperandLanes(ArrayView<IRInst*> lanes, UInt operandIndex, List<IRInst*>& out)
+    {
+        out.clear();
+        for (auto lane : lanes)
+            out.add(lane->getOperand(operandIndex));
+    }
+
+    bool canFormVector(ArrayView<IRInst*> lanes, int depth)
+    {
+        if (findExistingVector(lanes) || isSplat(lanes) || areAllConstants(lanes))
+            return true;
+        if (depth >= kMaxDepth || !areIsomorphicOps(lanes))
+            return false;
+        List<IRInst*> operandLanes;
+        for (UInt i = 0; i < lanes[0]->getOperandCount(); i++)
+        {
+            getOperandLanes(lanes, i, operandLanes);
+            if (!canFormVector(operandLanes.getArrayView(), depth + 1))
+                return false;
+        }
+        return true;
+    }
+
+    IRInst* formVector(IRBuilder& builder, IRType* vectorType, ArrayView<IRInst*> lanes)
+    {
+        if (auto vector = findExistingVector(lanes))
+            return vector;
+        if (isSplat(lanes))
+            return builder.emitMakeVectorFromScalar(vectorType, lanes[0]);
+        if (areAllConstants(lanes))
+            return builder.emitMakeVector(vectorType, (UInt)lanes.getCount(), lanes.getBuffer());
+
+        List<IRInst*> operands;
+        List<IRInst*> operandLanes;
+        for (UInt i = 0; i < lanes[0]->getOperandCount(); i++)
+        {
+            getOperandLanes(lanes, i, operandLanes);
+            operands.add(formVector(builder, vectorType, operandLanes.getArrayView()));
+        }
+        return builder.emitIntrinsicInst(
+            vectorType,
+            lanes[0]->getOp(),
+            (UInt)operands.getCount(),
+            operands.getBuffer());
+    }
+
+    bool tryVectorize(IRInst* makeVector)
+    {
+        auto vectorType = as<IRVectorType>(makeVector->getDataType());
+        if (!vectorType)
+            return false;
+        auto elementCount = as<IRIntLit>(vectorType->getElementCount());
+        if (!elementCount ||
+            elementCount->getValue() != (IRIntegerValue)makeVector->getOperandCount())
+            return false;
+
+        List<IRInst*> lanes;
+        for (UInt i = 0; i < makeVector->getOperandCount(); i++)
+            lanes.add(makeVector->getOperand(i));
+
+        // Splats and constants are better left as they are.
+        //
+        auto lanesView = lanes.getArrayView();
+        if (!findExistingVector(lanesView) && !areIsomorphicOps(lanesView))
+            return false;
+        if (!canFormVector(lanesView, 0))
+            return false;
+
+        IRBuilder builder(makeVector);
+        builder.setInsertBefore(makeVector);
+        auto vector = formVector(builder, vectorType, lanesView);
+        makeVector->replaceUsesWith(vector);
+        makeVector->removeAndDeallocate();
+        return true;
+    }
+
+    bool processFunc(IRGlobalValueWithCode* func)
+    {
+        List<IRInst*> makeVectors;
+        for (auto block : func->getBlocks())
+        {
+            for (auto inst : block->getChildren())
+            {
+                if (inst->getOp() == kIROp_MakeVector)
+                    makeVectors.add(inst);
+            }
+        }
+
+        // The scalar operations a vector replaces are left for dead code
+        // elimination to remove.
+        //
+        bool changed = false;
+        for (auto makeVector : makeVectors)
+            changed |= tryVectorize(makeVector);
+        return changed;
+    }
+};
+
+bool vectorizeScalarOps(IRModule* module)
+{
+    ScalarOpVectorizationContext context;
+    bool changed = false;
+    for (auto inst : module->getGlobalInsts())
+    {
+        if (auto func = as<IRFunc>(inst))
+            changed |= context.processFunc(func);
+    }
+    return changed;
+}
+
+} // namespace Slang
@@ -0,0 +1,19 @@
+// slang-ir-vectorize-scalar-ops.h
+#pragma once
+
+namespace Slang
+{
+struct IRModule;
+
+/// Replace vectors built out of the results of isomorphic scalar operations
+/// with a single vector operation.
+///
+/// For example `makeVector(add(x.x, y), add(x.y, y))` becomes
+/// `add(x, makeVectorFromScalar(y))` when `x` is a 2-component vector. Only
+/// vectors whose lanes can all be traced back to existing vectors, repeated
+/// values, or constants are vectorized, so no new packing of scalars is
+/// introduced.
+///
+/// Returns true if any vector was replaced.
+bool vectorizeScalarOps(IRModule* module);
+} // namespace Slang
@@ -8,6 +8,10 @@
 #include "slang-ir-util.h"
 #include "slang-mangle.h"
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 namespace Slang
 {
 struct IRSpecContext;
@@ -154,6 +158,10 @@ IROp findIROp(const UnownedStringSlice& name)
 
 //
 
+#ifdef _DEBUG
+IRUse::DebugCounters IRUse::s_debugCounters;
+#endif
+
 void IRUse::debugValidate()
 {
 #ifdef _DEBUG
@@ -192,6 +200,9 @@ void IRUse::init(IRInst* u, IRInst* v)
         }
 
         v->firstUse = this;
+#ifdef _DEBUG
+        s_debugCounters.linkCount++;
+#endif
     }
 #ifdef SLANG_ENABLE_FULL_IR_VALIDATION
     debugValidate();
@@ -229,6 +240,9 @@ void IRUse::clear()
         usedValue = nullptr;
         nextUse = nullptr;
         prevLink = nullptr;
+#ifdef _DEBUG
+        s_debugCounters.unlinkCount++;
+#endif
 
 #ifdef SLANG_ENABLE_FULL_IR_VALIDATION
         if (uv->firstUse)
@@ -2499,30 +2513,37 @@ IRInst* IRBuilder::_findOrEmitHoistableInst(
 
     canonicalizeInstOperands(*this, op, canonicalizedOperands.getArrayView().arrayView);
 
-    auto& memoryArena = getModule()->getMemoryArena();
-    void* cursor = memoryArena.getCursor();
-
-    // We are going to create a 'dummy' instruction on the memoryArena
-    // which can be used as a key for lookup, so see if we
-    // already have an equivalent instruction available to use.
-    size_t keySize = sizeof(IRInst) + operandCount * sizeof(IRUse);
-    IRInst* inst = (IRInst*)memoryArena.allocateAndZero(keySize);
-
-    void* endCursor = memoryArena.getCursor();
-    // Mark as 'unused' cos it is unused on release builds.
-    SLANG_UNUSED(endCursor);
+    // We are going to create a 'dummy' instruction which can be used as a key for
+    // lookup, so see if we already have an equivalent instruction available to use.
+    //
+    // Most lookups find an existing instruction, so the key is built in a local buffer
+    // rather than in the module's memory arena, and the instruction is only allocated
+    // (and its operands linked up) once we know it is new.
+    //
+    const size_t keySize = sizeof(IRInst) + operandCount * sizeof(IRUse);
+    enum
+    {
+        kLocalKeyOperandCount = 8
+    };
+    alignas(IRInst) unsigned char localKeyBuffer[sizeof(IRInst) +
+                                                 kLocalKeyOperandCount * sizeof(IRUse)];
+    List<UInt64> heapKeyBuffer;
+    void* keyBuffer = localKeyBuffer;
+    if (keySize > sizeof(localKeyBuffer))
+    {
+        heapKeyBuffer.setCount(Index((keySize + sizeof(UInt64) - 1) / sizeof(UInt64)));
+        keyBuffer = heapKeyBuffer.getBuffer();
+    }
+    ::memset(keyBuffer, 0, keySize);
 
-    new (inst) IRInst();
-#if SLANG_ENABLE_IR_BREAK_ALLOC
-    inst->_debugUID = _debugGetAndIncreaseInstCounter();
-#endif
-    inst->m_op = op;
-    inst->typeUse.usedValue = type;
-    inst->operandCount = (uint32_t)operandCount;
+    IRInst* keyInst = new (keyBuffer) IRInst();
+    keyInst->m_op = op;
+    keyInst->typeUse.usedValue = type;
+    keyInst->operandCount = (uint32_t)operandCount;
 
-    // Don't link up as we may free (if we already have this key)
+    // Don't link up, as the key is only used for the lookup
     {
-        IRUse* operand = inst->getOperands();
+        IRUse* operand = keyInst->getOperands();
         for (Int ii = 0; ii < fixedArgCount; ++ii)
         {
             auto arg = canonicalizedOperands[ii];
@@ -2543,20 +2564,15 @@ IRInst* IRBuilder::_findOrEmitHoistableInst(
         }
     }
 
-    // Find or add the key/inst
+    // Find the key
     {
-        IRInstKey key = {inst};
-
-        IRInst** found = m_dedupContext->getGlobalValueNumberingMap().tryGetValueOrAdd(key, inst);
-        SLANG_ASSERT(endCursor == memoryArena.getCursor());
-        // If it's found, just return, and throw away the instruction
-        if (found)
+        IRInst* foundInst = nullptr;
+        if (m_dedupContext->getGlobalValueNumberingMap().tryGetValue(
+                IRInstKey{keyInst},
+                foundInst))
         {
-            memoryArena.rewindToCursor(cursor);
-
             // If the found inst is defined in the same parent as current insert location but
             // is located after the insert location, we need to move it to the insert location.
-            auto foundInst = *found;
             if (foundInst->getParent() && foundInst->getParent() == getInsertLoc().getParent() &&
                 getInsertLoc().getMode() == IRInsertLoc::Mode::Before)
             {
@@ -2573,32 +2589,29 @@ IRInst* IRBuilder::_findOrEmitHoistableInst(
                 if (isAfter)
                     foundInst->insertBefore(insertLoc);
             }
-            return *found;
+            return foundInst;
         }
     }
 
-    // Make the lookup 'inst' instruction into 'proper' instruction. Equivalent to
+    // Make a 'proper' instruction with the same contents as the key. Equivalent to
     // IRInst* inst = createInstImpl<IRInst>(builder, op, type, 0, nullptr, operandListCount,
     // listOperandCounts, listOperands);
+    IRInst* inst = getModule()->_allocateInst(op, operandCount);
+#if SLANG_ENABLE_IR_BREAK_ALLOC
+    inst->_debugUID = _debugGetAndIncreaseInstCounter();
+#endif
     {
         if (type)
-        {
-            inst->typeUse.usedValue = nullptr;
             inst->typeUse.init(inst, type);
-        }
 
         _maybeSetSourceLoc(inst);
 
+        IRUse* const keyOperands = keyInst->getOperands();
         IRUse* const operands = inst->getOperands();
         for (UInt i = 0; i < operandCount; ++i)
-        {
-            IRUse& operand = operands[i];
-            auto value = operand.usedValue;
-
-            operand.usedValue = nullptr;
-            operand.init(inst, value);
-        }
+            operands[i].init(inst, keyOperands[i].usedValue);
     }
+    m_dedupContext->getGlobalValueNumberingMap().add(IRInstKey{inst}, inst);
 
     addHoistableInst(this, inst);
 
@@ -2972,6 +2985,12 @@ IRTensorViewType* IRBuilder::getTensorViewType(IRType* elementType)
     return (IRTensorViewType*)getType(kIROp_TensorViewType, 1, (IRInst**)&elementType);
 }
 
+IRTensorViewType* IRBuilder::getContiguousTensorViewType(IRType* elementType)
+{
+    IRInst* operands[] = {elementType, getBoolValue(true)};
+    return (IRTensorViewType*)getType(kIROp_TensorViewType, 2, operands);
+}
+
 IRTorchTensorType* IRBuilder::getTorchTensorType(IRType* elementType)
 {
     return (IRTorchTensorType*)getType(kIROp_TorchTensorType, 1, (IRInst**)&elementType);
@@ -3392,10 +3411,26 @@ IRInst* IRBuilder::emitCudaKernelLaunch(
     IRInst* gridDim,
     IRInst* blockDim,
     IRInst* argsArray,
-    IRInst* cudaStream)
+    IRInst* cudaStream,
+    IRInst* contiguousVariantFn,
+    List<IRInst*> const& contiguousTensors)
 {
-    IRInst* args[5] = {baseFn, gridDim, blockDim, argsArray, cudaStream};
-    return emitIntrinsicInst(getVoidType(), kIROp_CudaKernelLaunch, 5, args);
+    List<IRInst*> args;
+    args.add(baseFn);
+    args.add(gridDim);
+    args.add(blockDim);
+    args.add(argsArray);
+    args.add(cudaStream);
+    if (contiguousVariantFn)
+    {
+        args.add(contiguousVariantFn);
+        args.addRange(contiguousTensors);
+    }
+    return emitIntrinsicInst(
+        getVoidType(),
+        kIROp_CudaKernelLaunch,
+        args.getCount(),
+        args.getBuffer());
 }
 
 IRInst* IRBuilder::emitGetTorchCudaStream()
@@ -4421,6 +4456,14 @@ RefPtr<IRModule> IRModule::create(Session* session)
 {
     RefPtr<IRModule> module = new IRModule(session);
 
+    // Count the memory of the module against the session it is created for, if there is one.
+    if (auto astBuilder = getCurrentASTBuilder())
+    {
+        module->m_memoryArena.setAccounting(
+            astBuilder->getMemoryAccounting(),
+            MemoryCategory::IR);
+    }
+
     auto moduleInst = module->_allocateInst<IRModuleInst>(kIROp_Module, 0);
 
     module->m_moduleInst = moduleInst;
@@ -4429,6 +4472,43 @@ RefPtr<IRModule> IRModule::create(Session* session)
     return module;
 }
 
+MangledNamePool::Id MangledNamePool::add(UnownedStringSlice mangledName)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return StringSlicePool::asIndex(m_pool.add(mangledName));
+}
+
+/* static */ MangledNamePool& MangledNamePool::getSingleton()
+{
+    static MangledNamePool pool;
+    return pool;
+}
+
+const IRModule::MangledNameIndex& IRModule::getMangledNameIndex()
+{
+    std::lock_guard<std::mutex> lock(m_mangledNameIndexMutex);
+    if (!m_mangledNameIndex)
+    {
+        m_mangledNameIndex = std::make_unique<MangledNameIndex>();
+        auto& mangledNamePool = MangledNamePool::getSingleton();
+        for (auto inst : getGlobalInsts())
+        {
+            if (auto linkage = inst->findDecoration<IRLinkageDecoration>())
+            {
+                auto id = mangledNamePool.add(linkage->getMangledName());
+                m_mangledNameIndex->getOrAddValue(id, {}).add(inst);
+            }
+        }
+    }
+    return *m_mangledNameIndex;
+}
+
+void IRModule::invalidateMangledNameIndex()
+{
+    std::lock_guard<std::mutex> lock(m_mangledNameIndexMutex);
+    m_mangledNameIndex.reset();
+}
+
 IRDominatorTree* IRModule::findOrCreateDominatorTree(IRGlobalValueWithCode* func)
 {
     IRAnalysis* analysis = m_mapInstToAnalysis.tryGetValue(func);
@@ -4443,6 +4523,48 @@ IRDominatorTree* IRModule::findOrCreateDominatorTree(IRGlobalValueWithCode* func
     return analysis->getDominatorTree();
 }
 
+void IRModule::createDominatorTreesInParallel(
+    ArrayView<IRGlobalValueWithCode*> funcs,
+    Count threadCount)
+{
+    // Computing a dominator tree only reads the blocks of its function, so the trees
+    // of different functions can be computed at the same time. Nothing else about the
+    // IR is safe to use concurrently (instructions share use lists with the global
+    // values they reference, and are allocated from the module's arena), so the trees
+    // are only added to the cache once all the workers are done.
+    //
+    const Count funcCount = funcs.getCount();
+    List<RefPtr<IRDominatorTree>> domTrees;
+    domTrees.setCount(funcCount);
+
+    std::atomic<Index> nextFuncIndex(0);
+    auto worker = [&]()
+    {
+        for (;;)
+        {
+            const Index funcIndex = nextFuncIndex++;
+            if (funcIndex >= funcCount)
+                break;
+            domTrees[funcIndex] = computeDominatorTree(funcs[funcIndex]);
+        }
+    };
+
+    // This thread computes trees too, so it only needs `threadCount - 1` helpers.
+    std::vector<std::thread> threads;
+    const Count helperCount = Math::Min(threadCount, funcCount) - 1;
+    for (Index i = 0; i < helperCount; ++i)
+        threads.emplace_back(worker);
+    worker();
+    for (auto& thread : threads)
+        thread.join();
+
+    for (Index i = 0; i < funcCount; ++i)
+    {
+        SLANG_ASSERT(!m_mapInstToAnalysis.containsKey(funcs[i]));
+        m_mapInstToAnalysis[funcs[i]].domTree = domTrees[i];
+    }
+}
+
 void addGlobalValue(IRBuilder* builder, IRInst* value)
 {
     // Try to find a suitable parent for the
@@ -7651,7 +7773,9 @@ static void _maybeHoistOperand(IRUse* use)
     }
 }
 
-static void _replaceInstUsesWith(IRInst* thisInst, IRInst* other)
+// Replace all the uses of each `key` with its `value`. The work list and deduplication state
+// are shared by all the replacements, so that a batch of them costs one sweep.
+static void _replaceInstUsesWith(ArrayView<KeyValuePair<IRInst*, IRInst*>> replacements)
 {
     IRDeduplicationContext* dedupContext = nullptr;
 
@@ -7677,13 +7801,14 @@ static void _replaceInstUsesWith(IRInst* thisInst, IRInst* other)
         }
     };
 
-    addToWorkList(thisInst, other);
+    for (auto& replacement : replacements)
+        addToWorkList(replacement.key, replacement.value);
 
     for (Index i = 0; i < workList.getCount(); i++)
     {
         auto workItem = workList[i];
-        thisInst = workItem.thisInst;
-        other = workItem.otherInst;
+        auto thisInst = workItem.thisInst;
+        auto other = workItem.otherInst;
 
         SLANG_ASSERT(other);
 
@@ -7732,6 +7857,9 @@ static void _replaceInstUsesWith(IRInst* thisInst, IRInst* other)
 
             // Swap this use over to use the other value.
             uu->usedValue = other;
+#ifdef _DEBUG
+            IRUse::s_debugCounters.replaceCount++;
+#endif
 
             // If `other` is hoistable, then we need to make sure `other` is hoisted
             // to a point before `user`, if it is not already so.
@@ -7793,6 +7921,9 @@ static void _replaceInstUsesWith(IRInst* thisInst, IRInst* other)
 
         // And `this` will have no uses any more.
         thisInst->firstUse = nullptr;
+#ifdef _DEBUG
+        IRUse::s_debugCounters.spliceCount++;
+#endif
 
         ff->debugValidate();
     }
@@ -7800,7 +7931,42 @@ static void _replaceInstUsesWith(IRInst* thisInst, IRInst* other)
 
 void IRInst::replaceUsesWith(IRInst* other)
 {
-    _replaceInstUsesWith(this, other);
+    KeyValuePair<IRInst*, IRInst*> replacement(this, other);
+    _replaceInstUsesWith(makeArrayViewSingle(replacement));
+}
+
+void IRInstReplacements::add(IRInst* inst, IRInst* replacement)
+{
+    SLANG_ASSERT(inst && replacement);
+    m_replacements[inst] = replacement;
+}
+
+IRInst* IRInstReplacements::getReplacement(IRInst* inst) const
+{
+    // A chain can't be longer than the number of replacements, unless it is a cycle.
+    Index steps = 0;
+    IRInst* replacement = nullptr;
+    while (m_replacements.tryGetValue(inst, replacement) && replacement != inst)
+    {
+        inst = replacement;
+        SLANG_RELEASE_ASSERT(++steps <= m_replacements.getCount());
+    }
+    return inst;
+}
+
+void IRInstReplacements::apply()
+{
+    List<KeyValuePair<IRInst*, IRInst*>> replacements;
+    replacements.reserve(m_replacements.getCount());
+    for (const auto& [inst, replacement] : m_replacements)
+    {
+        auto finalReplacement = getReplacement(replacement);
+        if (finalReplacement != inst)
+            replacements.add(KeyValuePair<IRInst*, IRInst*>(inst, finalReplacement));
+    }
+    m_replacements.clear();
+
+    _replaceInstUsesWith(replacements.getArrayView());
 }
 
 // Insert this instruction into the same basic block
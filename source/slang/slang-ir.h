@@ -14,10 +14,13 @@
 #include "../compiler-core/slang-source-map.h"
 #include "../core/slang-basic.h"
 #include "../core/slang-memory-arena.h"
+#include "../core/slang-string-slice-pool.h"
 #include "slang-container-pool.h"
 #include "slang-type-system-shared.h"
 
+#include <atomic>
 #include <functional>
+#include <mutex>
 
 namespace Slang
 {
@@ -30,6 +33,7 @@ class Layout;
 class Type;
 class Session;
 class Name;
+class OptimizationRemarks;
 struct IRBuilder;
 struct IRFunc;
 struct IRGlobalValueWithCode;
@@ -163,6 +167,23 @@ struct IRUse
     IRUse** prevLink = nullptr;
 
     void debugValidate();
+
+#ifdef _DEBUG
+    /// Counts of the use list operations done so far, to measure how much time passes spend
+    /// maintaining use lists.
+    struct DebugCounters
+    {
+        /// Uses added to the use list of a value.
+        std::atomic<uint64_t> linkCount{0};
+        /// Uses removed from the use list of a value.
+        std::atomic<uint64_t> unlinkCount{0};
+        /// Uses moved to another value by a replacement of all the uses of a value.
+        std::atomic<uint64_t> replaceCount{0};
+        /// Whole use lists spliced onto the use list of another value.
+        std::atomic<uint64_t> spliceCount{0};
+    };
+    static DebugCounters s_debugCounters;
+#endif
 };
 
 struct IRBlock;
@@ -584,6 +605,17 @@ struct IRInst
     // Source location information for this value, if any
     SourceLoc sourceLoc;
 
+    // Reserved memory space for use by individual IR passes.
+    // This field is not supposed to be valid outside an IR pass,
+    // and each IR pass should always treat it as uninitialized
+    // upon entry.
+    //
+    // Note: This is kept to 32 bits, so that it packs together with the
+    // 32-bit fields above ahead of the pointer-sized fields that follow,
+    // rather than adding a full word (and padding) to every instruction.
+    //
+    uint32_t scratchData = 0;
+
     // Each instruction can have zero or more "decorations"
     // attached to it. A decoration is a specialized kind
     // of instruction that either attaches metadata to,
@@ -697,12 +729,6 @@ struct IRInst
     uint32_t _debugUID;
 #endif
 
-    // Reserved memory space for use by individual IR passes.
-    // This field is not supposed to be valid outside an IR pass,
-    // and each IR pass should always treat it as uninitialized
-    // upon entry.
-    UInt64 scratchData = 0;
-
     // The type of the result value of this instruction,
     // or `null` to indicate that the instruction has
     // no value.
@@ -1730,6 +1756,12 @@ struct IRTensorViewType : IRType
 {
     IRType* getElementType() { return (IRType*)getOperand(0); }
 
+    /// Is the innermost dimension of the viewed tensor known to be contiguous?
+    ///
+    /// Such a view is emitted as a `ContiguousTensorView`, which is only ever used for the
+    /// parameters of the contiguous variant of a CUDA kernel.
+    bool hasContiguousInnermostDim() { return getOperandCount() > 1; }
+
     IR_LEAF_ISA(TensorViewType)
 };
 
@@ -2336,6 +2368,27 @@ struct IRAnalysis
     IRDominatorTree* getDominatorTree();
 };
 
+/// Gives each mangled name an integer id, so that the linker can match the symbols of different
+/// modules by comparing ids rather than strings.
+///
+/// There is one pool for the process rather than one per global session, since the IR of the
+/// core module is shared by every global session. Ids are never released. Can be used from
+/// several threads at once.
+class MangledNamePool
+{
+public:
+    typedef Index Id;
+
+    /// Get the id of the name, adding it if it's new
+    Id add(UnownedStringSlice mangledName);
+
+    static MangledNamePool& getSingleton();
+
+protected:
+    std::mutex m_mutex;
+    StringSlicePool m_pool = StringSlicePool(StringSlicePool::Style::Empty);
+};
+
 struct IRModule : RefObject
 {
 public:
@@ -2369,14 +2422,63 @@ public:
         return nullptr;
     }
     IRDominatorTree* findOrCreateDominatorTree(IRGlobalValueWithCode* func);
+
+    /// Compute and cache the dominator trees of `funcs`, on up to `threadCount` threads.
+    /// The functions must not have a cached dominator tree already.
+    void createDominatorTreesInParallel(ArrayView<IRGlobalValueWithCode*> funcs, Count threadCount);
     void invalidateAnalysisForInst(IRGlobalValueWithCode* func)
     {
         m_mapInstToAnalysis.remove(func);
     }
     void invalidateAllAnalysis() { m_mapInstToAnalysis.clear(); }
 
+    /// Returns true if changes to the control flow of functions are being reported,
+    /// see `IRAnalysisTrackingScope`.
+    bool isTrackingAnalysisChanges() const { return m_analysisTrackingDepth != 0; }
+
+    /// Called by a pass before it relies on cached analyses.
+    ///
+    /// Not every pass reports the functions it changes, so outside of an
+    /// `IRAnalysisTrackingScope` all analyses are invalidated. Within one, only
+    /// the analyses of functions that were reported as changed are rebuilt.
+    void invalidateUntrackedAnalysis()
+    {
+        if (!isTrackingAnalysisChanges())
+            invalidateAllAnalysis();
+    }
+
+    void beginTrackingAnalysisChanges()
+    {
+        // Changes made before tracking started may not have been reported.
+        if (m_analysisTrackingDepth++ == 0)
+            invalidateAllAnalysis();
+    }
+    void endTrackingAnalysisChanges()
+    {
+        SLANG_ASSERT(m_analysisTrackingDepth > 0);
+        m_analysisTrackingDepth--;
+    }
+
     IRInstListBase getGlobalInsts() const { return getModuleInst()->getChildren(); }
 
+    typedef Dictionary<MangledNamePool::Id, List<IRInst*>> MangledNameIndex;
+
+    /// Get the global instructions of this module that have linkage, by the id of their mangled
+    /// name in the MangledNamePool, in the order they appear in the module.
+    ///
+    /// The index is built the first time it is requested, so that a module that is linked
+    /// many times is only scanned once. Adding or removing global values with linkage
+    /// afterwards requires a call to `invalidateMangledNameIndex`.
+    ///
+    const MangledNameIndex& getMangledNameIndex();
+
+    void invalidateMangledNameIndex();
+
+    /// Get the collector that passes run on this module report their optimization remarks to,
+    /// or null if no remarks were asked for. See `OptimizationRemarks`.
+    OptimizationRemarks* getOptimizationRemarks() const { return m_optimizationRemarks; }
+    void setOptimizationRemarks(OptimizationRemarks* remarks) { m_optimizationRemarks = remarks; }
+
     /// Create an empty instruction with the `op` opcode and space for
     /// a number of operands given by `operandCount`.
     ///
@@ -2444,6 +2546,33 @@ private:
     ComPtr<IBoxValue<SourceMap>> m_obfuscatedSourceMap;
 
     Dictionary<IRInst*, IRAnalysis> m_mapInstToAnalysis;
+
+    /// The number of open `IRAnalysisTrackingScope`s.
+    Index m_analysisTrackingDepth = 0;
+
+    /// The index returned by `getMangledNameIndex`, if it has been built. Modules such as
+    /// the core module are linked by many sessions, which may do so on different threads.
+    std::unique_ptr<MangledNameIndex> m_mangledNameIndex;
+    std::mutex m_mangledNameIndexMutex;
+
+    /// The collector returned by `getOptimizationRemarks`, owned by whoever set it.
+    OptimizationRemarks* m_optimizationRemarks = nullptr;
+};
+
+/// Within the lifetime of this scope, the passes run on `module` are ones that report
+/// every function whose control flow they change with `invalidateAnalysisForInst`,
+/// so the analyses cached for other functions stay valid and can be reused.
+struct IRAnalysisTrackingScope
+{
+    IRAnalysisTrackingScope(IRModule* module)
+        : m_module(module)
+    {
+        m_module->beginTrackingAnalysisChanges();
+    }
+    ~IRAnalysisTrackingScope() { m_module->endTrackingAnalysisChanges(); }
+
+private:
+    IRModule* m_module;
 };
 
 
@@ -2533,6 +2662,78 @@ struct InstHashSet
     void clear() { set->clear(); }
 };
 
+/// Gives instructions dense indices, in the order they are added, so that a pass can keep state
+/// for each instruction in a `List` or `UIntSet` indexed by them, rather than in a `Dictionary`
+/// or `HashSet` keyed by the instruction.
+///
+/// The index of an instruction is held in its `scratchData`, so a numbering is only valid while
+/// no other pass uses the `scratchData` of the numbered instructions. Looking up an instruction
+/// checks the index against the numbered instructions, so an instruction that wasn't numbered,
+/// such as one created afterwards, is never taken to have the index left in its `scratchData`.
+///
+/// A null instruction can be added to reserve an index.
+struct IRInstNumbering
+{
+    /// Add `inst` with the next index, and return the index
+    Index add(IRInst* inst)
+    {
+        const Index index = m_insts.getCount();
+        if (inst)
+            inst->scratchData = uint32_t(index);
+        m_insts.add(inst);
+        return index;
+    }
+
+    /// Get the index of `inst`, or -1 if it hasn't been numbered
+    Index tryGetIndex(IRInst* inst) const
+    {
+        const Index index = Index(inst->scratchData);
+        return (index < m_insts.getCount() && m_insts[index] == inst) ? index : -1;
+    }
+    Index getIndex(IRInst* inst) const
+    {
+        const Index index = tryGetIndex(inst);
+        SLANG_ASSERT(index >= 0);
+        return index;
+    }
+    bool contains(IRInst* inst) const { return tryGetIndex(inst) >= 0; }
+
+    IRInst* operator[](Index index) const { return m_insts[index]; }
+    Index getCount() const { return m_insts.getCount(); }
+    const List<IRInst*>& getInsts() const { return m_insts; }
+
+    void clear() { m_insts.clear(); }
+
+protected:
+    List<IRInst*> m_insts;
+};
+
+/// Collects replacements for instructions, so that the uses of all of them are moved onto their
+/// replacements in one sweep by `apply`, rather than by a `replaceUsesWith` for each.
+///
+/// Replacements are followed through, so when `a` is replaced by `b` and `b` by `c`, the uses of
+/// `a` are moved straight onto `c` rather than onto `b` and then again onto `c`.
+struct IRInstReplacements
+{
+    /// Add a replacement of `inst` by `replacement`, overriding any earlier one for `inst`
+    void add(IRInst* inst, IRInst* replacement);
+
+    /// Get what `inst` is replaced by once replacements are followed through, or `inst` itself
+    /// if it isn't replaced
+    IRInst* getReplacement(IRInst* inst) const;
+
+    Index getCount() const { return m_replacements.getCount(); }
+
+    /// Move the uses of every instruction added onto its replacement, and clear the
+    /// replacements. The instructions themselves are left in place with no uses.
+    void apply();
+
+    void clear() { m_replacements.clear(); }
+
+protected:
+    Dictionary<IRInst*, IRInst*> m_replacements;
+};
+
 
 struct IRSpecializationDictionaryItem : public IRInst
 {
@@ -137,6 +137,46 @@ bool isDeclKeyword(const UnownedStringSlice& slice)
     return false;
 }
 
+// Returns true if a candidate named `label` can be shown for the typed `prefix`. Clients filter
+// the list further with their own fuzzy matching, which always needs the typed characters to
+// appear in order in the label, so candidates without them can be dropped before sending the
+// list.
+static bool _matchesTypedPrefix(UnownedStringSlice label, UnownedStringSlice prefix)
+{
+    Index labelIndex = 0;
+    for (auto ch : prefix)
+    {
+        const char lowerCh = CharUtil::toLower(ch);
+        while (labelIndex < label.getLength() && CharUtil::toLower(label[labelIndex]) != lowerCh)
+            labelIndex++;
+        if (labelIndex == label.getLength())
+            return false;
+        labelIndex++;
+    }
+    return true;
+}
+
+// The number of candidates up to which a list is always sent in full. Clients filter short lists
+// quickly themselves, and a complete list doesn't need to be requested again on each keystroke.
+static const Index kMaxUnfilteredCompletionCandidateCount = 256;
+
+void filterCompletionCandidates(CompletionResult& result, UnownedStringSlice typedPrefix)
+{
+    if (typedPrefix.getLength() == 0 ||
+        result.items.getCount() <= kMaxUnfilteredCompletionCandidateCount)
+    {
+        return;
+    }
+    List<LanguageServerProtocol::CompletionItem> items;
+    for (auto& item : result.items)
+    {
+        if (_matchesTypedPrefix(item.label.getUnownedSlice(), typedPrefix))
+            items.add(item);
+    }
+    result.items = _Move(items);
+    result.isIncomplete = true;
+}
+
 LanguageServerResult<CompletionResult> CompletionContext::tryCompleteHLSLSemantic()
 {
     if (version->linkage->contentAssistInfo.completionSuggestions.scopeKind !=
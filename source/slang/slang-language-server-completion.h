@@ -20,6 +20,8 @@ struct CompletionResult
 {
     List<LanguageServerProtocol::CompletionItem> items;
     List<LanguageServerProtocol::TextEditCompletionItem> textEditItems;
+    // Some candidates were left out, so the client must ask again as the user keeps typing.
+    bool isIncomplete = false;
     CompletionResult() = default;
     CompletionResult(List<LanguageServerProtocol::CompletionItem>&& other)
         : items(_Move(other))
@@ -70,4 +72,8 @@ struct CompletionContext
         char closingChar);
 };
 
+// Leave out the candidates of a long list that can't match the part of the identifier at the
+// cursor that is already typed, and mark the list incomplete if any filtering was done.
+void filterCompletionCandidates(CompletionResult& result, UnownedStringSlice typedPrefix);
+
 } // namespace Slang
@@ -10,7 +10,7 @@ struct GetDocumentSymbolContext
     UnownedStringSlice fileName;
 };
 
-static LanguageServerProtocol::SymbolKind _getSymbolKind(Decl* decl)
+LanguageServerProtocol::SymbolKind getDeclSymbolKind(Decl* decl)
 {
     if (as<StructDecl>(decl))
     {
@@ -140,7 +140,7 @@ static void _getDocumentSymbolsImpl(
         {
             child = genericDecl->inner;
         }
-        LanguageServerProtocol::SymbolKind kind = _getSymbolKind(child);
+        LanguageServerProtocol::SymbolKind kind = getDeclSymbolKind(child);
         if (kind <= 0)
             continue;
         NameLoc nameLoc = _getDeclNameLoc(child);
@@ -9,6 +9,9 @@
 
 namespace Slang
 {
+/// Get the kind of symbol that `decl` is shown as, or -1 if it isn't shown as a symbol.
+LanguageServerProtocol::SymbolKind getDeclSymbolKind(Decl* decl);
+
 List<LanguageServerProtocol::DocumentSymbol> getDocumentSymbols(
     Linkage* linkage,
     Module* module,
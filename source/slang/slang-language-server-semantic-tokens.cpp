@@ -398,4 +398,54 @@ List<uint32_t> getEncodedTokens(List<SemanticToken>& tokens)
     return result;
 }
 
+List<SemanticToken> getDecodedTokens(const List<uint32_t>& data)
+{
+    List<SemanticToken> tokens;
+    int line = 0;
+    int col = 0;
+    for (Index i = 0; i + 4 < data.getCount(); i += 5)
+    {
+        if (data[i] != 0)
+            col = 0;
+        line += (int)data[i];
+        col += (int)data[i + 1];
+        SemanticToken token;
+        token.line = line;
+        token.col = col;
+        token.length = (int)data[i + 2];
+        token.type = (SemanticTokenType)data[i + 3];
+        tokens.add(token);
+    }
+    return tokens;
+}
+
+List<LanguageServerProtocol::SemanticTokensEdit> getEncodedTokenEdits(
+    const List<uint32_t>& oldData,
+    const List<uint32_t>& newData)
+{
+    // An edit usually changes the tokens of a few lines, so a single edit that replaces
+    // everything between the longest common prefix and suffix is small.
+    Index prefixLength = 0;
+    Index maxLength = Math::Min(oldData.getCount(), newData.getCount());
+    while (prefixLength < maxLength && oldData[prefixLength] == newData[prefixLength])
+        prefixLength++;
+    Index suffixLength = 0;
+    while (suffixLength < maxLength - prefixLength &&
+           oldData[oldData.getCount() - 1 - suffixLength] ==
+               newData[newData.getCount() - 1 - suffixLength])
+        suffixLength++;
+
+    List<LanguageServerProtocol::SemanticTokensEdit> edits;
+    if (prefixLength == oldData.getCount() && prefixLength == newData.getCount())
+        return edits;
+    LanguageServerProtocol::SemanticTokensEdit edit;
+    edit.start = (uint32_t)prefixLength;
+    edit.deleteCount = (uint32_t)(oldData.getCount() - prefixLength - suffixLength);
+    edit.data.addRange(
+        newData.getBuffer() + prefixLength,
+        newData.getCount() - prefixLength - suffixLength);
+    edits.add(edit);
+    return edits;
+}
+
 } // namespace Slang
@@ -46,5 +46,19 @@ List<SemanticToken> getSemanticTokens(
     UnownedStringSlice fileName,
     DocumentVersion* doc);
 List<uint32_t> getEncodedTokens(List<SemanticToken>& tokens);
+List<SemanticToken> getDecodedTokens(const List<uint32_t>& data);
+
+/// Get the edits that turn the encoded tokens `oldData` into `newData`.
+List<LanguageServerProtocol::SemanticTokensEdit> getEncodedTokenEdits(
+    const List<uint32_t>& oldData,
+    const List<uint32_t>& newData);
+
+struct SemanticTokensDeltaResult
+{
+    // Are the tokens sent as edits of the previous result the client has?
+    bool isDelta = false;
+    LanguageServerProtocol::SemanticTokens tokens;
+    LanguageServerProtocol::SemanticTokensDelta delta;
+};
 
 } // namespace Slang
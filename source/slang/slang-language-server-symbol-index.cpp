@@ -0,0 +1,190 @@
+#include "slang-language-server-symbol-index.h"
+
+#include "../core/slang-io.h"
+#include "../core/slang-stable-hash.h"
+#include "../core/slang-string-util.h"
+#include "slang-language-server-document-symbols.h"
+
+namespace Slang
+{
+static const char kSymbolIndexFileHeader[] = "slang-symbol-index 1";
+
+static String _getCanonicalPath(SourceFile* sourceFile)
+{
+    const auto& foundPath = sourceFile->getPathInfo().foundPath;
+    String canonicalPath;
+    if (foundPath.getLength() && SLANG_SUCCEEDED(Path::getCanonical(foundPath, canonicalPath)))
+        return canonicalPath;
+    return String();
+}
+
+static void _collectSymbols(
+    SourceManager* sourceManager,
+    ContainerDecl* containerDecl,
+    Dictionary<SourceFile*, List<WorkspaceSymbolIndex::Symbol>>& symbolsPerFile)
+{
+    for (auto member : containerDecl->members)
+    {
+        Decl* decl = member;
+        if (auto genericDecl = as<GenericDecl>(decl))
+            decl = genericDecl->inner;
+        if (decl->hasModifier<SynthesizedModifier>() ||
+            decl->hasModifier<ToBeSynthesizedModifier>())
+            continue;
+
+        // The members of aggregate types, namespaces and extensions are symbols too, but
+        // parameters and locals of functions aren't.
+        if (auto childContainerDecl = as<ContainerDecl>(decl))
+        {
+            if (!as<CallableDecl>(decl))
+                _collectSymbols(sourceManager, childContainerDecl, symbolsPerFile);
+        }
+        if (as<ExtensionDecl>(decl))
+            continue;
+
+        auto kind = getDeclSymbolKind(decl);
+        if (kind <= 0)
+            continue;
+        auto nameLoc = decl->nameAndLoc;
+        if (!nameLoc.name || nameLoc.name->text.getLength() == 0 || !nameLoc.loc.isValid())
+            continue;
+        auto sourceView = sourceManager->findSourceViewRecursively(nameLoc.loc);
+        if (!sourceView)
+            continue;
+        auto humaneLoc = sourceView->getHumaneLoc(nameLoc.loc, SourceLocType::Actual);
+        if (humaneLoc.line == 0)
+            continue;
+
+        WorkspaceSymbolIndex::Symbol symbol;
+        symbol.name = nameLoc.name->text;
+        symbol.kind = kind;
+        symbol.line = humaneLoc.line;
+        symbol.column = humaneLoc.column;
+        symbolsPerFile.getOrAddValue(sourceView->getSourceFile(), {}).add(symbol);
+    }
+}
+
+void WorkspaceSymbolIndex::addModule(Linkage* linkage, Module* module)
+{
+    auto moduleDecl = module->getModuleDecl();
+    if (!moduleDecl)
+        return;
+    auto sourceManager = linkage->getSourceManager();
+
+    Dictionary<SourceFile*, List<Symbol>> symbolsPerFile;
+    // The symbols of the file the module was parsed from are replaced even if it has none.
+    if (auto sourceView = sourceManager->findSourceViewRecursively(moduleDecl->loc))
+        symbolsPerFile.getOrAddValue(sourceView->getSourceFile(), {});
+    _collectSymbols(sourceManager, moduleDecl, symbolsPerFile);
+
+    for (auto& [sourceFile, symbols] : symbolsPerFile)
+    {
+        auto path = _getCanonicalPath(sourceFile);
+        if (path.getLength() == 0)
+            continue;
+        auto content = sourceFile->getContent();
+        StringBuilder contentHash;
+        contentHash << getStableHashCode64(content.begin(), content.getLength()).hash;
+
+        auto& fileSymbols = m_files.getOrAddValue(path, FileSymbols());
+        if (fileSymbols.contentHash == contentHash.getUnownedSlice())
+            continue;
+        fileSymbols.contentHash = contentHash.produceString();
+        fileSymbols.symbols = _Move(symbols);
+        m_isDirty = true;
+    }
+}
+
+void WorkspaceSymbolIndex::findSymbols(
+    UnownedStringSlice name,
+    bool exactMatch,
+    Index maxCount,
+    List<SymbolLocation>& outSymbols)
+{
+    String lowerName = String(name).toLower();
+    for (const auto& [path, fileSymbols] : m_files)
+    {
+        for (const auto& symbol : fileSymbols.symbols)
+        {
+            bool isMatch = exactMatch
+                               ? symbol.name == name
+                               : symbol.name.toLower().indexOf(lowerName.getUnownedSlice()) != -1;
+            if (!isMatch)
+                continue;
+            outSymbols.add(SymbolLocation{path, &symbol});
+            if (outSymbols.getCount() >= maxCount)
+                return;
+        }
+    }
+}
+
+SlangResult WorkspaceSymbolIndex::loadFromFile(const String& filePath)
+{
+    String text;
+    SLANG_RETURN_ON_FAIL(File::readAllText(filePath, text));
+    List<UnownedStringSlice> lines;
+    StringUtil::calcLines(text.getUnownedSlice(), lines);
+    if (lines.getCount() == 0 || lines[0] != UnownedStringSlice(kSymbolIndexFileHeader))
+        return SLANG_FAIL;
+
+    // Each file starts with a `file` line that has its content hash and path, followed by a
+    // line with the kind, line, column and name of each of its symbols.
+    Dictionary<String, FileSymbols> files;
+    FileSymbols* currentFile = nullptr;
+    List<UnownedStringSlice> fields;
+    for (Index i = 1; i < lines.getCount(); i++)
+    {
+        if (lines[i].getLength() == 0)
+            continue;
+        fields.clear();
+        StringUtil::split(lines[i], '\t', fields);
+        if (fields.getCount() == 3 && fields[0] == toSlice("file"))
+        {
+            currentFile = &files.getOrAddValue(fields[2], FileSymbols());
+            currentFile->contentHash = fields[1];
+            continue;
+        }
+        Int kind = 0, line = 0, column = 0;
+        if (!currentFile || fields.getCount() != 4 ||
+            SLANG_FAILED(StringUtil::parseInt(fields[0], kind)) ||
+            SLANG_FAILED(StringUtil::parseInt(fields[1], line)) ||
+            SLANG_FAILED(StringUtil::parseInt(fields[2], column)))
+        {
+            return SLANG_FAIL;
+        }
+        Symbol symbol;
+        symbol.kind = LanguageServerProtocol::SymbolKind(kind);
+        symbol.line = line;
+        symbol.column = column;
+        symbol.name = fields[3];
+        currentFile->symbols.add(symbol);
+    }
+
+    // Files that were indexed since the language server started are newer than the saved
+    // index.
+    for (auto& [path, fileSymbols] : files)
+    {
+        if (!m_files.containsKey(path))
+            m_files[path] = _Move(fileSymbols);
+    }
+    return SLANG_OK;
+}
+
+SlangResult WorkspaceSymbolIndex::saveToFile(const String& filePath)
+{
+    StringBuilder sb;
+    sb << kSymbolIndexFileHeader << "\n";
+    for (const auto& [path, fileSymbols] : m_files)
+    {
+        sb << "file\t" << fileSymbols.contentHash << "\t" << path << "\n";
+        for (const auto& symbol : fileSymbols.symbols)
+        {
+            sb << Int32(symbol.kind) << "\t" << Int64(symbol.line) << "\t" << Int64(symbol.column)
+               << "\t" << symbol.name << "\n";
+        }
+    }
+    SLANG_RETURN_ON_FAIL(File::writeAllTextIfChanged(filePath, sb.getUnownedSlice()));
+    m_isDirty = false;
+    return SLANG_OK;
+}
+} // namespace Slang
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "../compiler-core/slang-language-server-protocol.h"
+#include "../core/slang-basic.h"
+#include "slang-compiler.h"
+
+namespace Slang
+{
+/// An index of the declarations in the files of a workspace, by name.
+///
+/// The index is filled in from the modules the language server checks, and can be saved to
+/// and loaded from a file, so that it can answer navigation requests right after the language
+/// server starts, before any module has been checked.
+class WorkspaceSymbolIndex : public RefObject
+{
+public:
+    struct Symbol
+    {
+        String name;
+        LanguageServerProtocol::SymbolKind kind = 0;
+        // 1-based line and UTF-8 column of the name of the declaration.
+        Index line = 0;
+        Index column = 0;
+    };
+
+    struct SymbolLocation
+    {
+        String path;
+        const Symbol* symbol = nullptr;
+    };
+
+    /// Add the declarations of `module` to the index, replacing those of the files it was
+    /// parsed from.
+    void addModule(Linkage* linkage, Module* module);
+
+    /// Find the symbols whose name is `name`, or contains `name` ignoring case if `exactMatch`
+    /// is false. Stops after `maxCount` symbols.
+    void findSymbols(
+        UnownedStringSlice name,
+        bool exactMatch,
+        Index maxCount,
+        List<SymbolLocation>& outSymbols);
+
+    /// Has the index changed since it was last loaded or saved?
+    bool isDirty() { return m_isDirty; }
+
+    SlangResult loadFromFile(const String& filePath);
+    SlangResult saveToFile(const String& filePath);
+
+private:
+    struct FileSymbols
+    {
+        // A hash of the contents of the file the symbols were found in.
+        String contentHash;
+        List<Symbol> symbols;
+    };
+
+    Dictionary<String, FileSymbols> m_files;
+    bool m_isDirty = false;
+};
+} // namespace Slang
@@ -138,6 +138,7 @@ SlangResult LanguageServer::parseNextMessage()
                     caps.hoverProvider = true;
                     caps.definitionProvider = true;
                     caps.documentSymbolProvider = true;
+                    caps.workspaceSymbolProvider = true;
                     caps.inlayHintProvider.resolveProvider = false;
                     caps.documentFormattingProvider = true;
                     caps.documentOnTypeFormattingProvider.firstTriggerCharacter = "}";
@@ -155,8 +156,8 @@ SlangResult LanguageServer::parseNextMessage()
                     caps.completionProvider.triggerCharacters.add("/");
                     caps.completionProvider.resolveProvider = true;
                     caps.completionProvider.workDoneToken = "";
-                    caps.semanticTokensProvider.full = true;
-                    caps.semanticTokensProvider.range = false;
+                    caps.semanticTokensProvider.full.delta = true;
+                    caps.semanticTokensProvider.range = true;
                     caps.signatureHelpProvider.triggerCharacters.add("(");
                     caps.signatureHelpProvider.triggerCharacters.add(",");
                     caps.signatureHelpProvider.retriggerCharacters.add(",");
@@ -208,7 +209,7 @@ SlangResult LanguageServer::parseNextMessage()
                 if (response.result.getKind() == JSONValue::Kind::Array)
                 {
                     auto arr = m_connection->getContainer()->getArray(response.result);
-                    if (arr.getCount() == 12)
+                    if (arr.getCount() == 13)
                     {
                         updatePredefinedMacros(arr[0]);
                         updateSearchPaths(arr[1]);
@@ -217,6 +218,7 @@ SlangResult LanguageServer::parseNextMessage()
                         updateFormattingOptions(arr[4], arr[5], arr[6], arr[7], arr[8]);
                         updateInlayHintOptions(arr[9], arr[10]);
                         updateTraceOptions(arr[11]);
+                        updateSymbolIndexCacheDirectory(arr[12]);
                     }
                 }
                 break;
@@ -966,6 +968,7 @@ LanguageServerResult<List<LanguageServerProtocol::Location>> LanguageServerCore:
     {
         SLANG_LS_RETURN_ON_SUCCESS(tryGotoMacroDefinition(version, doc, line, col));
         SLANG_LS_RETURN_ON_SUCCESS(tryGotoFileInclude(version, doc, line));
+        SLANG_LS_RETURN_ON_SUCCESS(tryGotoIndexedSymbol(doc, line, col));
         return std::nullopt;
     }
     struct LocationResult
@@ -1088,6 +1091,13 @@ SlangResult LanguageServer::completion(
     auto result = m_core.completion(args);
     if (SLANG_FAILED(result.returnCode) || result.isNull)
         m_connection->sendResult(NullResponse::get(), responseId);
+    else if (result.result.isIncomplete)
+    {
+        LanguageServerProtocol::CompletionList list;
+        list.isIncomplete = true;
+        list.items = _Move(result.result.items);
+        m_connection->sendResult(&list, responseId);
+    }
     else if (result.result.items.getCount())
         m_connection->sendResult(&result.result.items, responseId);
     else
@@ -1138,6 +1148,7 @@ LanguageServerResult<CompletionResult> LanguageServerCore::completion(
     {
         return std::nullopt;
     }
+    const auto typedEndOffset = cursorOffset;
 
     // Ajust cursor position to the beginning of the current/last identifier.
     cursorOffset--;
@@ -1153,6 +1164,42 @@ LanguageServerResult<CompletionResult> LanguageServerCore::completion(
         return std::nullopt;
     }
 
+    auto commitCharacterBehavior = m_commitCharacterBehavior;
+    if (args.context.triggerKind == kCompletionTriggerKindTriggerCharacter &&
+        (args.context.triggerCharacter == " " || args.context.triggerCharacter == "[" ||
+         args.context.triggerCharacter == "("))
+    {
+        // Never use commit character if completion request is triggerred by these characters to
+        // prevent annoyance.
+        commitCharacterBehavior = CommitCharacterBehavior::Disabled;
+    }
+
+    // The candidates only depend on the text around the identifier at the cursor, so the ones
+    // found before can be filtered again by the typed prefix as long as nothing else changed.
+    auto docText = doc->getText().getUnownedSlice();
+    String typedPrefix =
+        docText.subString(cursorOffset + 1, Math::Max(Index(0), typedEndOffset - cursorOffset - 1));
+    StringBuilder textBuilder;
+    textBuilder << docText.head(cursorOffset + 1)
+                << docText.tail(cursorOffset + 1 + typedPrefix.getLength());
+    String textWithoutTypedPrefix = textBuilder.produceString();
+    String triggerCharacter;
+    if (args.context.triggerKind == kCompletionTriggerKindTriggerCharacter)
+        triggerCharacter = args.context.triggerCharacter;
+    auto workspaceChangeCount = m_workspace->getChangeCountExcludingDocument(canonicalPath);
+    auto& cache = m_completionCandidateCache;
+    if (cache.version && cache.version.Ptr() == m_workspace->getCurrentCompletionVersion() &&
+        cache.documentPath == canonicalPath && cache.identifierStartOffset == cursorOffset &&
+        cache.workspaceChangeCount == workspaceChangeCount &&
+        cache.triggerCharacter == triggerCharacter &&
+        cache.commitCharacterBehavior == commitCharacterBehavior &&
+        cache.textWithoutTypedPrefix == textWithoutTypedPrefix)
+    {
+        CompletionResult result = cache.result;
+        filterCompletionCandidates(result, typedPrefix.getUnownedSlice());
+        return result;
+    }
+
     // Always create a new workspace version for the completion request since we
     // will use a modified source.
     auto version = m_workspace->createVersionForCompletion();
@@ -1169,15 +1216,7 @@ LanguageServerResult<CompletionResult> LanguageServerCore::completion(
     context.canonicalPath = canonicalPath.getUnownedSlice();
     context.line = utf8Line;
     context.col = utf8Col;
-    context.commitCharacterBehavior = m_commitCharacterBehavior;
-    if (args.context.triggerKind == kCompletionTriggerKindTriggerCharacter &&
-        (args.context.triggerCharacter == " " || args.context.triggerCharacter == "[" ||
-         args.context.triggerCharacter == "("))
-    {
-        // Never use commit character if completion request is triggerred by these characters to
-        // prevent annoyance.
-        context.commitCharacterBehavior = CommitCharacterBehavior::Disabled;
-    }
+    context.commitCharacterBehavior = commitCharacterBehavior;
 
     SLANG_LS_RETURN_ON_SUCCESS(context.tryCompleteInclude());
     SLANG_LS_RETURN_ON_SUCCESS(context.tryCompleteImport());
@@ -1190,7 +1229,6 @@ LanguageServerResult<CompletionResult> LanguageServerCore::completion(
         return std::nullopt;
     }
 
-
     // Insert a completion request token at cursor position.
     auto originalText = doc->getText();
     StringBuilder newText;
@@ -1217,8 +1255,20 @@ LanguageServerResult<CompletionResult> LanguageServerCore::completion(
     }
 
     SLANG_LS_RETURN_ON_SUCCESS(context.tryCompleteHLSLSemantic());
-    SLANG_LS_RETURN_ON_SUCCESS(context.tryCompleteMemberAndSymbol());
-    return std::nullopt;
+
+    auto memberAndSymbolResult = context.tryCompleteMemberAndSymbol();
+    if (memberAndSymbolResult.returnCode != SLANG_OK || memberAndSymbolResult.isNull)
+        return std::nullopt;
+    cache.documentPath = canonicalPath;
+    cache.textWithoutTypedPrefix = textWithoutTypedPrefix;
+    cache.identifierStartOffset = cursorOffset;
+    cache.workspaceChangeCount = workspaceChangeCount;
+    cache.triggerCharacter = triggerCharacter;
+    cache.commitCharacterBehavior = context.commitCharacterBehavior;
+    cache.version = version;
+    cache.result = memberAndSymbolResult.result;
+    filterCompletionCandidates(memberAndSymbolResult.result, typedPrefix.getUnownedSlice());
+    return memberAndSymbolResult;
 }
 
 SlangResult LanguageServer::completionResolve(
@@ -1284,24 +1334,63 @@ SlangResult LanguageServer::semanticTokens(
     return SLANG_OK;
 }
 
-LanguageServerResult<LanguageServerProtocol::SemanticTokens> LanguageServerCore::semanticTokens(
-    const LanguageServerProtocol::SemanticTokensParams& args)
+SlangResult LanguageServer::semanticTokensRange(
+    const LanguageServerProtocol::SemanticTokensRangeParams& args,
+    const JSONValue& responseId)
 {
-    String canonicalPath = uriToCanonicalPath(args.textDocument.uri);
+    auto result = m_core.semanticTokensRange(args);
+    if (SLANG_FAILED(result.returnCode) || result.isNull)
+    {
+        m_connection->sendResult(NullResponse::get(), responseId);
+        return SLANG_OK;
+    }
+    m_connection->sendResult(&result.result, responseId);
+    return SLANG_OK;
+}
+
+SlangResult LanguageServer::semanticTokensDelta(
+    const LanguageServerProtocol::SemanticTokensDeltaParams& args,
+    const JSONValue& responseId)
+{
+    auto result = m_core.semanticTokensDelta(args);
+    if (SLANG_FAILED(result.returnCode) || result.isNull)
+    {
+        m_connection->sendResult(NullResponse::get(), responseId);
+        return SLANG_OK;
+    }
+    if (result.result.isDelta)
+        m_connection->sendResult(&result.result.delta, responseId);
+    else
+        m_connection->sendResult(&result.result.tokens, responseId);
+    return SLANG_OK;
+}
+
+SlangResult LanguageServerCore::getEncodedSemanticTokens(
+    const String& uri,
+    List<uint32_t>& outData)
+{
+    String canonicalPath = uriToCanonicalPath(uri);
 
     RefPtr<DocumentVersion> doc;
     if (!m_workspace->openedDocuments.tryGetValue(canonicalPath, doc))
     {
-        return std::nullopt;
+        return SLANG_FAIL;
     }
 
+    // Full, delta and range requests for the same version of the workspace share the tokens.
     auto version = m_workspace->getCurrentVersion();
+    if (auto cachedData = version->encodedSemanticTokens.tryGetValue(canonicalPath))
+    {
+        outData = *cachedData;
+        return SLANG_OK;
+    }
+
     SLANG_AST_BUILDER_RAII(version->linkage->getASTBuilder());
 
     Module* parsedModule = version->getOrLoadModule(canonicalPath);
     if (!parsedModule)
     {
-        return std::nullopt;
+        return SLANG_FAIL;
     }
 
     auto tokens = getSemanticTokens(
@@ -1323,12 +1412,77 @@ LanguageServerResult<LanguageServerProtocol::SemanticTokens> LanguageServerCore:
         token.col = (int)col;
         token.length = (int)(colEnd - col);
     }
+    outData = getEncodedTokens(tokens);
+    version->encodedSemanticTokens[canonicalPath] = outData;
+    return SLANG_OK;
+}
+
+String LanguageServerCore::sendSemanticTokens(const String& uri, const List<uint32_t>& data)
+{
+    SentSemanticTokens sent;
+    sent.resultId = String(++m_semanticTokensResultIdCounter);
+    sent.data = data;
+    auto resultId = sent.resultId;
+    m_sentSemanticTokens[uriToCanonicalPath(uri)] = _Move(sent);
+    return resultId;
+}
+
+LanguageServerResult<LanguageServerProtocol::SemanticTokens> LanguageServerCore::semanticTokens(
+    const LanguageServerProtocol::SemanticTokensParams& args)
+{
     SemanticTokens response;
-    response.resultId = "";
-    response.data = getEncodedTokens(tokens);
+    if (SLANG_FAILED(getEncodedSemanticTokens(args.textDocument.uri, response.data)))
+    {
+        return std::nullopt;
+    }
+    response.resultId = sendSemanticTokens(args.textDocument.uri, response.data);
     return response;
 }
 
+LanguageServerResult<LanguageServerProtocol::SemanticTokens> LanguageServerCore::
+    semanticTokensRange(const LanguageServerProtocol::SemanticTokensRangeParams& args)
+{
+    List<uint32_t> data;
+    if (SLANG_FAILED(getEncodedSemanticTokens(args.textDocument.uri, data)))
+    {
+        return std::nullopt;
+    }
+    List<SemanticToken> tokensInRange;
+    for (auto& token : getDecodedTokens(data))
+    {
+        if (token.line >= args.range.start.line && token.line <= args.range.end.line)
+            tokensInRange.add(token);
+    }
+    SemanticTokens response;
+    response.data = getEncodedTokens(tokensInRange);
+    return response;
+}
+
+LanguageServerResult<SemanticTokensDeltaResult> LanguageServerCore::semanticTokensDelta(
+    const LanguageServerProtocol::SemanticTokensDeltaParams& args)
+{
+    List<uint32_t> data;
+    if (SLANG_FAILED(getEncodedSemanticTokens(args.textDocument.uri, data)))
+    {
+        return std::nullopt;
+    }
+    SemanticTokensDeltaResult result;
+    auto sent = m_sentSemanticTokens.tryGetValue(uriToCanonicalPath(args.textDocument.uri));
+    if (sent && sent->resultId == args.previousResultId)
+    {
+        result.isDelta = true;
+        result.delta.edits = getEncodedTokenEdits(sent->data, data);
+        result.delta.resultId = sendSemanticTokens(args.textDocument.uri, data);
+    }
+    else
+    {
+        // The client's previous result isn't known, so send all the tokens.
+        result.tokens.resultId = sendSemanticTokens(args.textDocument.uri, data);
+        result.tokens.data = _Move(data);
+    }
+    return result;
+}
+
 String LanguageServerCore::getExprDeclSignature(
     Expr* expr,
     String* outDocumentation,
@@ -2002,6 +2156,20 @@ void LanguageServer::updateSearchPaths(const JSONValue& value)
     }
 }
 
+void LanguageServer::updateSymbolIndexCacheDirectory(const JSONValue& value)
+{
+    if (value.isValid())
+    {
+        auto container = m_connection->getContainer();
+        JSONToNativeConverter converter(container, &m_typeMap, m_connection->getSink());
+        String directory;
+        if (SLANG_SUCCEEDED(converter.convert(value, &directory)))
+        {
+            m_core.m_workspace->setSymbolIndexCacheDirectory(directory);
+        }
+    }
+}
+
 void LanguageServer::updateSearchInWorkspace(const JSONValue& value)
 {
     if (value.isValid())
@@ -2139,6 +2307,8 @@ void LanguageServer::sendConfigRequest()
     args.items.add(item);
     item.section = "slangLanguageServer.trace.server";
     args.items.add(item);
+    item.section = "slang.symbolIndexCacheDirectory";
+    args.items.add(item);
     m_connection->sendCall(
         ConfigurationParams::methodName,
         &args,
@@ -2288,6 +2458,98 @@ LanguageServerResult<List<Location>> LanguageServerCore::tryGotoFileInclude(
     return SLANG_FAIL;
 }
 
+// The most symbols returned from the symbol index for a single request.
+static const Index kMaxIndexedSymbolResultCount = 1000;
+
+static Location _getIndexedSymbolLocation(
+    Workspace* workspace,
+    const WorkspaceSymbolIndex::SymbolLocation& symbolLocation)
+{
+    auto symbol = symbolLocation.symbol;
+    Location result;
+    result.uri = URI::fromLocalFilePath(symbolLocation.path.getUnownedSlice()).uri;
+    RefPtr<DocumentVersion> doc;
+    if (workspace->openedDocuments.tryGetValue(symbolLocation.path, doc))
+    {
+        doc->oneBasedUTF8LocToZeroBasedUTF16Loc(
+            symbol->line,
+            symbol->column,
+            result.range.start.line,
+            result.range.start.character);
+    }
+    else
+    {
+        result.range.start.line = int(symbol->line - 1);
+        result.range.start.character = int(symbol->column - 1);
+    }
+    result.range.end = result.range.start;
+    result.range.end.character +=
+        (int)UTF8Util::calcUTF16CharCount(symbol->name.getUnownedSlice());
+    return result;
+}
+
+LanguageServerResult<List<Location>> LanguageServerCore::tryGotoIndexedSymbol(
+    DocumentVersion* doc,
+    Index line,
+    Index col)
+{
+    // The checked AST has no declaration for the name under the cursor, for example because
+    // the code around it has errors, so fall back to the declarations with that name.
+    Index offset = 0;
+    auto identifier = doc->peekIdentifier(line, col, offset);
+    if (identifier.getLength() == 0)
+        return SLANG_FAIL;
+    List<WorkspaceSymbolIndex::SymbolLocation> symbols;
+    m_workspace->getSymbolIndex()->findSymbols(
+        identifier,
+        true,
+        kMaxIndexedSymbolResultCount,
+        symbols);
+    if (symbols.getCount() == 0)
+        return SLANG_FAIL;
+    List<Location> results;
+    for (auto& symbol : symbols)
+        results.add(_getIndexedSymbolLocation(m_workspace, symbol));
+    return results;
+}
+
+SlangResult LanguageServer::workspaceSymbol(
+    const LanguageServerProtocol::WorkspaceSymbolParams& args,
+    const JSONValue& responseId)
+{
+    auto result = m_core.workspaceSymbol(args);
+    if (SLANG_FAILED(result.returnCode) || result.isNull)
+    {
+        m_connection->sendResult(NullResponse::get(), responseId);
+        return SLANG_OK;
+    }
+    m_connection->sendResult(&result.result, responseId);
+    return SLANG_OK;
+}
+
+LanguageServerResult<List<LanguageServerProtocol::SymbolInformation>> LanguageServerCore::
+    workspaceSymbol(const LanguageServerProtocol::WorkspaceSymbolParams& args)
+{
+    // This is answered from the symbol index alone, without checking any module, so that it
+    // works right after the language server starts.
+    List<WorkspaceSymbolIndex::SymbolLocation> symbols;
+    m_workspace->getSymbolIndex()->findSymbols(
+        args.query.getUnownedSlice(),
+        false,
+        kMaxIndexedSymbolResultCount,
+        symbols);
+    List<SymbolInformation> results;
+    for (auto& symbol : symbols)
+    {
+        SymbolInformation info;
+        info.name = symbol.symbol->name;
+        info.kind = symbol.symbol->kind;
+        info.location = _getIndexedSymbolLocation(m_workspace, symbol);
+        results.add(info);
+    }
+    return results;
+}
+
 SlangResult LanguageServer::queueJSONCall(JSONRPCCall call)
 {
     Command cmd;
@@ -2304,30 +2566,35 @@ SlangResult LanguageServer::queueJSONCall(JSONRPCCall call)
         DidCloseTextDocumentParams args;
         SLANG_RETURN_ON_FAIL(m_connection->toNativeArgsOrSendError(call.params, &args, call.id));
         cmd.closeDocArgs = args;
+        cmd.documentURI = args.textDocument.uri;
     }
     else if (call.method == DidChangeTextDocumentParams::methodName)
     {
         DidChangeTextDocumentParams args;
         SLANG_RETURN_ON_FAIL(m_connection->toNativeArgsOrSendError(call.params, &args, call.id));
         cmd.changeDocArgs = args;
+        cmd.documentURI = args.textDocument.uri;
     }
     else if (call.method == HoverParams::methodName)
     {
         HoverParams args;
         SLANG_RETURN_ON_FAIL(m_connection->toNativeArgsOrSendError(call.params, &args, call.id));
         cmd.hoverArgs = args;
+        cmd.documentURI = args.textDocument.uri;
     }
     else if (call.method == DefinitionParams::methodName)
     {
         DefinitionParams args;
         SLANG_RETURN_ON_FAIL(m_connection->toNativeArgsOrSendError(call.params, &args, call.id));
         cmd.definitionArgs = args;
+        cmd.documentURI = args.textDocument.uri;
     }
     else if (call.method == CompletionParams::methodName)
     {
         CompletionParams args;
         SLANG_RETURN_ON_FAIL(m_connection->toNativeArgsOrSendError(call.params, &args, call.id));
         cmd.completionArgs = args;
+        cmd.documentURI = args.textDocument.uri;
     }
     else if (call.method == SemanticTokensParams::methodName)
     {
@@ -2338,12 +2605,28 @@ SlangResult LanguageServer::queueJSONCall(JSONRPCCall call)
             &args,
             call.id));
         cmd.semanticTokenArgs = args;
+        cmd.documentURI = args.textDocument.uri;
+    }
+    else if (call.method == SemanticTokensRangeParams::methodName)
+    {
+        SemanticTokensRangeParams args;
+        SLANG_RETURN_ON_FAIL(m_connection->toNativeArgsOrSendError(call.params, &args, call.id));
+        cmd.semanticTokenRangeArgs = args;
+        cmd.documentURI = args.textDocument.uri;
+    }
+    else if (call.method == SemanticTokensDeltaParams::methodName)
+    {
+        SemanticTokensDeltaParams args;
+        SLANG_RETURN_ON_FAIL(m_connection->toNativeArgsOrSendError(call.params, &args, call.id));
+        cmd.semanticTokenDeltaArgs = args;
+        cmd.documentURI = args.textDocument.uri;
     }
     else if (call.method == SignatureHelpParams::methodName)
     {
         SignatureHelpParams args;
         SLANG_RETURN_ON_FAIL(m_connection->toNativeArgsOrSendError(call.params, &args, call.id));
         cmd.signatureHelpArgs = args;
+        cmd.documentURI = args.textDocument.uri;
     }
     else if (call.method == "completionItem/resolve")
     {
@@ -2364,6 +2647,13 @@ SlangResult LanguageServer::queueJSONCall(JSONRPCCall call)
             &args,
             call.id));
         cmd.documentSymbolArgs = args;
+        cmd.documentURI = args.textDocument.uri;
+    }
+    else if (call.method == WorkspaceSymbolParams::methodName)
+    {
+        WorkspaceSymbolParams args;
+        SLANG_RETURN_ON_FAIL(m_connection->toNativeArgsOrSendError(call.params, &args, call.id));
+        cmd.workspaceSymbolArgs = args;
     }
     else if (call.method == DocumentFormattingParams::methodName)
     {
@@ -2396,6 +2686,7 @@ SlangResult LanguageServer::queueJSONCall(JSONRPCCall call)
         InlayHintParams args;
         SLANG_RETURN_ON_FAIL(m_connection->toNativeArgsOrSendError(call.params, &args, call.id));
         cmd.inlayHintArgs = args;
+        cmd.documentURI = args.textDocument.uri;
     }
     else if (call.method == "$/cancelRequest")
     {
@@ -2453,6 +2744,14 @@ SlangResult LanguageServer::runCommand(Command& call)
         {
             return semanticTokens(call.semanticTokenArgs.get(), call.id);
         }
+        else if (call.method == SemanticTokensRangeParams::methodName)
+        {
+            return semanticTokensRange(call.semanticTokenRangeArgs.get(), call.id);
+        }
+        else if (call.method == SemanticTokensDeltaParams::methodName)
+        {
+            return semanticTokensDelta(call.semanticTokenDeltaArgs.get(), call.id);
+        }
         else if (call.method == SignatureHelpParams::methodName)
         {
             return signatureHelp(call.signatureHelpArgs.get(), call.id);
@@ -2468,6 +2767,10 @@ SlangResult LanguageServer::runCommand(Command& call)
         {
             return documentSymbol(call.documentSymbolArgs.get(), call.id);
         }
+        else if (call.method == WorkspaceSymbolParams::methodName)
+        {
+            return workspaceSymbol(call.workspaceSymbolArgs.get(), call.id);
+        }
         else if (call.method == DidChangeConfigurationParams::methodName)
         {
             return didChangeConfiguration(call.changeConfigArgs.get());
@@ -2503,28 +2806,75 @@ SlangResult LanguageServer::runCommand(Command& call)
     return m_connection->sendError(JSONRPC::ErrorCode::MethodNotFound, call.id);
 }
 
+void LanguageServer::readPendingMessages()
+{
+    while (true)
+    {
+        m_connection->tryReadMessage();
+        if (!m_connection->hasMessage())
+            break;
+        parseNextMessage();
+    }
+}
+
+// Does a query that only reads a document have no use anymore, because a later command in the
+// queue edits the document or asks the same query again?
+bool LanguageServer::isCommandSuperseded(Index commandIndex)
+{
+    auto& cmd = commands[commandIndex];
+    if (cmd.documentURI.getLength() == 0 || cmd.method == DidChangeTextDocumentParams::methodName ||
+        cmd.method == DidCloseTextDocumentParams::methodName)
+        return false;
+    for (Index i = commandIndex + 1; i < commands.getCount(); i++)
+    {
+        auto& laterCmd = commands[i];
+        if (laterCmd.documentURI != cmd.documentURI)
+            continue;
+        if (laterCmd.method == cmd.method ||
+            laterCmd.method == DidChangeTextDocumentParams::methodName ||
+            laterCmd.method == DidCloseTextDocumentParams::methodName)
+            return true;
+    }
+    return false;
+}
+
 void LanguageServer::processCommands()
 {
     HashSet<int64_t> canceledIDs;
-    for (auto& cmd : commands)
+    Index scannedCommandCount = 0;
+    const int kErrorRequestCanceled = -32800;
+    const int kErrorContentModified = -32801;
+    for (Index commandIndex = 0; commandIndex < commands.getCount(); commandIndex++)
     {
-        if (cmd.method == "$/cancelRequest")
+        // Pick up the messages that arrived while the earlier commands ran, so that their
+        // cancellations and edits apply to the commands that are still queued.
+        if (commandIndex > 0)
+            readPendingMessages();
+        for (; scannedCommandCount < commands.getCount(); scannedCommandCount++)
         {
-            auto id = cmd.cancelArgs.get().id;
-            if (id > 0)
+            auto& cmd = commands[scannedCommandCount];
+            if (cmd.method == "$/cancelRequest")
             {
-                canceledIDs.add(id);
+                auto id = cmd.cancelArgs.get().id;
+                if (id > 0)
+                {
+                    canceledIDs.add(id);
+                }
             }
         }
-    }
-    const int kErrorRequestCanceled = -32800;
-    for (auto& cmd : commands)
-    {
+
+        auto& cmd = commands[commandIndex];
         if (cmd.id.getKind() == JSONValue::Kind::Integer &&
             canceledIDs.contains(cmd.id.asInteger()))
         {
             m_connection->sendError((JSONRPC::ErrorCode)kErrorRequestCanceled, cmd.id);
         }
+        else if (isCommandSuperseded(commandIndex))
+        {
+            // Notifications don't get a response.
+            if (cmd.id.getKind() != JSONValue::Kind::Invalid)
+                m_connection->sendError((JSONRPC::ErrorCode)kErrorContentModified, cmd.id);
+        }
         else
         {
             runCommand(cmd);
@@ -2542,6 +2892,7 @@ SlangResult LanguageServerCore::didCloseTextDocument(const DidCloseTextDocumentP
 {
     String canonicalPath = uriToCanonicalPath(args.textDocument.uri);
     m_workspace->closeDoc(canonicalPath);
+    m_sentSemanticTokens.remove(canonicalPath);
     return SLANG_OK;
 }
 
@@ -2578,6 +2929,13 @@ void LanguageServer::update()
     if (!m_core.m_workspace)
         return;
     publishDiagnostics();
+
+    // Save the symbol index every so often rather than after every edit.
+    if (std::chrono::system_clock::now() - m_lastSymbolIndexSaveTime >= std::chrono::seconds(10))
+    {
+        m_lastSymbolIndexSaveTime = std::chrono::system_clock::now();
+        m_core.m_workspace->saveSymbolIndex();
+    }
 }
 
 void LanguageServer::updateConfigFromJSON(const JSONValue& jsonVal)
@@ -2635,6 +2993,10 @@ void LanguageServer::updateConfigFromJSON(const JSONValue& jsonVal)
         {
             updateInlayHintOptions(JSONValue(), kv.value);
         }
+        else if (key == "slang.symbolIndexCacheDirectory")
+        {
+            updateSymbolIndexCacheDirectory(kv.value);
+        }
     }
 }
 
@@ -2647,13 +3009,7 @@ SlangResult LanguageServer::execute()
     {
         // Consume all messages first.
         commands.clear();
-        while (true)
-        {
-            m_connection->tryReadMessage();
-            if (!m_connection->hasMessage())
-                break;
-            parseNextMessage();
-        }
+        readPendingMessages();
 
         auto workStart = platform::PerformanceCounter::now();
 
@@ -2675,6 +3031,8 @@ SlangResult LanguageServer::execute()
         m_connection->getUnderlyingConnection()->waitForResult(1000);
     }
 
+    if (m_core.m_workspace)
+        m_core.m_workspace->saveSymbolIndex();
     return SLANG_OK;
 }
 
@@ -5,6 +5,7 @@
 #include "slang-language-server-auto-format.h"
 #include "slang-language-server-completion.h"
 #include "slang-language-server-inlay-hints.h"
+#include "slang-language-server-semantic-tokens.h"
 #include "slang-workspace-version.h"
 #include "slang.h"
 
@@ -18,6 +19,8 @@ struct Command
 {
     PersistentJSONValue id;
     String method;
+    // The URI of the document the command is about, if any.
+    String documentURI;
 
     template<typename T>
     struct Optional
@@ -63,6 +66,7 @@ struct Command
     Optional<LanguageServerProtocol::CompletionItem> completionResolveArgs;
     Optional<LanguageServerProtocol::TextEditCompletionItem> textEditCompletionResolveArgs;
     Optional<LanguageServerProtocol::DocumentSymbolParams> documentSymbolArgs;
+    Optional<LanguageServerProtocol::WorkspaceSymbolParams> workspaceSymbolArgs;
     Optional<LanguageServerProtocol::InlayHintParams> inlayHintArgs;
     Optional<LanguageServerProtocol::DocumentFormattingParams> formattingArgs;
     Optional<LanguageServerProtocol::DocumentRangeFormattingParams> rangeFormattingArgs;
@@ -71,6 +75,8 @@ struct Command
     Optional<LanguageServerProtocol::SignatureHelpParams> signatureHelpArgs;
     Optional<LanguageServerProtocol::DefinitionParams> definitionArgs;
     Optional<LanguageServerProtocol::SemanticTokensParams> semanticTokenArgs;
+    Optional<LanguageServerProtocol::SemanticTokensRangeParams> semanticTokenRangeArgs;
+    Optional<LanguageServerProtocol::SemanticTokensDeltaParams> semanticTokenDeltaArgs;
     Optional<LanguageServerProtocol::HoverParams> hoverArgs;
     Optional<LanguageServerProtocol::DidOpenTextDocumentParams> openDocArgs;
     Optional<LanguageServerProtocol::DidChangeTextDocumentParams> changeDocArgs;
@@ -126,10 +132,16 @@ public:
         const LanguageServerProtocol::TextEditCompletionItem& editItem);
     LanguageServerResult<LanguageServerProtocol::SemanticTokens> semanticTokens(
         const LanguageServerProtocol::SemanticTokensParams& args);
+    LanguageServerResult<LanguageServerProtocol::SemanticTokens> semanticTokensRange(
+        const LanguageServerProtocol::SemanticTokensRangeParams& args);
+    LanguageServerResult<SemanticTokensDeltaResult> semanticTokensDelta(
+        const LanguageServerProtocol::SemanticTokensDeltaParams& args);
     LanguageServerResult<LanguageServerProtocol::SignatureHelp> signatureHelp(
         const LanguageServerProtocol::SignatureHelpParams& args);
     LanguageServerResult<List<LanguageServerProtocol::DocumentSymbol>> documentSymbol(
         const LanguageServerProtocol::DocumentSymbolParams& args);
+    LanguageServerResult<List<LanguageServerProtocol::SymbolInformation>> workspaceSymbol(
+        const LanguageServerProtocol::WorkspaceSymbolParams& args);
     LanguageServerResult<List<LanguageServerProtocol::InlayHint>> inlayHint(
         const LanguageServerProtocol::InlayHintParams& args);
     LanguageServerResult<List<LanguageServerProtocol::TextEdit>> formatting(
@@ -148,7 +160,38 @@ public:
         List<Slang::Range<Index>>* outParamRanges);
 
 private:
+    struct SentSemanticTokens
+    {
+        String resultId;
+        List<uint32_t> data;
+    };
+
+    // The last full semantic tokens sent for each document, that a delta request can be
+    // based on.
+    Dictionary<String, SentSemanticTokens> m_sentSemanticTokens;
+    Index m_semanticTokensResultIdCounter = 0;
+
+    // The member and symbol candidates found by the last completion request. They are reused
+    // while only the identifier at the cursor is being typed, without parsing and checking the
+    // document again.
+    struct CompletionCandidateCache
+    {
+        String documentPath;
+        // The document text without the typed part of the identifier at the cursor.
+        String textWithoutTypedPrefix;
+        Index identifierStartOffset = -1;
+        Index workspaceChangeCount = -1;
+        String triggerCharacter;
+        CommitCharacterBehavior commitCharacterBehavior = CommitCharacterBehavior::Disabled;
+        // The completion version the candidates were found in, which resolve requests use.
+        RefPtr<WorkspaceVersion> version;
+        CompletionResult result;
+    };
+    CompletionCandidateCache m_completionCandidateCache;
+
     slang::IGlobalSession* getOrCreateGlobalSession();
+    SlangResult getEncodedSemanticTokens(const String& uri, List<uint32_t>& outData);
+    String sendSemanticTokens(const String& uri, const List<uint32_t>& data);
 
     FormatOptions getFormatOptions(Workspace* workspace, FormatOptions inOptions);
     LanguageServerResult<LanguageServerProtocol::Hover> tryGetMacroHoverInfo(
@@ -165,6 +208,10 @@ private:
         WorkspaceVersion* version,
         DocumentVersion* doc,
         Index line);
+    LanguageServerResult<List<LanguageServerProtocol::Location>> tryGotoIndexedSymbol(
+        DocumentVersion* doc,
+        Index line,
+        Index col);
 };
 
 class LanguageServer
@@ -187,6 +234,7 @@ public:
     bool m_initialized = false;
     TraceOptions m_traceOptions = TraceOptions::Off;
     std::chrono::time_point<std::chrono::system_clock> m_lastDiagnosticUpdateTime;
+    std::chrono::time_point<std::chrono::system_clock> m_lastSymbolIndexSaveTime;
     Dictionary<String, String> m_lastPublishedDiagnostics;
 
     LanguageServer(LanguageServerStartupOptions options)
@@ -219,12 +267,21 @@ public:
     SlangResult semanticTokens(
         const LanguageServerProtocol::SemanticTokensParams& args,
         const JSONValue& responseId);
+    SlangResult semanticTokensRange(
+        const LanguageServerProtocol::SemanticTokensRangeParams& args,
+        const JSONValue& responseId);
+    SlangResult semanticTokensDelta(
+        const LanguageServerProtocol::SemanticTokensDeltaParams& args,
+        const JSONValue& responseId);
     SlangResult signatureHelp(
         const LanguageServerProtocol::SignatureHelpParams& args,
         const JSONValue& responseId);
     SlangResult documentSymbol(
         const LanguageServerProtocol::DocumentSymbolParams& args,
         const JSONValue& responseId);
+    SlangResult workspaceSymbol(
+        const LanguageServerProtocol::WorkspaceSymbolParams& args,
+        const JSONValue& responseId);
     SlangResult inlayHint(
         const LanguageServerProtocol::InlayHintParams& args,
         const JSONValue& responseId);
@@ -254,6 +311,7 @@ private:
         const JSONValue& allowLineBreakInRange);
     void updateInlayHintOptions(const JSONValue& deducedTypes, const JSONValue& parameterNames);
     void updateTraceOptions(const JSONValue& value);
+    void updateSymbolIndexCacheDirectory(const JSONValue& value);
 
     void sendConfigRequest();
     void registerCapability(const char* methodName);
@@ -262,6 +320,8 @@ private:
     List<Command> commands;
     SlangResult queueJSONCall(JSONRPCCall call);
     SlangResult runCommand(Command& cmd);
+    void readPendingMessages();
+    bool isCommandSuperseded(Index commandIndex);
     void processCommands();
 };
 
@@ -203,6 +203,8 @@ static void _lookUpDirectAndTransparentMembers(
         // Look up the declarations with the chosen name in the container.
         Decl* firstDecl = nullptr;
         containerDecl->getMemberDictionary().tryGetValue(name, firstDecl);
+        if (auto cacheEntry = request.memberLookupCacheEntry)
+            cacheEntry->addContainer(containerDecl);
 
         // Now iterate over those declarations (if any) and see if
         // we find any that meet our filtering criteria.
@@ -237,6 +239,10 @@ static void _lookUpDirectAndTransparentMembers(
     if ((int)request.mask & (int)LookupMask::Attribute)
         return;
 
+    // What is found in a transparent member depends on its type, which might not be known yet.
+    if (request.memberLookupCacheEntry && containerDecl->getTransparentMembers().getCount())
+        request.memberLookupCacheEntry->isCacheable = false;
+
     for (auto transparentInfo : containerDecl->getTransparentMembers())
     {
         // The reference to the transparent member should use the same
@@ -561,6 +567,14 @@ static void _lookUpMembersInSuperTypeDeclImpl(
 
     ensureDecl(semantics, declRef.getDecl(), DeclCheckState::ReadyForLookup);
 
+    // A declaration that isn't ready for lookup yet, because it is being checked, may have
+    // more bases or members by the time it is.
+    if (request.memberLookupCacheEntry &&
+        !declRef.getDecl()->isChecked(DeclCheckState::ReadyForLookup))
+    {
+        request.memberLookupCacheEntry->isCacheable = false;
+    }
+
     // With semantics context, we can do a comprehensive lookup by scanning through
     // the linearized inheritance list.
 
@@ -751,15 +765,58 @@ static void _lookUpMembersInType(
         return;
     }
 
+    // A lookup that starts from `type`, rather than part way through another lookup, only
+    // depends on `type`, `name` and the mask and options of the request, so its result is
+    // cached on the shared semantics context. This saves walking all the facets of types
+    // with many extensions or base types each time one of their members is named.
+    //
+    SharedSemanticsContext* shared = nullptr;
+    if (!breadcrumbs && request.semantics && !request.memberLookupCacheEntry &&
+        !request.declToExclude && !request.isCompletionRequest())
+    {
+        shared = request.semantics->getShared();
+    }
+    if (!shared)
+    {
+        _lookUpMembersInSuperTypeImpl(
+            astBuilder,
+            name,
+            type,
+            type,
+            nullptr,
+            request,
+            ioResult,
+            breadcrumbs);
+        return;
+    }
+
+    MemberLookupCacheKey key;
+    key.type = type;
+    key.name = name;
+    key.mask = request.mask;
+    key.options = request.options;
+    if (auto cachedEntry = shared->tryGetCachedMemberLookup(key))
+    {
+        AddToLookupResult(ioResult, cachedEntry->result);
+        return;
+    }
+
+    MemberLookupCacheEntry entry;
+    entry.generation = shared->getMemberLookupCacheGeneration();
+    entry.isCacheable = !shared->isCalculatingInheritanceInfo();
+    LookupRequest recordingRequest = request;
+    recordingRequest.memberLookupCacheEntry = &entry;
     _lookUpMembersInSuperTypeImpl(
         astBuilder,
         name,
         type,
         type,
         nullptr,
-        request,
-        ioResult,
-        breadcrumbs);
+        recordingRequest,
+        entry.result,
+        nullptr);
+    shared->cacheMemberLookup(key, entry);
+    AddToLookupResult(ioResult, entry.result);
 }
 
 /// Look up members by `name` in the given `valueDeclRef`.
@@ -652,6 +652,44 @@ bool isForceInlineEarly(Decl* decl)
     return decl->hasModifier<UnsafeForceInlineEarlyAttribute>();
 }
 
+/// Is `decl` a function, or generic function, whose body was never checked because checking
+/// was deferred and nothing referenced it? See `CompilerOptionName::DeferFunctionBodyChecking`.
+bool isFunctionBodyUncheckedAndDeferred(IRGenContext* context, Decl* decl)
+{
+    if (!context->getLinkage()->m_optionSet.getBoolOption(
+            CompilerOptionName::DeferFunctionBodyChecking))
+        return false;
+    if (auto genericDecl = as<GenericDecl>(decl))
+        decl = genericDecl->inner;
+    auto funcDecl = as<FunctionDeclBase>(decl);
+    return funcDecl && funcDecl->body && !funcDecl->isChecked(DeclCheckState::DefinitionChecked);
+}
+
+/// Is `decl` a global function, or generic function, that its module doesn't generate IR for
+/// because nothing referenced it? See `CompilerOptionName::LowerReferencedFunctionsOnly`.
+bool isFunctionUnreferencedAndSkipped(IRGenContext* context, Decl* decl)
+{
+    auto module = context->getMainModuleDecl()->module;
+    if (!module || !module->lowersReferencedFunctionsOnly())
+        return false;
+    if (!as<ModuleDecl>(decl->parentDecl) && !as<FileDecl>(decl->parentDecl) &&
+        !as<NamespaceDecl>(decl->parentDecl))
+        return false;
+
+    auto funcDecl = as<FunctionDeclBase>(decl);
+    if (auto genericDecl = as<GenericDecl>(decl))
+        funcDecl = as<FunctionDeclBase>(genericDecl->inner);
+    if (!funcDecl || !funcDecl->body)
+        return false;
+
+    // Attributes mark entry points, exports, and functions that are found through other
+    // functions rather than referenced, such as derivatives.
+    if (funcDecl->findModifier<AttributeBase>() || funcDecl->hasModifier<HLSLExportModifier>() ||
+        funcDecl->hasModifier<ExternCppModifier>())
+        return false;
+    return module->shouldSkipLoweringFunction(decl);
+}
+
 bool isImportedDecl(IRGenContext* context, Decl* decl, bool& outIsExplicitExtern)
 {
     // If the declaration has the extern attribute then it must be imported
@@ -6833,11 +6871,10 @@ void maybeEmitDebugLine(
         return;
 
     IRInst* debugSourceInst = nullptr;
-    auto humaneLoc =
-        context->getLinkage()->getSourceManager()->getHumaneLoc(loc, SourceLocType::Emit);
-
-    // Do a best-effort attempt to retrieve the nominal source file.
-    auto pathInfo = sourceView->getPathInfo(loc, SourceLocType::Emit);
+    // The view has been found already, so look the location up in it directly. The path of the
+    // humane location is the nominal source file, on a best-effort basis.
+    auto humaneLoc = sourceView->getHumaneLoc(loc, SourceLocType::Emit);
+    const auto& pathInfo = humaneLoc.pathInfo;
 
     // If the source file path correspond to an existing SourceFile in the source manager, use it.
     auto source = sourceManager->findSourceFileByPathRecursively(pathInfo.foundPath);
@@ -6873,9 +6910,7 @@ void maybeAddDebugLocationDecoration(IRGenContext* context, IRInst* inst)
     IRInst* debugSourceInst = nullptr;
     if (context->shared->mapSourceFileToDebugSourceInst.tryGetValue(source, debugSourceInst))
     {
-        auto humaneLoc = context->getLinkage()->getSourceManager()->getHumaneLoc(
-            inst->sourceLoc,
-            SourceLocType::Emit);
+        auto humaneLoc = sourceView->getHumaneLoc(inst->sourceLoc, SourceLocType::Emit);
         context->irBuilder
             ->addDebugLocationDecoration(inst, debugSourceInst, humaneLoc.line, humaneLoc.column);
     }
@@ -8112,6 +8147,8 @@ struct DeclLoweringVisitor : DeclVisitor<DeclLoweringVisitor, LoweredValInfo>
         }
         if (hasLayoutSemantic)
             builder->addHasExplicitHLSLBindingDecoration(irParam);
+        if (decl->hasModifier<ProfileCountersAttribute>())
+            builder->addDecoration(irParam, kIROp_ProfileCountersDecoration);
 
         // A global variable's SSA value is a *pointer* to
         // the underlying storage.
@@ -8756,6 +8793,16 @@ struct DeclLoweringVisitor : DeclVisitor<DeclLoweringVisitor, LoweredValInfo>
         {
             subBuilder->addSpecializeDecoration(irInterface);
         }
+        if (auto specConstDispatchAttr =
+                decl->findModifier<SpecializationConstantDispatchAttribute>())
+        {
+            subBuilder->addDecoration(
+                irInterface,
+                kIROp_SpecializationConstantDispatchDecoration,
+                subBuilder->getIntValue(
+                    subBuilder->getIntType(),
+                    specConstDispatchAttr->constantId));
+        }
         if (auto comInterfaceAttr = decl->findModifier<ComInterfaceAttribute>())
         {
             subBuilder->addComInterfaceDecoration(
@@ -9937,6 +9984,11 @@ struct DeclLoweringVisitor : DeclVisitor<DeclLoweringVisitor, LoweredValInfo>
         else if (isDeclInDifferentModule(context, decl) && !isForceInlineEarly(decl))
         {
         }
+        else if (isFunctionBodyUncheckedAndDeferred(context, decl))
+        {
+            // The body was never checked, so the function can only be emitted as a
+            // declaration.
+        }
         else if (emitBody)
         {
             // This is a function definition, so we need to actually
@@ -10197,6 +10249,10 @@ struct DeclLoweringVisitor : DeclVisitor<DeclLoweringVisitor, LoweredValInfo>
             {
                 getBuilder()->addSimpleDecoration<IRNoInlineDecoration>(irFunc);
             }
+            else if (as<PreferHalfAttribute>(modifier))
+            {
+                getBuilder()->addSimpleDecoration<IRPreferHalfDecoration>(irFunc);
+            }
             else if (as<DerivativeGroupQuadAttribute>(modifier))
             {
                 derivativeGroupQuadDecor =
@@ -10375,6 +10431,15 @@ struct DeclLoweringVisitor : DeclVisitor<DeclLoweringVisitor, LoweredValInfo>
                         getBuilder()->getIntType(),
                         attr->sideEffectBehavior));
             }
+            else if (auto checkpointPolicyAttr = as<CheckpointPolicyAttribute>(modifier))
+            {
+                getBuilder()->addDecoration(
+                    irFunc,
+                    kIROp_CheckpointPolicyDecoration,
+                    getBuilder()->getIntValue(
+                        getBuilder()->getIntType(),
+                        checkpointPolicyAttr->policy));
+            }
             else if (auto extensionMod = as<RequiredGLSLExtensionModifier>(modifier))
                 getBuilder()->addRequireGLSLExtensionDecoration(
                     irFunc,
@@ -11113,6 +11178,12 @@ static void lowerProgramEntryPointToIR(
 /// Ensure that `decl` and all relevant declarations under it get emitted.
 static void ensureAllDeclsRec(IRGenContext* context, Decl* decl)
 {
+    // A function whose body checking was deferred, and that nothing referenced, isn't emitted.
+    if (isFunctionBodyUncheckedAndDeferred(context, decl))
+        return;
+    if (isFunctionUnreferencedAndSkipped(context, decl))
+        return;
+
     ensureDecl(context, decl);
 
     // Note: We are checking here for aggregate type declarations, and
@@ -11694,7 +11765,10 @@ RefPtr<IRModule> generateIRForTypeConformance(
 
 RefPtr<IRModule> TargetProgram::getOrCreateIRModuleForLayout(DiagnosticSink* sink)
 {
-    getOrCreateLayout(sink);
+    // The IR module is created along with the layout, but may have been released since by
+    // `_releaseIntermediateIRIfComplete`.
+    if (getOrCreateLayout(sink) && !m_irModuleForLayout)
+        m_irModuleForLayout = createIRModuleForLayout(sink);
     return m_irModuleForLayout;
 }
 
@@ -11,8 +11,22 @@ struct ManglingContext
     ManglingContext(ASTBuilder* inAstBuilder)
         : astBuilder(inAstBuilder)
     {
+        if (!astBuilder)
+            return;
+        // The names depend on resolved types and witnesses, so like resolved `Val`s,
+        // they are only reused within the epoch they were computed in.
+        cache = &astBuilder->m_mangledNameCache;
+        const Index epoch = astBuilder->getEpoch();
+        if (cache->epoch != epoch)
+        {
+            cache->epoch = epoch;
+            cache->mangledNames.clear();
+            cache->qualifiedNames.clear();
+            cache->qualifiedNamesWithoutModule.clear();
+        }
     }
     ASTBuilder* astBuilder;
+    ASTBuilder::MangledNameCache* cache = nullptr;
     StringBuilder sb;
 };
 
@@ -31,6 +45,11 @@ void emit(ManglingContext* context, String const& value)
     context->sb.append(value);
 }
 
+static bool _isUnescapedNameChar(char c)
+{
+    return ('a' <= c) && (c <= 'z') || ('A' <= c) && (c <= 'Z') || ('0' <= c) && (c <= '9');
+}
+
 void emitNameImpl(ManglingContext* context, UnownedStringSlice str)
 {
     Index length = str.getLength();
@@ -71,36 +90,47 @@ void emitNameImpl(ManglingContext* context, UnownedStringSlice str)
         // ASCII alphanumeric code points go through unmodified,
         // and we use `_` as a kind of escape character.
         //
-        StringBuilder encoded;
-
+        // Any byte that isn't within the allowed ranges
+        // we be turned into hex, prefixed with `_` and
+        // suffixed with `x`.
+        //
+        // The length of the encoded name is worked out first, so that the
+        // name can be encoded straight into the output rather than into a
+        // temporary.
+        //
         // TODO: This loop probalby ought to be over code points
         // rather than bytes.
         //
+        Index encodedLength = 0;
+        for (auto c : str)
+        {
+            if (_isUnescapedNameChar(c))
+                encodedLength += 1;
+            else if (c == '_')
+                encodedLength += 2;
+            else
+                encodedLength += ((unsigned char)c < 16 ? 1 : 2) + 2;
+        }
+
+        context->sb.append("R");
+        emit(context, encodedLength);
         for (auto c : str)
         {
-            if (('a' <= c) && (c <= 'z') || ('A' <= c) && (c <= 'Z') || ('0' <= c) && (c <= '9'))
+            if (_isUnescapedNameChar(c))
             {
-                encoded.append(c);
+                context->sb.appendChar(c);
             }
             else if (c == '_')
             {
-                encoded.append("_u");
+                context->sb.append("_u");
             }
             else
             {
-                // Any byte that isn't within the allowed ranges
-                // we be turned into hex, prefixed with `_` and
-                // suffixed with `x`.
-                //
-                encoded.append("_");
-                encoded.append(uint32_t((unsigned char)c), 16);
-                encoded.appendChar('x');
+                context->sb.appendChar('_');
+                context->sb.append(uint32_t((unsigned char)c), 16);
+                context->sb.appendChar('x');
             }
         }
-
-        context->sb.append("R");
-        emit(context, encoded.getLength());
-        context->sb.append(encoded);
     }
 
     // TODO: This logic does not rule out consecutive underscores,
@@ -386,7 +416,31 @@ void emitVal(ManglingContext* context, Val* val)
     }
 }
 
+void emitQualifiedNameImpl(ManglingContext* context, DeclRef<Decl> declRef, bool includeModuleName);
+
 void emitQualifiedName(ManglingContext* context, DeclRef<Decl> declRef, bool includeModuleName)
+{
+    auto cache = context->cache;
+    if (!cache)
+    {
+        emitQualifiedNameImpl(context, declRef, includeModuleName);
+        return;
+    }
+
+    // The qualified names of parent decls are emitted again for each of their members
+    // and specializations, so they are kept to be appended directly.
+    auto& names = includeModuleName ? cache->qualifiedNames : cache->qualifiedNamesWithoutModule;
+    if (auto found = names.tryGetValue(declRef.declRefBase))
+    {
+        context->sb.append(*found);
+        return;
+    }
+    const Index start = context->sb.getLength();
+    emitQualifiedNameImpl(context, declRef, includeModuleName);
+    names[declRef.declRefBase] = context->sb.getUnownedSlice().tail(start);
+}
+
+void emitQualifiedNameImpl(ManglingContext* context, DeclRef<Decl> declRef, bool includeModuleName)
 {
     if (!includeModuleName)
     {
@@ -752,8 +806,17 @@ static String getMangledName(ASTBuilder* astBuilder, DeclRef<Decl> const& declRe
 {
     SLANG_AST_BUILDER_RAII(astBuilder);
     ManglingContext context(astBuilder);
+    if (!context.cache)
+    {
+        mangleName(&context, declRef);
+        return context.sb.produceString();
+    }
+    if (auto found = context.cache->mangledNames.tryGetValue(declRef.declRefBase))
+        return *found;
     mangleName(&context, declRef);
-    return context.sb.produceString();
+    String name = context.sb.produceString();
+    context.cache->mangledNames[declRef.declRefBase] = name;
+    return name;
 }
 
 String getMangledName(ASTBuilder* astBuilder, DeclRefBase* declRef)
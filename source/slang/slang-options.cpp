@@ -18,6 +18,7 @@
 #include "../core/slang-file-system.h"
 #include "../core/slang-hex-dump-util.h"
 #include "../core/slang-name-value.h"
+#include "../core/slang-performance-profiler.h"
 #include "../core/slang-string-slice-pool.h"
 #include "../core/slang-type-text-util.h"
 #include "slang-compiler-options.h"
@@ -63,6 +64,8 @@ enum class ValueCategory
     FileSystemType,
     VulkanShift,
     SourceEmbedStyle,
+    SpirvOptimizationPreset,
+    AutodiffCheckpointPolicy,
 
     CountOf,
 };
@@ -87,6 +90,8 @@ SLANG_GET_VALUE_CATEGORY(FloatingPointMode, FloatingPointMode)
 SLANG_GET_VALUE_CATEGORY(FileSystemType, TypeTextUtil::FileSystemType)
 SLANG_GET_VALUE_CATEGORY(HelpStyle, CommandOptionsWriter::Style)
 SLANG_GET_VALUE_CATEGORY(OptimizationLevel, SlangOptimizationLevel)
+SLANG_GET_VALUE_CATEGORY(SpirvOptimizationPreset, SlangSpirvOptimizationPreset)
+SLANG_GET_VALUE_CATEGORY(AutodiffCheckpointPolicy, SlangAutodiffCheckpointPolicy)
 SLANG_GET_VALUE_CATEGORY(VulkanShift, HLSLToVulkanLayoutOptions::Kind)
 SLANG_GET_VALUE_CATEGORY(SourceEmbedStyle, SourceEmbedUtil::Style)
 SLANG_GET_VALUE_CATEGORY(Language, SourceLanguage)
@@ -189,6 +194,20 @@ void initCommandOptions(CommandOptions& options)
             UserValue(ValueCategory::OptimizationLevel));
         options.addValues(TypeTextUtil::getOptimizationLevelInfos());
 
+        options.addCategory(
+            CategoryKind::Value,
+            "spirv-optimization-preset",
+            "SPIR-V Optimization Preset",
+            UserValue(ValueCategory::SpirvOptimizationPreset));
+        options.addValues(TypeTextUtil::getSpirvOptimizationPresetInfos());
+
+        options.addCategory(
+            CategoryKind::Value,
+            "autodiff-checkpoint-policy",
+            "Autodiff Checkpoint Policy",
+            UserValue(ValueCategory::AutodiffCheckpointPolicy));
+        options.addValues(TypeTextUtil::getAutodiffCheckpointPolicyInfos());
+
         options.addCategory(
             CategoryKind::Value,
             "debug-level",
@@ -339,6 +358,13 @@ void initCommandOptions(CommandOptions& options)
          "-depfile",
          "-depfile <path>",
          "Save the source file dependency list in a file."},
+        {OptionKind::PrecompileModules,
+         "-precompile-modules",
+         "-precompile-modules <dir>",
+         "Write each input file to <dir> as a precompiled module named after it, along with a "
+         "'.d' dependency file, instead of generating code. The input files are checked in import "
+         "order, so a module imported by another input is only loaded once. The files are written "
+         "on the threads given by -front-end-threads."},
         {OptionKind::EntryPointName,
          "-entry",
          "-entry <name>",
@@ -398,11 +424,15 @@ void initCommandOptions(CommandOptions& options)
         {OptionKind::MinimumSlangOptimization,
          "-minimum-slang-optimization",
          nullptr,
-         "Perform minimum code optimization in Slang to favor compilation time."},
+         "Perform minimum code optimization in Slang to favor compilation time. Only the "
+         "passes the target needs are run, and -report-ir-pass-stats lists the passes that "
+         "were skipped."},
         {OptionKind::DisableNonEssentialValidations,
          "-disable-non-essential-validations",
          nullptr,
-         "Disable non-essential IR validations such as use of uninitialized variables."},
+         "Disable non-essential IR validations such as use of uninitialized variables, "
+         "missing returns, recursive types and autodiff usage patterns. Passes skipped this way "
+         "are listed as skipped by -report-ir-pass-stats."},
         {OptionKind::DisableSourceMap,
          "-disable-source-map",
          nullptr,
@@ -485,6 +515,12 @@ void initCommandOptions(CommandOptions& options)
          nullptr,
          "Reports information about checkpoint contexts used for reverse-mode automatic "
          "differentiation."},
+        {OptionKind::ReportRegisterPressure,
+         "-report-register-pressure",
+         nullptr,
+         "Reports, for each function in SPIR-V emitted directly, the largest number of values "
+         "live at once in any of its blocks, before and after instructions are scheduled to "
+         "reduce it."},
         {OptionKind::SkipSPIRVValidation,
          "-skip-spirv-validation",
          nullptr,
@@ -528,6 +564,217 @@ void initCommandOptions(CommandOptions& options)
          "-reflection-json",
          "reflection-json <path>",
          "Emit reflection data in JSON format to a file."},
+        {OptionKind::TraceOutput,
+         "-trace-output",
+         "-trace-output <path>",
+         "Record a hierarchical trace of the time spent in the compiler and write it to <path> "
+         "in the Chrome trace event JSON format (viewable in chrome://tracing or Perfetto). "
+         "Events are tagged with the module or entry point being processed."},
+        {OptionKind::ReportIRPassStatistics,
+         "-report-ir-pass-stats",
+         nullptr,
+         "Reports, for every IR pass run during code generation, its invocation count, time, "
+         "and the change in instruction count and IR memory it caused, along with how often "
+         "it was skipped for -minimum-slang-optimization."},
+        {OptionKind::IRPassStatisticsJSON,
+         "-ir-pass-stats-json",
+         "-ir-pass-stats-json <path>",
+         "Write the statistics of -report-ir-pass-stats in JSON format to <path>, "
+         "or to stdout if <path> is '-'."},
+        {OptionKind::DownstreamThreadCount,
+         "-downstream-threads",
+         "-downstream-threads <count>",
+         "Run the downstream compiles (such as DXC or NVRTC) of separately compiled entry "
+         "points on up to <count> threads. Linking, optimizing and emitting the IR of each "
+         "entry point are not parallel. Diagnostics and outputs are produced in the same "
+         "order as on a single thread."},
+        {OptionKind::DownstreamResultCache,
+         "-downstream-cache",
+         nullptr,
+         "Reuse the result of an earlier downstream compile (such as DXC or glslang) of the same "
+         "code with the same options, instead of invoking the downstream compiler again."},
+        {OptionKind::MapBinaryModules,
+         "-map-binary-modules",
+         nullptr,
+         "Load precompiled .slang-module files by mapping them into memory rather than reading "
+         "them, so the parts a compile doesn't use are never read from disk."},
+        {OptionKind::OptimizationThreadCount,
+         "-optimization-threads",
+         "-optimization-threads <count>",
+         "Compute the per-function analyses the IR optimizer uses, such as dominator trees, "
+         "on up to <count> threads."},
+        {OptionKind::FrontEndThreadCount,
+         "-front-end-threads",
+         "-front-end-threads <count>",
+         "Lex the source files of the translation units being compiled on up to <count> threads "
+         "before they are preprocessed and parsed."},
+        {OptionKind::DeferFunctionBodyChecking,
+         "-defer-function-body-checking",
+         nullptr,
+         "Only check the bodies of global functions that are entry points, have attributes, are "
+         "visible outside their module, or are used by other checked code. Other functions are "
+         "not checked or emitted. Functions in modules without a `module` declaration are only "
+         "visible outside it if marked `public`."},
+        {OptionKind::ReflectionJSONCompact,
+         "-reflection-json-compact",
+         nullptr,
+         "Write the reflection data of -reflection-json without new lines or indentation."},
+        {OptionKind::ReflectionJSONFilter,
+         "-reflection-json-filter",
+         "-reflection-json-filter <names>",
+         "Only write the reflection data of the global parameters and entry points named in the "
+         "comma separated list <names> to the file of -reflection-json."},
+        {OptionKind::EmitReflectionBinary,
+         "-reflection-binary",
+         "-reflection-binary <path>",
+         "Write the binding layout of the parameters and entry points to <path> in the compact "
+         "binary format described in slang-reflection-blob.h."},
+        {OptionKind::ShareGenericSpecializations,
+         "-share-generic-specializations",
+         nullptr,
+         "Reuse the specializations of generic functions made while linking a program for a "
+         "target in the other programs linked for the same target."},
+        {OptionKind::ShareForwardDerivatives,
+         "-share-forward-derivatives",
+         nullptr,
+         "Reuse the forward derivatives of functions made while linking a program for a target "
+         "in the other programs linked for the same target."},
+        {OptionKind::AutodiffCheckpointPolicy,
+         "-autodiff-checkpoint-policy",
+         "-autodiff-checkpoint-policy <autodiff-checkpoint-policy>",
+         "Select how the backward derivatives of functions without a [CheckpointPolicy] attribute "
+         "make the values computed in the primal pass available to the backward pass."},
+        {OptionKind::AutodiffRecomputeBudget,
+         "-autodiff-recompute-budget",
+         "-autodiff-recompute-budget <count>",
+         "Recompute the primal values that cost at most <count> instructions to recompute, when "
+         "the budget checkpoint policy is selected. Defaults to 16."},
+        {OptionKind::InstrumentProfileCounters,
+         "-instrument-profile-counters",
+         nullptr,
+         "Count the calls to each function and the iterations of each loop in the global "
+         "RWStructuredBuffer<uint> marked [ProfileCounters], and report what each counter "
+         "counts."},
+        {OptionKind::ProfileCounts,
+         "-profile-counts",
+         "-profile-counts <path>",
+         "Read the counts collected by a program compiled with -instrument-profile-counters "
+         "from <path>, a text file of whitespace separated counts, and use them to unroll hot "
+         "loops and inline hot functions."},
+        {OptionKind::TrimUnusedUniformFields,
+         "-trim-unused-uniform-fields",
+         nullptr,
+         "Remove the fields that the compiled entry points don't use from constant buffers, and "
+         "pack the remaining fields together. The offsets of the remaining fields are reported "
+         "by IMetadata::getUniformDataOffset."},
+        {OptionKind::PackGlobalUniforms,
+         "-pack-global-uniforms",
+         nullptr,
+         "Lay out the global-scope uniform parameters in the order that needs the least padding "
+         "under the constant buffer layout rules of the target, instead of in declaration order. "
+         "Reflection reports the chosen offsets."},
+        {OptionKind::CPUThreadSIMDWidth,
+         "-cpu-thread-simd-width",
+         "-cpu-thread-simd-width <width>",
+         "Mark the loop over the threads of a compute thread group in code generated for CPU "
+         "targets for the downstream compiler to vectorize, running <width> threads in the lanes "
+         "of SIMD instructions. 0, the default, runs the threads one at a time."},
+        {OptionKind::BatchEntryPoints,
+         "-batch-entry-points",
+         nullptr,
+         "Compile all the entry points of a program for the PTX or metallib targets as one "
+         "module, with a single invocation of the downstream compiler, instead of compiling "
+         "each entry point on its own. Every entry point's result is the shared module."},
+        {OptionKind::ContiguousTensorVariants,
+         "-contiguous-tensor-variants",
+         nullptr,
+         "Add a variant of each [CudaKernel] that takes TensorViews of scalars, in which the "
+         "innermost dimension of those tensors is known to be contiguous. The generated torch "
+         "host code launches the variant when the tensors it is given allow it. Must be set "
+         "for both the cuda and torch targets."},
+        {OptionKind::CacheTensorViews,
+         "-cache-tensor-views",
+         nullptr,
+         "Make the torch host code reuse the TensorView it made for a tensor at the same place "
+         "in the last call, when the tensor's data, shape and strides haven't changed, instead "
+         "of checking the tensor and making the view again."},
+        {OptionKind::PadGroupSharedArrays,
+         "-pad-groupshared-arrays",
+         nullptr,
+         "Pad the rows of two-dimensional groupshared arrays of 32-bit scalars by one element "
+         "when their length is a multiple of the 32 shared memory banks and the arrays are "
+         "indexed by rows that aren't constant, so that the threads accessing a column don't "
+         "all access the same bank. A note is reported for each array that is padded."},
+        {OptionKind::ReportOptimizationRemarks,
+         "-report-optimization-remarks",
+         nullptr,
+         "Report a note for each decision about unrolling a loop, inlining a call, specializing "
+         "a dynamic dispatch or keeping a struct or array variable in registers, saying whether "
+         "the optimization was applied or missed, why, and how many IR instructions it "
+         "affects."},
+        {OptionKind::OptimizationRemarksFile,
+         "-optimization-remarks-file",
+         "-optimization-remarks-file <path>",
+         "Write the remarks of -report-optimization-remarks to <path> as JSON, whether or not "
+         "they are also reported as notes."},
+        {OptionKind::ReportShaderCost,
+         "-report-shader-cost",
+         nullptr,
+         "Report a note with the static cost of each entry point in the generated code: its "
+         "ALU operations, texture and buffer accesses, groupshared memory, barriers, local "
+         "arrays kept in memory and an estimate of the values live at once."},
+        {OptionKind::IncrementalCodeGen,
+         "-incremental-codegen",
+         nullptr,
+         "Keep the code generated for each program in the global session, and reuse it for "
+         "programs whose linked IR is the same, such as programs using modules that were "
+         "reloaded after a change to functions they don't call."},
+        {OptionKind::LowerReferencedFunctionsOnly,
+         "-lower-referenced-functions-only",
+         nullptr,
+         "Only generate IR for the global functions of an imported module that are referenced "
+         "from checked code, and generate it when the IR of the module is first needed "
+         "instead of when the module is imported."},
+        {OptionKind::ReleaseIntermediateIR,
+         "-release-intermediate-ir",
+         nullptr,
+         "Release the IR kept for a target of a program once the code of all its entry points "
+         "has been generated, keeping only the code and the reflection. When compiling a "
+         "batch, each linked program is also released once its last item is compiled."},
+        {OptionKind::MemoryBudget,
+         "-memory-budget",
+         "-memory-budget <MiB>",
+         "Set a soft limit on the memory used by the IR and syntax trees of the session. "
+         "When it is exceeded, the linked IR that SPIR-V is emitted from is released as soon "
+         "as the SPIR-V has been emitted, instead of when spirv-opt is done with it."},
+        {OptionKind::IndexSearchDirectories,
+         "-index-search-directories",
+         nullptr,
+         "Keep the listing of each search directory, and only look for a file to include or "
+         "import in the directories that hold the first element of its path."},
+        {OptionKind::PrefetchImportedModules,
+         "-prefetch-imported-modules",
+         nullptr,
+         "Before the imports of a module are checked, read the files of the modules they name "
+         "concurrently, so that reading them overlaps."},
+        {OptionKind::LoopUnrollBudget,
+         "-loop-unroll-budget",
+         "-loop-unroll-budget <count>",
+         "Set the number of instructions that unrolling a [ForceUnroll] loop may add to a "
+         "function, counted after each unrolled iteration is simplified. Unrolling is aborted "
+         "with an error when it is exceeded. There is no limit by default."},
+        {OptionKind::CompressIdleModuleIR,
+         "-compress-idle-module-ir",
+         "-compress-idle-module-ir <seconds>",
+         "Keep the IR of a loaded module serialized and compressed once it has not been used for "
+         "the given number of seconds, and read it back when it is next needed. The IR is not "
+         "compressed by default."},
+        {OptionKind::AggressiveExpressionFolding,
+         "-aggressive-expression-folding",
+         nullptr,
+         "When emitting source code, fold a single-use value into the expression that uses it "
+         "even when side effects come in between, if they can't change the value, and fold "
+         "resource method calls too. This leaves out temporaries to make the source smaller."},
     };
 
 
@@ -580,6 +827,11 @@ void initCommandOptions(CommandOptions& options)
          "<debug-info-format> specifies a debugging info format\n"
          "It is valid to have multiple -g options, such as a <debug-level> and a "
          "<debug-info-format>"},
+        {OptionKind::DebugInfoFunctions,
+         "-debug-info-functions",
+         "-debug-info-functions <name>[,<name>...]",
+         "Only emit the debug information of the functions with the given names, and of the "
+         "types and variables they use. Only applies to SPIR-V."},
         {OptionKind::LineDirectiveMode,
          "-line-directive-mode",
          "-line-directive-mode <line-directive-mode>",
@@ -718,6 +970,11 @@ void initCommandOptions(CommandOptions& options)
          "existing compiler <compiler>.\n"
          "These are intended for debugging/testing purposes, when you want to be able to see what "
          "these existing compilers do with the \"same\" input and options"},
+        {OptionKind::SpirvOptimizationPreset,
+         "-spirv-opt-preset",
+         "-spirv-opt-preset <spirv-optimization-preset>",
+         "Select the passes spirv-opt runs on SPIR-V output, instead of picking them from the "
+         "optimization level."},
     };
 
     _addOptions(makeConstArrayView(downstreamOpts), options);
@@ -1125,6 +1382,10 @@ struct OptionsParser
     void _appendMinimalUsage(StringBuilder& out);
     void _outputMinimalUsage();
 
+    /// When a performance benchmark is requested, report the time spent compiling and saving the
+    /// core module so far.
+    void _reportCoreModuleBenchmark();
+
     SlangResult addReferencedModule(String path, SourceLoc loc, bool includeEntryPoint);
     SlangResult _parseReferenceModule(const CommandLineArg& arg);
     SlangResult _parseReproFileSystem(const CommandLineArg& arg);
@@ -1634,6 +1895,20 @@ void OptionsParser::_appendMinimalUsage(StringBuilder& out)
     out << "For help: slangc -h\n";
 }
 
+void OptionsParser::_reportCoreModuleBenchmark()
+{
+    if (!m_requestImpl->getLinkage()->m_optionSet.getBoolOption(
+            CompilerOptionName::ReportPerfBenchmark))
+        return;
+
+    StringBuilder perfResult;
+    PerformanceProfiler::getProfiler()->getResult(perfResult);
+    m_sink->diagnose(
+        SourceLoc(),
+        Diagnostics::performanceBenchmarkResult,
+        perfResult.produceString());
+}
+
 
 SlangResult OptionsParser::_getValue(
     ValueCategory valueCategory,
@@ -2118,7 +2393,30 @@ SlangResult OptionsParser::_parse(int argc, char const* const* argv)
         case OptionKind::DumpReproOnError:
         case OptionKind::ReportDownstreamTime:
         case OptionKind::ReportPerfBenchmark:
+        case OptionKind::ReportIRPassStatistics:
+        case OptionKind::DownstreamResultCache:
+        case OptionKind::MapBinaryModules:
+        case OptionKind::DeferFunctionBodyChecking:
+        case OptionKind::ReflectionJSONCompact:
+        case OptionKind::ShareGenericSpecializations:
+        case OptionKind::ShareForwardDerivatives:
         case OptionKind::ReportCheckpointIntermediates:
+        case OptionKind::ReportRegisterPressure:
+        case OptionKind::InstrumentProfileCounters:
+        case OptionKind::TrimUnusedUniformFields:
+        case OptionKind::PackGlobalUniforms:
+        case OptionKind::BatchEntryPoints:
+        case OptionKind::ContiguousTensorVariants:
+        case OptionKind::CacheTensorViews:
+        case OptionKind::PadGroupSharedArrays:
+        case OptionKind::ReportOptimizationRemarks:
+        case OptionKind::ReportShaderCost:
+        case OptionKind::IncrementalCodeGen:
+        case OptionKind::LowerReferencedFunctionsOnly:
+        case OptionKind::ReleaseIntermediateIR:
+        case OptionKind::IndexSearchDirectories:
+        case OptionKind::PrefetchImportedModules:
+        case OptionKind::AggressiveExpressionFolding:
         case OptionKind::SkipSPIRVValidation:
         case OptionKind::DisableSpecialization:
         case OptionKind::DisableDynamicDispatch:
@@ -2173,9 +2471,9 @@ SlangResult OptionsParser::_parse(int argc, char const* const* argv)
                 SLANG_RETURN_ON_FAIL(
                     m_session->loadCoreModule(contents.getData(), contents.getSizeInBytes()));
 
-                // Ensure that the linkage's AST builder is up-to-date.
-                linkage->getASTBuilder()->m_cachedNodes =
-                    asInternal(m_session)->getGlobalASTBuilder()->m_cachedNodes;
+                // Ensure that the linkage's AST builder finds the Vals of the new core
+                // module, rather than any it created before.
+                linkage->getASTBuilder()->m_cachedNodes.clear();
 
                 break;
             }
@@ -2199,6 +2497,7 @@ SlangResult OptionsParser::_parse(int argc, char const* const* argv)
                     fileName.value,
                     blob->getBufferPointer(),
                     blob->getBufferSize()));
+                _reportCoreModuleBenchmark();
                 break;
             }
         case OptionKind::SaveCoreModuleBinSource:
@@ -2210,16 +2509,21 @@ SlangResult OptionsParser::_parse(int argc, char const* const* argv)
 
                 SLANG_RETURN_ON_FAIL(m_session->saveCoreModule(m_archiveType, blob.writeRef()));
 
-                StringBuilder builder;
-                StringWriter writer(&builder, 0);
+                {
+                    SLANG_PROFILE_SECTION(dumpCoreModuleSource);
+
+                    StringBuilder builder;
+                    StringWriter writer(&builder, 0);
 
-                SLANG_RETURN_ON_FAIL(HexDumpUtil::dumpSourceBytes(
-                    (const uint8_t*)blob->getBufferPointer(),
-                    blob->getBufferSize(),
-                    16,
-                    &writer));
+                    SLANG_RETURN_ON_FAIL(HexDumpUtil::dumpSourceBytes(
+                        (const uint8_t*)blob->getBufferPointer(),
+                        blob->getBufferSize(),
+                        16,
+                        &writer));
 
-                File::writeAllText(fileName.value, builder);
+                    File::writeAllText(fileName.value, builder);
+                }
+                _reportCoreModuleBenchmark();
                 break;
             }
         case OptionKind::DumpIrIds:
@@ -2234,6 +2538,29 @@ SlangResult OptionsParser::_parse(int argc, char const* const* argv)
                 linkage->m_optionSet.set(CompilerOptionName::DumpIntermediatePrefix, prefix.value);
                 break;
             }
+        case OptionKind::ProfileCounts:
+            {
+                CommandLineArg path;
+                SLANG_RETURN_ON_FAIL(m_reader.expectArg(path));
+                linkage->m_optionSet.set(CompilerOptionName::ProfileCounts, path.value);
+                break;
+            }
+        case OptionKind::OptimizationRemarksFile:
+            {
+                CommandLineArg path;
+                SLANG_RETURN_ON_FAIL(m_reader.expectArg(path));
+                linkage->m_optionSet.set(CompilerOptionName::OptimizationRemarksFile, path.value);
+                break;
+            }
+        case OptionKind::DebugInfoFunctions:
+            {
+                CommandLineArg names;
+                SLANG_RETURN_ON_FAIL(m_reader.expectArg(names));
+                linkage->m_optionSet.add(
+                    OptionKind::DebugInfoFunctions,
+                    names.value.getUnownedSlice());
+                break;
+            }
         case OptionKind::Doc:
             {
                 // When compiling the core module, it will write out a documentation.
@@ -2676,6 +3003,70 @@ SlangResult OptionsParser::_parse(int argc, char const* const* argv)
                 linkage->m_optionSet.set(CompilerOptionName::EmitReflectionJSON, outputPath.value);
                 break;
             }
+        case OptionKind::EmitReflectionBinary:
+            {
+                CommandLineArg outputPath;
+                SLANG_RETURN_ON_FAIL(m_reader.expectArg(outputPath));
+
+                linkage->m_optionSet.set(
+                    CompilerOptionName::EmitReflectionBinary,
+                    outputPath.value);
+                break;
+            }
+        case OptionKind::ReflectionJSONFilter:
+            {
+                CommandLineArg names;
+                SLANG_RETURN_ON_FAIL(m_reader.expectArg(names));
+
+                linkage->m_optionSet.set(CompilerOptionName::ReflectionJSONFilter, names.value);
+                break;
+            }
+        case OptionKind::TraceOutput:
+            {
+                CommandLineArg outputPath;
+                SLANG_RETURN_ON_FAIL(m_reader.expectArg(outputPath));
+
+                linkage->m_optionSet.set(CompilerOptionName::TraceOutput, outputPath.value);
+                break;
+            }
+        case OptionKind::DownstreamThreadCount:
+            {
+                Int threadCount = 0;
+                SLANG_RETURN_ON_FAIL(_expectInt(arg, threadCount));
+
+                linkage->m_optionSet.set(
+                    CompilerOptionName::DownstreamThreadCount,
+                    int(threadCount));
+                break;
+            }
+        case OptionKind::OptimizationThreadCount:
+            {
+                Int threadCount = 0;
+                SLANG_RETURN_ON_FAIL(_expectInt(arg, threadCount));
+
+                linkage->m_optionSet.set(
+                    CompilerOptionName::OptimizationThreadCount,
+                    int(threadCount));
+                break;
+            }
+        case OptionKind::FrontEndThreadCount:
+            {
+                Int threadCount = 0;
+                SLANG_RETURN_ON_FAIL(_expectInt(arg, threadCount));
+
+                linkage->m_optionSet.set(CompilerOptionName::FrontEndThreadCount, int(threadCount));
+                break;
+            }
+        case OptionKind::IRPassStatisticsJSON:
+            {
+                CommandLineArg outputPath;
+                SLANG_RETURN_ON_FAIL(m_reader.expectArg(outputPath));
+
+                linkage->m_optionSet.set(
+                    CompilerOptionName::IRPassStatisticsJSON,
+                    outputPath.value);
+                break;
+            }
         case OptionKind::DepFile:
             {
                 CommandLineArg dependencyPath;
@@ -2694,6 +3085,14 @@ SlangResult OptionsParser::_parse(int argc, char const* const* argv)
                 }
                 break;
             }
+        case OptionKind::PrecompileModules:
+            {
+                CommandLineArg outputDir;
+                SLANG_RETURN_ON_FAIL(m_reader.expectArg(outputDir));
+
+                m_requestImpl->m_precompiledModuleOutputDir = outputDir.value;
+                break;
+            }
         case OptionKind::LineDirectiveMode:
             {
                 SlangLineDirectiveMode value;
@@ -2701,6 +3100,60 @@ SlangResult OptionsParser::_parse(int argc, char const* const* argv)
                 m_compileRequest->setLineDirectiveMode(value);
                 break;
             }
+        case OptionKind::SpirvOptimizationPreset:
+            {
+                SlangSpirvOptimizationPreset value;
+                SLANG_RETURN_ON_FAIL(_expectValue(value));
+                linkage->m_optionSet.set(CompilerOptionName::SpirvOptimizationPreset, value);
+                break;
+            }
+        case OptionKind::AutodiffCheckpointPolicy:
+            {
+                SlangAutodiffCheckpointPolicy value;
+                SLANG_RETURN_ON_FAIL(_expectValue(value));
+                linkage->m_optionSet.set(CompilerOptionName::AutodiffCheckpointPolicy, value);
+                break;
+            }
+        case OptionKind::AutodiffRecomputeBudget:
+            {
+                Int budget = 0;
+                SLANG_RETURN_ON_FAIL(_expectInt(arg, budget));
+
+                linkage->m_optionSet.set(CompilerOptionName::AutodiffRecomputeBudget, int(budget));
+                break;
+            }
+        case OptionKind::MemoryBudget:
+            {
+                Int budget = 0;
+                SLANG_RETURN_ON_FAIL(_expectInt(arg, budget));
+
+                linkage->m_optionSet.set(CompilerOptionName::MemoryBudget, int(budget));
+                break;
+            }
+        case OptionKind::LoopUnrollBudget:
+            {
+                Int budget = 0;
+                SLANG_RETURN_ON_FAIL(_expectInt(arg, budget));
+
+                linkage->m_optionSet.set(CompilerOptionName::LoopUnrollBudget, int(budget));
+                break;
+            }
+        case OptionKind::CompressIdleModuleIR:
+            {
+                Int seconds = 0;
+                SLANG_RETURN_ON_FAIL(_expectInt(arg, seconds));
+
+                linkage->m_optionSet.set(CompilerOptionName::CompressIdleModuleIR, int(seconds));
+                break;
+            }
+        case OptionKind::CPUThreadSIMDWidth:
+            {
+                Int width = 0;
+                SLANG_RETURN_ON_FAIL(_expectInt(arg, width));
+
+                linkage->m_optionSet.set(CompilerOptionName::CPUThreadSIMDWidth, int(width));
+                break;
+            }
         case OptionKind::FloatingPointMode:
             {
                 FloatingPointMode value;
@@ -2504,6 +2504,12 @@ struct ScopeLayoutBuilder
     //
     StructTypeLayoutBuilder m_pendingDataTypeLayoutBuilder;
 
+    // When set, the ordinary data of the parameters is laid out in the order that needs the
+    // least padding, once all the parameters are added, rather than in declaration order.
+    //
+    bool m_packUniformData = false;
+    List<RefPtr<VarLayout>> m_uniformParams;
+
     void beginLayout(ParameterBindingContext* context, TypeLayoutContext layoutContext)
     {
         m_context = context;
@@ -2522,22 +2528,78 @@ struct ScopeLayoutBuilder
         beginLayout(context, context->layoutContext);
     }
 
-    void _addParameter(RefPtr<VarLayout> varLayout)
+    static UniformLayoutInfo _getUniformLayoutInfo(VarLayout* varLayout)
     {
-        // Does the parameter have any uniform data?
         auto layoutInfo = varLayout->typeLayout->FindResourceInfo(LayoutResourceKind::Uniform);
         LayoutSize uniformSize = layoutInfo ? layoutInfo->count : 0;
-        if (uniformSize != 0)
+        return UniformLayoutInfo(uniformSize, varLayout->typeLayout->uniformAlignment);
+    }
+
+    void _addUniformData(VarLayout* varLayout)
+    {
+        auto rules = m_layoutContext.rules;
+        LayoutSize uniformOffset =
+            rules->AddStructField(&m_structLayoutInfo, _getUniformLayoutInfo(varLayout));
+
+        varLayout->findOrAddResourceInfo(LayoutResourceKind::Uniform)->index =
+            uniformOffset.getFiniteValue();
+    }
+
+    // Lay out the ordinary data of the parameters in `m_uniformParams`, by repeatedly
+    // picking the one that needs the least padding at the current offset, and among those
+    // the most aligned and then the largest one. Parameters of unbounded size go last.
+    //
+    void _packUniformData()
+    {
+        auto rules = m_layoutContext.rules;
+        List<RefPtr<VarLayout>> remainingParams = _Move(m_uniformParams);
+        while (remainingParams.getCount() != 0)
         {
-            // Make sure uniform fields get laid out properly...
+            Index bestIndex = 0;
+            LayoutSize::RawValue bestPadding = 0;
+            UniformLayoutInfo bestInfo;
+            bool foundFiniteParam = false;
+            for (Index i = 0; i < remainingParams.getCount(); i++)
+            {
+                auto fieldInfo = _getUniformLayoutInfo(remainingParams[i]);
+                if (fieldInfo.size.isInfinite())
+                    continue;
 
-            UniformLayoutInfo fieldInfo(uniformSize, varLayout->typeLayout->uniformAlignment);
+                UniformLayoutInfo structInfo = m_structLayoutInfo;
+                auto offset = rules->AddStructField(&structInfo, fieldInfo).getFiniteValue();
+                auto padding = offset - m_structLayoutInfo.size.getFiniteValue();
 
-            auto rules = m_layoutContext.rules;
-            LayoutSize uniformOffset = rules->AddStructField(&m_structLayoutInfo, fieldInfo);
+                bool isBetter = !foundFiniteParam || padding < bestPadding;
+                if (foundFiniteParam && padding == bestPadding)
+                {
+                    isBetter = fieldInfo.alignment > bestInfo.alignment ||
+                               (fieldInfo.alignment == bestInfo.alignment &&
+                                fieldInfo.size.getFiniteValue() > bestInfo.size.getFiniteValue());
+                }
+                if (isBetter)
+                {
+                    foundFiniteParam = true;
+                    bestIndex = i;
+                    bestPadding = padding;
+                    bestInfo = fieldInfo;
+                }
+            }
 
-            varLayout->findOrAddResourceInfo(LayoutResourceKind::Uniform)->index =
-                uniformOffset.getFiniteValue();
+            _addUniformData(remainingParams[bestIndex]);
+            remainingParams.removeAt(bestIndex);
+        }
+    }
+
+    void _addParameter(RefPtr<VarLayout> varLayout)
+    {
+        // Does the parameter have any uniform data?
+        if (_getUniformLayoutInfo(varLayout).size != 0)
+        {
+            // Make sure uniform fields get laid out properly...
+            if (m_packUniformData)
+                m_uniformParams.add(varLayout);
+            else
+                _addUniformData(varLayout);
         }
 
         m_structLayout->fields.add(varLayout);
@@ -2620,6 +2682,8 @@ struct ScopeLayoutBuilder
     {
         // Finish computing the layout for the ordindary data (if any).
         //
+        if (m_packUniformData)
+            _packUniformData();
         auto rules = m_layoutContext.rules;
         rules->EndStructLayout(&m_structLayoutInfo);
         m_pendingDataTypeLayoutBuilder.endLayout();
@@ -4050,6 +4114,16 @@ RefPtr<ProgramLayout> generateParameterBindings(TargetProgram* targetProgram, Di
     //
     collectGlobalGenericArguments(&context, program);
 
+    // The layout of a type only depends on the program through the global generic
+    // parameters in scope and the arguments bound to them. A program without any can
+    // reuse the layouts computed for the other programs linked for the same target.
+    //
+    if (programLayout->globalGenericArgs.getCount() == 0 &&
+        program->getSpecializationParamCount() == 0)
+    {
+        context.layoutContext.layoutCache = targetReq->getTypeLayoutCache();
+    }
+
     // Next we want to collect a full listing of all the shader
     // parameters that need to be considered for layout, along
     // with all of the entry points, which also need their
@@ -4321,8 +4395,13 @@ RefPtr<ProgramLayout> generateParameterBindings(TargetProgram* targetProgram, Di
     // to encapsulate the logic that can be shared with the entry-point
     // case.
     //
+    // The global-scope uniforms are fields of a structure the compiler synthesizes, so their
+    // order is up to us.
+    //
     ScopeLayoutBuilder globalScopeLayoutBuilder;
     globalScopeLayoutBuilder.beginLayout(&context);
+    globalScopeLayoutBuilder.m_packUniformData =
+        targetProgram->getOptionSet().getBoolOption(CompilerOptionName::PackGlobalUniforms);
     for (auto& parameterInfo : sharedContext.parameters)
     {
         globalScopeLayoutBuilder.addParameter(parameterInfo);
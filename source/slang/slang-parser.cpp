@@ -1061,6 +1061,11 @@ static Token peekToken(Parser* parser)
 
 static SyntaxDecl* tryLookUpSyntaxDecl(Parser* parser, Name* name)
 {
+    // Most identifiers aren't keywords, and for those we can skip the
+    // lookup, which has to search every scope up to the core module.
+    if (!name || !name->isSyntaxDeclName.load(std::memory_order_relaxed))
+        return nullptr;
+
     // Let's look up the name and see what we find.
 
     auto lookupResult = lookUp(
@@ -4245,6 +4250,8 @@ static NodeBase* parseSyntaxDecl(Parser* parser, void* /*userData*/)
     SyntaxDecl* syntaxDecl = parser->astBuilder->create<SyntaxDecl>();
     syntaxDecl->nameAndLoc = nameAndLoc;
     syntaxDecl->loc = nameAndLoc.loc;
+    if (nameAndLoc.name)
+        nameAndLoc.name->isSyntaxDeclName = true;
     syntaxDecl->syntaxClass = syntaxClass;
     syntaxDecl->parseCallback = parseCallback;
     syntaxDecl->parseUserData = parseUserData;
@@ -8055,6 +8062,7 @@ static void addBuiltinSyntaxImpl(
 
     SyntaxDecl* syntaxDecl = globalASTBuilder->create<SyntaxDecl>();
     syntaxDecl->nameAndLoc = NameLoc(name);
+    name->isSyntaxDeclName = true;
     syntaxDecl->syntaxClass = syntaxClass;
     syntaxDecl->parseCallback = callback;
     syntaxDecl->parseUserData = userData;
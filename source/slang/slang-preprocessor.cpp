@@ -16,6 +16,9 @@
 #include "slang-diagnostics.h"
 
 #include <assert.h>
+#include <atomic>
+#include <thread>
+#include <vector>
 
 namespace Slang
 {
@@ -492,7 +495,12 @@ struct LexerInputStream : InputStream
 {
     typedef InputStream Super;
 
-    LexerInputStream(Preprocessor* preprocessor, SourceView* sourceView);
+    /// If `cachedTokens` is set tokens are read from it rather than lexed, but the lexer is still
+    /// set up so the source view and lexer flags can be used as usual.
+    LexerInputStream(
+        Preprocessor* preprocessor,
+        SourceView* sourceView,
+        PreprocessorTokenCache::Entry* cachedTokens);
 
     Lexer* getLexer() { return &m_lexer; }
 
@@ -513,6 +521,17 @@ private:
     /// Read a token from the lexer, bypassing lookahead
     Token _readTokenImpl()
     {
+        if (m_cachedTokens)
+        {
+            const auto& tokens = m_cachedTokens->tokens.m_tokens;
+            Token token = tokens[m_cachedTokenIndex];
+            // Keep returning the end of file token once it is reached.
+            if (m_cachedTokenIndex + 1 < tokens.getCount())
+                m_cachedTokenIndex++;
+            token.loc = token.loc + m_cachedLocOffset;
+            return token;
+        }
+
         for (;;)
         {
             Token token = m_lexer.lexToken();
@@ -532,6 +551,12 @@ private:
     /// The lexer state that will provide input
     Lexer m_lexer;
 
+    /// Tokens to read instead of lexing, if set
+    RefPtr<PreprocessorTokenCache::Entry> m_cachedTokens;
+    Index m_cachedTokenIndex = 0;
+    /// Moves the locations of cached tokens into this stream's source view
+    Int m_cachedLocOffset = 0;
+
     /// One token of lookahead
     Token m_lookaheadToken;
 };
@@ -891,7 +916,10 @@ private:
 ///
 struct InputFile
 {
-    InputFile(Preprocessor* preprocessor, SourceView* sourceView);
+    InputFile(
+        Preprocessor* preprocessor,
+        SourceView* sourceView,
+        PreprocessorTokenCache::Entry* cachedTokens = nullptr);
 
     ~InputFile();
 
@@ -927,6 +955,34 @@ struct InputFile
 
     bool isIncludedFile() { return m_parent != nullptr; }
 
+    /// How far detecting an include guard wrapping the whole file has got
+    enum class IncludeGuardState
+    {
+        /// Nothing other than newlines has been read
+        Start,
+        /// Inside the `#ifndef` that may be an include guard
+        Inside,
+        /// After the `#endif` that ends the include guard
+        AfterEnd,
+        /// The file isn't wrapped in an include guard
+        None,
+    };
+
+    IncludeGuardState m_includeGuardState = IncludeGuardState::Start;
+
+    /// The conditional started by the include guard's `#ifndef`, while inside it
+    Conditional* m_includeGuardConditional = nullptr;
+
+    /// The macro name the include guard checks
+    Name* m_includeGuardName = nullptr;
+
+    /// Note that the file has content outside of an include guard
+    void clearIncludeGuard()
+    {
+        m_includeGuardState = IncludeGuardState::None;
+        m_includeGuardConditional = nullptr;
+    }
+
 private:
     friend struct Preprocessor;
 
@@ -981,6 +1037,11 @@ struct Preprocessor
     /// stop them from being included again.
     HashSet<String> pragmaOnceUniqueIdentities;
 
+    /// Maps the unique identities of files wrapped in an include guard to the macro name it
+    /// checks. Including such a file while the macro is defined would skip everything in it,
+    /// so it isn't read again.
+    Dictionary<String, Name*> includeGuardNames;
+
     /// Name pool to use when creating `Name`s from strings
     NamePool* namePool = nullptr;
 
@@ -999,6 +1060,9 @@ struct Preprocessor
     /// Stores macro definition and invocation info for language server.
     PreprocessorContentAssistInfo* contentAssistInfo = nullptr;
 
+    /// Cache of tokens lexed from included files, if set
+    PreprocessorTokenCache* tokenCache = nullptr;
+
     NamePool* getNamePool() { return namePool; }
     SourceManager* getSourceManager() { return sourceManager; }
 
@@ -1073,19 +1137,30 @@ DiagnosticSink* InputStream::getSink()
 // Basic Input Handling
 //
 
-LexerInputStream::LexerInputStream(Preprocessor* preprocessor, SourceView* sourceView)
-    : Super(preprocessor)
+LexerInputStream::LexerInputStream(
+    Preprocessor* preprocessor,
+    SourceView* sourceView,
+    PreprocessorTokenCache::Entry* cachedTokens)
+    : Super(preprocessor), m_cachedTokens(cachedTokens)
 {
     MemoryArena* memoryArena = sourceView->getSourceManager()->getMemoryArena();
     m_lexer.initialize(sourceView, GetSink(preprocessor), preprocessor->getNamePool(), memoryArena);
+    if (cachedTokens)
+    {
+        m_cachedLocOffset =
+            Int(sourceView->getRange().begin.getRaw()) - Int(cachedTokens->startLoc.getRaw());
+    }
     m_lookaheadToken = _readTokenImpl();
 }
 
-InputFile::InputFile(Preprocessor* preprocessor, SourceView* sourceView)
+InputFile::InputFile(
+    Preprocessor* preprocessor,
+    SourceView* sourceView,
+    PreprocessorTokenCache::Entry* cachedTokens)
 {
     m_preprocessor = preprocessor;
 
-    m_lexerStream = new LexerInputStream(preprocessor, sourceView);
+    m_lexerStream = new LexerInputStream(preprocessor, sourceView, cachedTokens);
     m_expansionStream = new ExpansionInputStream(preprocessor, m_lexerStream);
 }
 
@@ -2950,6 +3025,15 @@ static void HandleIfNDefDirective(PreprocessorDirectiveContext* context)
 
     // Check if the name is defined.
     beginConditional(context, LookupMacro(context, name) == NULL);
+
+    // An `#ifndef` before anything else in the file may start an include guard.
+    InputFile* inputFile = getInputFile(context);
+    if (inputFile->m_includeGuardState == InputFile::IncludeGuardState::Start)
+    {
+        inputFile->m_includeGuardState = InputFile::IncludeGuardState::Inside;
+        inputFile->m_includeGuardConditional = inputFile->getInnerMostConditional();
+        inputFile->m_includeGuardName = name;
+    }
 }
 
 // Handle a `#else` directive
@@ -2981,6 +3065,10 @@ static void HandleElseDirective(PreprocessorDirectiveContext* context)
     }
     conditional->elseToken = context->m_directiveToken;
 
+    // Content in an `#else` of the include guard would be read when the guard is defined.
+    if (conditional == inputFile->m_includeGuardConditional)
+        inputFile->clearIncludeGuard();
+
     switch (conditional->state)
     {
     case Conditional::State::Before:
@@ -3044,6 +3132,9 @@ static void HandleElifDirective(PreprocessorDirectiveContext* context)
         return;
     }
 
+    if (conditional == inputFile->m_includeGuardConditional)
+        inputFile->clearIncludeGuard();
+
     switch (conditional->state)
     {
     case Conditional::State::Before:
@@ -3091,6 +3182,12 @@ static void HandleEndIfDirective(PreprocessorDirectiveContext* context)
         return;
     }
 
+    if (conditional == inputFile->m_includeGuardConditional)
+    {
+        inputFile->m_includeGuardState = InputFile::IncludeGuardState::AfterEnd;
+        inputFile->m_includeGuardConditional = nullptr;
+    }
+
     inputFile->popConditional();
 
     updateLexerFlagsForConditionals(inputFile);
@@ -3229,6 +3326,15 @@ static void HandleIncludeDirective(PreprocessorDirectiveContext* context)
         return;
     }
 
+    // Check whether the file is wrapped in an include guard that is now defined, in which case
+    // including it again would skip all of it.
+    if (auto includeGuardName =
+            context->m_preprocessor->includeGuardNames.tryGetValue(filePathInfo.uniqueIdentity))
+    {
+        if (LookupMacro(context, *includeGuardName))
+            return;
+    }
+
     // Simplify the path
     filePathInfo.foundPath = includeSystem->simplifyPath(filePathInfo.foundPath);
 
@@ -3265,7 +3371,13 @@ static void HandleIncludeDirective(PreprocessorDirectiveContext* context)
     SourceView* sourceView =
         sourceManager->createSourceView(sourceFile, &filePathInfo, directiveLoc);
 
-    InputFile* inputFile = new InputFile(context->m_preprocessor, sourceView);
+    // Included files are often included by many translation units, so their tokens are
+    // worth caching.
+    PreprocessorTokenCache::Entry* cachedTokens = nullptr;
+    if (auto tokenCache = context->m_preprocessor->tokenCache)
+        cachedTokens = tokenCache->getOrLexTokens(sourceView, context->m_preprocessor->namePool);
+
+    InputFile* inputFile = new InputFile(context->m_preprocessor, sourceView, cachedTokens);
 
     context->m_preprocessor->pushInputFile(inputFile);
 }
@@ -4009,6 +4121,21 @@ static void HandleDirective(PreprocessorDirectiveContext* context)
     // Look up the handler for the directive.
     PreprocessorDirective const* directive = FindDirective(GetDirectiveName(context));
 
+    // Directives outside of an include guard mean the file isn't wrapped in one.
+    InputFile* inputFile = getInputFile(context);
+    switch (inputFile->m_includeGuardState)
+    {
+    case InputFile::IncludeGuardState::Start:
+        if (directive->callback != &HandleIfNDefDirective)
+            inputFile->clearIncludeGuard();
+        break;
+    case InputFile::IncludeGuardState::AfterEnd:
+        inputFile->clearIncludeGuard();
+        break;
+    default:
+        break;
+    }
+
     // If we are skipping disabled code, and the directive is not one
     // of the small number that need to run even in that case, skip it.
     if (isSkipping(context) && !(directive->flags & PreprocessorDirectiveFlag::ProcessWhenSkipping))
@@ -4057,6 +4184,17 @@ void Preprocessor::popInputFile()
             conditional->ifToken.getContent());
     }
 
+    // If the whole file was wrapped in an include guard, it needn't be read again while
+    // the guard's macro is defined.
+    //
+    if (inputFile->m_includeGuardState == InputFile::IncludeGuardState::AfterEnd)
+    {
+        SourceFile* sourceFile = inputFile->getLexer()->m_sourceView->getSourceFile();
+        const PathInfo& pathInfo = sourceFile->getPathInfo();
+        if (pathInfo.hasUniqueIdentity())
+            includeGuardNames[pathInfo.uniqueIdentity] = inputFile->m_includeGuardName;
+    }
+
     // We will update the current file to the parent of whatever
     // the `inputFile` was (usually the file that `#include`d it).
     //
@@ -4113,6 +4251,10 @@ static Token ReadToken(Preprocessor* preprocessor)
             continue;
         }
 
+        // Tokens outside of an include guard mean the file isn't wrapped in one.
+        if (token.type != TokenType::NewLine && !inputFile->getInnerMostConditional())
+            inputFile->clearIncludeGuard();
+
         // otherwise, if we are currently in a skipping mode, then skip tokens
         if (inputFile->isSkipping())
         {
@@ -4218,6 +4360,150 @@ static TokenList ReadAllTokens(Preprocessor* preprocessor)
 
 } // namespace preprocessor
 
+/// Lex the content of `sourceView` for the token cache, returning nullptr if lexing it produces
+/// diagnostics. If `namePool` is null, identifiers are left without names.
+static RefPtr<PreprocessorTokenCache::Entry> _lexTokensForCache(
+    SourceView* sourceView,
+    NamePool* namePool)
+{
+    RefPtr<PreprocessorTokenCache::Entry> entry = new PreprocessorTokenCache::Entry;
+    entry->contentBlob = sourceView->getSourceFile()->getContentBlob();
+    entry->namePool = namePool;
+    entry->startLoc = sourceView->getRange().begin;
+
+    // Diagnostics go to a sink of our own, so if there are any the file is lexed again
+    // when it is preprocessed and they are reported as usual. The sink has no source manager
+    // so that it doesn't touch any state shared with other threads.
+    DiagnosticSink sink(nullptr, nullptr);
+
+    Lexer lexer;
+    lexer.initialize(sourceView, &sink, namePool, &entry->memoryArena);
+    for (;;)
+    {
+        const Token token = lexer.lexToken();
+        switch (token.type)
+        {
+        case TokenType::WhiteSpace:
+        case TokenType::BlockComment:
+        case TokenType::LineComment:
+            continue;
+        default:
+            break;
+        }
+        entry->tokens.add(token);
+        if (token.type == TokenType::EndOfFile)
+            break;
+    }
+
+    if (sink.outputBuffer.getLength() != 0)
+        return nullptr;
+    return entry;
+}
+
+PreprocessorTokenCache::Entry* PreprocessorTokenCache::findTokens(
+    SourceView* sourceView,
+    NamePool* namePool)
+{
+    SourceFile* sourceFile = sourceView->getSourceFile();
+    if (!sourceFile->hasContent())
+        return nullptr;
+
+    if (auto found = m_entries.tryGetValue(sourceFile->getDigest()))
+    {
+        Entry* entry = *found;
+        if (entry && entry->namePool == namePool)
+            return entry;
+    }
+    return nullptr;
+}
+
+PreprocessorTokenCache::Entry* PreprocessorTokenCache::getOrLexTokens(
+    SourceView* sourceView,
+    NamePool* namePool)
+{
+    SourceFile* sourceFile = sourceView->getSourceFile();
+    if (!sourceFile->hasContent())
+        return nullptr;
+
+    const SHA1::Digest digest = sourceFile->getDigest();
+    if (auto found = m_entries.tryGetValue(digest))
+    {
+        Entry* entry = *found;
+        return (entry && entry->namePool == namePool) ? entry : nullptr;
+    }
+
+    RefPtr<Entry> entry = _lexTokensForCache(sourceView, namePool);
+    m_entries.add(digest, entry);
+    return entry;
+}
+
+void PreprocessorTokenCache::addTokens(
+    ConstArrayView<SourceView*> sourceViews,
+    NamePool* namePool,
+    Count threadCount)
+{
+    // Find the content that isn't in the cache yet, lexing each distinct content once.
+    List<SourceView*> viewsToLex;
+    List<SHA1::Digest> digestsToLex;
+    HashSet<SHA1::Digest> seenDigests;
+    for (auto sourceView : sourceViews)
+    {
+        SourceFile* sourceFile = sourceView->getSourceFile();
+        if (!sourceFile->hasContent())
+            continue;
+
+        const SHA1::Digest digest = sourceFile->getDigest();
+        if (m_entries.containsKey(digest) || !seenDigests.add(digest))
+            continue;
+
+        viewsToLex.add(sourceView);
+        digestsToLex.add(digest);
+    }
+
+    const Count viewCount = viewsToLex.getCount();
+    List<RefPtr<Entry>> entries;
+    entries.setCount(viewCount);
+
+    // The name pool isn't thread safe, so identifiers are named once all the lexing is done.
+    std::atomic<Index> nextViewIndex(0);
+    auto worker = [&]()
+    {
+        for (;;)
+        {
+            const Index viewIndex = nextViewIndex++;
+            if (viewIndex >= viewCount)
+                break;
+            entries[viewIndex] = _lexTokensForCache(viewsToLex[viewIndex], nullptr);
+        }
+    };
+
+    // This thread lexes too, so it only needs `threadCount - 1` helpers.
+    std::vector<std::thread> threads;
+    const Count helperCount = Math::Min(threadCount, viewCount) - 1;
+    for (Index i = 0; i < helperCount; ++i)
+        threads.emplace_back(worker);
+    worker();
+    for (auto& thread : threads)
+        thread.join();
+
+    for (Index i = 0; i < viewCount; ++i)
+    {
+        if (auto entry = entries[i])
+        {
+            entry->namePool = namePool;
+            for (auto& token : entry->tokens.m_tokens)
+            {
+                if (token.type == TokenType::Identifier ||
+                    token.type == TokenType::CompletionRequest)
+                {
+                    token.setName(namePool->getName(token.getContent()));
+                }
+            }
+        }
+        m_entries.add(digestsToLex[i], entries[i]);
+    }
+}
+
 /// Try to look up a macro with the given `macroName` and produce its value as a string
 Result findMacroValue(
     Preprocessor* preprocessor,
@@ -4286,6 +4572,12 @@ TokenList preprocessSource(
     {
         desc.contentAssistInfo = &linkage->contentAssistInfo.preprocessorInfo;
     }
+    else
+    {
+        // Not used by the language server, where files are edited as they are worked on, so the
+        // cache would mostly hold stale content.
+        desc.tokenCache = linkage->getPreprocessorTokenCache();
+    }
     return preprocessSource(file, desc, outDetectedLanguage);
 }
 
@@ -4306,6 +4598,7 @@ TokenList preprocessSource(
     preprocessor.endOfFileToken.type = TokenType::EndOfFile;
     preprocessor.endOfFileToken.flags = TokenFlag::AtStartOfLine;
     preprocessor.contentAssistInfo = desc.contentAssistInfo;
+    preprocessor.tokenCache = desc.tokenCache;
 
     // Add builtin macros
     {
@@ -4351,7 +4644,12 @@ TokenList preprocessSource(
             sourceManager->createSourceView(file, nullptr, SourceLoc::fromRaw(0));
 
         // create an initial input stream based on the provided buffer
-        InputFile* primaryInputFile = new InputFile(&preprocessor, sourceView);
+        // The primary file is only in the token cache if it was lexed ahead of time.
+        PreprocessorTokenCache::Entry* cachedTokens = nullptr;
+        if (auto tokenCache = desc.tokenCache)
+            cachedTokens = tokenCache->findTokens(sourceView, desc.namePool);
+
+        InputFile* primaryInputFile = new InputFile(&preprocessor, sourceView, cachedTokens);
         preprocessor.pushInputFile(primaryInputFile);
     }
 
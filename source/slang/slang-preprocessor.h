@@ -5,6 +5,8 @@
 #include "../compiler-core/slang-include-system.h"
 #include "../compiler-core/slang-lexer.h"
 #include "../core/slang-basic.h"
+#include "../core/slang-crypto.h"
+#include "../core/slang-memory-arena.h"
 
 namespace Slang
 {
@@ -33,6 +35,51 @@ struct PreprocessorHandler
     virtual void handleFileDependency(SourceFile* sourceFile);
 };
 
+/// Tokens lexed from files included by the preprocessor, which can be shared between the
+/// translation units a `Linkage` preprocesses.
+///
+/// Files are keyed by a digest of their content, so a header included by many translation
+/// units is only lexed once. Only content that lexes without diagnostics is cached, as they
+/// wouldn't be reported when tokens are replayed from the cache.
+class PreprocessorTokenCache
+{
+public:
+    struct Entry : RefObject
+    {
+        Entry()
+            : memoryArena(2048)
+        {
+        }
+
+        /// Holds the content tokens point into, so it outlives the source file.
+        ComPtr<ISlangBlob> contentBlob;
+        /// Holds the content of tokens that had escaped newlines removed.
+        MemoryArena memoryArena;
+        /// The name pool identifier tokens were looked up in.
+        NamePool* namePool = nullptr;
+        /// The start of the source view the tokens were lexed in. The tokens can be used in
+        /// another view of the same content by offsetting their locations.
+        SourceLoc startLoc;
+        /// The tokens other than whitespace and comments, ending with the end of file.
+        TokenList tokens;
+    };
+
+    /// Get the tokens for the content of `sourceView`, lexing it if it isn't in the cache.
+    /// Returns nullptr if the content can't be cached.
+    Entry* getOrLexTokens(SourceView* sourceView, NamePool* namePool);
+
+    /// Get the tokens for the content of `sourceView` if it is in the cache, or nullptr.
+    Entry* findTokens(SourceView* sourceView, NamePool* namePool);
+
+    /// Lex the content of `sourceViews` that isn't in the cache on up to `threadCount` threads,
+    /// and add it to the cache.
+    void addTokens(ConstArrayView<SourceView*> sourceViews, NamePool* namePool, Count threadCount);
+
+private:
+    // Content that can't be cached maps to null, so it's only lexed once to find out.
+    Dictionary<SHA1::Digest, RefPtr<Entry>> m_entries;
+};
+
 /// Description of a preprocessor options/dependencies
 struct PreprocessorDesc
 {
@@ -59,6 +106,9 @@ struct PreprocessorDesc
 
     /// Optional: additional information for code assist.
     PreprocessorContentAssistInfo* contentAssistInfo = nullptr;
+
+    /// Optional: cache of tokens lexed from included files
+    PreprocessorTokenCache* tokenCache = nullptr;
 };
 
 /// Take a source `file` and preprocess it into a list of tokens.
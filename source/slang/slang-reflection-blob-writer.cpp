@@ -0,0 +1,230 @@
+#include "slang-reflection-blob-writer.h"
+
+#include "../core/slang-blob.h"
+#include "../core/slang-offset-container.h"
+#include "slang-reflection-blob.h"
+
+namespace Slang
+{
+
+namespace
+{ // anonymous
+
+struct ReflectionBlobWriter
+{
+    // The structures are built up on the stack and copied into the container once they are
+    // complete, because any allocation in the container can move its contents.
+    template<typename T>
+    void set(uint32_t offset, const T& value)
+    {
+        ::memcpy(m_container._getRaw(offset), &value, sizeof(T));
+    }
+
+    template<typename T>
+    uint32_t allocateArray(uint32_t count)
+    {
+        return m_container.newArray<T>(count).m_data.m_offset;
+    }
+
+    SlangReflectionBlobArray writeString(const char* text)
+    {
+        SlangReflectionBlobArray result = {0, 0};
+        if (!text || !*text)
+            return result;
+        const uint32_t length = uint32_t(::strlen(text));
+        result.offset = allocateArray<char>(length + 1);
+        result.count = length;
+        ::memcpy(m_container._getRaw(result.offset), text, length + 1);
+        return result;
+    }
+
+    static uint32_t toUInt32(size_t value)
+    {
+        return value >= SLANG_REFLECTION_BLOB_UNBOUNDED ? SLANG_REFLECTION_BLOB_UNBOUNDED
+                                                        : uint32_t(value);
+    }
+
+    SlangReflectionBlobArray writeBindings(slang::VariableLayoutReflection* var)
+    {
+        auto typeLayout = var->getTypeLayout();
+        SlangReflectionBlobArray result = {0, var->getCategoryCount()};
+        if (result.count == 0)
+            return result;
+        result.offset = allocateArray<SlangReflectionBlobBinding>(result.count);
+        for (uint32_t i = 0; i < result.count; i++)
+        {
+            auto category = SlangParameterCategory(var->getCategoryByIndex(i));
+            SlangReflectionBlobBinding binding;
+            binding.category = uint32_t(category);
+            binding.space = toUInt32(var->getBindingSpace(category));
+            binding.index = toUInt32(var->getOffset(category));
+            binding.size = toUInt32(typeLayout->getSize(category));
+            set(result.offset + i * uint32_t(sizeof(binding)), binding);
+        }
+        return result;
+    }
+
+    SlangReflectionBlobArray writeFields(slang::TypeLayoutReflection* typeLayout)
+    {
+        // Look through arrays and buffers to the fields of their element type.
+        for (;;)
+        {
+            switch (typeLayout->getKind())
+            {
+            case slang::TypeReflection::Kind::Array:
+            case slang::TypeReflection::Kind::ConstantBuffer:
+            case slang::TypeReflection::Kind::ParameterBlock:
+            case slang::TypeReflection::Kind::TextureBuffer:
+            case slang::TypeReflection::Kind::ShaderStorageBuffer:
+                if (auto elementTypeLayout = typeLayout->getElementTypeLayout())
+                {
+                    typeLayout = elementTypeLayout;
+                    continue;
+                }
+                break;
+            default:
+                break;
+            }
+            break;
+        }
+
+        SlangReflectionBlobArray result = {0, 0};
+        if (typeLayout->getKind() != slang::TypeReflection::Kind::Struct)
+            return result;
+        result.count = typeLayout->getFieldCount();
+        if (result.count == 0)
+            return result;
+        result.offset = allocateArray<SlangReflectionBlobVar>(result.count);
+        for (uint32_t i = 0; i < result.count; i++)
+        {
+            writeVar(
+                result.offset + i * uint32_t(sizeof(SlangReflectionBlobVar)),
+                typeLayout->getFieldByIndex(i));
+        }
+        return result;
+    }
+
+    void writeVar(uint32_t offset, slang::VariableLayoutReflection* var)
+    {
+        auto typeLayout = var->getTypeLayout();
+
+        SlangReflectionBlobVar blobVar;
+        blobVar.name = writeString(var->getName());
+        blobVar.bindings = writeBindings(var);
+        blobVar.fields = writeFields(typeLayout);
+        blobVar.typeKind = uint32_t(typeLayout->getKind());
+        blobVar.elementCount = typeLayout->getKind() == slang::TypeReflection::Kind::Array
+                                   ? toUInt32(typeLayout->getElementCount())
+                                   : 0;
+        set(offset, blobVar);
+    }
+
+    void writeEntryPoint(uint32_t offset, slang::EntryPointReflection* entryPoint)
+    {
+        SlangReflectionBlobEntryPoint blobEntryPoint;
+        blobEntryPoint.name = writeString(entryPoint->getName());
+        blobEntryPoint.stage = uint32_t(entryPoint->getStage());
+
+        SlangUInt threadGroupSize[3] = {0, 0, 0};
+        entryPoint->getComputeThreadGroupSize(3, threadGroupSize);
+        for (int i = 0; i < 3; i++)
+            blobEntryPoint.threadGroupSize[i] = toUInt32(size_t(threadGroupSize[i]));
+
+        blobEntryPoint.parameters = {0, entryPoint->getParameterCount()};
+        if (blobEntryPoint.parameters.count)
+        {
+            blobEntryPoint.parameters.offset =
+                allocateArray<SlangReflectionBlobVar>(blobEntryPoint.parameters.count);
+            for (uint32_t i = 0; i < blobEntryPoint.parameters.count; i++)
+            {
+                writeVar(
+                    blobEntryPoint.parameters.offset +
+                        i * uint32_t(sizeof(SlangReflectionBlobVar)),
+                    entryPoint->getParameterByIndex(i));
+            }
+        }
+        set(offset, blobEntryPoint);
+    }
+
+    void writeProgram(slang::ShaderReflection* program)
+    {
+        // The program is the first thing allocated, so that it is at the offset readers expect.
+        const uint32_t programOffset = m_container.newObject<SlangReflectionBlobProgram>().m_offset;
+        SLANG_ASSERT(programOffset == SLANG_REFLECTION_BLOB_PROGRAM_OFFSET);
+
+        SlangReflectionBlobProgram blobProgram;
+        blobProgram.version = SLANG_REFLECTION_BLOB_VERSION;
+        blobProgram.reserved = 0;
+
+        blobProgram.parameters = {0, program->getParameterCount()};
+        if (blobProgram.parameters.count)
+        {
+            blobProgram.parameters.offset =
+                allocateArray<SlangReflectionBlobVar>(blobProgram.parameters.count);
+            for (uint32_t i = 0; i < blobProgram.parameters.count; i++)
+            {
+                writeVar(
+                    blobProgram.parameters.offset + i * uint32_t(sizeof(SlangReflectionBlobVar)),
+                    program->getParameterByIndex(i));
+            }
+        }
+
+        blobProgram.entryPoints = {0, uint32_t(program->getEntryPointCount())};
+        if (blobProgram.entryPoints.count)
+        {
+            blobProgram.entryPoints.offset =
+                allocateArray<SlangReflectionBlobEntryPoint>(blobProgram.entryPoints.count);
+            for (uint32_t i = 0; i < blobProgram.entryPoints.count; i++)
+            {
+                writeEntryPoint(
+                    blobProgram.entryPoints.offset +
+                        i * uint32_t(sizeof(SlangReflectionBlobEntryPoint)),
+                    program->getEntryPointByIndex(i));
+            }
+        }
+        set(programOffset, blobProgram);
+    }
+
+    OffsetContainer m_container;
+};
+
+} // namespace
+
+SlangResult writeReflectionBlob(SlangReflection* reflection, ComPtr<ISlangBlob>& outBlob)
+{
+    if (!reflection)
+        return SLANG_E_INVALID_ARG;
+
+    ReflectionBlobWriter writer;
+    writer.writeProgram((slang::ShaderReflection*)reflection);
+
+    const size_t dataSize = writer.m_container.getDataCount();
+    if (dataSize >= SLANG_REFLECTION_BLOB_UNBOUNDED)
+        return SLANG_FAIL;
+
+    SlangReflectionBlobHeader header;
+    header.fourCC = SLANG_REFLECTION_BLOB_FOURCC;
+    header.size = uint32_t(dataSize);
+
+    List<uint8_t> data;
+    data.setCount(Index(sizeof(header) + dataSize));
+    ::memcpy(data.getBuffer(), &header, sizeof(header));
+    ::memcpy(data.getBuffer() + sizeof(header), writer.m_container.getData(), dataSize);
+
+    outBlob = ListBlob::moveCreate(data);
+    return SLANG_OK;
+}
+
+} // namespace Slang
+
+extern "C"
+{
+    SLANG_API SlangResult spReflection_ToBinary(SlangReflection* reflection, ISlangBlob** outBlob)
+    {
+        using namespace Slang;
+        ComPtr<ISlangBlob> blob;
+        SLANG_RETURN_ON_FAIL(writeReflectionBlob(reflection, blob));
+        *outBlob = blob.detach();
+        return SLANG_OK;
+    }
+}
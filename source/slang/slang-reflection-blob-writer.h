@@ -0,0 +1,16 @@
+#ifndef SLANG_REFLECTION_BLOB_WRITER_H
+#define SLANG_REFLECTION_BLOB_WRITER_H
+
+#include "slang-com-ptr.h"
+#include "slang.h"
+
+namespace Slang
+{
+
+/// Serialize the binding layout of the parameters and entry points of `reflection` into the
+/// binary format described in `slang-reflection-blob.h`.
+SlangResult writeReflectionBlob(SlangReflection* reflection, ComPtr<ISlangBlob>& outBlob);
+
+} // namespace Slang
+
+#endif
@@ -1094,41 +1094,61 @@ static void emitReflectionEntryPointJSON(
     writer << "\n}";
 }
 
+static bool _isIncluded(const List<String>& includedNames, const char* name)
+{
+    if (includedNames.getCount() == 0)
+        return true;
+    return name && includedNames.contains(UnownedStringSlice(name));
+}
+
 static void emitReflectionJSON(
     PrettyWriter& writer,
     SlangCompileRequest* request,
-    slang::ShaderReflection* programReflection)
+    slang::ShaderReflection* programReflection,
+    const List<String>& includedNames)
 {
     writer << "{\n";
     writer.indent();
     writer << "\"parameters\": [\n";
     writer.indent();
 
+    bool needComma = false;
     auto parameterCount = programReflection->getParameterCount();
     for (auto pp : makeRange(parameterCount))
     {
-        if (pp != 0)
+        auto parameter = programReflection->getParameterByIndex(pp);
+        if (!_isIncluded(includedNames, parameter->getName()))
+            continue;
+
+        if (needComma)
             writer << ",\n";
+        needComma = true;
 
-        auto parameter = programReflection->getParameterByIndex(pp);
         emitReflectionParamJSON(writer, parameter);
     }
 
     writer.dedent();
     writer << "\n]";
 
+    List<int> entryPointIndices;
     auto entryPointCount = programReflection->getEntryPointCount();
-    if (entryPointCount)
+    for (auto ee : makeRange(entryPointCount))
+    {
+        auto entryPoint = programReflection->getEntryPointByIndex(ee);
+        if (_isIncluded(includedNames, entryPoint->getName()))
+            entryPointIndices.add((int)ee);
+    }
+    if (entryPointIndices.getCount())
     {
         writer << ",\n\"entryPoints\": [\n";
         writer.indent();
 
-        for (auto ee : makeRange(entryPointCount))
+        for (Index i = 0; i < entryPointIndices.getCount(); i++)
         {
-            if (ee != 0)
+            if (i != 0)
                 writer << ",\n";
 
-            emitReflectionEntryPointJSON(writer, request, programReflection, (int)ee);
+            emitReflectionEntryPointJSON(writer, request, programReflection, entryPointIndices[i]);
         }
 
         writer.dedent();
@@ -1190,9 +1210,18 @@ void emitReflectionJSON(
     SlangCompileRequest* request,
     SlangReflection* reflection,
     PrettyWriter& writer)
+{
+    emitReflectionJSON(request, reflection, writer, List<String>());
+}
+
+void emitReflectionJSON(
+    SlangCompileRequest* request,
+    SlangReflection* reflection,
+    PrettyWriter& writer,
+    const List<String>& includedNames)
 {
     auto programReflection = (slang::ShaderReflection*)reflection;
-    emitReflectionJSON(writer, request, programReflection);
+    emitReflectionJSON(writer, request, programReflection, includedNames);
 }
 
 } // namespace Slang
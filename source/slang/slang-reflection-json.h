@@ -2,6 +2,7 @@
 #define SLANG_REFLECTION_JSON_H
 
 #include "../compiler-core/slang-pretty-writer.h"
+#include "../core/slang-list.h"
 #include "slang.h"
 
 namespace Slang
@@ -12,6 +13,14 @@ void emitReflectionJSON(
     SlangReflection* reflection,
     PrettyWriter& writer);
 
+/// Emit the reflection data of only the global parameters and entry points whose names are in
+/// `includedNames`. All of them are emitted if it is empty.
+void emitReflectionJSON(
+    SlangCompileRequest* request,
+    SlangReflection* reflection,
+    PrettyWriter& writer,
+    const List<String>& includedNames);
+
 }
 
 #endif
@@ -2,6 +2,8 @@
 #include "slang-serialize-container.h"
 
 #include "../core/slang-byte-encode-util.h"
+#include "../core/slang-io.h"
+#include "../core/slang-lz4-compression-system.h"
 #include "../core/slang-math.h"
 #include "../core/slang-stream.h"
 #include "../core/slang-text-io.h"
@@ -154,8 +156,31 @@ namespace Slang
         }
         Path::getCanonical(linkageRoot, linkageRoot);
 
+        // The files can only be stamped if their found paths are paths in the OS file system.
+        auto fileSystem = module->getLinkage() ? module->getLinkage()->getFileSystemExt() : nullptr;
+        const bool canStampFiles = fileSystem && fileSystem->getOSPathKind() == OSPathKind::Direct;
+
         for (auto file : fileDependencies)
         {
+            SerialContainerDataModule::FileStamp stamp;
+            stamp.digest = file->getDigest();
+            if (canStampFiles && file->getPathInfo().hasFileFoundPath())
+            {
+                uint64_t modifiedTime = 0, size = 0;
+                // If the size on disk doesn't match the contents that were compiled, the file has
+                // changed since, and the stamp would hide that.
+                if (SLANG_SUCCEEDED(File::getModifiedTimeAndSize(
+                        file->getPathInfo().foundPath,
+                        modifiedTime,
+                        size)) &&
+                    size == file->getContentSize())
+                {
+                    stamp.modifiedTime = modifiedTime;
+                    stamp.size = size;
+                }
+            }
+            dstModule.dependentFileStamps.add(stamp);
+
             if (file->getPathInfo().hasFoundPath())
             {
                 String canonicalFilePath = file->getPathInfo().foundPath;
@@ -340,6 +365,17 @@ namespace Slang
                 uint32_t fileListLength = (uint32_t)filePathsSB.getLength();
                 headerMemStream.write(&fileListLength, sizeof(uint32_t));
                 headerMemStream.write(filePathsSB.getBuffer(), fileListLength);
+
+                // The stamps follow the file list, so readers that don't know about them stop
+                // before them.
+                uint32_t stampCount = (uint32_t)module.dependentFileStamps.getCount();
+                headerMemStream.write(&stampCount, sizeof(uint32_t));
+                for (const auto& stamp : module.dependentFileStamps)
+                {
+                    headerMemStream.write(stamp.digest.data, sizeof(stamp.digest.data));
+                    headerMemStream.write(&stamp.modifiedTime, sizeof(uint64_t));
+                    headerMemStream.write(&stamp.size, sizeof(uint64_t));
+                }
                 container->write(
                     headerMemStream.getContents().getBuffer(),
                     headerMemStream.getContents().getCount());
@@ -470,6 +506,172 @@ namespace Slang
     return SLANG_OK;
 }
 
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! SerialDeferredIRModule !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+
+SerialDeferredIRModule::SerialDeferredIRModule(
+    RefObject* containerOwner,
+    RiffContainer::ListChunk* irChunk,
+    SerialCompressionType compressionType,
+    SerialSourceLocReader* sourceLocReader,
+    Session* session)
+    : m_containerOwner(containerOwner)
+    , m_irChunk(irChunk)
+    , m_compressionType(compressionType)
+    , m_sourceLocReader(sourceLocReader)
+    , m_session(session)
+{
+}
+
+SerialDeferredIRModule::~SerialDeferredIRModule() {}
+
+SlangResult SerialDeferredIRModule::_read(RefPtr<IRModule>& outIRModule)
+{
+    IRSerialData serialData;
+    SLANG_RETURN_ON_FAIL(IRSerialReader::readContainer(m_irChunk, m_compressionType, &serialData));
+
+    IRSerialReader reader;
+    SLANG_RETURN_ON_FAIL(reader.read(serialData, m_session, m_sourceLocReader, outIRModule));
+    return SLANG_OK;
+}
+
+IRModule* SerialDeferredIRModule::getIRModule()
+{
+    if (m_isRead.load(std::memory_order_acquire))
+        return m_irModule;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_isRead.load(std::memory_order_relaxed))
+    {
+        if (m_sharedSlot)
+        {
+            std::lock_guard<std::mutex> sharedLock(m_sharedSlot->m_mutex);
+            if (!m_sharedSlot->m_isRead)
+            {
+                if (SLANG_FAILED(_read(m_sharedSlot->m_irModule)))
+                {
+                    SLANG_ASSERT(!"Unable to read deferred IR module");
+                    m_sharedSlot->m_irModule = nullptr;
+                }
+                m_sharedSlot->m_isRead = true;
+            }
+            m_irModule = m_sharedSlot->m_irModule;
+        }
+        else
+        {
+            if (SLANG_FAILED(_read(m_ownedIRModule)))
+            {
+                SLANG_ASSERT(!"Unable to read deferred IR module");
+                m_ownedIRModule = nullptr;
+            }
+            m_irModule = m_ownedIRModule;
+        }
+
+        // The container and source loc reader are kept even though they won't be used again,
+        // as they may be shared with other modules, and their reference counts aren't atomic.
+        m_isRead.store(true, std::memory_order_release);
+    }
+    return m_irModule;
+}
+
+bool SerialDeferredIRModule::mayDefineSymbol(UnownedStringSlice mangledName)
+{
+    if (!m_isSymbolDirectoryRead.load(std::memory_order_acquire))
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_isSymbolDirectoryRead.load(std::memory_order_relaxed))
+        {
+            IRSerialData serialData;
+            if (SLANG_SUCCEEDED(IRSerialReader::readSymbolDirectory(
+                    m_irChunk,
+                    m_compressionType,
+                    &serialData)) &&
+                serialData.m_symbols.getCount())
+            {
+                List<UnownedStringSlice> strings;
+                SerialStringTableUtil::decodeStringTable(
+                    serialData.m_stringTable.getBuffer(),
+                    serialData.m_stringTable.getCount(),
+                    strings);
+                for (const auto& symbol : serialData.m_symbols)
+                    m_symbolNames.add(strings[Index(symbol.m_mangledName)]);
+                m_hasSymbolDirectory = true;
+            }
+            m_isSymbolDirectoryRead.store(true, std::memory_order_release);
+        }
+    }
+    return !m_hasSymbolDirectory || m_symbolNames.has(mangledName);
+}
+
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! SerialCompressedIRModule !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+
+/* static */ SlangResult SerialCompressedIRModule::create(
+    IRModule* irModule,
+    RefPtr<SerialCompressedIRModule>& out)
+{
+    OwnedMemoryStream stream(FileAccess::Write);
+    {
+        IRSerialData serialData;
+        IRSerialWriter writer;
+        SLANG_RETURN_ON_FAIL(
+            writer.write(irModule, nullptr, SerialOptionFlag::RawSourceLocation, &serialData));
+
+        // The IR arrays aren't encoded, as LZ4 compresses the whole container better and faster.
+        RiffContainer container;
+        RiffContainer::ScopeChunk containerScope(
+            &container,
+            RiffContainer::Chunk::Kind::List,
+            SerialBinary::kContainerFourCc);
+        SLANG_RETURN_ON_FAIL(
+            IRSerialWriter::writeContainer(serialData, SerialCompressionType::None, &container));
+        SLANG_RETURN_ON_FAIL(RiffUtil::write(&container, &stream));
+    }
+
+    RefPtr<SerialCompressedIRModule> compressedModule = new SerialCompressedIRModule();
+    const auto contents = stream.getContents();
+    CompressionStyle style;
+    style.m_type = CompressionStyle::Type::BestSpeed;
+    SLANG_RETURN_ON_FAIL(LZ4CompressionSystem::getSingleton()->compress(
+        &style,
+        contents.getBuffer(),
+        size_t(contents.getCount()),
+        compressedModule->m_compressedBlob.writeRef()));
+    compressedModule->m_serializedSize = size_t(contents.getCount());
+    compressedModule->m_obfuscatedSourceMap = irModule->getObfuscatedSourceMap();
+    compressedModule->m_optimizationRemarks = irModule->getOptimizationRemarks();
+
+    out = compressedModule;
+    return SLANG_OK;
+}
+
+SlangResult SerialCompressedIRModule::read(Session* session, RefPtr<IRModule>& outIRModule)
+{
+    List<uint8_t> serialized;
+    serialized.setCount(Index(m_serializedSize));
+    SLANG_RETURN_ON_FAIL(LZ4CompressionSystem::getSingleton()->decompress(
+        m_compressedBlob->getBufferPointer(),
+        m_compressedBlob->getBufferSize(),
+        m_serializedSize,
+        serialized.getBuffer()));
+
+    MemoryStreamBase stream(FileAccess::Read, serialized.getBuffer(), m_serializedSize);
+    RiffContainer container;
+    SLANG_RETURN_ON_FAIL(RiffUtil::read(&stream, container));
+
+    RiffContainer::ListChunk* irChunk =
+        container.getRoot()->findContainedList(IRSerialBinary::kIRModuleFourCc);
+    if (!irChunk)
+        return SLANG_FAIL;
+
+    IRSerialData serialData;
+    SLANG_RETURN_ON_FAIL(
+        IRSerialReader::readContainer(irChunk, SerialCompressionType::None, &serialData));
+
+    IRSerialReader reader;
+    SLANG_RETURN_ON_FAIL(reader.read(serialData, session, nullptr, outIRModule));
+    outIRModule->setObfuscatedSourceMap(m_obfuscatedSourceMap);
+    outIRModule->setOptimizationRemarks(m_optimizationRemarks);
+    return SLANG_OK;
+}
 
 static List<ExtensionDecl*>& _getCandidateExtensionList(
     AggTypeDecl* typeDecl,
@@ -600,13 +802,41 @@ static List<ExtensionDecl*>& _getCandidateExtensionList(
                         module.dependentFiles.add(file);
                     }
                 }
+
+                // Modules written before the stamps were added end here.
+                uint32_t stampCount = 0;
+                memStream.read(&stampCount, sizeof(uint32_t), readSize);
+                if (readSize == sizeof(uint32_t) &&
+                    stampCount == (uint32_t)module.dependentFiles.getCount())
+                {
+                    module.dependentFileStamps.setCount(stampCount);
+                    for (auto& stamp : module.dependentFileStamps)
+                    {
+                        size_t digestSize = 0, timeSize = 0;
+                        memStream.read(stamp.digest.data, sizeof(stamp.digest.data), digestSize);
+                        memStream.read(&stamp.modifiedTime, sizeof(uint64_t), timeSize);
+                        memStream.read(&stamp.size, sizeof(uint64_t), readSize);
+                        if (digestSize + timeSize + readSize !=
+                            sizeof(stamp.digest.data) + 2 * sizeof(uint64_t))
+                            return SLANG_FAIL;
+                    }
+                }
                 // Onto next chunk
                 chunk = chunk->m_next;
             }
 
             if (auto irChunk = as<RiffContainer::ListChunk>(chunk, IRSerialBinary::kIRModuleFourCc))
             {
-                if (!options.readHeaderOnly)
+                if (options.deferIRContainerOwner && !options.readHeaderOnly)
+                {
+                    module.deferredIRModule = new SerialDeferredIRModule(
+                        options.deferIRContainerOwner,
+                        irChunk,
+                        containerCompressionType,
+                        sourceLocReader,
+                        options.session);
+                }
+                else if (!options.readHeaderOnly)
                 {
                     IRSerialData serialData;
                     SLANG_RETURN_ON_FAIL(IRSerialReader::readContainer(
@@ -845,6 +1075,9 @@ static List<ExtensionDecl*>& _getCandidateExtensionList(
                                             SLANG_ASSERT(syntaxKeywordDict.getCount());
                                         }
 
+                                        if (auto name = syntaxDecl->getName())
+                                            name->isSyntaxDeclName = true;
+
                                         // Look up the index
                                         Index* entryIndexPtr =
                                             syntaxKeywordDict.tryGetValue(syntaxDecl->getName());
@@ -882,7 +1115,7 @@ static List<ExtensionDecl*>& _getCandidateExtensionList(
                 chunk = chunk->m_next;
             }
 
-            if (astBuilder || irModule)
+            if (astBuilder || irModule || module.deferredIRModule)
             {
                 module.astBuilder = astBuilder;
                 module.astRootNode = astRootNode;
@@ -7,10 +7,14 @@
 #include "slang-profile.h"
 #include "slang-serialize-types.h"
 
+#include <atomic>
+#include <mutex>
+
 namespace Slang
 {
 
 class EndToEndCompileRequest;
+class SerialSourceLocReader;
 
 /* The binary representation actually held in riff/file format*/
 struct SerialContainerBinary
@@ -31,13 +35,126 @@ struct SerialContainerBinary
     };
 };
 
+/* Holds the IR of a deferred module that is shared by every global session that reads the
+same serialized module, so it's only read, and only takes up memory, once.
+
+Once read the IR module is never modified or released, so it can be used from any thread. */
+class SerialSharedIRModuleSlot : public RefObject
+{
+public:
+    std::mutex m_mutex;
+    bool m_isRead = false;
+    RefPtr<IRModule> m_irModule;
+};
+
+/* The serialized IR of a module, read the first time it's asked for rather than when the
+container holding it is read.
+
+Holds a reference to the owner of the container, so the container stays valid until then.
+It's safe to ask for the IR module from multiple threads at once. */
+class SerialDeferredIRModule : public RefObject
+{
+public:
+    /// Get the IR module, reading it if this is the first time it's asked for.
+    /// Returns nullptr if it couldn't be read.
+    IRModule* getIRModule();
+
+    /// Share the IR module through `slot`, which must outlive this. If another module with
+    /// the same slot has been read, its IR module is used, otherwise this reads it into the slot.
+    /// Only valid for modules read from the same serialized data, with source locations that
+    /// map to the same `SourceLoc`s.
+    void setSharedSlot(SerialSharedIRModuleSlot* slot) { m_sharedSlot = slot; }
+
+    /// True if the module may define a global value with the mangled name `mangledName`. The
+    /// symbol directory written with the module is read to find out, rather than its IR, so a
+    /// module that doesn't define a symbol needn't be read to look for it. A module written
+    /// without a directory may define any symbol.
+    bool mayDefineSymbol(UnownedStringSlice mangledName);
+
+    SerialDeferredIRModule(
+        RefObject* containerOwner,
+        RiffContainer::ListChunk* irChunk,
+        SerialCompressionType compressionType,
+        SerialSourceLocReader* sourceLocReader,
+        Session* session);
+    ~SerialDeferredIRModule();
+
+protected:
+    RefPtr<RefObject> m_containerOwner;
+    RiffContainer::ListChunk* m_irChunk;
+    SerialCompressionType m_compressionType;
+    RefPtr<SerialSourceLocReader> m_sourceLocReader;
+    Session* m_session;
+
+    SlangResult _read(RefPtr<IRModule>& outIRModule);
+
+    // Not a `RefPtr` as the slot is shared between threads, and reference counts aren't atomic.
+    SerialSharedIRModuleSlot* m_sharedSlot = nullptr;
+
+    std::mutex m_mutex;
+    std::atomic<bool> m_isRead{false};
+
+    std::atomic<bool> m_isSymbolDirectoryRead{false};
+    bool m_hasSymbolDirectory = false;
+    // The mangled names in the symbol directory, held in the container.
+    StringSlicePool m_symbolNames = StringSlicePool(StringSlicePool::Style::Empty);
+    // Either `m_ownedIRModule`, or the IR module held in `m_sharedSlot`.
+    IRModule* m_irModule = nullptr;
+    RefPtr<IRModule> m_ownedIRModule;
+};
+
+/* The IR of a module, serialized and compressed with LZ4, so that a module whose IR isn't being
+used can release it and read it back when it is used again.
+
+The source locations are stored as they are, so the IR can only be read back into the session
+that it was written from. */
+class SerialCompressedIRModule : public RefObject
+{
+public:
+    /// Serialize and compress `irModule`.
+    static SlangResult create(IRModule* irModule, RefPtr<SerialCompressedIRModule>& out);
+
+    /// Read the IR module back, as a new module of `session`.
+    SlangResult read(Session* session, RefPtr<IRModule>& outIRModule);
+
+    /// The size of the compressed IR in bytes.
+    size_t getCompressedSize() const
+    {
+        return m_compressedBlob ? m_compressedBlob->getBufferSize() : 0;
+    }
+
+protected:
+    ComPtr<ISlangBlob> m_compressedBlob;
+    /// The size of the serialized IR before it was compressed.
+    size_t m_serializedSize = 0;
+
+    // Module state that isn't serialized with its instructions.
+    ComPtr<IBoxValue<SourceMap>> m_obfuscatedSourceMap;
+    OptimizationRemarks* m_optimizationRemarks = nullptr;
+};
+
 struct SerialContainerDataModule
 {
     RefPtr<IRModule> irModule;       ///< The IR for the module
+    /// Set instead of `irModule` if reading the IR was deferred
+    RefPtr<SerialDeferredIRModule> deferredIRModule;
     RefPtr<ASTBuilder> astBuilder;   ///< The astBuilder that owns the astRootNode
     NodeBase* astRootNode = nullptr; ///< The module decl
     List<String> dependentFiles;
     SHA1::Digest digest;
+
+    /// The digest of a dependent file's contents, along with the time it was last written and
+    /// its size when the module was written. A file whose time and size still match doesn't
+    /// need to be read again to check that the module is up to date.
+    struct FileStamp
+    {
+        SHA1::Digest digest;
+        uint64_t modifiedTime = 0;
+        /// Zero if the file couldn't be stamped, in which case it must always be read.
+        uint64_t size = 0;
+    };
+    /// Either empty, or a stamp for each of `dependentFiles`
+    List<FileStamp> dependentFileStamps;
 };
 
 /* Struct that holds all the data that can be held in a 'container' */
@@ -105,6 +222,10 @@ struct SerialContainerUtil
         DiagnosticSink* sink = nullptr;
         bool readHeaderOnly = false;
         String modulePath;
+        /// If set, the IR of modules isn't read along with the rest of the container.
+        /// Instead each module gets a `deferredIRModule` that reads it the first time it's
+        /// needed, and keeps `containerOwner`, which must own the container, alive till then.
+        RefObject* deferIRContainerOwner = nullptr;
     };
 
     /// Add module to outData
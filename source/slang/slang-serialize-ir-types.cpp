@@ -62,6 +62,7 @@ size_t IRSerialData::calcSizeInBytes() const
 {
     return _calcArraySize(m_insts) + _calcArraySize(m_childRuns) +
            _calcArraySize(m_externalOperands) + _calcArraySize(m_stringTable) +
+           _calcArraySize(m_symbols) +
            /* Raw source locs */
            _calcArraySize(m_rawSourceLocs) +
            /* Debug */
@@ -84,6 +85,7 @@ void IRSerialData::clear()
     m_rawSourceLocs.clear();
 
     m_stringTable.clear();
+    m_symbols.clear();
 
     m_debugSourceLocRuns.clear();
 }
@@ -96,6 +98,7 @@ bool IRSerialData::operator==(const ThisType& rhs) const
             SerialListUtil::isEqual(m_externalOperands, rhs.m_externalOperands) &&
             SerialListUtil::isEqual(m_rawSourceLocs, rhs.m_rawSourceLocs) &&
             SerialListUtil::isEqual(m_stringTable, rhs.m_stringTable) &&
+            SerialListUtil::isEqual(m_symbols, rhs.m_symbols) &&
             /* Debug */
             SerialListUtil::isEqual(m_debugSourceLocRuns, rhs.m_debugSourceLocRuns));
 }
@@ -39,6 +39,12 @@ struct IRSerialBinary
     /// Debug information is held elsewhere, but if this optional section exists, it maps
     /// instructions to locs
     static const FourCC kDebugSourceLocRunFourCc = SLANG_FOUR_CC('S', 'd', 's', 'r');
+    /// The same runs, each stored as the difference to the run before it, which is how they
+    /// are written now
+    static const FourCC kDebugSourceLocRunDeltaFourCc = SLANG_FOUR_CC('S', 'd', 's', 'd');
+
+    /// The directory of the global values the module defines, by mangled name
+    static const FourCC kSymbolFourCc = SLANG_FOUR_CC('S', 'L', 's', 'y');
 };
 
 struct IRSerialData
@@ -88,6 +94,21 @@ struct IRSerialData
         SizeType m_numInst;                         ///< The number of children
     };
 
+    /// A global value with a linkage, which a module can be asked for by its mangled name
+    struct Symbol
+    {
+        typedef Symbol ThisType;
+
+        bool operator==(const ThisType& rhs) const
+        {
+            return m_mangledName == rhs.m_mangledName && m_instIndex == rhs.m_instIndex;
+        }
+        bool operator!=(const ThisType& rhs) const { return !(*this == rhs); }
+
+        StringIndex m_mangledName; ///< The mangled name, in the string table
+        InstIndex m_instIndex;     ///< The global value
+    };
+
     struct PayloadInfo
     {
         uint8_t m_numOperands;
@@ -199,7 +220,11 @@ struct IRSerialData
 
     List<char> m_stringTable; ///< All strings. Indexed into by StringIndex
 
-    List<SourceLocRun> m_debugSourceLocRuns; ///< Runs of instructions that use a source loc
+    List<SourceLocRun> m_debugSourceLocRuns; ///< Runs of instructions that use a source loc, in
+                                             ///< instruction order
+
+    List<Symbol> m_symbols; ///< The global values with a linkage, in instruction order. Can be
+                            ///< read without the instructions, to find what a module defines
 
     static const PayloadInfo s_payloadInfos[int(Inst::PayloadType::CountOf)];
 };
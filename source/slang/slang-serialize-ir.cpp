@@ -6,6 +6,8 @@
 #include "../core/slang-text-io.h"
 #include "slang-ir-insts.h"
 
+#include <thread>
+
 namespace Slang
 {
 
@@ -15,15 +17,62 @@ static bool _isConstant(IROp opIn)
     return op >= kIROp_FirstConstant && op <= kIROp_LastConstant;
 }
 
+// Source loc runs are written as the difference of each run to the run before, which keeps the
+// values small enough to take a byte or two each with `VariableByteLite`. The runs are in
+// instruction order, so a run starts `m_startInstIndex` instructions after the end of the run
+// before, and `m_sourceLoc` holds the signed difference in locations with its sign in the low
+// bit.
+static void _encodeSourceLocRunDeltas(
+    const List<IRSerialData::SourceLocRun>& runs,
+    List<IRSerialData::SourceLocRun>& outDeltas)
+{
+    outDeltas.setCount(runs.getCount());
+
+    uint32_t prevEndInstIndex = 0;
+    uint32_t prevSourceLoc = 0;
+    for (Index i = 0; i < runs.getCount(); ++i)
+    {
+        const auto& run = runs[i];
+        const uint32_t startInstIndex = uint32_t(run.m_startInstIndex);
+        SLANG_ASSERT(startInstIndex >= prevEndInstIndex);
+
+        const uint32_t locDelta = run.m_sourceLoc - prevSourceLoc;
+
+        auto& delta = outDeltas[i];
+        delta.m_startInstIndex = IRSerialData::InstIndex(startInstIndex - prevEndInstIndex);
+        delta.m_numInst = run.m_numInst;
+        delta.m_sourceLoc = (locDelta << 1) ^ uint32_t(int32_t(locDelta) >> 31);
+
+        prevEndInstIndex = startInstIndex + run.m_numInst;
+        prevSourceLoc = run.m_sourceLoc;
+    }
+}
+
+static void _decodeSourceLocRunDeltas(List<IRSerialData::SourceLocRun>& ioRuns)
+{
+    uint32_t prevEndInstIndex = 0;
+    uint32_t prevSourceLoc = 0;
+    for (auto& run : ioRuns)
+    {
+        const uint32_t startInstIndex = prevEndInstIndex + uint32_t(run.m_startInstIndex);
+        const uint32_t encodedLocDelta = run.m_sourceLoc;
+        const uint32_t locDelta = (encodedLocDelta >> 1) ^ (0u - (encodedLocDelta & 1));
+
+        run.m_startInstIndex = IRSerialData::InstIndex(startInstIndex);
+        run.m_sourceLoc = prevSourceLoc + locDelta;
+
+        prevEndInstIndex = startInstIndex + run.m_numInst;
+        prevSourceLoc = run.m_sourceLoc;
+    }
+}
+
 // !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! IRSerialWriter !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
 
 void IRSerialWriter::_addInstruction(IRInst* inst)
 {
-    // It cannot already be in the map
-    SLANG_ASSERT(!m_instMap.containsKey(inst));
+    // It cannot already be numbered
+    SLANG_ASSERT(!m_insts.contains(inst));
 
-    // Add to the map
-    m_instMap.add(inst, Ser::InstIndex(m_insts.getCount()));
     m_insts.add(inst);
 }
 
@@ -102,6 +151,11 @@ Result IRSerialWriter::_calcDebugInfo(SerialSourceLocWriter* sourceLocWriter)
         startInstLoc = curInstLoc;
     }
 
+    // Put the runs in instruction order, so they can be written as deltas
+    m_serialData->m_debugSourceLocRuns.sort(
+        [](const IRSerialData::SourceLocRun& a, const IRSerialData::SourceLocRun& b)
+        { return a.m_startInstIndex < b.m_startInstIndex; });
+
     return SLANG_OK;
 }
 
@@ -122,7 +176,6 @@ Result IRSerialWriter::write(
     m_insts.add(nullptr);
 
     // Reset
-    m_instMap.clear();
     m_decorations.clear();
 
     // Stack for parentInst
@@ -140,7 +193,7 @@ Result IRSerialWriter::write(
         // If it's in the stack it is assumed it is already in the inst map
         IRInst* parentInst = parentInstStack.getLast();
         parentInstStack.removeLast();
-        SLANG_ASSERT(m_instMap.containsKey(parentInst));
+        SLANG_ASSERT(m_insts.contains(parentInst));
 
         // Okay we go through each of the children in order. If they are IRInstParent derived, we
         // add to stack to process later cos we want breadth first so the order of children is the
@@ -150,8 +203,8 @@ Result IRSerialWriter::write(
         IRInstListBase childrenList = parentInst->getDecorationsAndChildren();
         for (IRInst* child : childrenList)
         {
-            // This instruction can't be in the map...
-            SLANG_ASSERT(!m_instMap.containsKey(child));
+            // This instruction can't be numbered yet...
+            SLANG_ASSERT(!m_insts.contains(child));
 
             _addInstruction(child);
 
@@ -162,7 +215,7 @@ Result IRSerialWriter::write(
         if (Ser::InstIndex(m_insts.getCount()) != startChildInstIndex)
         {
             Ser::InstRun run;
-            run.m_parentIndex = m_instMap[parentInst];
+            run.m_parentIndex = getInstIndex(parentInst);
             run.m_startInstIndex = startChildInstIndex;
             run.m_numChildren = Ser::SizeType(m_insts.getCount() - int(startChildInstIndex));
 
@@ -301,6 +354,19 @@ Result IRSerialWriter::write(
         }
     }
 
+    // Make a directory of the global values with a linkage, so that what the module defines can
+    // be found without reading its instructions
+    for (auto child : moduleInst->getChildren())
+    {
+        if (auto linkageDecoration = child->findDecoration<IRLinkageDecoration>())
+        {
+            Ser::Symbol symbol;
+            symbol.m_mangledName = getStringIndex(linkageDecoration->getMangledName());
+            symbol.m_instIndex = getInstIndex(child);
+            m_serialData->m_symbols.add(symbol);
+        }
+    }
+
     // Convert strings into a string table
     {
         SerialStringTableUtil::encodeStringTable(m_stringSlicePool, serialData->m_stringTable);
@@ -434,40 +500,39 @@ Result _encodeInsts(
     return SLANG_OK;
 }
 
-Result _writeInstArrayChunk(
+static Result _encodeInstArrayChunk(
     SerialCompressionType compressionType,
     FourCC chunkId,
     const List<IRSerialData::Inst>& array,
-    RiffContainer* container)
+    SerialRiffUtil::EncodedArrayChunk& outChunk)
 {
-    typedef RiffContainer::Chunk Chunk;
-    typedef RiffContainer::ScopeChunk ScopeChunk;
-
-    if (array.getCount() == 0)
-    {
-        return SLANG_OK;
-    }
-
     switch (compressionType)
     {
     case SerialCompressionType::None:
         {
-            return SerialRiffUtil::writeArrayChunk(compressionType, chunkId, array, container);
+            return SerialRiffUtil::encodeArrayChunk(compressionType, chunkId, array, outChunk);
         }
     case SerialCompressionType::VariableByteLite:
         {
+            outChunk.chunkId = 0;
+            outChunk.payload.clear();
+            if (array.getCount() == 0)
+            {
+                return SLANG_OK;
+            }
+
             List<uint8_t> compressedPayload;
             SLANG_RETURN_ON_FAIL(_encodeInsts(compressionType, array, compressedPayload));
 
-            ScopeChunk scope(container, Chunk::Kind::Data, SLANG_MAKE_COMPRESSED_FOUR_CC(chunkId));
-
             SerialBinary::CompressedArrayHeader header;
             header.numEntries = uint32_t(array.getCount());
             header.numCompressedEntries = 0;
 
-            container->write(&header, sizeof(header));
-            container->write(compressedPayload.getBuffer(), compressedPayload.getCount());
+            outChunk.payload.setCount(Index(sizeof(header)));
+            memcpy(outChunk.payload.getBuffer(), &header, sizeof(header));
+            outChunk.payload.addRange(compressedPayload);
 
+            outChunk.chunkId = SLANG_MAKE_COMPRESSED_FOUR_CC(chunkId);
             return SLANG_OK;
         }
     default:
@@ -486,39 +551,92 @@ Result _writeInstArrayChunk(
 
     ScopeChunk scopeModule(container, Chunk::Kind::List, Bin::kIRModuleFourCc);
 
-    SLANG_RETURN_ON_FAIL(
-        _writeInstArrayChunk(compressionType, Bin::kInstFourCc, data.m_insts, container));
-    SLANG_RETURN_ON_FAIL(SerialRiffUtil::writeArrayChunk(
-        compressionType,
-        Bin::kChildRunFourCc,
-        data.m_childRuns,
-        container));
-    SLANG_RETURN_ON_FAIL(SerialRiffUtil::writeArrayChunk(
-        compressionType,
-        Bin::kExternalOperandsFourCc,
-        data.m_externalOperands,
-        container));
-    SLANG_RETURN_ON_FAIL(SerialRiffUtil::writeArrayChunk(
-        SerialCompressionType::None,
-        SerialBinary::kStringTableFourCc,
-        data.m_stringTable,
-        container));
-
-    SLANG_RETURN_ON_FAIL(SerialRiffUtil::writeArrayChunk(
-        SerialCompressionType::None,
-        Bin::kUInt32RawSourceLocFourCc,
-        data.m_rawSourceLocs,
-        container));
-
-    if (data.m_debugSourceLocRuns.getCount())
+    // The arrays are all encoded before any is written. Encoding the instructions is most of the
+    // work for a large module, so they are encoded on another thread while the other arrays are
+    // encoded on this one. The chunks are written in the same order either way, so the output
+    // doesn't depend on the threading.
+    SerialRiffUtil::EncodedArrayChunk instChunk;
+    Result instResult = SLANG_OK;
+    auto encodeInsts = [&]()
     {
-        SerialRiffUtil::writeArrayChunk(
-            compressionType,
-            Bin::kDebugSourceLocRunFourCc,
-            data.m_debugSourceLocRuns,
-            container);
+        instResult =
+            _encodeInstArrayChunk(compressionType, Bin::kInstFourCc, data.m_insts, instChunk);
+    };
+
+    // Below this many instructions, encoding takes less time than starting a thread.
+    const Index kMinInstCountToEncodeInParallel = 0x10000;
+
+    // A WebAssembly build without `-pthread` has no threads to start.
+#if SLANG_WASM && !defined(__EMSCRIPTEN_PTHREADS__)
+    const bool canStartThread = false;
+#else
+    const bool canStartThread = true;
+#endif
+
+    std::thread instThread;
+    if (canStartThread && compressionType != SerialCompressionType::None &&
+        data.m_insts.getCount() >= kMinInstCountToEncodeInParallel)
+    {
+        instThread = std::thread(encodeInsts);
+    }
+    else
+    {
+        encodeInsts();
     }
 
+    SerialRiffUtil::EncodedArrayChunk chunks[6];
+    auto encodeArrays = [&]() -> Result
+    {
+        SLANG_RETURN_ON_FAIL(SerialRiffUtil::encodeArrayChunk(
+            compressionType,
+            Bin::kChildRunFourCc,
+            data.m_childRuns,
+            chunks[0]));
+        SLANG_RETURN_ON_FAIL(SerialRiffUtil::encodeArrayChunk(
+            compressionType,
+            Bin::kExternalOperandsFourCc,
+            data.m_externalOperands,
+            chunks[1]));
+        SLANG_RETURN_ON_FAIL(SerialRiffUtil::encodeArrayChunk(
+            SerialCompressionType::None,
+            SerialBinary::kStringTableFourCc,
+            data.m_stringTable,
+            chunks[2]));
+        SLANG_RETURN_ON_FAIL(SerialRiffUtil::encodeArrayChunk(
+            compressionType,
+            Bin::kSymbolFourCc,
+            data.m_symbols,
+            chunks[3]));
+        SLANG_RETURN_ON_FAIL(SerialRiffUtil::encodeArrayChunk(
+            SerialCompressionType::None,
+            Bin::kUInt32RawSourceLocFourCc,
+            data.m_rawSourceLocs,
+            chunks[4]));
+
+        if (data.m_debugSourceLocRuns.getCount())
+        {
+            List<IRSerialData::SourceLocRun> deltaRuns;
+            _encodeSourceLocRunDeltas(data.m_debugSourceLocRuns, deltaRuns);
+
+            SLANG_RETURN_ON_FAIL(SerialRiffUtil::encodeArrayChunk(
+                compressionType,
+                Bin::kDebugSourceLocRunDeltaFourCc,
+                deltaRuns,
+                chunks[5]));
+        }
+        return SLANG_OK;
+    };
+    const Result result = encodeArrays();
+
+    if (instThread.joinable())
+        instThread.join();
+    SLANG_RETURN_ON_FAIL(instResult);
+    SLANG_RETURN_ON_FAIL(result);
+
+    SerialRiffUtil::writeEncodedArrayChunk(instChunk, container);
+    for (const auto& chunk : chunks)
+        SerialRiffUtil::writeEncodedArrayChunk(chunk, container);
+
     return SLANG_OK;
 }
 
@@ -729,6 +847,15 @@ static Result _readInstArrayChunk(
                     SerialRiffUtil::readArrayUncompressedChunk(dataChunk, outData->m_stringTable));
                 break;
             }
+        case SLANG_MAKE_COMPRESSED_FOUR_CC(Bin::kSymbolFourCc):
+        case Bin::kSymbolFourCc:
+            {
+                SLANG_RETURN_ON_FAIL(SerialRiffUtil::readArrayChunk(
+                    containerCompressionType,
+                    dataChunk,
+                    outData->m_symbols));
+                break;
+            }
         case Bin::kUInt32RawSourceLocFourCc:
             {
                 SLANG_RETURN_ON_FAIL(SerialRiffUtil::readArrayUncompressedChunk(
@@ -745,6 +872,60 @@ static Result _readInstArrayChunk(
                     outData->m_debugSourceLocRuns));
                 break;
             }
+        case SLANG_MAKE_COMPRESSED_FOUR_CC(Bin::kDebugSourceLocRunDeltaFourCc):
+        case Bin::kDebugSourceLocRunDeltaFourCc:
+            {
+                SLANG_RETURN_ON_FAIL(SerialRiffUtil::readArrayChunk(
+                    containerCompressionType,
+                    dataChunk,
+                    outData->m_debugSourceLocRuns));
+                _decodeSourceLocRunDeltas(outData->m_debugSourceLocRuns);
+                break;
+            }
+        default:
+            {
+                break;
+            }
+        }
+    }
+
+    return SLANG_OK;
+}
+
+/* static */ Result IRSerialReader::readSymbolDirectory(
+    RiffContainer::ListChunk* module,
+    SerialCompressionType containerCompressionType,
+    IRSerialData* outData)
+{
+    typedef IRSerialBinary Bin;
+
+    outData->clear();
+
+    for (RiffContainer::Chunk* chunk = module->m_containedChunks; chunk; chunk = chunk->m_next)
+    {
+        RiffContainer::DataChunk* dataChunk = as<RiffContainer::DataChunk>(chunk);
+        if (!dataChunk)
+        {
+            continue;
+        }
+
+        switch (dataChunk->m_fourCC)
+        {
+        case SerialBinary::kStringTableFourCc:
+            {
+                SLANG_RETURN_ON_FAIL(
+                    SerialRiffUtil::readArrayUncompressedChunk(dataChunk, outData->m_stringTable));
+                break;
+            }
+        case SLANG_MAKE_COMPRESSED_FOUR_CC(Bin::kSymbolFourCc):
+        case Bin::kSymbolFourCc:
+            {
+                SLANG_RETURN_ON_FAIL(SerialRiffUtil::readArrayChunk(
+                    containerCompressionType,
+                    dataChunk,
+                    outData->m_symbols));
+                break;
+            }
         default:
             {
                 break;
@@ -34,7 +34,7 @@ struct IRSerialWriter
     /// Get an instruction index from an instruction
     Ser::InstIndex getInstIndex(IRInst* inst) const
     {
-        return inst ? Ser::InstIndex(m_instMap.getValue(inst)) : Ser::InstIndex(0);
+        return inst ? Ser::InstIndex(m_insts.getIndex(inst)) : Ser::InstIndex(0);
     }
 
     /// Get a slice from an index
@@ -78,15 +78,16 @@ protected:
     void _addInstruction(IRInst* inst);
     Result _calcDebugInfo(SerialSourceLocWriter* sourceLocWriter);
 
-    List<IRInst*> m_insts; ///< Instructions in same order as stored in the
+    /// Instructions in same order as stored in the serial data, indexed by their instruction
+    /// index. Numbering them avoids a map from each instruction to its index, as the index of
+    /// every operand is looked up.
+    IRInstNumbering m_insts;
 
     List<IRDecoration*>
         m_decorations; ///< Holds all decorations in order of the instructions as found
     List<IRInst*> m_instWithFirstDecoration; ///< All decorations are held in this order after all
                                              ///< the regular instructions
 
-    Dictionary<IRInst*, Ser::InstIndex> m_instMap; ///< Map an instruction to an instruction index
-
     StringSlicePool m_stringSlicePool;
     IRSerialData* m_serialData; ///< Where the data is stored
 };
@@ -101,6 +102,14 @@ struct IRSerialReader
         SerialCompressionType containerCompressionType,
         IRSerialData* outData);
 
+    /// Read only the string table and the symbol directory of a stream into `outData`, which is
+    /// enough to find the global values the module defines without reading its instructions.
+    /// The symbols are empty if the module was written without a directory.
+    static Result readSymbolDirectory(
+        RiffContainer::ListChunk* module,
+        SerialCompressionType containerCompressionType,
+        IRSerialData* outData);
+
     /// Read a module from serial data
     Result read(
         const IRSerialData& data,
@@ -144,29 +144,22 @@ struct ByteReader
 
 // !!!!!!!!!!!!!!!!!!!!!!!!!!!! SerialRiffUtil !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
 
-/* static */ Result SerialRiffUtil::writeArrayChunk(
+/* static */ Result SerialRiffUtil::encodeArrayChunk(
     SerialCompressionType compressionType,
     FourCC chunkId,
     const void* data,
     size_t numEntries,
     size_t typeSize,
-    RiffContainer* container)
+    EncodedArrayChunk& outChunk)
 {
-    typedef RiffContainer::Chunk Chunk;
-    typedef RiffContainer::ScopeChunk ScopeChunk;
+    outChunk.chunkId = 0;
+    outChunk.payload.clear();
 
     if (numEntries == 0)
     {
         return SLANG_OK;
     }
 
-    // Make compressed fourCC
-    chunkId = (compressionType != SerialCompressionType::None)
-                  ? SLANG_MAKE_COMPRESSED_FOUR_CC(chunkId)
-                  : chunkId;
-
-    ScopeChunk scope(container, Chunk::Kind::Data, chunkId);
-
     switch (compressionType)
     {
     case SerialCompressionType::None:
@@ -174,8 +167,9 @@ struct ByteReader
             SerialBinary::ArrayHeader header;
             header.numEntries = uint32_t(numEntries);
 
-            container->write(&header, sizeof(header));
-            container->write(data, typeSize * numEntries);
+            outChunk.payload.setCount(Index(sizeof(header) + typeSize * numEntries));
+            memcpy(outChunk.payload.getBuffer(), &header, sizeof(header));
+            memcpy(outChunk.payload.getBuffer() + sizeof(header), data, typeSize * numEntries);
             break;
         }
     case SerialCompressionType::VariableByteLite:
@@ -192,8 +186,12 @@ struct ByteReader
             header.numEntries = uint32_t(numEntries);
             header.numCompressedEntries = uint32_t(numCompressedEntries);
 
-            container->write(&header, sizeof(header));
-            container->write(compressedPayload.getBuffer(), compressedPayload.getCount());
+            outChunk.payload.setCount(Index(sizeof(header)));
+            memcpy(outChunk.payload.getBuffer(), &header, sizeof(header));
+            outChunk.payload.addRange(compressedPayload);
+
+            // Make compressed fourCC
+            chunkId = SLANG_MAKE_COMPRESSED_FOUR_CC(chunkId);
             break;
         }
     default:
@@ -201,6 +199,36 @@ struct ByteReader
             return SLANG_FAIL;
         }
     }
+
+    outChunk.chunkId = chunkId;
+    return SLANG_OK;
+}
+
+/* static */ void SerialRiffUtil::writeEncodedArrayChunk(
+    const EncodedArrayChunk& chunk,
+    RiffContainer* container)
+{
+    if (chunk.chunkId == 0)
+    {
+        return;
+    }
+
+    RiffContainer::ScopeChunk scope(container, RiffContainer::Chunk::Kind::Data, chunk.chunkId);
+    container->write(chunk.payload.getBuffer(), chunk.payload.getCount());
+}
+
+/* static */ Result SerialRiffUtil::writeArrayChunk(
+    SerialCompressionType compressionType,
+    FourCC chunkId,
+    const void* data,
+    size_t numEntries,
+    size_t typeSize,
+    RiffContainer* container)
+{
+    EncodedArrayChunk chunk;
+    SLANG_RETURN_ON_FAIL(
+        encodeArrayChunk(compressionType, chunkId, data, numEntries, typeSize, chunk));
+    writeEncodedArrayChunk(chunk, container);
     return SLANG_OK;
 }
 
@@ -222,6 +222,45 @@ struct SerialRiffUtil
         List<T>& m_list;
     };
 
+    /// An array chunk encoded by `encodeArrayChunk`, to be written by `writeEncodedArrayChunk`.
+    ///
+    /// Encoding is separate from writing so that the arrays of a container can be encoded on
+    /// several threads, and still be written in a fixed order.
+    struct EncodedArrayChunk
+    {
+        /// The id of the chunk, with the compressed form if compressed. 0 if there is nothing to
+        /// write.
+        FourCC chunkId = 0;
+        /// The header and data of the chunk
+        List<uint8_t> payload;
+    };
+
+    static Result encodeArrayChunk(
+        SerialCompressionType compressionType,
+        FourCC chunkId,
+        const void* data,
+        size_t numEntries,
+        size_t typeSize,
+        EncodedArrayChunk& outChunk);
+
+    template<typename T>
+    static Result encodeArrayChunk(
+        SerialCompressionType compressionType,
+        FourCC chunkId,
+        const List<T>& array,
+        EncodedArrayChunk& outChunk)
+    {
+        return encodeArrayChunk(
+            compressionType,
+            chunkId,
+            array.begin(),
+            size_t(array.getCount()),
+            sizeof(T),
+            outChunk);
+    }
+
+    static void writeEncodedArrayChunk(const EncodedArrayChunk& chunk, RiffContainer* container);
+
     static Result writeArrayChunk(
         SerialCompressionType compressionType,
         FourCC chunkId,
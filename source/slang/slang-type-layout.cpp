@@ -2194,6 +2194,7 @@ TypeLayoutContext getInitialLayoutContextForTarget(
     context.astBuilder = astBuilder;
     context.targetReq = targetReq;
     context.programLayout = programLayout;
+    context.layoutCache = new TypeLayoutCache();
     context.rules = nullptr;
     context.matrixLayoutMode = targetReq->getOptionSet().getMatrixLayoutMode();
 
@@ -4447,6 +4448,8 @@ static TypeLayoutResult _updateLayout(
     return result;
 }
 
+static TypeLayoutResult _createTypeLayoutUncached(TypeLayoutContext& context, Type* type);
+
 static TypeLayoutResult _createTypeLayout(TypeLayoutContext& context, Type* type)
 {
     if (auto layoutResultPtr = context.layoutMap.tryGetValue(type))
@@ -4454,6 +4457,24 @@ static TypeLayoutResult _createTypeLayout(TypeLayoutContext& context, Type* type
         return *layoutResultPtr;
     }
 
+    // The layout of a type that has specialization args in scope depends on those args,
+    // so only layouts computed without any are shared through the cache.
+    //
+    auto layoutCache = context.layoutCache.get();
+    if (!layoutCache || context.specializationArgCount != 0)
+        return _createTypeLayoutUncached(context, type);
+
+    TypeLayoutCache::Key key = {type, context.rules, context.matrixLayoutMode};
+    if (auto layoutResultPtr = layoutCache->layouts.tryGetValue(key))
+        return *layoutResultPtr;
+
+    auto result = _createTypeLayoutUncached(context, type);
+    layoutCache->layouts[key] = result;
+    return result;
+}
+
+static TypeLayoutResult _createTypeLayoutUncached(TypeLayoutContext& context, Type* type)
+{
     auto rules = context.rules;
 
     if (auto parameterGroupType = as<ParameterGroupType>(type))
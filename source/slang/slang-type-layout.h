@@ -1148,6 +1148,39 @@ struct TypeLayoutResult
     }
 };
 
+/// The type layouts computed from a single initial `TypeLayoutContext`, shared by all the
+/// contexts derived from it.
+///
+/// A layout only depends on the type, the layout rules and the matrix layout mode, as long as
+/// there are no specialization args in scope, so a type that is used in many places (e.g., the
+/// element type of a large array of parameter blocks) only needs to be laid out once.
+///
+struct TypeLayoutCache : public RefObject
+{
+    struct Key
+    {
+        Type* type;
+        LayoutRulesImpl* rules;
+        MatrixLayoutMode matrixLayoutMode;
+
+        HashCode getHashCode() const
+        {
+            Hasher hasher;
+            hasher.hashValue(type);
+            hasher.hashValue(rules);
+            hasher.hashValue(matrixLayoutMode);
+            return hasher.getResult();
+        }
+        bool operator==(Key const& other) const
+        {
+            return type == other.type && rules == other.rules &&
+                   matrixLayoutMode == other.matrixLayoutMode;
+        }
+    };
+
+    Dictionary<Key, TypeLayoutResult> layouts;
+};
+
 struct TypeLayoutContext
 {
     ASTBuilder* astBuilder;
@@ -1178,6 +1211,9 @@ struct TypeLayoutContext
     // Map types to their type layout
     Dictionary<Type*, TypeLayoutResult> layoutMap;
 
+    // The completed type layouts, shared with the contexts this one was derived from.
+    RefPtr<TypeLayoutCache> layoutCache;
+
     // Options passed to object layout
     ObjectLayoutRulesImpl::Options objectLayoutOptions;
 
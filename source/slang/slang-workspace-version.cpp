@@ -3,6 +3,7 @@
 #include "../compiler-core/slang-lexer.h"
 #include "../core/slang-file-system.h"
 #include "../core/slang-io.h"
+#include "../core/slang-stable-hash.h"
 #include "slang-check-impl.h"
 #include "slang-mangle.h"
 #include "slang-serialize-container.h"
@@ -53,21 +54,19 @@ void Workspace::changeDoc(
         auto startOffset = doc->getOffset(line, col);
         doc->zeroBasedUTF16LocToOneBasedUTF8Loc(range.end.line, range.end.character, line, col);
         auto endOffset = doc->getOffset(line, col);
-        auto originalText = doc->getText().getUnownedSlice();
-        StringBuilder newText;
-        if (startOffset != -1)
-            newText << originalText.head(startOffset);
-        newText << text;
-        if (endOffset != -1)
-            newText << originalText.tail(endOffset);
-        changeDoc(doc.Ptr(), newText.produceString());
+        if (startOffset == -1)
+            startOffset = 0;
+        if (endOffset == -1)
+            endOffset = doc->getText().getLength();
+        doc->replaceText(startOffset, endOffset, text.getUnownedSlice());
+        invalidateDocument(doc->getPath());
     }
 }
 
 void Workspace::changeDoc(DocumentVersion* doc, const String& newText)
 {
     doc->setText(newText);
-    invalidate();
+    invalidateDocument(doc->getPath());
 }
 
 void Workspace::closeDoc(const String& path)
@@ -197,6 +196,26 @@ void Workspace::init(List<URI> rootDirURI, slang::IGlobalSession* globalSession)
 void Workspace::invalidate()
 {
     currentVersion = nullptr;
+    reusableVersion = nullptr;
+    changedDocumentPaths.clear();
+    changeCount++;
+}
+
+void Workspace::invalidateDocument(const String& path)
+{
+    if (currentVersion)
+        reusableVersion = currentVersion;
+    currentVersion = nullptr;
+    changedDocumentPaths.add(path);
+    changeCount++;
+    documentChangeCounts[path]++;
+}
+
+Index Workspace::getChangeCountExcludingDocument(const String& path)
+{
+    Index documentChangeCount = 0;
+    documentChangeCounts.tryGetValue(path, documentChangeCount);
+    return changeCount - documentChangeCount;
 }
 
 void WorkspaceVersion::parseDiagnostics(String compilerOutput)
@@ -367,10 +386,108 @@ SlangResult Workspace::loadFile(const char* path, ISlangBlob** outBlob)
     }
     return Slang::OSFileSystem::getExtSingleton()->loadFile(path, outBlob);
 }
+// The number of versions in a row that may reuse a linkage. The modules that are parsed
+// again are never freed while the linkage is alive, so it is replaced every so often.
+static const Index kMaxIncrementalUpdateCount = 32;
+
+static String _getCanonicalPath(SourceFile* sourceFile)
+{
+    const auto& foundPath = sourceFile->getPathInfo().foundPath;
+    String canonicalPath;
+    if (foundPath.getLength() && SLANG_SUCCEEDED(Path::getCanonical(foundPath, canonicalPath)))
+        return canonicalPath;
+    return foundPath;
+}
+
+template<typename T>
+static void _removeInfoOutsideFiles(
+    List<T>& infos,
+    SourceManager* sourceManager,
+    const HashSet<SourceFile*>& files)
+{
+    Index count = 0;
+    for (Index i = 0; i < infos.getCount(); i++)
+    {
+        auto sourceView = sourceManager->findSourceViewRecursively(infos[i].loc);
+        if (sourceView && files.contains(sourceView->getSourceFile()))
+            infos[count++] = _Move(infos[i]);
+    }
+    infos.setCount(count);
+}
+
+RefPtr<WorkspaceVersion> Workspace::createIncrementalWorkspaceVersion()
+{
+    auto previous = reusableVersion;
+    if (previous->incrementalUpdateCount >= kMaxIncrementalUpdateCount)
+        return nullptr;
+    auto linkage = previous->linkage;
+
+    // An import that failed is remembered as a null module and never retried, but the edit
+    // may have fixed it.
+    for (const auto& [name, module] : linkage->mapNameToLoadedModules)
+    {
+        if (!module)
+            return nullptr;
+    }
+
+    // The file dependencies of a module include those of the modules it imports, so this
+    // finds every module that needs to be parsed and checked again.
+    HashSet<Module*> staleModules;
+    for (auto& module : linkage->loadedModulesList)
+    {
+        for (auto sourceFile : module->getFileDependencyList())
+        {
+            if (changedDocumentPaths.contains(_getCanonicalPath(sourceFile)))
+            {
+                staleModules.add(module);
+                break;
+            }
+        }
+    }
+    linkage->unloadModules(staleModules);
+
+    // The file system caches file contents, and identifies files by a hash of the contents,
+    // so clearing it makes changed files load as new source files.
+    linkage->getFileSystemExt()->clearCache();
+
+    HashSet<SourceFile*> liveFiles;
+    HashSet<String> liveFilePaths;
+    for (auto& module : linkage->loadedModulesList)
+    {
+        for (auto sourceFile : module->getFileDependencyList())
+        {
+            if (liveFiles.add(sourceFile))
+                liveFilePaths.add(_getCanonicalPath(sourceFile));
+        }
+    }
+
+    // The preprocessor info of the stale modules is added again when they are parsed.
+    auto sourceManager = linkage->getSourceManager();
+    auto& preprocessorInfo = linkage->contentAssistInfo.preprocessorInfo;
+    _removeInfoOutsideFiles(preprocessorInfo.macroDefinitions, sourceManager, liveFiles);
+    _removeInfoOutsideFiles(preprocessorInfo.macroInvocations, sourceManager, liveFiles);
+    _removeInfoOutsideFiles(preprocessorInfo.fileIncludes, sourceManager, liveFiles);
+
+    RefPtr<WorkspaceVersion> version = new WorkspaceVersion();
+    version->workspace = this;
+    version->flavor = previous->flavor;
+    version->linkage = linkage;
+    version->incrementalUpdateCount = previous->incrementalUpdateCount + 1;
+    version->inheritUnchangedState(previous, staleModules, liveFilePaths);
+    return version;
+}
+
 WorkspaceVersion* Workspace::getCurrentVersion()
 {
     if (!currentVersion)
-        currentVersion = createWorkspaceVersion();
+    {
+        if (reusableVersion)
+            currentVersion = createIncrementalWorkspaceVersion();
+        if (!currentVersion)
+            currentVersion = createWorkspaceVersion();
+        reusableVersion = nullptr;
+        changedDocumentPaths.clear();
+    }
     return currentVersion.Ptr();
 }
 WorkspaceVersion* Workspace::createVersionForCompletion()
@@ -381,6 +498,47 @@ WorkspaceVersion* Workspace::createVersionForCompletion()
     return currentCompletionVersion.Ptr();
 }
 
+WorkspaceSymbolIndex* Workspace::getSymbolIndex()
+{
+    if (!symbolIndex)
+        symbolIndex = new WorkspaceSymbolIndex();
+    return symbolIndex.Ptr();
+}
+
+void Workspace::setSymbolIndexCacheDirectory(const String& directory)
+{
+    if (directory.getLength() == 0)
+    {
+        symbolIndexFilePath = String();
+        return;
+    }
+    if (!File::exists(directory) && !Path::createDirectoryRecursive(directory))
+        return;
+
+    // Workspaces with different root directories keep their indices in different files.
+    StringBuilder rootDirectoriesText;
+    for (auto& dir : rootDirectories)
+        rootDirectoriesText << dir << ";";
+    StringBuilder fileName;
+    fileName << "symbol-index-"
+             << getStableHashCode64(
+                    rootDirectoriesText.getBuffer(),
+                    rootDirectoriesText.getLength())
+                    .hash
+             << ".txt";
+    auto filePath = Path::combine(directory, fileName.produceString());
+    if (filePath == symbolIndexFilePath)
+        return;
+    symbolIndexFilePath = filePath;
+    getSymbolIndex()->loadFromFile(symbolIndexFilePath);
+}
+
+void Workspace::saveSymbolIndex()
+{
+    if (symbolIndexFilePath.getLength() && symbolIndex && symbolIndex->isDirty())
+        symbolIndex->saveToFile(symbolIndexFilePath);
+}
+
 void* Workspace::getObject(const Guid& uuid)
 {
     SLANG_UNUSED(uuid);
@@ -412,64 +570,136 @@ void DocumentVersion::setText(const String& newText)
     StringUtil::calcLines(text.getUnownedSlice(), lines);
     mapUTF16CharIndexToCodePointIndex.clear();
     mapCodePointIndexToUTF8ByteOffset.clear();
+    mapUTF16CharIndexToCodePointIndex.setCount(lines.getCount());
+    mapCodePointIndexToUTF8ByteOffset.setCount(lines.getCount());
 }
 
-void DocumentVersion::ensureUTFBoundsAvailable()
+void DocumentVersion::replaceText(
+    Index startOffset,
+    Index endOffset,
+    UnownedStringSlice replacement)
 {
-    for (auto slice : lines)
+    const UnownedStringSlice oldText = text.getUnownedSlice();
+    startOffset = Math::Clamp(startOffset, Index(0), oldText.getLength());
+    endOffset = Math::Clamp(endOffset, startOffset, oldText.getLength());
+
+    StringBuilder sb;
+    sb << oldText.head(startOffset) << replacement << oldText.tail(endOffset);
+    String newText = sb.produceString();
+    const UnownedStringSlice newTextSlice = newText.getUnownedSlice();
+    const Index delta = replacement.getLength() - (endOffset - startOffset);
+
+    List<UnownedStringSlice> newLines;
+    List<List<Index>> newUTF16Bounds;
+    List<List<Index>> newUTF8Bounds;
+    auto keepLine = [&](Index lineIndex, Index offsetDelta)
     {
-        List<Index> bounds;
-        List<Index> utf8Bounds;
-        Index index = 0;
-        Index codePointIndex = 0;
-        while (index < slice.getLength())
-        {
-            auto startIndex = index;
-            const Char32 codePoint = getUnicodePointFromUTF8(
-                [&]() -> Byte
-                {
-                    if (index < slice.getLength())
-                        return slice[index++];
-                    else
-                        return '\0';
-                });
-            if (!codePoint)
-                break;
+        const auto line = lines[lineIndex];
+        newLines.add(UnownedStringSlice(
+            newTextSlice.begin() + getLineStart(line) + offsetDelta,
+            line.getLength()));
+        newUTF16Bounds.add(_Move(mapUTF16CharIndexToCodePointIndex[lineIndex]));
+        newUTF8Bounds.add(_Move(mapCodePointIndexToUTF8ByteOffset[lineIndex]));
+    };
+
+    // The lines before the one with the start of the edit are unchanged. The line before it is
+    // split again too, as the replacement can pair a line break with the one ending that line.
+    Index firstLine = Index(
+        std::upper_bound(
+            lines.begin(),
+            lines.end(),
+            startOffset,
+            [this](Index offset, UnownedStringSlice line) { return offset < getLineStart(line); }) -
+        lines.begin());
+    firstLine = Math::Max(Index(0), firstLine - 2);
+    for (Index i = 0; i < firstLine; i++)
+        keepLine(i, 0);
+
+    // Split the new text from there, until a line starts at an old line start after the end of
+    // the edit. The lines from there on have the same text as before, moved by `delta`.
+    const Index splitStart = firstLine < lines.getCount() ? getLineStart(lines[firstLine]) : 0;
+    UnownedStringSlice remaining = newTextSlice.tail(splitStart);
+    UnownedStringSlice line;
+    Index oldLine = firstLine;
+    while (StringUtil::extractLine(remaining, line))
+    {
+        newLines.add(line);
+        newUTF16Bounds.add(List<Index>());
+        newUTF8Bounds.add(List<Index>());
+        if (!remaining.begin())
+            break;
 
-            Char16 buffer[2];
-            int count = encodeUnicodePointToUTF16Reversed(codePoint, buffer);
-            for (int i = 0; i < count; i++)
-                bounds.add(codePointIndex);
-            utf8Bounds.add(startIndex);
-            codePointIndex++;
+        const Index oldLineStart = Index(remaining.begin() - newTextSlice.begin()) - delta;
+        if (oldLineStart < endOffset)
+            continue;
+        while (oldLine < lines.getCount() && getLineStart(lines[oldLine]) < oldLineStart)
+            oldLine++;
+        if (oldLine < lines.getCount() && getLineStart(lines[oldLine]) == oldLineStart)
+        {
+            for (Index i = oldLine; i < lines.getCount(); i++)
+                keepLine(i, delta);
+            break;
         }
-        bounds.add(slice.getLength());
-        utf8Bounds.add(slice.getLength());
-        mapUTF16CharIndexToCodePointIndex.add(_Move(bounds));
-        mapCodePointIndexToUTF8ByteOffset.add(_Move(utf8Bounds));
     }
+
+    text = _Move(newText);
+    lines = _Move(newLines);
+    mapUTF16CharIndexToCodePointIndex = _Move(newUTF16Bounds);
+    mapCodePointIndexToUTF8ByteOffset = _Move(newUTF8Bounds);
 }
 
-ArrayView<Index> DocumentVersion::getUTF16Boundaries(Index line)
+void DocumentVersion::ensureUTFBoundsAvailable(Index lineIndex)
 {
-    if (!mapUTF16CharIndexToCodePointIndex.getCount())
+    // Every computed map has at least the bound of the end of the line.
+    if (mapUTF16CharIndexToCodePointIndex[lineIndex].getCount())
+        return;
+
+    const auto slice = lines[lineIndex];
+    List<Index> bounds;
+    List<Index> utf8Bounds;
+    Index index = 0;
+    Index codePointIndex = 0;
+    while (index < slice.getLength())
     {
-        ensureUTFBoundsAvailable();
+        auto startIndex = index;
+        const Char32 codePoint = getUnicodePointFromUTF8(
+            [&]() -> Byte
+            {
+                if (index < slice.getLength())
+                    return slice[index++];
+                else
+                    return '\0';
+            });
+        if (!codePoint)
+            break;
+
+        Char16 buffer[2];
+        int count = encodeUnicodePointToUTF16Reversed(codePoint, buffer);
+        for (int i = 0; i < count; i++)
+            bounds.add(codePointIndex);
+        utf8Bounds.add(startIndex);
+        codePointIndex++;
     }
-    return line >= 1 && line <= mapUTF16CharIndexToCodePointIndex.getCount()
-               ? mapUTF16CharIndexToCodePointIndex[line - 1].getArrayView()
-               : ArrayView<Index>();
+    bounds.add(slice.getLength());
+    utf8Bounds.add(slice.getLength());
+    mapUTF16CharIndexToCodePointIndex[lineIndex] = _Move(bounds);
+    mapCodePointIndexToUTF8ByteOffset[lineIndex] = _Move(utf8Bounds);
+}
+
+ArrayView<Index> DocumentVersion::getUTF16Boundaries(Index line)
+{
+    if (line < 1 || line > lines.getCount())
+        return ArrayView<Index>();
+    ensureUTFBoundsAvailable(line - 1);
+    return mapUTF16CharIndexToCodePointIndex[line - 1].getArrayView();
 }
 
 ArrayView<Index> DocumentVersion::getUTF8Boundaries(Index line)
 {
-    if (!mapCodePointIndexToUTF8ByteOffset.getCount())
-    {
-        ensureUTFBoundsAvailable();
-    }
-    return line >= 1 && line <= mapCodePointIndexToUTF8ByteOffset.getCount()
-               ? mapCodePointIndexToUTF8ByteOffset[line - 1].getArrayView()
-               : ArrayView<Index>();
+    if (line < 1 || line > lines.getCount())
+        return ArrayView<Index>();
+    ensureUTFBoundsAvailable(line - 1);
+    return mapCodePointIndexToUTF8ByteOffset[line - 1].getArrayView();
 }
 
 void DocumentVersion::oneBasedUTF8LocToZeroBasedUTF16Loc(
@@ -554,6 +784,34 @@ int DocumentVersion::getTokenLength(Index line, Index col)
     return getTokenLength(offset);
 }
 
+void WorkspaceVersion::inheritUnchangedState(
+    WorkspaceVersion* previous,
+    const HashSet<Module*>& staleModules,
+    const HashSet<String>& liveFilePaths)
+{
+    for (const auto& [path, module] : previous->modules)
+    {
+        if (!staleModules.contains(module))
+            modules[path] = module;
+    }
+    for (auto module : previous->indexedModules)
+    {
+        if (!staleModules.contains(module))
+            indexedModules.add(module);
+    }
+    for (const auto& [moduleDecl, markup] : previous->markupASTs)
+    {
+        if (!staleModules.contains(moduleDecl->module))
+            markupASTs[moduleDecl] = markup;
+    }
+    // Modules that are not parsed again don't report their diagnostics again.
+    for (const auto& [path, documentDiagnostics] : previous->diagnostics)
+    {
+        if (liveFilePaths.contains(path))
+            diagnostics[path] = documentDiagnostics;
+    }
+}
+
 ASTMarkup* WorkspaceVersion::getOrCreateMarkupAST(ModuleDecl* module)
 {
     RefPtr<ASTMarkup> astMarkup;
@@ -640,9 +898,21 @@ Module* WorkspaceVersion::getOrLoadModule(String path)
         if (docDiagnostic)
             docDiagnostic->originalOutput = diagnosticString;
     }
+    updateSymbolIndex();
     return static_cast<Module*>(parsedModule);
 }
 
+void WorkspaceVersion::updateSymbolIndex()
+{
+    // Index the modules that were imported on the way too.
+    auto symbolIndex = workspace->getSymbolIndex();
+    for (auto& module : linkage->loadedModulesList)
+    {
+        if (indexedModules.add(module.get()))
+            symbolIndex->addModule(linkage, module);
+    }
+}
+
 MacroDefinitionContentAssistInfo* WorkspaceVersion::tryGetMacroDefinition(UnownedStringSlice name)
 {
     if (macroDefinitions.getCount() == 0)
@@ -7,6 +7,7 @@
 #include "slang-com-ptr.h"
 #include "slang-compiler.h"
 #include "slang-doc-ast.h"
+#include "slang-language-server-symbol-index.h"
 #include "slang.h"
 
 namespace Slang
@@ -20,9 +21,13 @@ private:
     String path;
     String text;
     List<UnownedStringSlice> lines;
+    // The maps of each line are computed when a position on the line is first converted, and
+    // are empty until then.
     List<List<Index>> mapUTF16CharIndexToCodePointIndex;
     List<List<Index>> mapCodePointIndexToUTF8ByteOffset;
 
+    void ensureUTFBoundsAvailable(Index lineIndex);
+
 public:
     void setPath(String filePath)
     {
@@ -33,8 +38,9 @@ public:
     String getPath() { return path; }
     const String& getText() { return text; }
     void setText(const String& newText);
-
-    void ensureUTFBoundsAvailable();
+    // Replace the text between the byte offsets `startOffset` and `endOffset`. The lines are
+    // only split again around the replaced text, and the maps of the other lines are kept.
+    void replaceText(Index startOffset, Index endOffset, UnownedStringSlice replacement);
     ArrayView<Index> getUTF16Boundaries(Index line);
     ArrayView<Index> getUTF8Boundaries(Index line);
 
@@ -141,14 +147,28 @@ private:
     Dictionary<String, Module*> modules;
     Dictionary<ModuleDecl*, RefPtr<ASTMarkup>> markupASTs;
     Dictionary<Name*, MacroDefinitionContentAssistInfo*> macroDefinitions;
+    // Modules of `linkage` whose declarations are in the workspace's symbol index.
+    HashSet<Module*> indexedModules;
     void parseDiagnostics(String compilerOutput);
+    void updateSymbolIndex();
 
 public:
     Workspace* workspace;
     WorkspaceFlavor flavor = WorkspaceFlavor::Standard;
     RefPtr<Linkage> linkage;
     Dictionary<String, DocumentDiagnostics> diagnostics;
+    // The encoded semantic tokens of each document, as computed for this version.
+    Dictionary<String, List<uint32_t>> encodedSemanticTokens;
+    // Number of versions in a row that have reused the linkage, including this one.
+    Index incrementalUpdateCount = 0;
     ASTMarkup* getOrCreateMarkupAST(ModuleDecl* module);
+    // Take over the modules, markup and diagnostics of `previous` that are still valid after
+    // the `staleModules` of its linkage are parsed again. `liveFilePaths` are the files the
+    // remaining modules depend on.
+    void inheritUnchangedState(
+        WorkspaceVersion* previous,
+        const HashSet<Module*>& staleModules,
+        const HashSet<String>& liveFilePaths);
     Module* getOrLoadModule(String path);
     void ensureWorkspaceFlavor(UnownedStringSlice path);
     MacroDefinitionContentAssistInfo* tryGetMacroDefinition(UnownedStringSlice name);
@@ -164,7 +184,20 @@ class Workspace : public ISlangFileSystem, public ComObject
 private:
     RefPtr<WorkspaceVersion> currentVersion;
     RefPtr<WorkspaceVersion> currentCompletionVersion;
+    // The last version before documents in `changedDocumentPaths` were edited. Its linkage
+    // is reused by the next version, so that only the modules affected by the edits are
+    // parsed and checked again.
+    RefPtr<WorkspaceVersion> reusableVersion;
+    HashSet<String> changedDocumentPaths;
+    // The number of times the workspace was invalidated, and how many of them were edits
+    // of each document.
+    Index changeCount = 0;
+    Dictionary<String, Index> documentChangeCounts;
+    RefPtr<WorkspaceSymbolIndex> symbolIndex;
+    // The file the symbol index is saved to, if any.
+    String symbolIndexFilePath;
     RefPtr<WorkspaceVersion> createWorkspaceVersion();
+    RefPtr<WorkspaceVersion> createIncrementalWorkspaceVersion();
 
 public:
     List<String> rootDirectories;
@@ -189,10 +222,20 @@ public:
 
     void init(List<URI> rootDirURI, slang::IGlobalSession* globalSession);
     void invalidate();
+    // Invalidate the current version after the text of the document at `path` changed.
+    void invalidateDocument(const String& path);
+    // Get a count that changes whenever the workspace is invalidated, except by edits of the
+    // document at `path`.
+    Index getChangeCountExcludingDocument(const String& path);
     WorkspaceVersion* getCurrentVersion();
     WorkspaceVersion* getCurrentCompletionVersion() { return currentCompletionVersion.Ptr(); }
     WorkspaceVersion* createVersionForCompletion();
 
+    WorkspaceSymbolIndex* getSymbolIndex();
+    // Keep the symbol index in a file in `directory`, and load what was saved there before.
+    void setSymbolIndexCacheDirectory(const String& directory);
+    void saveSymbolIndex();
+
 public:
     // Inherited via ISlangFileSystem
     SLANG_COM_OBJECT_IUNKNOWN_ALL
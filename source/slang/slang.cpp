@@ -23,6 +23,9 @@
 #include "slang-check.h"
 #include "slang-doc-ast.h"
 #include "slang-doc-markdown-writer.h"
+#include "slang-ir-link.h"
+#include "slang-ir-pass-profile.h"
+#include "slang-ir-specialization-cache.h"
 #include "slang-lookup.h"
 #include "slang-lower-to-ir.h"
 #include "slang-mangle.h"
@@ -31,6 +34,7 @@
 #include "slang-parameter-binding.h"
 #include "slang-parser.h"
 #include "slang-preprocessor.h"
+#include "slang-reflection-blob-writer.h"
 #include "slang-reflection-json.h"
 #include "slang-repro.h"
 #include "slang-serialize-ast.h"
@@ -40,6 +44,10 @@
 #include "slang-type-layout.h"
 
 #include <sys/stat.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
 
 // Used to print exception type names in internal-compiler-error messages
 #include <typeinfo>
@@ -154,6 +162,10 @@ const char* getBuildTagString()
     return SLANG_TAG_VERSION;
 }
 
+static SHA1::Digest _computePreludeDigest(const String& prelude)
+{
+    return SHA1::compute(prelude.getBuffer(), prelude.getLength());
+}
 
 void Session::init()
 {
@@ -237,6 +249,8 @@ void Session::init()
     m_languagePreludes[Index(SourceLanguage::CUDA)] = get_slang_cuda_prelude();
     m_languagePreludes[Index(SourceLanguage::CPP)] = get_slang_cpp_prelude();
     m_languagePreludes[Index(SourceLanguage::HLSL)] = get_slang_hlsl_prelude();
+    for (Index i = 0; i < Index(SourceLanguage::CountOf); ++i)
+        m_languagePreludeDigests[i] = _computePreludeDigest(m_languagePreludes[i]);
 
     if (!spirvCoreGrammarInfo)
         spirvCoreGrammarInfo = SPIRVCoreGrammarInfo::getEmbeddedVersion();
@@ -372,6 +386,7 @@ void Session::writeCoreModuleDoc(String config)
 
 SlangResult Session::compileCoreModule(slang::CompileCoreModuleFlags compileFlags)
 {
+    SLANG_PROFILE;
     SLANG_AST_BUILDER_RAII(m_builtinLinkage->getASTBuilder());
 
     if (m_builtinLinkage->mapNameToLoadedModules.getCount())
@@ -388,12 +403,20 @@ SlangResult Session::compileCoreModule(slang::CompileCoreModuleFlags compileFlag
     fprintf(stderr, "Compiling core module on debug build, this can take a while.\n");
 #endif
 
+    // The meta modules are generated into a single source, as the declarations of each of them
+    // depend on those of the ones before it, and that source is checked and lowered as one
+    // module.
+    //
     // TODO(JS): Could make this return a SlangResult as opposed to exception
-    StringBuilder coreModuleSrcBuilder;
-    coreModuleSrcBuilder << (const char*)getCoreLibraryCode()->getBufferPointer()
-                         << (const char*)getHLSLLibraryCode()->getBufferPointer()
-                         << (const char*)getAutodiffLibraryCode()->getBufferPointer();
-    auto coreModuleSrcBlob = StringBlob::moveCreate(coreModuleSrcBuilder.produceString());
+    ComPtr<ISlangBlob> coreModuleSrcBlob;
+    {
+        SLANG_PROFILE_SECTION(generateCoreModuleSource);
+        StringBuilder coreModuleSrcBuilder;
+        coreModuleSrcBuilder << (const char*)getCoreLibraryCode()->getBufferPointer()
+                             << (const char*)getHLSLLibraryCode()->getBufferPointer()
+                             << (const char*)getAutodiffLibraryCode()->getBufferPointer();
+        coreModuleSrcBlob = StringBlob::moveCreate(coreModuleSrcBuilder.produceString());
+    }
     addBuiltinSource(coreLanguageScope, "core", coreModuleSrcBlob);
 
     if (compileFlags & slang::CompileCoreModuleFlag::WriteDocumentation)
@@ -435,12 +458,56 @@ SlangResult Session::loadCoreModule(const void* coreModule, size_t coreModuleSiz
 
     SLANG_AST_BUILDER_RAII(m_builtinLinkage->getASTBuilder());
 
-    // Make a file system to read it from
-    ComPtr<ISlangFileSystemExt> fileSystem;
-    SLANG_RETURN_ON_FAIL(loadArchiveFileSystem(coreModule, coreModuleSizeInBytes, fileSystem));
+    SharedCoreModule* sharedCoreModule =
+        SharedCoreModule::findOrAdd(coreModule, coreModuleSizeInBytes);
+
+    // Only the first session to load this core module needs to extract it from the archive.
+    ComPtr<ISlangBlob> moduleBlob;
+    {
+        std::lock_guard<std::mutex> lock(sharedCoreModule->mutex);
+        if (!sharedCoreModule->moduleBlob)
+        {
+            ComPtr<ISlangFileSystemExt> fileSystem;
+            SLANG_RETURN_ON_FAIL(
+                loadArchiveFileSystem(coreModule, coreModuleSizeInBytes, fileSystem));
+            SLANG_RETURN_ON_FAIL(
+                fileSystem->loadFile("core.slang-module", sharedCoreModule->moduleBlob.writeRef()));
+        }
+        moduleBlob = sharedCoreModule->moduleBlob;
+    }
 
     // Let's try loading serialized modules and adding them
-    SLANG_RETURN_ON_FAIL(_readBuiltinModule(fileSystem, coreLanguageScope, "core"));
+    const Index firstModuleIndex = coreModules.getCount();
+    SLANG_RETURN_ON_FAIL(_readBuiltinModule(moduleBlob, coreLanguageScope, "core"));
+
+    // The AST is specific to this session, but the IR can be shared with every other session
+    // that loaded the same core module. That requires its source locations to mean the same
+    // here as in the session that read it, which they will as long as the builtin source
+    // manager has been used the same way.
+    {
+        std::lock_guard<std::mutex> lock(sharedCoreModule->mutex);
+        const SourceRange sourceRange = getBuiltinSourceManager()->getSourceRange();
+        const Index moduleCount = coreModules.getCount() - firstModuleIndex;
+        if (!sharedCoreModule->hasIRModuleSlots)
+        {
+            sharedCoreModule->sourceRange = sourceRange;
+            for (Index i = 0; i < moduleCount; ++i)
+                sharedCoreModule->irModuleSlots.add(new SerialSharedIRModuleSlot);
+            sharedCoreModule->hasIRModuleSlots = true;
+        }
+
+        if (sourceRange.begin == sharedCoreModule->sourceRange.begin &&
+            sourceRange.end == sharedCoreModule->sourceRange.end &&
+            moduleCount == sharedCoreModule->irModuleSlots.getCount())
+        {
+            for (Index i = 0; i < moduleCount; ++i)
+            {
+                Module* module = coreModules[firstModuleIndex + i];
+                if (auto deferredIRModule = module->getDeferredIRModule())
+                    deferredIRModule->setSharedSlot(sharedCoreModule->irModuleSlots[i]);
+            }
+        }
+    }
 
     finalizeSharedASTBuilder();
     return SLANG_OK;
@@ -448,6 +515,8 @@ SlangResult Session::loadCoreModule(const void* coreModule, size_t coreModuleSiz
 
 SlangResult Session::saveCoreModule(SlangArchiveType archiveType, ISlangBlob** outBlob)
 {
+    SLANG_PROFILE;
+
     if (m_builtinLinkage->mapNameToLoadedModules.getCount() == 0)
     {
         // There is no standard lib loaded
@@ -469,6 +538,8 @@ SlangResult Session::saveCoreModule(SlangArchiveType archiveType, ISlangBlob** o
 
     for (const auto& [moduleName, module] : m_builtinLinkage->mapNameToLoadedModules)
     {
+        SLANG_PROFILE_SECTION(serializeCoreModule);
+
         // Set up options
         SerialContainerUtil::WriteOptions options;
 
@@ -493,31 +564,59 @@ SlangResult Session::saveCoreModule(SlangArchiveType archiveType, ISlangBlob** o
     }
 
     // Now need to convert into a blob
+    SLANG_PROFILE_SECTION(storeCoreModuleArchive);
     SLANG_RETURN_ON_FAIL(archiveFileSystem->storeArchive(true, outBlob));
     return SLANG_OK;
 }
 
-SlangResult Session::_readBuiltinModule(
-    ISlangFileSystem* fileSystem,
-    Scope* scope,
-    String moduleName)
+namespace
+{ // anonymous
+
+// A builtin module container, along with the blob it was read from in place.
+struct BuiltinModuleContainer : public RefObject
 {
-    // Get the name of the module
-    StringBuilder moduleFilename;
-    moduleFilename << moduleName << ".slang-module";
+    ComPtr<ISlangBlob> blob;
+    RiffContainer container;
+};
 
-    RiffContainer riffContainer;
-    {
-        // Load it
-        ComPtr<ISlangBlob> blob;
-        SLANG_RETURN_ON_FAIL(fileSystem->loadFile(moduleFilename.getBuffer(), blob.writeRef()));
+} // namespace
 
-        // Set up a stream
-        MemoryStreamBase stream(FileAccess::Read, blob->getBufferPointer(), blob->getBufferSize());
+std::mutex SharedCoreModule::s_mutex;
+Dictionary<SHA1::Digest, RefPtr<SharedCoreModule>>* SharedCoreModule::s_sharedCoreModules;
 
-        // Load the riff container
-        SLANG_RETURN_ON_FAIL(RiffUtil::read(&stream, riffContainer));
-    }
+/* static */ SharedCoreModule* SharedCoreModule::findOrAdd(const void* data, size_t size)
+{
+    const SHA1::Digest digest = SHA1::compute(data, SlangInt(size));
+
+    std::lock_guard<std::mutex> lock(s_mutex);
+    if (!s_sharedCoreModules)
+        s_sharedCoreModules = new Dictionary<SHA1::Digest, RefPtr<SharedCoreModule>>();
+
+    RefPtr<SharedCoreModule>& sharedCoreModule = (*s_sharedCoreModules)[digest];
+    if (!sharedCoreModule)
+        sharedCoreModule = new SharedCoreModule;
+    return sharedCoreModule;
+}
+
+/* static */ void SharedCoreModule::freeAll()
+{
+    std::lock_guard<std::mutex> lock(s_mutex);
+    delete s_sharedCoreModules;
+    s_sharedCoreModules = nullptr;
+}
+
+SlangResult Session::_readBuiltinModule(ISlangBlob* moduleBlob, Scope* scope, String moduleName)
+{
+    // The container references the blob's contents, so the blob must outlive it.
+    // Both are kept for as long as the modules are, as their IR is read on first use.
+    RefPtr<BuiltinModuleContainer> moduleContainer = new BuiltinModuleContainer;
+    moduleContainer->blob = moduleBlob;
+
+    RiffContainer& riffContainer = moduleContainer->container;
+    SLANG_RETURN_ON_FAIL(RiffUtil::readInPlace(
+        moduleBlob->getBufferPointer(),
+        moduleBlob->getBufferSize(),
+        riffContainer));
 
     // Load up the module
 
@@ -541,6 +640,10 @@ SlangResult Session::_readBuiltinModule(
     // Hmm - don't have a suitable sink yet, so attempt to just not have one
     options.sink = nullptr;
 
+    // Sessions that only check or reflect code never need the builtin modules' IR, so it's
+    // only read once something, typically linking, asks for it.
+    options.deferIRContainerOwner = moduleContainer;
+
     SLANG_RETURN_ON_FAIL(
         SerialContainerUtil::read(&riffContainer, options, nullptr, containerData));
 
@@ -564,7 +667,10 @@ SlangResult Session::_readBuiltinModule(
             module->setModuleDecl(moduleDecl);
         }
 
-        module->setIRModule(srcModule.irModule);
+        if (srcModule.deferredIRModule)
+            module->setDeferredIRModule(srcModule.deferredIRModule);
+        else
+            module->setIRModule(srcModule.irModule);
 
         // Put in the loaded module map
         linkage->mapNameToLoadedModules.add(sessionNamePool->getName(moduleName), module);
@@ -670,6 +776,7 @@ Session::createSession(slang::SessionDesc const& inDesc, slang::ISession** outSe
     RefPtr<Linkage> linkage = new Linkage(this, astBuilder, getBuiltinLinkage());
 
     linkage->setMatrixLayoutMode(desc.defaultMatrixLayoutMode);
+    linkage->setThreadSafe((desc.flags & slang::kSessionFlags_ThreadSafe) != 0);
 
     Int searchPathCount = desc.searchPathCount;
     for (Int ii = 0; ii < searchPathCount; ++ii)
@@ -790,6 +897,8 @@ Session::setLanguagePrelude(SlangSourceLanguage inSourceLanguage, char const* pr
     if (sourceLanguage != SourceLanguage::Unknown)
     {
         m_languagePreludes[int(sourceLanguage)] = prelude;
+        m_languagePreludeDigests[int(sourceLanguage)] =
+            _computePreludeDigest(m_languagePreludes[int(sourceLanguage)]);
     }
 }
 
@@ -1119,8 +1228,12 @@ Linkage::Linkage(Session* session, ASTBuilder* astBuilder, Linkage* builtinLinka
     , m_astBuilder(astBuilder)
     , m_cmdLineContext(new CommandLineContext())
 {
-    if (builtinLinkage)
-        m_astBuilder->m_cachedNodes = builtinLinkage->getASTBuilder()->m_cachedNodes;
+    m_memoryAccounting = new MemoryAccounting();
+    m_astBuilder->setMemoryAccounting(m_memoryAccounting);
+
+    // The AST builder already finds the Vals of the builtin modules through the shared AST
+    // builder, so there is nothing to copy from `builtinLinkage`.
+    SLANG_UNUSED(builtinLinkage);
 
     getNamePool()->setRootNamePool(session->getRootNamePool());
 
@@ -1147,6 +1260,12 @@ ISlangUnknown* Linkage::getInterface(const Guid& guid)
 {
     if (guid == ISlangUnknown::getTypeGuid() || guid == ISession::getTypeGuid())
         return asExternal(this);
+    if (guid == IBatchCompileService_Experimental::getTypeGuid())
+        return static_cast<slang::IBatchCompileService_Experimental*>(this);
+    if (guid == IMemoryStats::getTypeGuid())
+        return static_cast<slang::IMemoryStats*>(this);
+    if (guid == ICompileCancellation::getTypeGuid())
+        return static_cast<slang::ICompileCancellation*>(this);
 
     return nullptr;
 }
@@ -1156,6 +1275,90 @@ Linkage::~Linkage()
     destroyTypeCheckingCache();
 }
 
+SlangResult Linkage::getMemoryUsage(
+    SlangMemoryCategory category,
+    uint64_t* outCurrentBytes,
+    uint64_t* outPeakBytes)
+{
+    return m_memoryAccounting->getUsage(category, outCurrentBytes, outPeakBytes);
+}
+
+void Linkage::resetPeakMemoryUsage()
+{
+    m_memoryAccounting->resetPeaks();
+}
+
+static int64_t _getSteadyClockNanoseconds()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+void Linkage::cancel()
+{
+    m_isCanceled = true;
+}
+
+void Linkage::cancelAfter(uint32_t milliseconds)
+{
+    // 0 means that no time is set, so at least a nanosecond has to pass.
+    m_cancelTime =
+        Math::Max(_getSteadyClockNanoseconds() + int64_t(milliseconds) * 1000000, int64_t(1));
+}
+
+void Linkage::resetCancellation()
+{
+    m_isCanceled = false;
+    m_cancelTime = 0;
+}
+
+bool Linkage::isCanceled()
+{
+    if (m_isCanceled)
+        return true;
+    const int64_t cancelTime = m_cancelTime;
+    return cancelTime != 0 && _getSteadyClockNanoseconds() >= cancelTime;
+}
+
+void Linkage::checkForCancellation(DiagnosticSink* sink)
+{
+    if (!isCanceled())
+        return;
+    if (sink)
+        sink->diagnose(SourceLoc(), Diagnostics::compilationCanceled);
+    throw CompilationCanceledException();
+}
+
+bool Linkage::isOverMemoryBudget()
+{
+    const uint64_t budgetMiB = uint64_t(m_optionSet.getIntOption(CompilerOptionName::MemoryBudget));
+    return budgetMiB > 0 && m_memoryAccounting->getTotalCurrentBytes() > budgetMiB * 1024 * 1024;
+}
+
+void Linkage::compressIdleModuleIR()
+{
+    const int64_t idleSeconds = m_optionSet.getIntOption(CompilerOptionName::CompressIdleModuleIR);
+    if (idleSeconds <= 0)
+        return;
+
+    const int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::steady_clock::now().time_since_epoch())
+                            .count();
+    const int64_t idleNanoseconds = idleSeconds * 1000 * 1000 * 1000;
+
+    // No code can be generated while the IR is released, as it may be using the IR of any
+    // module. See `Module::compressIRModule`.
+    auto codeGenLock = lockForCodeGen();
+    for (auto module : loadedModulesList)
+    {
+        if (module->isIRModuleCompressed() || now - module->getLastIRUseTime() < idleNanoseconds)
+            continue;
+        // A module that can't be compressed keeps its IR, which is still correct.
+        module->compressIRModule();
+    }
+}
+
 SearchDirectoryList& Linkage::getSearchDirectories()
 {
     auto list = m_optionSet.getArray(CompilerOptionName::Include);
@@ -1165,6 +1368,21 @@ SearchDirectoryList& Linkage::getSearchDirectories()
         for (auto dir : list)
             searchDirectoryCache.searchDirectories.add(SearchDirectory(dir.stringValue));
     }
+
+    // The listings are read from the OS file system, so they can only be used when the linkage
+    // loads through it.
+    if (m_fileSystem == nullptr &&
+        m_optionSet.getBoolOption(CompilerOptionName::IndexSearchDirectories))
+    {
+        if (!m_searchDirectoryIndex)
+            m_searchDirectoryIndex =
+                new SearchDirectoryIndex(getSessionImpl()->m_directoryListingCache);
+        searchDirectoryCache.index = m_searchDirectoryIndex;
+    }
+    else
+    {
+        searchDirectoryCache.index = nullptr;
+    }
     return searchDirectoryCache;
 }
 
@@ -1222,7 +1440,10 @@ SLANG_NO_THROW slang::ITarget* SLANG_MCALL Linkage::getTargetByIndex(SlangInt in
 SLANG_NO_THROW slang::IModule* SLANG_MCALL
 Linkage::loadModule(const char* moduleName, slang::IBlob** outDiagnostics)
 {
+    auto threadSafetyLock = lockIfThreadSafe();
+
     SLANG_AST_BUILDER_RAII(getASTBuilder());
+    compressIdleModuleIR();
 
     DiagnosticSink sink(getSourceManager(), Lexer::sourceLocationLexer);
     applySettingsToDiagnosticSink(&sink, &sink, m_optionSet);
@@ -1255,7 +1476,10 @@ slang::IModule* Linkage::loadModuleFromBlob(
     ModuleBlobType blobType,
     slang::IBlob** outDiagnostics)
 {
+    auto threadSafetyLock = lockIfThreadSafe();
+
     SLANG_AST_BUILDER_RAII(getASTBuilder());
+    compressIdleModuleIR();
 
     DiagnosticSink sink(getSourceManager(), Lexer::sourceLocationLexer);
     applySettingsToDiagnosticSink(&sink, &sink, m_optionSet);
@@ -1345,10 +1569,13 @@ SLANG_NO_THROW SlangResult SLANG_MCALL Linkage::createCompositeComponentType(
     slang::IComponentType** outCompositeComponentType,
     ISlangBlob** outDiagnostics)
 {
+    auto threadSafetyLock = lockIfThreadSafe();
+
     if (outCompositeComponentType == nullptr)
         return SLANG_E_INVALID_ARG;
 
     SLANG_AST_BUILDER_RAII(getASTBuilder());
+    compressIdleModuleIR();
 
     // Attempting to create a "composite" of just one component type should
     // just return the component type itself, to avoid redundant work.
@@ -1384,6 +1611,8 @@ SLANG_NO_THROW slang::TypeReflection* SLANG_MCALL Linkage::specializeType(
     SlangInt specializationArgCount,
     ISlangBlob** outDiagnostics)
 {
+    auto threadSafetyLock = lockIfThreadSafe();
+
     SLANG_AST_BUILDER_RAII(getASTBuilder());
 
     auto unspecializedType = asInternal(inUnspecializedType);
@@ -1564,6 +1793,8 @@ SLANG_NO_THROW slang::TypeLayoutReflection* SLANG_MCALL Linkage::getTypeLayout(
     slang::LayoutRules rules,
     ISlangBlob** outDiagnostics)
 {
+    auto threadSafetyLock = lockIfThreadSafe();
+
     SLANG_AST_BUILDER_RAII(getASTBuilder());
 
     auto type = asInternal(inType);
@@ -1596,6 +1827,8 @@ SLANG_NO_THROW slang::TypeReflection* SLANG_MCALL Linkage::getContainerType(
     slang::ContainerType containerType,
     ISlangBlob** outDiagnostics)
 {
+    auto threadSafetyLock = lockIfThreadSafe();
+
     SLANG_AST_BUILDER_RAII(getASTBuilder());
 
     auto type = asInternal(inType);
@@ -1647,6 +1880,8 @@ SLANG_NO_THROW slang::TypeReflection* SLANG_MCALL Linkage::getContainerType(
 
 SLANG_NO_THROW slang::TypeReflection* SLANG_MCALL Linkage::getDynamicType()
 {
+    auto threadSafetyLock = lockIfThreadSafe();
+
     SLANG_AST_BUILDER_RAII(getASTBuilder());
 
     return asExternal(getASTBuilder()->getSharedASTBuilder()->getDynamicType());
@@ -1655,6 +1890,8 @@ SLANG_NO_THROW slang::TypeReflection* SLANG_MCALL Linkage::getDynamicType()
 SLANG_NO_THROW SlangResult SLANG_MCALL
 Linkage::getTypeRTTIMangledName(slang::TypeReflection* type, ISlangBlob** outNameBlob)
 {
+    auto threadSafetyLock = lockIfThreadSafe();
+
     SLANG_AST_BUILDER_RAII(getASTBuilder());
 
     auto internalType = asInternal(type);
@@ -1673,6 +1910,8 @@ SLANG_NO_THROW SlangResult SLANG_MCALL Linkage::getTypeConformanceWitnessMangled
     slang::TypeReflection* interfaceType,
     ISlangBlob** outNameBlob)
 {
+    auto threadSafetyLock = lockIfThreadSafe();
+
     SLANG_AST_BUILDER_RAII(getASTBuilder());
 
     auto subType = asInternal(type);
@@ -1688,6 +1927,8 @@ SLANG_NO_THROW SlangResult SLANG_MCALL Linkage::getTypeConformanceWitnessSequent
     slang::TypeReflection* interfaceType,
     uint32_t* outId)
 {
+    auto threadSafetyLock = lockIfThreadSafe();
+
     SLANG_AST_BUILDER_RAII(getASTBuilder());
 
     auto subType = asInternal(type);
@@ -1726,6 +1967,8 @@ SLANG_NO_THROW SlangResult SLANG_MCALL Linkage::createTypeConformanceComponentTy
     SlangInt conformanceIdOverride,
     ISlangBlob** outDiagnostics)
 {
+    auto threadSafetyLock = lockIfThreadSafe();
+
     if (outConformanceComponentType == nullptr)
         return SLANG_E_INVALID_ARG;
 
@@ -1769,16 +2012,40 @@ Linkage::createCompileRequest(SlangCompileRequest** outCompileRequest)
 
 SLANG_NO_THROW SlangInt SLANG_MCALL Linkage::getLoadedModuleCount()
 {
+    auto threadSafetyLock = lockIfThreadSafe();
+
     return loadedModulesList.getCount();
 }
 
 SLANG_NO_THROW slang::IModule* SLANG_MCALL Linkage::getLoadedModule(SlangInt index)
 {
+    auto threadSafetyLock = lockIfThreadSafe();
+
     if (index >= 0 && index < loadedModulesList.getCount())
         return loadedModulesList[index].get();
     return nullptr;
 }
 
+PersistentCache* Linkage::getCompilationCache()
+{
+    auto threadSafetyLock = lockIfThreadSafe();
+
+    if (!m_compilationCache)
+    {
+        const String directory =
+            m_optionSet.getStringOption(CompilerOptionName::CompilationCachePath);
+        if (directory.getLength() == 0)
+            return nullptr;
+
+        PersistentCache::Desc desc;
+        desc.directory = directory.getBuffer();
+        desc.maxEntryCount =
+            m_optionSet.getIntOption(CompilerOptionName::CompilationCacheMaxEntryCount);
+        m_compilationCache = new PersistentCache(desc);
+    }
+    return m_compilationCache;
+}
+
 void Linkage::buildHash(DigestBuilder<SHA1>& builder, SlangInt targetIndex)
 {
     // Add the Slang compiler version to the hash
@@ -1797,14 +2064,11 @@ void Linkage::buildHash(DigestBuilder<SHA1>& builder, SlangInt targetIndex)
         const SourceLanguage sourceLanguage =
             getDefaultSourceLanguageForDownstreamCompiler(passThroughMode);
 
-        // Add prelude for the given downstream compiler.
-        ComPtr<ISlangBlob> prelude;
-        getGlobalSession()->getLanguagePrelude(
-            (SlangSourceLanguage)sourceLanguage,
-            prelude.writeRef());
-        if (prelude)
+        // Add prelude for the given downstream compiler. Preludes can be large, so we use
+        // the digest computed when the prelude was set, rather than hashing it again.
+        if (sourceLanguage != SourceLanguage::Unknown)
         {
-            builder.append(prelude);
+            builder.append(getSessionImpl()->getPreludeDigestForLanguage(sourceLanguage));
         }
 
         // TODO: Downstream compilers (specifically dxc) can currently #include additional
@@ -1874,13 +2138,20 @@ TargetRequest::TargetRequest(Linkage* linkage, CodeGenTarget format)
 {
     optionSet = linkage->m_optionSet;
     optionSet.add(CompilerOptionName::Target, format);
+
+    // The cache is created up front, since the entry points of a program may be specialized
+    // on several threads.
+    m_irSpecializationCache = new IRSpecializationCache(linkage->getSessionImpl());
 }
 
 TargetRequest::TargetRequest(const TargetRequest& other)
     : RefObject(), linkage(other.linkage), optionSet(other.optionSet)
 {
+    m_irSpecializationCache = new IRSpecializationCache(linkage->getSessionImpl());
 }
 
+TargetRequest::~TargetRequest() {}
+
 
 Session* TargetRequest::getSession()
 {
@@ -2054,6 +2325,13 @@ CapabilitySet TargetRequest::getTargetCaps()
 }
 
 
+TypeLayoutCache* TargetRequest::getTypeLayoutCache()
+{
+    if (!m_typeLayoutCache)
+        m_typeLayoutCache = new TypeLayoutCache();
+    return m_typeLayoutCache;
+}
+
 TypeLayout* TargetRequest::getTypeLayout(Type* type, slang::LayoutRules rules)
 {
     SLANG_AST_BUILDER_RAII(getLinkage()->getASTBuilder());
@@ -2069,6 +2347,7 @@ TypeLayout* TargetRequest::getTypeLayout(Type* type, slang::LayoutRules rules)
     // maps to the ordering via some API on the program layout).
     //
     auto layoutContext = getInitialLayoutContextForTarget(this, nullptr, rules);
+    layoutContext.layoutCache = getTypeLayoutCache();
 
     RefPtr<TypeLayout> result;
     auto key = TypeLayoutKey{type, rules};
@@ -3166,6 +3445,62 @@ RefPtr<ComponentType> createSpecializedGlobalAndEntryPointsComponentType(
     EndToEndCompileRequest* endToEndReq,
     List<RefPtr<ComponentType>>& outSpecializedEntryPoints);
 
+void FrontEndCompileRequest::lexSourceFilesInParallel(Count threadCount)
+{
+    SLANG_PROFILE;
+
+    auto linkage = getLinkage();
+
+    // The preprocessor doesn't use the token cache in the language server.
+    if (linkage->isInLanguageServer())
+        return;
+
+    // The views are only used to lex the files. Preprocessing creates views of its own, and
+    // the cached tokens are moved into them.
+    auto sourceManager = linkage->getSourceManager();
+    List<SourceView*> sourceViews;
+    for (TranslationUnitRequest* translationUnit : translationUnits)
+    {
+        if (translationUnit->isChecked)
+            continue;
+        for (auto sourceFile : translationUnit->getSourceFiles())
+            sourceViews.add(sourceManager->createSourceView(sourceFile, nullptr, SourceLoc()));
+    }
+    if (sourceViews.getCount() < 2)
+        return;
+
+    linkage->getPreprocessorTokenCache()->addTokens(
+        sourceViews.getArrayView(),
+        linkage->getNamePool(),
+        threadCount);
+}
+
+/// Add the translation unit at `index`, after the ones it imports, to `outOrder`.
+static void _addTranslationUnitInCheckOrder(
+    Index index,
+    List<RefPtr<TranslationUnitRequest>> const& translationUnits,
+    List<List<Index>> const& importedIndices,
+    List<bool>& ioIsVisited,
+    List<TranslationUnitRequest*>& outOrder)
+{
+    if (ioIsVisited[index])
+        return;
+    ioIsVisited[index] = true;
+
+    // Translation units that import each other are left in the order they were added, as
+    // there's no order in which both can find the other already checked.
+    for (auto importedIndex : importedIndices[index])
+    {
+        _addTranslationUnitInCheckOrder(
+            importedIndex,
+            translationUnits,
+            importedIndices,
+            ioIsVisited,
+            outOrder);
+    }
+    outOrder.add(translationUnits[index]);
+}
+
 void FrontEndCompileRequest::checkAllTranslationUnits()
 {
     SLANG_PROFILE;
@@ -3174,21 +3509,57 @@ void FrontEndCompileRequest::checkAllTranslationUnits()
     if (additionalLoadedModules)
         loadedModules = *additionalLoadedModules;
 
+    // Find which translation units of this request import each other, so that each one
+    // can be checked after the ones it imports, and `findOrImportModule` finds them in
+    // `loadedModules` rather than loading them again.
+    //
+    const Count translationUnitCount = translationUnits.getCount();
+    Dictionary<Name*, Index> mapModuleNameToIndex;
+    for (Index i = 0; i < translationUnitCount; ++i)
+        mapModuleNameToIndex.addIfNotExists(translationUnits[i]->moduleName, i);
+
+    List<List<Index>> importedIndices;
+    importedIndices.setCount(translationUnitCount);
+    for (Index i = 0; i < translationUnitCount; ++i)
+    {
+        auto moduleDecl = translationUnits[i]->getModuleDecl();
+        if (!moduleDecl)
+            continue;
+        for (auto importDecl : moduleDecl->getMembersOfType<ImportDecl>())
+        {
+            Index importedIndex = -1;
+            if (mapModuleNameToIndex.tryGetValue(importDecl->moduleNameAndLoc.name, importedIndex))
+                importedIndices[i].add(importedIndex);
+        }
+    }
+
+    List<bool> isVisited;
+    isVisited.setCount(translationUnitCount);
+    for (auto& visited : isVisited)
+        visited = false;
+
+    List<TranslationUnitRequest*> checkOrder;
+    for (Index i = 0; i < translationUnitCount; ++i)
+    {
+        _addTranslationUnitInCheckOrder(
+            i,
+            translationUnits,
+            importedIndices,
+            isVisited,
+            checkOrder);
+    }
+
     // Iterate over all translation units and
     // apply the semantic checking logic.
-    for (auto& translationUnit : translationUnits)
+    for (auto translationUnit : checkOrder)
     {
         if (translationUnit->isChecked)
             continue;
 
-        checkTranslationUnit(translationUnit.Ptr(), loadedModules);
+        checkTranslationUnit(translationUnit, loadedModules);
 
         // Add the checked module to list of loadedModules so that they can be
         // discovered by `findOrImportModule` when processing future `import` decls.
-        // TODO: this does not handle the case where a translation unit to discover
-        // another translation unit added later to the compilation request.
-        // We should output an error message when we detect such a case, or support
-        // this scenario with a recursive style checking.
         loadedModules.add(translationUnit->moduleName, translationUnit->getModule());
     }
     checkEntryPoints();
@@ -3270,6 +3641,10 @@ void FrontEndCompileRequest::generateIR()
         // Set the module on the translation unit
         translationUnit->getModule()->setIRModule(irModule);
     }
+
+    // The modules imported by the translation units can now be lowered, if that was left until
+    // the functions they reference were known.
+    getLinkage()->generatePendingModuleIR(getSink());
 }
 
 // Try to infer a single common source language for a request
@@ -3308,6 +3683,12 @@ SlangResult FrontEndCompileRequest::executeActionsInner()
     }
 
 
+    const Count threadCount = optionSet.getIntOption(CompilerOptionName::FrontEndThreadCount);
+    if (threadCount > 1)
+    {
+        lexSourceFilesInParallel(threadCount);
+    }
+
     // Parse everything from the input files requested
     for (TranslationUnitRequest* translationUnit : translationUnits)
     {
@@ -3411,6 +3792,10 @@ EndToEndCompileRequest::queryInterface(SlangUUID const& uuid, void** outObject)
         return SLANG_OK;
     }
 
+    // Cancelling a request cancels the compilations of its linkage.
+    if (uuid == slang::ICompileCancellation::getTypeGuid())
+        return m_linkage->queryInterface(uuid, outObject);
+
     return SLANG_E_NO_INTERFACE;
 }
 
@@ -3512,6 +3897,11 @@ SlangResult EndToEndCompileRequest::executeActionsInner()
         }
     }
 
+    if (m_precompiledModuleOutputDir.getLength())
+    {
+        return writePrecompiledModules();
+    }
+
     // If codegen is enabled, we need to move along to
     // apply any generic specialization that the user asked for.
     //
@@ -3772,14 +4162,114 @@ void Linkage::loadParsedModule(
             // IR code for the imported module.
             if (errorCountAfter == 0)
             {
-                loadedModule->setIRModule(
-                    generateIRForTranslationUnit(getASTBuilder(), translationUnit));
+                // With `LowerReferencedFunctionsOnly`, the IR of a module loaded for an
+                // `import` is generated once the code that imports it has been checked, when
+                // we know which of its functions that code references.
+                //
+                if (m_optionSet.getBoolOption(CompilerOptionName::LowerReferencedFunctionsOnly) &&
+                    m_modulesBeingImported && m_modulesBeingImported->importLoc.isValid())
+                {
+                    auto& lazilyLoweredModule = m_lazilyLoweredModules[loadedModule.get()];
+                    lazilyLoweredModule.frontEndReq = compileRequest;
+                    lazilyLoweredModule.translationUnit = translationUnit;
+                }
+                else
+                {
+                    loadedModule->setIRModule(
+                        generateIRForTranslationUnit(getASTBuilder(), translationUnit));
+                    generatePendingModuleIR(sink);
+                }
             }
         }
     }
     loadedModulesList.add(loadedModule);
 }
 
+void Linkage::_generateLazilyLoweredModuleIR(
+    Module* module,
+    LazilyLoweredModule& lazilyLoweredModule,
+    bool lowerReferencedFunctionsOnly,
+    DiagnosticSink* sink)
+{
+    // The request that loaded the module has completed, so its sink may be gone.
+    lazilyLoweredModule.frontEndReq->setSink(sink);
+
+    if (auto irModule = module->getIRModule())
+        lazilyLoweredModule.replacedIRModules.add(irModule);
+    module->setLowersReferencedFunctionsOnly(lowerReferencedFunctionsOnly);
+    module->setIRModule(
+        generateIRForTranslationUnit(getASTBuilder(), lazilyLoweredModule.translationUnit));
+}
+
+void Linkage::generatePendingModuleIR(DiagnosticSink* sink)
+{
+    if (m_lazilyLoweredModules.getCount() == 0)
+        return;
+
+    auto threadSafetyLock = lockIfThreadSafe();
+
+    // Generating the IR of one module can check more code, and so reference functions of
+    // modules whose IR was already generated.
+    for (bool generatedIR = true; generatedIR;)
+    {
+        generatedIR = false;
+        for (auto& [module, lazilyLoweredModule] : m_lazilyLoweredModules)
+        {
+            if (module->getIRModule() && !module->isIRMissingReferencedFunctions())
+                continue;
+            _generateLazilyLoweredModuleIR(module, lazilyLoweredModule, true, sink);
+            generatedIR = true;
+        }
+    }
+}
+
+void Linkage::generateCompleteModuleIR(Module* module, DiagnosticSink* sink)
+{
+    auto threadSafetyLock = lockIfThreadSafe();
+
+    auto lazilyLoweredModule = m_lazilyLoweredModules.tryGetValue(module);
+    if (!lazilyLoweredModule)
+        return;
+    if (module->getIRModule() && !module->lowersReferencedFunctionsOnly())
+        return;
+    _generateLazilyLoweredModuleIR(module, *lazilyLoweredModule, false, sink);
+}
+
+void Linkage::unloadModules(const HashSet<Module*>& modules)
+{
+    if (modules.getCount() == 0)
+        return;
+
+    List<RefPtr<LoadedModule>> remainingModules;
+    for (auto& module : loadedModulesList)
+    {
+        if (!modules.contains(module.get()))
+            remainingModules.add(module);
+    }
+    loadedModulesList = _Move(remainingModules);
+
+    List<String> pathsToRemove;
+    for (const auto& [path, module] : mapPathToLoadedModule)
+    {
+        if (modules.contains(module.get()))
+            pathsToRemove.add(path);
+    }
+    for (auto& path : pathsToRemove)
+        mapPathToLoadedModule.remove(path);
+
+    List<Name*> namesToRemove;
+    for (const auto& [name, module] : mapNameToLoadedModules)
+    {
+        if (modules.contains(module.get()))
+            namesToRemove.add(name);
+    }
+    for (auto name : namesToRemove)
+        mapNameToLoadedModules.remove(name);
+
+    for (auto module : modules)
+        m_lazilyLoweredModules.remove(module);
+}
+
 RefPtr<Module> Linkage::loadDeserializedModule(
     Name* name,
     const PathInfo& filePathInfo,
@@ -3819,12 +4309,12 @@ RefPtr<Module> Linkage::loadModuleFromIRBlobImpl(
     String mostUniqueIdentity = filePathInfo.getMostUniqueIdentity();
     SLANG_ASSERT(mostUniqueIdentity.getLength() > 0);
 
+    // The container references the blob in place, rather than copying out its contents.
     RiffContainer container;
-    MemoryStreamBase readStream(
-        FileAccess::Read,
+    SLANG_RETURN_NULL_ON_FAIL(RiffUtil::readInPlace(
         fileContentsBlob->getBufferPointer(),
-        fileContentsBlob->getBufferSize());
-    SLANG_RETURN_NULL_ON_FAIL(RiffUtil::read(&readStream, container));
+        fileContentsBlob->getBufferSize(),
+        container));
 
     if (m_optionSet.getBoolOption(CompilerOptionName::UseUpToDateBinaryModule))
     {
@@ -4137,6 +4627,12 @@ RefPtr<Module> Linkage::findOrImportModule(
                 return loadedModule;
 
             // Try to load it
+            if (!fileContents && checkBinaryModule == 1 &&
+                m_optionSet.getBoolOption(CompilerOptionName::MapBinaryModules))
+            {
+                // If it can't be mapped, just fall back to loading it the usual way.
+                mapBinaryModuleFile(filePathInfo, fileContents);
+            }
             if (!fileContents && SLANG_FAILED(includeSystem.loadFile(filePathInfo, fileContents)))
             {
                 continue;
@@ -4163,6 +4659,119 @@ RefPtr<Module> Linkage::findOrImportModule(
     return nullptr;
 }
 
+void Linkage::prefetchImportedModuleFiles(const List<Name*>& names, SourceLoc const& loc)
+{
+    // The contents are held by the file system of the global session, which is only what the
+    // linkage loads through if it is using the default file system.
+    if (m_fileSystem || !m_optionSet.getBoolOption(CompilerOptionName::PrefetchImportedModules))
+        return;
+
+    IncludeSystem includeSystem(&getSearchDirectories(), getFileSystemExt(), getSourceManager());
+    PathInfo pathIncludedFromInfo = getSourceManager()->getPathInfo(loc, SourceLocType::Actual);
+
+    // Find the file each module would be loaded from, in the order `findOrImportModule` looks
+    // for them. Finding goes through the file system of the linkage, so it is done on this
+    // thread.
+    List<String> paths;
+    for (auto name : names)
+    {
+        if (!name || name->text == "glsl" || mapNameToLoadedModules.containsKey(name))
+            continue;
+
+        bool found = false;
+        for (auto checkBinaryModule : {true, false})
+        {
+            if (isInLanguageServer())
+                checkBinaryModule = !checkBinaryModule;
+
+            for (int translateUnderScore = 0; translateUnderScore <= 1 && !found;
+                 translateUnderScore++)
+            {
+                auto fileName = getFileNameFromModuleName(name, translateUnderScore == 1);
+                if (checkBinaryModule)
+                    fileName = Path::replaceExt(fileName, "slang-module");
+
+                PathInfo filePathInfo;
+                if (SLANG_FAILED(includeSystem.findFile(
+                        fileName,
+                        pathIncludedFromInfo.foundPath,
+                        filePathInfo)))
+                    continue;
+                found = true;
+
+                // Binary modules that are mapped aren't read.
+                const bool isMapped =
+                    checkBinaryModule &&
+                    m_optionSet.getBoolOption(CompilerOptionName::MapBinaryModules);
+                if (!isMapped &&
+                    !mapPathToLoadedModule.containsKey(filePathInfo.getMostUniqueIdentity()))
+                    paths.add(filePathInfo.foundPath);
+            }
+            if (found)
+                break;
+        }
+    }
+    if (paths.getCount() < 2)
+        return;
+
+    ISlangFileSystemExt* sharedFileSystem = getSessionImpl()->m_sharedFileSystem;
+    std::atomic<Index> nextPathIndex(0);
+    auto worker = [&]()
+    {
+        for (;;)
+        {
+            const Index pathIndex = nextPathIndex++;
+            if (pathIndex >= paths.getCount())
+                break;
+
+            // A file that can't be read is just read again, and fails, when it is imported.
+            ComPtr<ISlangBlob> blob;
+            sharedFileSystem->loadFile(paths[pathIndex].getBuffer(), blob.writeRef());
+        }
+    };
+
+    const Count threadCount =
+        Math::Min(paths.getCount(), Count(Math::Max(std::thread::hardware_concurrency(), 1u)));
+    std::vector<std::thread> threads;
+    for (Index i = 0; i < threadCount; ++i)
+        threads.emplace_back(worker);
+    for (auto& thread : threads)
+        thread.join();
+}
+
+SlangResult Linkage::mapBinaryModuleFile(const PathInfo& pathInfo, ComPtr<ISlangBlob>& outBlob)
+{
+    // Mapping goes directly to the OS, so is only equivalent to loading through the file system
+    // if that's the default one.
+    if (m_fileSystem)
+        return SLANG_E_NOT_AVAILABLE;
+
+    auto sourceManager = getSourceManager();
+    SourceFile* sourceFile = sourceManager->findSourceFileRecursively(pathInfo.uniqueIdentity);
+    if (sourceFile && sourceFile->getContentBlob())
+    {
+        outBlob = sourceFile->getContentBlob();
+        return SLANG_OK;
+    }
+
+    ComPtr<ISlangBlob> mappedBlob;
+    SLANG_RETURN_ON_FAIL(File::mapAllBytes(pathInfo.foundPath, mappedBlob.writeRef()));
+
+    // Register the file the same way `IncludeSystem::loadFile` would, so later lookups find it.
+    if (sourceFile)
+    {
+        sourceFile->setContents(mappedBlob);
+    }
+    else
+    {
+        sourceFile = sourceManager->createSourceFileWithBlob(pathInfo, mappedBlob);
+        sourceManager->addSourceFile(pathInfo.uniqueIdentity, sourceFile);
+    }
+
+    outBlob = mappedBlob;
+    return SLANG_OK;
+}
+
 SourceFile* Linkage::loadSourceFile(String pathFrom, String path)
 {
     IncludeSystem includeSystem(&getSearchDirectories(), getFileSystemExt(), getSourceManager());
@@ -4177,6 +4786,8 @@ SourceFile* Linkage::loadSourceFile(String pathFrom, String path)
 // Check if a serialized module is up-to-date with current compiler options and source files.
 bool Linkage::isBinaryModuleUpToDate(String fromPath, RiffContainer* container)
 {
+    auto threadSafetyLock = lockIfThreadSafe();
+
     DiagnosticSink sink;
     SerialContainerUtil::ReadOptions readOptions;
     readOptions.linkage = this;
@@ -4218,19 +4829,52 @@ bool Linkage::isBinaryModuleUpToDate(String fromPath, RiffContainer* container)
         }
     }
 
-    for (auto file : moduleHeader.dependentFiles)
+    // A file whose time and size match its stamp still has the contents it had when the
+    // module was written, so the digest in the stamp can be used without reading the file.
+    const bool canStatFiles = getFileSystemExt()->getOSPathKind() == OSPathKind::Direct;
+    auto findFileDigest = [&](const String& pathFrom,
+                              const String& path,
+                              const SerialContainerDataModule::FileStamp* stamp,
+                              SHA1::Digest& outDigest) -> bool
     {
-        auto sourceFile = loadSourceFile(fromPath, file);
-        if (!sourceFile)
-        {
-            // If we cannot find the source file from `fromPath`,
-            // try again from the module's source file path.
-            if (moduleHeader.dependentFiles.getCount() != 0)
-                sourceFile = loadSourceFile(moduleSrcPath, file);
-        }
-        if (!sourceFile)
-            return false;
-        digestBuilder.append(sourceFile->getDigest());
+        IncludeSystem includeSystem(
+            &getSearchDirectories(),
+            getFileSystemExt(),
+            getSourceManager());
+        PathInfo pathInfo;
+        if (SLANG_FAILED(includeSystem.findFile(path, pathFrom, pathInfo)))
+            return false;
+        if (stamp && stamp->size && canStatFiles && pathInfo.hasFileFoundPath())
+        {
+            uint64_t modifiedTime = 0, size = 0;
+            if (SLANG_SUCCEEDED(
+                    File::getModifiedTimeAndSize(pathInfo.foundPath, modifiedTime, size)) &&
+                modifiedTime == stamp->modifiedTime && size == stamp->size)
+            {
+                outDigest = stamp->digest;
+                return true;
+            }
+        }
+        ComPtr<slang::IBlob> blob;
+        SourceFile* sourceFile = nullptr;
+        if (SLANG_FAILED(includeSystem.loadFile(pathInfo, blob, sourceFile)) || !sourceFile)
+            return false;
+        outDigest = sourceFile->getDigest();
+        return true;
+    };
+
+    const auto& stamps = moduleHeader.dependentFileStamps;
+    for (Index i = 0; i < moduleHeader.dependentFiles.getCount(); i++)
+    {
+        const auto& file = moduleHeader.dependentFiles[i];
+        auto stamp = i < stamps.getCount() ? &stamps[i] : nullptr;
+        SHA1::Digest fileDigest;
+        // If we cannot find the source file from `fromPath`,
+        // try again from the module's source file path.
+        if (!findFileDigest(fromPath, file, stamp, fileDigest) &&
+            !findFileDigest(moduleSrcPath, file, stamp, fileDigest))
+            return false;
+        digestBuilder.append(fileDigest);
     }
     return digestBuilder.finalize() == moduleHeader.digest;
 }
@@ -4239,15 +4883,183 @@ SLANG_NO_THROW bool SLANG_MCALL
 Linkage::isBinaryModuleUpToDate(const char* modulePath, slang::IBlob* binaryModuleBlob)
 {
     RiffContainer container;
-    MemoryStreamBase readStream(
-        FileAccess::Read,
-        binaryModuleBlob->getBufferPointer(),
-        binaryModuleBlob->getBufferSize());
-    if (SLANG_FAILED(RiffUtil::read(&readStream, container)))
+    if (SLANG_FAILED(RiffUtil::readInPlace(
+            binaryModuleBlob->getBufferPointer(),
+            binaryModuleBlob->getBufferSize(),
+            container)))
         return false;
     return isBinaryModuleUpToDate(modulePath, &container);
 }
 
+// Write the diagnostics of `first` followed by those of `second` to `outDiagnostics`.
+static void _appendDiagnostics(
+    ISlangBlob* first,
+    ISlangBlob* second,
+    ComPtr<ISlangBlob>& outDiagnostics)
+{
+    if (!first || !second)
+    {
+        outDiagnostics = first ? first : second;
+        return;
+    }
+    StringBuilder builder;
+    builder << StringUtil::getSlice(first) << StringUtil::getSlice(second);
+    outDiagnostics = StringBlob::moveCreate(builder);
+}
+
+SLANG_NO_THROW SlangResult SLANG_MCALL Linkage::compileBatch(
+    slang::BatchCompileItem const* items,
+    SlangInt itemCount,
+    SlangInt threadCount,
+    slang::BatchCompileCallback callback,
+    void* userData)
+{
+    if (itemCount < 0 || (itemCount != 0 && !items) || !callback)
+        return SLANG_E_INVALID_ARG;
+
+    // Items with the same program and specialization arguments share the linked program, and
+    // so the layout and the code generated for each target, which the program caches.
+    struct LinkedProgram
+    {
+        ComPtr<slang::IComponentType> program;
+        ComPtr<ISlangBlob> diagnostics;
+        SlangResult result = SLANG_OK;
+    };
+    List<LinkedProgram> linkedPrograms;
+    List<Index> linkedProgramIndices;
+    Dictionary<String, Index> linkedProgramIndexForKey;
+
+    // Specializing and linking holds the linkage lock anyway, so it is done up front on this
+    // thread.
+    for (Index i = 0; i < itemCount; ++i)
+    {
+        auto& item = items[i];
+        StringBuilder key;
+        key << UInt64(size_t(item.program));
+        for (SlangInt a = 0; a < item.specializationArgCount; ++a)
+        {
+            auto& arg = item.specializationArgs[a];
+            key << "," << Int32(arg.kind) << ":" << UInt64(size_t(arg.type));
+        }
+
+        if (auto found = linkedProgramIndexForKey.tryGetValue(key))
+        {
+            linkedProgramIndices.add(*found);
+            continue;
+        }
+
+        LinkedProgram linked;
+        if (!item.program)
+        {
+            linked.result = SLANG_E_INVALID_ARG;
+        }
+        else
+        {
+            ComPtr<slang::IComponentType> specialized(item.program);
+            ComPtr<ISlangBlob> specializeDiagnostics;
+            if (item.specializationArgCount)
+            {
+                specialized = nullptr;
+                linked.result = item.program->specialize(
+                    item.specializationArgs,
+                    item.specializationArgCount,
+                    specialized.writeRef(),
+                    specializeDiagnostics.writeRef());
+            }
+
+            ComPtr<ISlangBlob> linkDiagnostics;
+            if (SLANG_SUCCEEDED(linked.result))
+                linked.result =
+                    specialized->link(linked.program.writeRef(), linkDiagnostics.writeRef());
+            _appendDiagnostics(specializeDiagnostics, linkDiagnostics, linked.diagnostics);
+        }
+
+        linkedProgramIndexForKey.add(key, linkedPrograms.getCount());
+        linkedProgramIndices.add(linkedPrograms.getCount());
+        linkedPrograms.add(linked);
+    }
+
+    // With `ReleaseIntermediateIR`, a linked program, along with everything generated for it but
+    // the code, is released as soon as its last item is done.
+    const bool shouldReleaseLinkedPrograms =
+        m_optionSet.getBoolOption(CompilerOptionName::ReleaseIntermediateIR);
+    List<Count> remainingItemCounts;
+    remainingItemCounts.setCount(linkedPrograms.getCount());
+    for (auto& count : remainingItemCounts)
+        count = 0;
+    for (auto index : linkedProgramIndices)
+        remainingItemCounts[index]++;
+    std::mutex remainingItemCountsMutex;
+
+    std::atomic<Index> nextItemIndex(0);
+    std::atomic<bool> anyFailed(false);
+    auto worker = [&]()
+    {
+        for (;;)
+        {
+            const Index itemIndex = nextItemIndex++;
+            if (itemIndex >= itemCount)
+                break;
+
+            auto& item = items[itemIndex];
+            auto& linked = linkedPrograms[linkedProgramIndices[itemIndex]];
+            SlangResult result = linked.result;
+            ComPtr<ISlangBlob> code;
+            ComPtr<ISlangBlob> diagnostics;
+            if (SLANG_SUCCEEDED(result))
+            {
+                ComPtr<ISlangBlob> codeGenDiagnostics;
+                try
+                {
+                    result = linked.program->getEntryPointCode(
+                        item.entryPointIndex,
+                        item.targetIndex,
+                        code.writeRef(),
+                        codeGenDiagnostics.writeRef());
+                }
+                catch (...)
+                {
+                    result = SLANG_FAIL;
+                }
+                _appendDiagnostics(linked.diagnostics, codeGenDiagnostics, diagnostics);
+            }
+            else
+            {
+                diagnostics = linked.diagnostics;
+            }
+
+            if (SLANG_FAILED(result))
+                anyFailed = true;
+            callback(userData, itemIndex, result, code, diagnostics);
+
+            if (shouldReleaseLinkedPrograms)
+            {
+                std::lock_guard<std::mutex> lock(remainingItemCountsMutex);
+                if (--remainingItemCounts[linkedProgramIndices[itemIndex]] == 0)
+                    linked.program = nullptr;
+            }
+        }
+    };
+
+    // Workers are only used in a thread safe linkage, and this thread does its share of the
+    // work. Code generation holds the linkage lock (see `Linkage::lockForCodeGen`) up to the
+    // downstream compile, so that is the part of the items that overlaps. The items must not
+    // be compiled from here with the lock held, which would serialize the downstream
+    // compiles as well.
+    std::vector<std::thread> threads;
+    if (isThreadSafe())
+    {
+        const Count workerCount = Math::Min(Count(threadCount), Count(itemCount)) - 1;
+        for (Index i = 0; i < workerCount; ++i)
+            threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads)
+        thread.join();
+
+    return anyFailed ? SLANG_FAIL : SLANG_OK;
+}
+
 SourceFile* Linkage::findFile(Name* name, SourceLoc loc, IncludeSystem& outIncludeSystem)
 {
     auto impl = [&](bool translateUnderScore) -> SourceFile*
@@ -4450,6 +5262,9 @@ Module::Module(Linkage* linkage, ASTBuilder* astBuilder)
     addModuleDependency(this);
 }
 
+// Defined here, where `SerialDeferredIRModule` is complete.
+Module::~Module() {}
+
 ISlangUnknown* Module::getInterface(const Guid& guid)
 {
     if (guid == IModule::getTypeGuid())
@@ -4506,6 +5321,100 @@ void Module::setModuleDecl(ModuleDecl* moduleDecl)
     moduleDecl->module = this;
 }
 
+IRModule* Module::getIRModule()
+{
+    if (m_deferredIRModule)
+        return m_deferredIRModule->getIRModule();
+
+    _noteIRUsed();
+    std::lock_guard<std::mutex> lock(m_compressedIRModuleMutex);
+    if (m_compressedIRModule)
+    {
+        SLANG_AST_BUILDER_RAII(getLinkage()->getASTBuilder());
+        RefPtr<IRModule> irModule;
+        if (SLANG_FAILED(m_compressedIRModule->read(getLinkage()->getSessionImpl(), irModule)))
+        {
+            SLANG_ASSERT(!"Unable to read compressed IR module");
+        }
+        m_irModule = irModule;
+        m_compressedIRModule = nullptr;
+    }
+    return m_irModule;
+}
+
+void Module::setIRModule(IRModule* irModule)
+{
+    std::lock_guard<std::mutex> lock(m_compressedIRModuleMutex);
+    m_irModule = irModule;
+    m_compressedIRModule = nullptr;
+    _noteIRUsed();
+}
+
+bool Module::isIRModuleCompressed()
+{
+    std::lock_guard<std::mutex> lock(m_compressedIRModuleMutex);
+    return m_compressedIRModule.get() != nullptr;
+}
+
+SlangResult Module::compressIRModule()
+{
+    // The IR is handed out as a raw pointer, so it may only be released while nothing can be
+    // using it. Code generation holds this lock throughout, as does the front end of a thread
+    // safe linkage.
+    auto codeGenLock = getLinkage()->lockForCodeGen();
+    std::lock_guard<std::mutex> lock(m_compressedIRModuleMutex);
+
+    // IR that is read on demand is already serialized, and IR that something else holds can't
+    // be released.
+    if (!m_irModule || m_deferredIRModule || !m_irModule->isUniquelyReferenced())
+        return SLANG_OK;
+
+    RefPtr<SerialCompressedIRModule> compressedIRModule;
+    SLANG_RETURN_ON_FAIL(SerialCompressedIRModule::create(m_irModule, compressedIRModule));
+    m_compressedIRModule = compressedIRModule;
+    m_irModule = nullptr;
+    return SLANG_OK;
+}
+
+void Module::_noteIRUsed()
+{
+    m_lastIRUseTime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          std::chrono::steady_clock::now().time_since_epoch())
+                          .count();
+}
+
+void Module::setDeferredIRModule(SerialDeferredIRModule* deferredIRModule)
+{
+    m_deferredIRModule = deferredIRModule;
+}
+
+void Module::setLowersReferencedFunctionsOnly(bool value)
+{
+    m_lowersReferencedFunctionsOnly = value;
+    m_isIRMissingReferencedFunctions = false;
+    m_unloweredFunctionDecls.clear();
+}
+
+void Module::noteFunctionReferenced(Decl* decl)
+{
+    // A generic function is lowered as a whole.
+    if (auto genericDecl = as<GenericDecl>(decl->parentDecl))
+    {
+        if (genericDecl->inner == decl)
+            decl = genericDecl;
+    }
+    if (m_referencedFunctionDecls.add(decl) && m_unloweredFunctionDecls.contains(decl))
+        m_isIRMissingReferencedFunctions = true;
+}
+
+bool Module::shouldSkipLoweringFunction(Decl* decl)
+{
+    if (!m_lowersReferencedFunctionsOnly || m_referencedFunctionDecls.contains(decl))
+        return false;
+    m_unloweredFunctionDecls.add(decl);
+    return true;
+}
+
 void Module::setName(String name)
 {
     m_name = getLinkage()->getNamePool()->getName(name);
@@ -4514,6 +5423,8 @@ void Module::setName(String name)
 
 RefPtr<EntryPoint> Module::findEntryPointByName(UnownedStringSlice const& name)
 {
+    auto threadSafetyLock = getLinkage()->lockIfThreadSafe();
+
     for (auto entryPoint : m_entryPoints)
     {
         if (entryPoint->getName()->text.getUnownedSlice() == name)
@@ -4528,6 +5439,8 @@ RefPtr<EntryPoint> Module::findAndCheckEntryPoint(
     SlangStage stage,
     ISlangBlob** outDiagnostics)
 {
+    auto threadSafetyLock = getLinkage()->lockIfThreadSafe();
+
     // If there is already an entrypoint marked with the [shader] attribute,
     // we should just return that.
     //
@@ -4561,6 +5474,11 @@ RefPtr<EntryPoint> Module::findAndCheckEntryPoint(
 void Module::_addEntryPoint(EntryPoint* entryPoint)
 {
     m_entryPoints.add(entryPoint);
+
+    // An entry point found by name after the module was loaded may be a function that the IR
+    // skipped.
+    if (auto funcDecl = entryPoint->getFuncDecl())
+        noteFunctionReferenced(funcDecl);
 }
 
 static bool _canExportDeclSymbol(ASTNodeType type)
@@ -4653,6 +5571,8 @@ ComponentType::ComponentType(Linkage* linkage)
 {
 }
 
+ComponentType::~ComponentType() {}
+
 ComponentType* asInternal(slang::IComponentType* inComponentType)
 {
     // Note: we use a `queryInterface` here instead of just a `static_cast`
@@ -4679,6 +5599,19 @@ ISlangUnknown* ComponentType::getInterface(Guid const& guid)
     return nullptr;
 }
 
+uint32_t ComponentType::_addRefThreadSafe()
+{
+    auto threadSafetyLock = m_linkage->lockIfThreadSafe();
+    return (uint32_t)addReference();
+}
+
+uint32_t ComponentType::_releaseThreadSafe()
+{
+    // The lock refers to the linkage, so it stays valid even if this releases `this`.
+    auto threadSafetyLock = m_linkage->lockIfThreadSafe();
+    return (uint32_t)releaseReference();
+}
+
 SLANG_NO_THROW slang::ISession* SLANG_MCALL ComponentType::getSession()
 {
     return m_linkage;
@@ -4687,6 +5620,8 @@ SLANG_NO_THROW slang::ISession* SLANG_MCALL ComponentType::getSession()
 SLANG_NO_THROW slang::ProgramLayout* SLANG_MCALL
 ComponentType::getLayout(Int targetIndex, slang::IBlob** outDiagnostics)
 {
+    auto threadSafetyLock = getLinkage()->lockIfThreadSafe();
+
     auto linkage = getLinkage();
     if (targetIndex < 0 || targetIndex >= linkage->targets.getCount())
         return nullptr;
@@ -4806,6 +5741,13 @@ SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::getResultAsFileSystem(
     return SLANG_OK;
 }
 
+/// The result of a request for code that produced none: either the compilation of the session
+/// was canceled, or it failed.
+static SlangResult _getNoCodeResult(Linkage* linkage)
+{
+    return linkage->isCanceled() ? SLANG_E_CANCELED : SLANG_FAIL;
+}
+
 SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::getEntryPointCode(
     SlangInt entryPointIndex,
     Int targetIndex,
@@ -4815,7 +5757,51 @@ SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::getEntryPointCode(
     auto linkage = getLinkage();
     if (targetIndex < 0 || targetIndex >= linkage->targets.getCount())
         return SLANG_E_INVALID_ARG;
+    if (entryPointIndex < 0 || entryPointIndex >= getEntryPointCount())
+        return SLANG_E_INVALID_ARG;
+
+    // Code that has already been produced is handed out again as is, so that asking for the
+    // code of an entry point every frame costs no more than a lookup.
+    if (auto existingCode = findExistingEntryPointCode(entryPointIndex, targetIndex))
+    {
+        existingCode->addRef();
+        *outCode = existingCode;
+        if (outDiagnostics)
+            *outDiagnostics = nullptr;
+        return SLANG_OK;
+    }
+
     auto target = linkage->targets[targetIndex];
+    auto setExistingEntryPointCode = [&](ISlangBlob* code)
+    {
+        auto lock = linkage->isThreadSafe() ? std::unique_lock<std::mutex>(m_entryPointCodesMutex)
+                                            : std::unique_lock<std::mutex>();
+        if (targetIndex >= m_entryPointCodes.getCount())
+            m_entryPointCodes.setCount(targetIndex + 1);
+        auto& codes = m_entryPointCodes[targetIndex];
+        if (entryPointIndex >= codes.getCount())
+            codes.setCount(entryPointIndex + 1);
+        codes[entryPointIndex] = code;
+    };
+
+    // If there is a compilation cache, code for an entry point that was compiled
+    // before (by this or another process) can be read from there instead.
+    PersistentCache* cache = linkage->getCompilationCache();
+    PersistentCache::Key cacheKey;
+    if (cache)
+    {
+        ComPtr<ISlangBlob> hash;
+        getEntryPointHash(entryPointIndex, targetIndex, hash.writeRef());
+        cacheKey = PersistentCache::Key(hash);
+
+        if (SLANG_SUCCEEDED(cache->readEntry(cacheKey, outCode)))
+        {
+            setExistingEntryPointCode(*outCode);
+            if (outDiagnostics)
+                *outDiagnostics = nullptr;
+            return SLANG_OK;
+        }
+    }
 
     auto targetProgram = getTargetProgram(target);
 
@@ -4827,9 +5813,53 @@ SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::getEntryPointCode(
     sink.getBlobIfNeeded(outDiagnostics);
 
     if (artifact == nullptr)
-        return SLANG_FAIL;
+        return _getNoCodeResult(linkage);
 
-    return artifact->loadBlob(ArtifactKeep::Yes, outCode);
+    SLANG_RETURN_ON_FAIL(artifact->loadBlob(ArtifactKeep::Yes, outCode));
+    if (cache)
+        cache->writeEntry(cacheKey, *outCode);
+    setExistingEntryPointCode(*outCode);
+    return SLANG_OK;
+}
+
+ISlangBlob* ComponentType::findExistingEntryPointCode(
+    SlangInt entryPointIndex,
+    SlangInt targetIndex)
+{
+    auto linkage = getLinkage();
+    auto lock = linkage->isThreadSafe() ? std::unique_lock<std::mutex>(m_entryPointCodesMutex)
+                                        : std::unique_lock<std::mutex>();
+    if (targetIndex >= m_entryPointCodes.getCount())
+        return nullptr;
+    auto& codes = m_entryPointCodes[targetIndex];
+    if (entryPointIndex >= codes.getCount())
+        return nullptr;
+    return codes[entryPointIndex];
+}
+
+SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::getEntryPointCodes(
+    SlangInt entryPointCount,
+    SlangInt const* entryPointIndices,
+    SlangInt targetIndex,
+    slang::IBlob** outCodes,
+    slang::IBlob** outDiagnostics)
+{
+    for (SlangInt i = 0; i < entryPointCount; ++i)
+    {
+        outCodes[i] = nullptr;
+        auto result =
+            getEntryPointCode(entryPointIndices[i], targetIndex, &outCodes[i], outDiagnostics);
+        if (SLANG_FAILED(result))
+        {
+            for (SlangInt j = 0; j < i; ++j)
+            {
+                outCodes[j]->release();
+                outCodes[j] = nullptr;
+            }
+            return result;
+        }
+    }
+    return SLANG_OK;
 }
 
 SLANG_NO_THROW void SLANG_MCALL ComponentType::getEntryPointHash(
@@ -4837,6 +5867,8 @@ SLANG_NO_THROW void SLANG_MCALL ComponentType::getEntryPointHash(
     SlangInt targetIndex,
     slang::IBlob** outHash)
 {
+    auto threadSafetyLock = getLinkage()->lockIfThreadSafe();
+
     DigestBuilder<SHA1> builder;
 
     // A note on enums that may be hashed in as part of the following two function calls:
@@ -4881,7 +5913,7 @@ SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::getEntryPointHostCallable(
     sink.getBlobIfNeeded(outDiagnostics);
 
     if (artifact == nullptr)
-        return SLANG_FAIL;
+        return _getNoCodeResult(linkage);
 
     return artifact->loadSharedLibrary(ArtifactKeep::Yes, outSharedLibrary);
 }
@@ -4918,11 +5950,52 @@ SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::getEntryPointMetadata(
     return SLANG_OK;
 }
 
+ComponentType* Linkage::findSpecializedComponentType(SpecializedComponentTypeKey const& key)
+{
+    auto threadSafetyLock = lockIfThreadSafe();
+    auto entry = m_specializedComponentTypes.tryGetValue(key);
+    if (!entry)
+        return nullptr;
+    entry->lastUse = ++m_specializedComponentTypeUseCount;
+    return entry->componentType;
+}
+
+void Linkage::addSpecializedComponentType(
+    SpecializedComponentTypeKey const& key,
+    ComponentType* componentType)
+{
+    auto threadSafetyLock = lockIfThreadSafe();
+    SpecializedComponentTypeEntry entry;
+    entry.componentType = componentType;
+    entry.lastUse = ++m_specializedComponentTypeUseCount;
+    m_specializedComponentTypes[key] = entry;
+
+    if (m_specializedComponentTypes.getCount() <= kMaxSpecializedComponentTypeCount)
+        return;
+
+    // Evict the least recently used entry. This only happens once the cache is full, and then
+    // once per added entry.
+    const SpecializedComponentTypeKey* leastRecentlyUsedKey = nullptr;
+    uint64_t leastRecentUse = 0;
+    for (auto& [cachedKey, cachedEntry] : m_specializedComponentTypes)
+    {
+        if (!leastRecentlyUsedKey || cachedEntry.lastUse < leastRecentUse)
+        {
+            leastRecentlyUsedKey = &cachedKey;
+            leastRecentUse = cachedEntry.lastUse;
+        }
+    }
+    SpecializedComponentTypeKey evictedKey = *leastRecentlyUsedKey;
+    m_specializedComponentTypes.remove(evictedKey);
+}
+
 RefPtr<ComponentType> ComponentType::specialize(
     SpecializationArg const* inSpecializationArgs,
     SlangInt specializationArgCount,
     DiagnosticSink* sink)
 {
+    auto threadSafetyLock = getLinkage()->lockIfThreadSafe();
+
     if (specializationArgCount == 0)
     {
         return this;
@@ -4931,15 +6004,37 @@ RefPtr<ComponentType> ComponentType::specialize(
     List<SpecializationArg> specializationArgs;
     specializationArgs.addRange(inSpecializationArgs, specializationArgCount);
 
+    // Applications often specialize the same component type with the same
+    // arguments many times, so we reuse the result of an earlier call when
+    // there is one.
+    //
+    SpecializedComponentTypeKey key;
+    key.base = this;
+    for (auto& arg : specializationArgs)
+        key.args.add(arg.val);
+
+    auto linkage = getLinkage();
+    if (auto found = linkage->findSpecializedComponentType(key))
+        return found;
+
     // We next need to validate that the specialization arguments
     // make sense, and also expand them to include any derived data
     // (e.g., interface conformance witnesses) that doesn't get
     // passed explicitly through the API interface.
     //
+    auto errorCountBefore = sink->getErrorCount();
     RefPtr<SpecializationInfo> specializationInfo =
         _validateSpecializationArgs(specializationArgs.getBuffer(), specializationArgCount, sink);
 
-    return new SpecializedComponentType(this, specializationInfo, specializationArgs, sink);
+    RefPtr<ComponentType> result =
+        new SpecializedComponentType(this, specializationInfo, specializationArgs, sink);
+
+    // A specialization that produced errors is not reused, so that its
+    // diagnostics are reported again by later calls.
+    //
+    if (sink->getErrorCount() == errorCountBefore)
+        linkage->addSpecializedComponentType(key, result);
+    return result;
 }
 
 SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::specialize(
@@ -4997,6 +6092,8 @@ SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::specialize(
 SLANG_NO_THROW SlangResult SLANG_MCALL
 ComponentType::renameEntryPoint(const char* newName, IComponentType** outEntryPoint)
 {
+    auto threadSafetyLock = getLinkage()->lockIfThreadSafe();
+
     RefPtr<RenamedEntryPointComponentType> result =
         new RenamedEntryPointComponentType(this, newName);
     *outEntryPoint = result.detach();
@@ -5008,6 +6105,8 @@ RefPtr<ComponentType> fillRequirements(ComponentType* inComponentType);
 SLANG_NO_THROW SlangResult SLANG_MCALL
 ComponentType::link(slang::IComponentType** outLinkedComponentType, ISlangBlob** outDiagnostics)
 {
+    auto threadSafetyLock = getLinkage()->lockIfThreadSafe();
+
     // TODO: It should be possible for `fillRequirements` to fail,
     // in cases where we have a dependency that can't be automatically
     // resolved.
@@ -5028,6 +6127,8 @@ SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::linkWithOptions(
     slang::CompilerOptionEntry* entries,
     ISlangBlob** outDiagnostics)
 {
+    auto threadSafetyLock = getLinkage()->lockIfThreadSafe();
+
     SLANG_RETURN_ON_FAIL(link(outLinkedComponentType, outDiagnostics));
 
     auto linked = *outLinkedComponentType;
@@ -5146,10 +6247,13 @@ IArtifact* ComponentType::getTargetArtifact(Int targetIndex, slang::IBlob** outD
     auto linkage = getLinkage();
     if (targetIndex < 0 || targetIndex >= linkage->targets.getCount())
         return nullptr;
-    ComPtr<IArtifact> artifact;
-    if (m_targetArtifacts.tryGetValue(targetIndex, artifact))
     {
-        return artifact.get();
+        auto threadSafetyLock = linkage->lockIfThreadSafe();
+        ComPtr<IArtifact> artifact;
+        if (m_targetArtifacts.tryGetValue(targetIndex, artifact))
+        {
+            return artifact.get();
+        }
     }
 
     // If the user hasn't specified any entry points, then we should
@@ -5184,6 +6288,7 @@ IArtifact* ComponentType::getTargetArtifact(Int targetIndex, slang::IBlob** outD
                                   ->getTargetArtifact(targetIndex, outDiagnostics);
         if (targetArtifact)
         {
+            auto threadSafetyLock = linkage->lockIfThreadSafe();
             m_targetArtifacts[targetIndex] = targetArtifact;
         }
         return targetArtifact;
@@ -5198,19 +6303,57 @@ IArtifact* ComponentType::getTargetArtifact(Int targetIndex, slang::IBlob** outD
 
     IArtifact* targetArtifact = targetProgram->getOrCreateWholeProgramResult(&sink);
     sink.getBlobIfNeeded(outDiagnostics);
+
+    // A canceled compilation is not remembered, so that the code can be asked for again.
+    if (targetArtifact == nullptr && linkage->isCanceled())
+        return nullptr;
+
+    auto threadSafetyLock = linkage->lockIfThreadSafe();
+
     m_targetArtifacts[targetIndex] = ComPtr<IArtifact>(targetArtifact);
     return targetArtifact;
 }
 
+void ComponentType::buildTargetCodeHash(DigestBuilder<SHA1>& builder, SlangInt targetIndex)
+{
+    getLinkage()->buildHash(builder, targetIndex);
+    buildHash(builder);
+
+    // Distinguish the whole program from the code for any single entry point.
+    builder.append(toSlice("targetCode"));
+}
+
 SLANG_NO_THROW SlangResult SLANG_MCALL
 ComponentType::getTargetCode(Int targetIndex, slang::IBlob** outCode, slang::IBlob** outDiagnostics)
 {
+    auto linkage = getLinkage();
+    if (targetIndex < 0 || targetIndex >= linkage->targets.getCount())
+        return SLANG_E_INVALID_ARG;
+
+    PersistentCache* cache = linkage->getCompilationCache();
+    PersistentCache::Key cacheKey;
+    if (cache)
+    {
+        DigestBuilder<SHA1> builder;
+        {
+            auto threadSafetyLock = linkage->lockIfThreadSafe();
+            buildTargetCodeHash(builder, targetIndex);
+        }
+        cacheKey = builder.finalize();
+
+        if (SLANG_SUCCEEDED(cache->readEntry(cacheKey, outCode)))
+            return SLANG_OK;
+    }
+
     IArtifact* artifact = getTargetArtifact(targetIndex, outDiagnostics);
 
     if (artifact == nullptr)
-        return SLANG_FAIL;
+        return _getNoCodeResult(getLinkage());
 
-    return artifact->loadBlob(ArtifactKeep::Yes, outCode);
+    SLANG_RETURN_ON_FAIL(artifact->loadBlob(ArtifactKeep::Yes, outCode));
+    if (cache)
+        cache->writeEntry(cacheKey, *outCode);
+    return SLANG_OK;
 }
 
 SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::getTargetMetadata(
@@ -5221,7 +6364,7 @@ SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::getTargetMetadata(
     IArtifact* artifact = getTargetArtifact(targetIndex, outDiagnostics);
 
     if (artifact == nullptr)
-        return SLANG_FAIL;
+        return _getNoCodeResult(getLinkage());
 
     auto metadata = findAssociatedRepresentation<IArtifactPostEmitMetadata>(artifact);
     if (!metadata)
@@ -5866,6 +7009,8 @@ void ComponentTypeVisitor::visitChildren(SpecializedComponentType* specialized)
 
 TargetProgram* ComponentType::getTargetProgram(TargetRequest* target)
 {
+    auto threadSafetyLock = getLinkage()->lockIfThreadSafe();
+
     RefPtr<TargetProgram> targetProgram;
     if (!m_targetPrograms.tryGetValue(target, targetProgram))
     {
@@ -5887,6 +7032,8 @@ TargetProgram::TargetProgram(ComponentType* componentType, TargetRequest* target
     m_optionSet.inheritFrom(targetReq->getOptionSet());
 }
 
+TargetProgram::~TargetProgram() {}
+
 //
 
 Session* CompileRequestBase::getSession()
@@ -5901,11 +7048,14 @@ void Linkage::setFileSystem(ISlangFileSystem* inFileSystem)
 
     // Release what's there
     m_fileSystemExt.setNull();
+    m_searchDirectoryIndex = nullptr;
 
     // If nullptr passed in set up default
     if (inFileSystem == nullptr)
     {
-        m_fileSystemExt = new Slang::CacheFileSystem(Slang::OSFileSystem::getExtSingleton());
+        // The cache of the linkage sits over the file system of the global session, so that
+        // files already loaded by another session are only reloaded if they have changed.
+        m_fileSystemExt = new Slang::CacheFileSystem(getSessionImpl()->m_sharedFileSystem);
     }
     else
     {
@@ -6017,6 +7167,8 @@ RefPtr<Module> findOrImportModule(
 
 void Session::addBuiltinSource(Scope* scope, String const& path, ISlangBlob* sourceBlob)
 {
+    SLANG_PROFILE;
+
     SourceManager* sourceManager = getBuiltinSourceManager();
 
     DiagnosticSink sink(sourceManager, Lexer::sourceLocationLexer);
@@ -6743,6 +7895,23 @@ SlangResult EndToEndCompileRequest::compile()
         getSession()->getCompilerElapsedTime(&totalStartTime, &downstreamStartTime);
         PerformanceProfiler::getProfiler()->clear();
     }
+
+    const String traceOutputPath = getOptionSet().getStringOption(CompilerOptionName::TraceOutput);
+    if (traceOutputPath.getLength() != 0)
+    {
+        PerformanceProfiler::getProfiler()->clear();
+        PerformanceProfiler::getProfiler()->setTraceEnabled(true);
+    }
+
+    const bool reportIRPassStatistics =
+        getOptionSet().getBoolOption(CompilerOptionName::ReportIRPassStatistics);
+    const String irPassStatisticsPath =
+        getOptionSet().getStringOption(CompilerOptionName::IRPassStatisticsJSON);
+    if (reportIRPassStatistics || irPassStatisticsPath.getLength() != 0)
+    {
+        IRPassProfiler::getProfiler()->clear();
+        IRPassProfiler::getProfiler()->setEnabled(true);
+    }
 #if !defined(SLANG_DEBUG_INTERNAL_ERROR)
     // By default we'd like to catch as many internal errors as possible,
     // and report them to the user nicely (rather than just crash their
@@ -6759,6 +7928,12 @@ SlangResult EndToEndCompileRequest::compile()
         SLANG_PROFILE_SECTION(compileInner);
         res = executeActions();
     }
+    catch (const CompilationCanceledException&)
+    {
+        // The compilation was canceled through the linkage, and the cancellation has
+        // already been diagnosed.
+        res = SLANG_E_CANCELED;
+    }
     catch (const AbortCompilationException& e)
     {
         // This situation indicates a fatal (but not necessarily internal) error
@@ -6819,12 +7994,63 @@ SlangResult EndToEndCompileRequest::compile()
         StringBuilder perfResult;
         PerformanceProfiler::getProfiler()->getResult(perfResult);
         perfResult << "\nType Dictionary Size: " << getSession()->m_typeDictionarySize << "\n";
+        const auto valStats = getLinkage()->getASTBuilder()->getValCacheStats();
+        perfResult << "Val Cache: " << valStats.hitCount << " hits ("
+                   << valStats.builtinHitCount << " in builtin modules), " << valStats.missCount
+                   << " misses, " << valStats.entryCount << " entries, " << valStats.memoryUsed
+                   << " bytes\n";
         getSink()->diagnose(
             SourceLoc(),
             Diagnostics::performanceBenchmarkResult,
             perfResult.produceString());
     }
 
+    if (reportIRPassStatistics || irPassStatisticsPath.getLength() != 0)
+    {
+        auto passProfiler = IRPassProfiler::getProfiler();
+        passProfiler->setEnabled(false);
+
+        if (reportIRPassStatistics)
+        {
+            StringBuilder report;
+            passProfiler->writeReport(report);
+            getSink()->diagnose(
+                SourceLoc(),
+                Diagnostics::irPassStatisticsResult,
+                report.produceString());
+        }
+        if (irPassStatisticsPath.getLength() != 0)
+        {
+            StringBuilder json;
+            passProfiler->writeJSON(json);
+            if (irPassStatisticsPath == "-")
+            {
+                StdWriters::getOut().write(json.getBuffer(), json.getLength());
+            }
+            else if (SLANG_FAILED(File::writeAllText(irPassStatisticsPath, json)))
+            {
+                getSink()->diagnose(
+                    SourceLoc(),
+                    Diagnostics::unableToWriteFile,
+                    irPassStatisticsPath);
+            }
+        }
+        passProfiler->clear();
+    }
+
+    if (traceOutputPath.getLength() != 0)
+    {
+        auto profiler = PerformanceProfiler::getProfiler();
+        profiler->setTraceEnabled(false);
+
+        StringBuilder traceJSON;
+        profiler->getTraceJSON(traceJSON);
+        if (SLANG_FAILED(File::writeAllText(traceOutputPath, traceJSON)))
+        {
+            getSink()->diagnose(SourceLoc(), Diagnostics::unableToWriteFile, traceOutputPath);
+        }
+    }
+
     // Repro dump handling
     {
         auto dumpRepro = getOptionSet().getStringOption(CompilerOptionName::DumpRepro);
@@ -6863,19 +8089,60 @@ SlangResult EndToEndCompileRequest::compile()
     auto reflectionPath = getOptionSet().getStringOption(CompilerOptionName::EmitReflectionJSON);
     if (reflectionPath.getLength() != 0)
     {
-        auto bufferWriter = PrettyWriter();
-        emitReflectionJSON(this, this->getReflection(), bufferWriter);
+        // The reflection data of a large program can be far bigger than the program, so it is
+        // written out as it is produced instead of being built up in memory.
+        ComPtr<ISlangWriter> fileWriter;
+        ISlangWriter* reflectionWriter = nullptr;
         if (reflectionPath == "-")
         {
-            auto builder = bufferWriter.getBuilder();
-            StdWriters::getOut().write(builder.getBuffer(), builder.getLength());
+            reflectionWriter = StdWriters::getOut().getWriter();
+        }
+        else if (SLANG_SUCCEEDED(
+                     FileWriter::createText(reflectionPath.getBuffer(), 0, fileWriter)))
+        {
+            reflectionWriter = fileWriter;
+        }
+
+        List<String> includedNames;
+        auto filter = getOptionSet().getStringOption(CompilerOptionName::ReflectionJSONFilter);
+        if (filter.getLength())
+        {
+            List<UnownedStringSlice> names;
+            StringUtil::split(filter.getUnownedSlice(), ',', names);
+            for (auto name : names)
+            {
+                if (name.trim().getLength())
+                    includedNames.add(name.trim());
+            }
         }
-        else if (SLANG_FAILED(File::writeAllText(reflectionPath, bufferWriter.getBuilder())))
+
+        PrettyWriter bufferWriter;
+        bufferWriter.setSink(reflectionWriter);
+        bufferWriter.setCompact(
+            getOptionSet().getBoolOption(CompilerOptionName::ReflectionJSONCompact));
+        if (reflectionWriter)
+            emitReflectionJSON(this, this->getReflection(), bufferWriter, includedNames);
+        if (!reflectionWriter || SLANG_FAILED(bufferWriter.flush()))
         {
             getSink()->diagnose(SourceLoc(), Diagnostics::unableToWriteFile, reflectionPath);
         }
     }
 
+    auto reflectionBinaryPath =
+        getOptionSet().getStringOption(CompilerOptionName::EmitReflectionBinary);
+    if (reflectionBinaryPath.getLength() != 0)
+    {
+        ComPtr<ISlangBlob> reflectionBlob;
+        if (SLANG_FAILED(writeReflectionBlob(getReflection(), reflectionBlob)) ||
+            SLANG_FAILED(File::writeAllBytes(
+                reflectionBinaryPath,
+                reflectionBlob->getBufferPointer(),
+                reflectionBlob->getBufferSize())))
+        {
+            getSink()->diagnose(SourceLoc(), Diagnostics::unableToWriteFile, reflectionBinaryPath);
+        }
+    }
+
     return res;
 }
 
@@ -6955,7 +8222,8 @@ SlangResult EndToEndCompileRequest::getCompileTimeProfile(
         return SLANG_E_INVALID_ARG;
     }
 
-    SlangProfiler* profiler = new SlangProfiler(PerformanceProfiler::getProfiler());
+    SlangProfiler* profiler =
+        new SlangProfiler(PerformanceProfiler::getProfiler(), getLinkage()->getMemoryAccounting());
 
     if (shouldClear)
     {
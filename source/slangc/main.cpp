@@ -4,8 +4,11 @@
 
 SLANG_API void spSetCommandLineCompilerMode(SlangCompileRequest* request);
 
+#include "../compiler-core/slang-json-rpc-connection.h"
+#include "../compiler-core/slang-test-server-protocol.h"
 #include "../core/slang-io.h"
 #include "../core/slang-test-tool-util.h"
+#include "../core/slang-writer.h"
 
 using namespace Slang;
 
@@ -77,11 +80,12 @@ bool shouldEmbedPrelude(const char* const* argv, int argc)
     return false;
 }
 
-SLANG_TEST_TOOL_API SlangResult innerMain(
+static SlangResult _innerMain(
     StdWriters* stdWriters,
     slang::IGlobalSession* sharedSession,
     int argc,
-    const char* const* argv)
+    const char* const* argv,
+    bool isServerCompile)
 {
     StdWriters::setSingleton(stdWriters);
 
@@ -107,6 +111,16 @@ SLANG_TEST_TOOL_API SlangResult innerMain(
         TestToolUtil::setSessionDefaultPreludeFromExePath(argv[0], session);
 
     SlangCompileRequest* compileRequest = spCreateCompileRequest(session);
+    // A server compile must not write to the process's own streams, as the server uses them to
+    // talk to its client.
+    if (isServerCompile)
+    {
+        for (int i = 0; i < int{SLANG_WRITER_CHANNEL_COUNT_OF}; ++i)
+        {
+            const auto channel = SlangWriterChannel(i);
+            compileRequest->setWriter(channel, stdWriters->getWriter(channel));
+        }
+    }
     compileRequest->addSearchPath(Path::getParentDirectory(Path::getExecutablePath()).getBuffer());
     SlangResult res = _compile(compileRequest, argc, argv);
     // Now that we are done, clean up after ourselves
@@ -115,10 +129,115 @@ SLANG_TEST_TOOL_API SlangResult innerMain(
     return res;
 }
 
+SLANG_TEST_TOOL_API SlangResult innerMain(
+    StdWriters* stdWriters,
+    slang::IGlobalSession* sharedSession,
+    int argc,
+    const char* const* argv)
+{
+    return _innerMain(stdWriters, sharedSession, argc, argv, false);
+}
+
+// Compile the command line of an `ExecuteToolTestArgs` call, and send back what it wrote.
+static SlangResult _executeServerCompile(
+    JSONRPCConnection* connection,
+    slang::IGlobalSession* session,
+    const char* exePath,
+    const JSONRPCCall& call)
+{
+    auto id = connection->getPersistentValue(call.id);
+
+    TestServerProtocol::ExecuteToolTestArgs args;
+    SLANG_RETURN_ON_FAIL(connection->toNativeArgsOrSendError(call.params, &args, id));
+    if (args.toolName != "slangc")
+    {
+        return connection->sendError(JSONRPC::ErrorCode::InvalidParams, id);
+    }
+
+    // The search path and prelude are found relative to the first argument.
+    List<const char*> toolArgs;
+    toolArgs.add(exePath);
+    for (const auto& arg : args.args)
+    {
+        toolArgs.add(arg.getBuffer());
+    }
+
+    StringBuilder stdOut;
+    StringBuilder stdError;
+    RefPtr<StringWriter> stdOutWriter(new StringWriter(&stdOut, WriterFlag::IsConsole));
+    RefPtr<StringWriter> stdErrorWriter(new StringWriter(&stdError, WriterFlag::IsConsole));
+
+    StdWriters stdWriters;
+    stdWriters.setWriter(SLANG_WRITER_CHANNEL_STD_ERROR, stdErrorWriter);
+    stdWriters.setWriter(SLANG_WRITER_CHANNEL_STD_OUTPUT, stdOutWriter);
+    stdWriters.setWriter(SLANG_WRITER_CHANNEL_DIAGNOSTIC, stdErrorWriter);
+
+    auto defaultStdWriters = StdWriters::getSingleton();
+    TestServerProtocol::ExecutionResult result;
+    result.result =
+        _innerMain(&stdWriters, session, int(toolArgs.getCount()), toolArgs.getBuffer(), true);
+    StdWriters::setSingleton(defaultStdWriters);
+
+    result.stdError = stdError;
+    result.stdOut = stdOut;
+    result.returnCode = int32_t(TestToolUtil::getReturnCode(result.result));
+    return connection->sendResult(&result, id);
+}
+
+// Compile the command lines a client sends over JSON-RPC on stdin and stdout, with the
+// `test-server` protocol, until the client quits or closes the connection. All of the compiles
+// share one global session, so the core module is only loaded once.
+static SlangResult _executeServer(const char* exePath)
+{
+    ComPtr<slang::IGlobalSession> session;
+    SLANG_RETURN_ON_FAIL(slang_createGlobalSession(SLANG_API_VERSION, session.writeRef()));
+
+    RefPtr<JSONRPCConnection> connection = new JSONRPCConnection;
+    SLANG_RETURN_ON_FAIL(connection->initWithStdStreams());
+
+    while (connection->isActive())
+    {
+        // Block waiting for a call, or for the connection to close
+        if (SLANG_FAILED(connection->waitForResult()) || !connection->hasMessage())
+            continue;
+
+        if (connection->getMessageType() != JSONRPCMessageType::Call)
+        {
+            connection->sendError(
+                JSONRPC::ErrorCode::InvalidRequest,
+                connection->getCurrentMessageId());
+            continue;
+        }
+
+        JSONRPCCall call;
+        if (SLANG_FAILED(connection->getRPCOrSendError(&call)))
+            continue;
+
+        if (call.method == TestServerProtocol::QuitArgs::g_methodName)
+        {
+            break;
+        }
+        else if (call.method == TestServerProtocol::ExecuteToolTestArgs::g_methodName)
+        {
+            // A failed compile is reported to the client, and doesn't stop the server
+            _executeServerCompile(connection, session, exePath, call);
+        }
+        else
+        {
+            connection->sendError(JSONRPC::ErrorCode::MethodNotFound, call.id);
+        }
+    }
+    return SLANG_OK;
+}
+
 int MAIN(int argc, char** argv)
 {
     auto stdWriters = StdWriters::initDefaultSingleton();
-    SlangResult res = innerMain(stdWriters, nullptr, argc, argv);
+    SlangResult res = SLANG_OK;
+    if (argc == 2 && UnownedStringSlice(argv[1]) == "-server")
+        res = _executeServer(argv[0]);
+    else
+        res = innerMain(stdWriters, nullptr, argc, argv);
     slang::shutdown();
     return (int)TestToolUtil::getReturnCode(res);
 }
@@ -0,0 +1,14 @@
+// include-guard-a.h
+
+// Used by the `include-guard.slang` test
+
+#ifndef INCLUDE_GUARD_A
+#define INCLUDE_GUARD_A
+
+#ifdef INCLUDE_GUARD_A_READ
+#define INCLUDE_GUARD_A_READ_AGAIN
+#else
+#define INCLUDE_GUARD_A_READ
+#endif
+
+#endif
@@ -0,0 +1,13 @@
+// include-guard-b.h
+
+// Used by the `include-guard.slang` test
+
+#ifndef INCLUDE_GUARD_B
+#define INCLUDE_GUARD_B
+#endif
+
+#ifdef INCLUDE_GUARD_B_READ
+#define INCLUDE_GUARD_B_READ_AGAIN
+#else
+#define INCLUDE_GUARD_B_READ
+#endif
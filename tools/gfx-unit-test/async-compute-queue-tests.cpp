@@ -0,0 +1,117 @@
+#include "core/slang-basic.h"
+#include "gfx-test-util.h"
+#include "gfx-util/shader-cursor.h"
+#include "slang-gfx.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace gfx;
+
+namespace gfx_test
+{
+// Increment the numbers of a buffer on a compute queue, then again on the graphics queue once
+// a fence signaled by the compute queue says the first dispatch is done.
+void asyncComputeQueueTestImpl(IDevice* device, UnitTestContext* context)
+{
+    ComPtr<IShaderProgram> shaderProgram;
+    slang::ProgramLayout* slangReflection;
+    GFX_CHECK_CALL_ABORT(loadComputeProgram(
+        device,
+        shaderProgram,
+        "compute-trivial",
+        "computeMain",
+        slangReflection));
+
+    ComputePipelineStateDesc pipelineDesc = {};
+    pipelineDesc.program = shaderProgram.get();
+    ComPtr<gfx::IPipelineState> pipelineState;
+    GFX_CHECK_CALL_ABORT(
+        device->createComputePipelineState(pipelineDesc, pipelineState.writeRef()));
+
+    const int numberCount = 4;
+    float initialData[] = {0.0f, 1.0f, 2.0f, 3.0f};
+    IBufferResource::Desc bufferDesc = {};
+    bufferDesc.sizeInBytes = numberCount * sizeof(float);
+    bufferDesc.format = gfx::Format::Unknown;
+    bufferDesc.elementSize = sizeof(float);
+    bufferDesc.allowedStates = ResourceStateSet(
+        ResourceState::ShaderResource,
+        ResourceState::UnorderedAccess,
+        ResourceState::CopyDestination,
+        ResourceState::CopySource);
+    bufferDesc.defaultState = ResourceState::UnorderedAccess;
+    bufferDesc.memoryType = MemoryType::DeviceLocal;
+
+    ComPtr<IBufferResource> numbersBuffer;
+    GFX_CHECK_CALL_ABORT(
+        device->createBufferResource(bufferDesc, (void*)initialData, numbersBuffer.writeRef()));
+
+    ComPtr<IResourceView> bufferView;
+    IResourceView::Desc viewDesc = {};
+    viewDesc.type = IResourceView::Type::UnorderedAccess;
+    viewDesc.format = Format::Unknown;
+    GFX_CHECK_CALL_ABORT(
+        device->createBufferView(numbersBuffer, nullptr, viewDesc, bufferView.writeRef()));
+
+    IFence::Desc fenceDesc = {};
+    ComPtr<IFence> fence;
+    GFX_CHECK_CALL_ABORT(device->createFence(fenceDesc, fence.writeRef()));
+
+    ICommandQueue::QueueType queueTypes[] = {
+        ICommandQueue::QueueType::Compute,
+        ICommandQueue::QueueType::Graphics};
+    ComPtr<ICommandQueue> queues[2];
+    ComPtr<ITransientResourceHeap> transientHeaps[2];
+    for (int i = 0; i < 2; i++)
+    {
+        ICommandQueue::Desc queueDesc = {queueTypes[i]};
+        GFX_CHECK_CALL_ABORT(device->createCommandQueue(queueDesc, queues[i].writeRef()));
+
+        ITransientResourceHeap::Desc transientHeapDesc = {};
+        transientHeapDesc.constantBufferSize = 4096;
+        transientHeapDesc.queueType = queueTypes[i];
+        GFX_CHECK_CALL_ABORT(
+            device->createTransientResourceHeap(transientHeapDesc, transientHeaps[i].writeRef()));
+    }
+
+    for (int i = 0; i < 2; i++)
+    {
+        auto commandBuffer = transientHeaps[i]->createCommandBuffer();
+        auto encoder = commandBuffer->encodeComputeCommands();
+        auto rootObject = encoder->bindPipeline(pipelineState);
+        ShaderCursor(rootObject).getPath("buffer").setResource(bufferView);
+        encoder->dispatchCompute(1, 1, 1);
+        encoder->endEncoding();
+        commandBuffer->close();
+
+        if (i == 0)
+        {
+            queues[i]->executeCommandBuffers(1, commandBuffer.readRef(), fence, 1);
+        }
+        else
+        {
+            IFence* fences[] = {fence.get()};
+            uint64_t waitValues[] = {1};
+            GFX_CHECK_CALL_ABORT(queues[i]->waitForFenceValuesOnDevice(1, fences, waitValues));
+            queues[i]->executeCommandBuffer(commandBuffer);
+        }
+    }
+    queues[1]->waitOnHost();
+
+    uint64_t fenceValue = 0;
+    GFX_CHECK_CALL_ABORT(fence->getCurrentValue(&fenceValue));
+    SLANG_CHECK(fenceValue == 1);
+
+    compareComputeResult(device, numbersBuffer, Slang::makeArray<float>(2.0f, 3.0f, 4.0f, 5.0f));
+}
+
+SLANG_UNIT_TEST(asyncComputeQueueD3D12)
+{
+    runTestImpl(asyncComputeQueueTestImpl, unitTestContext, Slang::RenderApiFlag::D3D12);
+}
+
+SLANG_UNIT_TEST(asyncComputeQueueVulkan)
+{
+    runTestImpl(asyncComputeQueueTestImpl, unitTestContext, Slang::RenderApiFlag::Vulkan);
+}
+
+} // namespace gfx_test
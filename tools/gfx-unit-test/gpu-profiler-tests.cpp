@@ -0,0 +1,132 @@
+#include "core/slang-basic.h"
+#include "gfx-test-util.h"
+#include "gfx-util/gpu-profiler.h"
+#include "gfx-util/shader-cursor.h"
+#include "slang-gfx.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace gfx;
+
+namespace gfx_test
+{
+void gpuProfilerTestImpl(IDevice* device, UnitTestContext* context)
+{
+    GpuProfiler profiler;
+    GpuProfiler::Desc profilerDesc = {};
+    profilerDesc.frameCount = 2;
+    profilerDesc.maxScopesPerFrame = 4;
+    auto initResult = profiler.init(device, profilerDesc);
+    if (initResult == SLANG_E_NOT_AVAILABLE)
+        SLANG_IGNORE_TEST;
+    GFX_CHECK_CALL_ABORT(initResult);
+
+    Slang::ComPtr<ITransientResourceHeap> transientHeap;
+    ITransientResourceHeap::Desc transientHeapDesc = {};
+    transientHeapDesc.constantBufferSize = 4096;
+    GFX_CHECK_CALL_ABORT(
+        device->createTransientResourceHeap(transientHeapDesc, transientHeap.writeRef()));
+
+    ComPtr<IShaderProgram> shaderProgram;
+    slang::ProgramLayout* slangReflection;
+    GFX_CHECK_CALL_ABORT(loadComputeProgram(
+        device,
+        shaderProgram,
+        "compute-trivial",
+        "computeMain",
+        slangReflection));
+
+    ComputePipelineStateDesc pipelineDesc = {};
+    pipelineDesc.program = shaderProgram.get();
+    ComPtr<gfx::IPipelineState> pipelineState;
+    GFX_CHECK_CALL_ABORT(
+        device->createComputePipelineState(pipelineDesc, pipelineState.writeRef()));
+
+    float initialData[] = {0.0f, 1.0f, 2.0f, 3.0f};
+    IBufferResource::Desc bufferDesc = {};
+    bufferDesc.sizeInBytes = sizeof(initialData);
+    bufferDesc.format = gfx::Format::Unknown;
+    bufferDesc.elementSize = sizeof(float);
+    bufferDesc.allowedStates = ResourceStateSet(
+        ResourceState::ShaderResource,
+        ResourceState::UnorderedAccess,
+        ResourceState::CopyDestination,
+        ResourceState::CopySource);
+    bufferDesc.defaultState = ResourceState::UnorderedAccess;
+    bufferDesc.memoryType = MemoryType::DeviceLocal;
+
+    ComPtr<IBufferResource> numbersBuffer;
+    GFX_CHECK_CALL_ABORT(
+        device->createBufferResource(bufferDesc, (void*)initialData, numbersBuffer.writeRef()));
+
+    ComPtr<IResourceView> bufferView;
+    IResourceView::Desc viewDesc = {};
+    viewDesc.type = IResourceView::Type::UnorderedAccess;
+    viewDesc.format = Format::Unknown;
+    GFX_CHECK_CALL_ABORT(
+        device->createBufferView(numbersBuffer, nullptr, viewDesc, bufferView.writeRef()));
+
+    {
+        ICommandQueue::Desc queueDesc = {ICommandQueue::QueueType::Graphics};
+        auto queue = device->createCommandQueue(queueDesc);
+
+        GFX_CHECK_CALL_ABORT(profiler.beginFrame());
+        auto commandBuffer = transientHeap->createCommandBuffer();
+        auto encoder = commandBuffer->encodeComputeCommands();
+        profiler.beginScope(encoder, "frame");
+        for (int i = 0; i < 2; i++)
+        {
+            profiler.beginScope(encoder, "dispatch");
+            auto rootObject = encoder->bindPipeline(pipelineState);
+            ShaderCursor(rootObject).getPath("buffer").setResource(bufferView);
+            encoder->dispatchCompute(1, 1, 1);
+            profiler.endScope(encoder);
+        }
+        profiler.endScope(encoder);
+        encoder->endEncoding();
+        commandBuffer->close();
+        queue->executeCommandBuffer(commandBuffer);
+        queue->waitOnHost();
+    }
+
+    // Nothing is read back until the frame's pool is reused, or all frames are resolved.
+    SLANG_CHECK(profiler.getResultCount() == 0);
+    GFX_CHECK_CALL_ABORT(profiler.resolveAllFrames());
+    SLANG_CHECK_ABORT(profiler.getResultCount() == 3);
+
+    auto frameScope = profiler.getResult(0);
+    SLANG_CHECK(strcmp(frameScope.name, "frame") == 0);
+    SLANG_CHECK(frameScope.depth == 0);
+    SLANG_CHECK(frameScope.startTimeMS == 0.0);
+    for (GfxIndex i = 1; i < 3; i++)
+    {
+        auto dispatchScope = profiler.getResult(i);
+        SLANG_CHECK(strcmp(dispatchScope.name, "dispatch") == 0);
+        SLANG_CHECK(dispatchScope.depth == 1);
+        SLANG_CHECK(dispatchScope.startTimeMS >= frameScope.startTimeMS);
+        SLANG_CHECK(
+            dispatchScope.startTimeMS + dispatchScope.durationMS <=
+            frameScope.startTimeMS + frameScope.durationMS);
+    }
+
+    ComPtr<ISlangBlob> traceJSON;
+    GFX_CHECK_CALL_ABORT(profiler.getTraceJSON(traceJSON.writeRef()));
+    Slang::UnownedStringSlice trace(
+        (const char*)traceJSON->getBufferPointer(),
+        traceJSON->getBufferSize());
+    SLANG_CHECK(trace.startsWith("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+    SLANG_CHECK(trace.indexOf(Slang::UnownedStringSlice("\"name\":\"dispatch\"")) >= 0);
+
+    compareComputeResult(device, numbersBuffer, Slang::makeArray<float>(2.0f, 3.0f, 4.0f, 5.0f));
+}
+
+SLANG_UNIT_TEST(gpuProfilerD3D12)
+{
+    runTestImpl(gpuProfilerTestImpl, unitTestContext, Slang::RenderApiFlag::D3D12);
+}
+
+SLANG_UNIT_TEST(gpuProfilerVulkan)
+{
+    runTestImpl(gpuProfilerTestImpl, unitTestContext, Slang::RenderApiFlag::Vulkan);
+}
+
+} // namespace gfx_test
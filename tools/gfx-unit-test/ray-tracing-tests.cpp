@@ -477,6 +477,23 @@ struct RayTracingTestB : BaseRayTracingTest
     }
 };
 
+// Render with rayGenShaderA once, and again after its hit group record is switched to hitgroupB,
+// which must update the shader table buffer created by the first dispatch.
+struct RayTracingTestC : RayTracingTestA
+{
+    void run()
+    {
+        createRequiredResources();
+        renderFrame();
+
+        GFX_CHECK_CALL_ABORT(shaderTable->setHitGroup(0, "hitgroupB", nullptr));
+        renderFrame();
+
+        float expectedResult[16] = {1, 1, 1, 1, 1, 1, 0, 1, 1, 0, 1, 1, 0, 1, 1, 1};
+        checkTestResults(expectedResult, 16);
+    }
+};
+
 template<typename T>
 void rayTracingTestImpl(IDevice* device, UnitTestContext* context)
 {
@@ -504,4 +521,14 @@ SLANG_UNIT_TEST(RayTracingTestBVulkan)
 {
     runTestImpl(rayTracingTestImpl<RayTracingTestB>, unitTestContext, Slang::RenderApiFlag::Vulkan);
 }
+
+SLANG_UNIT_TEST(RayTracingTestCD3D12)
+{
+    runTestImpl(rayTracingTestImpl<RayTracingTestC>, unitTestContext, Slang::RenderApiFlag::D3D12);
+}
+
+SLANG_UNIT_TEST(RayTracingTestCVulkan)
+{
+    runTestImpl(rayTracingTestImpl<RayTracingTestC>, unitTestContext, Slang::RenderApiFlag::Vulkan);
+}
 } // namespace gfx_test
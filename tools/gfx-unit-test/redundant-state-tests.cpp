@@ -0,0 +1,103 @@
+#include "core/slang-basic.h"
+#include "gfx-test-util.h"
+#include "gfx-util/shader-cursor.h"
+#include "slang-gfx.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace gfx;
+
+namespace gfx_test
+{
+// Dispatch twice with the same pipeline and bindings, and check that the second dispatch doesn't
+// bind the pipeline and the root signature or descriptor sets again.
+void redundantStateTestImpl(IDevice* device, UnitTestContext* context)
+{
+    Slang::ComPtr<ITransientResourceHeap> transientHeap;
+    ITransientResourceHeap::Desc transientHeapDesc = {};
+    transientHeapDesc.constantBufferSize = 4096;
+    GFX_CHECK_CALL_ABORT(
+        device->createTransientResourceHeap(transientHeapDesc, transientHeap.writeRef()));
+
+    ComPtr<IShaderProgram> shaderProgram;
+    slang::ProgramLayout* slangReflection;
+    GFX_CHECK_CALL_ABORT(loadComputeProgram(
+        device,
+        shaderProgram,
+        "compute-trivial",
+        "computeMain",
+        slangReflection));
+
+    ComputePipelineStateDesc pipelineDesc = {};
+    pipelineDesc.program = shaderProgram.get();
+    ComPtr<gfx::IPipelineState> pipelineState;
+    GFX_CHECK_CALL_ABORT(
+        device->createComputePipelineState(pipelineDesc, pipelineState.writeRef()));
+
+    const int numberCount = 4;
+    float initialData[] = {0.0f, 1.0f, 2.0f, 3.0f};
+    IBufferResource::Desc bufferDesc = {};
+    bufferDesc.sizeInBytes = numberCount * sizeof(float);
+    bufferDesc.format = gfx::Format::Unknown;
+    bufferDesc.elementSize = sizeof(float);
+    bufferDesc.allowedStates = ResourceStateSet(
+        ResourceState::ShaderResource,
+        ResourceState::UnorderedAccess,
+        ResourceState::CopyDestination,
+        ResourceState::CopySource);
+    bufferDesc.defaultState = ResourceState::UnorderedAccess;
+    bufferDesc.memoryType = MemoryType::DeviceLocal;
+
+    ComPtr<IBufferResource> numbersBuffer;
+    GFX_CHECK_CALL_ABORT(
+        device->createBufferResource(bufferDesc, (void*)initialData, numbersBuffer.writeRef()));
+
+    ComPtr<IResourceView> bufferView;
+    IResourceView::Desc viewDesc = {};
+    viewDesc.type = IResourceView::Type::UnorderedAccess;
+    viewDesc.format = Format::Unknown;
+    GFX_CHECK_CALL_ABORT(
+        device->createBufferView(numbersBuffer, nullptr, viewDesc, bufferView.writeRef()));
+
+    GFX_CHECK_CALL_ABORT(device->resetRedundantStateStats());
+    {
+        ICommandQueue::Desc queueDesc = {ICommandQueue::QueueType::Graphics};
+        auto queue = device->createCommandQueue(queueDesc);
+
+        auto commandBuffer = transientHeap->createCommandBuffer();
+        auto encoder = commandBuffer->encodeComputeCommands();
+
+        auto rootObject = encoder->bindPipeline(pipelineState);
+        ShaderCursor(rootObject).getPath("buffer").setResource(bufferView);
+
+        encoder->dispatchCompute(1, 1, 1);
+        encoder->bufferBarrier(
+            1,
+            numbersBuffer.readRef(),
+            ResourceState::UnorderedAccess,
+            ResourceState::UnorderedAccess);
+        encoder->dispatchCompute(1, 1, 1);
+        encoder->endEncoding();
+        commandBuffer->close();
+        queue->executeCommandBuffer(commandBuffer);
+        queue->waitOnHost();
+    }
+
+    RedundantStateStats stats;
+    GFX_CHECK_CALL_ABORT(device->getRedundantStateStats(&stats));
+    SLANG_CHECK(stats.pipelineBindCount == 1);
+    SLANG_CHECK(stats.descriptorBindCount >= 1);
+
+    compareComputeResult(device, numbersBuffer, Slang::makeArray<float>(2.0f, 3.0f, 4.0f, 5.0f));
+}
+
+SLANG_UNIT_TEST(redundantStateD3D12)
+{
+    runTestImpl(redundantStateTestImpl, unitTestContext, Slang::RenderApiFlag::D3D12);
+}
+
+SLANG_UNIT_TEST(redundantStateVulkan)
+{
+    runTestImpl(redundantStateTestImpl, unitTestContext, Slang::RenderApiFlag::Vulkan);
+}
+
+} // namespace gfx_test
@@ -663,6 +663,62 @@ struct ShaderCacheTestSpecialization : ShaderCacheTest
     }
 };
 
+// Test that the specializations recorded by `prewarmPipelineSpecializations` are created
+// from the shader cache in the next session, before the dispatches that use them.
+struct ShaderCacheTestPrewarm : ShaderCacheTestSpecialization
+{
+    bool dispatchAndCheck(const char* transformerTypeName, const List<float>& expectedOutput)
+    {
+        createComputeResources();
+        dispatchComputePipeline(transformerTypeName);
+        bool hasExpectedOutput = checkOutput(expectedOutput);
+        SLANG_CHECK(hasExpectedOutput);
+        bufferResource = nullptr;
+        bufferView = nullptr;
+        return hasExpectedOutput;
+    }
+
+    void runTests()
+    {
+        // Nothing is recorded yet, and the specializations are recorded as they are created.
+        runStep(
+            [this]()
+            {
+                createComputePipeline();
+                GFX_CHECK_CALL_ABORT(
+                    shaderCache->prewarmPipelineSpecializations(pipelineState, "transformers"));
+                SLANG_CHECK(getStats().missCount == 1);
+
+                SLANG_CHECK(dispatchAndCheck("AddTransformer", {5.f, 6.f, 7.f, 8.f}));
+                SLANG_CHECK(dispatchAndCheck("MulTransformer", {0.f, 5.f, 10.f, 15.f}));
+                pipelineState = nullptr;
+
+                SLANG_CHECK(getStats().missCount == 3);
+                SLANG_CHECK(getStats().entryCount == 3);
+            });
+
+        // The recorded specializations are created by the prewarm, so the dispatches don't
+        // look up the shader cache.
+        runStep(
+            [this]()
+            {
+                createComputePipeline();
+                GFX_CHECK_CALL_ABORT(
+                    shaderCache->prewarmPipelineSpecializations(pipelineState, "transformers"));
+                SLANG_CHECK(getStats().missCount == 0);
+                SLANG_CHECK(getStats().hitCount == 3);
+
+                SLANG_CHECK(dispatchAndCheck("AddTransformer", {5.f, 6.f, 7.f, 8.f}));
+                SLANG_CHECK(dispatchAndCheck("MulTransformer", {0.f, 5.f, 10.f, 15.f}));
+                pipelineState = nullptr;
+
+                SLANG_CHECK(getStats().missCount == 0);
+                SLANG_CHECK(getStats().hitCount == 3);
+                SLANG_CHECK(getStats().entryCount == 3);
+            });
+    }
+};
+
 struct ShaderCacheTestEviction : ShaderCacheTest
 {
     void runTests()
@@ -1098,6 +1154,16 @@ SLANG_UNIT_TEST(shaderCacheSpecializationVulkan)
     runTest<ShaderCacheTestSpecialization>(unitTestContext, Slang::RenderApiFlag::Vulkan);
 }
 
+SLANG_UNIT_TEST(shaderCachePrewarmD3D12)
+{
+    runTest<ShaderCacheTestPrewarm>(unitTestContext, Slang::RenderApiFlag::D3D12);
+}
+
+SLANG_UNIT_TEST(shaderCachePrewarmVulkan)
+{
+    runTest<ShaderCacheTestPrewarm>(unitTestContext, Slang::RenderApiFlag::Vulkan);
+}
+
 SLANG_UNIT_TEST(shaderCacheEvictionD3D12)
 {
     runTest<ShaderCacheTestEviction>(unitTestContext, Slang::RenderApiFlag::D3D12);
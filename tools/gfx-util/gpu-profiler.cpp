@@ -0,0 +1,226 @@
+#include "gpu-profiler.h"
+
+#include "core/slang-basic.h"
+#include "core/slang-blob.h"
+#include "core/slang-string-escape-util.h"
+
+namespace gfx
+{
+
+using namespace Slang;
+
+struct GpuProfiler::Impl
+{
+    struct Scope
+    {
+        String name;
+        int depth;
+        GfxIndex beginQueryIndex;
+        GfxIndex endQueryIndex;
+    };
+
+    struct Frame
+    {
+        ComPtr<IQueryPool> queryPool;
+        List<Scope> scopes;
+        GfxCount queryCount = 0;
+    };
+
+    struct ResolvedScope
+    {
+        String name;
+        int depth;
+        uint64_t beginTicks;
+        uint64_t endTicks;
+    };
+
+    Desc desc;
+    double ticksPerMS = 0;
+    List<Frame> frames;
+    Index currentFrameIndex = -1;
+    // The scopes that are open, as indices into the scopes of the current frame. Scopes that
+    // couldn't be measured are -1.
+    List<Index> openScopes;
+
+    List<ResolvedScope> results;
+    uint64_t originTicks = 0;
+    List<uint64_t> timestamps;
+
+    Frame* getCurrentFrame()
+    {
+        return currentFrameIndex < 0 ? nullptr : &frames[currentFrameIndex];
+    }
+
+    Result resolveFrame(Frame& frame)
+    {
+        if (frame.scopes.getCount() == 0)
+            return SLANG_OK;
+
+        timestamps.setCount(frame.queryCount);
+        SLANG_RETURN_ON_FAIL(
+            frame.queryPool->getResult(0, frame.queryCount, timestamps.getBuffer()));
+        for (auto& scope : frame.scopes)
+        {
+            // Scopes that were still open at the end of the frame have no end timestamp.
+            if (scope.endQueryIndex < 0)
+                continue;
+            ResolvedScope result;
+            result.name = scope.name;
+            result.depth = scope.depth;
+            result.beginTicks = timestamps[scope.beginQueryIndex];
+            result.endTicks = timestamps[scope.endQueryIndex];
+            if (results.getCount() == 0 || result.beginTicks < originTicks)
+                originTicks = result.beginTicks;
+            results.add(result);
+        }
+        frame.scopes.clear();
+        frame.queryCount = 0;
+        return SLANG_OK;
+    }
+
+    ScopeResult getResult(const ResolvedScope& scope)
+    {
+        ScopeResult result;
+        result.name = scope.name.getBuffer();
+        result.depth = scope.depth;
+        result.startTimeMS = double(scope.beginTicks - originTicks) / ticksPerMS;
+        result.durationMS = scope.endTicks > scope.beginTicks
+                                ? double(scope.endTicks - scope.beginTicks) / ticksPerMS
+                                : 0.0;
+        return result;
+    }
+};
+
+GpuProfiler::GpuProfiler()
+    : m_impl(new Impl())
+{
+}
+
+GpuProfiler::~GpuProfiler()
+{
+    delete m_impl;
+}
+
+Result GpuProfiler::init(IDevice* device, const Desc& desc)
+{
+    auto timestampFrequency = device->getDeviceInfo().timestampFrequency;
+    if (timestampFrequency == 0)
+        return SLANG_E_NOT_AVAILABLE;
+    if (desc.frameCount <= 0 || desc.maxScopesPerFrame <= 0)
+        return SLANG_E_INVALID_ARG;
+
+    m_impl->desc = desc;
+    m_impl->ticksPerMS = double(timestampFrequency) / 1000.0;
+    m_impl->frames.setCount(desc.frameCount);
+    for (auto& frame : m_impl->frames)
+    {
+        IQueryPool::Desc queryPoolDesc = {};
+        queryPoolDesc.type = QueryType::Timestamp;
+        queryPoolDesc.count = desc.maxScopesPerFrame * 2;
+        SLANG_RETURN_ON_FAIL(device->createQueryPool(queryPoolDesc, frame.queryPool.writeRef()));
+    }
+    return SLANG_OK;
+}
+
+Result GpuProfiler::beginFrame()
+{
+    SLANG_ASSERT(m_impl->openScopes.getCount() == 0);
+    m_impl->openScopes.clear();
+
+    auto& frames = m_impl->frames;
+    m_impl->currentFrameIndex = (m_impl->currentFrameIndex + 1) % frames.getCount();
+    return m_impl->resolveFrame(frames[m_impl->currentFrameIndex]);
+}
+
+void GpuProfiler::beginScope(ICommandEncoder* encoder, const char* name)
+{
+    auto frame = m_impl->getCurrentFrame();
+    if (!frame || frame->scopes.getCount() == m_impl->desc.maxScopesPerFrame)
+    {
+        m_impl->openScopes.add(-1);
+        return;
+    }
+
+    Impl::Scope scope;
+    scope.name = name;
+    scope.depth = (int)m_impl->openScopes.getCount();
+    scope.beginQueryIndex = frame->queryCount++;
+    scope.endQueryIndex = -1;
+    encoder->writeTimestamp(frame->queryPool, scope.beginQueryIndex);
+    m_impl->openScopes.add(frame->scopes.getCount());
+    frame->scopes.add(scope);
+}
+
+void GpuProfiler::endScope(ICommandEncoder* encoder)
+{
+    auto& openScopes = m_impl->openScopes;
+    SLANG_ASSERT(openScopes.getCount() != 0);
+    if (openScopes.getCount() == 0)
+        return;
+    auto scopeIndex = openScopes.getLast();
+    openScopes.removeLast();
+    if (scopeIndex < 0)
+        return;
+
+    auto frame = m_impl->getCurrentFrame();
+    auto& scope = frame->scopes[scopeIndex];
+    scope.endQueryIndex = frame->queryCount++;
+    encoder->writeTimestamp(frame->queryPool, scope.endQueryIndex);
+}
+
+Result GpuProfiler::resolveAllFrames()
+{
+    // Resolve the frames from the oldest to the newest, so that the results stay in order.
+    auto& frames = m_impl->frames;
+    for (Index i = 1; i <= frames.getCount(); i++)
+    {
+        auto frameIndex = (m_impl->currentFrameIndex + i) % frames.getCount();
+        SLANG_RETURN_ON_FAIL(m_impl->resolveFrame(frames[frameIndex]));
+    }
+    return SLANG_OK;
+}
+
+GfxCount GpuProfiler::getResultCount()
+{
+    return (GfxCount)m_impl->results.getCount();
+}
+
+GpuProfiler::ScopeResult GpuProfiler::getResult(GfxIndex index)
+{
+    return m_impl->getResult(m_impl->results[index]);
+}
+
+void GpuProfiler::clearResults()
+{
+    m_impl->results.clear();
+}
+
+Result GpuProfiler::getTraceJSON(ISlangBlob** outTraceJSON)
+{
+    auto handler = StringEscapeUtil::getHandler(StringEscapeUtil::Style::JSON);
+
+    // The GPU events are given a process of their own, since their timeline starts at the
+    // first measured scope rather than at the epoch of the CPU trace.
+    StringBuilder out;
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    for (Index i = 0; i < m_impl->results.getCount(); ++i)
+    {
+        auto result = m_impl->getResult(m_impl->results[i]);
+        if (i)
+            out << ",";
+        out << "\n{\"name\":";
+        StringEscapeUtil::appendQuoted(handler, UnownedStringSlice(result.name), out);
+
+        // Chrome trace timestamps are in microseconds.
+        out << ",\"cat\":\"gpu\",\"ph\":\"X\",\"pid\":2,\"tid\":0"
+            << ",\"ts\":" << String(result.startTimeMS * 1000.0, "%.3f")
+            << ",\"dur\":" << String(result.durationMS * 1000.0, "%.3f")
+            << ",\"args\":{\"depth\":" << result.depth << "}}";
+    }
+    out << "\n]}\n";
+
+    *outTraceJSON = StringBlob::moveCreate(out).detach();
+    return SLANG_OK;
+}
+
+} // namespace gfx
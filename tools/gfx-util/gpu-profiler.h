@@ -0,0 +1,83 @@
+#pragma once
+
+#include "slang-gfx.h"
+
+namespace gfx
+{
+
+/// Measures how long the GPU spends on scopes of commands recorded into command encoders.
+///
+/// A scope writes a timestamp query when it begins and another when it ends. The queries of
+/// each frame come from a pool of their own, so that the results of a frame can be read back
+/// when its pool is reused `Desc::frameCount` frames later, by which time the GPU has long
+/// finished with it, instead of stalling the frame that is being recorded.
+///
+/// A typical frame looks like:
+///
+///     transientHeap->synchronizeAndReset();
+///     profiler.beginFrame();
+///     auto encoder = commandBuffer->encodeComputeCommands();
+///     profiler.beginScope(encoder, "lighting");
+///     ...
+///     profiler.endScope(encoder);
+///
+/// Scopes can be nested, and can span encoders of the same queue, but must begin and end in
+/// the same frame.
+///
+class GpuProfiler
+{
+public:
+    struct Desc
+    {
+        /// The number of frames that can be in flight on the GPU at once.
+        GfxCount frameCount = 3;
+        /// The number of scopes that can be measured in a frame. Scopes past the limit are
+        /// not measured.
+        GfxCount maxScopesPerFrame = 256;
+    };
+
+    struct ScopeResult
+    {
+        const char* name;
+        /// The number of scopes that were open when the scope began.
+        int depth;
+        /// The time the scope began, relative to the first scope measured by the profiler.
+        double startTimeMS;
+        double durationMS;
+    };
+
+    GpuProfiler();
+    ~GpuProfiler();
+
+    /// Creates the query pools of the profiler. Fails with `SLANG_E_NOT_AVAILABLE` when the
+    /// device doesn't support timestamp queries.
+    Result init(IDevice* device, const Desc& desc);
+
+    /// Starts a new frame, reading back the timestamps of the frame that last used its pool.
+    ///
+    /// The GPU must have finished the commands recorded for that frame, which is the case once
+    /// the transient heap used for it has been synchronized.
+    Result beginFrame();
+
+    void beginScope(ICommandEncoder* encoder, const char* name);
+    void endScope(ICommandEncoder* encoder);
+
+    /// Reads back the timestamps of every frame that hasn't been read back yet. The GPU must
+    /// have finished all the commands recorded with the profiler.
+    Result resolveAllFrames();
+
+    /// Get the scopes whose timestamps have been read back, in the order they began in.
+    GfxCount getResultCount();
+    ScopeResult getResult(GfxIndex index);
+    void clearResults();
+
+    /// Write the results in the Chrome trace event JSON format that the compiler's
+    /// `PerformanceProfiler` also writes, so that both can be loaded into the same tool.
+    Result getTraceJSON(ISlangBlob** outTraceJSON);
+
+private:
+    struct Impl;
+    Impl* m_impl;
+};
+
+} // namespace gfx
@@ -9,6 +9,7 @@
 #include "cpu-shader-program.h"
 #include "cpu-texture.h"
 
+#include <atomic>
 #include <chrono>
 
 namespace gfx
@@ -17,8 +18,51 @@ using namespace Slang;
 
 namespace cpu
 {
+struct DeviceImpl::DispatchJob
+{
+    slang_prelude::ComputeFunc func = nullptr;
+    void* entryPointParamsData = nullptr;
+    void* globalParamsData = nullptr;
+    uint32_t groupCountX = 0;
+    uint32_t groupCountY = 0;
+    uint32_t rangesPerRow = 0;
+    uint32_t rangeCount = 0;
+    std::atomic<uint32_t> nextRangeIndex{0};
+
+    // Run ranges of thread groups until none are left.
+    void run()
+    {
+        for (;;)
+        {
+            const uint32_t rangeIndex = nextRangeIndex++;
+            if (rangeIndex >= rangeCount)
+                break;
+
+            const uint32_t row = rangeIndex / rangesPerRow;
+            const uint32_t rangeInRow = rangeIndex % rangesPerRow;
+
+            slang_prelude::ComputeVaryingInput varyingInput;
+            varyingInput.startGroupID.x = groupCountX * rangeInRow / rangesPerRow;
+            varyingInput.startGroupID.y = row % groupCountY;
+            varyingInput.startGroupID.z = row / groupCountY;
+            varyingInput.endGroupID.x = groupCountX * (rangeInRow + 1) / rangesPerRow;
+            varyingInput.endGroupID.y = varyingInput.startGroupID.y + 1;
+            varyingInput.endGroupID.z = varyingInput.startGroupID.z + 1;
+            func(&varyingInput, entryPointParamsData, globalParamsData);
+        }
+    }
+};
+
 DeviceImpl::~DeviceImpl()
 {
+    {
+        std::lock_guard<std::mutex> lock(m_dispatchMutex);
+        m_isStoppingDispatchWorkers = true;
+    }
+    m_dispatchStartCondition.notify_all();
+    for (auto& worker : m_dispatchWorkers)
+        worker.join();
+
     m_currentPipeline = nullptr;
     m_currentRootObject = nullptr;
 }
@@ -35,6 +79,29 @@ SLANG_NO_THROW Result SLANG_MCALL DeviceImpl::initialize(const Desc& desc)
 
     SLANG_RETURN_ON_FAIL(RendererBase::initialize(desc));
 
+    // Dispatches run on the calling thread only, unless a pool is requested, since kernels
+    // written for a single thread may not be safe to run on several.
+    //
+    uint32_t threadPoolSize = 0;
+    for (GfxIndex i = 0; i < desc.extendedDescCount; i++)
+    {
+        StructType stype;
+        memcpy(&stype, desc.extendedDescs[i], sizeof(stype));
+        switch (stype)
+        {
+        case StructType::CPUDeviceExtendedDesc:
+            threadPoolSize =
+                static_cast<CPUDeviceExtendedDesc*>(desc.extendedDescs[i])->threadPoolSize;
+            if (threadPoolSize == 0)
+                threadPoolSize = Math::Max(1u, std::thread::hardware_concurrency()) - 1;
+            break;
+        default:
+            break;
+        }
+    }
+    for (uint32_t i = 0; i < threadPoolSize; i++)
+        m_dispatchWorkers.emplace_back([this]() { _runDispatchWorker(); });
+
     // Initialize DeviceInfo
     {
         m_info.deviceType = DeviceType::CPU;
@@ -279,17 +346,86 @@ void DeviceImpl::dispatchCompute(int x, int y, int z)
 
     auto func = (slang_prelude::ComputeFunc)sharedLibrary->findSymbolAddressByName(entryPointName);
 
-    slang_prelude::ComputeVaryingInput varyingInput;
-    varyingInput.startGroupID.x = 0;
-    varyingInput.startGroupID.y = 0;
-    varyingInput.startGroupID.z = 0;
-    varyingInput.endGroupID.x = x;
-    varyingInput.endGroupID.y = y;
-    varyingInput.endGroupID.z = z;
-
     auto globalParamsData = m_currentRootObject->getDataBuffer();
     auto entryPointParamsData = entryPointObject->getDataBuffer();
-    func(&varyingInput, entryPointParamsData, globalParamsData);
+
+    const uint32_t rowCount = uint32_t(y) * uint32_t(z);
+    if (m_dispatchWorkers.empty() || rowCount * uint32_t(x) <= 1)
+    {
+        slang_prelude::ComputeVaryingInput varyingInput;
+        varyingInput.startGroupID.x = 0;
+        varyingInput.startGroupID.y = 0;
+        varyingInput.startGroupID.z = 0;
+        varyingInput.endGroupID.x = x;
+        varyingInput.endGroupID.y = y;
+        varyingInput.endGroupID.z = z;
+        func(&varyingInput, entryPointParamsData, globalParamsData);
+        return;
+    }
+
+    // The thread groups are independent, so we split them into ranges of groups along x, for
+    // each y and z, and have the workers take the ranges one at a time. There are a few ranges
+    // per thread, so that threads that finish early pick up the groups left by the others.
+    //
+    const uint32_t threadCount = uint32_t(m_dispatchWorkers.size()) + 1;
+    const uint32_t minRangeCount = threadCount * 4;
+
+    DispatchJob job;
+    job.func = func;
+    job.entryPointParamsData = entryPointParamsData;
+    job.globalParamsData = globalParamsData;
+    job.groupCountX = uint32_t(x);
+    job.groupCountY = uint32_t(y);
+    job.rangesPerRow =
+        Math::Min(uint32_t(x), Math::Max(1u, (minRangeCount + rowCount - 1) / rowCount));
+    job.rangeCount = rowCount * job.rangesPerRow;
+
+    {
+        std::lock_guard<std::mutex> lock(m_dispatchMutex);
+        m_currentDispatch = &job;
+        m_dispatchGeneration++;
+    }
+    m_dispatchStartCondition.notify_all();
+
+    // The calling thread works on the dispatch too, and then waits for the workers that took
+    // part in it. Workers that wake up after that find no dispatch, and go back to waiting.
+    job.run();
+    {
+        std::unique_lock<std::mutex> lock(m_dispatchMutex);
+        m_dispatchDoneCondition.wait(lock, [this]() { return m_busyDispatchWorkerCount == 0; });
+        m_currentDispatch = nullptr;
+    }
+}
+
+void DeviceImpl::_runDispatchWorker()
+{
+    uint64_t lastGeneration = 0;
+    for (;;)
+    {
+        DispatchJob* job = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(m_dispatchMutex);
+            m_dispatchStartCondition.wait(
+                lock,
+                [&]()
+                { return m_isStoppingDispatchWorkers || m_dispatchGeneration != lastGeneration; });
+            if (m_isStoppingDispatchWorkers)
+                return;
+            lastGeneration = m_dispatchGeneration;
+            job = m_currentDispatch;
+            if (!job)
+                continue;
+            m_busyDispatchWorkerCount++;
+        }
+
+        job->run();
+
+        {
+            std::lock_guard<std::mutex> lock(m_dispatchMutex);
+            m_busyDispatchWorkerCount--;
+        }
+        m_dispatchDoneCondition.notify_one();
+    }
 }
 
 void DeviceImpl::copyBuffer(
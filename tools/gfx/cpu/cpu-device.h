@@ -83,6 +83,26 @@ private:
     RefPtr<RootShaderObjectImpl> m_currentRootObject = nullptr;
     DeviceInfo m_info;
 
+    // The thread groups of a compute dispatch that the workers and the calling thread share.
+    struct DispatchJob;
+
+    // The pool of threads that run compute dispatches with the calling thread. It is created
+    // with the device, and is empty unless a `CPUDeviceExtendedDesc` asks for workers.
+    std::vector<std::thread> m_dispatchWorkers;
+    std::mutex m_dispatchMutex;
+    // Signalled when a dispatch is started, or the workers are stopped.
+    std::condition_variable m_dispatchStartCondition;
+    // Signalled when a worker has finished its part of a dispatch.
+    std::condition_variable m_dispatchDoneCondition;
+    // The dispatch in progress, whose `generation` tells workers whether they have run it.
+    // Guarded by `m_dispatchMutex`, as is the rest of the dispatch state.
+    DispatchJob* m_currentDispatch = nullptr;
+    uint64_t m_dispatchGeneration = 0;
+    uint32_t m_busyDispatchWorkerCount = 0;
+    bool m_isStoppingDispatchWorkers = false;
+
+    void _runDispatchWorker();
+
     virtual void setPipelineState(IPipelineState* state) override;
 
     virtual void bindRootShaderObject(IShaderObject* object) override;
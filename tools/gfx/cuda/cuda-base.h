@@ -49,6 +49,7 @@ class RootShaderObjectImpl;
 class ShaderProgramImpl;
 class PipelineStateImpl;
 class QueryPoolImpl;
+class FenceImpl;
 class DeviceImpl;
 class CommandBufferImpl;
 class ResourceCommandEncoderImpl;
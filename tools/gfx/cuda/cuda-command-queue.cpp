@@ -3,6 +3,7 @@
 
 #include "cuda-buffer.h"
 #include "cuda-command-buffer.h"
+#include "cuda-fence.h"
 #include "cuda-query.h"
 #include "cuda-shader-object-layout.h"
 
@@ -41,13 +42,18 @@ SLANG_NO_THROW void SLANG_MCALL CommandQueueImpl::executeCommandBuffers(
     IFence* fence,
     uint64_t valueToSignal)
 {
-    SLANG_UNUSED(valueToSignal);
-    // TODO: implement fence.
-    assert(fence == nullptr);
     for (GfxIndex i = 0; i < count; i++)
     {
         execute(static_cast<CommandBufferImpl*>(commandBuffers[i]));
     }
+    // The commands are only enqueued on the stream, and the fence is signaled by an event that
+    // completes after them, such that nothing waits for the work here.
+    if (fence)
+    {
+        auto result = static_cast<FenceImpl*>(fence)->signalOnStream(stream, valueToSignal);
+        SLANG_ASSERT(SLANG_SUCCEEDED(result));
+        SLANG_UNUSED(result);
+    }
 }
 
 SLANG_NO_THROW void SLANG_MCALL CommandQueueImpl::waitOnHost()
@@ -62,12 +68,19 @@ SLANG_NO_THROW Result SLANG_MCALL CommandQueueImpl::waitForFenceValuesOnDevice(
     IFence** fences,
     uint64_t* waitValues)
 {
-    return SLANG_FAIL;
+    for (GfxIndex i = 0; i < fenceCount; ++i)
+    {
+        auto fenceImpl = static_cast<FenceImpl*>(fences[i]);
+        SLANG_RETURN_ON_FAIL(fenceImpl->waitOnStream(stream, waitValues[i]));
+    }
+    return SLANG_OK;
 }
 
 SLANG_NO_THROW Result SLANG_MCALL CommandQueueImpl::getNativeHandle(InteropHandle* outHandle)
 {
-    return SLANG_FAIL;
+    outHandle->api = InteropHandleAPI::CUDA;
+    outHandle->handleValue = (uint64_t)stream;
+    return SLANG_OK;
 }
 
 void CommandQueueImpl::setPipelineState(IPipelineState* state)
@@ -113,7 +126,7 @@ void CommandQueueImpl::dispatchCompute(int x, int y, int z)
             (CUdeviceptr)globalParamsSymbol,
             (CUdeviceptr)globalParamsCUDAData,
             globalParamsSymbolSize,
-            0);
+            stream);
     }
     //
     // The argument data for the entry-point parameters are already
@@ -158,10 +171,11 @@ void CommandQueueImpl::copyBuffer(
 {
     auto dstImpl = static_cast<BufferResourceImpl*>(dst);
     auto srcImpl = static_cast<BufferResourceImpl*>(src);
-    cuMemcpy(
+    cuMemcpyAsync(
         (CUdeviceptr)((uint8_t*)dstImpl->m_cudaMemory + dstOffset),
         (CUdeviceptr)((uint8_t*)srcImpl->m_cudaMemory + srcOffset),
-        size);
+        size,
+        stream);
 }
 
 void CommandQueueImpl::uploadBufferData(
@@ -171,7 +185,9 @@ void CommandQueueImpl::uploadBufferData(
     void* data)
 {
     auto dstImpl = static_cast<BufferResourceImpl*>(dst);
-    cuMemcpy((CUdeviceptr)((uint8_t*)dstImpl->m_cudaMemory + offset), (CUdeviceptr)data, size);
+    // The data is copied out of the pageable memory of the command buffer before the call returns,
+    // so the command buffer can be reset while the copy is still in flight.
+    cuMemcpyHtoDAsync((CUdeviceptr)((uint8_t*)dstImpl->m_cudaMemory + offset), data, size, stream);
 }
 
 void CommandQueueImpl::writeTimestamp(IQueryPool* pool, SlangInt index)
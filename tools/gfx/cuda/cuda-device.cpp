@@ -3,6 +3,7 @@
 
 #include "cuda-buffer.h"
 #include "cuda-command-queue.h"
+#include "cuda-fence.h"
 #include "cuda-pipeline-state.h"
 #include "cuda-query.h"
 #include "cuda-resource-views.h"
@@ -11,6 +12,9 @@
 #include "cuda-shader-program.h"
 #include "cuda-texture.h"
 
+#include <chrono>
+#include <thread>
+
 namespace gfx
 {
 #ifdef GFX_ENABLE_CUDA
@@ -939,6 +943,54 @@ DeviceImpl::createQueryPool(const IQueryPool::Desc& desc, IQueryPool** outPool)
     return SLANG_OK;
 }
 
+SLANG_NO_THROW Result SLANG_MCALL
+DeviceImpl::createFence(const IFence::Desc& desc, IFence** outFence)
+{
+    RefPtr<FenceImpl> fence = new FenceImpl();
+    SLANG_RETURN_ON_FAIL(fence->init(desc));
+    returnComPtr(outFence, fence);
+    return SLANG_OK;
+}
+
+SLANG_NO_THROW Result SLANG_MCALL DeviceImpl::waitForFences(
+    GfxCount fenceCount,
+    IFence** fences,
+    uint64_t* fenceValues,
+    bool waitForAll,
+    uint64_t timeout)
+{
+    if (waitForAll && timeout == kTimeoutInfinite)
+    {
+        for (GfxIndex i = 0; i < fenceCount; ++i)
+        {
+            auto fenceImpl = static_cast<FenceImpl*>(fences[i]);
+            SLANG_RETURN_ON_FAIL(fenceImpl->waitOnHost(fenceValues[i]));
+        }
+        return SLANG_OK;
+    }
+
+    // CUDA events cannot be waited on with a timeout, so poll them until the deadline.
+    auto startTime = std::chrono::steady_clock::now();
+    for (;;)
+    {
+        GfxCount reachedCount = 0;
+        for (GfxIndex i = 0; i < fenceCount; ++i)
+        {
+            auto fenceImpl = static_cast<FenceImpl*>(fences[i]);
+            if (fenceImpl->isValueReached(fenceValues[i]))
+                reachedCount++;
+        }
+        if (waitForAll ? reachedCount == fenceCount : reachedCount > 0)
+            return SLANG_OK;
+
+        auto elapsedTime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - startTime);
+        if (uint64_t(elapsedTime.count()) >= timeout)
+            return SLANG_E_TIME_OUT;
+        std::this_thread::yield();
+    }
+}
+
 Result DeviceImpl::createShaderObjectLayout(
     slang::ISession* session,
     slang::TypeLayoutReflection* typeLayout,
@@ -0,0 +1,149 @@
+// cuda-fence.cpp
+#include "cuda-fence.h"
+
+#include "cuda-helper-functions.h"
+
+namespace gfx
+{
+#ifdef GFX_ENABLE_CUDA
+using namespace Slang;
+
+namespace cuda
+{
+
+FenceImpl::~FenceImpl()
+{
+    for (auto& signal : m_pendingSignals)
+    {
+        cuEventDestroy(signal.event);
+    }
+    for (auto event : m_freeEvents)
+    {
+        cuEventDestroy(event);
+    }
+}
+
+Result FenceImpl::init(const IFence::Desc& desc)
+{
+    m_currentValue = desc.initialValue;
+    return SLANG_OK;
+}
+
+Result FenceImpl::signalOnStream(CUstream stream, uint64_t value)
+{
+    CUevent event = nullptr;
+    if (m_freeEvents.getCount())
+    {
+        event = m_freeEvents.getLast();
+        m_freeEvents.removeLast();
+    }
+    else
+    {
+        // The events are only used for ordering, so timing is disabled to make them cheaper.
+        SLANG_CUDA_RETURN_ON_FAIL(cuEventCreate(&event, CU_EVENT_DISABLE_TIMING));
+    }
+
+    auto result = cuEventRecord(event, stream);
+    if (result != CUDA_SUCCESS)
+    {
+        m_freeEvents.add(event);
+        SLANG_CUDA_RETURN_ON_FAIL(result);
+    }
+
+    PendingSignal signal;
+    signal.value = value;
+    signal.event = event;
+    m_pendingSignals.add(signal);
+    return SLANG_OK;
+}
+
+void FenceImpl::_retireCompletedSignals()
+{
+    Index count = 0;
+    for (auto& signal : m_pendingSignals)
+    {
+        if (cuEventQuery(signal.event) == CUDA_SUCCESS)
+        {
+            if (signal.value > m_currentValue)
+                m_currentValue = signal.value;
+            m_freeEvents.add(signal.event);
+        }
+        else
+        {
+            m_pendingSignals[count++] = signal;
+        }
+    }
+    m_pendingSignals.setCount(count);
+}
+
+FenceImpl::PendingSignal* FenceImpl::_findPendingSignal(uint64_t value)
+{
+    for (auto& signal : m_pendingSignals)
+    {
+        if (signal.value >= value)
+            return &signal;
+    }
+    return nullptr;
+}
+
+bool FenceImpl::isValueReached(uint64_t value)
+{
+    if (m_currentValue >= value)
+        return true;
+    _retireCompletedSignals();
+    return m_currentValue >= value;
+}
+
+Result FenceImpl::waitOnStream(CUstream stream, uint64_t value)
+{
+    if (isValueReached(value))
+        return SLANG_OK;
+
+    // A CUDA stream can only wait for an event that has already been recorded, so waiting for a
+    // value that no queue has been asked to signal yet is not supported.
+    auto signal = _findPendingSignal(value);
+    if (!signal)
+        return SLANG_E_NOT_AVAILABLE;
+    SLANG_CUDA_RETURN_ON_FAIL(cuStreamWaitEvent(stream, signal->event, 0));
+    return SLANG_OK;
+}
+
+Result FenceImpl::waitOnHost(uint64_t value)
+{
+    if (isValueReached(value))
+        return SLANG_OK;
+
+    auto signal = _findPendingSignal(value);
+    if (!signal)
+        return SLANG_E_NOT_AVAILABLE;
+    SLANG_CUDA_RETURN_ON_FAIL(cuEventSynchronize(signal->event));
+    _retireCompletedSignals();
+    return SLANG_OK;
+}
+
+Result FenceImpl::getCurrentValue(uint64_t* outValue)
+{
+    _retireCompletedSignals();
+    *outValue = m_currentValue;
+    return SLANG_OK;
+}
+
+Result FenceImpl::setCurrentValue(uint64_t value)
+{
+    m_currentValue = value;
+    return SLANG_OK;
+}
+
+Result FenceImpl::getSharedHandle(InteropHandle* outHandle)
+{
+    return SLANG_E_NOT_AVAILABLE;
+}
+
+Result FenceImpl::getNativeHandle(InteropHandle* outNativeHandle)
+{
+    return SLANG_E_NOT_AVAILABLE;
+}
+
+} // namespace cuda
+#endif
+} // namespace gfx
@@ -0,0 +1,68 @@
+// cuda-fence.h
+#pragma once
+#include "cuda-base.h"
+
+namespace gfx
+{
+#ifdef GFX_ENABLE_CUDA
+using namespace Slang;
+
+namespace cuda
+{
+
+/// A fence whose values are signaled by events recorded on the streams of command queues.
+class FenceImpl : public FenceBase
+{
+public:
+    ~FenceImpl();
+
+    Result init(const IFence::Desc& desc);
+
+    /// Record an event on `stream` that sets the fence to `value` once the work before it is
+    /// done.
+    Result signalOnStream(CUstream stream, uint64_t value);
+
+    /// Make the work submitted to `stream` from now on wait until the fence reaches `value`.
+    Result waitOnStream(CUstream stream, uint64_t value);
+
+    /// Block the calling thread until the fence reaches `value`.
+    Result waitOnHost(uint64_t value);
+
+    /// Check if the fence has reached `value`, without waiting.
+    bool isValueReached(uint64_t value);
+
+    virtual SLANG_NO_THROW Result SLANG_MCALL getCurrentValue(uint64_t* outValue) override;
+
+    virtual SLANG_NO_THROW Result SLANG_MCALL setCurrentValue(uint64_t value) override;
+
+    virtual SLANG_NO_THROW Result SLANG_MCALL getSharedHandle(InteropHandle* outHandle) override;
+
+    virtual SLANG_NO_THROW Result SLANG_MCALL
+    getNativeHandle(InteropHandle* outNativeHandle) override;
+
+protected:
+    struct PendingSignal
+    {
+        uint64_t value;
+        CUevent event;
+    };
+
+    /// Take the values of the signals whose events have completed, and recycle their events.
+    void _retireCompletedSignals();
+
+    /// Find the earliest pending signal that reaches `value`, or nullptr if there is none.
+    PendingSignal* _findPendingSignal(uint64_t value);
+
+    uint64_t m_currentValue = 0;
+
+    // The signals that have been recorded and may not have completed, in the order they were
+    // recorded.
+    List<PendingSignal> m_pendingSignals;
+
+    // Events of completed signals, to be reused by later signals.
+    List<CUevent> m_freeEvents;
+};
+
+} // namespace cuda
+#endif
+} // namespace gfx
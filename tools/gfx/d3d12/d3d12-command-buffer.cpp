@@ -31,7 +31,9 @@ Result CommandBufferImpl::getNativeHandle(InteropHandle* handle)
 
 void CommandBufferImpl::bindDescriptorHeaps()
 {
-    if (!m_descriptorHeapsBound)
+    // Copy command lists can't bind descriptor heaps, and have no use for them.
+    if (!m_descriptorHeapsBound &&
+        m_transientHeap->m_commandListType != D3D12_COMMAND_LIST_TYPE_COPY)
     {
         ID3D12DescriptorHeap* heaps[] = {
             m_transientHeap->getCurrentViewHeap().getHeap(),
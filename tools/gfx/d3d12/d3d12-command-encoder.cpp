@@ -44,6 +44,15 @@ void PipelineCommandEncoder::init(CommandBufferImpl* commandBuffer)
     m_renderer = commandBuffer->m_renderer;
     m_transientHeap = commandBuffer->m_transientHeap;
     m_device = commandBuffer->m_renderer->m_device;
+    m_submitterState.reset();
+    m_submitterState.stats = &m_redundantStateStats;
+}
+
+void PipelineCommandEncoder::endEncodingImpl()
+{
+    m_isOpen = false;
+    m_renderer->addRedundantStateStats(m_redundantStateStats);
+    m_redundantStateStats = {};
 }
 
 Result PipelineCommandEncoder::bindPipelineImpl(
@@ -106,6 +115,8 @@ Result PipelineCommandEncoder::_bindRenderState(
     // themselves will be responsible for allocating, binding, and filling in
     // any descriptor tables or other root parameters needed.
     //
+    if (!m_commandBuffer->m_descriptorHeapsBound)
+        m_submitterState.resetRootArguments();
     m_commandBuffer->bindDescriptorHeaps();
     if (rootObjectImpl->bindAsRoot(&context, rootLayoutImpl) == SLANG_E_OUT_OF_MEMORY)
     {
@@ -117,6 +128,7 @@ Result PipelineCommandEncoder::_bindRenderState(
         // If we run out of heap space while binding, allocate new descriptor heaps and try again.
         ID3D12DescriptorHeap* d3dheap = nullptr;
         m_commandBuffer->invalidateDescriptorHeapBinding();
+        m_submitterState.resetRootArguments();
         switch (context.outOfMemoryHeap)
         {
         case D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV:
@@ -336,17 +348,16 @@ void ResourceCommandEncoderImpl::uploadTextureData(
 
         IBufferResource* stagingBuffer;
         Offset stagingBufferOffset = 0;
-        m_commandBuffer->m_transientHeap->allocateStagingBuffer(
+        void* mappedData = nullptr;
+        m_commandBuffer->m_transientHeap->allocateMappedStagingBuffer(
             bufferSize,
             stagingBuffer,
             stagingBufferOffset,
-            MemoryType::Upload,
+            mappedData,
             true);
         assert(stagingBufferOffset == 0);
         BufferResourceImpl* bufferImpl = static_cast<BufferResourceImpl*>(stagingBuffer);
-        uint8_t* bufferData = nullptr;
-        D3D12_RANGE mapRange = {0, 0};
-        bufferImpl->m_resource.getResource()->Map(0, &mapRange, (void**)&bufferData);
+        uint8_t* bufferData = (uint8_t*)mappedData;
         for (uint32_t z = 0; z < footprint.Footprint.Depth; z++)
         {
             auto imageStart = bufferData + footprint.Footprint.RowPitch * rowCount * (Size)z;
@@ -359,7 +370,6 @@ void ResourceCommandEncoderImpl::uploadTextureData(
                     rowSize);
             }
         }
-        bufferImpl->m_resource.getResource()->Unmap(0, nullptr);
         srcRegion.pResource = bufferImpl->m_resource.getResource();
         m_commandBuffer->m_cmdList
             ->CopyTextureRegion(&dstRegion, offset.x, offset.y, offset.z, &srcRegion, nullptr);
@@ -834,6 +844,11 @@ void RenderCommandEncoderImpl::init(
     m_boundIndexFormat = DXGI_FORMAT_UNKNOWN;
     m_boundIndexOffset = 0;
     m_currentPipeline = nullptr;
+    m_viewportCount = 0;
+    m_scissorRectCount = 0;
+    m_setPrimitiveTopology = D3D_PRIMITIVE_TOPOLOGY_UNDEFINED;
+    m_setVertexViewCount = -1;
+    m_setIndexBufferView = {};
 
     // Set render target states.
     if (!framebuffer)
@@ -954,10 +969,11 @@ void RenderCommandEncoderImpl::setViewports(GfxCount count, const Viewport* view
 {
     static const int kMaxViewports = D3D12_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE;
     assert(count <= kMaxViewports && count <= kMaxRTVCount);
+    D3D12_VIEWPORT dxViewports[kMaxRTVCount];
     for (GfxIndex ii = 0; ii < count; ++ii)
     {
         auto& inViewport = viewports[ii];
-        auto& dxViewport = m_viewports[ii];
+        auto& dxViewport = dxViewports[ii];
 
         dxViewport.TopLeftX = inViewport.originX;
         dxViewport.TopLeftY = inViewport.originY;
@@ -966,6 +982,14 @@ void RenderCommandEncoderImpl::setViewports(GfxCount count, const Viewport* view
         dxViewport.MinDepth = inViewport.minZ;
         dxViewport.MaxDepth = inViewport.maxZ;
     }
+    if (m_viewportCount == count &&
+        memcmp(m_viewports, dxViewports, sizeof(D3D12_VIEWPORT) * count) == 0)
+    {
+        m_redundantStateStats.viewportCount++;
+        return;
+    }
+    memcpy(m_viewports, dxViewports, sizeof(D3D12_VIEWPORT) * count);
+    m_viewportCount = count;
     m_d3dCmdList->RSSetViewports(UINT(count), m_viewports);
 }
 
@@ -974,16 +998,25 @@ void RenderCommandEncoderImpl::setScissorRects(GfxCount count, const ScissorRect
     static const int kMaxScissorRects = D3D12_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE;
     assert(count <= kMaxScissorRects && count <= kMaxRTVCount);
 
+    D3D12_RECT dxRects[kMaxRTVCount];
     for (GfxIndex ii = 0; ii < count; ++ii)
     {
         auto& inRect = rects[ii];
-        auto& dxRect = m_scissorRects[ii];
+        auto& dxRect = dxRects[ii];
 
         dxRect.left = LONG(inRect.minX);
         dxRect.top = LONG(inRect.minY);
         dxRect.right = LONG(inRect.maxX);
         dxRect.bottom = LONG(inRect.maxY);
     }
+    if (m_scissorRectCount == count &&
+        memcmp(m_scissorRects, dxRects, sizeof(D3D12_RECT) * count) == 0)
+    {
+        m_redundantStateStats.scissorRectCount++;
+        return;
+    }
+    memcpy(m_scissorRects, dxRects, sizeof(D3D12_RECT) * count);
+    m_scissorRectCount = count;
 
     m_d3dCmdList->RSSetScissorRects(UINT(count), m_scissorRects);
 }
@@ -1038,12 +1071,16 @@ Result RenderCommandEncoderImpl::prepareDraw()
 
     // Submit - setting for graphics
     {
-        GraphicsSubmitter submitter(m_d3dCmdList);
+        GraphicsSubmitter submitter(m_d3dCmdList, &m_submitterState);
         RefPtr<PipelineStateBase> newPipeline;
         SLANG_RETURN_ON_FAIL(_bindRenderState(&submitter, newPipeline));
     }
 
-    m_d3dCmdList->IASetPrimitiveTopology(m_primitiveTopology);
+    if (m_setPrimitiveTopology != m_primitiveTopology)
+    {
+        m_d3dCmdList->IASetPrimitiveTopology(m_primitiveTopology);
+        m_setPrimitiveTopology = m_primitiveTopology;
+    }
 
     // Set up vertex buffer views
     {
@@ -1067,7 +1104,23 @@ Result RenderCommandEncoderImpl::prepareDraw()
                     vertexView.StrideInBytes = inputLayout->m_vertexStreamStrides[i];
                 }
             }
-            m_d3dCmdList->IASetVertexBuffers(0, numVertexViews, vertexViews);
+            if (m_setVertexViewCount == numVertexViews &&
+                memcmp(
+                    m_setVertexViews,
+                    vertexViews,
+                    sizeof(D3D12_VERTEX_BUFFER_VIEW) * numVertexViews) == 0)
+            {
+                m_redundantStateStats.vertexBufferBindCount++;
+            }
+            else
+            {
+                m_d3dCmdList->IASetVertexBuffers(0, numVertexViews, vertexViews);
+                memcpy(
+                    m_setVertexViews,
+                    vertexViews,
+                    sizeof(D3D12_VERTEX_BUFFER_VIEW) * numVertexViews);
+                m_setVertexViewCount = numVertexViews;
+            }
         }
     }
     // Set up index buffer
@@ -1081,7 +1134,15 @@ Result RenderCommandEncoderImpl::prepareDraw()
             UINT(m_boundIndexBuffer->getDesc()->sizeInBytes - m_boundIndexOffset);
         indexBufferView.Format = m_boundIndexFormat;
 
-        m_d3dCmdList->IASetIndexBuffer(&indexBufferView);
+        if (memcmp(&m_setIndexBufferView, &indexBufferView, sizeof(indexBufferView)) == 0)
+        {
+            m_redundantStateStats.indexBufferBindCount++;
+        }
+        else
+        {
+            m_d3dCmdList->IASetIndexBuffer(&indexBufferView);
+            m_setIndexBufferView = indexBufferView;
+        }
     }
     return SLANG_OK;
 }
@@ -1288,7 +1349,7 @@ Result ComputeCommandEncoderImpl::dispatchCompute(int x, int y, int z)
 {
     // Submit binding for compute
     {
-        ComputeSubmitter submitter(m_d3dCmdList);
+        ComputeSubmitter submitter(m_d3dCmdList, &m_submitterState);
         RefPtr<PipelineStateBase> newPipeline;
         SLANG_RETURN_ON_FAIL(_bindRenderState(&submitter, newPipeline));
     }
@@ -1300,7 +1361,7 @@ Result ComputeCommandEncoderImpl::dispatchComputeIndirect(IBufferResource* argBu
 {
     // Submit binding for compute
     {
-        ComputeSubmitter submitter(m_d3dCmdList);
+        ComputeSubmitter submitter(m_d3dCmdList, &m_submitterState);
         RefPtr<PipelineStateBase> newPipeline;
         SLANG_RETURN_ON_FAIL(_bindRenderState(&submitter, newPipeline));
     }
@@ -31,11 +31,15 @@ public:
 
     RefPtr<PipelineStateBase> m_currentPipeline;
 
+    // The state changes this encoder skipped because the state was already set.
+    RedundantStateStats m_redundantStateStats = {};
+    SubmitterState m_submitterState;
+
     static int getBindPointIndex(PipelineType type);
 
     void init(CommandBufferImpl* commandBuffer);
 
-    void endEncodingImpl() { m_isOpen = false; }
+    void endEncodingImpl();
 
     Result bindPipelineImpl(IPipelineState* pipelineState, IShaderObject** outRootObject);
 
@@ -218,6 +222,14 @@ public:
     D3D12_PRIMITIVE_TOPOLOGY_TYPE m_primitiveTopologyType;
     D3D12_PRIMITIVE_TOPOLOGY m_primitiveTopology;
 
+    // The state last set on the command list by this encoder.
+    GfxCount m_viewportCount;
+    GfxCount m_scissorRectCount;
+    D3D12_PRIMITIVE_TOPOLOGY m_setPrimitiveTopology;
+    D3D12_VERTEX_BUFFER_VIEW m_setVertexViews[16];
+    int m_setVertexViewCount;
+    D3D12_INDEX_BUFFER_VIEW m_setIndexBufferView;
+
     void init(
         DeviceImpl* renderer,
         TransientResourceHeapImpl* transientHeap,
@@ -4,6 +4,7 @@
 #include "d3d12-command-buffer.h"
 #include "d3d12-device.h"
 #include "d3d12-fence.h"
+#include "d3d12-helper-functions.h"
 
 namespace gfx
 {
@@ -12,13 +13,14 @@ namespace d3d12
 
 using namespace Slang;
 
-Result CommandQueueImpl::init(DeviceImpl* device, uint32_t queueIndex)
+Result CommandQueueImpl::init(DeviceImpl* device, uint32_t queueIndex, const Desc& desc)
 {
     m_queueIndex = queueIndex;
     m_renderer = device;
     m_device = device->m_device;
+    m_desc = desc;
     D3D12_COMMAND_QUEUE_DESC queueDesc = {};
-    queueDesc.Type = D3D12_COMMAND_LIST_TYPE_DIRECT;
+    queueDesc.Type = translateCommandListType(desc.type);
     SLANG_RETURN_ON_FAIL(
         m_device->CreateCommandQueue(&queueDesc, IID_PPV_ARGS(m_d3dQueue.writeRef())));
     SLANG_RETURN_ON_FAIL(
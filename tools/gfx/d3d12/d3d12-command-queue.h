@@ -29,7 +29,7 @@ public:
     Desc m_desc;
     uint32_t m_queueIndex = 0;
 
-    Result init(DeviceImpl* device, uint32_t queueIndex);
+    Result init(DeviceImpl* device, uint32_t queueIndex, const Desc& desc);
     ~CommandQueueImpl();
     virtual SLANG_NO_THROW const Desc& SLANG_MCALL getDesc() override;
 
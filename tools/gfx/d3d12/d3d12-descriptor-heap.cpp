@@ -6,7 +6,7 @@ namespace gfx
 using namespace Slang;
 
 D3D12DescriptorHeap::D3D12DescriptorHeap()
-    : m_totalSize(0), m_currentIndex(0), m_descriptorSize(0)
+    : m_startIndex(0), m_totalSize(0), m_currentIndex(0), m_descriptorSize(0)
 {
 }
 
@@ -26,12 +26,30 @@ Result D3D12DescriptorHeap::init(
         device->CreateDescriptorHeap(&srvHeapDesc, IID_PPV_ARGS(m_heap.writeRef())));
 
     m_descriptorSize = device->GetDescriptorHandleIncrementSize(type);
+    m_startIndex = 0;
     m_totalSize = size;
     m_heapFlags = flags;
 
     return SLANG_OK;
 }
 
+Result D3D12DescriptorHeap::initAsRange(const D3D12DescriptorHeap& heap, int startIndex, int size)
+{
+    // Ranges can't be resized, since other ranges of the underlying heap follow them, and
+    // only shader-visible heaps are never resized.
+    assert(heap.m_heapFlags & D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE);
+    assert(startIndex >= 0 && startIndex + size <= heap.m_totalSize);
+    m_device = heap.m_device;
+    m_heap = heap.m_heap;
+    m_descriptorSize = heap.m_descriptorSize;
+    m_startIndex = heap.m_startIndex + startIndex;
+    m_totalSize = size;
+    m_currentIndex = 0;
+    m_heapFlags = heap.m_heapFlags;
+
+    return SLANG_OK;
+}
+
 Result D3D12DescriptorHeap::init(
     ID3D12Device* device,
     const D3D12_CPU_DESCRIPTOR_HANDLE* handles,
@@ -33,6 +33,9 @@ public:
         int numHandles,
         D3D12_DESCRIPTOR_HEAP_TYPE type,
         D3D12_DESCRIPTOR_HEAP_FLAGS flags);
+    /// Initialize as the `size` descriptors starting at `startIndex` of `heap`. The underlying
+    /// heap is shared with `heap`, and allocations are only made from that range.
+    Slang::Result initAsRange(const D3D12DescriptorHeap& heap, int startIndex, int size);
 
     /// Returns the number of slots that have been used
     SLANG_FORCE_INLINE int getUsedSize() const { return m_currentIndex; }
@@ -54,15 +57,22 @@ public:
     /// Get the size of each
     SLANG_FORCE_INLINE int getDescriptorSize() const { return m_descriptorSize; }
 
+    /// Get the index in the underlying heap of the first descriptor of this heap
+    SLANG_FORCE_INLINE int getStartIndex() const { return m_startIndex; }
+
     /// Get the GPU heap start
     SLANG_FORCE_INLINE D3D12_GPU_DESCRIPTOR_HANDLE getGpuStart() const
     {
-        return m_heap->GetGPUDescriptorHandleForHeapStart();
+        D3D12_GPU_DESCRIPTOR_HANDLE start = m_heap->GetGPUDescriptorHandleForHeapStart();
+        start.ptr += (UINT64)m_descriptorSize * m_startIndex;
+        return start;
     }
     /// Get the CPU heap start
     SLANG_FORCE_INLINE D3D12_CPU_DESCRIPTOR_HANDLE getCpuStart() const
     {
-        return m_heap->GetCPUDescriptorHandleForHeapStart();
+        D3D12_CPU_DESCRIPTOR_HANDLE start = m_heap->GetCPUDescriptorHandleForHeapStart();
+        start.ptr += (SIZE_T)m_descriptorSize * m_startIndex;
+        return start;
     }
 
     /// Get the GPU handle at the specified index
@@ -79,6 +89,7 @@ public:
 protected:
     Slang::ComPtr<ID3D12Device> m_device;
     Slang::ComPtr<ID3D12DescriptorHeap> m_heap; ///< The underlying heap being allocated from
+    int m_startIndex;                        ///< The index of the first descriptor in `m_heap`
     int m_totalSize;                         ///< Total amount of allocations available on the heap
     int m_currentIndex;                      ///< The current descriptor
     int m_descriptorSize;                    ///< The size of each descriptor
@@ -136,6 +147,8 @@ public:
         return m_heap.getGpuHandle(index);
     }
 
+    const D3D12DescriptorHeap& getHeap() const { return m_heap; }
+
     int allocate(int count) { return m_allocator.alloc(count); }
 
     Slang::Result allocate(D3D12Descriptor* outDescriptor)
@@ -519,7 +532,7 @@ SLANG_FORCE_INLINE D3D12_CPU_DESCRIPTOR_HANDLE D3D12DescriptorHeap::getCpuHandle
     assert(index >= 0 && index < m_totalSize);
     D3D12_CPU_DESCRIPTOR_HANDLE start = m_heap->GetCPUDescriptorHandleForHeapStart();
     D3D12_CPU_DESCRIPTOR_HANDLE dst;
-    dst.ptr = start.ptr + m_descriptorSize * index;
+    dst.ptr = start.ptr + m_descriptorSize * (m_startIndex + index);
     return dst;
 }
 // ---------------------------------------------------------------------------
@@ -528,7 +541,7 @@ SLANG_FORCE_INLINE D3D12_GPU_DESCRIPTOR_HANDLE D3D12DescriptorHeap::getGpuHandle
     assert(index >= 0 && index < m_totalSize);
     D3D12_GPU_DESCRIPTOR_HANDLE start = m_heap->GetGPUDescriptorHandleForHeapStart();
     D3D12_GPU_DESCRIPTOR_HANDLE dst;
-    dst.ptr = start.ptr + m_descriptorSize * index;
+    dst.ptr = start.ptr + m_descriptorSize * (m_startIndex + index);
     return dst;
 }
 
@@ -2,6 +2,8 @@
 #include "d3d12-device.h"
 
 #include "../nvapi/nvapi-util.h"
+#include "core/slang-crypto.h"
+#include "core/slang-io.h"
 #include "d3d12-buffer.h"
 #include "d3d12-fence.h"
 #include "d3d12-framebuffer.h"
@@ -831,7 +833,9 @@ Result DeviceImpl::initialize(const Desc& desc)
     m_desc = desc;
 
     // Create a command queue for internal resource transfer operations.
-    SLANG_RETURN_ON_FAIL(createCommandQueueImpl(m_resourceCommandQueue.writeRef()));
+    ICommandQueue::Desc resourceQueueDesc = {ICommandQueue::QueueType::Graphics};
+    SLANG_RETURN_ON_FAIL(
+        createCommandQueueImpl(resourceQueueDesc, m_resourceCommandQueue.writeRef()));
     // `CommandQueueImpl` holds a back reference to `D3D12Device`, make it a weak reference here
     // since this object is already owned by `D3D12Device`.
     m_resourceCommandQueue->breakStrongReferenceToDevice();
@@ -875,6 +879,16 @@ Result DeviceImpl::initialize(const Desc& desc)
         m_info.limits = limits;
     }
 
+    if (m_extendedDesc.enableBindlessResources)
+    {
+        m_bindlessViewHeap = new D3D12GeneralDescriptorHeap();
+        SLANG_RETURN_ON_FAIL(m_bindlessViewHeap->init(
+            m_device,
+            D3D12_MAX_SHADER_VISIBLE_DESCRIPTOR_HEAP_SIZE_TIER_1,
+            D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV,
+            D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE));
+    }
+
     SLANG_RETURN_ON_FAIL(createTransientResourceHeapImpl(
         ITransientResourceHeap::Flags::AllowResizing,
         0,
@@ -1012,6 +1026,25 @@ Result DeviceImpl::initialize(const Desc& desc)
             nullptr,
             IID_PPV_ARGS(dispatchIndirectCmdSignature.writeRef())));
     }
+
+    if (desc.shaderCache.shaderCachePath && m_deviceInfo.m_adapter)
+    {
+        // Name the file after the adapter, so that devices sharing a shader cache directory each
+        // keep their own data. A library written by another driver version is rejected when it
+        // is loaded.
+        DXGI_ADAPTER_DESC adapterDesc;
+        m_deviceInfo.m_adapter->GetDesc(&adapterDesc);
+        DigestBuilder<SHA1> builder;
+        builder.append(adapterDesc.VendorId);
+        builder.append(adapterDesc.DeviceId);
+        builder.append(adapterDesc.SubSysId);
+        builder.append(adapterDesc.Revision);
+        m_pipelineLibraryFileName = Path::combine(
+            desc.shaderCache.shaderCachePath,
+            "d3d12-pipeline-library-" + builder.finalize().toString());
+    }
+    _createPipelineLibrary(true);
+
     m_isInitialized = true;
     return SLANG_OK;
 }
@@ -1034,7 +1067,7 @@ Result DeviceImpl::createTransientResourceHeap(
 Result DeviceImpl::createCommandQueue(const ICommandQueue::Desc& desc, ICommandQueue** outQueue)
 {
     RefPtr<CommandQueueImpl> queue;
-    SLANG_RETURN_ON_FAIL(createCommandQueueImpl(queue.writeRef()));
+    SLANG_RETURN_ON_FAIL(createCommandQueueImpl(desc, queue.writeRef()));
     returnComPtr(outQueue, queue);
     return SLANG_OK;
 }
@@ -1085,6 +1118,48 @@ Result DeviceImpl::getTextureRowAlignment(Size* outAlignment)
     return SLANG_OK;
 }
 
+Result DeviceImpl::getBindlessResourceIndex(IResourceView* view, uint32_t* outIndex)
+{
+    *outIndex = 0;
+    if (!m_bindlessViewHeap)
+        return SLANG_E_NOT_AVAILABLE;
+
+    ResourceViewInternalImpl* viewImpl = nullptr;
+    switch (view->getViewDesc()->type)
+    {
+    case IResourceView::Type::ShaderResource:
+    case IResourceView::Type::UnorderedAccess:
+        viewImpl = static_cast<ResourceViewImpl*>(view);
+        break;
+#if SLANG_GFX_HAS_DXR_SUPPORT
+    case IResourceView::Type::AccelerationStructure:
+        viewImpl = static_cast<AccelerationStructureImpl*>(view);
+        break;
+#endif
+    default:
+        // Render target and depth stencil views can't be accessed by shaders.
+        return SLANG_E_INVALID_ARG;
+    }
+
+    // A view is copied into the shader-visible heap the first time its index is asked for,
+    // and keeps its slot until it is destroyed.
+    if (viewImpl->m_bindlessIndex < 0)
+    {
+        int index = m_bindlessViewHeap->allocate(1);
+        if (index < 0)
+            return SLANG_E_OUT_OF_MEMORY;
+        m_device->CopyDescriptorsSimple(
+            1,
+            m_bindlessViewHeap->getCpuHandle(index),
+            viewImpl->m_descriptor.cpuHandle,
+            D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+        viewImpl->m_bindlessIndex = index;
+        viewImpl->m_bindlessHeap = m_bindlessViewHeap;
+    }
+    *outIndex = (uint32_t)viewImpl->m_bindlessIndex;
+    return SLANG_OK;
+}
+
 Result DeviceImpl::createTextureResource(
     const ITextureResource::Desc& descIn,
     const ITextureResource::SubresourceData* initData,
@@ -2290,7 +2365,9 @@ Result DeviceImpl::createTransientResourceHeapImpl(
     return SLANG_OK;
 }
 
-Result DeviceImpl::createCommandQueueImpl(CommandQueueImpl** outQueue)
+Result DeviceImpl::createCommandQueueImpl(
+    const ICommandQueue::Desc& desc,
+    CommandQueueImpl** outQueue)
 {
     int queueIndex = m_queueIndexAllocator.alloc(1);
     // If we run out of queue index space, then the user is requesting too many queues.
@@ -2298,7 +2375,7 @@ Result DeviceImpl::createCommandQueueImpl(CommandQueueImpl** outQueue)
         return SLANG_FAIL;
 
     RefPtr<CommandQueueImpl> queue = new CommandQueueImpl();
-    SLANG_RETURN_ON_FAIL(queue->init(this, (uint32_t)queueIndex));
+    SLANG_RETURN_ON_FAIL(queue->init(this, (uint32_t)queueIndex, desc));
     returnRefPtrMove(outQueue, queue);
     return SLANG_OK;
 }
@@ -2317,6 +2394,62 @@ void* DeviceImpl::loadProc(SharedLibrary::Handle module, char const* name)
 DeviceImpl::~DeviceImpl()
 {
     m_shaderObjectLayoutCache = decltype(m_shaderObjectLayoutCache)();
+    if (m_pipelineLibrary)
+    {
+        _savePipelineLibrary();
+        m_pipelineLibrary.setNull();
+    }
+}
+
+void DeviceImpl::_createPipelineLibrary(bool loadFromFile)
+{
+    m_pipelineLibrary.setNull();
+    m_pipelineLibraryData.clear();
+    m_hasNewPipelineLibraryEntries = false;
+
+    // Pipelines are created without a library if the runtime or driver doesn't support them.
+    ComPtr<ID3D12Device1> device1;
+    if (SLANG_FAILED(m_device->QueryInterface<ID3D12Device1>(device1.writeRef())))
+        return;
+
+    if (loadFromFile && m_pipelineLibraryFileName.getLength() &&
+        SLANG_SUCCEEDED(File::readAllBytes(m_pipelineLibraryFileName, m_pipelineLibraryData)) &&
+        SLANG_SUCCEEDED(device1->CreatePipelineLibrary(
+            m_pipelineLibraryData.getBuffer(),
+            SIZE_T(m_pipelineLibraryData.getCount()),
+            IID_PPV_ARGS(m_pipelineLibrary.writeRef()))))
+    {
+        return;
+    }
+
+    // The data was missing, or written for another adapter or driver version.
+    m_pipelineLibraryData.clear();
+    device1->CreatePipelineLibrary(nullptr, 0, IID_PPV_ARGS(m_pipelineLibrary.writeRef()));
+}
+
+void DeviceImpl::_savePipelineLibrary()
+{
+    if (!m_pipelineLibraryFileName.getLength() || !m_hasNewPipelineLibraryEntries)
+        return;
+
+    const SIZE_T size = m_pipelineLibrary->GetSerializedSize();
+    if (size == 0)
+        return;
+    List<unsigned char> data;
+    data.setCount(Index(size));
+    if (SLANG_FAILED(m_pipelineLibrary->Serialize(data.getBuffer(), size)))
+        return;
+    writePipelineCacheFile(m_pipelineLibraryFileName, data.getBuffer(), size);
+}
+
+Result DeviceImpl::clearShaderCache()
+{
+    SLANG_RETURN_ON_FAIL(RendererBase::clearShaderCache());
+
+    // Start over with an empty library, so the pipelines created so far aren't written back to
+    // the cleared directory when the device is destroyed.
+    _createPipelineLibrary(false);
+    return SLANG_OK;
 }
 
 
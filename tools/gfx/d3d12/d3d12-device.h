@@ -5,6 +5,7 @@
 #include "d3d12-texture.h"
 #include "d3d12-transient-heap.h"
 
+#include <atomic>
 #include <d3d12.h>
 #include <d3d12sdklayers.h>
 
@@ -79,6 +80,12 @@ public:
     RefPtr<D3D12GeneralExpandingDescriptorHeap> m_cpuViewHeap;    ///< Cbv, Srv, Uav
     RefPtr<D3D12GeneralExpandingDescriptorHeap> m_cpuSamplerHeap; ///< Heap for samplers
 
+    // When bindless resources are enabled, the shader-visible CBV/SRV/UAV descriptors of all
+    // transient heaps are allocated from this heap, along with the views registered by
+    // `getBindlessResourceIndex`, so that a single heap can be bound for all command lists.
+    //
+    RefPtr<D3D12GeneralDescriptorHeap> m_bindlessViewHeap;
+
     // Dll entry points
     PFN_D3D12_GET_DEBUG_INTERFACE m_D3D12GetDebugInterface = nullptr;
     PFN_D3D12_CREATE_DEVICE m_D3D12CreateDevice = nullptr;
@@ -96,6 +103,15 @@ public:
     ComPtr<ID3D12CommandSignature> drawIndexedIndirectCmdSignature;
     ComPtr<ID3D12CommandSignature> dispatchIndirectCmdSignature;
 
+    // The library graphics and compute pipeline states are stored in and loaded from, if the
+    // driver supports it. It is persisted in the shader cache directory, if there is one, so the
+    // driver doesn't compile the same pipelines again. The library keeps pointing into the data
+    // it was created from, so that is kept alive with it.
+    ComPtr<ID3D12PipelineLibrary> m_pipelineLibrary;
+    List<unsigned char> m_pipelineLibraryData;
+    String m_pipelineLibraryFileName;
+    std::atomic<bool> m_hasNewPipelineLibraryEntries = false;
+
 public:
     virtual SLANG_NO_THROW SlangResult SLANG_MCALL initialize(const Desc& desc) override;
     virtual SLANG_NO_THROW Result SLANG_MCALL
@@ -116,6 +132,11 @@ public:
         Size* outSize,
         Size* outAlignment) override;
     virtual SLANG_NO_THROW Result SLANG_MCALL getTextureRowAlignment(Size* outAlignment) override;
+
+    virtual SLANG_NO_THROW Result SLANG_MCALL
+    getBindlessResourceIndex(IResourceView* view, uint32_t* outIndex) override;
+    // Draws and dispatches fail without recording anything while their pipeline is pending.
+    virtual bool supportsAsyncPipelineSpecialization() override { return true; }
     virtual SLANG_NO_THROW Result SLANG_MCALL createTextureResource(
         const ITextureResource::Desc& desc,
         const ITextureResource::SubresourceData* initData,
@@ -231,7 +252,7 @@ public:
 public:
     static void* loadProc(SharedLibrary::Handle module, char const* name);
 
-    Result createCommandQueueImpl(CommandQueueImpl** outQueue);
+    Result createCommandQueueImpl(const ICommandQueue::Desc& desc, CommandQueueImpl** outQueue);
 
     Result createTransientResourceHeapImpl(
         ITransientResourceHeap::Flags::Enum flags,
@@ -270,6 +291,15 @@ public:
     ResourceCommandRecordInfo encodeResourceCommands();
     void submitResourceCommandsAndWait(const ResourceCommandRecordInfo& info);
 
+    // IShaderCache implementation
+    virtual SLANG_NO_THROW Result SLANG_MCALL clearShaderCache() override;
+
+    /// Create `m_pipelineLibrary`, from the file written by an earlier device with the same
+    /// adapter and driver if there is a shader cache.
+    void _createPipelineLibrary(bool loadFromFile);
+    /// Write the contents of `m_pipelineLibrary` to the file in the shader cache directory.
+    void _savePipelineLibrary();
+
 private:
     void processExperimentalFeaturesDesc(SharedLibrary::Handle d3dModule, void* desc);
 };
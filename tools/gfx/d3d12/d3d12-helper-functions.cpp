@@ -201,6 +201,20 @@ D3D12_COMPARISON_FUNC translateComparisonFunc(ComparisonFunc func)
     }
 }
 
+D3D12_COMMAND_LIST_TYPE translateCommandListType(ICommandQueue::QueueType type)
+{
+    switch (type)
+    {
+    case ICommandQueue::QueueType::Compute:
+        return D3D12_COMMAND_LIST_TYPE_COMPUTE;
+    case ICommandQueue::QueueType::Copy:
+        return D3D12_COMMAND_LIST_TYPE_COPY;
+    case ICommandQueue::QueueType::Graphics:
+    default:
+        return D3D12_COMMAND_LIST_TYPE_DIRECT;
+    }
+}
+
 uint32_t getViewDescriptorCount(const ITransientResourceHeap::Desc& desc)
 {
     return Math::Max(
@@ -424,47 +438,42 @@ Result uploadBufferDataImpl(
     Size size,
     void* data)
 {
-    IBufferResource* uploadResource;
-    Offset uploadResourceOffset = 0;
-    if (buffer->getDesc()->memoryType != MemoryType::Upload)
+    if (buffer->getDesc()->memoryType == MemoryType::Upload)
     {
-        SLANG_RETURN_ON_FAIL(transientHeap->allocateStagingBuffer(
-            size,
-            uploadResource,
-            uploadResourceOffset,
-            MemoryType::Upload));
-    }
-    else
-    {
-        uploadResourceOffset = offset;
-    }
-    D3D12Resource& uploadResourceRef =
-        (buffer->getDesc()->memoryType == MemoryType::Upload)
-            ? buffer->m_resource
-            : static_cast<BufferResourceImpl*>(uploadResource)->m_resource;
-
-    D3D12_RANGE readRange = {};
-    readRange.Begin = 0;
-    readRange.End = 0;
-    void* uploadData;
-    SLANG_RETURN_ON_FAIL(
-        uploadResourceRef.getResource()->Map(0, &readRange, reinterpret_cast<void**>(&uploadData)));
-    memcpy((uint8_t*)uploadData + uploadResourceOffset, data, size);
-    D3D12_RANGE writtenRange = {};
-    writtenRange.Begin = uploadResourceOffset;
-    writtenRange.End = uploadResourceOffset + size;
-    uploadResourceRef.getResource()->Unmap(0, &writtenRange);
-
-    if (buffer->getDesc()->memoryType != MemoryType::Upload)
-    {
-        cmdList->CopyBufferRegion(
-            buffer->m_resource.getResource(),
-            offset,
-            uploadResourceRef.getResource(),
-            uploadResourceOffset,
-            size);
+        // Write the buffer directly.
+        D3D12_RANGE readRange = {};
+        readRange.Begin = 0;
+        readRange.End = 0;
+        void* uploadData;
+        SLANG_RETURN_ON_FAIL(buffer->m_resource.getResource()->Map(
+            0,
+            &readRange,
+            reinterpret_cast<void**>(&uploadData)));
+        memcpy((uint8_t*)uploadData + offset, data, size);
+        D3D12_RANGE writtenRange = {};
+        writtenRange.Begin = offset;
+        writtenRange.End = offset + size;
+        buffer->m_resource.getResource()->Unmap(0, &writtenRange);
+        return SLANG_OK;
     }
 
+    // Write the data to the upload pool of the transient heap, which stays mapped, and copy it
+    // from there.
+    IBufferResource* uploadResource;
+    Offset uploadResourceOffset = 0;
+    void* uploadData;
+    SLANG_RETURN_ON_FAIL(transientHeap->allocateMappedStagingBuffer(
+        size,
+        uploadResource,
+        uploadResourceOffset,
+        uploadData));
+    memcpy(uploadData, data, size);
+    cmdList->CopyBufferRegion(
+        buffer->m_resource.getResource(),
+        offset,
+        static_cast<BufferResourceImpl*>(uploadResource)->m_resource.getResource(),
+        uploadResourceOffset,
+        size);
     return SLANG_OK;
 }
 
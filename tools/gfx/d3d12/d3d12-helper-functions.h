@@ -53,6 +53,7 @@ D3D12_FILTER_TYPE translateFilterMode(TextureFilteringMode mode);
 D3D12_FILTER_REDUCTION_TYPE translateFilterReduction(TextureReductionOp op);
 D3D12_TEXTURE_ADDRESS_MODE translateAddressingMode(TextureAddressingMode mode);
 D3D12_COMPARISON_FUNC translateComparisonFunc(ComparisonFunc func);
+D3D12_COMMAND_LIST_TYPE translateCommandListType(ICommandQueue::QueueType type);
 
 uint32_t getViewDescriptorCount(const ITransientResourceHeap::Desc& desc);
 void initSrvDesc(
@@ -6,6 +6,7 @@
 #endif
 
 #include "../nvapi/nvapi-util.h"
+#include "core/slang-crypto.h"
 #include "d3d12-device.h"
 #include "d3d12-framebuffer.h"
 #include "d3d12-pipeline-state-stream.h"
@@ -21,6 +22,107 @@ namespace d3d12
 
 using namespace Slang;
 
+// The pipeline library needs a name for each pipeline state that stays the same between runs.
+// The descs point to the shaders, root signature and input layout, so those pointers are cleared
+// before hashing the desc, and the shader code and input elements are hashed instead. The root
+// signature is created from the layout of the program, which the code depends on.
+static OSString _getPipelineLibraryName(
+    ShaderProgramImpl* program,
+    D3D12_GRAPHICS_PIPELINE_STATE_DESC desc)
+{
+    DigestBuilder<SHA1> builder;
+    for (auto& shaderBin : program->m_shaders)
+    {
+        builder.append(shaderBin.stage);
+        builder.append(shaderBin.code);
+    }
+    for (UINT i = 0; i < desc.InputLayout.NumElements; i++)
+    {
+        auto element = desc.InputLayout.pInputElementDescs[i];
+        builder.append(UnownedStringSlice(element.SemanticName));
+        element.SemanticName = nullptr;
+        builder.append(&element, sizeof(element));
+    }
+    desc.pRootSignature = nullptr;
+    desc.VS = desc.PS = desc.DS = desc.HS = desc.GS = {};
+    desc.StreamOutput = {};
+    desc.InputLayout.pInputElementDescs = nullptr;
+    desc.CachedPSO = {};
+    builder.append(&desc, sizeof(desc));
+    return ("graphics-" + builder.finalize().toString()).toWString();
+}
+
+static OSString _getPipelineLibraryName(
+    ShaderProgramImpl* program,
+    D3D12_COMPUTE_PIPELINE_STATE_DESC desc)
+{
+    DigestBuilder<SHA1> builder;
+    builder.append(program->m_shaders[0].code);
+    desc.pRootSignature = nullptr;
+    desc.CS = {};
+    desc.CachedPSO = {};
+    builder.append(&desc, sizeof(desc));
+    return ("compute-" + builder.finalize().toString()).toWString();
+}
+
+static HRESULT _createPipelineState(
+    ID3D12Device* device,
+    const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc,
+    ID3D12PipelineState** outState)
+{
+    return device->CreateGraphicsPipelineState(&desc, IID_PPV_ARGS(outState));
+}
+
+static HRESULT _createPipelineState(
+    ID3D12Device* device,
+    const D3D12_COMPUTE_PIPELINE_STATE_DESC& desc,
+    ID3D12PipelineState** outState)
+{
+    return device->CreateComputePipelineState(&desc, IID_PPV_ARGS(outState));
+}
+
+static HRESULT _loadPipelineState(
+    ID3D12PipelineLibrary* library,
+    LPCWSTR name,
+    const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc,
+    ID3D12PipelineState** outState)
+{
+    return library->LoadGraphicsPipeline(name, &desc, IID_PPV_ARGS(outState));
+}
+
+static HRESULT _loadPipelineState(
+    ID3D12PipelineLibrary* library,
+    LPCWSTR name,
+    const D3D12_COMPUTE_PIPELINE_STATE_DESC& desc,
+    ID3D12PipelineState** outState)
+{
+    return library->LoadComputePipeline(name, &desc, IID_PPV_ARGS(outState));
+}
+
+// Create a pipeline state, or load it from the pipeline library of the device if an earlier run
+// stored it there.
+template<typename TDesc>
+static Result _createPipelineStateWithLibrary(
+    DeviceImpl* device,
+    ShaderProgramImpl* program,
+    const TDesc& desc,
+    ID3D12PipelineState** outState)
+{
+    ComPtr<ID3D12PipelineLibrary> library = device->m_pipelineLibrary;
+    if (!library)
+        return _createPipelineState(device->m_device, desc, outState);
+
+    const auto name = _getPipelineLibraryName(program, desc);
+    if (SUCCEEDED(_loadPipelineState(library, name.begin(), desc, outState)))
+        return SLANG_OK;
+    SLANG_RETURN_ON_FAIL(_createPipelineState(device->m_device, desc, outState));
+
+    // Storing fails if another thread stored the same pipeline state first, which is fine.
+    if (SUCCEEDED(library->StorePipeline(name.begin(), *outState)))
+        device->m_hasNewPipelineLibraryEntries = true;
+    return SLANG_OK;
+}
+
 void PipelineStateImpl::init(const GraphicsPipelineStateDesc& inDesc)
 {
     PipelineStateDesc pipelineDesc;
@@ -290,9 +392,11 @@ Result PipelineStateImpl::ensureAPIPipelineStateCreated()
             }
             else
             {
-                SLANG_RETURN_ON_FAIL(m_device->m_device->CreateGraphicsPipelineState(
-                    &graphicsDesc,
-                    IID_PPV_ARGS(m_pipelineState.writeRef())));
+                SLANG_RETURN_ON_FAIL(_createPipelineStateWithLibrary(
+                    m_device,
+                    programImpl,
+                    graphicsDesc,
+                    m_pipelineState.writeRef()));
             }
         }
     }
@@ -355,12 +459,22 @@ Result PipelineStateImpl::ensureAPIPipelineStateCreated()
                             &computeDesc,
                             (void**)m_pipelineState.writeRef()));
                 }
-                else
+                else if (desc.compute.d3d12RootSignatureOverride)
                 {
+                    // The override isn't identified by the program, so the pipeline state can't
+                    // be named for the pipeline library.
                     SLANG_RETURN_ON_FAIL(m_device->m_device->CreateComputePipelineState(
                         &computeDesc,
                         IID_PPV_ARGS(m_pipelineState.writeRef())));
                 }
+                else
+                {
+                    SLANG_RETURN_ON_FAIL(_createPipelineStateWithLibrary(
+                        m_device,
+                        programImpl,
+                        computeDesc,
+                        m_pipelineState.writeRef()));
+                }
             }
         }
     }
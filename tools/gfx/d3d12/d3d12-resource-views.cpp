@@ -18,6 +18,8 @@ ResourceViewInternalImpl::~ResourceViewInternalImpl()
     {
         m_allocator->free(desc.second);
     }
+    if (m_bindlessHeap)
+        m_bindlessHeap->free(m_bindlessIndex, 1);
 }
 
 SlangResult createD3D12BufferDescriptor(
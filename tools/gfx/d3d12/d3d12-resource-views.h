@@ -25,6 +25,11 @@ public:
 
     RefPtr<D3D12GeneralExpandingDescriptorHeap> m_allocator;
 
+    // The slot of the view in the device's bindless heap, or -1 if the view hasn't been
+    // registered in it.
+    int m_bindlessIndex = -1;
+    RefPtr<D3D12GeneralDescriptorHeap> m_bindlessHeap;
+
     ~ResourceViewInternalImpl();
 
     // Get a d3d12 descriptor from the buffer view with the given buffer element stride.
@@ -917,6 +917,15 @@ D3D12_ROOT_SIGNATURE_DESC1& RootShaderObjectLayoutImpl::RootSignatureDescBuilder
     //
     m_rootSignatureDesc.Flags = D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT;
 
+    // Shaders can only index the descriptor heaps directly, as `getResourceFromDescriptorHeap`
+    // does, when the root signature allows it.
+    //
+    if (m_device->m_bindlessViewHeap)
+    {
+        m_rootSignatureDesc.Flags |= D3D12_ROOT_SIGNATURE_FLAG_CBV_SRV_UAV_HEAP_DIRECTLY_INDEXED |
+                                     D3D12_ROOT_SIGNATURE_FLAG_SAMPLER_HEAP_DIRECTLY_INDEXED;
+    }
+
     return m_rootSignatureDesc;
 }
 
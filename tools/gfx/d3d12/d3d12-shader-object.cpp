@@ -61,6 +61,13 @@ Result ShaderObjectImpl::setData(ShaderOffset const& inOffset, void const* data,
         size = availableSize - offset;
     }
 
+    // Setting data to the value that it already has doesn't require the constant buffer to be
+    // written again, which avoids new uploads for objects that are fully re-set between draws
+    // with only a few fields changing.
+    //
+    if (memcmp(dest + offset, data, size) == 0)
+        return SLANG_OK;
+
     memcpy(dest + offset, data, size);
 
     m_isConstantBufferDirty = true;
@@ -238,13 +245,10 @@ Result ShaderObjectImpl::init(
     return SLANG_OK;
 }
 
-/// Write the uniform/ordinary data of this object into the given `dest` buffer at the given
-/// `offset`
+/// Write the uniform/ordinary data of this object into the given `dest` memory
 
 Result ShaderObjectImpl::_writeOrdinaryData(
-    PipelineCommandEncoder* encoder,
-    BufferResourceImpl* buffer,
-    Offset offset,
+    void* dest,
     Size destSize,
     ShaderObjectLayoutImpl* specializedLayout)
 {
@@ -253,14 +257,7 @@ Result ShaderObjectImpl::_writeOrdinaryData(
 
     SLANG_ASSERT(srcSize <= destSize);
 
-    uploadBufferDataImpl(
-        encoder->m_device,
-        encoder->m_d3dCmdList,
-        encoder->m_transientHeap,
-        buffer,
-        offset,
-        srcSize,
-        src);
+    memcpy(dest, src, srcSize);
 
     // In the case where this object has any sub-objects of
     // existential/interface type, we need to recurse on those objects
@@ -340,9 +337,7 @@ Result ShaderObjectImpl::_writeOrdinaryData(
                 subObjectRangePendingDataOffset + i * subObjectRangePendingDataStride;
 
             subObject->_writeOrdinaryData(
-                encoder,
-                buffer,
-                offset + subObjectOffset,
+                (char*)dest + subObjectOffset,
                 destSize - subObjectOffset,
                 subObjectLayout);
         }
@@ -394,11 +389,15 @@ Result ShaderObjectImpl::_ensureOrdinaryDataBufferCreatedIfNeeded(
     // Once we have computed how large the buffer should be, we can allocate
     // it from the transient resource heap.
     //
+    // The memory is in an upload heap, so we write it directly through a persistent mapping.
+    //
     auto alignedConstantBufferSize = D3DUtil::calcAligned(m_constantBufferSize, 256);
-    SLANG_RETURN_ON_FAIL(encoder->m_commandBuffer->m_transientHeap->allocateConstantBuffer(
+    void* constantBufferData = nullptr;
+    SLANG_RETURN_ON_FAIL(encoder->m_commandBuffer->m_transientHeap->allocateMappedConstantBuffer(
         alignedConstantBufferSize,
         m_constantBufferWeakPtr,
-        m_constantBufferOffset));
+        m_constantBufferOffset,
+        constantBufferData));
 
     // Once the buffer is allocated, we can use `_writeOrdinaryData` to fill it in.
     //
@@ -406,12 +405,8 @@ Result ShaderObjectImpl::_ensureOrdinaryDataBufferCreatedIfNeeded(
     // where this object contains interface/existential-type fields, so we
     // don't need or want to inline it into this call site.
     //
-    SLANG_RETURN_ON_FAIL(_writeOrdinaryData(
-        encoder,
-        static_cast<BufferResourceImpl*>(m_constantBufferWeakPtr),
-        m_constantBufferOffset,
-        m_constantBufferSize,
-        specializedLayout));
+    SLANG_RETURN_ON_FAIL(
+        _writeOrdinaryData(constantBufferData, m_constantBufferSize, specializedLayout));
 
     {
         // We also create and store a descriptor for our root constant buffer
@@ -129,12 +129,9 @@ protected:
         DescriptorHeapReference viewHeap,
         DescriptorHeapReference samplerHeap);
 
-    /// Write the uniform/ordinary data of this object into the given `dest` buffer at the given
-    /// `offset`
+    /// Write the uniform/ordinary data of this object into the given `dest` memory
     Result _writeOrdinaryData(
-        PipelineCommandEncoder* encoder,
-        BufferResourceImpl* buffer,
-        Offset offset,
+        void* dest,
         Size destSize,
         ShaderObjectLayoutImpl* specializedLayout);
 
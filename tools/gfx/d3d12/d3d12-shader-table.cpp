@@ -12,6 +12,31 @@ namespace d3d12
 
 using namespace Slang;
 
+void ShaderTableImpl::writeRecords(
+    uint8_t* dest,
+    uint32_t stride,
+    Index firstRecord,
+    uint32_t recordCount,
+    ID3D12StateObjectProperties* stateObjectProperties)
+{
+    memset(dest, 0, stride * recordCount);
+    for (uint32_t i = 0; i < recordCount; i++)
+    {
+        auto recordPtr = dest + stride * i;
+        auto& name = m_shaderGroupNames[firstRecord + i];
+        if (name.getLength())
+        {
+            void* shaderId = stateObjectProperties->GetShaderIdentifier(name.toWString().begin());
+            memcpy(recordPtr, shaderId, D3D12_SHADER_IDENTIFIER_SIZE_IN_BYTES);
+        }
+        auto& overwrite = m_recordOverwrites[firstRecord + i];
+        if (overwrite.size)
+        {
+            memcpy(recordPtr + overwrite.offset, overwrite.data, overwrite.size);
+        }
+    }
+}
+
 RefPtr<BufferResource> ShaderTableImpl::createDeviceBuffer(
     PipelineStateBase* pipeline,
     TransientResourceHeapBase* transientHeap,
@@ -37,6 +62,7 @@ RefPtr<BufferResource> ShaderTableImpl::createDeviceBuffer(
     bufferDesc.memoryType = gfx::MemoryType::DeviceLocal;
     bufferDesc.defaultState = ResourceState::General;
     bufferDesc.allowedStates.add(ResourceState::NonPixelShaderResource);
+    bufferDesc.allowedStates.add(ResourceState::CopyDestination);
     bufferDesc.type = IResource::Type::Buffer;
     bufferDesc.sizeInBytes = tableSize;
     m_device->createBufferResource(bufferDesc, nullptr, bufferResource.writeRef());
@@ -49,59 +75,44 @@ RefPtr<BufferResource> ShaderTableImpl::createDeviceBuffer(
 
     IBufferResource* stagingBuffer = nullptr;
     Offset stagingBufferOffset = 0;
+    void* stagingPtr = nullptr;
     transientHeapImpl
-        ->allocateStagingBuffer(tableSize, stagingBuffer, stagingBufferOffset, MemoryType::Upload);
+        ->allocateMappedStagingBuffer(tableSize, stagingBuffer, stagingBufferOffset, stagingPtr);
 
     assert(stagingBuffer);
-    void* stagingPtr = nullptr;
-    stagingBuffer->map(nullptr, &stagingPtr);
-
-    auto copyShaderIdInto = [&](void* dest, String& name, const ShaderRecordOverwrite& overwrite)
-    {
-        if (name.getLength())
-        {
-            void* shaderId = stateObjectProperties->GetShaderIdentifier(name.toWString().begin());
-            memcpy(dest, shaderId, D3D12_SHADER_IDENTIFIER_SIZE_IN_BYTES);
-        }
-        if (overwrite.size)
-        {
-            memcpy((uint8_t*)dest + overwrite.offset, overwrite.data, overwrite.size);
-        }
-    };
 
-    uint8_t* stagingBufferPtr = (uint8_t*)stagingPtr + stagingBufferOffset;
+    uint8_t* stagingBufferPtr = (uint8_t*)stagingPtr;
     memset(stagingBufferPtr, 0, tableSize);
 
-    for (uint32_t i = 0; i < m_rayGenShaderCount; i++)
-    {
-        copyShaderIdInto(
-            stagingBufferPtr + m_rayGenTableOffset + kRayGenRecordSize * i,
-            m_shaderGroupNames[i],
-            m_recordOverwrites[i]);
-    }
-    for (uint32_t i = 0; i < m_missShaderCount; i++)
-    {
-        copyShaderIdInto(
-            stagingBufferPtr + m_missTableOffset + D3D12_SHADER_IDENTIFIER_SIZE_IN_BYTES * i,
-            m_shaderGroupNames[m_rayGenShaderCount + i],
-            m_recordOverwrites[m_rayGenShaderCount + i]);
-    }
-    for (uint32_t i = 0; i < m_hitGroupCount; i++)
-    {
-        copyShaderIdInto(
-            stagingBufferPtr + m_hitGroupTableOffset + D3D12_SHADER_IDENTIFIER_SIZE_IN_BYTES * i,
-            m_shaderGroupNames[m_rayGenShaderCount + m_missShaderCount + i],
-            m_recordOverwrites[m_rayGenShaderCount + m_missShaderCount + i]);
-    }
-    for (uint32_t i = 0; i < m_callableShaderCount; i++)
-    {
-        copyShaderIdInto(
-            stagingBufferPtr + m_callableTableOffset + D3D12_SHADER_IDENTIFIER_SIZE_IN_BYTES * i,
-            m_shaderGroupNames[m_rayGenShaderCount + m_missShaderCount + m_hitGroupCount + i],
-            m_recordOverwrites[m_rayGenShaderCount + m_missShaderCount + m_hitGroupCount + i]);
-    }
+    Index firstRecord = 0;
+    writeRecords(
+        stagingBufferPtr + m_rayGenTableOffset,
+        kRayGenRecordSize,
+        firstRecord,
+        m_rayGenShaderCount,
+        stateObjectProperties);
+    firstRecord += m_rayGenShaderCount;
+    writeRecords(
+        stagingBufferPtr + m_missTableOffset,
+        D3D12_SHADER_IDENTIFIER_SIZE_IN_BYTES,
+        firstRecord,
+        m_missShaderCount,
+        stateObjectProperties);
+    firstRecord += m_missShaderCount;
+    writeRecords(
+        stagingBufferPtr + m_hitGroupTableOffset,
+        D3D12_SHADER_IDENTIFIER_SIZE_IN_BYTES,
+        firstRecord,
+        m_hitGroupCount,
+        stateObjectProperties);
+    firstRecord += m_hitGroupCount;
+    writeRecords(
+        stagingBufferPtr + m_callableTableOffset,
+        D3D12_SHADER_IDENTIFIER_SIZE_IN_BYTES,
+        firstRecord,
+        m_callableShaderCount,
+        stateObjectProperties);
 
-    stagingBuffer->unmap(nullptr);
     encoder->copyBuffer(bufferResource, 0, stagingBuffer, stagingBufferOffset, tableSize);
     encoder->bufferBarrier(
         1,
@@ -112,5 +123,55 @@ RefPtr<BufferResource> ShaderTableImpl::createDeviceBuffer(
     return _Move(resultPtr);
 }
 
+Result ShaderTableImpl::updateDeviceBufferHitGroups(
+    PipelineStateBase* pipeline,
+    BufferResource* buffer,
+    uint32_t firstHitGroup,
+    uint32_t hitGroupCount,
+    TransientResourceHeapBase* transientHeap,
+    IResourceCommandEncoder* encoder)
+{
+    auto pipelineImpl = static_cast<RayTracingPipelineStateImpl*>(pipeline);
+    ComPtr<ID3D12StateObjectProperties> stateObjectProperties;
+    SLANG_RETURN_ON_FAIL(
+        pipelineImpl->m_stateObject->QueryInterface(stateObjectProperties.writeRef()));
+
+    Size updateSize = hitGroupCount * D3D12_SHADER_IDENTIFIER_SIZE_IN_BYTES;
+    IBufferResource* stagingBuffer = nullptr;
+    Offset stagingBufferOffset = 0;
+    void* stagingPtr = nullptr;
+    SLANG_RETURN_ON_FAIL(static_cast<TransientResourceHeapImpl*>(transientHeap)
+                             ->allocateMappedStagingBuffer(
+                                 updateSize,
+                                 stagingBuffer,
+                                 stagingBufferOffset,
+                                 stagingPtr));
+    writeRecords(
+        (uint8_t*)stagingPtr,
+        D3D12_SHADER_IDENTIFIER_SIZE_IN_BYTES,
+        m_rayGenShaderCount + m_missShaderCount + firstHitGroup,
+        hitGroupCount,
+        stateObjectProperties);
+
+    IBufferResource* bufferResource = buffer;
+    encoder->bufferBarrier(
+        1,
+        &bufferResource,
+        gfx::ResourceState::NonPixelShaderResource,
+        gfx::ResourceState::CopyDestination);
+    encoder->copyBuffer(
+        bufferResource,
+        m_hitGroupTableOffset + firstHitGroup * D3D12_SHADER_IDENTIFIER_SIZE_IN_BYTES,
+        stagingBuffer,
+        stagingBufferOffset,
+        updateSize);
+    encoder->bufferBarrier(
+        1,
+        &bufferResource,
+        gfx::ResourceState::CopyDestination,
+        gfx::ResourceState::NonPixelShaderResource);
+    return SLANG_OK;
+}
+
 } // namespace d3d12
 } // namespace gfx
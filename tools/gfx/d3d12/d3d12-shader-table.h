@@ -24,6 +24,23 @@ public:
         PipelineStateBase* pipeline,
         TransientResourceHeapBase* transientHeap,
         IResourceCommandEncoder* encoder) override;
+
+    virtual Result updateDeviceBufferHitGroups(
+        PipelineStateBase* pipeline,
+        BufferResource* buffer,
+        uint32_t firstHitGroup,
+        uint32_t hitGroupCount,
+        TransientResourceHeapBase* transientHeap,
+        IResourceCommandEncoder* encoder) override;
+
+private:
+    // Write the records `[firstRecord, firstRecord + recordCount)` of the table to `dest`.
+    void writeRecords(
+        uint8_t* dest,
+        uint32_t stride,
+        Index firstRecord,
+        uint32_t recordCount,
+        ID3D12StateObjectProperties* stateObjectProperties);
 };
 
 } // namespace d3d12
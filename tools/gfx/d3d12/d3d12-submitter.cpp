@@ -10,20 +10,70 @@ namespace d3d12
 
 using namespace Slang;
 
+void SubmitterState::reset()
+{
+    rootSignature = nullptr;
+    pipelineState = nullptr;
+    rootArguments.clear();
+}
+
+bool SubmitterState::updateRootArgument(int index, UINT64 value)
+{
+    if (index < rootArguments.getCount() && rootArguments[index] == value)
+    {
+        stats->descriptorBindCount++;
+        return false;
+    }
+    while (rootArguments.getCount() <= index)
+        rootArguments.add(0);
+    rootArguments[index] = value;
+    return true;
+}
+
+bool SubmitterState::updateRootSignature(ID3D12RootSignature* newRootSignature)
+{
+    if (rootSignature == newRootSignature)
+    {
+        stats->descriptorBindCount++;
+        return false;
+    }
+    // Setting a different root signature resets all root arguments.
+    rootSignature = newRootSignature;
+    rootArguments.clear();
+    return true;
+}
+
+bool SubmitterState::updatePipelineState(ID3D12PipelineState* newPipelineState)
+{
+    if (pipelineState == newPipelineState)
+    {
+        stats->pipelineBindCount++;
+        return false;
+    }
+    pipelineState = newPipelineState;
+    return true;
+}
+
 void GraphicsSubmitter::setRootConstantBufferView(
     int index,
     D3D12_GPU_VIRTUAL_ADDRESS gpuBufferLocation)
 {
+    if (m_state && !m_state->updateRootArgument(index, gpuBufferLocation))
+        return;
     m_commandList->SetGraphicsRootConstantBufferView(index, gpuBufferLocation);
 }
 
 void GraphicsSubmitter::setRootUAV(int index, D3D12_GPU_VIRTUAL_ADDRESS gpuBufferLocation)
 {
+    if (m_state && !m_state->updateRootArgument(index, gpuBufferLocation))
+        return;
     m_commandList->SetGraphicsRootUnorderedAccessView(index, gpuBufferLocation);
 }
 
 void GraphicsSubmitter::setRootSRV(int index, D3D12_GPU_VIRTUAL_ADDRESS gpuBufferLocation)
 {
+    if (m_state && !m_state->updateRootArgument(index, gpuBufferLocation))
+        return;
     m_commandList->SetGraphicsRootShaderResourceView(index, gpuBufferLocation);
 }
 
@@ -31,11 +81,15 @@ void GraphicsSubmitter::setRootDescriptorTable(
     int index,
     D3D12_GPU_DESCRIPTOR_HANDLE baseDescriptor)
 {
+    if (m_state && !m_state->updateRootArgument(index, baseDescriptor.ptr))
+        return;
     m_commandList->SetGraphicsRootDescriptorTable(index, baseDescriptor);
 }
 
 void GraphicsSubmitter::setRootSignature(ID3D12RootSignature* rootSignature)
 {
+    if (m_state && !m_state->updateRootSignature(rootSignature))
+        return;
     m_commandList->SetGraphicsRootSignature(rootSignature);
 }
 
@@ -55,6 +109,8 @@ void GraphicsSubmitter::setRootConstants(
 void GraphicsSubmitter::setPipelineState(PipelineStateBase* pipeline)
 {
     auto pipelineImpl = static_cast<PipelineStateImpl*>(pipeline);
+    if (m_state && !m_state->updatePipelineState(pipelineImpl->m_pipelineState.get()))
+        return;
     m_commandList->SetPipelineState(pipelineImpl->m_pipelineState.get());
 }
 
@@ -62,26 +118,36 @@ void ComputeSubmitter::setRootConstantBufferView(
     int index,
     D3D12_GPU_VIRTUAL_ADDRESS gpuBufferLocation)
 {
+    if (m_state && !m_state->updateRootArgument(index, gpuBufferLocation))
+        return;
     m_commandList->SetComputeRootConstantBufferView(index, gpuBufferLocation);
 }
 
 void ComputeSubmitter::setRootUAV(int index, D3D12_GPU_VIRTUAL_ADDRESS gpuBufferLocation)
 {
+    if (m_state && !m_state->updateRootArgument(index, gpuBufferLocation))
+        return;
     m_commandList->SetComputeRootUnorderedAccessView(index, gpuBufferLocation);
 }
 
 void ComputeSubmitter::setRootSRV(int index, D3D12_GPU_VIRTUAL_ADDRESS gpuBufferLocation)
 {
+    if (m_state && !m_state->updateRootArgument(index, gpuBufferLocation))
+        return;
     m_commandList->SetComputeRootShaderResourceView(index, gpuBufferLocation);
 }
 
 void ComputeSubmitter::setRootDescriptorTable(int index, D3D12_GPU_DESCRIPTOR_HANDLE baseDescriptor)
 {
+    if (m_state && !m_state->updateRootArgument(index, baseDescriptor.ptr))
+        return;
     m_commandList->SetComputeRootDescriptorTable(index, baseDescriptor);
 }
 
 void ComputeSubmitter::setRootSignature(ID3D12RootSignature* rootSignature)
 {
+    if (m_state && !m_state->updateRootSignature(rootSignature))
+        return;
     m_commandList->SetComputeRootSignature(rootSignature);
 }
 
@@ -101,6 +167,8 @@ void ComputeSubmitter::setRootConstants(
 void ComputeSubmitter::setPipelineState(PipelineStateBase* pipeline)
 {
     auto pipelineImpl = static_cast<PipelineStateImpl*>(pipeline);
+    if (m_state && !m_state->updatePipelineState(pipelineImpl->m_pipelineState.get()))
+        return;
     m_commandList->SetPipelineState(pipelineImpl->m_pipelineState.get());
 }
 
@@ -10,6 +10,28 @@ namespace d3d12
 
 using namespace Slang;
 
+// The root signature, pipeline state and root arguments that a command encoder last set through
+// its submitters, so that setting the same values again can be skipped. The skipped calls are
+// counted in `stats`.
+struct SubmitterState
+{
+    ID3D12RootSignature* rootSignature = nullptr;
+    ID3D12PipelineState* pipelineState = nullptr;
+    // The descriptor table or buffer address set for each root parameter, or 0 if unknown.
+    List<UINT64> rootArguments;
+    RedundantStateStats* stats = nullptr;
+
+    void reset();
+
+    // Invalidate the root arguments, which must be set again after the descriptor heaps change.
+    void resetRootArguments() { rootArguments.clear(); }
+
+    // Returns false if `value` is already set for the root parameter at `index`.
+    bool updateRootArgument(int index, UINT64 value);
+    bool updateRootSignature(ID3D12RootSignature* newRootSignature);
+    bool updatePipelineState(ID3D12PipelineState* newPipelineState);
+};
+
 struct Submitter
 {
     virtual void setRootConstantBufferView(
@@ -43,12 +65,13 @@ struct GraphicsSubmitter : public Submitter
         void const* srcData) override;
     virtual void setPipelineState(PipelineStateBase* pipeline) override;
 
-    GraphicsSubmitter(ID3D12GraphicsCommandList* commandList)
-        : m_commandList(commandList)
+    GraphicsSubmitter(ID3D12GraphicsCommandList* commandList, SubmitterState* state = nullptr)
+        : m_commandList(commandList), m_state(state)
     {
     }
 
     ID3D12GraphicsCommandList* m_commandList;
+    SubmitterState* m_state;
 };
 
 struct ComputeSubmitter : public Submitter
@@ -66,12 +89,13 @@ struct ComputeSubmitter : public Submitter
         Index countOf32BitValues,
         void const* srcData) override;
     virtual void setPipelineState(PipelineStateBase* pipeline) override;
-    ComputeSubmitter(ID3D12GraphicsCommandList* commandList)
-        : m_commandList(commandList)
+    ComputeSubmitter(ID3D12GraphicsCommandList* commandList, SubmitterState* state = nullptr)
+        : m_commandList(commandList), m_state(state)
     {
     }
 
     ID3D12GraphicsCommandList* m_commandList;
+    SubmitterState* m_state;
 };
 
 } // namespace d3d12
@@ -4,6 +4,7 @@
 #include "d3d12-buffer.h"
 #include "d3d12-command-buffer.h"
 #include "d3d12-device.h"
+#include "d3d12-helper-functions.h"
 
 namespace gfx
 {
@@ -106,7 +107,7 @@ Result TransientResourceHeapImpl::allocateTransientDescriptorTable(
     {
         return SLANG_E_OUT_OF_MEMORY;
     }
-    outDescriptorOffset = (Offset)allocResult;
+    outDescriptorOffset = (Offset)(heap.getStartIndex() + allocResult);
     *outD3DDescriptorHeapHandle = heap.getHeap();
     return SLANG_OK;
 }
@@ -116,6 +117,11 @@ TransientResourceHeapImpl::~TransientResourceHeapImpl()
     synchronize();
     for (auto& waitInfo : m_waitInfos)
         CloseHandle(waitInfo.fenceEvent);
+    if (m_bindlessViewHeap)
+    {
+        for (auto& viewHeap : m_viewHeaps)
+            m_bindlessViewHeap->free(viewHeap.getStartIndex(), viewHeap.getTotalSize());
+    }
 }
 
 Result TransientResourceHeapImpl::init(
@@ -128,6 +134,7 @@ Result TransientResourceHeapImpl::init(
     m_canResize = (desc.flags & ITransientResourceHeap::Flags::AllowResizing) != 0;
     m_viewHeapSize = viewHeapSize;
     m_samplerHeapSize = samplerHeapSize;
+    m_bindlessViewHeap = device->m_bindlessViewHeap;
 
     m_stagingCpuViewHeap.init(
         device->m_device,
@@ -141,12 +148,13 @@ Result TransientResourceHeapImpl::init(
         D3D12_DESCRIPTOR_HEAP_FLAG_NONE);
 
     auto d3dDevice = device->m_device;
+    m_commandListType = translateCommandListType(desc.queueType);
     SLANG_RETURN_ON_FAIL(d3dDevice->CreateCommandAllocator(
-        D3D12_COMMAND_LIST_TYPE_DIRECT,
+        m_commandListType,
         IID_PPV_ARGS(m_commandAllocator.writeRef())));
 
-    allocateNewViewDescriptorHeap(device);
-    allocateNewSamplerDescriptorHeap(device);
+    SLANG_RETURN_ON_FAIL(allocateNewViewDescriptorHeap(device));
+    SLANG_RETURN_ON_FAIL(allocateNewSamplerDescriptorHeap(device));
 
     return SLANG_OK;
 }
@@ -162,11 +170,25 @@ Result TransientResourceHeapImpl::allocateNewViewDescriptorHeap(DeviceImpl* devi
     }
     auto d3dDevice = device->m_device;
     D3D12DescriptorHeap viewHeap;
-    SLANG_RETURN_ON_FAIL(viewHeap.init(
-        d3dDevice,
-        m_viewHeapSize,
-        D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV,
-        D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE));
+    if (m_bindlessViewHeap)
+    {
+        // All command lists must bind the heap that holds the bindless resources, so the
+        // descriptor tables are allocated from a range of that heap instead of a heap of
+        // their own.
+        int startIndex = m_bindlessViewHeap->allocate((int)m_viewHeapSize);
+        if (startIndex < 0)
+            return SLANG_E_OUT_OF_MEMORY;
+        SLANG_RETURN_ON_FAIL(
+            viewHeap.initAsRange(m_bindlessViewHeap->getHeap(), startIndex, m_viewHeapSize));
+    }
+    else
+    {
+        SLANG_RETURN_ON_FAIL(viewHeap.init(
+            d3dDevice,
+            m_viewHeapSize,
+            D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV,
+            D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE));
+    }
     m_currentViewHeapIndex = (int32_t)m_viewHeaps.getCount();
     m_viewHeaps.add(_Move(viewHeap));
     return SLANG_OK;
@@ -208,7 +230,7 @@ Result TransientResourceHeapImpl::createCommandBuffer(ICommandBuffer** outCmdBuf
     ComPtr<ID3D12GraphicsCommandList> cmdList;
     SLANG_RETURN_ON_FAIL(m_device->m_device->CreateCommandList(
         0,
-        D3D12_COMMAND_LIST_TYPE_DIRECT,
+        m_commandListType,
         m_commandAllocator,
         nullptr,
         IID_PPV_ARGS(cmdList.writeRef())));
@@ -22,6 +22,8 @@ public:
     List<ComPtr<ID3D12GraphicsCommandList>> m_d3dCommandListPool;
     List<RefPtr<RefObject>> m_commandBufferPool;
     uint32_t m_commandListAllocId = 0;
+    // The type of the queues that the command lists are submitted to.
+    D3D12_COMMAND_LIST_TYPE m_commandListType = D3D12_COMMAND_LIST_TYPE_DIRECT;
     // Wait values for each command queue.
     struct QueueWaitInfo
     {
@@ -48,6 +50,10 @@ public:
     uint32_t m_viewHeapSize;
     uint32_t m_samplerHeapSize;
 
+    // The device's bindless heap that `m_viewHeaps` are ranges of, if bindless resources
+    // are enabled.
+    RefPtr<D3D12GeneralDescriptorHeap> m_bindlessViewHeap;
+
     D3D12DescriptorHeap& getCurrentViewHeap();
     D3D12DescriptorHeap& getCurrentSamplerHeap();
 
@@ -685,6 +685,24 @@ Result DebugDevice::getTextureRowAlignment(size_t* outAlignment)
     return baseObject->getTextureRowAlignment(outAlignment);
 }
 
+Result DebugDevice::getBindlessResourceIndex(IResourceView* view, uint32_t* outIndex)
+{
+    SLANG_GFX_API_FUNC;
+    return baseObject->getBindlessResourceIndex(getInnerObj(view), outIndex);
+}
+
+Result DebugDevice::getRedundantStateStats(RedundantStateStats* outStats)
+{
+    SLANG_GFX_API_FUNC;
+    return baseObject->getRedundantStateStats(outStats);
+}
+
+Result DebugDevice::resetRedundantStateStats()
+{
+    SLANG_GFX_API_FUNC;
+    return baseObject->resetRedundantStateStats();
+}
+
 Result DebugDevice::createShaderTable(const IShaderTable::Desc& desc, IShaderTable** outTable)
 {
     SLANG_GFX_API_FUNC;
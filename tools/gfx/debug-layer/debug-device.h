@@ -162,6 +162,11 @@ public:
         size_t* outAlignment) override;
     virtual SLANG_NO_THROW Result SLANG_MCALL getTextureRowAlignment(size_t* outAlignment) override;
     virtual SLANG_NO_THROW Result SLANG_MCALL
+    getBindlessResourceIndex(IResourceView* view, uint32_t* outIndex) override;
+    virtual SLANG_NO_THROW Result SLANG_MCALL
+    getRedundantStateStats(RedundantStateStats* outStats) override;
+    virtual SLANG_NO_THROW Result SLANG_MCALL resetRedundantStateStats() override;
+    virtual SLANG_NO_THROW Result SLANG_MCALL
     createShaderTable(const IShaderTable::Desc& desc, IShaderTable** outTable) override;
 };
 
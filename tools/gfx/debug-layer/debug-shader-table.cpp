@@ -0,0 +1,28 @@
+// debug-shader-table.cpp
+#include "debug-shader-table.h"
+
+#include "debug-helper-functions.h"
+
+namespace gfx
+{
+using namespace Slang;
+
+namespace debug
+{
+
+Result DebugShaderTable::setHitGroup(
+    GfxIndex index,
+    const char* hitGroupName,
+    const ShaderRecordOverwrite* recordOverwrite)
+{
+    SLANG_GFX_API_FUNC;
+    if (!hitGroupName)
+    {
+        GFX_DIAGNOSE_ERROR("IShaderTable::setHitGroup: hitGroupName must not be null.");
+        return SLANG_E_INVALID_ARG;
+    }
+    return baseObject->setHitGroup(index, hitGroupName, recordOverwrite);
+}
+
+} // namespace debug
+} // namespace gfx
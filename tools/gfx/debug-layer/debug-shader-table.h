@@ -14,6 +14,10 @@ class DebugShaderTable : public DebugObject<IShaderTable>
 public:
     SLANG_COM_OBJECT_IUNKNOWN_ALL;
     IShaderTable* getInterface(const Slang::Guid& guid);
+    virtual SLANG_NO_THROW Result SLANG_MCALL setHitGroup(
+        GfxIndex index,
+        const char* hitGroupName,
+        const ShaderRecordOverwrite* recordOverwrite) override;
 };
 
 } // namespace debug
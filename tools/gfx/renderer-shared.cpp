@@ -3,6 +3,7 @@
 #include "../../source/core/slang-file-system.h"
 #include "../../source/core/slang-stable-hash.h"
 #include "core/slang-io.h"
+#include "core/slang-process.h"
 #include "core/slang-token-reader.h"
 #include "mutable-shader-object.h"
 #include "slang.h"
@@ -359,6 +360,9 @@ void PipelineStateBase::initializeBase(const PipelineStateDesc& inDesc)
     }
 }
 
+// True on the threads that pipelines are specialized on in the background.
+static thread_local bool t_isPipelineSpecializationWorker = false;
+
 Result RendererBase::getEntryPointCodeFromShaderCache(
     slang::IComponentType* program,
     SlangInt entryPointIndex,
@@ -367,7 +371,8 @@ Result RendererBase::getEntryPointCodeFromShaderCache(
     slang::IBlob** outDiagnostics)
 {
     // Immediately call getEntryPointCode if no shader cache has been initialized
-    if (!persistentShaderCache)
+    bool isSpecializingInBackground = m_specializationWorkers.size() != 0;
+    if (!persistentShaderCache && !isSpecializingInBackground)
     {
         return program->getEntryPointCode(entryPointIndex, targetIndex, outCode, outDiagnostics);
     }
@@ -378,9 +383,19 @@ Result RendererBase::getEntryPointCodeFromShaderCache(
     program->getEntryPointHash(entryPointIndex, targetIndex, hashBlob.writeRef());
     PersistentCache::Key cacheKey(hashBlob);
 
-    // Query the shader cache.
+    // Use the code that a worker thread generated for the program, if there is any.
     ComPtr<ISlangBlob> codeBlob;
-    if (persistentShaderCache->readEntry(cacheKey, codeBlob.writeRef()) != SLANG_OK)
+    if (isSpecializingInBackground && !t_isPipelineSpecializationWorker)
+    {
+        std::lock_guard<std::mutex> lock(m_backgroundEntryPointCodeMutex);
+        if (m_backgroundEntryPointCode.tryGetValue(cacheKey, codeBlob))
+            m_backgroundEntryPointCode.remove(cacheKey);
+    }
+
+    // Query the shader cache.
+    if (!codeBlob &&
+        (!persistentShaderCache ||
+         persistentShaderCache->readEntry(cacheKey, codeBlob.writeRef()) != SLANG_OK))
     {
         // No cached entry found. Generate the code and add it to the cache.
         SLANG_RETURN_ON_FAIL(program->getEntryPointCode(
@@ -388,13 +403,27 @@ Result RendererBase::getEntryPointCodeFromShaderCache(
             targetIndex,
             codeBlob.writeRef(),
             outDiagnostics));
-        persistentShaderCache->writeEntry(cacheKey, codeBlob);
+        if (persistentShaderCache)
+            persistentShaderCache->writeEntry(cacheKey, codeBlob);
+    }
+
+    // Keep the code that a worker thread generated until the program it was generated for is
+    // created on the thread that records commands.
+    if (t_isPipelineSpecializationWorker)
+    {
+        std::lock_guard<std::mutex> lock(m_backgroundEntryPointCodeMutex);
+        m_backgroundEntryPointCode[cacheKey] = codeBlob;
     }
 
     *outCode = codeBlob.detach();
     return SLANG_OK;
 }
 
+RendererBase::~RendererBase()
+{
+    _stopPipelineSpecializationWorkers();
+}
+
 SlangResult RendererBase::queryInterface(SlangUUID const& uuid, void** outObject)
 {
     // Only return the shader cache interface if it is enabled.
@@ -442,6 +471,25 @@ SLANG_NO_THROW Result SLANG_MCALL RendererBase::initialize(const Desc& desc)
                 (void**)m_pipelineCreationAPIDispatcher.writeRef());
         }
     }
+
+    for (GfxIndex i = 0; i < desc.extendedDescCount; i++)
+    {
+        StructType stype;
+        memcpy(&stype, desc.extendedDescs[i], sizeof(stype));
+        if (stype == StructType::AsyncPipelineSpecializationDesc &&
+            supportsAsyncPipelineSpecialization())
+        {
+            auto asyncDesc = (AsyncPipelineSpecializationDesc*)desc.extendedDescs[i];
+            uint32_t workerCount = asyncDesc->workerThreadCount;
+            if (workerCount == 0)
+                workerCount = Math::Max(1u, std::thread::hardware_concurrency());
+            for (uint32_t w = 0; w < workerCount; w++)
+            {
+                m_specializationWorkers.emplace_back([this]()
+                                                     { _runPipelineSpecializationWorker(); });
+            }
+        }
+    }
     return SLANG_OK;
 }
 
@@ -770,6 +818,40 @@ Result RendererBase::getTextureRowAlignment(Size* outAlignment)
     return SLANG_E_NOT_AVAILABLE;
 }
 
+Result RendererBase::getBindlessResourceIndex(IResourceView* view, uint32_t* outIndex)
+{
+    SLANG_UNUSED(view);
+    *outIndex = 0;
+    return SLANG_E_NOT_AVAILABLE;
+}
+
+Result RendererBase::getRedundantStateStats(RedundantStateStats* outStats)
+{
+    if (!outStats)
+        return SLANG_E_INVALID_ARG;
+    std::lock_guard<std::mutex> lock(m_redundantStateStatsMutex);
+    *outStats = m_redundantStateStats;
+    return SLANG_OK;
+}
+
+Result RendererBase::resetRedundantStateStats()
+{
+    std::lock_guard<std::mutex> lock(m_redundantStateStatsMutex);
+    m_redundantStateStats = {};
+    return SLANG_OK;
+}
+
+void RendererBase::addRedundantStateStats(const RedundantStateStats& stats)
+{
+    std::lock_guard<std::mutex> lock(m_redundantStateStatsMutex);
+    m_redundantStateStats.pipelineBindCount += stats.pipelineBindCount;
+    m_redundantStateStats.descriptorBindCount += stats.descriptorBindCount;
+    m_redundantStateStats.vertexBufferBindCount += stats.vertexBufferBindCount;
+    m_redundantStateStats.indexBufferBindCount += stats.indexBufferBindCount;
+    m_redundantStateStats.viewportCount += stats.viewportCount;
+    m_redundantStateStats.scissorRectCount += stats.scissorRectCount;
+}
+
 Result RendererBase::getShaderObjectLayout(
     slang::ISession* session,
     slang::TypeReflection* type,
@@ -799,6 +881,7 @@ Result RendererBase::getShaderObjectLayout(
     slang::TypeLayoutReflection* typeLayout,
     ShaderObjectLayoutBase** outLayout)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_shaderObjectLayoutCacheMutex);
     RefPtr<ShaderObjectLayoutBase> shaderObjectLayout;
     if (!m_shaderObjectLayoutCache.tryGetValue(typeLayout, shaderObjectLayout))
     {
@@ -810,6 +893,21 @@ Result RendererBase::getShaderObjectLayout(
     return SLANG_OK;
 }
 
+void RendererBase::writePipelineCacheFile(const String& fileName, const void* data, Size size)
+{
+    StringBuilder tempFileName;
+    tempFileName << fileName << "." << Process::getId() << ".tmp";
+    if (SLANG_FAILED(File::writeAllBytes(tempFileName, data, size)))
+        return;
+    if (::rename(tempFileName.getBuffer(), fileName.getBuffer()) != 0)
+    {
+        // Renaming over an existing file fails on Windows.
+        File::remove(fileName);
+        if (::rename(tempFileName.getBuffer(), fileName.getBuffer()) != 0)
+            File::remove(tempFileName);
+    }
+}
+
 Result RendererBase::clearShaderCache()
 {
     SLANG_ASSERT(persistentShaderCache);
@@ -887,9 +985,17 @@ ShaderComponentID ShaderCache::getComponentId(UnownedStringSlice name)
     return getComponentId(key);
 }
 
-ShaderComponentID ShaderCache::getComponentId(ComponentKey key)
+ShaderComponentID ShaderCache::getComponentId(const ComponentKey& key)
 {
     ShaderComponentID componentId = 0;
+    {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        if (componentIds.tryGetValue(key, componentId))
+            return componentId;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    // Another thread may have added the component since the lookup above.
     if (componentIds.tryGetValue(key, componentId))
         return componentId;
     OwningComponentKey owningTypeKey;
@@ -901,11 +1007,15 @@ ShaderComponentID ShaderCache::getComponentId(ComponentKey key)
     return resultId;
 }
 
-void ShaderCache::addSpecializedPipeline(
-    PipelineKey key,
-    Slang::RefPtr<PipelineStateBase> specializedPipeline)
+PipelineStateBase* ShaderCache::addSpecializedPipeline(
+    const PipelineKey& key,
+    PipelineStateBase* specializedPipeline)
 {
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    if (auto existingPipeline = specializedPipelines.tryGetValue(key))
+        return *existingPipeline;
     specializedPipelines[key] = specializedPipeline;
+    return specializedPipeline;
 }
 
 void ShaderObjectLayoutBase::initBase(
@@ -1187,6 +1297,215 @@ bool ShaderProgramBase::isMeshShaderProgram() const
     return false;
 }
 
+Result RendererBase::_specializeProgram(
+    slang::IComponentType* linkedProgram,
+    const slang::SpecializationArg* args,
+    Index argCount,
+    ComPtr<slang::IComponentType>& outSpecializedComponentType)
+{
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto compileRs = linkedProgram->specialize(
+        args,
+        argCount,
+        outSpecializedComponentType.writeRef(),
+        diagnosticBlob.writeRef());
+    if (diagnosticBlob)
+    {
+        getDebugCallback()->handleMessage(
+            compileRs == SLANG_OK ? DebugMessageType::Warning : DebugMessageType::Error,
+            DebugMessageSource::Slang,
+            (char*)diagnosticBlob->getBufferPointer());
+    }
+    return compileRs;
+}
+
+static IShaderProgram::Desc _getSpecializedProgramDesc(
+    const IShaderProgram::Desc& unspecializedProgramDesc,
+    slang::IComponentType* specializedComponentType)
+{
+    IShaderProgram::Desc specializedProgramDesc = unspecializedProgramDesc;
+    specializedProgramDesc.slangGlobalScope = specializedComponentType;
+
+    if (specializedProgramDesc.linkingStyle == IShaderProgram::LinkingStyle::SingleProgram)
+    {
+        // When linking style is GraphicsCompute, the specialized global scope already
+        // contains entry-points, so we do not need to supply them again when creating the
+        // specialized pipeline.
+        specializedProgramDesc.entryPointCount = 0;
+    }
+    return specializedProgramDesc;
+}
+
+Result RendererBase::_createSpecializedPipeline(
+    PipelineStateBase* unspecializedPipeline,
+    ShaderProgramBase* unspecializedProgram,
+    slang::IComponentType* specializedComponentType,
+    RefPtr<PipelineStateBase>& outSpecializedPipeline)
+{
+    // Now create the specialized shader program using compiled binaries.
+    ComPtr<IShaderProgram> specializedProgram;
+    SLANG_RETURN_ON_FAIL(createProgram(
+        _getSpecializedProgramDesc(unspecializedProgram->desc, specializedComponentType),
+        specializedProgram.writeRef()));
+
+    // Create specialized pipeline state.
+    ComPtr<IPipelineState> specializedPipelineComPtr;
+    switch (unspecializedPipeline->desc.type)
+    {
+    case PipelineType::Compute:
+        {
+            auto pipelineDesc = unspecializedPipeline->desc.compute;
+            pipelineDesc.program = specializedProgram;
+            SLANG_RETURN_ON_FAIL(
+                createComputePipelineState(pipelineDesc, specializedPipelineComPtr.writeRef()));
+            break;
+        }
+    case PipelineType::Graphics:
+        {
+            auto pipelineDesc = unspecializedPipeline->desc.graphics;
+            pipelineDesc.program = static_cast<ShaderProgramBase*>(specializedProgram.get());
+            SLANG_RETURN_ON_FAIL(
+                createGraphicsPipelineState(pipelineDesc, specializedPipelineComPtr.writeRef()));
+            break;
+        }
+    case PipelineType::RayTracing:
+        {
+            auto pipelineDesc = unspecializedPipeline->desc.rayTracing;
+            pipelineDesc.program = static_cast<ShaderProgramBase*>(specializedProgram.get());
+            SLANG_RETURN_ON_FAIL(createRayTracingPipelineState(
+                pipelineDesc.get(),
+                specializedPipelineComPtr.writeRef()));
+            break;
+        }
+    default:
+        break;
+    }
+    outSpecializedPipeline = static_cast<PipelineStateBase*>(specializedPipelineComPtr.get());
+    outSpecializedPipeline->unspecializedPipelineState = unspecializedPipeline;
+    return SLANG_OK;
+}
+
+void RendererBase::_runPipelineSpecializationJob(PipelineSpecializationJob* job)
+{
+    job->result = _specializeProgram(
+        job->linkedProgram,
+        job->specializationArgs.getBuffer(),
+        job->specializationArgs.getCount(),
+        job->specializedComponentType);
+    if (SLANG_SUCCEEDED(job->result))
+    {
+        // Generate the code of the entry points the same way the specialized program will, so
+        // that `getEntryPointCodeFromShaderCache` finds it when the program is created.
+        RefPtr<ShaderProgramBase> program = new ShaderProgramBase();
+        program->init(_getSpecializedProgramDesc(job->programDesc, job->specializedComponentType));
+        job->result = program->compileShaders(this);
+    }
+    job->isDone = true;
+}
+
+void RendererBase::_runPipelineSpecializationWorker()
+{
+    t_isPipelineSpecializationWorker = true;
+    for (;;)
+    {
+        PipelineSpecializationJob* job = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(m_specializationQueueMutex);
+            m_specializationQueueCondition.wait(
+                lock,
+                [this]()
+                { return m_isStoppingSpecializationWorkers || m_specializationQueue.getCount(); });
+            if (m_isStoppingSpecializationWorkers)
+                return;
+            job = m_specializationQueue[0];
+            m_specializationQueue.removeAt(0);
+        }
+        _runPipelineSpecializationJob(job);
+    }
+}
+
+void RendererBase::_stopPipelineSpecializationWorkers()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_specializationQueueMutex);
+        m_isStoppingSpecializationWorkers = true;
+    }
+    m_specializationQueueCondition.notify_all();
+    for (auto& worker : m_specializationWorkers)
+        worker.join();
+    m_specializationWorkers.clear();
+}
+
+Result RendererBase::_specializePipeline(
+    PipelineStateBase* unspecializedPipeline,
+    const PipelineKey& pipelineKey,
+    const ExtendedShaderObjectTypeList& specializationArgs,
+    PipelineStateBase*& outSpecializedPipeline)
+{
+    auto unspecializedProgram = static_cast<ShaderProgramBase*>(
+        unspecializedPipeline->desc.type == PipelineType::Compute
+            ? unspecializedPipeline->desc.compute.program
+            : unspecializedPipeline->desc.graphics.program);
+
+    ComPtr<slang::IComponentType> specializedComponentType;
+    if (m_specializationWorkers.size())
+    {
+        // Specialize the program and generate its code on a worker thread, and skip the
+        // draws and dispatches that need it until it is ready.
+        std::unique_lock<std::mutex> lock(m_specializationQueueMutex);
+        PipelineSpecializationJob* job = nullptr;
+        if (auto pendingJob = m_pendingSpecializations.tryGetValue(pipelineKey))
+        {
+            job = *pendingJob;
+        }
+        else
+        {
+            job = new PipelineSpecializationJob();
+            job->linkedProgram = unspecializedProgram->linkedProgram;
+            for (auto& entryPoint : unspecializedProgram->slangEntryPoints)
+            {
+                job->slangEntryPoints.add(entryPoint);
+                job->slangEntryPointPtrs.add(entryPoint);
+            }
+            job->programDesc = unspecializedProgram->desc;
+            job->programDesc.slangEntryPoints = job->slangEntryPointPtrs.getBuffer();
+            job->specializationArgs.addRange(
+                specializationArgs.components.getArrayView().getBuffer(),
+                specializationArgs.getCount());
+            m_pendingSpecializations.add(pipelineKey, job);
+            m_specializationQueue.add(job);
+            m_specializationQueueCondition.notify_one();
+        }
+        if (!job->isDone)
+            return SLANG_E_PENDING;
+
+        Result result = job->result;
+        specializedComponentType = job->specializedComponentType;
+        m_pendingSpecializations.remove(pipelineKey);
+        SLANG_RETURN_ON_FAIL(result);
+    }
+    else
+    {
+        SLANG_RETURN_ON_FAIL(_specializeProgram(
+            unspecializedProgram->linkedProgram,
+            specializationArgs.components.getArrayView().getBuffer(),
+            specializationArgs.getCount(),
+            specializedComponentType));
+    }
+
+    RefPtr<PipelineStateBase> newPipelineState;
+    SLANG_RETURN_ON_FAIL(_createSpecializedPipeline(
+        unspecializedPipeline,
+        unspecializedProgram,
+        specializedComponentType,
+        newPipelineState));
+    // Use the pipeline of another thread that specialized the same pipeline first.
+    outSpecializedPipeline = shaderCache.addSpecializedPipeline(pipelineKey, newPipelineState);
+    if (outSpecializedPipeline == newPipelineState)
+        _recordPipelineSpecialization(unspecializedPipeline, specializationArgs);
+    return SLANG_OK;
+}
+
 Result RendererBase::maybeSpecializePipeline(
     PipelineStateBase* currentPipeline,
     ShaderObjectBase* rootObject,
@@ -1194,14 +1513,15 @@ Result RendererBase::maybeSpecializePipeline(
 {
     outNewPipeline = static_cast<PipelineStateBase*>(currentPipeline);
 
-    auto pipelineType = currentPipeline->desc.type;
     if (currentPipeline->unspecializedPipelineState)
         currentPipeline = currentPipeline->unspecializedPipelineState;
     // If the currently bound pipeline is specializable, we need to specialize it based on bound
     // shader objects.
     if (currentPipeline->isSpecializable)
     {
-        specializationArgs.clear();
+        // The argument lists are short lists, so that collecting the arguments and looking up
+        // the pipeline don't allocate.
+        ExtendedShaderObjectTypeList specializationArgs;
         SLANG_RETURN_ON_FAIL(rootObject->collectSpecializationArgs(specializationArgs));
 
         // Construct a shader cache key that represents the specialized shader kernels.
@@ -1210,92 +1530,139 @@ Result RendererBase::maybeSpecializePipeline(
         pipelineKey.specializationArgs.addRange(specializationArgs.componentIDs);
         pipelineKey.updateHash();
 
-        RefPtr<PipelineStateBase> specializedPipelineState =
+        PipelineStateBase* specializedPipelineState =
             shaderCache.getSpecializedPipelineState(pipelineKey);
         // Try to find specialized pipeline from shader cache.
         if (!specializedPipelineState)
         {
-            auto unspecializedProgram = static_cast<ShaderProgramBase*>(
-                pipelineType == PipelineType::Compute ? currentPipeline->desc.compute.program
-                                                      : currentPipeline->desc.graphics.program);
-            auto unspecializedProgramLayout = unspecializedProgram->linkedProgram->getLayout();
-
-            ComPtr<slang::IComponentType> specializedComponentType;
-            ComPtr<slang::IBlob> diagnosticBlob;
-            auto compileRs = unspecializedProgram->linkedProgram->specialize(
-                specializationArgs.components.getArrayView().getBuffer(),
-                specializationArgs.getCount(),
-                specializedComponentType.writeRef(),
-                diagnosticBlob.writeRef());
-            if (diagnosticBlob)
-            {
-                getDebugCallback()->handleMessage(
-                    compileRs == SLANG_OK ? DebugMessageType::Warning : DebugMessageType::Error,
-                    DebugMessageSource::Slang,
-                    (char*)diagnosticBlob->getBufferPointer());
-            }
-            SLANG_RETURN_ON_FAIL(compileRs);
+            SLANG_RETURN_ON_FAIL(_specializePipeline(
+                currentPipeline,
+                pipelineKey,
+                specializationArgs,
+                specializedPipelineState));
+        }
+        outNewPipeline = specializedPipelineState;
+    }
+    return SLANG_OK;
+}
 
-            // Now create the specialized shader program using compiled binaries.
-            ComPtr<IShaderProgram> specializedProgram;
-            IShaderProgram::Desc specializedProgramDesc = unspecializedProgram->desc;
-            specializedProgramDesc.slangGlobalScope = specializedComponentType;
+// The specializations of a pipeline are recorded in the shader cache as text, with a line for
+// each specialization that lists the full names of its type arguments separated by tabs.
+static PersistentCache::Key _getPipelineSpecializationsKey(const char* name)
+{
+    String keyName = String("pipeline-specializations:") + name;
+    return SHA1::compute(keyName.getBuffer(), keyName.getLength());
+}
 
-            if (specializedProgramDesc.linkingStyle == IShaderProgram::LinkingStyle::SingleProgram)
-            {
-                // When linking style is GraphicsCompute, the specialized global scope already
-                // contains entry-points, so we do not need to supply them again when creating the
-                // specialized pipeline.
-                specializedProgramDesc.entryPointCount = 0;
-            }
-            SLANG_RETURN_ON_FAIL(
-                createProgram(specializedProgramDesc, specializedProgram.writeRef()));
+void RendererBase::_recordPipelineSpecialization(
+    PipelineStateBase* unspecializedPipeline,
+    const ExtendedShaderObjectTypeList& specializationArgs)
+{
+    std::lock_guard<std::mutex> lock(m_recordedSpecializationsMutex);
+    RefPtr<RecordedPipelineSpecializations>* recordedSpecializations =
+        m_recordedSpecializations.tryGetValue(unspecializedPipeline);
+    if (!recordedSpecializations)
+        return;
 
-            // Create specialized pipeline state.
-            ComPtr<IPipelineState> specializedPipelineComPtr;
-            switch (pipelineType)
-            {
-            case PipelineType::Compute:
-                {
-                    auto pipelineDesc = currentPipeline->desc.compute;
-                    pipelineDesc.program = specializedProgram;
-                    SLANG_RETURN_ON_FAIL(createComputePipelineState(
-                        pipelineDesc,
-                        specializedPipelineComPtr.writeRef()));
-                    break;
-                }
-            case PipelineType::Graphics:
-                {
-                    auto pipelineDesc = currentPipeline->desc.graphics;
-                    pipelineDesc.program =
-                        static_cast<ShaderProgramBase*>(specializedProgram.get());
-                    SLANG_RETURN_ON_FAIL(createGraphicsPipelineState(
-                        pipelineDesc,
-                        specializedPipelineComPtr.writeRef()));
-                    break;
-                }
-            case PipelineType::RayTracing:
-                {
-                    auto pipelineDesc = currentPipeline->desc.rayTracing;
-                    pipelineDesc.program =
-                        static_cast<ShaderProgramBase*>(specializedProgram.get());
-                    SLANG_RETURN_ON_FAIL(createRayTracingPipelineState(
-                        pipelineDesc.get(),
-                        specializedPipelineComPtr.writeRef()));
-                    break;
-                }
-            default:
+    StringBuilder line;
+    for (Index i = 0; i < specializationArgs.getCount(); i++)
+    {
+        ComPtr<ISlangBlob> nameBlob;
+        if (SLANG_FAILED(specializationArgs.components[i].type->getFullName(nameBlob.writeRef())))
+            return;
+        if (i != 0)
+            line.appendChar('\t');
+        line.append(UnownedStringSlice(
+            (const char*)nameBlob->getBufferPointer(),
+            nameBlob->getBufferSize()));
+    }
+    if (!(*recordedSpecializations)->lines.add(line.produceString()))
+        return;
+
+    auto& text = (*recordedSpecializations)->text;
+    text.append(line);
+    text.appendChar('\n');
+    ComPtr<ISlangBlob> textBlob = StringBlob::create(text);
+    persistentShaderCache->writeEntry((*recordedSpecializations)->key, textBlob);
+}
+
+Result RendererBase::prewarmPipelineSpecializations(IPipelineState* pipeline, const char* name)
+{
+    SLANG_ASSERT(persistentShaderCache);
+    if (!pipeline || !name)
+        return SLANG_E_INVALID_ARG;
+
+    auto unspecializedPipeline = static_cast<PipelineStateBase*>(pipeline);
+    if (unspecializedPipeline->unspecializedPipelineState)
+        unspecializedPipeline = unspecializedPipeline->unspecializedPipelineState;
+    if (!unspecializedPipeline->isSpecializable)
+        return SLANG_OK;
+
+    RefPtr<RecordedPipelineSpecializations> recordedSpecializations =
+        new RecordedPipelineSpecializations();
+    recordedSpecializations->pipeline = unspecializedPipeline;
+    recordedSpecializations->key = _getPipelineSpecializationsKey(name);
+
+    ComPtr<ISlangBlob> textBlob;
+    if (SLANG_SUCCEEDED(
+            persistentShaderCache->readEntry(recordedSpecializations->key, textBlob.writeRef())))
+    {
+        recordedSpecializations->text.append(UnownedStringSlice(
+            (const char*)textBlob->getBufferPointer(),
+            textBlob->getBufferSize()));
+    }
+
+    auto unspecializedProgram = static_cast<ShaderProgramBase*>(unspecializedPipeline->m_program);
+    auto programLayout = unspecializedProgram->linkedProgram->getLayout();
+
+    List<UnownedStringSlice> lines;
+    StringUtil::calcLines(recordedSpecializations->text.getUnownedSlice(), lines);
+    for (auto line : lines)
+    {
+        if (line.getLength() == 0 || !recordedSpecializations->lines.add(String(line)))
+            continue;
+
+        // Skip the specializations whose types the program no longer has.
+        List<UnownedStringSlice> typeNames;
+        StringUtil::split(line, '\t', typeNames);
+        ExtendedShaderObjectTypeList specializationArgs;
+        for (auto typeName : typeNames)
+        {
+            ExtendedShaderObjectType arg;
+            arg.slangType = programLayout->findTypeByName(String(typeName).getBuffer());
+            if (!arg.slangType)
                 break;
-            }
-            specializedPipelineState =
-                static_cast<PipelineStateBase*>(specializedPipelineComPtr.get());
-            specializedPipelineState->unspecializedPipelineState = currentPipeline;
-            shaderCache.addSpecializedPipeline(pipelineKey, specializedPipelineState);
+            arg.componentID = shaderCache.getComponentId(arg.slangType);
+            specializationArgs.add(arg);
         }
-        auto specializedPipelineStateBase =
-            static_cast<PipelineStateBase*>(specializedPipelineState.Ptr());
-        outNewPipeline = specializedPipelineStateBase;
+        if (specializationArgs.getCount() != typeNames.getCount())
+            continue;
+
+        PipelineKey pipelineKey;
+        pipelineKey.pipeline = unspecializedPipeline;
+        pipelineKey.specializationArgs.addRange(specializationArgs.componentIDs);
+        pipelineKey.updateHash();
+        if (shaderCache.getSpecializedPipelineState(pipelineKey))
+            continue;
+
+        // With background specialization this only queues the job, and the first draw or
+        // dispatch that needs the specialization creates its pipeline.
+        PipelineStateBase* specializedPipeline = nullptr;
+        auto result = _specializePipeline(
+            unspecializedPipeline,
+            pipelineKey,
+            specializationArgs,
+            specializedPipeline);
+        if (result == SLANG_E_PENDING)
+            continue;
+        SLANG_RETURN_ON_FAIL(result);
+        // Devices that create the API pipeline on first use would compile the code then.
+        SLANG_RETURN_ON_FAIL(specializedPipeline->ensureAPIPipelineStateCreated());
     }
+
+    // Record the specializations that draws and dispatches create from now on.
+    std::lock_guard<std::mutex> lock(m_recordedSpecializationsMutex);
+    m_recordedSpecializations[unspecializedPipeline] = recordedSpecializations;
     return SLANG_OK;
 }
 
@@ -1353,6 +1720,29 @@ Result ShaderObjectBase::copyFrom(IShaderObject* object, ITransientResourceHeap*
     return SLANG_FAIL;
 }
 
+Result ShaderTableBase::setHitGroup(
+    GfxIndex index,
+    const char* hitGroupName,
+    const ShaderRecordOverwrite* recordOverwrite)
+{
+    if (index < 0 || uint32_t(index) >= m_hitGroupCount || !hitGroupName)
+        return SLANG_E_INVALID_ARG;
+
+    const Index recordIndex = m_rayGenShaderCount + m_missShaderCount + index;
+    m_shaderGroupNames[recordIndex] = hitGroupName;
+    if (recordOverwrite)
+        m_recordOverwrites[recordIndex] = *recordOverwrite;
+
+    const HitGroupRange range = {uint32_t(index), uint32_t(index) + 1};
+    for (const auto& [pipeline, _] : m_deviceBuffers)
+    {
+        auto& changed = m_changedHitGroups.getOrAddValue(pipeline, range);
+        changed.begin = Math::Min(changed.begin, range.begin);
+        changed.end = Math::Max(changed.end, range.end);
+    }
+    return SLANG_OK;
+}
+
 Result ShaderTableBase::init(const IShaderTable::Desc& desc)
 {
     m_rayGenShaderCount = desc.rayGenShaderCount;
@@ -7,6 +7,13 @@
 #include "slang-context.h"
 #include "slang-gfx.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
 namespace gfx
 {
 
@@ -405,6 +412,9 @@ protected:
 public:
     ComPtr<slang::ISession> m_slangSession;
 
+    // Layouts are shared by the shader objects of all recording threads.
+    ShaderObjectLayoutBase() { enableThreadSafeReferenceCount(); }
+
     ShaderObjectContainerType getContainerType() { return m_containerType; }
 
     static slang::TypeLayoutReflection* _unwrapParameterGroups(
@@ -1111,32 +1121,41 @@ struct OwningComponentKey
 };
 
 // A cache from specialization keys to a specialized `ShaderKernel`.
+//
+// The cache can be used from several threads. Lookups, which hit almost always once the
+// pipelines of a frame have been specialized, only take a shared lock, and take their keys by
+// reference so that they don't allocate.
 class ShaderCache : public Slang::RefObject
 {
 public:
     ShaderComponentID getComponentId(slang::TypeReflection* type);
     ShaderComponentID getComponentId(Slang::UnownedStringSlice name);
-    ShaderComponentID getComponentId(ComponentKey key);
+    ShaderComponentID getComponentId(const ComponentKey& key);
 
-    Slang::RefPtr<PipelineStateBase> getSpecializedPipelineState(PipelineKey programKey)
+    // The returned pipeline is held alive by the cache until `free` is called.
+    PipelineStateBase* getSpecializedPipelineState(const PipelineKey& programKey)
     {
-        Slang::RefPtr<PipelineStateBase> result;
-        if (specializedPipelines.tryGetValue(programKey, result))
-            return result;
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        if (auto result = specializedPipelines.tryGetValue(programKey))
+            return *result;
         return nullptr;
     }
-    void addSpecializedPipeline(
-        PipelineKey key,
-        Slang::RefPtr<PipelineStateBase> specializedPipeline);
+    // Returns the pipeline cached for `key`, which is another thread's if it added a pipeline
+    // for the same key first.
+    PipelineStateBase* addSpecializedPipeline(
+        const PipelineKey& key,
+        PipelineStateBase* specializedPipeline);
     void free()
     {
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
         specializedPipelines = decltype(specializedPipelines)();
         componentIds = decltype(componentIds)();
     }
 
 protected:
+    std::shared_mutex m_mutex;
     Slang::OrderedDictionary<OwningComponentKey, ShaderComponentID> componentIds;
-    Slang::OrderedDictionary<PipelineKey, Slang::RefPtr<PipelineStateBase>> specializedPipelines;
+    Slang::Dictionary<PipelineKey, Slang::RefPtr<PipelineStateBase>> specializedPipelines;
 };
 
 class TransientResourceHeapBase : public ITransientResourceHeap, public Slang::ComObject
@@ -1144,9 +1163,10 @@ class TransientResourceHeapBase : public ITransientResourceHeap, public Slang::C
 public:
     uint64_t m_version = 0;
     uint64_t getVersion() { return m_version; }
-    uint64_t& getVersionCounter()
+    // Shared by the heaps of all threads.
+    std::atomic<uint64_t>& getVersionCounter()
     {
-        static uint64_t version = 1;
+        static std::atomic<uint64_t> version = {1};
         return version;
     }
     TransientResourceHeapBase() { m_version = getVersionCounter()++; }
@@ -1179,6 +1199,14 @@ public:
 
     Slang::Dictionary<PipelineStateBase*, Slang::RefPtr<BufferResource>> m_deviceBuffers;
 
+    // The hit groups changed by `setHitGroup` since the buffer of each pipeline was written.
+    struct HitGroupRange
+    {
+        uint32_t begin;
+        uint32_t end;
+    };
+    Slang::Dictionary<PipelineStateBase*, HitGroupRange> m_changedHitGroups;
+
     SLANG_COM_OBJECT_IUNKNOWN_ALL
     IShaderTable* getInterface(const Slang::Guid& guid)
     {
@@ -1187,11 +1215,36 @@ public:
         return nullptr;
     }
 
+    virtual SLANG_NO_THROW Result SLANG_MCALL setHitGroup(
+        GfxIndex index,
+        const char* hitGroupName,
+        const ShaderRecordOverwrite* recordOverwrite) override;
+
     virtual Slang::RefPtr<BufferResource> createDeviceBuffer(
         PipelineStateBase* pipeline,
         TransientResourceHeapBase* transientHeap,
         IResourceCommandEncoder* encoder) = 0;
 
+    // Record commands that write the hit groups `[firstHitGroup, firstHitGroup + hitGroupCount)`
+    // to `buffer`, which `createDeviceBuffer` created for `pipeline`. The buffer is created again
+    // instead if this fails.
+    virtual Result updateDeviceBufferHitGroups(
+        PipelineStateBase* pipeline,
+        BufferResource* buffer,
+        uint32_t firstHitGroup,
+        uint32_t hitGroupCount,
+        TransientResourceHeapBase* transientHeap,
+        IResourceCommandEncoder* encoder)
+    {
+        SLANG_UNUSED(pipeline);
+        SLANG_UNUSED(buffer);
+        SLANG_UNUSED(firstHitGroup);
+        SLANG_UNUSED(hitGroupCount);
+        SLANG_UNUSED(transientHeap);
+        SLANG_UNUSED(encoder);
+        return SLANG_E_NOT_IMPLEMENTED;
+    }
+
     BufferResource* getOrCreateBuffer(
         PipelineStateBase* pipeline,
         TransientResourceHeapBase* transientHeap,
@@ -1199,6 +1252,19 @@ public:
     {
         if (auto ptr = m_deviceBuffers.tryGetValue(pipeline))
         {
+            HitGroupRange changed;
+            if (m_changedHitGroups.tryGetValue(pipeline, changed))
+            {
+                m_changedHitGroups.remove(pipeline);
+                if (SLANG_FAILED(updateDeviceBufferHitGroups(
+                        pipeline,
+                        ptr->Ptr(),
+                        changed.begin,
+                        changed.end - changed.begin,
+                        transientHeap,
+                        encoder)))
+                    *ptr = createDeviceBuffer(pipeline, transientHeap, encoder);
+            }
             return ptr->Ptr();
         }
         auto result = createDeviceBuffer(pipeline, transientHeap, encoder);
@@ -1209,6 +1275,38 @@ public:
     Result init(const IShaderTable::Desc& desc);
 };
 
+// A specialization of a pipeline whose Slang code is generated on a background thread.
+//
+// The job only holds the Slang objects of the unspecialized program, whose reference counts can be
+// changed from any thread.
+class PipelineSpecializationJob : public Slang::RefObject
+{
+public:
+    // Set before the job is queued.
+    IShaderProgram::Desc programDesc;
+    Slang::ComPtr<slang::IComponentType> linkedProgram;
+    Slang::List<Slang::ComPtr<slang::IComponentType>> slangEntryPoints;
+    Slang::List<slang::IComponentType*> slangEntryPointPtrs;
+    Slang::List<slang::SpecializationArg> specializationArgs;
+
+    // Set by the worker thread before `isDone`.
+    Result result = SLANG_OK;
+    Slang::ComPtr<slang::IComponentType> specializedComponentType;
+    std::atomic<bool> isDone = {false};
+};
+
+// The specializations of a pipeline that `IShaderCache::prewarmPipelineSpecializations` records
+// in the shader cache.
+class RecordedPipelineSpecializations : public Slang::RefObject
+{
+public:
+    // Keeps the recorded pipeline alive, so that its address isn't reused by another pipeline.
+    Slang::RefPtr<PipelineStateBase> pipeline;
+    Slang::PersistentCache::Key key;
+    Slang::String text;
+    Slang::HashSet<Slang::String> lines;
+};
+
 // Renderer implementation shared by all platforms.
 // Responsible for shader compilation, specialization and caching.
 class RendererBase : public IDevice, public IShaderCache, public Slang::ComObject
@@ -1219,6 +1317,8 @@ public:
     SLANG_COM_OBJECT_IUNKNOWN_ADD_REF
     SLANG_COM_OBJECT_IUNKNOWN_RELEASE
 
+    ~RendererBase();
+
     virtual SLANG_NO_THROW Result SLANG_MCALL getNativeDeviceHandles(InteropHandles* outHandles)
         SLANG_OVERRIDE;
     virtual SLANG_NO_THROW Result SLANG_MCALL getFeatures(
@@ -1338,6 +1438,17 @@ public:
     // Provides a default implementation that returns SLANG_E_NOT_AVAILABLE.
     virtual SLANG_NO_THROW Result SLANG_MCALL getTextureRowAlignment(size_t* outAlignment) override;
 
+    // Provides a default implementation that returns SLANG_E_NOT_AVAILABLE.
+    virtual SLANG_NO_THROW Result SLANG_MCALL
+    getBindlessResourceIndex(IResourceView* view, uint32_t* outIndex) override;
+
+    virtual SLANG_NO_THROW Result SLANG_MCALL
+    getRedundantStateStats(RedundantStateStats* outStats) override;
+    virtual SLANG_NO_THROW Result SLANG_MCALL resetRedundantStateStats() override;
+
+    // Add the state changes that a command encoder skipped to the counts of the device.
+    void addRedundantStateStats(const RedundantStateStats& stats);
+
     Result getEntryPointCodeFromShaderCache(
         slang::IComponentType* program,
         SlangInt entryPointIndex,
@@ -1357,7 +1468,6 @@ public:
         ShaderObjectLayoutBase** outLayout);
 
 public:
-    ExtendedShaderObjectTypeList specializationArgs;
     // Given current pipeline and root shader object binding, generate and bind a specialized
     // pipeline if necessary. The newly specialized pipeline is held alive by the pipeline cache so
     // users of `outNewPipeline` do not need to maintain its lifespan.
@@ -1386,21 +1496,88 @@ public:
     virtual SLANG_NO_THROW Result SLANG_MCALL getShaderCacheStats(ShaderCacheStats* outStats)
         SLANG_OVERRIDE;
     virtual SLANG_NO_THROW Result SLANG_MCALL resetShaderCacheStats() SLANG_OVERRIDE;
+    virtual SLANG_NO_THROW Result SLANG_MCALL
+    prewarmPipelineSpecializations(IPipelineState* pipeline, const char* name) SLANG_OVERRIDE;
 
 protected:
     virtual SLANG_NO_THROW SlangResult SLANG_MCALL initialize(const Desc& desc);
 
+    // Returns true if the command encoders of the device skip the draws and dispatches that
+    // `maybeSpecializePipeline` returns `SLANG_E_PENDING` for.
+    virtual bool supportsAsyncPipelineSpecialization() { return false; }
+
+    // Write the pipeline cache data of the driver to `fileName`. It is written to a file of this
+    // process first and then moved into place, so that other processes never read a partially
+    // written file.
+    static void writePipelineCacheFile(
+        const Slang::String& fileName,
+        const void* data,
+        Size size);
+
 protected:
     Slang::List<Slang::String> m_features;
 
+private:
+    Result _specializeProgram(
+        slang::IComponentType* linkedProgram,
+        const slang::SpecializationArg* args,
+        Slang::Index argCount,
+        Slang::ComPtr<slang::IComponentType>& outSpecializedComponentType);
+    Result _specializePipeline(
+        PipelineStateBase* unspecializedPipeline,
+        const PipelineKey& pipelineKey,
+        const ExtendedShaderObjectTypeList& specializationArgs,
+        PipelineStateBase*& outSpecializedPipeline);
+    void _recordPipelineSpecialization(
+        PipelineStateBase* unspecializedPipeline,
+        const ExtendedShaderObjectTypeList& specializationArgs);
+    Result _createSpecializedPipeline(
+        PipelineStateBase* unspecializedPipeline,
+        ShaderProgramBase* unspecializedProgram,
+        slang::IComponentType* specializedComponentType,
+        Slang::RefPtr<PipelineStateBase>& outSpecializedPipeline);
+    void _runPipelineSpecializationJob(PipelineSpecializationJob* job);
+    void _runPipelineSpecializationWorker();
+    void _stopPipelineSpecializationWorkers();
+
+    std::vector<std::thread> m_specializationWorkers;
+    std::mutex m_specializationQueueMutex;
+    std::condition_variable m_specializationQueueCondition;
+    // The jobs are owned by `m_pendingSpecializations`.
+    Slang::List<PipelineSpecializationJob*> m_specializationQueue;
+    bool m_isStoppingSpecializationWorkers = false;
+
+    // The specializations that draws and dispatches are waiting for, guarded by
+    // `m_specializationQueueMutex`.
+    Slang::Dictionary<PipelineKey, Slang::RefPtr<PipelineSpecializationJob>>
+        m_pendingSpecializations;
+
+    // The code that the worker threads generated, by entry point hash, until the pipelines that
+    // use it are created.
+    std::mutex m_backgroundEntryPointCodeMutex;
+    Slang::Dictionary<Slang::PersistentCache::Key, Slang::ComPtr<ISlangBlob>>
+        m_backgroundEntryPointCode;
+
+    std::mutex m_redundantStateStatsMutex;
+    RedundantStateStats m_redundantStateStats = {};
+
 public:
     SlangContext slangContext;
     ShaderCache shaderCache;
 
     Slang::RefPtr<Slang::PersistentCache> persistentShaderCache;
 
+    // Guarded by `m_shaderObjectLayoutCacheMutex`, since shader objects can be created by any
+    // recording thread. The mutex is recursive because creating a layout can create the layouts
+    // of its sub-objects.
+    std::recursive_mutex m_shaderObjectLayoutCacheMutex;
     Slang::Dictionary<slang::TypeLayoutReflection*, Slang::RefPtr<ShaderObjectLayoutBase>>
         m_shaderObjectLayoutCache;
+
+    // The pipelines that `prewarmPipelineSpecializations` records the specializations of.
+    std::mutex m_recordedSpecializationsMutex;
+    Slang::Dictionary<PipelineStateBase*, Slang::RefPtr<RecordedPipelineSpecializations>>
+        m_recordedSpecializations;
     Slang::ComPtr<IPipelineCreationAPIDispatcher> m_pipelineCreationAPIDispatcher;
 };
 
@@ -53,11 +53,20 @@ public:
 
         for (uint32_t i = 0; i < extendedDescCount; i++)
         {
-            if ((*(StructType*)extendedDescs[i]) == StructType::SlangSessionExtendedDesc)
+            switch (*(StructType*)extendedDescs[i])
             {
-                auto extDesc = (SlangSessionExtendedDesc*)extendedDescs[i];
-                slangSessionDesc.compilerOptionEntryCount = extDesc->compilerOptionEntryCount;
-                slangSessionDesc.compilerOptionEntries = extDesc->compilerOptionEntries;
+            case StructType::SlangSessionExtendedDesc:
+                {
+                    auto extDesc = (SlangSessionExtendedDesc*)extendedDescs[i];
+                    slangSessionDesc.compilerOptionEntryCount = extDesc->compilerOptionEntryCount;
+                    slangSessionDesc.compilerOptionEntries = extDesc->compilerOptionEntries;
+                    break;
+                }
+            case StructType::AsyncPipelineSpecializationDesc:
+                // Pipelines are specialized on worker threads.
+                slangSessionDesc.flags |= slang::kSessionFlags_ThreadSafe;
+                break;
+            default:
                 break;
             }
         }
@@ -11,12 +11,16 @@ public:
     {
         Slang::RefPtr<TBufferResource> resource;
         size_t size;
+        // The host address of `resource`, once the page has been mapped by `getMappedData`.
+        void* mappedData = nullptr;
     };
 
     struct Allocation
     {
         TBufferResource* resource;
         size_t offset;
+        // The index of the page the allocation was made from, or -1 for a large allocation.
+        Slang::Index pageIndex;
     };
 
     TDevice* m_device;
@@ -101,6 +105,7 @@ public:
             Allocation result;
             result.resource = m_largeAllocations.getLast();
             result.offset = 0;
+            result.pageIndex = -1;
             return result;
         }
 
@@ -127,10 +132,34 @@ public:
         Allocation result;
         result.resource = m_pages[bufferId].resource.Ptr();
         result.offset = bufferAllocOffset;
+        result.pageIndex = bufferId;
         m_pageAllocCounter = bufferId;
         m_offsetAllocCounter = bufferAllocOffset + size;
         return result;
     }
+
+    /// Get the host address that `allocation` can be written through. Pages stay mapped once
+    /// they have been mapped here, so the pool must be of host-visible memory that isn't
+    /// mapped by other means, and this must be called at most once for a large allocation.
+    Result getMappedData(const Allocation& allocation, void*& outData)
+    {
+        MemoryRange readRange = {0, 0};
+        void* mappedData = nullptr;
+        if (allocation.pageIndex < 0)
+        {
+            // Large allocations are released on `reset`, which also unmaps them.
+            SLANG_RETURN_ON_FAIL(allocation.resource->map(&readRange, &mappedData));
+        }
+        else
+        {
+            auto& page = m_pages[allocation.pageIndex];
+            if (!page.mappedData)
+                SLANG_RETURN_ON_FAIL(page.resource->map(&readRange, &page.mappedData));
+            mappedData = page.mappedData;
+        }
+        outData = (char*)mappedData + allocation.offset;
+        return SLANG_OK;
+    }
 };
 
 template<typename TDevice, typename TBufferResource>
@@ -170,8 +199,7 @@ public:
             256,
             ResourceStateSet(ResourceState::CopySource, ResourceState::CopyDestination));
 
-        m_version = getVersionCounter();
-        getVersionCounter()++;
+        m_version = getVersionCounter()++;
         return SLANG_OK;
     }
 
@@ -202,6 +230,24 @@ public:
         return SLANG_OK;
     }
 
+    /// Allocate upload memory like `allocateStagingBuffer`, and also get the host address that
+    /// it can be written through. The pages of the upload pool stay mapped until the heap is
+    /// destroyed, so that uploads don't map and unmap memory each time, and memory allocated
+    /// from it must only be written through this address.
+    Result allocateMappedStagingBuffer(
+        size_t size,
+        IBufferResource*& outBufferWeakPtr,
+        size_t& outOffset,
+        void*& outMappedData,
+        bool forceLargePage = false)
+    {
+        auto allocation = m_uploadBufferPool.allocate(size, forceLargePage);
+        SLANG_RETURN_ON_FAIL(m_uploadBufferPool.getMappedData(allocation, outMappedData));
+        outBufferWeakPtr = allocation.resource;
+        outOffset = allocation.offset;
+        return SLANG_OK;
+    }
+
     Result allocateConstantBuffer(
         size_t size,
         IBufferResource*& outBufferWeakPtr,
@@ -213,13 +259,29 @@ public:
         return SLANG_OK;
     }
 
+    /// Allocate constant buffer memory like `allocateConstantBuffer`, and also get the host
+    /// address that it can be written through directly, instead of uploading data to it with
+    /// a command. The memory must not be written after commands that read it have been
+    /// submitted.
+    Result allocateMappedConstantBuffer(
+        size_t size,
+        IBufferResource*& outBufferWeakPtr,
+        size_t& outOffset,
+        void*& outMappedData)
+    {
+        auto allocation = m_constantBufferPool.allocate(size, false);
+        SLANG_RETURN_ON_FAIL(m_constantBufferPool.getMappedData(allocation, outMappedData));
+        outBufferWeakPtr = allocation.resource;
+        outOffset = allocation.offset;
+        return SLANG_OK;
+    }
+
     void reset()
     {
         m_constantBufferPool.reset();
         m_uploadBufferPool.reset();
         m_readbackBufferPool.reset();
-        m_version = getVersionCounter();
-        getVersionCounter()++;
+        m_version = getVersionCounter()++;
     }
 };
 
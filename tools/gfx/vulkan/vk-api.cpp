@@ -125,7 +125,7 @@ int VulkanApi::findMemoryTypeIndex(uint32_t typeBits, VkMemoryPropertyFlags prop
     return -1;
 }
 
-int VulkanApi::findQueue(VkQueueFlags reqFlags) const
+int VulkanApi::findQueue(VkQueueFlags reqFlags, VkQueueFlags excludedFlags) const
 {
     assert(m_physicalDevice != VK_NULL_HANDLE);
 
@@ -145,7 +145,8 @@ int VulkanApi::findQueue(VkQueueFlags reqFlags) const
     int queueFamilyIndex = -1;
     for (int i = 0; i < int(numQueueFamilies); ++i)
     {
-        if ((queueFamilies[i].queueFlags & reqFlags) == reqFlags)
+        if ((queueFamilies[i].queueFlags & reqFlags) == reqFlags &&
+            (queueFamilies[i].queueFlags & excludedFlags) == 0)
         {
             return i;
         }
@@ -59,6 +59,9 @@ namespace gfx
     x(vkCreateComputePipelines) \
     x(vkCreateGraphicsPipelines) \
     x(vkDestroyPipeline) \
+    x(vkCreatePipelineCache) \
+    x(vkDestroyPipelineCache) \
+    x(vkGetPipelineCacheData) \
     x(vkCreateShaderModule) \
     x(vkDestroyShaderModule) \
     x(vkCreateFramebuffer) \
@@ -336,7 +339,25 @@ struct VulkanApi
     int findMemoryTypeIndex(uint32_t typeBits, VkMemoryPropertyFlags properties) const;
 
     /// Given queue required flags, finds a queue
-    int findQueue(VkQueueFlags reqFlags) const;
+    /// Queue families with any of the excluded flags are skipped.
+    int findQueue(VkQueueFlags reqFlags, VkQueueFlags excludedFlags = 0) const;
+
+    /// Sets up the create info of a buffer or image so that it can be used on every queue family
+    /// that the device has queues of.
+    template<typename TCreateInfo>
+    void initSharingMode(TCreateInfo& createInfo) const
+    {
+        if (m_queueFamilyIndexCount > 1)
+        {
+            createInfo.sharingMode = VK_SHARING_MODE_CONCURRENT;
+            createInfo.queueFamilyIndexCount = m_queueFamilyIndexCount;
+            createInfo.pQueueFamilyIndices = m_queueFamilyIndices;
+        }
+        else
+        {
+            createInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        }
+    }
 
     const VulkanModule* m_module = nullptr; ///< Module this was all loaded from
     VkInstance m_instance = VK_NULL_HANDLE;
@@ -348,6 +369,10 @@ struct VulkanApi
     VkPhysicalDeviceFeatures m_deviceFeatures;
     VkPhysicalDeviceMemoryProperties m_deviceMemoryProperties;
     VulkanExtendedFeatureProperties m_extendedFeatures;
+
+    /// The distinct queue families that the device has queues of.
+    uint32_t m_queueFamilyIndices[3] = {};
+    uint32_t m_queueFamilyIndexCount = 0;
 };
 
 } // namespace gfx
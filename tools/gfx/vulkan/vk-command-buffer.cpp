@@ -93,6 +93,13 @@ VkCommandBuffer CommandBufferImpl::getPreCommandBuffer()
     return m_preCommandBuffer;
 }
 
+VkPipelineStageFlags CommandBufferImpl::getSupportedPipelineStages(VkPipelineStageFlags stages)
+{
+    if (m_transientHeap->m_queueType == ICommandQueue::QueueType::Graphics)
+        return stages;
+    return VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+}
+
 void CommandBufferImpl::encodeRenderCommands(
     IRenderPassLayout* renderPass,
     IFramebuffer* framebuffer,
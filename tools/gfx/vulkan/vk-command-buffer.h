@@ -51,6 +51,10 @@ public:
 
     VkCommandBuffer getPreCommandBuffer();
 
+    // Returns the stages that a barrier recorded into the command buffer should use for
+    // `stages`, since compute and copy queues don't support the graphics stages.
+    VkPipelineStageFlags getSupportedPipelineStages(VkPipelineStageFlags stages);
+
 public:
     virtual SLANG_NO_THROW void SLANG_MCALL encodeRenderCommands(
         IRenderPassLayout* renderPass,
@@ -49,6 +49,12 @@ void PipelineCommandEncoder::endEncodingImpl()
 {
     for (auto& pipeline : m_boundPipelines)
         pipeline = VK_NULL_HANDLE;
+    for (auto& layout : m_boundPipelineLayouts)
+        layout = VK_NULL_HANDLE;
+    for (auto& descriptorSets : m_boundDescriptorSets)
+        descriptorSets.clear();
+    m_device->addRedundantStateStats(m_redundantStateStats);
+    m_redundantStateStats = {};
 }
 
 void PipelineCommandEncoder::_uploadBufferData(
@@ -62,21 +68,16 @@ void PipelineCommandEncoder::_uploadBufferData(
     auto& api = buffer->m_renderer->m_api;
     IBufferResource* stagingBuffer = nullptr;
     Offset stagingBufferOffset = 0;
-    transientHeap
-        ->allocateStagingBuffer(size, stagingBuffer, stagingBufferOffset, MemoryType::Upload);
+    void* mappedData = nullptr;
+    if (SLANG_FAILED(transientHeap->allocateMappedStagingBuffer(
+            size,
+            stagingBuffer,
+            stagingBufferOffset,
+            mappedData)))
+        return;
 
     BufferResourceImpl* stagingBufferImpl = static_cast<BufferResourceImpl*>(stagingBuffer);
-
-    void* mappedData = nullptr;
-    SLANG_VK_CHECK(api.vkMapMemory(
-        api.m_device,
-        stagingBufferImpl->m_buffer.m_memory,
-        0,
-        stagingBufferOffset + size,
-        0,
-        &mappedData));
-    memcpy((char*)mappedData + stagingBufferOffset, data, size);
-    api.vkUnmapMemory(api.m_device, stagingBufferImpl->m_buffer.m_memory);
+    memcpy(mappedData, data, size);
 
     // Copy from staging buffer to real buffer
     VkBufferCopy copyInfo = {};
@@ -131,26 +132,37 @@ Result PipelineCommandEncoder::bindRootShaderObjectImpl(
     // and the number of sets we need to make space for is determined
     // by the specialized program layout.
     //
-    List<VkDescriptorSet> descriptorSetsStorage;
+    List<DescriptorSetContents> descriptorSetContents;
 
-    context.descriptorSets = &descriptorSetsStorage;
+    context.descriptorSets = &descriptorSetContents;
 
     // We kick off recursive binding of shader objects to the pipeline (plus
     // the state in `context`).
     //
     // Note: this logic will directly write any push-constant ranges needed,
-    // and will also fill in any descriptor sets. Currently it does not
-    // *bind* the descriptor sets it fills in.
-    //
-    // TODO: It could probably bind the descriptor sets as well.
+    // and will also collect the contents of any descriptor sets. It does
+    // not allocate or write the descriptor sets themselves.
     //
     rootShaderObject->bindAsRoot(this, context, specializedLayout);
 
-    // Once we've filled in all the descriptor sets, we bind them
-    // to the pipeline at once.
+    // Once we know the contents of all the descriptor sets, we get a set for
+    // each of them, reusing any set written with the same contents earlier in
+    // this transient heap, and bind them to the pipeline at once.
     //
-    if (descriptorSetsStorage.getCount() > 0)
+    if (descriptorSetContents.getCount() > 0)
     {
+        List<VkDescriptorSet> descriptorSetsStorage;
+        for (auto& contents : descriptorSetContents)
+            descriptorSetsStorage.add(context.descriptorSetAllocator->getOrWriteSet(contents));
+
+        // Consecutive draws with the same bindings get the same sets, which are still bound.
+        auto bindPointIndex = getBindPointIndex(bindPoint);
+        if (m_boundPipelineLayouts[bindPointIndex] == specializedLayout->m_pipelineLayout &&
+            m_boundDescriptorSets[bindPointIndex] == descriptorSetsStorage)
+        {
+            m_redundantStateStats.descriptorBindCount++;
+            return SLANG_OK;
+        }
         m_device->m_api.vkCmdBindDescriptorSets(
             m_commandBuffer->m_commandBuffer,
             bindPoint,
@@ -160,6 +172,8 @@ Result PipelineCommandEncoder::bindRootShaderObjectImpl(
             descriptorSetsStorage.getBuffer(),
             0,
             nullptr);
+        m_boundPipelineLayouts[bindPointIndex] = specializedLayout->m_pipelineLayout;
+        m_boundDescriptorSets[bindPointIndex] = _Move(descriptorSetsStorage);
     }
 
     return SLANG_OK;
@@ -213,6 +227,10 @@ Result PipelineCommandEncoder::bindRenderState(VkPipelineBindPoint pipelineBindP
         api.vkCmdBindPipeline(m_vkCommandBuffer, pipelineBindPoint, newPipelineImpl->m_pipeline);
         m_boundPipelines[pipelineBindPointId] = newPipelineImpl->m_pipeline;
     }
+    else
+    {
+        m_redundantStateStats.pipelineBindCount++;
+    }
 
     return SLANG_OK;
 }
@@ -290,8 +308,10 @@ void ResourceCommandEncoder::textureBarrier(
         barriers.add(barrier);
     }
 
-    VkPipelineStageFlagBits srcStage = calcPipelineStageFlags(src, true);
-    VkPipelineStageFlagBits dstStage = calcPipelineStageFlags(dst, false);
+    VkPipelineStageFlags srcStage =
+        m_commandBuffer->getSupportedPipelineStages(calcPipelineStageFlags(src, true));
+    VkPipelineStageFlags dstStage =
+        m_commandBuffer->getSupportedPipelineStages(calcPipelineStageFlags(dst, false));
 
     auto& vkApi = m_commandBuffer->m_renderer->m_api;
     vkApi.vkCmdPipelineBarrier(
@@ -332,8 +352,10 @@ void ResourceCommandEncoder::bufferBarrier(
         barriers.add(barrier);
     }
 
-    VkPipelineStageFlagBits srcStage = calcPipelineStageFlags(src, true);
-    VkPipelineStageFlagBits dstStage = calcPipelineStageFlags(dst, false);
+    VkPipelineStageFlags srcStage =
+        m_commandBuffer->getSupportedPipelineStages(calcPipelineStageFlags(src, true));
+    VkPipelineStageFlags dstStage =
+        m_commandBuffer->getSupportedPipelineStages(calcPipelineStageFlags(dst, false));
 
     auto& vkApi = m_commandBuffer->m_renderer->m_api;
     vkApi.vkCmdPipelineBarrier(
@@ -476,16 +498,18 @@ void ResourceCommandEncoder::uploadTextureData(
 
     IBufferResource* uploadBuffer = nullptr;
     Offset uploadBufferOffset = 0;
-    m_commandBuffer->m_transientHeap
-        ->allocateStagingBuffer(bufferSize, uploadBuffer, uploadBufferOffset, MemoryType::Upload);
+    void* mappedData = nullptr;
+    m_commandBuffer->m_transientHeap->allocateMappedStagingBuffer(
+        bufferSize,
+        uploadBuffer,
+        uploadBufferOffset,
+        mappedData);
 
     // Copy into upload buffer
     {
         int subResourceCounter = 0;
 
-        uint8_t* dstData;
-        uploadBuffer->map(nullptr, (void**)&dstData);
-        dstData += uploadBufferOffset;
+        uint8_t* dstData = (uint8_t*)mappedData;
         uint8_t* dstDataStart;
         dstDataStart = dstData;
 
@@ -529,7 +553,6 @@ void ResourceCommandEncoder::uploadTextureData(
                 dstSubresourceOffset += dstLayerSizeInBytes * mipSize.depth;
             }
         }
-        uploadBuffer->unmap(nullptr);
     }
     {
         Offset srcOffset = uploadBufferOffset;
@@ -926,8 +949,10 @@ void ResourceCommandEncoder::textureSubresourceBarrier(
     barrier.dstAccessMask = calcAccessFlags(dst);
     barriers.add(barrier);
 
-    VkPipelineStageFlagBits srcStage = calcPipelineStageFlags(src, true);
-    VkPipelineStageFlagBits dstStage = calcPipelineStageFlags(dst, false);
+    VkPipelineStageFlags srcStage =
+        m_commandBuffer->getSupportedPipelineStages(calcPipelineStageFlags(src, true));
+    VkPipelineStageFlags dstStage =
+        m_commandBuffer->getSupportedPipelineStages(calcPipelineStageFlags(dst, false));
 
     auto& vkApi = m_commandBuffer->m_renderer->m_api;
     vkApi.vkCmdPipelineBarrier(
@@ -994,6 +1019,10 @@ void RenderCommandEncoder::endEncoding()
 {
     auto& api = *m_api;
     api.vkCmdEndRenderPass(m_vkCommandBuffer);
+    m_viewports.clear();
+    m_scissorRects.clear();
+    m_boundVertexBuffers.clear();
+    m_boundIndexBuffer = VK_NULL_HANDLE;
     endEncodingImpl();
 }
 
@@ -1016,11 +1045,11 @@ void RenderCommandEncoder::setViewports(GfxCount count, const Viewport* viewport
     static const int kMaxViewports = 8; // TODO: base on device caps
     assert(count <= kMaxViewports);
 
-    m_viewports.setCount(count);
+    VkViewport vkViewports[kMaxViewports];
     for (GfxIndex ii = 0; ii < count; ++ii)
     {
         auto& inViewport = viewports[ii];
-        auto& vkViewport = m_viewports[ii];
+        auto& vkViewport = vkViewports[ii];
 
         vkViewport.x = inViewport.originX;
         vkViewport.y = inViewport.originY + inViewport.extentY;
@@ -1030,6 +1059,15 @@ void RenderCommandEncoder::setViewports(GfxCount count, const Viewport* viewport
         vkViewport.maxDepth = inViewport.maxZ;
     }
 
+    if (m_viewports.getCount() == count &&
+        memcmp(m_viewports.getBuffer(), vkViewports, sizeof(VkViewport) * count) == 0)
+    {
+        m_redundantStateStats.viewportCount++;
+        return;
+    }
+    m_viewports.clear();
+    m_viewports.addRange(vkViewports, count);
+
     auto& api = *m_api;
     api.vkCmdSetViewport(m_vkCommandBuffer, 0, uint32_t(count), m_viewports.getBuffer());
 }
@@ -1039,11 +1077,11 @@ void RenderCommandEncoder::setScissorRects(GfxCount count, const ScissorRect* re
     static const int kMaxScissorRects = 8; // TODO: base on device caps
     assert(count <= kMaxScissorRects);
 
-    m_scissorRects.setCount(count);
+    VkRect2D vkRects[kMaxScissorRects];
     for (GfxIndex ii = 0; ii < count; ++ii)
     {
         auto& inRect = rects[ii];
-        auto& vkRect = m_scissorRects[ii];
+        auto& vkRect = vkRects[ii];
 
         vkRect.offset.x = int32_t(inRect.minX);
         vkRect.offset.y = int32_t(inRect.minY);
@@ -1051,6 +1089,15 @@ void RenderCommandEncoder::setScissorRects(GfxCount count, const ScissorRect* re
         vkRect.extent.height = uint32_t(inRect.maxY - inRect.minY);
     }
 
+    if (m_scissorRects.getCount() == count &&
+        memcmp(m_scissorRects.getBuffer(), vkRects, sizeof(VkRect2D) * count) == 0)
+    {
+        m_redundantStateStats.scissorRectCount++;
+        return;
+    }
+    m_scissorRects.clear();
+    m_scissorRects.addRange(vkRects, count);
+
     auto& api = *m_api;
     api.vkCmdSetScissor(m_vkCommandBuffer, 0, uint32_t(count), m_scissorRects.getBuffer());
 }
@@ -1086,6 +1133,12 @@ void RenderCommandEncoder::setVertexBuffers(
     IBufferResource* const* buffers,
     const Offset* offsets)
 {
+    if (startSlot + slotCount > m_boundVertexBuffers.getCount())
+    {
+        BoundVertexBuffer unbound = {VK_NULL_HANDLE, 0};
+        while (m_boundVertexBuffers.getCount() < startSlot + slotCount)
+            m_boundVertexBuffers.add(unbound);
+    }
     for (GfxIndex i = 0; i < GfxIndex(slotCount); i++)
     {
         GfxIndex slotIndex = startSlot + i;
@@ -1095,6 +1148,15 @@ void RenderCommandEncoder::setVertexBuffers(
             VkBuffer vertexBuffers[] = {buffer->m_buffer.m_buffer};
             VkDeviceSize offset = VkDeviceSize(offsets[i]);
 
+            auto& bound = m_boundVertexBuffers[slotIndex];
+            if (bound.buffer == vertexBuffers[0] && bound.offset == offset)
+            {
+                m_redundantStateStats.vertexBufferBindCount++;
+                continue;
+            }
+            bound.buffer = vertexBuffers[0];
+            bound.offset = offset;
+
             m_api->vkCmdBindVertexBuffers(
                 m_vkCommandBuffer,
                 (uint32_t)slotIndex,
@@ -1124,6 +1186,15 @@ void RenderCommandEncoder::setIndexBuffer(
     }
 
     BufferResourceImpl* bufferImpl = static_cast<BufferResourceImpl*>(buffer);
+    if (m_boundIndexBuffer == bufferImpl->m_buffer.m_buffer &&
+        m_boundIndexOffset == (VkDeviceSize)offset && m_boundIndexType == indexType)
+    {
+        m_redundantStateStats.indexBufferBindCount++;
+        return;
+    }
+    m_boundIndexBuffer = bufferImpl->m_buffer.m_buffer;
+    m_boundIndexOffset = (VkDeviceSize)offset;
+    m_boundIndexType = indexType;
 
     m_api->vkCmdBindIndexBuffer(
         m_vkCommandBuffer,
@@ -19,6 +19,11 @@ public:
     VkCommandBuffer m_vkCommandBuffer;
     VkCommandBuffer m_vkPreCommandBuffer = VK_NULL_HANDLE;
     VkPipeline m_boundPipelines[3] = {};
+    // The pipeline layout and descriptor sets last bound by this encoder at each bind point.
+    VkPipelineLayout m_boundPipelineLayouts[3] = {};
+    List<VkDescriptorSet> m_boundDescriptorSets[3];
+    // The state changes this encoder skipped because the state was already set.
+    RedundantStateStats m_redundantStateStats = {};
     DeviceImpl* m_device = nullptr;
     RefPtr<PipelineStateImpl> m_currentPipeline;
 
@@ -184,8 +189,19 @@ class RenderCommandEncoder : public IRenderCommandEncoder, public ResourceComman
     }
 
 public:
+    struct BoundVertexBuffer
+    {
+        VkBuffer buffer;
+        VkDeviceSize offset;
+    };
+
+    // The state last set by this encoder, cleared when the encoder ends.
     List<VkViewport> m_viewports;
     List<VkRect2D> m_scissorRects;
+    List<BoundVertexBuffer> m_boundVertexBuffers;
+    VkBuffer m_boundIndexBuffer = VK_NULL_HANDLE;
+    VkDeviceSize m_boundIndexOffset = 0;
+    VkIndexType m_boundIndexType = VK_INDEX_TYPE_UINT16;
 
 public:
     void beginPass(IRenderPassLayout* renderPass, IFramebuffer* framebuffer);
@@ -24,12 +24,17 @@ CommandQueueImpl::~CommandQueueImpl()
 {
     m_renderer->m_api.vkQueueWaitIdle(m_queue);
 
-    m_renderer->m_queueAllocCount--;
+    m_renderer->m_queueAllocCounts[Index(m_desc.type)]--;
     m_renderer->m_api.vkDestroySemaphore(m_renderer->m_api.m_device, m_semaphore, nullptr);
 }
 
-void CommandQueueImpl::init(DeviceImpl* renderer, VkQueue queue, uint32_t queueFamilyIndex)
+void CommandQueueImpl::init(
+    DeviceImpl* renderer,
+    VkQueue queue,
+    uint32_t queueFamilyIndex,
+    const Desc& desc)
 {
+    m_desc = desc;
     m_renderer = renderer;
     m_queue = queue;
     m_queueFamilyIndex = queueFamilyIndex;
@@ -96,27 +101,35 @@ void CommandQueueImpl::queueSubmitImpl(
 
     VkSubmitInfo submitInfo = {};
     submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    VkPipelineStageFlags stageFlag[] = {
-        VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
-        VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT};
-    submitInfo.pWaitDstStageMask = stageFlag;
     submitInfo.commandBufferCount = (uint32_t)m_submitCommandBuffers.getCount();
     submitInfo.pCommandBuffers = m_submitCommandBuffers.getBuffer();
-    Array<VkSemaphore, 3> waitSemaphores;
-    Array<uint64_t, 3> waitValues;
+    auto& waitSemaphores = m_submitWaitSemaphores;
+    auto& waitValues = m_submitWaitValues;
+    auto& waitStages = m_submitWaitStages;
+    waitSemaphores.clear();
+    waitValues.clear();
+    waitStages.clear();
     for (auto s : m_pendingWaitSemaphores)
     {
         if (s != VK_NULL_HANDLE)
         {
             waitSemaphores.add(s);
             waitValues.add(0);
+            waitStages.add(VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT);
         }
     }
+    // The work that a fence signals may be done by another queue, so all of the commands
+    // submitted here wait for it.
     for (auto& fenceWait : m_pendingWaitFences)
     {
         waitSemaphores.add(fenceWait.fence->m_semaphore);
         waitValues.add(fenceWait.waitValue);
+        waitStages.add(VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
     }
+    submitInfo.pWaitDstStageMask = waitStages.getBuffer();
+    // Waiting on a fence signaled by another queue needs the timeline values as much as
+    // signaling one does.
+    bool hasTimelineSemaphores = fence || m_pendingWaitFences.getCount() != 0;
     m_pendingWaitFences.clear();
     VkTimelineSemaphoreSubmitInfo timelineSubmitInfo = {
         VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO};
@@ -125,6 +138,9 @@ void CommandQueueImpl::queueSubmitImpl(
         auto fenceImpl = static_cast<FenceImpl*>(fence);
         signalSemaphores.add(fenceImpl->m_semaphore);
         signalValues.add(valueToSignal);
+    }
+    if (hasTimelineSemaphores)
+    {
         submitInfo.pNext = &timelineSubmitInfo;
         timelineSubmitInfo.signalSemaphoreValueCount = (uint32_t)signalValues.getCount();
         timelineSubmitInfo.pSignalSemaphoreValues = signalValues.getBuffer();
@@ -31,10 +31,13 @@ public:
     List<FenceWaitInfo> m_pendingWaitFences;
     VkSemaphore m_pendingWaitSemaphores[2] = {VK_NULL_HANDLE, VK_NULL_HANDLE};
     List<VkCommandBuffer> m_submitCommandBuffers;
+    List<VkSemaphore> m_submitWaitSemaphores;
+    List<uint64_t> m_submitWaitValues;
+    List<VkPipelineStageFlags> m_submitWaitStages;
     VkSemaphore m_semaphore;
     ~CommandQueueImpl();
 
-    void init(DeviceImpl* renderer, VkQueue queue, uint32_t queueFamilyIndex);
+    void init(DeviceImpl* renderer, VkQueue queue, uint32_t queueFamilyIndex, const Desc& desc);
 
     virtual SLANG_NO_THROW void SLANG_MCALL waitOnHost() override;
 
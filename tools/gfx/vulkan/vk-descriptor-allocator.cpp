@@ -4,6 +4,47 @@
 
 namespace gfx
 {
+void DescriptorSetContents::addEntry(VkWriteDescriptorSet const& write)
+{
+    assert(write.descriptorCount == 1);
+
+    DescriptorSetEntry entry;
+    memset(&entry, 0, sizeof(entry));
+    entry.binding = write.dstBinding;
+    entry.arrayElement = write.dstArrayElement;
+    entry.type = write.descriptorType;
+    if (write.pImageInfo)
+        entry.imageInfo = *write.pImageInfo;
+    if (write.pBufferInfo)
+        entry.bufferInfo = *write.pBufferInfo;
+    if (write.pTexelBufferView)
+        entry.texelBufferView = *write.pTexelBufferView;
+    if (write.descriptorType == VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR)
+    {
+        auto asWrite = (VkWriteDescriptorSetAccelerationStructureKHR const*)write.pNext;
+        entry.accelerationStructure = asWrite->pAccelerationStructures[0];
+    }
+    entries.add(entry);
+}
+
+Slang::HashCode64 DescriptorSetContents::getHashCode() const
+{
+    return Slang::combineHash(
+        Slang::getHashCode(layout),
+        Slang::getHashCode(
+            (const char*)entries.getBuffer(),
+            entries.getCount() * sizeof(DescriptorSetEntry)));
+}
+
+bool DescriptorSetContents::operator==(DescriptorSetContents const& other) const
+{
+    return layout == other.layout && entries.getCount() == other.entries.getCount() &&
+           memcmp(
+               entries.getBuffer(),
+               other.entries.getBuffer(),
+               entries.getCount() * sizeof(DescriptorSetEntry)) == 0;
+}
+
 VkDescriptorPool DescriptorSetAllocator::newPool()
 {
     VkDescriptorPoolCreateInfo descriptorPoolInfo = {VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO};
@@ -82,4 +123,66 @@ VulkanDescriptorSet DescriptorSetAllocator::allocate(VkDescriptorSetLayout layou
     assert(!"descriptor set allocation failed.");
     return rs;
 }
+
+VkDescriptorSet DescriptorSetAllocator::getOrWriteSet(DescriptorSetContents const& contents)
+{
+    if (auto cachedSet = m_cachedSets.tryGetValue(contents))
+        return *cachedSet;
+
+    VkDescriptorSet descriptorSet = allocate(contents.layout).handle;
+
+    Slang::Index entryCount = contents.entries.getCount();
+    Slang::List<VkWriteDescriptorSet> writes;
+    Slang::List<VkWriteDescriptorSetAccelerationStructureKHR> accelerationStructureWrites;
+    writes.setCount(entryCount);
+    accelerationStructureWrites.setCount(entryCount);
+    for (Slang::Index i = 0; i < entryCount; i++)
+    {
+        auto& entry = contents.entries[i];
+        VkWriteDescriptorSet write = {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET};
+        write.dstSet = descriptorSet;
+        write.dstBinding = entry.binding;
+        write.dstArrayElement = entry.arrayElement;
+        write.descriptorCount = 1;
+        write.descriptorType = entry.type;
+        switch (entry.type)
+        {
+        case VK_DESCRIPTOR_TYPE_SAMPLER:
+        case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
+        case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+        case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+            write.pImageInfo = &entry.imageInfo;
+            break;
+        case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:
+        case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER:
+            write.pTexelBufferView = &entry.texelBufferView;
+            break;
+        case VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR:
+            {
+                auto& asWrite = accelerationStructureWrites[i];
+                asWrite = {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET_ACCELERATION_STRUCTURE_KHR};
+                asWrite.accelerationStructureCount = 1;
+                asWrite.pAccelerationStructures = &entry.accelerationStructure;
+                write.pNext = &asWrite;
+            }
+            break;
+        default:
+            write.pBufferInfo = &entry.bufferInfo;
+            break;
+        }
+        writes[i] = write;
+    }
+    if (entryCount)
+    {
+        m_api->vkUpdateDescriptorSets(
+            m_api->m_device,
+            (uint32_t)entryCount,
+            writes.getBuffer(),
+            0,
+            nullptr);
+    }
+
+    m_cachedSets.add(contents, descriptorSet);
+    return descriptorSet;
+}
 } // namespace gfx
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "core/slang-dictionary.h"
 #include "core/slang-list.h"
 #include "vk-api.h"
 
@@ -12,6 +13,33 @@ struct VulkanDescriptorSet
     VkDescriptorSet handle;
     VkDescriptorPool pool;
 };
+
+/// A single descriptor written into a descriptor set. The fields that the descriptor's type
+/// doesn't use are left zeroed, so that descriptors can be hashed and compared by their bytes.
+struct DescriptorSetEntry
+{
+    uint32_t binding;
+    uint32_t arrayElement;
+    VkDescriptorType type;
+    VkDescriptorImageInfo imageInfo;
+    VkDescriptorBufferInfo bufferInfo;
+    VkBufferView texelBufferView;
+    VkAccelerationStructureKHR accelerationStructure;
+};
+
+/// The layout of a descriptor set and all the descriptors that are written into it.
+struct DescriptorSetContents
+{
+    VkDescriptorSetLayout layout = VK_NULL_HANDLE;
+    Slang::List<DescriptorSetEntry> entries;
+
+    /// Add the descriptor described by `write`, whose `dstSet` is ignored.
+    void addEntry(VkWriteDescriptorSet const& write);
+
+    Slang::HashCode64 getHashCode() const;
+    bool operator==(DescriptorSetContents const& other) const;
+};
+
 class DescriptorSetAllocator
 {
 public:
@@ -25,12 +53,18 @@ public:
         return newPool();
     }
     VulkanDescriptorSet allocate(VkDescriptorSetLayout layout);
+
+    /// Get a descriptor set holding `contents`. A set that was already written with the same
+    /// contents since the last `reset` is reused, otherwise a new set is allocated and all
+    /// of its descriptors are written with a single `vkUpdateDescriptorSets` call.
+    VkDescriptorSet getOrWriteSet(DescriptorSetContents const& contents);
     void free(VulkanDescriptorSet set)
     {
         m_api->vkFreeDescriptorSets(m_api->m_device, set.pool, 1, &set.handle);
     }
     void reset()
     {
+        m_cachedSets.clear();
         for (auto pool : pools)
             m_api->vkResetDescriptorPool(m_api->m_device, pool, 0);
     }
@@ -39,5 +73,11 @@ public:
         for (auto pool : pools)
             m_api->vkDestroyDescriptorPool(m_api->m_device, pool, nullptr);
     }
+
+private:
+    // The sets written by `getOrWriteSet` since the pools were last reset. Sets are not
+    // cached across resets, since the resources their descriptors refer to may have been
+    // destroyed and their handles reused by then.
+    Slang::Dictionary<DescriptorSetContents, VkDescriptorSet> m_cachedSets;
 };
 } // namespace gfx
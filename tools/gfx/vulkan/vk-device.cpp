@@ -1,6 +1,8 @@
 // vk-device.cpp
 #include "vk-device.h"
 
+#include "core/slang-crypto.h"
+#include "core/slang-io.h"
 #include "core/slang-platform.h"
 #include "vk-buffer.h"
 #include "vk-command-queue.h"
@@ -54,9 +56,16 @@ DeviceImpl::~DeviceImpl()
     }
 
     m_shaderObjectLayoutCache = decltype(m_shaderObjectLayoutCache)();
+    m_recordedSpecializations = decltype(m_recordedSpecializations)();
     shaderCache.free();
     m_deviceObjectsWithPotentialBackReferences.clearAndDeallocate();
 
+    if (m_pipelineCache != VK_NULL_HANDLE)
+    {
+        _savePipelineCache();
+        m_api.vkDestroyPipelineCache(m_device, m_pipelineCache, nullptr);
+    }
+
     if (m_api.vkDestroySampler)
     {
         m_api.vkDestroySampler(m_device, m_defaultSampler, nullptr);
@@ -159,7 +168,8 @@ Result DeviceImpl::initVulkanInstanceAndDevice(
 {
     m_features.clear();
 
-    m_queueAllocCount = 0;
+    for (auto& count : m_queueAllocCounts)
+        count = 0;
 
     bool enableRayTracingValidation = false;
 
@@ -922,6 +932,37 @@ Result DeviceImpl::initVulkanInstanceAndDevice(
     m_queueFamilyIndex = m_api.findQueue(VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT);
     assert(m_queueFamilyIndex >= 0);
 
+    // Compute and copy queues run on dedicated families where the device has them, so that
+    // their work can overlap with the graphics queue. We can't create queues of other families
+    // on a device that the application created.
+    m_computeQueueFamilyIndex = m_queueFamilyIndex;
+    m_transferQueueFamilyIndex = m_queueFamilyIndex;
+    if (handles[2].handleValue == 0)
+    {
+        int computeQueueFamilyIndex =
+            m_api.findQueue(VK_QUEUE_COMPUTE_BIT, VK_QUEUE_GRAPHICS_BIT);
+        if (computeQueueFamilyIndex >= 0)
+            m_computeQueueFamilyIndex = computeQueueFamilyIndex;
+        int transferQueueFamilyIndex = m_api.findQueue(
+            VK_QUEUE_TRANSFER_BIT,
+            VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT);
+        m_transferQueueFamilyIndex =
+            transferQueueFamilyIndex >= 0 ? transferQueueFamilyIndex : m_computeQueueFamilyIndex;
+    }
+    m_api.m_queueFamilyIndexCount = 0;
+    for (auto queueFamilyIndex :
+         {m_queueFamilyIndex, m_computeQueueFamilyIndex, m_transferQueueFamilyIndex})
+    {
+        bool isNewFamily = true;
+        for (uint32_t i = 0; i < m_api.m_queueFamilyIndexCount; i++)
+        {
+            if (m_api.m_queueFamilyIndices[i] == queueFamilyIndex)
+                isNewFamily = false;
+        }
+        if (isNewFamily)
+            m_api.m_queueFamilyIndices[m_api.m_queueFamilyIndexCount++] = queueFamilyIndex;
+    }
+
 #if defined(GFX_NV_AFTERMATH)
     VkDeviceDiagnosticsConfigCreateInfoNV aftermathInfo = {};
 
@@ -959,12 +1000,18 @@ Result DeviceImpl::initVulkanInstanceAndDevice(
     if (handles[2].handleValue == 0)
     {
         float queuePriority = 0.0f;
-        VkDeviceQueueCreateInfo queueCreateInfo = {VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO};
-        queueCreateInfo.queueFamilyIndex = m_queueFamilyIndex;
-        queueCreateInfo.queueCount = 1;
-        queueCreateInfo.pQueuePriorities = &queuePriority;
+        VkDeviceQueueCreateInfo queueCreateInfos[3] = {};
+        for (uint32_t i = 0; i < m_api.m_queueFamilyIndexCount; i++)
+        {
+            auto& queueCreateInfo = queueCreateInfos[i];
+            queueCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+            queueCreateInfo.queueFamilyIndex = m_api.m_queueFamilyIndices[i];
+            queueCreateInfo.queueCount = 1;
+            queueCreateInfo.pQueuePriorities = &queuePriority;
+        }
 
-        deviceCreateInfo.pQueueCreateInfos = &queueCreateInfo;
+        deviceCreateInfo.queueCreateInfoCount = m_api.m_queueFamilyIndexCount;
+        deviceCreateInfo.pQueueCreateInfos = queueCreateInfos;
 
         deviceCreateInfo.enabledExtensionCount = uint32_t(deviceExtensions.getCount());
         deviceCreateInfo.ppEnabledExtensionNames = deviceExtensions.getBuffer();
@@ -988,6 +1035,74 @@ Result DeviceImpl::initVulkanInstanceAndDevice(
     return SLANG_OK;
 }
 
+// Can `data` be used to seed a pipeline cache for the physical device of `props`? Drivers
+// are meant to ignore data for other devices, but not all of them check it carefully.
+static bool _isCompatiblePipelineCacheData(
+    const VkPhysicalDeviceProperties& props,
+    const List<unsigned char>& data)
+{
+    VkPipelineCacheHeaderVersionOne header;
+    if (size_t(data.getCount()) < sizeof(header))
+        return false;
+    ::memcpy(&header, data.getBuffer(), sizeof(header));
+    return header.headerSize >= sizeof(header) && header.headerSize <= size_t(data.getCount()) &&
+           header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+           header.vendorID == props.vendorID && header.deviceID == props.deviceID &&
+           ::memcmp(header.pipelineCacheUUID, props.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+}
+
+Result DeviceImpl::_createPipelineCache(bool loadFromFile)
+{
+    VkPhysicalDeviceProperties props;
+    m_api.vkGetPhysicalDeviceProperties(m_api.m_physicalDevice, &props);
+
+    List<unsigned char> initialData;
+    if (loadFromFile && m_pipelineCacheFileName.getLength() &&
+        SLANG_SUCCEEDED(File::readAllBytes(m_pipelineCacheFileName, initialData)) &&
+        !_isCompatiblePipelineCacheData(props, initialData))
+    {
+        initialData.clear();
+    }
+
+    VkPipelineCacheCreateInfo createInfo = {VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO};
+    createInfo.initialDataSize = size_t(initialData.getCount());
+    createInfo.pInitialData = initialData.getBuffer();
+    SLANG_VK_RETURN_ON_FAIL(
+        m_api.vkCreatePipelineCache(m_device, &createInfo, nullptr, &m_pipelineCache));
+    return SLANG_OK;
+}
+
+void DeviceImpl::_savePipelineCache()
+{
+    if (!m_pipelineCacheFileName.getLength())
+        return;
+
+    size_t size = 0;
+    if (m_api.vkGetPipelineCacheData(m_device, m_pipelineCache, &size, nullptr) != VK_SUCCESS ||
+        size == 0)
+        return;
+    List<unsigned char> data;
+    data.setCount(Index(size));
+    if (m_api.vkGetPipelineCacheData(m_device, m_pipelineCache, &size, data.getBuffer()) !=
+        VK_SUCCESS)
+        return;
+    writePipelineCacheFile(m_pipelineCacheFileName, data.getBuffer(), size);
+}
+
+Result DeviceImpl::clearShaderCache()
+{
+    SLANG_RETURN_ON_FAIL(RendererBase::clearShaderCache());
+
+    // Start over with an empty pipeline cache, so the pipelines created so far aren't written
+    // back to the cleared directory when the device is destroyed.
+    if (m_pipelineCache != VK_NULL_HANDLE)
+    {
+        m_api.vkDestroyPipelineCache(m_device, m_pipelineCache, nullptr);
+        m_pipelineCache = VK_NULL_HANDLE;
+    }
+    return _createPipelineCache(false);
+}
+
 SlangResult DeviceImpl::initialize(const Desc& desc)
 {
     // Initialize device info.
@@ -1028,6 +1143,23 @@ SlangResult DeviceImpl::initialize(const Desc& desc)
         SLANG_RETURN_ON_FAIL(m_deviceQueue.init(m_api, queue, m_queueFamilyIndex));
     }
 
+    if (desc.shaderCache.shaderCachePath)
+    {
+        // Name the file after the physical device and driver, so that devices sharing a shader
+        // cache directory each keep their own data.
+        VkPhysicalDeviceProperties props;
+        m_api.vkGetPhysicalDeviceProperties(m_api.m_physicalDevice, &props);
+        DigestBuilder<SHA1> builder;
+        builder.append(props.vendorID);
+        builder.append(props.deviceID);
+        builder.append(props.driverVersion);
+        builder.append(props.pipelineCacheUUID, VK_UUID_SIZE);
+        m_pipelineCacheFileName = Path::combine(
+            desc.shaderCache.shaderCachePath,
+            "vk-pipeline-cache-" + builder.finalize().toString());
+    }
+    SLANG_RETURN_ON_FAIL(_createPipelineCache(true));
+
     SLANG_RETURN_ON_FAIL(slangContext.initialize(
         desc.slang,
         desc.extendedDescCount,
@@ -1097,16 +1229,19 @@ Result DeviceImpl::createTransientResourceHeap(
 
 Result DeviceImpl::createCommandQueue(const ICommandQueue::Desc& desc, ICommandQueue** outQueue)
 {
-    // Only support one queue for now.
-    if (m_queueAllocCount != 0)
+    auto queueTypeIndex = Index(desc.type);
+    if (queueTypeIndex < 0 || queueTypeIndex >= SLANG_COUNT_OF(m_queueAllocCounts))
+        return SLANG_E_INVALID_ARG;
+    // Only support one queue of each type for now.
+    if (m_queueAllocCounts[queueTypeIndex] != 0)
         return SLANG_FAIL;
-    auto queueFamilyIndex = m_api.findQueue(VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT);
+    auto queueFamilyIndex = getQueueFamilyIndex(desc.type);
     VkQueue vkQueue;
     m_api.vkGetDeviceQueue(m_api.m_device, queueFamilyIndex, 0, &vkQueue);
     RefPtr<CommandQueueImpl> result = new CommandQueueImpl();
-    result->init(this, vkQueue, queueFamilyIndex);
+    result->init(this, vkQueue, queueFamilyIndex, desc);
     returnComPtr(outQueue, result);
-    m_queueAllocCount++;
+    m_queueAllocCounts[queueTypeIndex]++;
     return SLANG_OK;
 }
 
@@ -1428,6 +1563,10 @@ uint32_t DeviceImpl::getQueueFamilyIndex(ICommandQueue::QueueType queueType)
 {
     switch (queueType)
     {
+    case ICommandQueue::QueueType::Compute:
+        return m_computeQueueFamilyIndex;
+    case ICommandQueue::QueueType::Copy:
+        return m_transferQueueFamilyIndex;
     case ICommandQueue::QueueType::Graphics:
     default:
         return m_queueFamilyIndex;
@@ -1510,7 +1649,7 @@ Result DeviceImpl::getTextureAllocationInfo(
 
     imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
     imageInfo.usage = _calcImageUsageFlags(desc.allowedStates, desc.memoryType, nullptr);
-    imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    m_api.initSharingMode(imageInfo);
 
     imageInfo.samples = (VkSampleCountFlagBits)desc.sampleDesc.numSamples;
 
@@ -1603,7 +1742,7 @@ Result DeviceImpl::createTextureResource(
 
     imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
     imageInfo.usage = _calcImageUsageFlags(desc.allowedStates, desc.memoryType, initData);
-    imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    m_api.initSharingMode(imageInfo);
 
     imageInfo.samples = (VkSampleCountFlagBits)desc.sampleDesc.numSamples;
 
@@ -184,6 +184,18 @@ public:
 
     uint32_t getQueueFamilyIndex(ICommandQueue::QueueType queueType);
 
+    // IShaderCache implementation
+    virtual SLANG_NO_THROW Result SLANG_MCALL clearShaderCache() override;
+
+    // Draws and dispatches fail without recording anything while their pipeline is pending.
+    virtual bool supportsAsyncPipelineSpecialization() override { return true; }
+
+    /// Create `m_pipelineCache`, seeded from the file written by an earlier device with the same
+    /// physical device and driver if there is a shader cache.
+    Result _createPipelineCache(bool loadFromFile);
+    /// Write the contents of `m_pipelineCache` to the file in the shader cache directory.
+    void _savePipelineCache();
+
 public:
     // DeviceImpl members.
 
@@ -199,12 +211,17 @@ public:
 
     VulkanDeviceQueue m_deviceQueue;
     uint32_t m_queueFamilyIndex;
+    // The queue families of compute and copy queues. These are dedicated families where the
+    // device has them, and `m_queueFamilyIndex` otherwise.
+    uint32_t m_computeQueueFamilyIndex;
+    uint32_t m_transferQueueFamilyIndex;
 
     Desc m_desc;
 
     DescriptorSetAllocator descriptorSetAllocator;
 
-    uint32_t m_queueAllocCount;
+    // The number of command queues created of each queue type.
+    uint32_t m_queueAllocCounts[3];
 
     // A list to hold objects that may have a strong back reference to the device
     // instance. Because of the pipeline cache in `RendererBase`, there could be a reference
@@ -220,6 +237,11 @@ public:
 
     VkSampler m_defaultSampler;
 
+    // The cache every pipeline of the device is created with. It is persisted in the shader
+    // cache directory, if there is one, so the driver doesn't compile the same pipelines again.
+    VkPipelineCache m_pipelineCache = VK_NULL_HANDLE;
+    String m_pipelineCacheFileName;
+
     RefPtr<FramebufferImpl> m_emptyFramebuffer;
 };
 
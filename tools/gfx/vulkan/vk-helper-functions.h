@@ -140,8 +140,10 @@ struct RootBindingContext
     /// The device being used
     DeviceImpl* device;
 
-    /// The descriptor sets that are being allocated and bound
-    List<VkDescriptorSet>* descriptorSets;
+    /// The contents of the descriptor sets that are being written and bound. The sets
+    /// themselves are only obtained from `descriptorSetAllocator` once all of their
+    /// descriptors are known, so that sets with unchanged contents can be reused.
+    List<DescriptorSetContents>* descriptorSets;
 
     /// Information about all the push-constant ranges that should be bound
     ConstArrayView<VkPushConstantRange> pushConstantRanges;
@@ -74,6 +74,13 @@ Result ShaderObjectImpl::setData(ShaderOffset const& inOffset, void const* data,
         size = availableSize - offset;
     }
 
+    // Setting data to the value that it already has doesn't require the constant buffer to be
+    // written again, which avoids new uploads for objects that are fully re-set between draws
+    // with only a few fields changing.
+    //
+    if (memcmp(dest + offset, data, size) == 0)
+        return SLANG_OK;
+
     memcpy(dest + offset, data, size);
 
     m_isConstantBufferDirty = true;
@@ -219,9 +226,7 @@ Result ShaderObjectImpl::init(IDevice* device, ShaderObjectLayoutImpl* layout)
 }
 
 Result ShaderObjectImpl::_writeOrdinaryData(
-    PipelineCommandEncoder* encoder,
-    IBufferResource* buffer,
-    Offset offset,
+    void* dest,
     Size destSize,
     ShaderObjectLayoutImpl* specializedLayout)
 {
@@ -231,7 +236,7 @@ Result ShaderObjectImpl::_writeOrdinaryData(
 
     SLANG_ASSERT(srcSize <= destSize);
 
-    encoder->uploadBufferDataImpl(buffer, offset, srcSize, src);
+    memcpy(dest, src, srcSize);
 
     // In the case where this object has any sub-objects of
     // existential/interface type, we need to recurse on those objects
@@ -311,9 +316,7 @@ Result ShaderObjectImpl::_writeOrdinaryData(
                 subObjectRangePendingDataOffset + i * subObjectRangePendingDataStride;
 
             subObject->_writeOrdinaryData(
-                encoder,
-                buffer,
-                offset + subObjectOffset,
+                (char*)dest + subObjectOffset,
                 destSize - subObjectOffset,
                 subObjectLayout);
         }
@@ -324,10 +327,10 @@ Result ShaderObjectImpl::_writeOrdinaryData(
 
 void ShaderObjectImpl::writeDescriptor(
     RootBindingContext& context,
+    uint32_t setIndex,
     VkWriteDescriptorSet const& write)
 {
-    auto device = context.device;
-    device->m_api.vkUpdateDescriptorSets(device->m_device, 1, &write, 0, nullptr);
+    (*context.descriptorSets)[setIndex].addEntry(write);
 }
 
 void ShaderObjectImpl::writeBufferDescriptor(
@@ -338,8 +341,6 @@ void ShaderObjectImpl::writeBufferDescriptor(
     Offset bufferOffset,
     Size bufferSize)
 {
-    auto descriptorSet = (*context.descriptorSets)[offset.bindingSet];
-
     VkDescriptorBufferInfo bufferInfo = {};
     if (buffer)
     {
@@ -354,10 +355,9 @@ void ShaderObjectImpl::writeBufferDescriptor(
     write.descriptorType = descriptorType;
     write.dstArrayElement = 0;
     write.dstBinding = offset.binding;
-    write.dstSet = descriptorSet;
     write.pBufferInfo = &bufferInfo;
 
-    writeDescriptor(context, write);
+    writeDescriptor(context, offset.bindingSet, write);
 }
 
 void ShaderObjectImpl::writeBufferDescriptor(
@@ -381,8 +381,6 @@ void ShaderObjectImpl::writePlainBufferDescriptor(
     VkDescriptorType descriptorType,
     ArrayView<RefPtr<ResourceViewInternalBase>> resourceViews)
 {
-    auto descriptorSet = (*context.descriptorSets)[offset.bindingSet];
-
     Index count = resourceViews.getCount();
     for (Index i = 0; i < count; ++i)
     {
@@ -407,10 +405,9 @@ void ShaderObjectImpl::writePlainBufferDescriptor(
         write.descriptorType = descriptorType;
         write.dstArrayElement = uint32_t(i);
         write.dstBinding = offset.binding;
-        write.dstSet = descriptorSet;
         write.pBufferInfo = &bufferInfo;
 
-        writeDescriptor(context, write);
+        writeDescriptor(context, offset.bindingSet, write);
     }
 }
 
@@ -420,8 +417,6 @@ void ShaderObjectImpl::writeTexelBufferDescriptor(
     VkDescriptorType descriptorType,
     ArrayView<RefPtr<ResourceViewInternalBase>> resourceViews)
 {
-    auto descriptorSet = (*context.descriptorSets)[offset.bindingSet];
-
     Index count = resourceViews.getCount();
     for (Index i = 0; i < count; ++i)
     {
@@ -441,10 +436,9 @@ void ShaderObjectImpl::writeTexelBufferDescriptor(
         write.descriptorType = descriptorType;
         write.dstArrayElement = uint32_t(i);
         write.dstBinding = offset.binding;
-        write.dstSet = descriptorSet;
         write.descriptorCount = 1;
         write.pTexelBufferView = &bufferView;
-        writeDescriptor(context, write);
+        writeDescriptor(context, offset.bindingSet, write);
     }
 }
 
@@ -454,8 +448,6 @@ void ShaderObjectImpl::writeTextureSamplerDescriptor(
     VkDescriptorType descriptorType,
     ArrayView<CombinedTextureSamplerSlot> slots)
 {
-    auto descriptorSet = (*context.descriptorSets)[offset.bindingSet];
-
     Index count = slots.getCount();
     for (Index i = 0; i < count; ++i)
     {
@@ -482,10 +474,9 @@ void ShaderObjectImpl::writeTextureSamplerDescriptor(
         write.descriptorType = descriptorType;
         write.dstArrayElement = uint32_t(i);
         write.dstBinding = offset.binding;
-        write.dstSet = descriptorSet;
         write.pImageInfo = &imageInfo;
 
-        writeDescriptor(context, write);
+        writeDescriptor(context, offset.bindingSet, write);
     }
 }
 
@@ -495,8 +486,6 @@ void ShaderObjectImpl::writeAccelerationStructureDescriptor(
     VkDescriptorType descriptorType,
     ArrayView<RefPtr<ResourceViewInternalBase>> resourceViews)
 {
-    auto descriptorSet = (*context.descriptorSets)[offset.bindingSet];
-
     Index count = resourceViews.getCount();
     for (Index i = 0; i < count; ++i)
     {
@@ -521,9 +510,8 @@ void ShaderObjectImpl::writeAccelerationStructureDescriptor(
         write.descriptorType = descriptorType;
         write.dstArrayElement = uint32_t(i);
         write.dstBinding = offset.binding;
-        write.dstSet = descriptorSet;
         write.pNext = &writeAS;
-        writeDescriptor(context, write);
+        writeDescriptor(context, offset.bindingSet, write);
     }
 }
 
@@ -533,8 +521,6 @@ void ShaderObjectImpl::writeTextureDescriptor(
     VkDescriptorType descriptorType,
     ArrayView<RefPtr<ResourceViewInternalBase>> resourceViews)
 {
-    auto descriptorSet = (*context.descriptorSets)[offset.bindingSet];
-
     Index count = resourceViews.getCount();
     for (Index i = 0; i < count; ++i)
     {
@@ -557,10 +543,9 @@ void ShaderObjectImpl::writeTextureDescriptor(
         write.descriptorType = descriptorType;
         write.dstArrayElement = uint32_t(i);
         write.dstBinding = offset.binding;
-        write.dstSet = descriptorSet;
         write.pImageInfo = &imageInfo;
 
-        writeDescriptor(context, write);
+        writeDescriptor(context, offset.bindingSet, write);
     }
 }
 
@@ -570,8 +555,6 @@ void ShaderObjectImpl::writeSamplerDescriptor(
     VkDescriptorType descriptorType,
     ArrayView<RefPtr<SamplerStateImpl>> samplers)
 {
-    auto descriptorSet = (*context.descriptorSets)[offset.bindingSet];
-
     Index count = samplers.getCount();
     for (Index i = 0; i < count; ++i)
     {
@@ -594,10 +577,9 @@ void ShaderObjectImpl::writeSamplerDescriptor(
         write.descriptorType = descriptorType;
         write.dstArrayElement = uint32_t(i);
         write.dstBinding = offset.binding;
-        write.dstSet = descriptorSet;
         write.pImageInfo = &imageInfo;
 
-        writeDescriptor(context, write);
+        writeDescriptor(context, offset.bindingSet, write);
     }
 }
 
@@ -629,12 +611,15 @@ Result ShaderObjectImpl::_ensureOrdinaryDataBufferCreatedIfNeeded(
     }
 
     // Once we have computed how large the buffer should be, we can allocate
-    // it from the transient resource heap.
+    // it from the transient resource heap. The memory is host visible, so we
+    // write it directly rather than recording a copy from a staging buffer.
     //
-    SLANG_RETURN_ON_FAIL(encoder->m_commandBuffer->m_transientHeap->allocateConstantBuffer(
+    void* constantBufferData = nullptr;
+    SLANG_RETURN_ON_FAIL(encoder->m_commandBuffer->m_transientHeap->allocateMappedConstantBuffer(
         m_constantBufferSize,
         m_constantBuffer,
-        m_constantBufferOffset));
+        m_constantBufferOffset,
+        constantBufferData));
 
     // Once the buffer is allocated, we can use `_writeOrdinaryData` to fill it in.
     //
@@ -642,12 +627,8 @@ Result ShaderObjectImpl::_ensureOrdinaryDataBufferCreatedIfNeeded(
     // where this object contains interface/existential-type fields, so we
     // don't need or want to inline it into this call site.
     //
-    SLANG_RETURN_ON_FAIL(_writeOrdinaryData(
-        encoder,
-        m_constantBuffer,
-        m_constantBufferOffset,
-        m_constantBufferSize,
-        specializedLayout));
+    SLANG_RETURN_ON_FAIL(
+        _writeOrdinaryData(constantBufferData, m_constantBufferSize, specializedLayout));
 
     return SLANG_OK;
 }
@@ -881,16 +862,14 @@ Result ShaderObjectImpl::allocateDescriptorSets(
     //
     for (auto descriptorSetInfo : specializedLayout->getOwnDescriptorSets())
     {
-        auto descriptorSetHandle =
-            context.descriptorSetAllocator->allocate(descriptorSetInfo.descriptorSetLayout).handle;
-
-        // For each set, we need to write it into the set of descriptor sets
-        // being used for binding. This is done both so that other steps
-        // in binding can find the set to fill it in, but also so that
-        // we can bind all the descriptor sets to the pipeline when the
-        // time comes.
+        // For each set, we need to add it to the sets being used for binding.
+        // This is done both so that other steps in binding can find the set
+        // to fill it in, but also so that we can get and bind all the
+        // descriptor sets to the pipeline when the time comes.
         //
-        (*context.descriptorSets).add(descriptorSetHandle);
+        DescriptorSetContents descriptorSetContents;
+        descriptorSetContents.layout = descriptorSetInfo.descriptorSetLayout;
+        (*context.descriptorSets).add(descriptorSetContents);
     }
 
     return SLANG_OK;
@@ -62,18 +62,18 @@ protected:
 
     Result init(IDevice* device, ShaderObjectLayoutImpl* layout);
 
-    /// Write the uniform/ordinary data of this object into the given `dest` buffer at the given
-    /// `offset`
+    /// Write the uniform/ordinary data of this object into the given `dest` memory
     Result _writeOrdinaryData(
-        PipelineCommandEncoder* encoder,
-        IBufferResource* buffer,
-        Offset offset,
+        void* dest,
         Size destSize,
         ShaderObjectLayoutImpl* specializedLayout);
 
 public:
-    /// Write a single descriptor using the Vulkan API
-    static void writeDescriptor(RootBindingContext& context, VkWriteDescriptorSet const& write);
+    /// Add a single descriptor to the contents of the descriptor set at `setIndex`
+    static void writeDescriptor(
+        RootBindingContext& context,
+        uint32_t setIndex,
+        VkWriteDescriptorSet const& write);
 
     static void writeBufferDescriptor(
         RootBindingContext& context,
@@ -13,23 +13,71 @@ using namespace Slang;
 namespace vk
 {
 
+Result ShaderTableImpl::getShaderGroupHandles(
+    RayTracingPipelineStateImpl* pipeline,
+    List<uint8_t>& outHandles)
+{
+    auto& vkApi = m_device->m_api;
+    auto handleSize = vkApi.m_rtProperties.shaderGroupHandleSize;
+    auto handleCount = pipeline->shaderGroupCount;
+    outHandles.setCount(handleSize * handleCount);
+    auto result = vkApi.vkGetRayTracingShaderGroupHandlesKHR(
+        m_device->m_device,
+        pipeline->m_pipeline,
+        0,
+        (uint32_t)handleCount,
+        outHandles.getCount(),
+        outHandles.getBuffer());
+    return result == VK_SUCCESS ? SLANG_OK : SLANG_FAIL;
+}
+
+void ShaderTableImpl::writeRecords(
+    uint8_t* dest,
+    uint32_t stride,
+    Index firstRecord,
+    uint32_t recordCount,
+    RayTracingPipelineStateImpl* pipeline,
+    const List<uint8_t>& handles)
+{
+    // Each record is the handle of the shader group named by the record, found by its index
+    // in the buffer of handles, followed by zeros up to the record stride.
+    auto handleSize = m_device->m_api.m_rtProperties.shaderGroupHandleSize;
+    memset(dest, 0, stride * recordCount);
+    for (uint32_t i = 0; i < recordCount; i++)
+    {
+        auto shaderGroupIndexPtr =
+            pipeline->shaderGroupNameToIndex.tryGetValue(m_shaderGroupNames[firstRecord + i]);
+        if (!shaderGroupIndexPtr)
+            continue;
+        memcpy(
+            dest + i * stride,
+            handles.getBuffer() + *shaderGroupIndexPtr * handleSize,
+            handleSize);
+    }
+}
+
 RefPtr<BufferResource> ShaderTableImpl::createDeviceBuffer(
     PipelineStateBase* pipeline,
     TransientResourceHeapBase* transientHeap,
     IResourceCommandEncoder* encoder)
 {
-    auto vkApi = m_device->m_api;
-    auto rtProps = vkApi.m_rtProperties;
-    uint32_t handleSize = rtProps.shaderGroupHandleSize;
-    m_raygenTableSize = m_rayGenShaderCount * rtProps.shaderGroupBaseAlignment;
+    auto rtProps = m_device->m_api.m_rtProperties;
+    // The miss, hit and callable records use the smallest stride the device allows, which is the
+    // stride `dispatchRays` gives for them.
+    auto recordStride = (uint32_t)VulkanUtil::calcAligned(
+        rtProps.shaderGroupHandleSize,
+        rtProps.shaderGroupHandleAlignment);
+    auto rayGenStride =
+        (uint32_t)VulkanUtil::calcAligned(recordStride, rtProps.shaderGroupBaseAlignment);
+    m_raygenTableSize = m_rayGenShaderCount * rayGenStride;
     m_missTableSize = (uint32_t)VulkanUtil::calcAligned(
-        m_missShaderCount * handleSize,
+        m_missShaderCount * recordStride,
         rtProps.shaderGroupBaseAlignment);
     m_hitTableSize = (uint32_t)VulkanUtil::calcAligned(
-        m_hitGroupCount * handleSize,
+        m_hitGroupCount * recordStride,
         rtProps.shaderGroupBaseAlignment);
     m_callableTableSize = (uint32_t)VulkanUtil::calcAligned(
-        m_callableShaderCount * handleSize,
+        m_callableShaderCount * recordStride,
         rtProps.shaderGroupBaseAlignment);
     uint32_t tableSize = m_raygenTableSize + m_missTableSize + m_hitTableSize + m_callableTableSize;
 
@@ -38,8 +86,10 @@ RefPtr<BufferResource> ShaderTableImpl::createDeviceBuffer(
     IBufferResource::Desc bufferDesc = {};
     bufferDesc.memoryType = MemoryType::DeviceLocal;
     bufferDesc.defaultState = ResourceState::General;
-    bufferDesc.allowedStates =
-        ResourceStateSet(ResourceState::General, ResourceState::CopyDestination);
+    bufferDesc.allowedStates = ResourceStateSet(
+        ResourceState::General,
+        ResourceState::CopyDestination,
+        ResourceState::ShaderResource);
     bufferDesc.type = IResource::Type::Buffer;
     bufferDesc.sizeInBytes = tableSize;
     static_cast<vk::DeviceImpl*>(m_device)->createBufferResourceImpl(
@@ -53,94 +103,41 @@ RefPtr<BufferResource> ShaderTableImpl::createDeviceBuffer(
 
     IBufferResource* stagingBuffer = nullptr;
     Offset stagingBufferOffset = 0;
+    void* stagingPtr = nullptr;
     transientHeapImpl
-        ->allocateStagingBuffer(tableSize, stagingBuffer, stagingBufferOffset, MemoryType::Upload);
+        ->allocateMappedStagingBuffer(tableSize, stagingBuffer, stagingBufferOffset, stagingPtr);
 
     assert(stagingBuffer);
-    void* stagingPtr = nullptr;
-    stagingBuffer->map(nullptr, &stagingPtr);
 
     List<uint8_t> handles;
-    auto handleCount = pipelineImpl->shaderGroupCount;
-    auto totalHandleSize = handleSize * handleCount;
-    handles.setCount(totalHandleSize);
-    auto result = vkApi.vkGetRayTracingShaderGroupHandlesKHR(
-        m_device->m_device,
-        pipelineImpl->m_pipeline,
-        0,
-        (uint32_t)handleCount,
-        totalHandleSize,
-        handles.getBuffer());
-
-    uint8_t* stagingBufferPtr = (uint8_t*)stagingPtr + stagingBufferOffset;
-    auto subTablePtr = stagingBufferPtr;
-    Int shaderTableEntryCounter = 0;
-
-    // Each loop calculates the copy source and destination locations by fetching the name
-    // of the shader group from the list of shader group names and getting its corresponding
-    // index in the buffer of handles.
-    for (uint32_t i = 0; i < m_rayGenShaderCount; i++)
-    {
-        auto dstHandlePtr = subTablePtr + i * rtProps.shaderGroupBaseAlignment;
-        auto shaderGroupName = m_shaderGroupNames[shaderTableEntryCounter++];
-        auto shaderGroupIndexPtr =
-            pipelineImpl->shaderGroupNameToIndex.tryGetValue(shaderGroupName);
-        if (!shaderGroupIndexPtr)
-            continue;
-
-        auto shaderGroupIndex = *shaderGroupIndexPtr;
-        auto srcHandlePtr = handles.getBuffer() + shaderGroupIndex * handleSize;
-        memcpy(dstHandlePtr, srcHandlePtr, handleSize);
-        memset(dstHandlePtr + handleSize, 0, rtProps.shaderGroupBaseAlignment - handleSize);
-    }
+    getShaderGroupHandles(pipelineImpl, handles);
+
+    uint8_t* subTablePtr = (uint8_t*)stagingPtr;
+    memset(subTablePtr, 0, tableSize);
+    Index firstRecord = 0;
+    writeRecords(
+        subTablePtr,
+        rayGenStride,
+        firstRecord,
+        m_rayGenShaderCount,
+        pipelineImpl,
+        handles);
     subTablePtr += m_raygenTableSize;
-
-    for (uint32_t i = 0; i < m_missShaderCount; i++)
-    {
-        auto dstHandlePtr = subTablePtr + i * handleSize;
-        auto shaderGroupName = m_shaderGroupNames[shaderTableEntryCounter++];
-        auto shaderGroupIndexPtr =
-            pipelineImpl->shaderGroupNameToIndex.tryGetValue(shaderGroupName);
-        if (!shaderGroupIndexPtr)
-            continue;
-
-        auto shaderGroupIndex = *shaderGroupIndexPtr;
-        auto srcHandlePtr = handles.getBuffer() + shaderGroupIndex * handleSize;
-        memcpy(dstHandlePtr, srcHandlePtr, handleSize);
-    }
+    firstRecord += m_rayGenShaderCount;
+    writeRecords(subTablePtr, recordStride, firstRecord, m_missShaderCount, pipelineImpl, handles);
     subTablePtr += m_missTableSize;
-
-    for (uint32_t i = 0; i < m_hitGroupCount; i++)
-    {
-        auto dstHandlePtr = subTablePtr + i * handleSize;
-        auto shaderGroupName = m_shaderGroupNames[shaderTableEntryCounter++];
-        auto shaderGroupIndexPtr =
-            pipelineImpl->shaderGroupNameToIndex.tryGetValue(shaderGroupName);
-        if (!shaderGroupIndexPtr)
-            continue;
-
-        auto shaderGroupIndex = *shaderGroupIndexPtr;
-        auto srcHandlePtr = handles.getBuffer() + shaderGroupIndex * handleSize;
-        memcpy(dstHandlePtr, srcHandlePtr, handleSize);
-    }
+    firstRecord += m_missShaderCount;
+    writeRecords(subTablePtr, recordStride, firstRecord, m_hitGroupCount, pipelineImpl, handles);
     subTablePtr += m_hitTableSize;
+    firstRecord += m_hitGroupCount;
+    writeRecords(
+        subTablePtr,
+        recordStride,
+        firstRecord,
+        m_callableShaderCount,
+        pipelineImpl,
+        handles);
 
-    for (uint32_t i = 0; i < m_callableShaderCount; i++)
-    {
-        auto dstHandlePtr = subTablePtr + i * handleSize;
-        auto shaderGroupName = m_shaderGroupNames[shaderTableEntryCounter++];
-        auto shaderGroupIndexPtr =
-            pipelineImpl->shaderGroupNameToIndex.tryGetValue(shaderGroupName);
-        if (!shaderGroupIndexPtr)
-            continue;
-
-        auto shaderGroupIndex = *shaderGroupIndexPtr;
-        auto srcHandlePtr = handles.getBuffer() + shaderGroupIndex * handleSize;
-        memcpy(dstHandlePtr, srcHandlePtr, handleSize);
-    }
-    subTablePtr += m_callableTableSize;
-
-    stagingBuffer->unmap(nullptr);
     encoder->copyBuffer(bufferResource, 0, stagingBuffer, stagingBufferOffset, tableSize);
     encoder->bufferBarrier(
         1,
@@ -151,5 +148,60 @@ RefPtr<BufferResource> ShaderTableImpl::createDeviceBuffer(
     return _Move(resultPtr);
 }
 
+Result ShaderTableImpl::updateDeviceBufferHitGroups(
+    PipelineStateBase* pipeline,
+    BufferResource* buffer,
+    uint32_t firstHitGroup,
+    uint32_t hitGroupCount,
+    TransientResourceHeapBase* transientHeap,
+    IResourceCommandEncoder* encoder)
+{
+    auto rtProps = m_device->m_api.m_rtProperties;
+    auto recordStride = (uint32_t)VulkanUtil::calcAligned(
+        rtProps.shaderGroupHandleSize,
+        rtProps.shaderGroupHandleAlignment);
+    auto pipelineImpl = static_cast<RayTracingPipelineStateImpl*>(pipeline);
+
+    List<uint8_t> handles;
+    SLANG_RETURN_ON_FAIL(getShaderGroupHandles(pipelineImpl, handles));
+
+    Size updateSize = hitGroupCount * recordStride;
+    IBufferResource* stagingBuffer = nullptr;
+    Offset stagingBufferOffset = 0;
+    void* stagingPtr = nullptr;
+    SLANG_RETURN_ON_FAIL(static_cast<TransientResourceHeapImpl*>(transientHeap)
+                             ->allocateMappedStagingBuffer(
+                                 updateSize,
+                                 stagingBuffer,
+                                 stagingBufferOffset,
+                                 stagingPtr));
+    writeRecords(
+        (uint8_t*)stagingPtr,
+        recordStride,
+        m_rayGenShaderCount + m_missShaderCount + firstHitGroup,
+        hitGroupCount,
+        pipelineImpl,
+        handles);
+
+    IBufferResource* bufferResource = buffer;
+    encoder->bufferBarrier(
+        1,
+        &bufferResource,
+        gfx::ResourceState::ShaderResource,
+        gfx::ResourceState::CopyDestination);
+    encoder->copyBuffer(
+        bufferResource,
+        m_raygenTableSize + m_missTableSize + firstHitGroup * recordStride,
+        stagingBuffer,
+        stagingBufferOffset,
+        updateSize);
+    encoder->bufferBarrier(
+        1,
+        &bufferResource,
+        gfx::ResourceState::CopyDestination,
+        gfx::ResourceState::ShaderResource);
+    return SLANG_OK;
+}
+
 } // namespace vk
 } // namespace gfx
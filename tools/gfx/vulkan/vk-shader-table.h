@@ -25,6 +25,26 @@ public:
         PipelineStateBase* pipeline,
         TransientResourceHeapBase* transientHeap,
         IResourceCommandEncoder* encoder) override;
+
+    virtual Result updateDeviceBufferHitGroups(
+        PipelineStateBase* pipeline,
+        BufferResource* buffer,
+        uint32_t firstHitGroup,
+        uint32_t hitGroupCount,
+        TransientResourceHeapBase* transientHeap,
+        IResourceCommandEncoder* encoder) override;
+
+private:
+    Result getShaderGroupHandles(RayTracingPipelineStateImpl* pipeline, List<uint8_t>& outHandles);
+
+    // Write the records `[firstRecord, firstRecord + recordCount)` of the table to `dest`.
+    void writeRecords(
+        uint8_t* dest,
+        uint32_t stride,
+        Index firstRecord,
+        uint32_t recordCount,
+        RayTracingPipelineStateImpl* pipeline,
+        const List<uint8_t>& handles);
 };
 
 } // namespace vk
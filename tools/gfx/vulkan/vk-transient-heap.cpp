@@ -41,8 +41,8 @@ Result TransientResourceHeapImpl::init(const ITransientResourceHeap::Desc& desc,
     VkCommandPoolCreateInfo poolCreateInfo = {};
     poolCreateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
     poolCreateInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
-    poolCreateInfo.queueFamilyIndex =
-        device->getQueueFamilyIndex(ICommandQueue::QueueType::Graphics);
+    m_queueType = desc.queueType;
+    poolCreateInfo.queueFamilyIndex = device->getQueueFamilyIndex(m_queueType);
     device->m_api
         .vkCreateCommandPool(device->m_api.m_device, &poolCreateInfo, nullptr, &m_commandPool);
 
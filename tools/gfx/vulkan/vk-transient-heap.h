@@ -21,6 +21,8 @@ private:
 
 public:
     VkCommandPool m_commandPool;
+    // The type of the queues that the command buffers are submitted to.
+    ICommandQueue::QueueType m_queueType = ICommandQueue::QueueType::Graphics;
     DescriptorSetAllocator m_descSetAllocator;
     List<VkFence> m_fences;
     Index m_fenceIndex = -1;
@@ -174,6 +174,25 @@ static rhi::DeviceType _toRenderType(Slang::RenderApiType apiType)
         {
             outOptions.performanceProfile = true;
         }
+        else if (argValue == "-profile-warmup" || argValue == "-profile-iterations")
+        {
+            CommandLineArg countArg;
+            SLANG_RETURN_ON_FAIL(reader.expectArg(countArg));
+            Int count = 0;
+            if (SLANG_FAILED(StringUtil::parseInt(countArg.value.getUnownedSlice(), count)) ||
+                count < 0 || (count == 0 && argValue == "-profile-iterations"))
+            {
+                sink.diagnose(
+                    countArg.loc,
+                    RenderTestDiagnostics::invalidProfileCount,
+                    argValue);
+                return SLANG_FAIL;
+            }
+            if (argValue == "-profile-warmup")
+                outOptions.profileWarmupCount = int(count);
+            else
+                outOptions.profileIterationCount = int(count);
+        }
         else if (argValue == "-output-using-type")
         {
             outOptions.outputUsingType = true;
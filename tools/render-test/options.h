@@ -68,6 +68,10 @@ struct Options
     bool onlyStartup = false;
 
     bool performanceProfile = false;
+    /// With `performanceProfile`, the number of untimed runs before the timed runs, and the
+    /// number of timed runs.
+    int profileWarmupCount = 2;
+    int profileIterationCount = 10;
 
     bool dontAddDefaultEntryPoints = false;
 
@@ -56,11 +56,14 @@ static const int kVertexCount = SLANG_COUNT_OF(kVertexData);
 
 using namespace Slang;
 
-static void _outputProfileTime(uint64_t startTicks, uint64_t endTicks)
+// Print the minimum, median and maximum of `times` as `<name>-min=<time>`, etc.
+static void _outputProfileTimes(const char* name, List<double>& times)
 {
+    times.sort();
     WriterHelper out = StdWriters::getOut();
-    double time = double(endTicks - startTicks) / Process::getClockFrequency();
-    out.print("profile-time=%g\n", time);
+    out.print("%s-min=%g\n", name, times[0]);
+    out.print("%s-median=%g\n", name, times[times.getCount() / 2]);
+    out.print("%s-max=%g\n", name, times.getLast());
 }
 
 class ProgramVars;
@@ -106,7 +109,10 @@ protected:
     void _initializeRenderPass();
     void _initializeAccelerationStructure();
 
-    uint64_t m_startTicks;
+    /// Record the dispatch or draw of the test.
+    Result _encodeCommands(ICommandEncoder* encoder);
+    /// Run the test repeatedly, printing the times of the runs.
+    Result _runPerformanceProfile();
 
     // variables for state to be used for rendering...
     uintptr_t m_constantBufferSize;
@@ -919,9 +925,8 @@ Result RenderTestApp::writeScreen(const String& filename)
     return PngSerializeUtil::write(filename.getBuffer(), blob, width, height);
 }
 
-Result RenderTestApp::update()
+Result RenderTestApp::_encodeCommands(ICommandEncoder* encoder)
 {
-    auto encoder = m_queue->createCommandEncoder();
     if (m_options.shaderType == Options::ShaderProgramType::Compute)
     {
         auto rootObject = m_device->createRootShaderObject(m_pipeline);
@@ -989,74 +994,105 @@ Result RenderTestApp::update()
         }
         passEncoder->end();
     }
-    m_startTicks = Process::getClockTick();
-    m_queue->submit(encoder->finish());
-    m_queue->waitOnHost();
+    return SLANG_OK;
+}
 
-    // If we are in a mode where output is requested, we need to snapshot the back buffer here
-    if (m_options.outputPath.getLength() || m_options.performanceProfile)
+Result RenderTestApp::_runPerformanceProfile()
+{
+    // Each run is submitted and waited for on its own, and timed on the host, and with timestamp
+    // queries around its commands if the device supports them. The results of the warmup runs,
+    // which include creating any lazily created state, are left out.
+    const int warmupCount = m_options.profileWarmupCount;
+    const int iterationCount = m_options.profileIterationCount;
+
+    ComPtr<IQueryPool> queryPool;
+    const uint64_t timestampFrequency = m_device->getDeviceInfo().timestampFrequency;
+    if (timestampFrequency)
     {
-        // Wait until everything is complete
+        QueryPoolDesc queryPoolDesc = {};
+        queryPoolDesc.type = QueryType::Timestamp;
+        queryPoolDesc.count = 2;
+        if (SLANG_FAILED(m_device->createQueryPool(queryPoolDesc, queryPool.writeRef())))
+            queryPool = nullptr;
+    }
 
-        if (m_options.performanceProfile)
-        {
-#if 0
-            // It might not be enough on some APIs to 'waitForGpu' to mean the computation has completed. Let's lock an output
-            // buffer to be sure
-            if (m_bindingState->outputBindings.getCount() > 0)
-            {
-                const auto& binding = m_bindingState->outputBindings[0];
-                auto i = binding.entryIndex;
-                const auto& layoutBinding = m_shaderInputLayout.entries[i];
+    List<double> hostTimes;
+    List<double> gpuTimes;
+    for (int i = 0; i < warmupCount + iterationCount; ++i)
+    {
+        if (queryPool)
+            queryPool->reset();
 
-                assert(layoutBinding.isOutput);
-                
-                if (binding.resource && binding.resource->isBuffer())
-                {
-                    BufferResource* bufferResource = static_cast<BufferResource*>(binding.resource.Ptr());
-                    const size_t bufferSize = bufferResource->getDesc().size;
-                    unsigned int* ptr = (unsigned int*)m_renderer->map(bufferResource, MapFlavor::HostRead);
-                    if (!ptr)
-                    {                            
-                        return SLANG_FAIL;
-                    }
-                    m_renderer->unmap(bufferResource);
-                }
-            }
-#endif
+        auto encoder = m_queue->createCommandEncoder();
+        if (queryPool)
+            encoder->writeTimestamp(queryPool, 0);
+        SLANG_RETURN_ON_FAIL(_encodeCommands(encoder));
+        if (queryPool)
+            encoder->writeTimestamp(queryPool, 1);
 
-            // Note we don't do the same with screen rendering -> as that will do a lot of work,
-            // which may swamp any computation so can only really profile compute shaders at the
-            // moment
+        const uint64_t startTicks = Process::getClockTick();
+        m_queue->submit(encoder->finish());
+        m_queue->waitOnHost();
+        const uint64_t endTicks = Process::getClockTick();
+
+        if (i < warmupCount)
+            continue;
+        hostTimes.add(double(endTicks - startTicks) / Process::getClockFrequency());
+        uint64_t timestamps[2];
+        if (queryPool && SLANG_SUCCEEDED(queryPool->getResult(0, 2, timestamps)))
+            gpuTimes.add(double(timestamps[1] - timestamps[0]) / double(timestampFrequency));
+    }
+
+    // Every line is a `name=value` pair, and the times are in seconds. `profile-time` is the
+    // median GPU time if there is one, and the median host time otherwise.
+    WriterHelper out = StdWriters::getOut();
+    out.print("profile-warmup=%d\n", warmupCount);
+    out.print("profile-iterations=%d\n", iterationCount);
+    _outputProfileTimes("profile-host-time", hostTimes);
+    if (gpuTimes.getCount() == iterationCount)
+    {
+        _outputProfileTimes("profile-gpu-time", gpuTimes);
+        out.print("profile-time=%g\n", gpuTimes[gpuTimes.getCount() / 2]);
+    }
+    else
+    {
+        out.print("profile-time=%g\n", hostTimes[hostTimes.getCount() / 2]);
+    }
+    return SLANG_OK;
+}
 
-            const uint64_t endTicks = Process::getClockTick();
+Result RenderTestApp::update()
+{
+    auto encoder = m_queue->createCommandEncoder();
+    SLANG_RETURN_ON_FAIL(_encodeCommands(encoder));
+    m_queue->submit(encoder->finish());
+    m_queue->waitOnHost();
 
-            _outputProfileTime(m_startTicks, endTicks);
+    // If we are in a mode where output is requested, we need to snapshot the back buffer here
+    if (m_options.outputPath.getLength())
+    {
+        if (m_options.shaderType == Options::ShaderProgramType::Compute ||
+            m_options.shaderType == Options::ShaderProgramType::GraphicsCompute ||
+            m_options.shaderType == Options::ShaderProgramType::GraphicsMeshCompute ||
+            m_options.shaderType == Options::ShaderProgramType::GraphicsTaskMeshCompute)
+        {
+            SLANG_RETURN_ON_FAIL(writeBindingOutput(m_options.outputPath));
         }
-
-        if (m_options.outputPath.getLength())
+        else
         {
-            if (m_options.shaderType == Options::ShaderProgramType::Compute ||
-                m_options.shaderType == Options::ShaderProgramType::GraphicsCompute ||
-                m_options.shaderType == Options::ShaderProgramType::GraphicsMeshCompute ||
-                m_options.shaderType == Options::ShaderProgramType::GraphicsTaskMeshCompute)
-            {
-                auto request = m_compilationOutput.output.getRequestForReflection();
-                auto slangReflection = (slang::ShaderReflection*)spGetReflection(request);
-
-                SLANG_RETURN_ON_FAIL(writeBindingOutput(m_options.outputPath));
-            }
-            else
+            SlangResult res = writeScreen(m_options.outputPath);
+            if (SLANG_FAILED(res))
             {
-                SlangResult res = writeScreen(m_options.outputPath);
-                if (SLANG_FAILED(res))
-                {
-                    fprintf(stderr, "ERROR: failed to write screen capture to file\n");
-                    return res;
-                }
+                fprintf(stderr, "ERROR: failed to write screen capture to file\n");
+                return res;
             }
         }
-        return SLANG_OK;
+    }
+
+    // The output is written first, since repeated runs can change the contents of the buffers.
+    if (m_options.performanceProfile)
+    {
+        SLANG_RETURN_ON_FAIL(_runPerformanceProfile());
     }
     return SLANG_OK;
 }
@@ -0,0 +1,598 @@
+// slang-benchmark-main.cpp
+
+// Measures the time spent in the compile stages that are paid on every shader
+// (re)load, by driving the COM API in-process.
+//
+// Each workload is run `-warmup` times without being recorded, followed by
+// `-repeat` recorded runs. Every run reports the time spent in each of its phases,
+// and the results are summarized per phase as a table on stdout, and optionally
+// as JSON via `-json <path>`.
+
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-list.h"
+#include "../../source/core/slang-process.h"
+#include "../../source/core/slang-std-writers.h"
+#include "../../source/core/slang-string-escape-util.h"
+#include "../../source/core/slang-string.h"
+#include "slang-com-helper.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+
+#include <algorithm>
+#include <stdio.h>
+
+using namespace Slang;
+
+static const char* kDefaultSource = R"(
+interface IMaterial
+{
+    float3 shade(float3 normal, float3 lightDir);
+}
+
+struct Lambert : IMaterial
+{
+    float3 albedo;
+    float3 shade(float3 normal, float3 lightDir)
+    {
+        return albedo * max(dot(normal, lightDir), 0.0);
+    }
+}
+
+struct Phong : IMaterial
+{
+    float3 diffuse;
+    float3 specular;
+    float shininess;
+    float3 shade(float3 normal, float3 lightDir)
+    {
+        float3 r = reflect(-lightDir, normal);
+        return diffuse * max(dot(normal, lightDir), 0.0) +
+               specular * pow(max(r.z, 0.0), shininess);
+    }
+}
+
+float3 shadeAll<M : IMaterial>(M material, float3 normal, float3 lightDirs[4])
+{
+    float3 result = float3(0.0);
+    [ForceUnroll]
+    for (int i = 0; i < 4; i++)
+        result += material.shade(normal, lightDirs[i]);
+    return result;
+}
+
+struct Uniforms
+{
+    float4x4 modelViewProjection;
+    float3 lightDirs[4];
+    Lambert lambert;
+    Phong phong;
+}
+
+ConstantBuffer<Uniforms> gUniforms;
+Texture2D gTexture;
+SamplerState gSampler;
+RWStructuredBuffer<float4> gOutput;
+
+struct VertexOutput
+{
+    float4 position : SV_Position;
+    float3 normal : NORMAL;
+    float2 uv : TEXCOORD;
+}
+
+[shader("vertex")]
+VertexOutput vertexMain(float3 position : POSITION, float3 normal : NORMAL, float2 uv : TEXCOORD)
+{
+    VertexOutput output;
+    output.position = mul(gUniforms.modelViewProjection, float4(position, 1.0));
+    output.normal = normal;
+    output.uv = uv;
+    return output;
+}
+
+[shader("fragment")]
+float4 fragmentMain(VertexOutput input) : SV_Target
+{
+    float3 n = normalize(input.normal);
+    float3 color = shadeAll(gUniforms.lambert, n, gUniforms.lightDirs) +
+                   shadeAll(gUniforms.phong, n, gUniforms.lightDirs);
+    return float4(color, 1.0) * gTexture.Sample(gSampler, input.uv);
+}
+
+[shader("compute")]
+[numthreads(64, 1, 1)]
+void computeMain(uint3 tid : SV_DispatchThreadID)
+{
+    float3 n = normalize(float3(float(tid.x), 1.0, 0.0));
+    gOutput[tid.x] = float4(shadeAll(gUniforms.phong, n, gUniforms.lightDirs), 1.0);
+}
+)";
+
+struct BenchmarkOptions
+{
+    Count warmupCount = 1;
+    Count repeatCount = 5;
+    String source = kDefaultSource;
+    String sourcePath = "benchmark.slang";
+    String jsonPath;
+    List<String> workloadFilter;
+};
+
+/// The time spent in each phase during a single run of a workload.
+struct RunTimes
+{
+    void add(const char* phase, uint64_t elapsedTicks)
+    {
+        phases.add(phase);
+        ticks.add(elapsedTicks);
+    }
+
+    List<const char*> phases;
+    List<uint64_t> ticks;
+};
+
+/// Times a block of code, adding the elapsed ticks to `RunTimes` under `phase`.
+struct PhaseTimer
+{
+    PhaseTimer(RunTimes& times, const char* phase)
+        : m_times(times), m_phase(phase), m_startTick(Process::getClockTick())
+    {
+    }
+    ~PhaseTimer() { m_times.add(m_phase, Process::getClockTick() - m_startTick); }
+
+    RunTimes& m_times;
+    const char* m_phase;
+    uint64_t m_startTick;
+};
+
+struct PhaseResult
+{
+    String name;
+    List<double> samplesMS;
+};
+
+struct WorkloadResult
+{
+    String name;
+    SlangResult result = SLANG_OK;
+    String message;
+    List<PhaseResult> phases;
+};
+
+class Benchmark
+{
+public:
+    typedef SlangResult (Benchmark::*WorkloadFunc)(RunTimes& times);
+
+    SlangResult init(const BenchmarkOptions& options);
+    void runWorkload(const char* name, WorkloadFunc func);
+
+    void writeReport(FILE* file);
+    void writeJSON(StringBuilder& out);
+
+    SlangResult runCoreModuleLoad(RunTimes& times);
+    SlangResult runFrontEnd(RunTimes& times);
+    SlangResult runSPIRV(RunTimes& times) { return _runCodeGen(times, SLANG_SPIRV, "spirv_1_5"); }
+    SlangResult runDXIL(RunTimes& times) { return _runCodeGen(times, SLANG_DXIL, "sm_6_5"); }
+    SlangResult runMetal(RunTimes& times) { return _runCodeGen(times, SLANG_METAL, nullptr); }
+    SlangResult runPrecompiledImport(RunTimes& times);
+
+protected:
+    SlangResult _createSession(
+        SlangCompileTarget format,
+        const char* profile,
+        ComPtr<slang::ISession>& outSession);
+    SlangResult _loadModule(
+        slang::ISession* session,
+        RunTimes& times,
+        ComPtr<slang::IModule>& outModule);
+    SlangResult _link(
+        slang::IModule* module,
+        RunTimes& times,
+        ComPtr<slang::IComponentType>& outProgram);
+    SlangResult _runCodeGen(RunTimes& times, SlangCompileTarget format, const char* profile);
+    void _reportDiagnostics(slang::IBlob* diagnostics);
+
+    BenchmarkOptions m_options;
+    ComPtr<slang::IGlobalSession> m_globalSession;
+    ComPtr<slang::IBlob> m_serializedModule;
+    String m_lastDiagnostics;
+    List<WorkloadResult> m_results;
+};
+
+SlangResult Benchmark::init(const BenchmarkOptions& options)
+{
+    m_options = options;
+    SLANG_RETURN_ON_FAIL(slang_createGlobalSession(SLANG_API_VERSION, m_globalSession.writeRef()));
+
+    // Serialize the module once up front, so the import workload only measures loading it.
+    ComPtr<slang::ISession> session;
+    SLANG_RETURN_ON_FAIL(_createSession(SLANG_SPIRV, "spirv_1_5", session));
+    RunTimes times;
+    ComPtr<slang::IModule> module;
+    SLANG_RETURN_ON_FAIL(_loadModule(session, times, module));
+    SLANG_RETURN_ON_FAIL(module->serialize(m_serializedModule.writeRef()));
+    return SLANG_OK;
+}
+
+void Benchmark::_reportDiagnostics(slang::IBlob* diagnostics)
+{
+    if (diagnostics && diagnostics->getBufferSize())
+    {
+        m_lastDiagnostics = UnownedStringSlice(
+            (const char*)diagnostics->getBufferPointer(),
+            diagnostics->getBufferSize());
+    }
+}
+
+SlangResult Benchmark::_createSession(
+    SlangCompileTarget format,
+    const char* profile,
+    ComPtr<slang::ISession>& outSession)
+{
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = format;
+    if (profile)
+        targetDesc.profile = m_globalSession->findProfile(profile);
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    return m_globalSession->createSession(sessionDesc, outSession.writeRef());
+}
+
+SlangResult Benchmark::_loadModule(
+    slang::ISession* session,
+    RunTimes& times,
+    ComPtr<slang::IModule>& outModule)
+{
+    ComPtr<slang::IBlob> diagnostics;
+    {
+        PhaseTimer timer(times, "check");
+        outModule = session->loadModuleFromSourceString(
+            "benchmark",
+            m_options.sourcePath.getBuffer(),
+            m_options.source.getBuffer(),
+            diagnostics.writeRef());
+    }
+    _reportDiagnostics(diagnostics);
+    return outModule ? SLANG_OK : SLANG_FAIL;
+}
+
+SlangResult Benchmark::_link(
+    slang::IModule* module,
+    RunTimes& times,
+    ComPtr<slang::IComponentType>& outProgram)
+{
+    PhaseTimer timer(times, "link");
+
+    List<slang::IComponentType*> components;
+    List<ComPtr<slang::IEntryPoint>> entryPoints;
+    components.add(module);
+    for (SlangInt32 i = 0; i < module->getDefinedEntryPointCount(); ++i)
+    {
+        ComPtr<slang::IEntryPoint> entryPoint;
+        SLANG_RETURN_ON_FAIL(module->getDefinedEntryPoint(i, entryPoint.writeRef()));
+        components.add(entryPoint);
+        entryPoints.add(entryPoint);
+    }
+
+    ComPtr<slang::IBlob> diagnostics;
+    ComPtr<slang::IComponentType> composite;
+    SlangResult res = module->getSession()->createCompositeComponentType(
+        components.getBuffer(),
+        components.getCount(),
+        composite.writeRef(),
+        diagnostics.writeRef());
+    _reportDiagnostics(diagnostics);
+    SLANG_RETURN_ON_FAIL(res);
+
+    res = composite->link(outProgram.writeRef(), diagnostics.writeRef());
+    _reportDiagnostics(diagnostics);
+    return res;
+}
+
+SlangResult Benchmark::runCoreModuleLoad(RunTimes& times)
+{
+    PhaseTimer timer(times, "coreModule");
+    ComPtr<slang::IGlobalSession> globalSession;
+    return slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef());
+}
+
+SlangResult Benchmark::runFrontEnd(RunTimes& times)
+{
+    ComPtr<slang::ISession> session;
+    SLANG_RETURN_ON_FAIL(_createSession(SLANG_SPIRV, "spirv_1_5", session));
+
+    ComPtr<slang::IModule> module;
+    SLANG_RETURN_ON_FAIL(_loadModule(session, times, module));
+
+    ComPtr<slang::IComponentType> program;
+    return _link(module, times, program);
+}
+
+SlangResult Benchmark::_runCodeGen(
+    RunTimes& times,
+    SlangCompileTarget format,
+    const char* profile)
+{
+    // A new session is needed for every run, as a session caches loaded modules.
+    ComPtr<slang::ISession> session;
+    SLANG_RETURN_ON_FAIL(_createSession(format, profile, session));
+
+    ComPtr<slang::IModule> module;
+    SLANG_RETURN_ON_FAIL(_loadModule(session, times, module));
+
+    ComPtr<slang::IComponentType> program;
+    SLANG_RETURN_ON_FAIL(_link(module, times, program));
+
+    PhaseTimer timer(times, "emit");
+    const SlangInt entryPointCount = program->getLayout()->getEntryPointCount();
+    for (SlangInt i = 0; i < entryPointCount; ++i)
+    {
+        ComPtr<slang::IBlob> code;
+        ComPtr<slang::IBlob> diagnostics;
+        const SlangResult res =
+            program->getEntryPointCode(i, 0, code.writeRef(), diagnostics.writeRef());
+        _reportDiagnostics(diagnostics);
+        SLANG_RETURN_ON_FAIL(res);
+    }
+    return SLANG_OK;
+}
+
+SlangResult Benchmark::runPrecompiledImport(RunTimes& times)
+{
+    ComPtr<slang::ISession> session;
+    SLANG_RETURN_ON_FAIL(_createSession(SLANG_SPIRV, "spirv_1_5", session));
+
+    ComPtr<slang::IBlob> diagnostics;
+    ComPtr<slang::IModule> module;
+    {
+        PhaseTimer timer(times, "import");
+        module = session->loadModuleFromIRBlob(
+            "benchmark",
+            m_options.sourcePath.getBuffer(),
+            m_serializedModule,
+            diagnostics.writeRef());
+    }
+    _reportDiagnostics(diagnostics);
+    if (!module)
+        return SLANG_FAIL;
+
+    ComPtr<slang::IComponentType> program;
+    return _link(module, times, program);
+}
+
+void Benchmark::runWorkload(const char* name, WorkloadFunc func)
+{
+    if (m_options.workloadFilter.getCount() && m_options.workloadFilter.indexOf(name) < 0)
+        return;
+
+    WorkloadResult workload;
+    workload.name = name;
+
+    const double ticksToMS = 1000.0 / double(Process::getClockFrequency());
+    for (Count i = 0; i < m_options.warmupCount + m_options.repeatCount; ++i)
+    {
+        RunTimes times;
+        m_lastDiagnostics = String();
+        workload.result = (this->*func)(times);
+        if (SLANG_FAILED(workload.result))
+        {
+            workload.message = m_lastDiagnostics;
+            workload.phases.clear();
+            break;
+        }
+        if (i < m_options.warmupCount)
+            continue;
+
+        // Phases are recorded in the same order on every run.
+        for (Index j = 0; j < times.phases.getCount(); ++j)
+        {
+            if (j >= workload.phases.getCount())
+                workload.phases.add(PhaseResult{times.phases[j], List<double>()});
+            workload.phases[j].samplesMS.add(double(times.ticks[j]) * ticksToMS);
+        }
+    }
+    m_results.add(workload);
+}
+
+namespace
+{
+struct PhaseSummary
+{
+    double minMS;
+    double maxMS;
+    double meanMS;
+    double medianMS;
+};
+} // namespace
+
+static PhaseSummary _summarize(const List<double>& samples)
+{
+    List<double> sorted = samples;
+    std::sort(sorted.begin(), sorted.end());
+
+    PhaseSummary summary = {};
+    if (sorted.getCount() == 0)
+        return summary;
+
+    double total = 0.0;
+    for (auto sample : sorted)
+        total += sample;
+
+    const Index middle = sorted.getCount() / 2;
+    summary.minMS = sorted.getFirst();
+    summary.maxMS = sorted.getLast();
+    summary.meanMS = total / double(sorted.getCount());
+    summary.medianMS = (sorted.getCount() & 1) ? sorted[middle]
+                                               : (sorted[middle - 1] + sorted[middle]) * 0.5;
+    return summary;
+}
+
+void Benchmark::writeReport(FILE* file)
+{
+    fprintf(
+        file,
+        "%-20s %-12s %10s %10s %10s %10s\n",
+        "workload",
+        "phase",
+        "mean(ms)",
+        "median(ms)",
+        "min(ms)",
+        "max(ms)");
+    for (const auto& workload : m_results)
+    {
+        if (SLANG_FAILED(workload.result))
+        {
+            fprintf(file, "%-20s failed\n", workload.name.getBuffer());
+            if (workload.message.getLength())
+                fprintf(file, "%s\n", workload.message.getBuffer());
+            continue;
+        }
+        for (const auto& phase : workload.phases)
+        {
+            const auto summary = _summarize(phase.samplesMS);
+            fprintf(
+                file,
+                "%-20s %-12s %10.3f %10.3f %10.3f %10.3f\n",
+                workload.name.getBuffer(),
+                phase.name.getBuffer(),
+                summary.meanMS,
+                summary.medianMS,
+                summary.minMS,
+                summary.maxMS);
+        }
+    }
+}
+
+void Benchmark::writeJSON(StringBuilder& out)
+{
+    auto handler = StringEscapeUtil::getHandler(StringEscapeUtil::Style::JSON);
+
+    out << "{\n\"warmup\":" << m_options.warmupCount;
+    out << ",\n\"repeat\":" << m_options.repeatCount;
+    out << ",\n\"workloads\":[";
+    for (Index i = 0; i < m_results.getCount(); ++i)
+    {
+        const auto& workload = m_results[i];
+        out << (i ? ",\n" : "\n") << "{\"name\":";
+        StringEscapeUtil::appendQuoted(handler, workload.name.getUnownedSlice(), out);
+        out << ",\"succeeded\":" << (SLANG_SUCCEEDED(workload.result) ? "true" : "false");
+        if (workload.message.getLength())
+        {
+            out << ",\"message\":";
+            StringEscapeUtil::appendQuoted(handler, workload.message.getUnownedSlice(), out);
+        }
+
+        out << ",\"phases\":[";
+        for (Index j = 0; j < workload.phases.getCount(); ++j)
+        {
+            const auto& phase = workload.phases[j];
+            const auto summary = _summarize(phase.samplesMS);
+            out << (j ? "," : "") << "{\"name\":";
+            StringEscapeUtil::appendQuoted(handler, phase.name.getUnownedSlice(), out);
+            out << ",\"meanMS\":" << String(summary.meanMS, "%.3f");
+            out << ",\"medianMS\":" << String(summary.medianMS, "%.3f");
+            out << ",\"minMS\":" << String(summary.minMS, "%.3f");
+            out << ",\"maxMS\":" << String(summary.maxMS, "%.3f");
+            out << ",\"samplesMS\":[";
+            for (Index k = 0; k < phase.samplesMS.getCount(); ++k)
+                out << (k ? "," : "") << String(phase.samplesMS[k], "%.3f");
+            out << "]}";
+        }
+        out << "]}";
+    }
+    out << "\n]\n}\n";
+}
+
+static void _printUsage()
+{
+    printf(
+        "Usage: slang-benchmark [options]\n"
+        "  -warmup <count>    Unrecorded runs of each workload (default 1)\n"
+        "  -repeat <count>    Recorded runs of each workload (default 5)\n"
+        "  -source <path>     Benchmark the given module instead of the built-in one\n"
+        "  -workload <name>   Only run the named workload, can be repeated. One of:\n"
+        "                     core-module, front-end, spirv, dxil, metal, precompiled-import\n"
+        "  -json <path>       Write the results as JSON to the given path\n");
+}
+
+static SlangResult _parseOptions(int argc, char** argv, BenchmarkOptions& outOptions)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const UnownedStringSlice arg(argv[i]);
+        if (i + 1 >= argc)
+            return SLANG_FAIL;
+        const char* value = argv[++i];
+
+        if (arg == toSlice("-warmup"))
+            outOptions.warmupCount = atoi(value);
+        else if (arg == toSlice("-repeat"))
+            outOptions.repeatCount = atoi(value);
+        else if (arg == toSlice("-workload"))
+            outOptions.workloadFilter.add(value);
+        else if (arg == toSlice("-json"))
+            outOptions.jsonPath = value;
+        else if (arg == toSlice("-source"))
+        {
+            outOptions.sourcePath = value;
+            if (SLANG_FAILED(File::readAllText(outOptions.sourcePath, outOptions.source)))
+            {
+                fprintf(stderr, "error: unable to read '%s'\n", value);
+                return SLANG_FAIL;
+            }
+        }
+        else
+            return SLANG_FAIL;
+    }
+    if (outOptions.warmupCount < 0 || outOptions.repeatCount <= 0)
+        return SLANG_FAIL;
+    return SLANG_OK;
+}
+
+SlangResult innerMain(int argc, char** argv)
+{
+    auto stdWriters = StdWriters::initDefaultSingleton();
+
+    BenchmarkOptions options;
+    if (SLANG_FAILED(_parseOptions(argc, argv, options)))
+    {
+        _printUsage();
+        return SLANG_FAIL;
+    }
+
+    Benchmark benchmark;
+    if (SLANG_FAILED(benchmark.init(options)))
+    {
+        fprintf(stderr, "error: unable to compile the benchmark module\n");
+        return SLANG_FAIL;
+    }
+
+    benchmark.runWorkload("core-module", &Benchmark::runCoreModuleLoad);
+    benchmark.runWorkload("front-end", &Benchmark::runFrontEnd);
+    benchmark.runWorkload("spirv", &Benchmark::runSPIRV);
+    benchmark.runWorkload("dxil", &Benchmark::runDXIL);
+    benchmark.runWorkload("metal", &Benchmark::runMetal);
+    benchmark.runWorkload("precompiled-import", &Benchmark::runPrecompiledImport);
+
+    benchmark.writeReport(stdout);
+
+    if (options.jsonPath.getLength())
+    {
+        StringBuilder json;
+        benchmark.writeJSON(json);
+        SLANG_RETURN_ON_FAIL(File::writeAllText(options.jsonPath, json));
+    }
+    return SLANG_OK;
+}
+
+int main(int argc, char** argv)
+{
+    const SlangResult res = innerMain(argc, argv);
+#ifdef _MSC_VER
+    _CrtDumpMemoryLeaks();
+#endif
+    return SLANG_SUCCEEDED(res) ? 0 : 1;
+}
@@ -4,13 +4,24 @@
 #include <replay/json-consumer.h>
 #include <replay/recordFile-processor.h>
 #include <replay/replay-consumer.h>
+#include <replay/replay-timings.h>
 #include <replay/slang-decoder.h>
 #include <stdio.h>
+#include <stdlib.h>
 
 struct Options
 {
     bool convertToJson{false};
     Slang::String recordFileName;
+
+    // When non-zero, replay the record file this many times and report the latency of each API
+    // call.
+    int timingIterations{0};
+    Slang::String baselineFileName;
+    Slang::String saveBaselineFileName;
+    // How much slower than the baseline, in percent, the median latency of a call can get
+    // before it is reported as a regression.
+    double regressionThreshold{10.0};
 };
 
 void printUsage()
@@ -20,6 +31,27 @@ void printUsage()
     printf(
         "  --convert-json, -cj: Convert the record file to a JSON file in the same directory with record file.\n\
                        When this option is set, it won't replay the record file.\n");
+    printf("  --timing <count>, -t <count>: Replay the record file <count> times, and report the\n\
+                       latency percentiles of each API call.\n");
+    printf("  --baseline <file>: Compare the latencies with the ones saved in <file>, and fail\n\
+                       if a call got slower. Implies --timing 1 if --timing isn't set.\n");
+    printf("  --save-baseline <file>: Save the latencies to <file>, to be used with --baseline.\n\
+                       Implies --timing 1 if --timing isn't set.\n");
+    printf("  --regression-threshold <percent>: How much slower than the baseline the median\n\
+                       latency of a call can get before it is a regression. Defaults to 10.\n");
+}
+
+static const char* getOptionValue(int argc, char* argv[], int& argIndex)
+{
+    if (argIndex + 1 >= argc)
+    {
+        printf("Missing value for option: %s\n", argv[argIndex]);
+        printUsage();
+        exit(1);
+    }
+    const char* value = argv[argIndex + 1];
+    argIndex += 2;
+    return value;
 }
 
 Options parseOption(int argc, char* argv[])
@@ -48,6 +80,27 @@ Options parseOption(int argc, char* argv[])
             option.convertToJson = true;
             argIndex++;
         }
+        else if ((strcmp("--timing", arg) == 0) || (strcmp("-t", arg) == 0))
+        {
+            option.timingIterations = atoi(getOptionValue(argc, argv, argIndex));
+            if (option.timingIterations <= 0)
+            {
+                printf("Invalid timing iteration count\n");
+                exit(1);
+            }
+        }
+        else if (strcmp("--baseline", arg) == 0)
+        {
+            option.baselineFileName = getOptionValue(argc, argv, argIndex);
+        }
+        else if (strcmp("--save-baseline", arg) == 0)
+        {
+            option.saveBaselineFileName = getOptionValue(argc, argv, argIndex);
+        }
+        else if (strcmp("--regression-threshold", arg) == 0)
+        {
+            option.regressionThreshold = atof(getOptionValue(argc, argv, argIndex));
+        }
         else if ((strcmp("--help", arg) == 0) || (strcmp("-h", arg) == 0))
         {
             printUsage();
@@ -68,13 +121,124 @@ Options parseOption(int argc, char* argv[])
         exit(1);
     }
 
+    if (option.timingIterations == 0 &&
+        (option.baselineFileName.getLength() || option.saveBaselineFileName.getLength()))
+    {
+        option.timingIterations = 1;
+    }
+
     return option;
 }
 
+static void replayRecordFile(
+    const Slang::String& recordFileName,
+    SlangRecord::ReplayTimings* timings)
+{
+    SlangRecord::RecordFileProcessor recordFileProcessor(recordFileName);
+    SlangRecord::ReplayConsumer replayConsumer;
+    SlangRecord::SlangDecoder decoder;
+
+    decoder.addConsumer(&replayConsumer);
+    recordFileProcessor.addDecoder(&decoder);
+    recordFileProcessor.setTimings(timings);
+
+    while (recordFileProcessor.processNextBlock())
+    {
+    }
+}
+
+// Replays the record file `options.timingIterations` times, reports the latencies of the API
+// calls, and compares them with the baseline if there is one. Returns the exit code.
+static int runTiming(const Options& options)
+{
+    SlangRecord::ReplayTimings timings;
+    for (int i = 0; i < options.timingIterations; i++)
+    {
+        replayRecordFile(options.recordFileName, &timings);
+    }
+
+    Slang::List<SlangRecord::ReplayTimings::CallStats> stats;
+    timings.computeStats(stats);
+
+    printf("%-56s %8s %12s %12s %12s\n", "API call", "count", "p50 (us)", "p90 (us)", "p99 (us)");
+    for (const auto& callStats : stats)
+    {
+        printf(
+            "%-56s %8d %12.1f %12.1f %12.1f\n",
+            callStats.name.getBuffer(),
+            int(callStats.callCount),
+            callStats.p50,
+            callStats.p90,
+            callStats.p99);
+    }
+
+    if (options.saveBaselineFileName.getLength())
+    {
+        if (SLANG_FAILED(
+                SlangRecord::ReplayTimings::saveStats(options.saveBaselineFileName, stats)))
+        {
+            printf("Failed to save baseline to %s\n", options.saveBaselineFileName.getBuffer());
+            return 1;
+        }
+    }
+
+    if (options.baselineFileName.getLength() == 0)
+        return 0;
+
+    Slang::List<SlangRecord::ReplayTimings::CallStats> baselineStats;
+    if (SLANG_FAILED(
+            SlangRecord::ReplayTimings::loadStats(options.baselineFileName, baselineStats)))
+    {
+        printf("Failed to load baseline from %s\n", options.baselineFileName.getBuffer());
+        return 1;
+    }
+
+    int regressionCount = 0;
+    printf("\nComparison with baseline %s:\n", options.baselineFileName.getBuffer());
+    for (const auto& callStats : stats)
+    {
+        const SlangRecord::ReplayTimings::CallStats* baseline = nullptr;
+        for (const auto& baselineCallStats : baselineStats)
+        {
+            if (baselineCallStats.name == callStats.name)
+            {
+                baseline = &baselineCallStats;
+                break;
+            }
+        }
+        if (!baseline || baseline->p50 <= 0)
+            continue;
+
+        double change = (callStats.p50 / baseline->p50 - 1.0) * 100.0;
+        bool isRegression = change > options.regressionThreshold;
+        if (isRegression)
+            regressionCount++;
+        printf(
+            "%-56s p50 %12.1f us (baseline %12.1f us, %+.1f%%)%s\n",
+            callStats.name.getBuffer(),
+            callStats.p50,
+            baseline->p50,
+            change,
+            isRegression ? " REGRESSION" : "");
+    }
+
+    if (regressionCount)
+    {
+        printf("%d API call(s) regressed\n", regressionCount);
+        return 1;
+    }
+    return 0;
+}
+
 int main(int argc, char* argv[])
 {
     Options options = parseOption(argc, argv);
 
+    if (options.timingIterations)
+    {
+        return runTiming(options);
+    }
+
     SlangRecord::RecordFileProcessor recordFileProcessor(options.recordFileName);
 
     Slang::String jsonPath = Slang::Path::replaceExt(options.recordFileName, "json");
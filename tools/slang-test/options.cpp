@@ -212,6 +212,32 @@ static bool _isSubCommand(const char* arg)
                 optionsOut->serverCount = 1;
             }
         }
+        else if (strcmp(arg, "-shard") == 0)
+        {
+            if (argCursor == argEnd)
+            {
+                stdError.print("error: expected operand for '%s'\n", arg);
+                return SLANG_FAIL;
+            }
+            // The operand is of the form <index>/<count>
+            const char* shard = *argCursor++;
+            List<UnownedStringSlice> parts;
+            StringUtil::split(UnownedStringSlice(shard), '/', parts);
+            Int shardIndex = -1;
+            Int shardCount = 0;
+            if (parts.getCount() != 2 || SLANG_FAILED(StringUtil::parseInt(parts[0], shardIndex)) ||
+                SLANG_FAILED(StringUtil::parseInt(parts[1], shardCount)) || shardCount <= 0 ||
+                shardIndex < 0 || shardIndex >= shardCount)
+            {
+                stdError.print(
+                    "error: expected '<index>/<count>' for '%s', got '%s'\n",
+                    arg,
+                    shard);
+                return SLANG_FAIL;
+            }
+            optionsOut->shardIndex = int(shardIndex);
+            optionsOut->shardCount = int(shardCount);
+        }
         else if (strcmp(arg, "-appveyor") == 0)
         {
             optionsOut->outputMode = TestOutputMode::AppVeyor;
@@ -115,6 +115,11 @@ struct Options
     // Maximum number of test servers to run.
     int serverCount = 1;
 
+    // Only run the tests that fall in shard `shardIndex` of `shardCount`, so that a test run can
+    // be split across machines.
+    int shardIndex = 0;
+    int shardCount = 1;
+
     bool emitSPIRVDirectly = true;
 
     Slang::HashSet<Slang::String> expectedFailureList;
@@ -1992,19 +1992,31 @@ TestResult runLanguageServerTest(TestContext* context, TestInput& input)
             actualOutputSB << "--------\n";
             LanguageServerProtocol::NullResponse nullResponse;
             List<LanguageServerProtocol::CompletionItem> completionItems;
-            if (SLANG_SUCCEEDED(connection->getMessage(&nullResponse)))
-            {
-                actualOutputSB << "null\n";
-            }
-            else if (SLANG_SUCCEEDED(connection->getMessage(&completionItems)))
+            LanguageServerProtocol::CompletionList completionList;
+            auto printCompletionItems =
+                [&](const List<LanguageServerProtocol::CompletionItem>& items)
             {
-                for (auto item : completionItems)
+                for (auto item : items)
                 {
                     actualOutputSB << item.label << ": " << item.kind << " " << item.detail << " ";
                     for (auto ch : item.commitCharacters)
                         actualOutputSB << ch;
                     actualOutputSB << "\n";
                 }
+            };
+            if (SLANG_SUCCEEDED(connection->getMessage(&nullResponse)))
+            {
+                actualOutputSB << "null\n";
+            }
+            else if (SLANG_SUCCEEDED(connection->getMessage(&completionItems)))
+            {
+                printCompletionItems(completionItems);
+            }
+            else if (SLANG_SUCCEEDED(connection->getMessage(&completionList)))
+            {
+                actualOutputSB << "isIncomplete: "
+                               << (completionList.isIncomplete ? "true" : "false") << "\n";
+                printCompletionItems(completionList.items);
             }
         }
         else if (line.startsWith("//SIGNATURE:"))
@@ -4340,11 +4352,29 @@ static bool endsWithAllowedExtension(TestContext* /*context*/, String filePath)
     return false;
 }
 
+static bool _isInShard(TestContext* context, const String& filePath)
+{
+    const auto shardCount = context->options.shardCount;
+    if (shardCount <= 1)
+    {
+        return true;
+    }
+
+    // The shard is picked from a hash of the path, so that every machine agrees on the shard
+    // of a test whatever the order the files are found in.
+    const String path = StringUtil::calcCharReplaced(filePath, '\\', '/');
+    const HashCode64 hash = getHashCode(path.getBuffer(), size_t(path.getLength()));
+    return Index(hash % HashCode64(shardCount)) == context->options.shardIndex;
+}
+
 static bool shouldRunTest(TestContext* context, String filePath)
 {
     if (!endsWithAllowedExtension(context, filePath))
         return false;
 
+    if (!_isInShard(context, filePath))
+        return false;
+
     if (!context->options.testPrefixes.getCount())
     {
         return true;
@@ -0,0 +1,128 @@
+// unit-test-batch-compile.cpp
+
+#include "../../source/core/slang-basic.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <mutex>
+
+using namespace Slang;
+
+namespace
+{
+struct BatchResults
+{
+    std::mutex mutex;
+    List<SlangResult> results;
+    List<String> codes;
+};
+
+void SLANG_MCALL onItemCompiled(
+    void* userData,
+    SlangInt itemIndex,
+    SlangResult result,
+    slang::IBlob* code,
+    slang::IBlob*)
+{
+    auto batchResults = (BatchResults*)userData;
+    std::lock_guard<std::mutex> lock(batchResults->mutex);
+    batchResults->results[itemIndex] = result;
+    if (code)
+    {
+        batchResults->codes[itemIndex] =
+            UnownedStringSlice((const char*)code->getBufferPointer(), code->getBufferSize());
+    }
+}
+} // namespace
+
+// Test that the items of a batch are all compiled, and that the items which specialize an
+// entry point with the same arguments get the same code.
+//
+SLANG_UNIT_TEST(batchCompile)
+{
+    const char* userSourceBody = R"(
+        interface IMaterial { float4 eval(); }
+        struct Red : IMaterial { float4 eval() { return float4(1, 0, 0, 1); } }
+        struct Blue : IMaterial { float4 eval() { return float4(0, 0, 1, 1); } }
+
+        RWStructuredBuffer<float4> outputBuffer;
+
+        [shader("compute")]
+        [numthreads(1, 1, 1)]
+        void computeMain<M : IMaterial>()
+        {
+            M m;
+            outputBuffer[0] = m.eval();
+        }
+        )";
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.flags = slang::kSessionFlags_ThreadSafe;
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK(globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = session->loadModuleFromSourceString(
+        "m",
+        "m.slang",
+        userSourceBody,
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(module != nullptr);
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    module->findEntryPointByName("computeMain", entryPoint.writeRef());
+    SLANG_CHECK_ABORT(entryPoint != nullptr);
+
+    slang::SpecializationArg args[] = {
+        slang::SpecializationArg::fromType(module->getLayout()->findTypeByName("Red")),
+        slang::SpecializationArg::fromType(module->getLayout()->findTypeByName("Blue"))};
+    SLANG_CHECK_ABORT(args[0].type != nullptr && args[1].type != nullptr);
+
+    const Index itemCount = 4;
+    slang::BatchCompileItem items[itemCount];
+    for (Index i = 0; i < itemCount; ++i)
+    {
+        items[i].program = entryPoint;
+        items[i].specializationArgs = &args[i % 2];
+        items[i].specializationArgCount = 1;
+    }
+
+    ComPtr<slang::IBatchCompileService_Experimental> batchCompileService;
+    SLANG_CHECK_ABORT(
+        session->queryInterface(
+            SLANG_IID_PPV_ARGS(batchCompileService.writeRef())) == SLANG_OK);
+
+    BatchResults batchResults;
+    batchResults.results.setCount(itemCount);
+    batchResults.codes.setCount(itemCount);
+    for (auto& result : batchResults.results)
+        result = SLANG_E_NOT_IMPLEMENTED;
+    SLANG_CHECK(
+        batchCompileService->compileBatch(items, itemCount, 4, onItemCompiled, &batchResults) ==
+        SLANG_OK);
+
+    for (Index i = 0; i < itemCount; ++i)
+    {
+        SLANG_CHECK(batchResults.results[i] == SLANG_OK);
+        SLANG_CHECK(batchResults.codes[i].getLength() != 0);
+    }
+    SLANG_CHECK(batchResults.codes[0] == batchResults.codes[2]);
+    SLANG_CHECK(batchResults.codes[1] == batchResults.codes[3]);
+    SLANG_CHECK(batchResults.codes[0] != batchResults.codes[1]);
+
+    // An item without a program is reported as failed, without stopping the others.
+    items[1].program = nullptr;
+    SLANG_CHECK(
+        batchCompileService->compileBatch(items, 2, 1, onItemCompiled, &batchResults) ==
+        SLANG_FAIL);
+    SLANG_CHECK(batchResults.results[0] == SLANG_OK);
+    SLANG_CHECK(batchResults.results[1] == SLANG_E_INVALID_ARG);
+}
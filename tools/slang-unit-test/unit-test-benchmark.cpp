@@ -0,0 +1,339 @@
+// unit-test-benchmark.cpp
+
+#include "../../source/core/slang-basic.h"
+#include "../../source/core/slang-memory-arena.h"
+#include "../../source/core/slang-platform.h"
+#include "../../source/core/slang-string-util.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <chrono>
+
+using namespace Slang;
+
+// Micro-benchmarks of the core containers and of creating and optimizing IR, to give a baseline
+// for changes to their layout. Each benchmark also checks the results of its workload, which is
+// small by default so that a full test run stays quick. The timings are reported as info messages,
+// which slang-test prints when run with -v, and the benchmarks alone are run by filtering on their
+// prefix:
+//
+//     slang-test -v slang-unit-test-tool/benchmark
+//
+// The size of each workload is multiplied by the SLANG_UNIT_TEST_BENCHMARK_SCALE environment
+// variable, when it is set.
+
+namespace
+{
+
+struct BenchmarkTimer
+{
+    BenchmarkTimer()
+        : m_startTime(std::chrono::steady_clock::now())
+    {
+    }
+
+    /// Report the time since the timer was created, or last reported, for `operationCount`
+    /// operations of the named workload.
+    void report(const char* name, Index operationCount)
+    {
+        const auto endTime = std::chrono::steady_clock::now();
+        const double seconds = std::chrono::duration<double>(endTime - m_startTime).count();
+
+        StringBuilder buf;
+        StringUtil::appendFormat(
+            buf,
+            "%s: %d operations in %.3f ms (%.1f ns each)\n",
+            name,
+            int(operationCount),
+            seconds * 1000.0,
+            operationCount ? seconds * 1.0e9 / double(operationCount) : 0.0);
+        getTestReporter()->message(TestMessageType::Info, buf.getBuffer());
+
+        m_startTime = std::chrono::steady_clock::now();
+    }
+
+    std::chrono::steady_clock::time_point m_startTime;
+};
+
+} // namespace
+
+static Index _getBenchmarkScale()
+{
+    StringBuilder value;
+    Int scale = 0;
+    if (SLANG_FAILED(PlatformUtil::getEnvironmentVariable(
+            toSlice("SLANG_UNIT_TEST_BENCHMARK_SCALE"),
+            value)) ||
+        SLANG_FAILED(StringUtil::parseInt(value.getUnownedSlice(), scale)) || scale < 1)
+    {
+        return 1;
+    }
+    return Index(scale);
+}
+
+// A key that spreads the indices over the whole range of the hash, as real keys would.
+static Int _getBenchmarkKey(Index index)
+{
+    return Int(uint64_t(index) * 0x9E3779B97F4A7C15ull);
+}
+
+SLANG_UNIT_TEST(benchmarkDictionary)
+{
+    const Index count = (Index(1) << 16) * _getBenchmarkScale();
+
+    {
+        Dictionary<Int, Index> dictionary;
+        BenchmarkTimer timer;
+        for (Index i = 0; i < count; ++i)
+            dictionary.add(_getBenchmarkKey(i), i);
+        timer.report("Dictionary<Int> insert", count);
+
+        Index foundCount = 0;
+        for (Index i = 0; i < count; ++i)
+        {
+            Index value = 0;
+            if (dictionary.tryGetValue(_getBenchmarkKey(i), value) && value == i)
+                foundCount++;
+        }
+        timer.report("Dictionary<Int> lookup hit", count);
+
+        Index missedCount = 0;
+        for (Index i = 0; i < count; ++i)
+        {
+            if (!dictionary.containsKey(_getBenchmarkKey(count + i)))
+                missedCount++;
+        }
+        timer.report("Dictionary<Int> lookup miss", count);
+
+        SLANG_CHECK(dictionary.getCount() == count);
+        SLANG_CHECK(foundCount == count);
+        SLANG_CHECK(missedCount == count);
+    }
+
+    {
+        List<String> keys;
+        keys.setCount(count);
+        for (Index i = 0; i < count; ++i)
+            keys[i] = String("name_") + String(i);
+
+        Dictionary<String, Index> dictionary;
+        BenchmarkTimer timer;
+        for (Index i = 0; i < count; ++i)
+            dictionary.add(keys[i], i);
+        timer.report("Dictionary<String> insert", count);
+
+        Index foundCount = 0;
+        for (Index i = 0; i < count; ++i)
+        {
+            if (dictionary.containsKey(keys[i]))
+                foundCount++;
+        }
+        timer.report("Dictionary<String> lookup hit", count);
+
+        SLANG_CHECK(dictionary.getCount() == count);
+        SLANG_CHECK(foundCount == count);
+    }
+}
+
+SLANG_UNIT_TEST(benchmarkHashSet)
+{
+    const Index count = (Index(1) << 16) * _getBenchmarkScale();
+
+    HashSet<Int> set;
+    BenchmarkTimer timer;
+    Index addedCount = 0;
+    for (Index i = 0; i < count; ++i)
+    {
+        if (set.add(_getBenchmarkKey(i)))
+            addedCount++;
+    }
+    timer.report("HashSet<Int> insert", count);
+
+    // Adding the keys again finds that they are all present.
+    for (Index i = 0; i < count; ++i)
+    {
+        if (set.add(_getBenchmarkKey(i)))
+            addedCount++;
+    }
+    timer.report("HashSet<Int> insert existing", count);
+
+    Index foundCount = 0;
+    for (Index i = 0; i < 2 * count; ++i)
+    {
+        if (set.contains(_getBenchmarkKey(i)))
+            foundCount++;
+    }
+    timer.report("HashSet<Int> lookup hit and miss", 2 * count);
+
+    SLANG_CHECK(addedCount == count);
+    SLANG_CHECK(foundCount == count);
+    SLANG_CHECK(set.getCount() == count);
+}
+
+SLANG_UNIT_TEST(benchmarkList)
+{
+    const Index count = (Index(1) << 20) * _getBenchmarkScale();
+
+    {
+        List<Int> list;
+        BenchmarkTimer timer;
+        for (Index i = 0; i < count; ++i)
+            list.add(Int(i));
+        timer.report("List<Int> growth", count);
+
+        Int sum = 0;
+        for (auto value : list)
+            sum += value;
+        timer.report("List<Int> iteration", count);
+
+        SLANG_CHECK(list.getCount() == count);
+        SLANG_CHECK(sum == Int(count) * Int(count - 1) / 2);
+    }
+
+    {
+        const Index stringCount = count / 16;
+        List<String> list;
+        BenchmarkTimer timer;
+        for (Index i = 0; i < stringCount; ++i)
+            list.add(String("element"));
+        timer.report("List<String> growth", stringCount);
+
+        SLANG_CHECK(list.getCount() == stringCount);
+        SLANG_CHECK(list.getLast() == "element");
+    }
+}
+
+SLANG_UNIT_TEST(benchmarkStringBuilder)
+{
+    const Index count = (Index(1) << 18) * _getBenchmarkScale();
+
+    StringBuilder buf;
+    BenchmarkTimer timer;
+    for (Index i = 0; i < count; ++i)
+        buf << toSlice("item");
+    timer.report("StringBuilder append slice", count);
+
+    for (Index i = 0; i < count; ++i)
+        buf << Int(i & 0xff);
+    timer.report("StringBuilder append int", count);
+
+    for (Index i = 0; i < count; ++i)
+        buf.appendChar('.');
+    timer.report("StringBuilder append char", count);
+
+    // Each int is at most 3 digits.
+    SLANG_CHECK(buf.getLength() > count * 6);
+    SLANG_CHECK(buf.getLength() <= count * 8);
+    SLANG_CHECK(buf.startsWith(toSlice("itemitem")));
+}
+
+SLANG_UNIT_TEST(benchmarkMemoryArena)
+{
+    const Index count = (Index(1) << 18) * _getBenchmarkScale();
+    const Index roundCount = 4;
+
+    MemoryArena arena(64 * 1024);
+    BenchmarkTimer timer;
+    Index failedCount = 0;
+    for (Index round = 0; round < roundCount; ++round)
+    {
+        arena.deallocateAll();
+        for (Index i = 0; i < count; ++i)
+        {
+            // Sizes of small IR instructions and AST nodes.
+            const size_t size = 16 + (size_t(i) & 7) * 8;
+            if (!arena.allocate(size))
+                failedCount++;
+        }
+    }
+    timer.report("MemoryArena allocate", count * roundCount);
+
+    SLANG_CHECK(failedCount == 0);
+    SLANG_CHECK(arena.calcTotalMemoryAllocated() >= size_t(count) * 16);
+}
+
+// Make a module with many functions of many instructions, which use the same few vector and
+// matrix types throughout, such that creating its IR is mostly creating instructions and looking
+// up the types that are already deduplicated.
+static String _makeBenchmarkModuleSource(Index functionCount, Index statementCount)
+{
+    StringBuilder buf;
+    buf << "RWStructuredBuffer<float4> outputBuffer;\n";
+    buf << "uniform float4x4 transform;\n";
+    for (Index i = 0; i < functionCount; ++i)
+    {
+        buf << "float4 f" << i << "(float4 a, float4x4 m)\n{\n";
+        buf << "    float4 v = a;\n";
+        for (Index j = 0; j < statementCount; ++j)
+        {
+            buf << "    v = mul(m, v) * float4(" << (j & 7) + 1 << ".0) + m[" << (j & 3) << "];\n";
+        }
+        buf << "    return v;\n}\n";
+    }
+    buf << "[shader(\"compute\")]\n[numthreads(64, 1, 1)]\n";
+    buf << "void computeMain(uint tid : SV_DispatchThreadID)\n{\n";
+    buf << "    float4 v = outputBuffer[tid];\n";
+    for (Index i = 0; i < functionCount; ++i)
+        buf << "    v = f" << i << "(v, transform);\n";
+    buf << "    outputBuffer[tid] = v;\n}\n";
+    return buf.produceString();
+}
+
+// The IR is internal to the slang library, so its creation, the replacement of the uses of its
+// instructions and the deduplication of its types are measured through loading a module, which
+// lowers it to IR, and generating its code, which runs the IR passes.
+SLANG_UNIT_TEST(benchmarkIR)
+{
+    const Index functionCount = 8 * _getBenchmarkScale();
+    const Index statementCount = 32;
+    const String source = _makeBenchmarkModuleSource(functionCount, statementCount);
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(
+        slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+    BenchmarkTimer timer;
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = session->loadModuleFromSourceString(
+        "benchmark",
+        "benchmark.slang",
+        source.getBuffer(),
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(module != nullptr);
+    timer.report("IR module lowering (statements)", functionCount * statementCount);
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    module->findEntryPointByName("computeMain", entryPoint.writeRef());
+    SLANG_CHECK_ABORT(entryPoint != nullptr);
+
+    ComPtr<slang::IComponentType> compositeProgram;
+    slang::IComponentType* components[] = {module, entryPoint.get()};
+    session->createCompositeComponentType(
+        components,
+        2,
+        compositeProgram.writeRef(),
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(compositeProgram != nullptr);
+
+    ComPtr<slang::IComponentType> linkedProgram;
+    compositeProgram->link(linkedProgram.writeRef(), diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(linkedProgram != nullptr);
+
+    timer = BenchmarkTimer();
+    ComPtr<slang::IBlob> code;
+    linkedProgram->getEntryPointCode(0, 0, code.writeRef(), diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(code != nullptr);
+    timer.report("IR passes and emit (statements)", functionCount * statementCount);
+
+    SLANG_CHECK(StringUtil::getSlice(code).indexOf(UnownedStringSlice("computeMain")) >= 0);
+}
@@ -0,0 +1,115 @@
+// unit-test-compilation-cache.cpp
+
+#include "../../source/core/slang-file-system.h"
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-persistent-cache.h"
+#include "../../source/core/slang-process.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+static void _removeDirectory(const String& directory)
+{
+    auto osFileSystem = OSFileSystem::getMutableSingleton();
+    osFileSystem->enumeratePathContents(
+        directory.getBuffer(),
+        [](SlangPathType, const char* fileName, void* userData)
+        {
+            const String& directory = *static_cast<const String*>(userData);
+            String path = directory + "/" + fileName;
+            OSFileSystem::getMutableSingleton()->remove(path.getBuffer());
+        },
+        const_cast<String*>(&directory));
+    osFileSystem->remove(directory.getBuffer());
+}
+
+static bool _isBlobEqual(ISlangBlob* a, ISlangBlob* b)
+{
+    return a && b && a->getBufferSize() == b->getBufferSize() &&
+           ::memcmp(a->getBufferPointer(), b->getBufferPointer(), a->getBufferSize()) == 0;
+}
+
+// Test that, with `CompilationCachePath` set, compiled entry point code is stored in
+// a persistent cache keyed by `getEntryPointHash`, and that other sessions get the same code.
+//
+SLANG_UNIT_TEST(compilationCache)
+{
+    const char* userSource = R"(
+        [shader("compute")]
+        [numthreads(1, 1, 1)]
+        void computeMain(uint3 tid : SV_DispatchThreadID, uniform RWStructuredBuffer<float> b)
+        {
+            b[tid.x] = float(tid.x);
+        }
+        )";
+
+    const String cacheDirectory = Path::simplify(
+        Path::getParentDirectory(Path::getExecutablePath()) + "/compilation-cache-test" +
+        String(Process::getId()));
+    _removeDirectory(cacheDirectory);
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::CompilerOptionEntry compilerOptionEntry = {};
+    compilerOptionEntry.name = slang::CompilerOptionName::CompilationCachePath;
+    compilerOptionEntry.value.kind = slang::CompilerOptionValueKind::String;
+    compilerOptionEntry.value.stringValue0 = cacheDirectory.getBuffer();
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.compilerOptionEntryCount = 1;
+    sessionDesc.compilerOptionEntries = &compilerOptionEntry;
+
+    auto compile = [&](ComPtr<slang::IBlob>& outCode, ComPtr<slang::IBlob>& outHash)
+    {
+        ComPtr<slang::ISession> session;
+        SLANG_CHECK(globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+        ComPtr<slang::IBlob> diagnostics;
+        auto module =
+            session->loadModuleFromSourceString("m", "m.slang", userSource, diagnostics.writeRef());
+        SLANG_CHECK(module != nullptr);
+
+        ComPtr<slang::IComponentType> linkedProgram;
+        module->link(linkedProgram.writeRef(), diagnostics.writeRef());
+        SLANG_CHECK(linkedProgram != nullptr);
+
+        SLANG_CHECK(SLANG_SUCCEEDED(
+            linkedProgram->getEntryPointCode(0, 0, outCode.writeRef(), diagnostics.writeRef())));
+        linkedProgram->getEntryPointHash(0, 0, outHash.writeRef());
+    };
+
+    ComPtr<slang::IBlob> code;
+    ComPtr<slang::IBlob> hash;
+    compile(code, hash);
+    SLANG_CHECK(code && code->getBufferSize() != 0);
+
+    // The code is now in the cache, under the entry point hash.
+    {
+        PersistentCache::Desc desc;
+        desc.directory = cacheDirectory.getBuffer();
+        RefPtr<PersistentCache> cache = new PersistentCache(desc);
+
+        ComPtr<ISlangBlob> cachedCode;
+        SLANG_CHECK(
+            SLANG_SUCCEEDED(cache->readEntry(PersistentCache::Key(hash), cachedCode.writeRef())));
+        SLANG_CHECK(_isBlobEqual(cachedCode, code));
+    }
+
+    // A new session finds the same code through the cache.
+    ComPtr<slang::IBlob> secondCode;
+    ComPtr<slang::IBlob> secondHash;
+    compile(secondCode, secondHash);
+    SLANG_CHECK(_isBlobEqual(secondHash, hash));
+    SLANG_CHECK(_isBlobEqual(secondCode, code));
+
+    _removeDirectory(cacheDirectory);
+}
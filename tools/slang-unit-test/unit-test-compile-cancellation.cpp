@@ -0,0 +1,93 @@
+// unit-test-compile-cancellation.cpp
+
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Test that the compilations of a canceled session fail with SLANG_E_CANCELED, and that they
+// succeed again once the cancellation is reset.
+
+SLANG_UNIT_TEST(compileCancellation)
+{
+    const char* userSourceBody = R"(
+        RWStructuredBuffer<float> outputBuffer;
+
+        [shader("compute")]
+        [numthreads(64, 1, 1)]
+        void computeMain(uint tid : SV_DispatchThreadID)
+        {
+            outputBuffer[tid] = tid * 2.0;
+        }
+        )";
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK(globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+    ComPtr<slang::ICompileCancellation> cancellation;
+    SLANG_CHECK_ABORT(
+        session->queryInterface(
+            slang::ICompileCancellation::getTypeGuid(),
+            (void**)cancellation.writeRef()) == SLANG_OK);
+    SLANG_CHECK(!cancellation->isCanceled());
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = session->loadModuleFromSourceString(
+        "m",
+        "m.slang",
+        userSourceBody,
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(module != nullptr);
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    module->findEntryPointByName("computeMain", entryPoint.writeRef());
+    SLANG_CHECK_ABORT(entryPoint != nullptr);
+
+    ComPtr<slang::IComponentType> compositeProgram;
+    slang::IComponentType* components[] = {module, entryPoint.get()};
+    session->createCompositeComponentType(
+        components,
+        2,
+        compositeProgram.writeRef(),
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(compositeProgram != nullptr);
+
+    ComPtr<slang::IComponentType> linkedProgram;
+    compositeProgram->link(linkedProgram.writeRef(), nullptr);
+    SLANG_CHECK_ABORT(linkedProgram != nullptr);
+
+    // A canceled session generates no code.
+    cancellation->cancel();
+    SLANG_CHECK(cancellation->isCanceled());
+    ComPtr<slang::IBlob> code;
+    SLANG_CHECK(
+        linkedProgram->getEntryPointCode(0, 0, code.writeRef(), diagnosticBlob.writeRef()) ==
+        SLANG_E_CANCELED);
+    SLANG_CHECK(code == nullptr);
+    SLANG_CHECK(
+        linkedProgram->getTargetCode(0, code.writeRef(), diagnosticBlob.writeRef()) ==
+        SLANG_E_CANCELED);
+
+    // Once reset, the same program compiles.
+    cancellation->resetCancellation();
+    SLANG_CHECK(!cancellation->isCanceled());
+    SLANG_CHECK(
+        linkedProgram->getEntryPointCode(0, 0, code.writeRef(), diagnosticBlob.writeRef()) ==
+        SLANG_OK);
+    SLANG_CHECK(code != nullptr);
+
+    // A time that has not passed yet does not cancel anything.
+    cancellation->cancelAfter(1000 * 60 * 60);
+    SLANG_CHECK(!cancellation->isCanceled());
+    cancellation->resetCancellation();
+}
@@ -0,0 +1,130 @@
+// unit-test-compress-idle-module-ir.cpp
+
+#include "../../source/core/slang-string-util.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <chrono>
+#include <thread>
+
+using namespace Slang;
+
+// Test that the IR of a module that hasn't been used for the time set by `CompressIdleModuleIR`
+// is released, and that the same code is generated from it once it has been read back.
+
+static ComPtr<slang::IBlob> _generateCode(slang::ISession* session, slang::IModule* module)
+{
+    ComPtr<slang::IBlob> diagnosticBlob;
+    ComPtr<slang::IEntryPoint> entryPoint;
+    module->findEntryPointByName("computeMain", entryPoint.writeRef());
+    if (!entryPoint)
+        return nullptr;
+
+    ComPtr<slang::IComponentType> compositeProgram;
+    slang::IComponentType* components[] = {module, entryPoint.get()};
+    session->createCompositeComponentType(
+        components,
+        2,
+        compositeProgram.writeRef(),
+        diagnosticBlob.writeRef());
+    if (!compositeProgram)
+        return nullptr;
+
+    ComPtr<slang::IComponentType> linkedProgram;
+    compositeProgram->link(linkedProgram.writeRef(), diagnosticBlob.writeRef());
+    if (!linkedProgram)
+        return nullptr;
+
+    ComPtr<slang::IBlob> code;
+    linkedProgram->getEntryPointCode(0, 0, code.writeRef(), diagnosticBlob.writeRef());
+    return code;
+}
+
+SLANG_UNIT_TEST(compressIdleModuleIR)
+{
+    const char* userSourceBody = R"(
+        RWStructuredBuffer<float> outputBuffer;
+
+        float scale(float value, int count)
+        {
+            for (int i = 0; i < count; i++)
+                value = value * 2.0 + 1.0;
+            return value;
+        }
+
+        [shader("compute")]
+        [numthreads(64, 1, 1)]
+        void computeMain(uint tid : SV_DispatchThreadID)
+        {
+            outputBuffer[tid] = scale(tid, 3);
+        }
+        )";
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::CompilerOptionEntry compilerOptionEntry = {};
+    compilerOptionEntry.name = slang::CompilerOptionName::CompressIdleModuleIR;
+    compilerOptionEntry.value.kind = slang::CompilerOptionValueKind::Int;
+    compilerOptionEntry.value.intValue0 = 1;
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.compilerOptionEntryCount = 1;
+    sessionDesc.compilerOptionEntries = &compilerOptionEntry;
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK(globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+    ComPtr<slang::IMemoryStats> memoryStats;
+    SLANG_CHECK_ABORT(
+        session->queryInterface(
+            slang::IMemoryStats::getTypeGuid(),
+            (void**)memoryStats.writeRef()) == SLANG_OK);
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = session->loadModuleFromSourceString(
+        "m",
+        "m.slang",
+        userSourceBody,
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(module != nullptr);
+
+    // The linked program is released before the module becomes idle, so that nothing else
+    // refers to the IR of the module.
+    auto code = _generateCode(session, module);
+    SLANG_CHECK_ABORT(code != nullptr);
+
+    uint64_t irBytesBefore = 0;
+    SLANG_CHECK(
+        memoryStats->getMemoryUsage(SLANG_MEMORY_CATEGORY_IR, &irBytesBefore, nullptr) ==
+        SLANG_OK);
+
+    // Idle modules are looked for when a composite is created.
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    {
+        ComPtr<slang::IComponentType> compositeProgram;
+        slang::IComponentType* components[] = {module};
+        session->createCompositeComponentType(
+            components,
+            1,
+            compositeProgram.writeRef(),
+            diagnosticBlob.writeRef());
+        SLANG_CHECK(compositeProgram != nullptr);
+    }
+
+    uint64_t irBytesAfter = 0;
+    SLANG_CHECK(
+        memoryStats->getMemoryUsage(SLANG_MEMORY_CATEGORY_IR, &irBytesAfter, nullptr) ==
+        SLANG_OK);
+    SLANG_CHECK(irBytesAfter < irBytesBefore);
+
+    // Linking reads the IR back, and generates the same code from it.
+    auto codeAgain = _generateCode(session, module);
+    SLANG_CHECK_ABORT(codeAgain != nullptr);
+    SLANG_CHECK(StringUtil::getSlice(codeAgain) == StringUtil::getSlice(code));
+}
@@ -120,6 +120,26 @@ SLANG_UNIT_TEST(crypto)
             "cca0871ecbe200379f0a1e4b46de177e2d62e655");
     }
 
+    // Several blocks, given whole and in pieces that don't line up with the blocks.
+    {
+        List<uint8_t> data;
+        for (Index i = 0; i < 1000; ++i)
+            data.add(uint8_t(i * 31 + 7));
+        SLANG_CHECK(
+            SHA1::compute(data.getBuffer(), data.getCount()).toString() ==
+            "414475341017ec91703435a6f290324818f983e9");
+
+        SHA1 sha1;
+        Index offset = 0;
+        for (Index size = 1; offset < data.getCount(); size = size * 3 % 200 + 1)
+        {
+            const Index count = Math::Min(size, data.getCount() - offset);
+            sha1.update(data.getBuffer() + offset, count);
+            offset += count;
+        }
+        SLANG_CHECK(sha1.finalize().toString() == "414475341017ec91703435a6f290324818f983e9");
+    }
+
     // DigestBuider
 
     // Raw numerical values, etc.
@@ -0,0 +1,242 @@
+// unit-test-downstream-result-cache.cpp
+
+#include "../../source/compiler-core/slang-artifact-associated-impl.h"
+#include "../../source/compiler-core/slang-artifact-util.h"
+#include "../../source/compiler-core/slang-downstream-compiler-set.h"
+#include "../../source/core/slang-blob.h"
+#include "../../source/core/slang-file-system.h"
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-process.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+namespace
+{
+
+// A shared library standing in for JIT compiled code, that holds no symbols.
+class EmptySharedLibrary : public ISlangSharedLibrary, public ComBaseObject
+{
+public:
+    SLANG_COM_BASE_IUNKNOWN_ALL
+
+    virtual SLANG_NO_THROW void* SLANG_MCALL castAs(const Guid& guid) SLANG_OVERRIDE
+    {
+        return getInterface(guid);
+    }
+    virtual SLANG_NO_THROW void* SLANG_MCALL findSymbolAddressByName(char const* name)
+        SLANG_OVERRIDE
+    {
+        SLANG_UNUSED(name);
+        return nullptr;
+    }
+
+protected:
+    ISlangUnknown* getInterface(const SlangUUID& guid)
+    {
+        if (guid == ISlangUnknown::getTypeGuid() || guid == ISlangCastable::getTypeGuid() ||
+            guid == ISlangSharedLibrary::getTypeGuid())
+        {
+            return static_cast<ISlangSharedLibrary*>(this);
+        }
+        return nullptr;
+    }
+};
+
+// A downstream compiler that "compiles" by copying its source, and counts how often it is
+// invoked. If the source starts with "warn" it also produces a warning. Host callable results
+// are an empty shared library.
+class CopyDownstreamCompiler : public DownstreamCompilerBase
+{
+public:
+    typedef DownstreamCompilerBase Super;
+
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL
+    compile(const CompileOptions& options, IArtifact** outArtifact) SLANG_OVERRIDE
+    {
+        m_compileCount++;
+
+        ComPtr<ISlangBlob> sourceBlob;
+        SLANG_RETURN_ON_FAIL(
+            options.sourceArtifacts[0]->loadBlob(ArtifactKeep::No, sourceBlob.writeRef()));
+
+        auto diagnostics = ArtifactDiagnostics::create();
+        const auto source = StringUtil::getSlice(sourceBlob);
+        if (source.startsWith(toSlice("warn")))
+        {
+            ArtifactDiagnostic diagnostic;
+            diagnostic.severity = ArtifactDiagnostic::Severity::Warning;
+            diagnostic.text = TerminatedCharSlice("warning");
+            diagnostics->add(diagnostic);
+        }
+
+        auto artifact = ArtifactUtil::createArtifactForCompileTarget(options.targetType);
+        ArtifactUtil::addAssociated(artifact, diagnostics);
+        if (options.targetType == SLANG_HOST_HOST_CALLABLE)
+        {
+            ComPtr<ISlangSharedLibrary> sharedLibrary(new EmptySharedLibrary);
+            artifact->addRepresentation(sharedLibrary);
+        }
+        else
+        {
+            artifact->addRepresentationUnknown(StringBlob::create(source));
+        }
+
+        *outArtifact = artifact.detach();
+        return SLANG_OK;
+    }
+    virtual SLANG_NO_THROW bool SLANG_MCALL isFileBased() SLANG_OVERRIDE { return false; }
+
+    CopyDownstreamCompiler()
+        : Super(Desc(SLANG_PASS_THROUGH_DXC, 1, 0))
+    {
+    }
+
+    Count m_compileCount = 0;
+};
+
+} // namespace
+
+static void _removeDirectory(const String& directory)
+{
+    auto osFileSystem = OSFileSystem::getMutableSingleton();
+    osFileSystem->enumeratePathContents(
+        directory.getBuffer(),
+        [](SlangPathType, const char* fileName, void* userData)
+        {
+            const String& directory = *static_cast<const String*>(userData);
+            String path = directory + "/" + fileName;
+            OSFileSystem::getMutableSingleton()->remove(path.getBuffer());
+        },
+        const_cast<String*>(&directory));
+    osFileSystem->remove(directory.getBuffer());
+}
+
+static SlangResult _compile(
+    DownstreamCompilerSet* compilerSet,
+    IDownstreamCompiler* compiler,
+    PersistentCache* persistentCache,
+    const char* source,
+    SlangCompileTarget target,
+    String& outCode)
+{
+    auto sourceArtifact = ArtifactUtil::createArtifactForCompileTarget(SLANG_HLSL);
+    sourceArtifact->addRepresentationUnknown(StringBlob::create(UnownedStringSlice(source)));
+
+    DownstreamCompileOptions options;
+    options.targetType = target;
+    options.sourceLanguage = SLANG_SOURCE_LANGUAGE_HLSL;
+    options.sourceArtifacts = makeSlice(sourceArtifact.readRef(), 1);
+    options.entryPointName = TerminatedCharSlice("main");
+    options.profileName = TerminatedCharSlice("cs_6_5");
+
+    ComPtr<IArtifact> artifact;
+    SLANG_RETURN_ON_FAIL(compilerSet->compileWithResultCache(
+        compiler,
+        options,
+        persistentCache,
+        artifact.writeRef()));
+
+    ComPtr<ISlangBlob> blob;
+    SLANG_RETURN_ON_FAIL(artifact->loadBlob(ArtifactKeep::No, blob.writeRef()));
+    outCode = StringUtil::getString(blob);
+    return SLANG_OK;
+}
+
+SLANG_UNIT_TEST(downstreamResultCache)
+{
+    RefPtr<DownstreamCompilerSet> compilerSet = new DownstreamCompilerSet;
+    ComPtr<CopyDownstreamCompiler> compiler(new CopyDownstreamCompiler);
+
+    // The same source and options are only compiled once.
+    String code;
+    SLANG_CHECK(
+        SLANG_SUCCEEDED(_compile(compilerSet, compiler, nullptr, "a", SLANG_DXIL, code)));
+    SLANG_CHECK(
+        SLANG_SUCCEEDED(_compile(compilerSet, compiler, nullptr, "a", SLANG_DXIL, code)));
+    SLANG_CHECK(code == "a");
+    SLANG_CHECK(compiler->m_compileCount == 1);
+    SLANG_CHECK(compilerSet->getResultCacheStats().memoryHitCount == 1);
+
+    // Different source, or different options, is compiled again.
+    SLANG_CHECK(
+        SLANG_SUCCEEDED(_compile(compilerSet, compiler, nullptr, "b", SLANG_DXIL, code)));
+    SLANG_CHECK(code == "b");
+    SLANG_CHECK(
+        SLANG_SUCCEEDED(_compile(compilerSet, compiler, nullptr, "a", SLANG_DXBC, code)));
+    SLANG_CHECK(compiler->m_compileCount == 3);
+
+    // Results with diagnostics aren't cached, as the diagnostics would be lost.
+    SLANG_CHECK(
+        SLANG_SUCCEEDED(_compile(compilerSet, compiler, nullptr, "warn", SLANG_DXIL, code)));
+    SLANG_CHECK(
+        SLANG_SUCCEEDED(_compile(compilerSet, compiler, nullptr, "warn", SLANG_DXIL, code)));
+    SLANG_CHECK(compiler->m_compileCount == 5);
+
+    // Executables aren't cached.
+    SLANG_CHECK(SLANG_SUCCEEDED(
+        _compile(compilerSet, compiler, nullptr, "a", SLANG_HOST_EXECUTABLE, code)));
+    SLANG_CHECK(SLANG_SUCCEEDED(
+        _compile(compilerSet, compiler, nullptr, "a", SLANG_HOST_EXECUTABLE, code)));
+    SLANG_CHECK(compiler->m_compileCount == 7);
+
+    // Limiting the in memory entries removes the oldest first.
+    compilerSet->setResultCacheMaxEntryCount(1);
+    SLANG_CHECK(
+        SLANG_SUCCEEDED(_compile(compilerSet, compiler, nullptr, "a", SLANG_DXBC, code)));
+    SLANG_CHECK(compiler->m_compileCount == 7);
+    SLANG_CHECK(
+        SLANG_SUCCEEDED(_compile(compilerSet, compiler, nullptr, "a", SLANG_DXIL, code)));
+    SLANG_CHECK(compiler->m_compileCount == 8);
+    compilerSet->setResultCacheMaxEntryCount(256);
+
+    // With a persistent cache, results survive clearing the in memory results.
+    const String cacheDirectory = Path::simplify(
+        Path::getParentDirectory(Path::getExecutablePath()) + "/downstream-result-cache-test" +
+        String(Process::getId()));
+    _removeDirectory(cacheDirectory);
+    {
+        PersistentCache::Desc desc;
+        desc.directory = cacheDirectory.getBuffer();
+        RefPtr<PersistentCache> persistentCache = new PersistentCache(desc);
+
+        compilerSet->clearResultCache();
+        SLANG_CHECK(SLANG_SUCCEEDED(
+            _compile(compilerSet, compiler, persistentCache, "c", SLANG_DXIL, code)));
+        SLANG_CHECK(compiler->m_compileCount == 9);
+
+        compilerSet->clearResultCache();
+        SLANG_CHECK(SLANG_SUCCEEDED(
+            _compile(compilerSet, compiler, persistentCache, "c", SLANG_DXIL, code)));
+        SLANG_CHECK(code == "c");
+        SLANG_CHECK(compiler->m_compileCount == 9);
+        SLANG_CHECK(compilerSet->getResultCacheStats().persistentHitCount == 1);
+    }
+    _removeDirectory(cacheDirectory);
+
+    // Host callable results keep the same loaded shared library alive.
+    {
+        ComPtr<ISlangSharedLibrary> sharedLibraries[2];
+        for (auto& sharedLibrary : sharedLibraries)
+        {
+            auto sourceArtifact = ArtifactUtil::createArtifactForCompileTarget(SLANG_CPP_SOURCE);
+            sourceArtifact->addRepresentationUnknown(StringBlob::create(toSlice("d")));
+
+            DownstreamCompileOptions options;
+            options.targetType = SLANG_HOST_HOST_CALLABLE;
+            options.sourceLanguage = SLANG_SOURCE_LANGUAGE_CPP;
+            options.sourceArtifacts = makeSlice(sourceArtifact.readRef(), 1);
+
+            ComPtr<IArtifact> artifact;
+            SLANG_CHECK(SLANG_SUCCEEDED(compilerSet->compileWithResultCache(
+                compiler,
+                options,
+                nullptr,
+                artifact.writeRef())));
+            SLANG_CHECK(SLANG_SUCCEEDED(
+                artifact->loadSharedLibrary(ArtifactKeep::No, sharedLibrary.writeRef())));
+        }
+        SLANG_CHECK(compiler->m_compileCount == 10);
+        SLANG_CHECK(sharedLibraries[0] == sharedLibraries[1]);
+    }
+}
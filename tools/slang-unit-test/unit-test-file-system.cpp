@@ -525,6 +525,15 @@ static SlangResult _test(FileSystemType type)
 
         // Check the file systems contents are the same
         SLANG_RETURN_ON_FAIL(_checkEqual(loadedFileSystem, fileSystem));
+
+        // The same when the files are decompressed up front across several threads
+        ComPtr<ISlangFileSystemExt> decompressedFileSystem;
+        SLANG_RETURN_ON_FAIL(loadArchiveFileSystem(
+            archiveBlob->getBufferPointer(),
+            archiveBlob->getBufferSize(),
+            decompressedFileSystem,
+            4));
+        SLANG_RETURN_ON_FAIL(_checkEqual(decompressedFileSystem, fileSystem));
     }
 
     SLANG_RETURN_ON_FAIL(fileSystem->remove("d/a"));
@@ -0,0 +1,39 @@
+// unit-test-find-prelude.cpp
+
+#include "../../source/compiler-core/slang-downstream-compiler-util.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Test that the prelude of generated source, which downstream compilers precompile, is found
+// by its include guard, up to the matching #endif.
+
+SLANG_UNIT_TEST(findPrelude)
+{
+    const UnownedStringSlice source = toSlice("// front matter\n"
+                                              "#ifndef SLANG_CPP_PRELUDE_H\n"
+                                              "#define SLANG_CPP_PRELUDE_H\n"
+                                              "#if defined(A)\n"
+                                              "  #  ifdef B\n"
+                                              "  #  endif\n"
+                                              "#endif\n"
+                                              "struct S {};\n"
+                                              "#endif\n"
+                                              "void f() {}\n");
+
+    Index start = 0;
+    Index end = 0;
+    SLANG_CHECK(
+        DownstreamCompilerUtil::findPrelude(source, toSlice("SLANG_CPP_PRELUDE_H"), start, end));
+    SLANG_CHECK(source.head(start) == toSlice("// front matter\n"));
+    SLANG_CHECK(source.tail(end) == toSlice("void f() {}\n"));
+
+    // Other include guards, and unterminated blocks, aren't the prelude.
+    SLANG_CHECK(
+        !DownstreamCompilerUtil::findPrelude(source, toSlice("SLANG_CUDA_PRELUDE_H"), start, end));
+    SLANG_CHECK(!DownstreamCompilerUtil::findPrelude(
+        toSlice("#ifndef SLANG_CPP_PRELUDE_H\nstruct S {};\n"),
+        toSlice("SLANG_CPP_PRELUDE_H"),
+        start,
+        end));
+}
@@ -0,0 +1,69 @@
+// unit-test-front-end-threads.cpp
+
+#include "../../source/core/slang-basic.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+static String _compile(slang::IGlobalSession* globalSession, const char* threadCount)
+{
+    // The first translation unit imports the second, so needs it to be checked first.
+    const char* mainSource = R"(
+        import helpers;
+        [shader("compute")]
+        [numthreads(1, 1, 1)]
+        void computeMain(uint3 tid : SV_DispatchThreadID, uniform RWStructuredBuffer<float> b)
+        {
+            b[tid.x] = scale(float(tid.x));
+        }
+        )";
+    const char* helpersSource = R"(
+        public float scale(float x)
+        {
+            return x * 2;
+        }
+        )";
+
+    ComPtr<slang::ICompileRequest> request;
+    SLANG_ALLOW_DEPRECATED_BEGIN
+    if (SLANG_FAILED(globalSession->createCompileRequest(request.writeRef())))
+        return String();
+    SLANG_ALLOW_DEPRECATED_END
+
+    const char* args[] = {"-front-end-threads", threadCount};
+    if (SLANG_FAILED(request->processCommandLineArguments(args, SLANG_COUNT_OF(args))))
+        return String();
+
+    const int targetIndex = request->addCodeGenTarget(SLANG_HLSL);
+    request->setTargetProfile(targetIndex, globalSession->findProfile("sm_5_0"));
+
+    const int mainIndex = request->addTranslationUnit(SLANG_SOURCE_LANGUAGE_SLANG, "main");
+    request->addTranslationUnitSourceString(mainIndex, "main.slang", mainSource);
+    const int helpersIndex = request->addTranslationUnit(SLANG_SOURCE_LANGUAGE_SLANG, "helpers");
+    request->addTranslationUnitSourceString(helpersIndex, "helpers.slang", helpersSource);
+
+    request->addEntryPoint(mainIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+    if (SLANG_FAILED(request->compile()))
+        return String();
+
+    ComPtr<ISlangBlob> code;
+    if (SLANG_FAILED(request->getEntryPointCodeBlob(0, targetIndex, code.writeRef())))
+        return String();
+    return String(UnownedStringSlice((const char*)code->getBufferPointer(), code->getBufferSize()));
+}
+
+// Test that a translation unit can import one added after it, and that lexing the translation
+// units on several threads with `-front-end-threads` generates the same code as one thread.
+//
+SLANG_UNIT_TEST(frontEndThreads)
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    const String code = _compile(globalSession, "1");
+    SLANG_CHECK(code.getLength() != 0);
+    SLANG_CHECK(_compile(globalSession, "4") == code);
+}
@@ -0,0 +1,95 @@
+// unit-test-get-entry-point-codes.cpp
+
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Test that the code of an entry point is the same blob each time it is asked for, with no
+// diagnostics on a repeat request, and that IComponentType::getEntryPointCodes returns the code
+// of each of the entry points asked for.
+//
+SLANG_UNIT_TEST(getEntryPointCodes)
+{
+    const char* userSourceBody = R"(
+        [shader("fragment")]
+        float4 fragMain(float4 pos:SV_Position) : SV_Target
+        {
+            return pos;
+        }
+        [shader("vertex")]
+        float4 vertMain(float4 pos) : SV_Position
+        {
+            return pos;
+        }
+        )";
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK(globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = session->loadModuleFromSourceString(
+        "m",
+        "m.slang",
+        userSourceBody,
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(module != nullptr);
+
+    ComPtr<slang::IEntryPoint> fragEntryPoint;
+    module->findEntryPointByName("fragMain", fragEntryPoint.writeRef());
+    ComPtr<slang::IEntryPoint> vertEntryPoint;
+    module->findEntryPointByName("vertMain", vertEntryPoint.writeRef());
+    SLANG_CHECK_ABORT(fragEntryPoint != nullptr && vertEntryPoint != nullptr);
+
+    slang::IComponentType* components[] = {module, fragEntryPoint, vertEntryPoint};
+    ComPtr<slang::IComponentType> composedProgram;
+    SLANG_CHECK_ABORT(
+        session->createCompositeComponentType(
+            components,
+            3,
+            composedProgram.writeRef(),
+            diagnosticBlob.writeRef()) == SLANG_OK);
+    ComPtr<slang::IComponentType> linkedProgram;
+    SLANG_CHECK_ABORT(
+        composedProgram->link(linkedProgram.writeRef(), diagnosticBlob.writeRef()) == SLANG_OK);
+
+    ComPtr<slang::IBlob> vertCode;
+    SLANG_CHECK(linkedProgram->getEntryPointCode(1, 0, vertCode.writeRef()) == SLANG_OK);
+    SLANG_CHECK_ABORT(vertCode != nullptr);
+    ComPtr<slang::IBlob> vertCodeAgain;
+    SLANG_CHECK(linkedProgram->getEntryPointCode(1, 0, vertCodeAgain.writeRef()) == SLANG_OK);
+    SLANG_CHECK(vertCodeAgain == vertCode);
+
+    // Code that is handed out again has no diagnostics, so none are left in a reused pointer.
+    slang::IBlob* staleDiagnostics = (slang::IBlob*)vertCode.get();
+    ComPtr<slang::IBlob> vertCodeThird;
+    SLANG_CHECK(
+        linkedProgram->getEntryPointCode(1, 0, vertCodeThird.writeRef(), &staleDiagnostics) ==
+        SLANG_OK);
+    SLANG_CHECK(staleDiagnostics == nullptr);
+
+    SlangInt entryPointIndices[] = {1, 0};
+    slang::IBlob* codes[2] = {};
+    SLANG_CHECK_ABORT(
+        linkedProgram->getEntryPointCodes(2, entryPointIndices, 0, codes) == SLANG_OK);
+    SLANG_CHECK(codes[0] == vertCode);
+    SLANG_CHECK(codes[1] != nullptr && codes[1] != vertCode);
+    for (auto code : codes)
+        code->release();
+
+    // When one of the entry points can't be compiled, none of the code is returned.
+    SlangInt badEntryPointIndices[] = {0, 2};
+    SLANG_CHECK(
+        SLANG_FAILED(linkedProgram->getEntryPointCodes(2, badEntryPointIndices, 0, codes)));
+    SLANG_CHECK(codes[0] == nullptr);
+}
@@ -0,0 +1,117 @@
+// unit-test-incremental-codegen.cpp
+
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Compile the entry point of a module loaded from `source` in a new session of `globalSession`.
+static ComPtr<slang::IBlob> _compileInNewSession(
+    slang::IGlobalSession* globalSession,
+    const char* source)
+{
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::CompilerOptionEntry compilerOptionEntry = {};
+    compilerOptionEntry.name = slang::CompilerOptionName::IncrementalCodeGen;
+    compilerOptionEntry.value.kind = slang::CompilerOptionValueKind::Int;
+    compilerOptionEntry.value.intValue0 = 1;
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.compilerOptionEntryCount = 1;
+    sessionDesc.compilerOptionEntries = &compilerOptionEntry;
+    ComPtr<slang::ISession> session;
+    if (SLANG_FAILED(globalSession->createSession(sessionDesc, session.writeRef())))
+        return nullptr;
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module =
+        session->loadModuleFromSourceString("m", "m.slang", source, diagnosticBlob.writeRef());
+    if (!module)
+        return nullptr;
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    module->findEntryPointByName("computeMain", entryPoint.writeRef());
+    if (!entryPoint)
+        return nullptr;
+
+    slang::IComponentType* components[] = {module, entryPoint.get()};
+    ComPtr<slang::IComponentType> compositeProgram;
+    session->createCompositeComponentType(
+        components,
+        2,
+        compositeProgram.writeRef(),
+        diagnosticBlob.writeRef());
+    if (!compositeProgram)
+        return nullptr;
+
+    ComPtr<slang::IBlob> code;
+    compositeProgram->getEntryPointCode(0, 0, code.writeRef(), diagnosticBlob.writeRef());
+    return code;
+}
+
+// Test that with -incremental-codegen, a program whose module is reloaded after a change to a
+// function it doesn't call gets the code generated before, and one whose functions changed
+// gets new code.
+
+SLANG_UNIT_TEST(incrementalCodeGen)
+{
+    const char* originalSource = R"(
+        RWStructuredBuffer<float> outputBuffer;
+        float scale(float x) { return x * 2.0; }
+
+        [shader("compute")]
+        [numthreads(1, 1, 1)]
+        void computeMain(uint tid : SV_DispatchThreadID)
+        {
+            outputBuffer[tid] = scale(tid);
+        }
+
+        float unused(float x) { return x + 1.0; }
+        )";
+    const char* unusedFunctionChangedSource = R"(
+        RWStructuredBuffer<float> outputBuffer;
+        float scale(float x) { return x * 2.0; }
+
+        [shader("compute")]
+        [numthreads(1, 1, 1)]
+        void computeMain(uint tid : SV_DispatchThreadID)
+        {
+            outputBuffer[tid] = scale(tid);
+        }
+
+        float unused(float x) { return x + 3.0; }
+        )";
+    const char* usedFunctionChangedSource = R"(
+        RWStructuredBuffer<float> outputBuffer;
+        float scale(float x) { return x * 4.0; }
+
+        [shader("compute")]
+        [numthreads(1, 1, 1)]
+        void computeMain(uint tid : SV_DispatchThreadID)
+        {
+            outputBuffer[tid] = scale(tid);
+        }
+
+        float unused(float x) { return x + 3.0; }
+        )";
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    auto originalCode = _compileInNewSession(globalSession, originalSource);
+    SLANG_CHECK_ABORT(originalCode != nullptr);
+
+    auto unusedFunctionChangedCode =
+        _compileInNewSession(globalSession, unusedFunctionChangedSource);
+    SLANG_CHECK(unusedFunctionChangedCode == originalCode);
+
+    auto usedFunctionChangedCode = _compileInNewSession(globalSession, usedFunctionChangedSource);
+    SLANG_CHECK_ABORT(usedFunctionChangedCode != nullptr);
+    SLANG_CHECK(usedFunctionChangedCode != originalCode);
+}
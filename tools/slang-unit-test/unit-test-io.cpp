@@ -1,5 +1,7 @@
 // unit-test-io.cpp
 
+#include "../../source/compiler-core/slang-include-system.h"
+#include "../../source/core/slang-file-system.h"
 #include "../../source/core/slang-io.h"
 #include "unit-test/slang-unit-test.h"
 
@@ -57,7 +59,150 @@ static SlangResult _checkGenerateTemporary()
     return SLANG_OK;
 }
 
+static SlangResult _checkMapAllBytes()
+{
+    String path;
+    SLANG_RETURN_ON_FAIL(File::generateTemporary(toSlice("slang-check"), path));
+
+    // An empty file maps to an empty blob
+    {
+        ComPtr<ISlangBlob> blob;
+        SLANG_RETURN_ON_FAIL(File::mapAllBytes(path, blob.writeRef()));
+        SLANG_CHECK(blob->getBufferSize() == 0);
+    }
+
+    // The mapping holds the contents of the file
+    const UnownedStringSlice text = toSlice("Mapped contents");
+    SLANG_RETURN_ON_FAIL(File::writeAllBytes(path, text.begin(), text.getLength()));
+    {
+        ComPtr<ISlangBlob> blob;
+        SLANG_RETURN_ON_FAIL(File::mapAllBytes(path, blob.writeRef()));
+        SLANG_CHECK(blob->getBufferSize() == size_t(text.getLength()));
+        SLANG_CHECK(
+            UnownedStringSlice((const char*)blob->getBufferPointer(), blob->getBufferSize()) ==
+            text);
+    }
+
+    // Only files of at least the minimum size are mapped, and their contents are terminated
+    {
+        ComPtr<ISlangBlob> blob;
+        SLANG_CHECK(
+            File::mapAllBytesTerminated(path, text.getLength() + 1, blob.writeRef()) ==
+            SLANG_E_NOT_AVAILABLE);
+        SLANG_RETURN_ON_FAIL(
+            File::mapAllBytesTerminated(path, text.getLength(), blob.writeRef()));
+        SLANG_CHECK(blob->getBufferSize() == size_t(text.getLength()));
+        SLANG_CHECK(((const char*)blob->getBufferPointer())[text.getLength()] == 0);
+    }
+
+    // Large files are mapped by the file system, and loaded the same as smaller ones
+    {
+        List<char> contents;
+        contents.setCount(OSFileSystem::kMinMappedFileSize + 1);
+        for (Index i = 0; i < contents.getCount(); i++)
+            contents[i] = char('a' + i % 26);
+        SLANG_RETURN_ON_FAIL(
+            File::writeAllBytes(path, contents.getBuffer(), contents.getCount()));
+
+        ComPtr<ISlangBlob> blob;
+        SLANG_RETURN_ON_FAIL(
+            OSFileSystem::getExtSingleton()->loadFile(path.getBuffer(), blob.writeRef()));
+        SLANG_CHECK(blob->getBufferSize() == size_t(contents.getCount()));
+        SLANG_CHECK(
+            memcmp(blob->getBufferPointer(), contents.getBuffer(), contents.getCount()) == 0);
+        SLANG_CHECK(((const char*)blob->getBufferPointer())[contents.getCount()] == 0);
+    }
+
+    SLANG_RETURN_ON_FAIL(File::remove(path));
+
+    // A file that doesn't exist can't be mapped
+    ComPtr<ISlangBlob> blob;
+    SLANG_CHECK(SLANG_FAILED(File::mapAllBytes(path, blob.writeRef())));
+    return SLANG_OK;
+}
+
+static SlangResult _checkSharedCacheFileSystem()
+{
+    String path;
+    SLANG_RETURN_ON_FAIL(File::generateTemporary(toSlice("slang-check"), path));
+    SLANG_RETURN_ON_FAIL(File::writeAllText(path, "first"));
+
+    ComPtr<SharedCacheFileSystem> fileSystem(new SharedCacheFileSystem());
+
+    // Loading the same file again returns the contents that are held for it
+    ComPtr<ISlangBlob> firstBlob;
+    SLANG_RETURN_ON_FAIL(fileSystem->loadFile(path.getBuffer(), firstBlob.writeRef()));
+    SLANG_CHECK(StringUtil::getSlice(firstBlob) == toSlice("first"));
+    {
+        ComPtr<ISlangBlob> blob;
+        SLANG_RETURN_ON_FAIL(fileSystem->loadFile(path.getBuffer(), blob.writeRef()));
+        SLANG_CHECK(blob == firstBlob);
+    }
+    SLANG_CHECK(fileSystem->getEntryCount() == 1);
+
+    // A file that has changed on disk is reloaded
+    SLANG_RETURN_ON_FAIL(File::writeAllText(path, "second time"));
+    {
+        ComPtr<ISlangBlob> blob;
+        SLANG_RETURN_ON_FAIL(fileSystem->loadFile(path.getBuffer(), blob.writeRef()));
+        SLANG_CHECK(StringUtil::getSlice(blob) == toSlice("second time"));
+    }
+    SLANG_CHECK(fileSystem->getEntryCount() == 1);
+
+    fileSystem->clearCache();
+    SLANG_CHECK(fileSystem->getEntryCount() == 0);
+
+    SLANG_RETURN_ON_FAIL(File::remove(path));
+
+    // A file that doesn't exist can't be loaded
+    ComPtr<ISlangBlob> blob;
+    SLANG_CHECK(SLANG_FAILED(fileSystem->loadFile(path.getBuffer(), blob.writeRef())));
+    return SLANG_OK;
+}
+
+static SlangResult _checkSearchDirectoryIndex()
+{
+    String directory;
+    SLANG_RETURN_ON_FAIL(File::generateTemporary(toSlice("slang-check"), directory));
+    SLANG_RETURN_ON_FAIL(File::remove(directory));
+    SLANG_CHECK(Path::createDirectory(directory));
+    SLANG_CHECK(Path::createDirectory(Path::combine(directory, "Inner")));
+    SLANG_RETURN_ON_FAIL(File::writeAllText(Path::combine(directory, "a.h"), "a"));
+
+    RefPtr<DirectoryListingCache> listingCache = new DirectoryListingCache();
+    {
+        RefPtr<SearchDirectoryIndex> index = new SearchDirectoryIndex(listingCache);
+
+        // Only the first element of a path is looked up, ignoring case
+        SLANG_CHECK(index->mayContain(directory, "a.h"));
+        SLANG_CHECK(index->mayContain(directory, "A.H"));
+        SLANG_CHECK(index->mayContain(directory, "inner/b.h"));
+        SLANG_CHECK(!index->mayContain(directory, "b.h"));
+        SLANG_CHECK(!index->mayContain(directory, "outer/b.h"));
+        SLANG_CHECK(index->mayContain(directory, "../b.h"));
+
+        // A directory that can't be listed may hold anything
+        SLANG_CHECK(index->mayContain(Path::combine(directory, "missing"), "b.h"));
+
+        // The listing is kept by the index once it has been read
+        SLANG_RETURN_ON_FAIL(File::writeAllText(Path::combine(directory, "b.h"), "b"));
+        SLANG_CHECK(!index->mayContain(directory, "b.h"));
+    }
+
+    // A new index reads the listing again, as the directory has changed
+    {
+        RefPtr<SearchDirectoryIndex> index = new SearchDirectoryIndex(listingCache);
+        SLANG_CHECK(index->mayContain(directory, "b.h"));
+    }
+
+    SLANG_RETURN_ON_FAIL(Path::removeNonEmpty(directory));
+    return SLANG_OK;
+}
+
 SLANG_UNIT_TEST(io)
 {
     SLANG_CHECK(SLANG_SUCCEEDED(_checkGenerateTemporary()));
+    SLANG_CHECK(SLANG_SUCCEEDED(_checkMapAllBytes()));
+    SLANG_CHECK(SLANG_SUCCEEDED(_checkSharedCacheFileSystem()));
+    SLANG_CHECK(SLANG_SUCCEEDED(_checkSearchDirectoryIndex()));
 }
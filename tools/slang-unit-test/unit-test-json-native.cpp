@@ -77,6 +77,21 @@ static const StructRttiInfo _makeSomeStructRtti()
 
 } // namespace
 
+static SlangResult _parse(const String& json, DiagnosticSink* sink, JSONListener* listener)
+{
+    SourceManager* sourceManager = sink->getSourceManager();
+
+    String contents(json);
+    SourceFile* sourceFile =
+        sourceManager->createSourceFileWithString(PathInfo::makeUnknown(), contents);
+    SourceView* sourceView = sourceManager->createSourceView(sourceFile, nullptr, SourceLoc());
+
+    JSONLexer lexer;
+    lexer.init(sourceView, sink);
+
+    JSONParser parser;
+    return parser.parse(&lexer, sourceView, listener, sink);
+}
 
 static SlangResult _check()
 {
@@ -123,18 +138,8 @@ static SlangResult _check()
     JSONValue readValue;
     {
         // Now need to parse as JSON
-        String contents(json);
-        SourceFile* sourceFile =
-            sourceManager.createSourceFileWithString(PathInfo::makeUnknown(), contents);
-        SourceView* sourceView = sourceManager.createSourceView(sourceFile, nullptr, SourceLoc());
-
-        JSONLexer lexer;
-        lexer.init(sourceView, &sink);
-
         JSONBuilder builder(container);
-
-        JSONParser parser;
-        SLANG_RETURN_ON_FAIL(parser.parse(&lexer, sourceView, &builder, &sink));
+        SLANG_RETURN_ON_FAIL(_parse(json, &sink, &builder));
 
         readValue = builder.getRootValue();
     }
@@ -153,6 +158,31 @@ static SlangResult _check()
         }
     }
 
+    // Convert to native while parsing
+    {
+        JSONToNativeListener listener(container, &typeMap, &sink);
+
+        SomeStruct readS;
+        listener.setTarget(&readS);
+        SLANG_RETURN_ON_FAIL(_parse(json, &sink, &listener));
+        SLANG_RETURN_ON_FAIL(listener.getResult());
+
+        SLANG_CHECK(readS == s);
+
+        // Fields that aren't defined on the type, and missing fields, fail
+        const char* const invalidJsons[] = {
+            "{ \"a\" : 1, \"notAField\" : 2 }",
+            "{ \"a\" : 1 }",
+        };
+        for (auto invalidJson : invalidJsons)
+        {
+            SomeStruct invalidS;
+            listener.setTarget(&invalidS);
+            SLANG_RETURN_ON_FAIL(_parse(invalidJson, &sink, &listener));
+            SLANG_CHECK(SLANG_FAILED(listener.getResult()));
+        }
+    }
+
     return SLANG_OK;
 }
 
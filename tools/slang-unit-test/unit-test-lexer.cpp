@@ -0,0 +1,131 @@
+// unit-test-lexer.cpp
+
+#include "../../source/compiler-core/slang-lexer.h"
+#include "../../source/compiler-core/slang-name.h"
+#include "../../source/compiler-core/slang-source-loc.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+namespace
+{ // anonymous
+
+struct Piece
+{
+    TokenType type;
+    String text;
+};
+
+} // namespace
+
+// The content of a token lexed from `text`, which drops escaped newlines.
+static String _getScrubbedContent(const String& text)
+{
+    StringBuilder builder;
+    for (Index i = 0; i < text.getLength(); ++i)
+    {
+        if (text[i] == '\\' && i + 1 < text.getLength() &&
+            (text[i + 1] == '\n' || text[i + 1] == '\r'))
+        {
+            i += (text[i + 1] == '\r' && i + 2 < text.getLength() && text[i + 2] == '\n') ? 2 : 1;
+            continue;
+        }
+        builder.appendChar(text[i]);
+    }
+    return builder;
+}
+
+// Lex the concatenation of `pieces`, and check each piece is lexed as one token of its type.
+static bool _lexesAsPieces(ConstArrayView<Piece> pieces)
+{
+    StringBuilder text;
+    for (const auto& piece : pieces)
+        text << piece.text;
+
+    SourceManager sourceManager;
+    sourceManager.initialize(nullptr, nullptr);
+    auto sourceFile = sourceManager.createSourceFileWithString(PathInfo::makeUnknown(), text);
+    auto sourceView = sourceManager.createSourceView(sourceFile, nullptr, SourceLoc());
+
+    DiagnosticSink sink(&sourceManager, nullptr);
+    RootNamePool rootNamePool;
+    NamePool namePool;
+    namePool.setRootNamePool(&rootNamePool);
+    MemoryArena memoryArena;
+    memoryArena.init(1 << 16);
+
+    Lexer lexer;
+    lexer.initialize(sourceView, &sink, &namePool, &memoryArena);
+
+    for (const auto& piece : pieces)
+    {
+        const Token token = lexer.lexToken();
+        if (token.type != piece.type ||
+            token.getContent() != _getScrubbedContent(piece.text).getUnownedSlice())
+            return false;
+    }
+    return lexer.lexToken().type == TokenType::EndOfFile;
+}
+
+// Test that runs of identifier characters, whitespace and comments of every length up to a few
+// times the width the lexer scans at once are lexed the same, including ones that end at the
+// end of the input.
+//
+SLANG_UNIT_TEST(lexer)
+{
+    const char identifierChars[] = "aZ_9bY0c";
+    // Each is added whole, so a comment never ends part way through a code point.
+    const char* const commentChars[] = {"x", "*", " ", "/", "\t", "\xc3\xa9"};
+
+    for (Index length = 1; length < 50; ++length)
+    {
+        StringBuilder identifierBuilder;
+        StringBuilder spaceBuilder;
+        StringBuilder commentBuilder;
+        for (Index i = 0; i < length; ++i)
+        {
+            identifierBuilder.appendChar(
+                identifierChars[i % (SLANG_COUNT_OF(identifierChars) - 1)]);
+            spaceBuilder.appendChar((i % 3) ? ' ' : '\t');
+            commentBuilder << commentChars[i % SLANG_COUNT_OF(commentChars)];
+        }
+        const String identifier = identifierBuilder;
+        const String space = spaceBuilder;
+        const String comment = commentBuilder;
+
+        const Piece pieces[] = {
+            {TokenType::Identifier, identifier},
+            {TokenType::WhiteSpace, space},
+            {TokenType::LineComment, "//" + comment},
+            {TokenType::NewLine, "\n"},
+            {TokenType::BlockComment, "/*" + comment + "\n" + comment + "*/"},
+            {TokenType::WhiteSpace, space},
+            {TokenType::Identifier, identifier},
+        };
+        SLANG_CHECK(_lexesAsPieces(makeConstArrayView(pieces)));
+
+        // The same runs at the end of the input.
+        const Piece endIdentifier[] = {{TokenType::Identifier, identifier}};
+        SLANG_CHECK(_lexesAsPieces(makeConstArrayView(endIdentifier)));
+        const Piece endSpace[] = {{TokenType::Identifier, "a"}, {TokenType::WhiteSpace, space}};
+        SLANG_CHECK(_lexesAsPieces(makeConstArrayView(endSpace)));
+        const Piece endComment[] = {{TokenType::LineComment, "//" + comment}};
+        SLANG_CHECK(_lexesAsPieces(makeConstArrayView(endComment)));
+
+        // Escaped newlines continue identifiers, whitespace and line comments.
+        const Piece escapedNewLines[] = {
+            {TokenType::Identifier, identifier + "\\\n" + identifier},
+            {TokenType::WhiteSpace, space + "\\\r\n" + space},
+            {TokenType::LineComment, "//" + comment + "\\\n" + comment},
+            {TokenType::NewLine, "\n"},
+        };
+        SLANG_CHECK(_lexesAsPieces(makeConstArrayView(escapedNewLines)));
+
+        // `*` and `/` split by an escaped newline still end a block comment.
+        const Piece splitCommentEnd[] = {
+            {TokenType::BlockComment, "/*" + comment + "*\\\n/"},
+            {TokenType::Identifier, identifier},
+        };
+        SLANG_CHECK(_lexesAsPieces(makeConstArrayView(splitCommentEnd)));
+    }
+}
@@ -0,0 +1,109 @@
+// unit-test-memory-stats.cpp
+
+#include "../../source/core/slang-memory-arena.h"
+#include "../../source/core/slang-performance-profiler.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Test that the memory of arenas is counted, and that the memory used by a session is
+// available from the IMemoryStats interface.
+
+SLANG_UNIT_TEST(memoryStats)
+{
+    // The blocks of an arena are counted, and uncounted when freed.
+    {
+        RefPtr<MemoryAccounting> accounting = new MemoryAccounting();
+        {
+            MemoryArena arena(1024);
+            arena.setAccounting(accounting, MemoryCategory::IR);
+            arena.allocate(100);
+            arena.allocate(4000);
+            const uint64_t arenaBytes = accounting->getCurrentBytes(MemoryCategory::IR);
+            SLANG_CHECK(arenaBytes >= 4100);
+            SLANG_CHECK(arenaBytes == arena.calcTotalMemoryAllocated());
+            SLANG_CHECK(accounting->getCurrentBytes(MemoryCategory::AST) == 0);
+
+            arena.deallocateAll();
+            arena.allocate(100);
+            SLANG_CHECK(
+                accounting->getCurrentBytes(MemoryCategory::IR) ==
+                arena.calcTotalMemoryAllocated());
+        }
+        SLANG_CHECK(accounting->getTotalCurrentBytes() == 0);
+        SLANG_CHECK(accounting->getTotalPeakBytes() >= 4100);
+
+        accounting->resetPeaks();
+        SLANG_CHECK(accounting->getTotalPeakBytes() == 0);
+
+        uint64_t currentBytes = 1;
+        uint64_t peakBytes = 1;
+        SLANG_CHECK(
+            accounting->getUsage(SLANG_MEMORY_CATEGORY_IR, &currentBytes, &peakBytes) == SLANG_OK);
+        SLANG_CHECK(currentBytes == 0 && peakBytes == 0);
+        SLANG_CHECK(
+            accounting->getUsage(SLANG_MEMORY_CATEGORY_COUNT_OF, nullptr, nullptr) ==
+            SLANG_E_INVALID_ARG);
+    }
+
+    const char* userSourceBody = R"(
+        RWStructuredBuffer<float> outputBuffer;
+
+        [shader("compute")]
+        [numthreads(64, 1, 1)]
+        void computeMain(uint tid : SV_DispatchThreadID)
+        {
+            outputBuffer[tid] = tid * 2.0;
+        }
+        )";
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK(globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+    ComPtr<slang::IMemoryStats> memoryStats;
+    SLANG_CHECK_ABORT(
+        session->queryInterface(
+            slang::IMemoryStats::getTypeGuid(),
+            (void**)memoryStats.writeRef()) == SLANG_OK);
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = session->loadModuleFromSourceString(
+        "m",
+        "m.slang",
+        userSourceBody,
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(module != nullptr);
+
+    uint64_t irBytes = 0;
+    uint64_t astBytes = 0;
+    uint64_t totalBytes = 0;
+    uint64_t totalPeakBytes = 0;
+    SLANG_CHECK(
+        memoryStats->getMemoryUsage(SLANG_MEMORY_CATEGORY_IR, &irBytes, nullptr) == SLANG_OK);
+    SLANG_CHECK(
+        memoryStats->getMemoryUsage(SLANG_MEMORY_CATEGORY_AST, &astBytes, nullptr) == SLANG_OK);
+    SLANG_CHECK(
+        memoryStats->getMemoryUsage(SLANG_MEMORY_CATEGORY_TOTAL, &totalBytes, &totalPeakBytes) ==
+        SLANG_OK);
+    SLANG_CHECK(irBytes > 0);
+    SLANG_CHECK(astBytes > 0);
+    SLANG_CHECK(totalBytes == irBytes + astBytes);
+    SLANG_CHECK(totalPeakBytes >= totalBytes);
+
+    memoryStats->resetPeakMemoryUsage();
+    SLANG_CHECK(
+        memoryStats->getMemoryUsage(SLANG_MEMORY_CATEGORY_TOTAL, &totalBytes, &totalPeakBytes) ==
+        SLANG_OK);
+    SLANG_CHECK(totalPeakBytes == totalBytes);
+}
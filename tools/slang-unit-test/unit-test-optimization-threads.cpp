@@ -0,0 +1,83 @@
+// unit-test-optimization-threads.cpp
+
+#include "../../source/core/slang-basic.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+static String _compile(slang::IGlobalSession* globalSession, const char* source, int threadCount)
+{
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::CompilerOptionEntry compilerOptionEntry = {};
+    compilerOptionEntry.name = slang::CompilerOptionName::OptimizationThreadCount;
+    compilerOptionEntry.value.kind = slang::CompilerOptionValueKind::Int;
+    compilerOptionEntry.value.intValue0 = threadCount;
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.compilerOptionEntryCount = 1;
+    sessionDesc.compilerOptionEntries = &compilerOptionEntry;
+
+    ComPtr<slang::ISession> session;
+    if (SLANG_FAILED(globalSession->createSession(sessionDesc, session.writeRef())))
+        return String();
+
+    ComPtr<slang::IBlob> diagnostics;
+    auto module =
+        session->loadModuleFromSourceString("m", "m.slang", source, diagnostics.writeRef());
+    if (!module)
+        return String();
+
+    ComPtr<slang::IComponentType> linkedProgram;
+    module->link(linkedProgram.writeRef(), diagnostics.writeRef());
+    if (!linkedProgram)
+        return String();
+
+    ComPtr<slang::IBlob> code;
+    if (SLANG_FAILED(
+            linkedProgram->getEntryPointCode(0, 0, code.writeRef(), diagnostics.writeRef())))
+        return String();
+    return String(UnownedStringSlice((const char*)code->getBufferPointer(), code->getBufferSize()));
+}
+
+// Test that computing dominator trees on several threads with `OptimizationThreadCount`
+// generates the same code as computing them on one.
+//
+SLANG_UNIT_TEST(optimizationThreads)
+{
+    const char* userSource = R"(
+        float sum(uint n)
+        {
+            float s = 0;
+            for (uint i = 0; i < n; i++)
+                s += float(i);
+            return s;
+        }
+        float pick(uint n, float a, float b)
+        {
+            float r = a;
+            if (n > 4)
+                r = b;
+            return r * 2;
+        }
+        [shader("compute")]
+        [numthreads(1, 1, 1)]
+        void computeMain(uint3 tid : SV_DispatchThreadID, uniform RWStructuredBuffer<float> b)
+        {
+            b[tid.x] = sum(tid.x) + pick(tid.y, b[0], b[1]);
+        }
+        )";
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    const String code = _compile(globalSession, userSource, 1);
+    SLANG_CHECK(code.getLength() != 0);
+    SLANG_CHECK(_compile(globalSession, userSource, 4) == code);
+}
@@ -0,0 +1,143 @@
+// unit-test-performance-profiler.cpp
+
+#include "../../source/core/slang-basic.h"
+#include "../../source/core/slang-performance-profiler.h"
+#include "slang-com-ptr.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <thread>
+
+using namespace Slang;
+
+static void _innerFunction()
+{
+    SLANG_PROFILE_SECTION(inner);
+}
+
+static void _outerFunction()
+{
+    SLANG_PROFILE_SECTION(outer);
+    _innerFunction();
+    _innerFunction();
+}
+
+static Index _countOccurrences(const String& text, const char* find)
+{
+    Index count = 0;
+    Index pos = 0;
+    while ((pos = text.indexOf(find, pos)) >= 0)
+    {
+        count++;
+        pos += Index(strlen(find));
+    }
+    return count;
+}
+
+SLANG_UNIT_TEST(performanceProfilerTrace)
+{
+    auto profiler = PerformanceProfiler::getProfiler();
+    profiler->clear();
+
+    // Without tracing enabled, no events are recorded.
+    _outerFunction();
+    {
+        StringBuilder json;
+        profiler->getTraceJSON(json);
+        SLANG_CHECK(json.indexOf("\"name\"") < 0);
+    }
+
+    profiler->clear();
+    profiler->setTraceEnabled(true);
+    {
+        SLANG_PROFILE_TAG(UnownedStringSlice("myEntryPoint"));
+        _outerFunction();
+    }
+    _innerFunction();
+    profiler->setTraceEnabled(false);
+
+    StringBuilder json;
+    profiler->getTraceJSON(json);
+    const String text = json;
+
+    SLANG_CHECK(text.startsWith("{\"displayTimeUnit\""));
+    SLANG_CHECK(_countOccurrences(text, "\"name\":\"outer\"") == 1);
+    SLANG_CHECK(_countOccurrences(text, "\"name\":\"inner\"") == 3);
+
+    // Nested scopes are recorded one level deeper than their parent.
+    SLANG_CHECK(_countOccurrences(text, "\"depth\":0") == 2);
+    SLANG_CHECK(_countOccurrences(text, "\"depth\":1") == 2);
+
+    // Only events within the tag scope are tagged.
+    SLANG_CHECK(_countOccurrences(text, "\"tag\":\"myEntryPoint\"") == 3);
+
+    // The trace is also exposed through ISlangProfiler2.
+    ComPtr<ISlangProfiler> slangProfiler(new SlangProfiler(profiler));
+    ComPtr<ISlangProfiler2> slangProfiler2;
+    SLANG_CHECK_ABORT(
+        slangProfiler->queryInterface(
+            ISlangProfiler2::getTypeGuid(),
+            (void**)slangProfiler2.writeRef()) == SLANG_OK);
+    ComPtr<ISlangBlob> traceBlob;
+    SLANG_CHECK(SLANG_SUCCEEDED(slangProfiler2->getTraceJSON(traceBlob.writeRef())));
+    SLANG_CHECK(traceBlob && traceBlob->getBufferSize() == size_t(json.getLength()));
+
+    profiler->clear();
+}
+
+SLANG_UNIT_TEST(performanceProfilerTraceThreads)
+{
+    auto profiler = PerformanceProfiler::getProfiler();
+    profiler->clear();
+    profiler->setTraceEnabled(true);
+
+    // What is recorded on other threads is part of the results, each event with the index of
+    // the thread that recorded it.
+    _innerFunction();
+    std::thread worker(
+        []()
+        {
+            SLANG_PROFILE_TAG(UnownedStringSlice("workerEntryPoint"));
+            _outerFunction();
+        });
+    worker.join();
+    profiler->setTraceEnabled(false);
+
+    StringBuilder json;
+    profiler->getTraceJSON(json);
+    const String text = json;
+    SLANG_CHECK(_countOccurrences(text, "\"name\":\"outer\"") == 1);
+    SLANG_CHECK(_countOccurrences(text, "\"name\":\"inner\"") == 3);
+    SLANG_CHECK(_countOccurrences(text, "\"tag\":\"workerEntryPoint\"") == 3);
+
+    // The first event is the one recorded on this thread, and the others were recorded on
+    // the worker.
+    const char* tidKey = "\"tid\":";
+    auto getTid = [&](Index pos) -> String
+    {
+        const Index start = pos + Index(strlen(tidKey));
+        return text.subString(start, text.indexOf(',', start) - start);
+    };
+    const Index firstTidPos = text.indexOf(tidKey);
+    SLANG_CHECK_ABORT(firstTidPos >= 0);
+    const String mainThreadTid = getTid(firstTidPos);
+    Index workerEventCount = 0;
+    for (Index pos = text.indexOf(tidKey, firstTidPos + 1); pos >= 0;
+         pos = text.indexOf(tidKey, pos + 1))
+    {
+        if (getTid(pos) != mainThreadTid)
+            workerEventCount++;
+    }
+    SLANG_CHECK(workerEventCount == 3);
+
+    // The invocation counts of all threads are added up.
+    ComPtr<ISlangProfiler> slangProfiler(new SlangProfiler(profiler));
+    uint32_t innerInvocationCount = 0;
+    for (uint32_t i = 0; i < uint32_t(slangProfiler->getEntryCount()); ++i)
+    {
+        if (strcmp(slangProfiler->getEntryName(i), "inner") == 0)
+            innerInvocationCount = slangProfiler->getEntryInvocationTimes(i);
+    }
+    SLANG_CHECK(innerInvocationCount == 3);
+
+    profiler->clear();
+}
@@ -155,8 +155,35 @@ struct PersistentCacheTest
     // Get the absolute filename for a cache entry file.
     String getEntryFileName(const Entry& entry) { return cache->getEntryFileName(entry.key); }
 
-    // Get the absolute filename of the cache index file.
-    String getIndexFilename() { return cache->m_indexFileName; }
+    // Get the absolute filename of the index file of the shard holding an entry.
+    String getIndexFilename(const Entry& entry)
+    {
+        return cache->getShard(entry.key).indexFileName;
+    }
+
+    // Get the generation of the index file of the shard holding an entry.
+    // This changes each time the index file is written.
+    uint32_t getIndexGeneration(const Entry& entry)
+    {
+        PersistentCache::IndexStamp stamp;
+        SLANG_CHECK(cache->readIndexStamp(getIndexFilename(entry), stamp) == SLANG_OK);
+        return stamp.generation;
+    }
+
+    // Get the absolute filename of the journal file of the shard holding an entry.
+    String getJournalFilename(const Entry& entry)
+    {
+        return cache->getShard(entry.key).journalFileName;
+    }
+
+    // Create another cache on the same directory, as another process would.
+    RefPtr<PersistentCache> createOtherCache(Count maxEntryCount = 0)
+    {
+        PersistentCache::Desc desc;
+        desc.directory = cacheDirectory.getBuffer();
+        desc.maxEntryCount = maxEntryCount;
+        return new PersistentCache(desc);
+    }
 };
 
 } // namespace Slang
@@ -359,20 +386,20 @@ struct CorruptionTest : public PersistentCacheTest
         // Test behavior when the index file is removed before reading.
         writeEntry(entries[0]);
         SLANG_CHECK(readEntry(entries[0]) == true);
-        osFileSystem->remove(getIndexFilename().getBuffer());
+        osFileSystem->remove(getIndexFilename(entries[0]).getBuffer());
         // We expect a SLANG_E_NOT_FOUND because the cache has an empty index now.
         SLANG_CHECK(cache->readEntry(entries[0].key, data.writeRef()) == SLANG_E_NOT_FOUND);
 
         // Test behavior when the index file is removed before writing.
         writeEntry(entries[0]);
         SLANG_CHECK(readEntry(entries[0]) == true);
-        osFileSystem->remove(getIndexFilename().getBuffer());
+        osFileSystem->remove(getIndexFilename(entries[0]).getBuffer());
         writeEntry(entries[1]);
         SLANG_CHECK(readEntry(entries[1]) == true);
 
         // Test different corruptions of the index file.
         testIndexCorruption(
-            [this]() { osFileSystem->remove(getIndexFilename().getBuffer()); },
+            [this]() { osFileSystem->remove(getIndexFilename(entries[0]).getBuffer()); },
             SLANG_E_NOT_FOUND);
 
         testIndexCorruption(
@@ -380,7 +407,7 @@ struct CorruptionTest : public PersistentCacheTest
             {
                 FileStream fs;
                 fs.init(
-                    getIndexFilename(),
+                    getIndexFilename(entries[0]),
                     FileMode::Open,
                     FileAccess::ReadWrite,
                     FileShare::ReadWrite);
@@ -393,7 +420,7 @@ struct CorruptionTest : public PersistentCacheTest
             {
                 FileStream fs;
                 fs.init(
-                    getIndexFilename(),
+                    getIndexFilename(entries[0]),
                     FileMode::Open,
                     FileAccess::ReadWrite,
                     FileShare::ReadWrite);
@@ -408,7 +435,7 @@ struct CorruptionTest : public PersistentCacheTest
             {
                 FileStream fs;
                 fs.init(
-                    getIndexFilename(),
+                    getIndexFilename(entries[0]),
                     FileMode::Open,
                     FileAccess::ReadWrite,
                     FileShare::ReadWrite);
@@ -423,7 +450,7 @@ struct CorruptionTest : public PersistentCacheTest
             {
                 FileStream fs;
                 fs.init(
-                    getIndexFilename(),
+                    getIndexFilename(entries[0]),
                     FileMode::Open,
                     FileAccess::ReadWrite,
                     FileShare::ReadWrite);
@@ -438,7 +465,7 @@ struct CorruptionTest : public PersistentCacheTest
             {
                 FileStream fs;
                 fs.init(
-                    getIndexFilename(),
+                    getIndexFilename(entries[0]),
                     FileMode::Open,
                     FileAccess::ReadWrite,
                     FileShare::ReadWrite);
@@ -449,6 +476,52 @@ struct CorruptionTest : public PersistentCacheTest
     }
 };
 
+// Tests that reads are recorded in the shard journals rather than by rewriting the index,
+// and that other caches using the same directory take the journals into account.
+struct JournalTest : public PersistentCacheTest
+{
+    void run()
+    {
+        List<Entry> entries;
+        for (size_t i = 0; i < 3; ++i)
+        {
+            auto data = createRandomBlob(4096);
+            auto key = SHA1::compute(data->getBufferPointer(), data->getBufferSize());
+            entries.add(Entry{key, data});
+        }
+
+        writeEntry(entries[0]);
+        writeEntry(entries[1]);
+
+        // Reading doesn't write the index, only the journal.
+        const uint32_t generation = getIndexGeneration(entries[0]);
+        for (int i = 0; i < 10; ++i)
+        {
+            SLANG_CHECK(readEntry(entries[0]) == true);
+        }
+        SLANG_CHECK(getIndexGeneration(entries[0]) == generation);
+        SLANG_CHECK(File::exists(getJournalFilename(entries[0])));
+
+        // Another cache evicts the least recently used entry, which is entry 1 as entry 0
+        // has been read since.
+        {
+            RefPtr<PersistentCache> otherCache = createOtherCache(2);
+            SLANG_CHECK(otherCache->getStats().entryCount == 2);
+            SLANG_CHECK(otherCache->writeEntry(entries[2].key, entries[2].data) == SLANG_OK);
+            SLANG_CHECK(otherCache->getStats().entryCount == 2);
+        }
+        SLANG_CHECK(readEntry(entries[0]) == true);
+        SLANG_CHECK(readEntry(entries[1]) == false);
+        SLANG_CHECK(readEntry(entries[2]) == true);
+
+        // Writing to a shard folds its journal into the index.
+        writeEntry(entries[0]);
+        SLANG_CHECK(!File::exists(getJournalFilename(entries[0])));
+        SLANG_CHECK(getIndexGeneration(entries[0]) != generation);
+        SLANG_CHECK(readEntry(entries[0]) == true);
+    }
+};
+
 #undef ENABLE_LOGGING
 #undef ENABLE_WRITE_TEST
 
@@ -631,6 +704,12 @@ SLANG_UNIT_TEST(persistentCacheCorruption)
     test.run();
 }
 
+SLANG_UNIT_TEST(persistentCacheJournal)
+{
+    JournalTest test;
+    test.run();
+}
+
 SLANG_UNIT_TEST(persistentCacheStress)
 {
     // aarch64 builds currently fail to run multi-threaded tests within the test-server.
@@ -0,0 +1,268 @@
+// unit-test-precompiled-spirv-link.cpp
+
+#include "../../source/compiler-core/slang-artifact-associated.h"
+#include "../../source/compiler-core/slang-artifact-util.h"
+#include "../../source/compiler-core/slang-downstream-compiler-set.h"
+#include "../../source/compiler-core/slang-glslang-compiler.h"
+#include "../../source/core/slang-blob.h"
+#include "../../source/core/slang-shared-library.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Test that the SPIR-V of a module precompiled with `precompileForTarget` is linked into the
+// SPIR-V of a program that imports it, and that linking fails when an import can't be resolved.
+
+static const char* kLibrarySource = R"(
+    module lib;
+
+    public int scale(int value)
+    {
+        return value * 3 + 1;
+    }
+    )";
+
+static const char* kProgramSource = R"(
+    import lib;
+
+    RWStructuredBuffer<int> outputBuffer;
+
+    [shader("compute")]
+    [numthreads(64, 1, 1)]
+    void computeMain(uint tid : SV_DispatchThreadID)
+    {
+        outputBuffer[tid] = scale(int(tid));
+    }
+    )";
+
+namespace
+{
+enum : uint32_t
+{
+    kSpvMagicNumber = 0x07230203,
+    kSpvOpDecorate = 71,
+    kSpvDecorationLinkageAttributes = 41,
+    kSpvLinkageTypeImport = 1,
+};
+} // namespace
+
+// Count the functions `spirv` imports through LinkageAttributes decorations, or return -1 if
+// it isn't a valid SPIR-V module.
+static Index _countSPIRVImports(ISlangBlob* spirv)
+{
+    const uint32_t* words = (const uint32_t*)spirv->getBufferPointer();
+    const size_t wordCount = spirv->getBufferSize() / sizeof(uint32_t);
+    if (wordCount < 5 || words[0] != kSpvMagicNumber)
+        return -1;
+
+    Index importCount = 0;
+    for (size_t i = 5; i < wordCount;)
+    {
+        const uint32_t instWordCount = words[i] >> 16;
+        const uint32_t opcode = words[i] & 0xffff;
+        if (instWordCount == 0 || i + instWordCount > wordCount)
+            return -1;
+
+        // OpDecorate <target> LinkageAttributes <name> <linkage type>
+        if (opcode == kSpvOpDecorate && instWordCount >= 4 &&
+            words[i + 2] == kSpvDecorationLinkageAttributes &&
+            words[i + instWordCount - 1] == kSpvLinkageTypeImport)
+        {
+            importCount++;
+        }
+        i += instWordCount;
+    }
+    return importCount;
+}
+
+static ComPtr<slang::ISession> _createSPIRVSession(
+    slang::IGlobalSession* globalSession,
+    bool embedDownstreamIR)
+{
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_SPIRV;
+    targetDesc.profile = globalSession->findProfile("spirv_1_5");
+
+    slang::CompilerOptionEntry compilerOptionEntry = {};
+    compilerOptionEntry.name = slang::CompilerOptionName::EmbedDownstreamIR;
+    compilerOptionEntry.value.kind = slang::CompilerOptionValueKind::Int;
+    compilerOptionEntry.value.intValue0 = 1;
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    if (embedDownstreamIR)
+    {
+        sessionDesc.compilerOptionEntryCount = 1;
+        sessionDesc.compilerOptionEntries = &compilerOptionEntry;
+    }
+    ComPtr<slang::ISession> session;
+    globalSession->createSession(sessionDesc, session.writeRef());
+    return session;
+}
+
+static ComPtr<slang::IModulePrecompileService_Experimental> _loadPrecompiledLibrary(
+    slang::ISession* session)
+{
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module =
+        session->loadModuleFromSourceString("lib", "lib.slang", kLibrarySource, nullptr);
+    if (!module)
+        return nullptr;
+
+    ComPtr<slang::IModulePrecompileService_Experimental> precompileService;
+    if (SLANG_FAILED(module->queryInterface(
+            slang::SLANG_UUID_IModulePrecompileService_Experimental,
+            (void**)precompileService.writeRef())))
+        return nullptr;
+    if (SLANG_FAILED(precompileService->precompileForTarget(
+            SLANG_SPIRV,
+            diagnosticBlob.writeRef())))
+        return nullptr;
+    return precompileService;
+}
+
+static ComPtr<slang::IBlob> _generateProgramCode(slang::ISession* session)
+{
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = session->loadModuleFromSourceString(
+        "program",
+        "program.slang",
+        kProgramSource,
+        diagnosticBlob.writeRef());
+    if (!module)
+        return nullptr;
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    module->findEntryPointByName("computeMain", entryPoint.writeRef());
+    if (!entryPoint)
+        return nullptr;
+
+    ComPtr<slang::IComponentType> compositeProgram;
+    slang::IComponentType* components[] = {module, entryPoint.get()};
+    session->createCompositeComponentType(
+        components,
+        2,
+        compositeProgram.writeRef(),
+        diagnosticBlob.writeRef());
+    if (!compositeProgram)
+        return nullptr;
+
+    ComPtr<slang::IComponentType> linkedProgram;
+    compositeProgram->link(linkedProgram.writeRef(), diagnosticBlob.writeRef());
+    if (!linkedProgram)
+        return nullptr;
+
+    ComPtr<slang::IBlob> code;
+    linkedProgram->getEntryPointCode(0, 0, code.writeRef(), diagnosticBlob.writeRef());
+    return code;
+}
+
+static ComPtr<IArtifact> _link(IDownstreamCompiler* compiler, const List<ISlangBlob*>& modules)
+{
+    List<ComPtr<IArtifact>> artifacts;
+    List<IArtifact*> linkInputs;
+    for (auto module : modules)
+    {
+        auto artifact = ArtifactUtil::createArtifactForCompileTarget(SLANG_SPIRV);
+        artifact->addRepresentationUnknown(module);
+        linkInputs.add(artifact);
+        artifacts.add(artifact);
+    }
+
+    ComPtr<IArtifact> linked;
+    auto inputs = makeSlice(linkInputs.getBuffer(), linkInputs.getCount());
+    if (SLANG_FAILED(compiler->link(inputs, linked.writeRef())))
+        return nullptr;
+    return linked;
+}
+
+SLANG_UNIT_TEST(precompiledSPIRVLink)
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(
+        slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+    // Linking needs spirv-opt, which is part of slang-glslang.
+    if (SLANG_FAILED(globalSession->checkPassThroughSupport(SLANG_PASS_THROUGH_SPIRV_OPT)))
+        SLANG_IGNORE_TEST
+
+    auto session = _createSPIRVSession(globalSession, false);
+    SLANG_CHECK_ABORT(session != nullptr);
+    auto library = _loadPrecompiledLibrary(session);
+    SLANG_CHECK_ABORT(library != nullptr);
+
+    // The precompiled SPIR-V exports `scale`, and imports nothing.
+    ComPtr<slang::IBlob> librarySpirv;
+    SLANG_CHECK_ABORT(
+        library->getPrecompiledTargetCode(SLANG_SPIRV, librarySpirv.writeRef()) == SLANG_OK);
+    SLANG_CHECK(_countSPIRVImports(librarySpirv) == 0);
+
+    // The program's import of `scale` has been resolved against the precompiled definition.
+    auto code = _generateProgramCode(session);
+    SLANG_CHECK_ABORT(code != nullptr);
+    SLANG_CHECK(_countSPIRVImports(code) == 0);
+}
+
+SLANG_UNIT_TEST(precompiledSPIRVLinkDownstream)
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(
+        slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    RefPtr<DownstreamCompilerSet> compilerSet = new DownstreamCompilerSet;
+    SpirvOptDownstreamCompilerUtil::locateCompilers(
+        String(),
+        DefaultSharedLibraryLoader::getSingleton(),
+        compilerSet);
+    List<IDownstreamCompiler*> compilers;
+    compilerSet->getCompilers(compilers);
+    IDownstreamCompiler* compiler = nullptr;
+    for (auto candidate : compilers)
+    {
+        if (candidate->getDesc().type == SLANG_PASS_THROUGH_SPIRV_OPT)
+            compiler = candidate;
+    }
+    if (!compiler)
+        SLANG_IGNORE_TEST
+
+    // While precompiling, the program's import of `scale` is left for the final link.
+    auto session = _createSPIRVSession(globalSession, true);
+    SLANG_CHECK_ABORT(session != nullptr);
+    auto library = _loadPrecompiledLibrary(session);
+    SLANG_CHECK_ABORT(library != nullptr);
+    ComPtr<slang::IBlob> librarySpirv;
+    SLANG_CHECK_ABORT(
+        library->getPrecompiledTargetCode(SLANG_SPIRV, librarySpirv.writeRef()) == SLANG_OK);
+    auto code = _generateProgramCode(session);
+    SLANG_CHECK_ABORT(code != nullptr);
+    SLANG_CHECK(_countSPIRVImports(code) > 0);
+
+    // Linked with the precompiled module, the import is resolved.
+    {
+        List<ISlangBlob*> modules;
+        modules.add(code);
+        modules.add(librarySpirv);
+        auto linked = _link(compiler, modules);
+        SLANG_CHECK_ABORT(linked != nullptr);
+        ComPtr<ISlangBlob> blob;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(linked->loadBlob(ArtifactKeep::No, blob.writeRef())));
+        SLANG_CHECK(_countSPIRVImports(blob) == 0);
+    }
+
+    // Linked on its own, the import can't be resolved, which fails with an error and no code.
+    {
+        List<ISlangBlob*> modules;
+        modules.add(code);
+        auto linked = _link(compiler, modules);
+        SLANG_CHECK_ABORT(linked != nullptr);
+        auto diagnostics = findAssociatedRepresentation<IArtifactDiagnostics>(linked);
+        SLANG_CHECK_ABORT(diagnostics != nullptr);
+        SLANG_CHECK(SLANG_FAILED(diagnostics->getResult()));
+        SLANG_CHECK(
+            diagnostics->getCountAtLeastSeverity(ArtifactDiagnostic::Severity::Error) > 0);
+        ComPtr<ISlangBlob> blob;
+        SLANG_CHECK(SLANG_FAILED(linked->loadBlob(ArtifactKeep::No, blob.writeRef())));
+    }
+}
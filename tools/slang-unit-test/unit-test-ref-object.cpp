@@ -0,0 +1,59 @@
+// unit-test-ref-object.cpp
+
+#include "core/slang-basic.h"
+#include "core/slang-com-object.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <thread>
+#include <vector>
+
+using namespace Slang;
+
+namespace
+{
+class ThreadSafeObject : public ComObject
+{
+public:
+    static std::atomic<int> s_destroyedCount;
+    ~ThreadSafeObject() { s_destroyedCount++; }
+};
+std::atomic<int> ThreadSafeObject::s_destroyedCount = {0};
+} // namespace
+
+SLANG_UNIT_TEST(refObject)
+{
+    {
+        RefPtr<RefObject> object = new RefObject();
+        SLANG_CHECK(object->isUniquelyReferenced());
+        RefPtr<RefObject> copy = object;
+        SLANG_CHECK(object->debugGetReferenceCount() == 2);
+        copy = nullptr;
+        SLANG_CHECK(object->isUniquelyReferenced());
+    }
+
+    // The reference counts of COM objects can be changed from several threads at once.
+    {
+        RefPtr<ThreadSafeObject> object = new ThreadSafeObject();
+        SLANG_CHECK(object->isUniquelyReferenced());
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; t++)
+        {
+            threads.emplace_back(
+                [&]()
+                {
+                    for (int i = 0; i < 10000; i++)
+                    {
+                        RefPtr<ThreadSafeObject> copy = object;
+                    }
+                });
+        }
+        for (auto& thread : threads)
+            thread.join();
+
+        SLANG_CHECK(object->isUniquelyReferenced());
+        SLANG_CHECK(ThreadSafeObject::s_destroyedCount == 0);
+        object = nullptr;
+        SLANG_CHECK(ThreadSafeObject::s_destroyedCount == 1);
+    }
+}
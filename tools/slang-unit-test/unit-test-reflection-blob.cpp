@@ -0,0 +1,137 @@
+// unit-test-reflection-blob.cpp
+
+#include "slang-com-ptr.h"
+#include "slang-reflection-blob.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <string.h>
+
+using namespace Slang;
+
+// Test that the binary reflection blob holds the bindings reported by the reflection API.
+
+static const SlangReflectionBlobVar* _findVar(
+    const void* blob,
+    SlangReflectionBlobArray vars,
+    const char* name)
+{
+    auto items = (const SlangReflectionBlobVar*)
+        slangReflectionBlobGetItems(blob, vars, sizeof(SlangReflectionBlobVar));
+    for (uint32_t i = 0; items && i < vars.count; i++)
+    {
+        auto varName = (const char*)slangReflectionBlobGetItems(blob, items[i].name, 1);
+        if (varName && strcmp(varName, name) == 0)
+            return &items[i];
+    }
+    return nullptr;
+}
+
+SLANG_UNIT_TEST(reflectionBlob)
+{
+    const char* userSourceBody = R"(
+        struct Params
+        {
+            float4 color;
+            float scale;
+        };
+        ConstantBuffer<Params> gParams : register(b1);
+        Texture2D gTextures[4] : register(t2, space1);
+
+        [shader("compute")]
+        [numthreads(8, 4, 1)]
+        void computeMain(uint3 tid : SV_DispatchThreadID, uniform float offset)
+        {
+        }
+        )";
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK(globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = session->loadModuleFromSourceString(
+        "m",
+        "m.slang",
+        userSourceBody,
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(module != nullptr);
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    module->findEntryPointByName("computeMain", entryPoint.writeRef());
+    SLANG_CHECK_ABORT(entryPoint != nullptr);
+
+    ComPtr<slang::IComponentType> compositeProgram;
+    slang::IComponentType* components[] = {module, entryPoint.get()};
+    session->createCompositeComponentType(
+        components,
+        2,
+        compositeProgram.writeRef(),
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(compositeProgram != nullptr);
+
+    ComPtr<slang::IComponentType> linkedProgram;
+    compositeProgram->link(linkedProgram.writeRef(), nullptr);
+    SLANG_CHECK_ABORT(linkedProgram != nullptr);
+
+    auto reflection = linkedProgram->getLayout();
+    ComPtr<ISlangBlob> reflectionBlob;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(reflection->toBinary(reflectionBlob.writeRef())));
+
+    const void* blob = reflectionBlob->getBufferPointer();
+    auto program = slangReflectionBlobGetProgram(blob, reflectionBlob->getBufferSize());
+    SLANG_CHECK_ABORT(program != nullptr);
+    SLANG_CHECK(program->parameters.count == 2);
+
+    auto params = _findVar(blob, program->parameters, "gParams");
+    SLANG_CHECK_ABORT(params != nullptr);
+    SLANG_CHECK(params->typeKind == uint32_t(slang::TypeReflection::Kind::ConstantBuffer));
+    SLANG_CHECK(params->fields.count == 2);
+    auto paramsBinding = (const SlangReflectionBlobBinding*)
+        slangReflectionBlobGetItems(blob, params->bindings, sizeof(SlangReflectionBlobBinding));
+    SLANG_CHECK_ABORT(paramsBinding != nullptr);
+    SLANG_CHECK(paramsBinding->category == SLANG_PARAMETER_CATEGORY_CONSTANT_BUFFER);
+    SLANG_CHECK(paramsBinding->index == 1);
+
+    auto scale = _findVar(blob, params->fields, "scale");
+    SLANG_CHECK_ABORT(scale != nullptr);
+    auto scaleBinding = (const SlangReflectionBlobBinding*)
+        slangReflectionBlobGetItems(blob, scale->bindings, sizeof(SlangReflectionBlobBinding));
+    SLANG_CHECK_ABORT(scaleBinding != nullptr);
+    SLANG_CHECK(scaleBinding->category == SLANG_PARAMETER_CATEGORY_UNIFORM);
+    SLANG_CHECK(scaleBinding->index == 16);
+    SLANG_CHECK(scaleBinding->size == 4);
+
+    auto textures = _findVar(blob, program->parameters, "gTextures");
+    SLANG_CHECK_ABORT(textures != nullptr);
+    SLANG_CHECK(textures->elementCount == 4);
+    auto texturesBinding = (const SlangReflectionBlobBinding*)
+        slangReflectionBlobGetItems(blob, textures->bindings, sizeof(SlangReflectionBlobBinding));
+    SLANG_CHECK_ABORT(texturesBinding != nullptr);
+    SLANG_CHECK(texturesBinding->category == SLANG_PARAMETER_CATEGORY_SHADER_RESOURCE);
+    SLANG_CHECK(texturesBinding->index == 2);
+    SLANG_CHECK(texturesBinding->space == 1);
+    SLANG_CHECK(texturesBinding->size == 4);
+
+    SLANG_CHECK_ABORT(program->entryPoints.count == 1);
+    auto blobEntryPoint = (const SlangReflectionBlobEntryPoint*)slangReflectionBlobGetItems(
+        blob,
+        program->entryPoints,
+        sizeof(SlangReflectionBlobEntryPoint));
+    SLANG_CHECK_ABORT(blobEntryPoint != nullptr);
+    SLANG_CHECK(blobEntryPoint->stage == SLANG_STAGE_COMPUTE);
+    SLANG_CHECK(blobEntryPoint->threadGroupSize[0] == 8);
+    SLANG_CHECK(blobEntryPoint->threadGroupSize[1] == 4);
+    SLANG_CHECK(blobEntryPoint->threadGroupSize[2] == 1);
+    SLANG_CHECK(_findVar(blob, blobEntryPoint->parameters, "offset") != nullptr);
+
+    // A truncated blob is rejected.
+    SLANG_CHECK(slangReflectionBlobGetProgram(blob, sizeof(SlangReflectionBlobHeader)) == nullptr);
+}
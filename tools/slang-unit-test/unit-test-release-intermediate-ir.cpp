@@ -0,0 +1,114 @@
+// unit-test-release-intermediate-ir.cpp
+
+#include "../../source/core/slang-string-util.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Test that code and reflection are still available after the IR of a target is released by
+// `ReleaseIntermediateIR`, and that the IR is created again when more code is generated.
+
+SLANG_UNIT_TEST(releaseIntermediateIR)
+{
+    const char* userSourceBody = R"(
+        RWStructuredBuffer<float> outputBuffer;
+
+        [shader("compute")]
+        [numthreads(64, 1, 1)]
+        void computeA(uint tid : SV_DispatchThreadID)
+        {
+            outputBuffer[tid] = tid * 2.0;
+        }
+
+        [shader("compute")]
+        [numthreads(64, 1, 1)]
+        void computeB(uint tid : SV_DispatchThreadID)
+        {
+            outputBuffer[tid] = tid + 3.0;
+        }
+        )";
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::CompilerOptionEntry compilerOptionEntry = {};
+    compilerOptionEntry.name = slang::CompilerOptionName::ReleaseIntermediateIR;
+    compilerOptionEntry.value.kind = slang::CompilerOptionValueKind::Int;
+    compilerOptionEntry.value.intValue0 = 1;
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.compilerOptionEntryCount = 1;
+    sessionDesc.compilerOptionEntries = &compilerOptionEntry;
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK(globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = session->loadModuleFromSourceString(
+        "m",
+        "m.slang",
+        userSourceBody,
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(module != nullptr);
+
+    ComPtr<slang::IEntryPoint> entryPointA;
+    module->findEntryPointByName("computeA", entryPointA.writeRef());
+    ComPtr<slang::IEntryPoint> entryPointB;
+    module->findEntryPointByName("computeB", entryPointB.writeRef());
+    SLANG_CHECK_ABORT(entryPointA != nullptr && entryPointB != nullptr);
+
+    ComPtr<slang::IComponentType> compositeProgram;
+    slang::IComponentType* components[] = {module, entryPointA.get(), entryPointB.get()};
+    session->createCompositeComponentType(
+        components,
+        3,
+        compositeProgram.writeRef(),
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(compositeProgram != nullptr);
+
+    ComPtr<slang::IComponentType> linkedProgram;
+    compositeProgram->link(linkedProgram.writeRef(), nullptr);
+    SLANG_CHECK_ABORT(linkedProgram != nullptr);
+
+    // The IR is released once the code of both entry points has been generated.
+    ComPtr<slang::IBlob> codeA;
+    ComPtr<slang::IBlob> codeB;
+    SLANG_CHECK(
+        linkedProgram->getEntryPointCode(0, 0, codeA.writeRef(), diagnosticBlob.writeRef()) ==
+        SLANG_OK);
+    SLANG_CHECK(
+        linkedProgram->getEntryPointCode(1, 0, codeB.writeRef(), diagnosticBlob.writeRef()) ==
+        SLANG_OK);
+    SLANG_CHECK_ABORT(codeA != nullptr && codeB != nullptr);
+    SLANG_CHECK(StringUtil::getSlice(codeA).indexOf(UnownedStringSlice("computeA")) >= 0);
+    SLANG_CHECK(StringUtil::getSlice(codeB).indexOf(UnownedStringSlice("computeB")) >= 0);
+
+    // The code that was generated is kept.
+    ComPtr<slang::IBlob> codeAAgain;
+    SLANG_CHECK(
+        linkedProgram->getEntryPointCode(0, 0, codeAAgain.writeRef(), diagnosticBlob.writeRef()) ==
+        SLANG_OK);
+    SLANG_CHECK(codeAAgain.get() == codeA.get());
+
+    // The reflection is kept.
+    auto layout = linkedProgram->getLayout(0);
+    SLANG_CHECK_ABORT(layout != nullptr);
+    SLANG_CHECK(layout->getEntryPointCount() == 2);
+    SLANG_CHECK(layout->getParameterCount() == 1);
+
+    // Generating more code creates the IR again.
+    ComPtr<slang::IBlob> targetCode;
+    SLANG_CHECK(
+        linkedProgram->getTargetCode(0, targetCode.writeRef(), diagnosticBlob.writeRef()) ==
+        SLANG_OK);
+    SLANG_CHECK_ABORT(targetCode != nullptr);
+    auto targetCodeText = StringUtil::getSlice(targetCode);
+    SLANG_CHECK(targetCodeText.indexOf(UnownedStringSlice("computeA")) >= 0);
+    SLANG_CHECK(targetCodeText.indexOf(UnownedStringSlice("computeB")) >= 0);
+}
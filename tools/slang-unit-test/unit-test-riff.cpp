@@ -110,6 +110,42 @@ SLANG_UNIT_TEST(riff)
                 // They should be the same
                 SLANG_CHECK(readBuilder == builder);
             }
+
+            // Reading in place gives the same contents, referencing the aligned payloads
+            {
+                OwnedMemoryStream stream(FileAccess::ReadWrite);
+                SLANG_CHECK(SLANG_SUCCEEDED(RiffUtil::write(container.getRoot(), true, &stream)));
+
+                // Place the contents so the first payload, which follows the 12 byte riff header
+                // and 8 byte data chunk header, is 8 byte aligned
+                const auto contents = stream.getContents();
+                List<uint64_t> alignedContents;
+                alignedContents.setCount((contents.getCount() + 4 + 7) / 8);
+                uint8_t* begin = (uint8_t*)alignedContents.getBuffer() + 4;
+                ::memcpy(begin, contents.getBuffer(), contents.getCount());
+                const uint8_t* end = begin + contents.getCount();
+
+                RiffContainer readContainer;
+                SLANG_CHECK(SLANG_SUCCEEDED(
+                    RiffUtil::readInPlace(begin, contents.getCount(), readContainer)));
+
+                StringBuilder readBuilder;
+                {
+                    StringWriter writer(&readBuilder, 0);
+                    RiffUtil::dump(readContainer.getRoot(), &writer);
+                }
+                SLANG_CHECK(readBuilder == builder);
+
+                auto dataChunk = as<RiffContainer::DataChunk>(
+                    readContainer.getRoot()->getFirstContainedChunk());
+                SLANG_CHECK(dataChunk);
+                if (dataChunk)
+                {
+                    auto data = dataChunk->getSingleData();
+                    SLANG_CHECK(data && data->getOwnership() == RiffContainer::Ownership::NotOwned);
+                    SLANG_CHECK(data && data->getPayload() >= begin && data->getPayload() < end);
+                }
+            }
         }
     }
 
@@ -0,0 +1,82 @@
+// unit-test-shader-cost.cpp
+
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Test that the getShaderCost API reports the static cost of the entry points in the compiled
+// code.
+
+SLANG_UNIT_TEST(shaderCost)
+{
+    const char* userSourceBody = R"(
+        RWStructuredBuffer<float4> inputBuffer;
+        RWStructuredBuffer<float4> outputBuffer;
+        groupshared float4 cache[64];
+
+        [shader("compute")]
+        [numthreads(64, 1, 1)]
+        void computeMain(uint tid : SV_GroupIndex)
+        {
+            cache[tid] = inputBuffer[tid] * 2.0 + 1.0;
+            GroupMemoryBarrierWithGroupSync();
+            outputBuffer[tid] = cache[63 - tid];
+        }
+        )";
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK(globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = session->loadModuleFromSourceString(
+        "m",
+        "m.slang",
+        userSourceBody,
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(module != nullptr);
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    module->findEntryPointByName("computeMain", entryPoint.writeRef());
+    SLANG_CHECK_ABORT(entryPoint != nullptr);
+
+    ComPtr<slang::IComponentType> compositeProgram;
+    slang::IComponentType* components[] = {module, entryPoint.get()};
+    session->createCompositeComponentType(
+        components,
+        2,
+        compositeProgram.writeRef(),
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(compositeProgram != nullptr);
+
+    ComPtr<slang::IComponentType> linkedProgram;
+    compositeProgram->link(linkedProgram.writeRef(), nullptr);
+    SLANG_CHECK_ABORT(linkedProgram != nullptr);
+
+    ComPtr<slang::IMetadata> metadata;
+    linkedProgram->getTargetMetadata(0, metadata.writeRef(), nullptr);
+    SLANG_CHECK_ABORT(metadata != nullptr);
+
+    slang::ShaderCost cost;
+    SLANG_CHECK(metadata->getShaderCost("computeMain", cost) == SLANG_OK);
+    SLANG_CHECK(cost.aluOpCount >= 2);
+    SLANG_CHECK(cost.textureSampleCount == 0);
+    SLANG_CHECK(cost.bufferLoadCount == 1 && cost.bufferLoadBytes == 16);
+    SLANG_CHECK(cost.bufferStoreCount == 1 && cost.bufferStoreBytes == 16);
+    SLANG_CHECK(cost.groupSharedBytes == 64 * 16);
+    SLANG_CHECK(cost.barrierCount == 1);
+    SLANG_CHECK(cost.localArrayCount == 0);
+    SLANG_CHECK(cost.estimatedLiveValueCount != 0);
+
+    SLANG_CHECK(metadata->getShaderCost("missing", cost) == SLANG_E_NOT_FOUND);
+}
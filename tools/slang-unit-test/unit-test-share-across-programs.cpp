@@ -0,0 +1,158 @@
+// unit-test-share-across-programs.cpp
+
+#include "../../source/core/slang-basic.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Compile each of the entry points of `source` as a program of its own, in one session with
+// the bool option `option` set to `enable`, and return the code generated for them.
+static List<String> _compileEntryPoints(
+    slang::IGlobalSession* globalSession,
+    const char* source,
+    slang::CompilerOptionName option,
+    bool enable)
+{
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::CompilerOptionEntry compilerOptionEntry = {};
+    compilerOptionEntry.name = option;
+    compilerOptionEntry.value.kind = slang::CompilerOptionValueKind::Int;
+    compilerOptionEntry.value.intValue0 = enable ? 1 : 0;
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.compilerOptionEntryCount = 1;
+    sessionDesc.compilerOptionEntries = &compilerOptionEntry;
+
+    List<String> result;
+    ComPtr<slang::ISession> session;
+    if (SLANG_FAILED(globalSession->createSession(sessionDesc, session.writeRef())))
+        return result;
+
+    ComPtr<slang::IBlob> diagnostics;
+    auto module =
+        session->loadModuleFromSourceString("m", "m.slang", source, diagnostics.writeRef());
+    if (!module)
+        return result;
+
+    for (SlangInt32 i = 0; i < module->getDefinedEntryPointCount(); i++)
+    {
+        ComPtr<slang::IEntryPoint> entryPoint;
+        module->getDefinedEntryPoint(i, entryPoint.writeRef());
+        if (!entryPoint)
+            return List<String>();
+
+        slang::IComponentType* components[] = {module, entryPoint.get()};
+        ComPtr<slang::IComponentType> program;
+        session->createCompositeComponentType(
+            components,
+            2,
+            program.writeRef(),
+            diagnostics.writeRef());
+        if (!program)
+            return List<String>();
+
+        ComPtr<slang::IComponentType> linkedProgram;
+        program->link(linkedProgram.writeRef(), diagnostics.writeRef());
+        if (!linkedProgram)
+            return List<String>();
+
+        ComPtr<slang::IBlob> code;
+        if (SLANG_FAILED(
+                linkedProgram->getEntryPointCode(0, 0, code.writeRef(), diagnostics.writeRef())))
+            return List<String>();
+        result.add(String(
+            UnownedStringSlice((const char*)code->getBufferPointer(), code->getBufferSize())));
+    }
+    return result;
+}
+
+// Test that reusing the specializations of generic functions made for another program with
+// `ShareGenericSpecializations` generates the same code as specializing them again.
+//
+SLANG_UNIT_TEST(shareGenericSpecializations)
+{
+    const char* userSource = R"(
+        interface IMaterial { float4 eval(float x); }
+        struct Red : IMaterial { float4 eval(float x) { return float4(x, 0, 0, 1); } }
+        struct Blue : IMaterial { float4 eval(float x) { return float4(0, 0, x, 1); } }
+
+        float4 shade<M : IMaterial>(M m, float x)
+        {
+            float4 s = 0;
+            for (int i = 0; i < 4; i++)
+                s += m.eval(x * i);
+            return s;
+        }
+
+        RWStructuredBuffer<float4> outputBuffer;
+
+        [shader("compute")]
+        [numthreads(1, 1, 1)]
+        void computeRed(uint3 tid : SV_DispatchThreadID)
+        {
+            Red red;
+            outputBuffer[tid.x] = shade(red, tid.x);
+        }
+
+        [shader("compute")]
+        [numthreads(1, 1, 1)]
+        void computeBoth(uint3 tid : SV_DispatchThreadID)
+        {
+            Red red;
+            Blue blue;
+            outputBuffer[tid.x] = shade(red, tid.x) + shade(blue, tid.y);
+        }
+        )";
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    const auto option = slang::CompilerOptionName::ShareGenericSpecializations;
+    const List<String> code = _compileEntryPoints(globalSession, userSource, option, false);
+    SLANG_CHECK_ABORT(code.getCount() == 2);
+    SLANG_CHECK(_compileEntryPoints(globalSession, userSource, option, true) == code);
+}
+
+// Test that reusing the forward derivatives made for another program with
+// `ShareForwardDerivatives` generates the same code as transcribing them again.
+//
+SLANG_UNIT_TEST(shareForwardDerivatives)
+{
+    const char* userSource = R"(
+        [ForwardDifferentiable]
+        float softplus(float x) { return log(1 + exp(x)); }
+
+        RWStructuredBuffer<float> outputBuffer;
+
+        [shader("compute")]
+        [numthreads(1, 1, 1)]
+        void computeOne(uint3 tid : SV_DispatchThreadID)
+        {
+            let r = fwd_diff(softplus)(diffPair(outputBuffer[0], 1.0));
+            outputBuffer[tid.x] = r.d;
+        }
+
+        [shader("compute")]
+        [numthreads(1, 1, 1)]
+        void computeTwo(uint3 tid : SV_DispatchThreadID)
+        {
+            let r = fwd_diff(softplus)(diffPair(outputBuffer[1], 2.0));
+            outputBuffer[tid.x] = r.p + r.d;
+        }
+        )";
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    const auto option = slang::CompilerOptionName::ShareForwardDerivatives;
+    const List<String> code = _compileEntryPoints(globalSession, userSource, option, false);
+    SLANG_CHECK_ABORT(code.getCount() == 2);
+    SLANG_CHECK(_compileEntryPoints(globalSession, userSource, option, true) == code);
+}
@@ -0,0 +1,75 @@
+// unit-test-shared-core-module.cpp
+
+#include "../../source/core/slang-basic.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+static String _compile(slang::IGlobalSession* globalSession, const char* source)
+{
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+
+    ComPtr<slang::ISession> session;
+    if (SLANG_FAILED(globalSession->createSession(sessionDesc, session.writeRef())))
+        return String();
+
+    ComPtr<slang::IBlob> diagnostics;
+    auto module =
+        session->loadModuleFromSourceString("m", "m.slang", source, diagnostics.writeRef());
+    if (!module)
+        return String();
+
+    ComPtr<slang::IComponentType> linkedProgram;
+    module->link(linkedProgram.writeRef(), diagnostics.writeRef());
+    if (!linkedProgram)
+        return String();
+
+    ComPtr<slang::IBlob> code;
+    if (SLANG_FAILED(
+            linkedProgram->getEntryPointCode(0, 0, code.writeRef(), diagnostics.writeRef())))
+        return String();
+    return String(UnownedStringSlice((const char*)code->getBufferPointer(), code->getBufferSize()));
+}
+
+// Test that global sessions loading the same core module, which share its IR, generate
+// the same code, including once the session that first read the IR has been released.
+//
+SLANG_UNIT_TEST(sharedCoreModule)
+{
+    const char* userSource = R"(
+        [shader("compute")]
+        [numthreads(1, 1, 1)]
+        void computeMain(uint3 tid : SV_DispatchThreadID, uniform RWStructuredBuffer<float> b)
+        {
+            b[tid.x] = sin(float(tid.x)) + length(float3(tid));
+        }
+        )";
+
+    ComPtr<slang::IGlobalSession> firstGlobalSession;
+    SLANG_CHECK(
+        slang_createGlobalSession(SLANG_API_VERSION, firstGlobalSession.writeRef()) == SLANG_OK);
+    ComPtr<slang::IGlobalSession> secondGlobalSession;
+    SLANG_CHECK(
+        slang_createGlobalSession(SLANG_API_VERSION, secondGlobalSession.writeRef()) == SLANG_OK);
+
+    const String firstCode = _compile(firstGlobalSession, userSource);
+    SLANG_CHECK(firstCode.getLength() != 0);
+
+    firstGlobalSession.setNull();
+
+    const String secondCode = _compile(secondGlobalSession, userSource);
+    SLANG_CHECK(secondCode == firstCode);
+
+    // A session created after the IR was read uses it too.
+    ComPtr<slang::IGlobalSession> thirdGlobalSession;
+    SLANG_CHECK(
+        slang_createGlobalSession(SLANG_API_VERSION, thirdGlobalSession.writeRef()) == SLANG_OK);
+    SLANG_CHECK(_compile(thirdGlobalSession, userSource) == firstCode);
+}
@@ -0,0 +1,54 @@
+// unit-test-source-loc.cpp
+
+#include "../../source/compiler-core/slang-source-loc.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+SLANG_UNIT_TEST(sourceLocHumaneLocs)
+{
+    SourceManager sourceManager;
+    sourceManager.initialize(nullptr, nullptr);
+
+    const String contents[] = {"int a;\nint b;\n\nint c;\n", "float x;\r\nfloat y;\n"};
+    SourceView* views[2];
+    for (Index i = 0; i < 2; ++i)
+    {
+        StringBuilder path;
+        path << "file" << i << ".slang";
+        auto sourceFile =
+            sourceManager.createSourceFileWithString(PathInfo::makePath(path), contents[i]);
+        views[i] = sourceManager.createSourceView(sourceFile, nullptr, SourceLoc());
+    }
+
+    SLANG_CHECK(sourceManager.findSourceFileByPath("file1.slang") == views[1]->getSourceFile());
+    SLANG_CHECK(sourceManager.findSourceFileByPath("file2.slang") == nullptr);
+
+    // Interleave the locations of both views, out of order, with one that isn't in either.
+    List<SourceLoc> locs;
+    for (Index offset = Index(contents[0].getLength()); offset >= 0; offset -= 3)
+    {
+        locs.add(views[1]->getRange().begin + Math::Min(offset, contents[1].getLength()));
+        locs.add(views[0]->getRange().begin + offset);
+    }
+    locs.add(SourceLoc());
+
+    List<HumaneSourceLoc> humaneLocs;
+    humaneLocs.setCount(locs.getCount());
+    sourceManager.getHumaneLocs(
+        locs.getArrayView(),
+        SourceLocType::Nominal,
+        humaneLocs.getArrayView());
+
+    for (Index i = 0; i < locs.getCount(); ++i)
+    {
+        const auto expected = sourceManager.getHumaneLoc(locs[i], SourceLocType::Nominal);
+        SLANG_CHECK(humaneLocs[i].line == expected.line);
+        SLANG_CHECK(humaneLocs[i].column == expected.column);
+        SLANG_CHECK(humaneLocs[i].pathInfo.foundPath == expected.pathInfo.foundPath);
+    }
+
+    // The start of `int c;` is on the fourth line.
+    const auto loc = sourceManager.getHumaneLoc(views[0]->getRange().begin + 15);
+    SLANG_CHECK(loc.line == 4 && loc.column == 1);
+}
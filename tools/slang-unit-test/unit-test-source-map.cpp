@@ -115,6 +115,39 @@ static SlangResult _check()
         }
     }
 
+    // A streamed map should encode to the same mappings, and decode back to the same entries
+    {
+        SourceMap streamed;
+        SLANG_RETURN_ON_FAIL(streamed.setStreamed(true));
+
+        const Count linesCount = sourceMap.getGeneratedLineCount();
+        for (Index i = 0; i < linesCount; ++i)
+        {
+            streamed.advanceToLine(i);
+            for (const auto& entry : sourceMap.getEntriesForLine(i))
+            {
+                streamed.addEntry(entry);
+            }
+        }
+
+        StringBuilder expected, actual;
+        sourceMap.appendMappings(expected);
+        streamed.appendMappings(actual);
+        if (expected != actual)
+        {
+            return SLANG_FAIL;
+        }
+
+        SLANG_RETURN_ON_FAIL(streamed.setStreamed(false));
+        for (Index i = 0; i < linesCount; ++i)
+        {
+            if (streamed.getEntriesForLine(i) != sourceMap.getEntriesForLine(i))
+            {
+                return SLANG_FAIL;
+            }
+        }
+    }
+
     return SLANG_OK;
 }
 
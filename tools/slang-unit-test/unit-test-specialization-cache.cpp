@@ -0,0 +1,155 @@
+// unit-test-specialization-cache.cpp
+
+#include "../../source/core/slang-basic.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Test that specializing a component type with the same arguments again returns the same
+// specialized component type.
+
+SLANG_UNIT_TEST(specializationCache)
+{
+    const char* userSourceBody = R"(
+        interface IMaterial { float4 eval(); }
+        struct Red : IMaterial { float4 eval() { return float4(1, 0, 0, 1); } }
+        struct Blue : IMaterial { float4 eval() { return float4(0, 0, 1, 1); } }
+
+        RWStructuredBuffer<float4> outputBuffer;
+
+        [shader("compute")]
+        [numthreads(1, 1, 1)]
+        void computeMain<M : IMaterial>()
+        {
+            M m;
+            outputBuffer[0] = m.eval();
+        }
+        )";
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK(globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = session->loadModuleFromSourceString(
+        "m",
+        "m.slang",
+        userSourceBody,
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(module != nullptr);
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    module->findEntryPointByName("computeMain", entryPoint.writeRef());
+    SLANG_CHECK_ABORT(entryPoint != nullptr);
+
+    auto redType = module->getLayout()->findTypeByName("Red");
+    auto blueType = module->getLayout()->findTypeByName("Blue");
+    SLANG_CHECK_ABORT(redType != nullptr && blueType != nullptr);
+
+    auto specialize = [&](slang::TypeReflection* type)
+    {
+        auto arg = slang::SpecializationArg::fromType(type);
+        ComPtr<slang::IComponentType> specialized;
+        entryPoint->specialize(&arg, 1, specialized.writeRef(), diagnosticBlob.writeRef());
+        return specialized;
+    };
+
+    auto red = specialize(redType);
+    SLANG_CHECK_ABORT(red != nullptr);
+    SLANG_CHECK(specialize(redType).get() == red.get());
+
+    auto blue = specialize(blueType);
+    SLANG_CHECK_ABORT(blue != nullptr);
+    SLANG_CHECK(blue.get() != red.get());
+
+    // The reused specialization can still be linked and compiled.
+    ComPtr<slang::IComponentType> linkedProgram;
+    specialize(redType)->link(linkedProgram.writeRef(), diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(linkedProgram != nullptr);
+    ComPtr<slang::IBlob> code;
+    SLANG_CHECK(
+        linkedProgram->getEntryPointCode(0, 0, code.writeRef(), diagnosticBlob.writeRef()) ==
+        SLANG_OK);
+}
+
+// Test that the cache only keeps the most recently used specializations, so that a session
+// which creates many of them doesn't hold on to all of them.
+
+SLANG_UNIT_TEST(specializationCacheEviction)
+{
+    // More material types than the cache holds specializations.
+    const int materialCount = 300;
+    StringBuilder source;
+    source << "interface IMaterial { float4 eval(); }\n";
+    for (int i = 0; i < materialCount; ++i)
+        source << "struct M" << i << " : IMaterial { float4 eval() { return float4(" << i
+               << "); } }\n";
+    source << R"(
+        RWStructuredBuffer<float4> outputBuffer;
+
+        [shader("compute")]
+        [numthreads(1, 1, 1)]
+        void computeMain<M : IMaterial>()
+        {
+            M m;
+            outputBuffer[0] = m.eval();
+        }
+        )";
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK(globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = session->loadModuleFromSourceString(
+        "m",
+        "m.slang",
+        source.getBuffer(),
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(module != nullptr);
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    module->findEntryPointByName("computeMain", entryPoint.writeRef());
+    SLANG_CHECK_ABORT(entryPoint != nullptr);
+
+    auto specialize = [&](int materialIndex)
+    {
+        String name = String("M") + String(materialIndex);
+        auto type = module->getLayout()->findTypeByName(name.getBuffer());
+        auto arg = slang::SpecializationArg::fromType(type);
+        ComPtr<slang::IComponentType> specialized;
+        entryPoint->specialize(&arg, 1, specialized.writeRef(), diagnosticBlob.writeRef());
+        return specialized;
+    };
+
+    auto first = specialize(0);
+    SLANG_CHECK_ABORT(first != nullptr);
+    auto second = specialize(1);
+    SLANG_CHECK_ABORT(second != nullptr);
+
+    // Using a specialization keeps it in the cache, while one that isn't used is dropped once
+    // the cache is full.
+    for (int i = 2; i < materialCount; ++i)
+    {
+        SLANG_CHECK_ABORT(specialize(i) != nullptr);
+        SLANG_CHECK(specialize(0).get() == first.get());
+    }
+    SLANG_CHECK(specialize(0).get() == first.get());
+    SLANG_CHECK(specialize(1).get() != second.get());
+}
@@ -1,5 +1,6 @@
 // unit-test-path.cpp
 
+#include "../../source/core/slang-dictionary.h"
 #include "../../source/core/slang-string-util.h"
 #include "unit-test/slang-unit-test.h"
 
@@ -296,4 +297,21 @@ SLANG_UNIT_TEST(string)
             SLANG_CHECK(value == parsedValue);
         }
     }
+
+    {
+        // Strings held with their hash codes hash and compare the same as the strings
+        const UnownedStringSlice mangledName = toSlice("_S4main11computeMainp1pi_v");
+        const HashedStringSlice hashedSlice(mangledName);
+        const HashedString hashedString = String(mangledName);
+        SLANG_CHECK(hashedSlice.getHashCode() == getHashCode(mangledName));
+        SLANG_CHECK(hashedString.getHashCode() == getHashCode(mangledName));
+        SLANG_CHECK(hashedSlice == HashedStringSlice(mangledName.head(mangledName.getLength())));
+        SLANG_CHECK(hashedSlice != HashedStringSlice(toSlice("_S4main")));
+        SLANG_CHECK(hashedString == HashedString(mangledName));
+
+        Dictionary<HashedString, Index> map;
+        map.add(hashedString, 1);
+        SLANG_CHECK(map.containsKey(HashedString(mangledName)));
+        SLANG_CHECK(!map.containsKey(HashedString(toSlice("_S4main"))));
+    }
 }
@@ -0,0 +1,124 @@
+// unit-test-thread-safe-session.cpp
+
+#include "../../source/core/slang-basic.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace Slang;
+
+// Test that a session created with `kSessionFlags_ThreadSafe` can load modules and
+// generate code for different component types from several threads at once.
+//
+SLANG_UNIT_TEST(threadSafeSession)
+{
+    const char* sharedSource = R"(
+        float4 shade(float4 v) { return v * 2.0; }
+        )";
+
+    const char* userSource = R"(
+        import shared;
+        [shader("compute")]
+        [numthreads(1, 1, 1)]
+        void computeMain(uint3 tid : SV_DispatchThreadID, uniform RWStructuredBuffer<float4> b)
+        {
+            b[tid.x] = shade(float4(float(tid.x)));
+        }
+        )";
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.flags = slang::kSessionFlags_ThreadSafe;
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK(globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+    ComPtr<slang::IBlob> diagnostics;
+    SLANG_CHECK(
+        session->loadModuleFromSourceString(
+            "shared",
+            "shared.slang",
+            sharedSource,
+            diagnostics.writeRef()) != nullptr);
+
+    const int threadCount = 4;
+    std::atomic<int> failureCount(0);
+    List<String> codes;
+    codes.setCount(threadCount);
+
+    auto worker = [&](int threadIndex)
+    {
+        // Each thread loads its own module (which imports the shared one) and links and
+        // generates code for it, so the component types involved are all distinct.
+        StringBuilder moduleName;
+        moduleName << "user" << threadIndex;
+
+        ComPtr<slang::IBlob> threadDiagnostics;
+        ComPtr<slang::IModule> module(session->loadModuleFromSourceString(
+            moduleName.getBuffer(),
+            (moduleName + ".slang").getBuffer(),
+            userSource,
+            threadDiagnostics.writeRef()));
+        if (!module)
+        {
+            failureCount++;
+            return;
+        }
+
+        ComPtr<slang::IEntryPoint> entryPoint;
+        if (SLANG_FAILED(module->findEntryPointByName("computeMain", entryPoint.writeRef())))
+        {
+            failureCount++;
+            return;
+        }
+
+        slang::IComponentType* components[2] = {module, entryPoint};
+        ComPtr<slang::IComponentType> composite;
+        ComPtr<slang::IComponentType> linkedProgram;
+        ComPtr<slang::IBlob> code;
+        if (SLANG_FAILED(session->createCompositeComponentType(
+                components,
+                2,
+                composite.writeRef(),
+                threadDiagnostics.writeRef())) ||
+            SLANG_FAILED(composite->link(linkedProgram.writeRef(), threadDiagnostics.writeRef())) ||
+            SLANG_FAILED(linkedProgram->getEntryPointCode(
+                0,
+                0,
+                code.writeRef(),
+                threadDiagnostics.writeRef())))
+        {
+            failureCount++;
+            return;
+        }
+        codes[threadIndex] = UnownedStringSlice(
+            (const char*)code->getBufferPointer(),
+            code->getBufferSize());
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < threadCount; ++i)
+        threads.emplace_back(worker, i);
+    for (auto& thread : threads)
+        thread.join();
+
+    SLANG_CHECK(failureCount == 0);
+
+    // All of the modules are the same, so the generated code should be too.
+    for (int i = 0; i < threadCount; ++i)
+    {
+        SLANG_CHECK(codes[i].getLength() != 0);
+        SLANG_CHECK(codes[i] == codes[0]);
+    }
+}
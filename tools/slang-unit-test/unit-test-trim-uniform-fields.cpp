@@ -0,0 +1,123 @@
+// unit-test-trim-uniform-fields.cpp
+
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Test that the unused fields of constant buffers are removed with -trim-unused-uniform-fields,
+// and that the getUniformDataOffset API reports where the remaining fields are.
+
+SLANG_UNIT_TEST(trimUnusedUniformFields)
+{
+    const char* userSourceBody = R"(
+        struct Params
+        {
+            float4 unused;
+            float4 scale;
+            float4 bias;
+        };
+        ConstantBuffer<Params> params;
+        RWStructuredBuffer<float4> outputBuffer;
+
+        [shader("compute")]
+        [numthreads(1, 1, 1)]
+        void computeMain()
+        {
+            outputBuffer[0] = params.scale * 2.0 + params.bias;
+        }
+        )";
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_SPIRV;
+    targetDesc.profile = globalSession->findProfile("spirv_1_5");
+
+    slang::CompilerOptionEntry compilerOptionEntry = {};
+    compilerOptionEntry.name = slang::CompilerOptionName::TrimUnusedUniformFields;
+    compilerOptionEntry.value.kind = slang::CompilerOptionValueKind::Int;
+    compilerOptionEntry.value.intValue0 = 1;
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.compilerOptionEntryCount = 1;
+    sessionDesc.compilerOptionEntries = &compilerOptionEntry;
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK(globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = session->loadModuleFromSourceString(
+        "m",
+        "m.slang",
+        userSourceBody,
+        diagnosticBlob.writeRef());
+    SLANG_CHECK(module != nullptr);
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    module->findAndCheckEntryPoint(
+        "computeMain",
+        SLANG_STAGE_COMPUTE,
+        entryPoint.writeRef(),
+        diagnosticBlob.writeRef());
+    SLANG_CHECK(entryPoint != nullptr);
+
+    ComPtr<slang::IComponentType> compositeProgram;
+    slang::IComponentType* components[] = {module, entryPoint.get()};
+    session->createCompositeComponentType(
+        components,
+        2,
+        compositeProgram.writeRef(),
+        diagnosticBlob.writeRef());
+    SLANG_CHECK(compositeProgram != nullptr);
+
+    ComPtr<slang::IComponentType> linkedProgram;
+    compositeProgram->link(linkedProgram.writeRef(), nullptr);
+
+    ComPtr<slang::IMetadata> metadata;
+    linkedProgram->getTargetMetadata(0, metadata.writeRef(), nullptr);
+    SLANG_CHECK(metadata != nullptr);
+
+    // `params` is bound to descriptor 0, with `unused`, `scale` and `bias` at offsets 0, 16
+    // and 32 in its reflected layout.
+    SlangUInt offset = 0;
+    bool isUsed = true;
+    metadata->getUniformDataOffset(
+        SLANG_PARAMETER_CATEGORY_DESCRIPTOR_TABLE_SLOT,
+        0,
+        0,
+        0,
+        offset,
+        isUsed);
+    SLANG_CHECK(!isUsed);
+
+    metadata->getUniformDataOffset(
+        SLANG_PARAMETER_CATEGORY_DESCRIPTOR_TABLE_SLOT,
+        0,
+        0,
+        20,
+        offset,
+        isUsed);
+    SLANG_CHECK(isUsed && offset == 4);
+
+    metadata->getUniformDataOffset(
+        SLANG_PARAMETER_CATEGORY_DESCRIPTOR_TABLE_SLOT,
+        0,
+        0,
+        32,
+        offset,
+        isUsed);
+    SLANG_CHECK(isUsed && offset == 16);
+
+    // Buffers that weren't trimmed are reported at their reflected offsets.
+    metadata->getUniformDataOffset(
+        SLANG_PARAMETER_CATEGORY_DESCRIPTOR_TABLE_SLOT,
+        0,
+        1,
+        8,
+        offset,
+        isUsed);
+    SLANG_CHECK(isUsed && offset == 8);
+}